@@ -48,6 +48,7 @@
 #include "loco/common/TorsoBase.hpp"
 #include "loco/common/TerrainModelBase.hpp"
 #include "loco/common/TypeDefs.hpp"
+#include "loco/common/ParameterVector.hpp"
 
 namespace loco {
 
@@ -88,6 +89,13 @@ class CoMOverSupportPolygonControlBase {
    */
   virtual bool setToInterpolated(const CoMOverSupportPolygonControlBase& supportPolygon1, const CoMOverSupportPolygonControlBase& supportPolygon2, double t) = 0;
 
+  /*! Adds the weights and offsets to the parameter vector of the locomotion controller,
+   * which interpolates them during gait transitions.
+   * @param parameterVector   parameter vector
+   * @returns true if successful
+   */
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
+
 
   double getMinSwingLegWeight() const;
   double getStartShiftAwayFromLegAtStancePhase() const;
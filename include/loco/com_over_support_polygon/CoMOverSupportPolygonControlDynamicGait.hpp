@@ -43,6 +43,7 @@
 #define LOCO_COMOVERSUPPORTPOLYGONCONTROLDYNAMICGAIT_HPP_
 
 #include "loco/com_over_support_polygon/CoMOverSupportPolygonControlBase.hpp"
+#include "loco/common/ConvexPolygon.hpp"
 
 namespace loco {
 
@@ -69,7 +70,16 @@ class CoMOverSupportPolygonControlDynamicGait: public CoMOverSupportPolygonContr
 
     virtual bool setToInterpolated(const CoMOverSupportPolygonControlBase& supportPolygon1, const CoMOverSupportPolygonControlBase& supportPolygon2, double t);
 
+    //! Convex hull of the grounded feet in the x-y plane of the world frame, updated in advance()
+    const ConvexPolygon& getSupportPolygon() const;
+
+    /*! Signed distance of the desired CoM to the edges of the support polygon (positive inside)
+     * @return negative infinity if less than three feet are grounded
+     */
+    double getStabilityMarginOfDesiredCoM() const;
+
 protected:
+    ConvexPolygon supportPolygon_;
 
 };
 
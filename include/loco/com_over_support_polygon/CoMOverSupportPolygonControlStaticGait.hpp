@@ -45,7 +45,8 @@
 #include "loco/com_over_support_polygon/CoMOverSupportPolygonControlBase.hpp"
 #include "loco/foot_placement_strategy/FootPlacementStrategyBase.hpp"
 #include "loco/common/TorsoBase.hpp"
-#include "robotUtils/filters/FirstOrderFilter.hpp"
+#include "loco/temp_helpers/FilterBank.hpp"
+#include "loco/com_over_support_polygon/ZmpPreviewController.hpp"
 
 namespace loco {
 
@@ -83,6 +84,8 @@ class CoMOverSupportPolygonControlStaticGait: public CoMOverSupportPolygonContro
   virtual int getCurrentSwingLeg();
 
   virtual void setFootHold(int legId, Position footHold);
+  //! Returns the foothold of the leg that is used to plan the support polygons
+  const Position& getFootHold(int legId) const;
 
 
   virtual bool getSwingFootChanged();
@@ -96,6 +99,22 @@ class CoMOverSupportPolygonControlStaticGait: public CoMOverSupportPolygonContro
    * @return  true if all parameters could be loaded
    */
   virtual bool loadParameters(TiXmlHandle &hParameterSet);
+
+  /*! Loads the parameters of the static gait, e.g. from TorsoControl/StaticGait:
+   * \code
+   * <StaticGait>
+   *   <CoMOverSupportPolygonControl>
+   *     <Delta forward="0.1" backward="0.1"/>
+   *     <CoMFilter timeConstant="0.5"/>
+   *     <ZmpPreview samplingTime="0.02" previewTime="1.6" heightOfCoM="0.45" weightZmpError="1.0" weightJerk="1.0e-6"/>
+   *   </CoMOverSupportPolygonControl>
+   * </StaticGait>
+   * \endcode
+   * The element ZmpPreview is optional. If it exists, the owned preview controller is used unless another
+   * one has been set with setZmpPreviewController().
+   * @param hParameterSet   handle
+   * @return  true if all parameters could be loaded
+   */
   virtual bool loadParametersStaticGait(TiXmlHandle &hParameterSet);
 
   virtual void setIsInStandConfiguration(bool isInStandConfiguration);
@@ -103,6 +122,13 @@ class CoMOverSupportPolygonControlStaticGait: public CoMOverSupportPolygonContro
 
   virtual bool isSafeToResumeWalking();
 
+  /*! Sets the preview controller that generates the CoM trajectory from the upcoming support triangles
+   * (nullptr shifts the CoM to the safe triangle intersections with the first-order filter).
+   * The gains are computed in initialize(). The controller is not owned.
+   */
+  virtual void setZmpPreviewController(ZmpPreviewController* zmpPreviewController);
+  ZmpPreviewController* getZmpPreviewController();
+
   virtual void printState();
 
  protected:
@@ -146,8 +172,11 @@ class CoMOverSupportPolygonControlStaticGait: public CoMOverSupportPolygonContro
   //! Get the next stance feet positions based on the gait planner
   Eigen::Matrix<double,2,4> getNextStanceConfig(const FeetConfiguration& currentStanceConfig, int steppingFoot);
 
+  //! Get the support triangle of the feet without the swing foot, the order of the feet is kept
+  SupportTriangle getSupportTriangle(const FeetConfiguration& feetConfiguration, int swingLeg) const;
+
   //! Get safe triangle from support triangle
-  Eigen::Matrix<double,2,3> getSafeTriangle(const Eigen::Matrix<double,2,3>& supportTriangle);
+  Eigen::Matrix<double,2,3> getSafeTriangle(const Eigen::Matrix<double,2,3>& supportTriangle) const;
 
   //! Get the next swing foot based on the gait sequence
   int getNextSwingFoot(const int currentSwingFoot);
@@ -158,13 +187,52 @@ class CoMOverSupportPolygonControlStaticGait: public CoMOverSupportPolygonContro
   //! Get the index of the current swing leg
   int getIndexOfSwingLeg();
 
-  std::vector<int> getDiagonalElements(int swingLeg);
+  //! Get the vertices of the support triangle which span the diagonal used for the CoM target
+  Eigen::Vector2i getDiagonalElements(int swingLeg);
 
   void updateSwingLegsIndexes();
 
   void updateSafeSupportTriangles();
 
-  robotUtils::FirstOrderFilter *filterCoMX_, *filterCoMY_;
+  //! Timing and footholds of a leg to predict the support triangles of the preview horizon
+  struct LegPreview {
+    //! start of the current or of the next swing phase relative to now (infinity if the leg does not step)
+    double timeOfLiftOff_;
+    double swingDuration_;
+    double strideDuration_;
+    Pos2d positionFoot_;
+    Pos2d positionFirstFootHold_;
+    //! displacement of the foot per stride
+    Pos2d step_;
+  };
+
+  //! Updates the timing and the footholds of the legs at the beginning of the preview horizon
+  void updateLegPreviews();
+
+  bool isSwingingInPreview(int legId, double time) const;
+  double getTimeOfNextLiftOffInPreview(int legId, double time) const;
+  Pos2d getPositionFootInPreview(int legId, double time) const;
+
+  //! Centroid of the safe triangle of the three-leg support phase at time or of the next one
+  Pos2d getZmpReferenceInPreview(double time) const;
+
+  //! Updates the preview controller if a sampling interval has passed and integrates the CoM trajectory
+  void advanceZmpPreview(double dt);
+
+  ZmpPreviewController* zmpPreviewController_;
+  LegPreview legPreviews_[4];
+  ZmpPreviewController::ZmpReference zmpReference_;
+  double timeSinceZmpPreviewUpdate_;
+  double zmpPreviewSamplingTime_;
+  double zmpPreviewTime_;
+  double zmpPreviewHeightOfCoM_;
+  double zmpPreviewWeightZmpError_;
+  double zmpPreviewWeightJerk_;
+  //! preview controller that is used if the parameters contain the element ZmpPreview
+  ZmpPreviewController* defaultZmpPreviewController_;
+
+  //! first-order filters of the CoM target [x; y]
+  FilterBank<2> filterCoM_;
   double filterInputCoMX_, filterInputCoMY_;
   double filterOutputCoMX_, filterOutputCoMY_;
 
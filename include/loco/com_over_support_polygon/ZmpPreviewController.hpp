@@ -0,0 +1,137 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ZmpPreviewController.hpp
+* @brief
+*/
+
+#ifndef LOCO_ZMPPREVIEWCONTROLLER_HPP_
+#define LOCO_ZMPPREVIEWCONTROLLER_HPP_
+
+#include <Eigen/Core>
+
+namespace loco {
+
+//! Generates a trajectory of the center of mass that tracks a previewed reference of the ZMP
+/*! The horizontal motion of the center of mass is modelled as a cart on a table with constant height h,
+ *  sampled with the sampling time T and driven by the jerk u:
+ *
+ *    x(k+1) = A*x(k) + B*u(k),   x = [c, dc, ddc]
+ *    p(k) = C*x(k) = c - h/g*ddc                    (ZMP)
+ *
+ *  The jerk minimizes sum Qe*e(k)^2 + R*u(k)^2 with the ZMP error e = p - p_ref (preview control with
+ *  integral action). The optimal control law is
+ *
+ *    u(k) = -Gi*sum_i e(i) - Gx*x(k) - sum_(j=1..N) Gd(j)*p_ref(k+j)
+ *
+ *  The gains are computed once by initialize() from the discrete algebraic Riccati equation, the update
+ *  is a fixed matrix-vector product with the N previewed reference points. Both axes share the gains.
+ */
+class ZmpPreviewController {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static const int maxNumberOfPreviewSamples = 200;
+
+  //! rows: reference of the ZMP at the current sample and at the next N samples, columns: x and y
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 2, 0, maxNumberOfPreviewSamples+1, 2> ZmpReference;
+
+  ZmpPreviewController();
+  virtual ~ZmpPreviewController();
+
+  /*! Computes the gains of the preview controller.
+   * @param samplingTime      sampling time T of the model [s]
+   * @param previewTime       length of the preview horizon [s]
+   * @param heightOfCoM       height h of the center of mass above the ground [m]
+   * @param weightZmpError    weight Qe of the ZMP error
+   * @param weightJerk        weight R of the jerk
+   * @returns false if the parameters are invalid or the Riccati equation did not converge
+   */
+  bool initialize(double samplingTime, double previewTime, double heightOfCoM,
+                  double weightZmpError = 1.0, double weightJerk = 1.0e-6, double gravity = 9.81);
+
+  bool isInitialized() const;
+
+  double getSamplingTime() const;
+
+  //! Number of previewed samples N, the reference needs N+1 rows
+  int getNumberOfPreviewSamples() const;
+
+  //! Resets the center of mass to rest at the position and clears the integral of the ZMP error.
+  void reset(const Eigen::Vector2d& positionCoM);
+
+  /*! Computes the jerk for the next sampling interval.
+   * @param zmpReference    reference of the ZMP (N+1 rows)
+   * @returns false if the controller is not initialized or the reference has the wrong size
+   */
+  bool update(const ZmpReference& zmpReference);
+
+  //! Integrates the center of mass with the current jerk, advance by the sampling time between two updates.
+  void integrate(double dt);
+
+  Eigen::Vector2d getPositionCoM() const;
+  Eigen::Vector2d getVelocityCoM() const;
+  Eigen::Vector2d getAccelerationCoM() const;
+  Eigen::Vector2d getZmp() const;
+
+  //! Gains of the previewed reference, Gd(1)...Gd(N)
+  const Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, maxNumberOfPreviewSamples>& getPreviewGains() const;
+
+ protected:
+  bool isInitialized_;
+  double samplingTime_;
+  double heightOfCoM_;
+  double gravity_;
+  int numberOfPreviewSamples_;
+
+  //! model
+  Eigen::Matrix3d A_;
+  Eigen::Vector3d B_;
+  Eigen::RowVector3d C_;
+
+  //! gains
+  double gainIntegral_;
+  Eigen::RowVector3d gainState_;
+  Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, maxNumberOfPreviewSamples> gainsPreview_;
+
+  //! state of the cart (rows: position, velocity, acceleration, columns: x and y)
+  Eigen::Matrix<double, 3, 2> state_;
+  Eigen::RowVector2d integralOfZmpError_;
+  Eigen::RowVector2d jerk_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_ZMPPREVIEWCONTROLLER_HPP_ */
@@ -0,0 +1,92 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * BackgroundJobQueue.hpp
+ */
+
+#ifndef LOCO_BACKGROUNDJOBQUEUE_HPP_
+#define LOCO_BACKGROUNDJOBQUEUE_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace loco {
+
+//! Worker thread that runs jobs one after the other
+/*! Jobs that are added while another job is running are queued instead of rejected, and adding a job never
+ *  waits for a running job. This is used to parse parameter files without blocking the control thread.
+ */
+class BackgroundJobQueue {
+ public:
+  typedef std::function<void()> Job;
+
+  BackgroundJobQueue();
+
+  //! Discards the queued jobs and waits for the running job
+  virtual ~BackgroundJobQueue();
+
+  /*! Adds a job that runs after all jobs that have been added before.
+   * @param job   job, which must not add jobs or wait for the queue
+   */
+  void addJob(const Job& job);
+
+  //! Discards the jobs that have not been started yet
+  void clear();
+
+  //! Blocks until all jobs are done
+  void waitUntilDone();
+
+  //! @returns true if a job is running or queued
+  bool isBusy() const;
+
+ private:
+  void run();
+
+ private:
+  std::deque<Job> jobs_;
+  bool isRunningJob_;
+  bool isStopped_;
+  mutable std::mutex mutex_;
+  std::condition_variable jobAddedCondition_;
+  std::condition_variable jobsDoneCondition_;
+  std::thread worker_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_BACKGROUNDJOBQUEUE_HPP_ */
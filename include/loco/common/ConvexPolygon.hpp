@@ -0,0 +1,142 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ConvexPolygon.hpp
+ */
+
+#ifndef LOCO_CONVEXPOLYGON_HPP_
+#define LOCO_CONVEXPOLYGON_HPP_
+
+#include <Eigen/Core>
+
+namespace loco {
+
+//! Convex polygon in the plane with a fixed maximum number of vertices
+/*! The vertices are stored in Eigen matrices with a fixed maximum size, such that none of the
+ *  operations allocates memory. The polygon keeps the inward unit normals and the offsets of its
+ *  edges, hence the signed distances of a point to all edges are evaluated as one matrix product.
+ *  Support polygons of the legged robot have at most four vertices, the capacity leaves room for
+ *  polygons with additional contact points.
+ */
+class ConvexPolygon {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static const int maxNumberOfVertices = 8;
+
+  typedef Eigen::Vector2d Point;
+  typedef Eigen::Matrix<double, 2, Eigen::Dynamic, Eigen::ColMajor, 2, maxNumberOfVertices> Points;
+  typedef Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, maxNumberOfVertices> EdgeValues;
+
+  ConvexPolygon();
+  virtual ~ConvexPolygon();
+
+  //! Removes all vertices
+  void clear();
+
+  /*! Sets the polygon to the convex hull of the points (Andrew's monotone chain).
+   * The vertices are ordered counter-clockwise, collinear points are dropped.
+   * @param points  columns are the points, at most maxNumberOfVertices
+   * @returns false if there are more than maxNumberOfVertices points (the polygon is cleared) or if the hull
+   *          has less than three vertices
+   */
+  bool setToConvexHull(const Points& points);
+
+  /*! Sets the vertices of a polygon that is known to be convex, e.g. a support triangle.
+   * The order of the vertices is kept, both orientations are accepted.
+   * @returns false if there are more than maxNumberOfVertices (the polygon is cleared) or less than three vertices
+   *          or if the area is zero
+   */
+  bool setVertices(const Points& vertices);
+
+  /*! Shifts all edges by margin towards the inside and intersects the neighboring edges.
+   * The vertices of the offset polygon correspond to the vertices of this polygon.
+   * @param margin          distance between the edges of the two polygons
+   * @param offsetPolygon   safe polygon
+   * @returns false if the polygon is degenerate or the margin is too large for the polygon
+   */
+  bool getInwardOffset(double margin, ConvexPolygon& offsetPolygon) const;
+
+  /*! Signed distances of the point to the lines through the edges, positive inside.
+   * Entry k belongs to the edge from vertex k to vertex k+1.
+   */
+  void getSignedDistancesToEdges(const Point& point, EdgeValues& distances) const;
+
+  /*! Minimum of the signed distances to the edges, i.e. the stability margin of the point.
+   * Inside the polygon this is the distance to the boundary, outside it is a lower bound of the
+   * negative distance.
+   */
+  double getSignedDistance(const Point& point) const;
+
+  //! @returns true if the point is inside the polygon or closer than tolerance to its boundary
+  bool isInside(const Point& point, double tolerance = 0.0) const;
+
+  //! Mean of the vertices
+  Point getCentroid() const;
+
+  int getNumberOfVertices() const;
+  const Points& getVertices() const;
+  Point getVertex(int k) const;
+
+  /*! Index of the input point of setToConvexHull or setVertices which became vertex k.
+   * This allows to draw the polygon with the original three-dimensional contact positions.
+   */
+  int getIndexOfVertex(int k) const;
+
+  /*! Intersection of the lines through the segments a0-a1 and b0-b1.
+   * The intersection is a0 + s*(a1-a0) = b0 + t*(b1-b0).
+   * @returns false if one of the segments has zero length or if they are parallel
+   */
+  static bool intersectLines(const Point& a0, const Point& a1, const Point& b0, const Point& b1, double& s, double& t);
+
+  //! @returns true if the segments a0-a1 and b0-b1 intersect
+  static bool intersectSegments(const Point& a0, const Point& a1, const Point& b0, const Point& b1, Point& intersection);
+
+ protected:
+  //! Computes the edge normals and offsets from the vertices
+  bool updateEdges();
+
+  int numberOfVertices_;
+  Points vertices_;
+  //! Inward unit normals of the edges
+  Points edgeNormals_;
+  //! The edge k satisfies normal_k'*p = offset_k
+  EdgeValues edgeOffsets_;
+  int indicesOfVertices_[maxNumberOfVertices];
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_CONVEXPOLYGON_HPP_ */
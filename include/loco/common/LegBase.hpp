@@ -231,6 +231,14 @@ class LegBase {
   const Position& getDesiredWorldToFootPositionInWorldFrame() const;
   void setDesireWorldToFootPositionInWorldFrame(const Position& position);
 
+  /*! Feedforward of the swing trajectory: desired velocity and acceleration of the foot relative to the hip expressed in world frame.
+   * They are zero if the foot placement strategy does not provide them.
+   */
+  const LinearVelocity& getDesiredLinearVelocityHipToFootInWorldFrame() const;
+  void setDesiredLinearVelocityHipToFootInWorldFrame(const LinearVelocity& linearVelocity);
+  const LinearAcceleration& getDesiredLinearAccelerationHipToFootInWorldFrame() const;
+  void setDesiredLinearAccelerationHipToFootInWorldFrame(const LinearAcceleration& linearAcceleration);
+
 	void setPreviousStancePhase(double previousStancePhase);
 	double getPreviousStancePhase() const;
 
@@ -354,6 +362,11 @@ protected:
    */
   Position positionWorldToDesiredFootInWorldFrame_;
 
+  /*! Feedforward velocity and acceleration of the desired foot relative to the hip expressed in world frame.
+   */
+  LinearVelocity linearVelocityHipToDesiredFootInWorldFrame_;
+  LinearAcceleration linearAccelerationHipToDesiredFootInWorldFrame_;
+
   /*! Reference to the state switcher.
    */
   StateSwitcher* stateSwitcher_;
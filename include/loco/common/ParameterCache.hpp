@@ -0,0 +1,138 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterCache.hpp
+ */
+
+#ifndef LOCO_PARAMETERCACHE_HPP_
+#define LOCO_PARAMETERCACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "tinyxml.h"
+
+namespace loco {
+
+//! Precompiled binary cache of the XML parameter files of a directory
+/*! All XML files of a parameter directory are compiled into a single versioned blob that contains the
+ *  elements and attributes of each file in document order together with a string table. The blob is
+ *  protected by a checksum and memory-mapped when it is opened, such that a document can be restored
+ *  without reading and parsing the XML text.
+ *
+ *  The XML files remain the source of truth: a file is only restored from the cache if its size and its
+ *  modification time in nanoseconds match the ones recorded at compile time. If only the modification time
+ *  differs, the checksum of the file content is compared instead. Otherwise the caller falls back to the XML file.
+ *  openOrRebuild() recompiles the cache if any source file is newer.
+ */
+class ParameterCache {
+ public:
+  //! Version of the binary format, a cache with a different version is rebuilt
+  static const uint32_t version;
+
+  //! Default file name of the cache inside the parameter directory
+  static const char* defaultFileName;
+
+  ParameterCache();
+  virtual ~ParameterCache();
+
+  /*! Compiles the XML files into a cache file.
+   * @param directory   directory that contains the XML files
+   * @param fileNames   names of the files relative to the directory
+   * @param cacheFile   path of the cache file to write
+   * @returns true if successful
+   */
+  static bool compile(const std::string& directory, const std::vector<std::string>& fileNames, const std::string& cacheFile);
+
+  /*! Compiles all XML files of a directory into a cache file.
+   * @returns true if successful
+   */
+  static bool compileDirectory(const std::string& directory, const std::string& cacheFile);
+
+  /*! Lists the XML files of a directory in alphabetical order.
+   * @param directory   directory that contains the XML files
+   * @param fileNames   names of the files relative to the directory
+   * @returns false if the directory could not be opened
+   */
+  static bool listXmlFiles(const std::string& directory, std::vector<std::string>* fileNames);
+
+  /*! Memory-maps a cache file and validates its version and checksum.
+   * @param directory   directory that contains the XML files the cache was compiled from
+   * @param cacheFile   path of the cache file
+   * @returns true if the cache is valid
+   */
+  bool open(const std::string& directory, const std::string& cacheFile);
+
+  /*! Opens the cache of a directory and recompiles it first if it is missing, invalid or outdated.
+   * @returns true if the cache could be opened
+   */
+  bool openOrRebuild(const std::string& directory, const std::string& cacheFile);
+
+  //! Unmaps the cache file
+  void close();
+
+  //! @returns true if a cache file is mapped
+  bool isOpen() const;
+
+  /*! @returns true if all XML files of the directory are in the cache and none of them has been modified.
+   */
+  bool isUpToDate() const;
+
+  /*! Restores an XML document from the cache. This is thread-safe.
+   * @param filename  path of the XML file
+   * @param document  document to fill
+   * @returns false if the file is not in the cache or has been modified since the cache was compiled.
+   */
+  bool loadXmlDocument(const std::string& filename, TiXmlDocument* document) const;
+
+ private:
+  //! @returns the index of the file in the cache or -1 if not found
+  int findFile(const std::string& fileName) const;
+  //! @returns true if the source file has not been modified since the cache was compiled
+  bool isFileUpToDate(int fileIndex) const;
+  const char* getString(uint32_t offset) const;
+
+ private:
+  //! mapped cache file
+  const char* data_;
+  std::size_t size_;
+  //! directory of the XML files
+  std::string directory_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_PARAMETERCACHE_HPP_ */
@@ -0,0 +1,88 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterFileWatcher.hpp
+ */
+
+#ifndef LOCO_PARAMETERFILEWATCHER_HPP_
+#define LOCO_PARAMETERFILEWATCHER_HPP_
+
+#include <string>
+#include <vector>
+
+namespace loco {
+
+//! Watches a parameter directory for modified XML files
+/*! Uses inotify to get notified when an XML file is written or replaced (editors often write to a
+ *  temporary file and rename it). The watcher does not parse any file, this is left to the caller.
+ */
+class ParameterFileWatcher {
+ public:
+  ParameterFileWatcher();
+  virtual ~ParameterFileWatcher();
+
+  /*! Starts watching a directory.
+   * @param directory   directory that contains the XML parameter files
+   * @returns true if successful
+   */
+  bool watch(const std::string& directory);
+
+  //! Stops watching
+  void stop();
+
+  //! @returns true if a directory is watched
+  bool isWatching() const;
+
+  /*! Waits until XML files have been modified or the timeout has elapsed.
+   * @param fileNames   names of the modified files relative to the directory, each name is reported once
+   * @param timeout     maximal time to wait [ms], 0 does not block
+   * @returns true if at least one file has been modified
+   */
+  bool waitForModifiedFiles(std::vector<std::string>* fileNames, int timeout);
+
+  //! @returns the watched directory
+  const std::string& getDirectory() const;
+
+ private:
+  //! inotify file descriptor
+  int fileDescriptor_;
+  //! inotify watch descriptor of the directory
+  int watchDescriptor_;
+  std::string directory_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_PARAMETERFILEWATCHER_HPP_ */
@@ -0,0 +1,180 @@
+/*******************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterSchema.hpp
+ */
+
+#ifndef LOCO_PARAMETERSCHEMA_HPP_
+#define LOCO_PARAMETERSCHEMA_HPP_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "tinyxml.h"
+
+namespace loco {
+
+//! Schema of a typed parameter struct
+/*! A module declares its parameters as a plain struct of doubles (or fixed-size vectors of doubles) and a schema
+ *  that maps each double to an attribute of an element in the XML parameter file, e.g.
+ *  \code
+ *  schema.add("VirtualModelController/Gains/Heading", "kp", &Parameters::proportionalGainTranslation, 0);
+ *  \endcode
+ *  The XML file is parsed once into the struct. All entries are validated at once and every missing or
+ *  malformed attribute is reported, not only the first one. Afterwards the XML document is not needed anymore.
+ *
+ *  The schema covers fixed sets of doubles. It is used by the contact force distribution, the virtual model
+ *  controller, the whole-body controller, the centroidal MPC, the inverted pendulum foot placement strategy and the
+ *  dynamic gait limb coordinator. Lists of elements, e.g. the knots of trajectories and the foot fall patterns of the
+ *  gait patterns, are still read from the handle by the modules.
+ */
+template<typename Parameters_>
+class ParameterSchema {
+ public:
+  typedef Parameters_ Parameters;
+
+  //! Entry of the schema
+  struct Entry {
+    //! path of the element separated by '/' relative to the handle passed to parse
+    std::string path_;
+    std::string attribute_;
+    //! offset of the double in the parameter struct in bytes
+    std::size_t offset_;
+    bool isRequired_;
+    double defaultValue_;
+  };
+
+  ParameterSchema() {
+
+  }
+
+  //! Adds a required scalar parameter.
+  void add(const std::string& path, const std::string& attribute, double Parameters_::* member) {
+    Parameters_ prototype;
+    addEntry(path, attribute, getOffset(prototype, &(prototype.*member)), true, 0.0);
+  }
+
+  //! Adds a required element of a vector parameter (double[N] or a fixed-size Eigen vector).
+  template<typename Vector_>
+  void add(const std::string& path, const std::string& attribute, Vector_ Parameters_::* member, int index) {
+    Parameters_ prototype;
+    addEntry(path, attribute, getOffset(prototype, &(prototype.*member)[index]), true, 0.0);
+  }
+
+  //! Adds an optional scalar parameter that is set to the default value if it is not found.
+  void addOptional(const std::string& path, const std::string& attribute, double Parameters_::* member, double defaultValue) {
+    Parameters_ prototype;
+    addEntry(path, attribute, getOffset(prototype, &(prototype.*member)), false, defaultValue);
+  }
+
+  /*! Parses the XML into the parameter struct.
+   * @param handle      handle to the root of the paths of the entries
+   * @param parameters  parameter struct, unchanged if the parsing fails
+   * @returns true if all required parameters were found
+   */
+  bool parse(const TiXmlHandle& handle, Parameters_& parameters) const {
+    Parameters_ parsedParameters(parameters);
+    bool isValid = true;
+    for (const Entry& entry : entries_) {
+      double& value = getValue(parsedParameters, entry);
+      TiXmlElement* element = getElement(handle, entry.path_).Element();
+      if (element && element->QueryDoubleAttribute(entry.attribute_.c_str(), &value) == TIXML_SUCCESS) {
+        continue;
+      }
+      if (entry.isRequired_) {
+        printf("Could not find %s:%s\n", entry.path_.c_str(), entry.attribute_.c_str());
+        isValid = false;
+      }
+      else {
+        value = entry.defaultValue_;
+      }
+    }
+    if (isValid) {
+      parameters = parsedParameters;
+    }
+    return isValid;
+  }
+
+  const std::vector<Entry>& getEntries() const {
+    return entries_;
+  }
+
+  static double& getValue(Parameters_& parameters, const Entry& entry) {
+    return *reinterpret_cast<double*>(reinterpret_cast<char*>(&parameters) + entry.offset_);
+  }
+
+  static const double& getValue(const Parameters_& parameters, const Entry& entry) {
+    return *reinterpret_cast<const double*>(reinterpret_cast<const char*>(&parameters) + entry.offset_);
+  }
+
+ private:
+  static std::size_t getOffset(const Parameters_& prototype, const double* value) {
+    return static_cast<std::size_t>(reinterpret_cast<const char*>(value) - reinterpret_cast<const char*>(&prototype));
+  }
+
+  void addEntry(const std::string& path, const std::string& attribute, std::size_t offset, bool isRequired, double defaultValue) {
+    Entry entry;
+    entry.path_ = path;
+    entry.attribute_ = attribute;
+    entry.offset_ = offset;
+    entry.isRequired_ = isRequired;
+    entry.defaultValue_ = defaultValue;
+    entries_.push_back(entry);
+  }
+
+  static TiXmlHandle getElement(const TiXmlHandle& handle, const std::string& path) {
+    TiXmlHandle element(handle);
+    std::size_t begin = 0;
+    while (begin <= path.size()) {
+      std::size_t end = path.find('/', begin);
+      if (end == std::string::npos) {
+        end = path.size();
+      }
+      if (end > begin) {
+        element = element.FirstChild(path.substr(begin, end-begin).c_str());
+      }
+      begin = end+1;
+    }
+    return element;
+  }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_PARAMETERSCHEMA_HPP_ */
@@ -44,6 +44,7 @@
 
 #include <string>
 #include "tinyxml.h"
+#include "loco/common/ParameterCache.hpp"
 
 
 namespace loco {
@@ -67,10 +68,22 @@ class ParameterSet {
   bool isDocumentLoaded();
 
   /*! Loads the document
-   * @param filename  path and file name of the XML file
+   * @param filename        path and file name of the XML file
+   * @param parameterCache  if not null, the document is restored from the cache if the XML file has not been modified
    * @returns true if document could be loaded
    */
-  bool loadXmlDocument(const std::string& filename);
+  bool loadXmlDocument(const std::string& filename, const ParameterCache* parameterCache = nullptr);
+
+  /*! Loads the document again from the parameter file, e.g. after it has been released.
+   * The parameter cache passed to loadXmlDocument is used again.
+   * @returns true if document could be loaded
+   */
+  bool reloadXmlDocument();
+
+  /*! Replaces the document by a copy of another version of the parameter file, e.g. to parse a modified file.
+   * @param document  document to copy
+   */
+  void setXmlDocument(const TiXmlDocument& document);
 
   /*! Gets the handle to access the parameters from the XML file
    *
@@ -78,6 +91,15 @@ class ParameterSet {
    */
   TiXmlHandle& getHandle();
 
+  /*! Releases the XML document once all parameters have been parsed into the modules.
+   * The handle refers to an empty document afterwards.
+   */
+  void releaseXmlDocument();
+
+  /*! @returns path to the parameter file
+   */
+  const std::string& getParameterFile() const;
+
 
  protected:
   //! true if xml document is loaded
@@ -91,6 +113,9 @@ class ParameterSet {
 
   //! path to parameter file
   std::string parameterFile_;
+
+  //! cache the document was loaded from (not owned)
+  const ParameterCache* parameterCache_;
 };
 
 } /* namespace loco */
@@ -0,0 +1,143 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterVector.hpp
+ */
+
+#ifndef LOCO_PARAMETERVECTOR_HPP_
+#define LOCO_PARAMETERVECTOR_HPP_
+
+#include <Eigen/Core>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace loco {
+
+//! Contiguous vector of the continuous parameters of a controller
+/*! Each module registers its continuous parameters as a named slice. The vector holds a copy of the
+ *  parameters in contiguous memory such that the parameters of a gait transition are interpolated by a
+ *  single vectorized operation over two vectors instead of field by field. The interpolated values are
+ *  then written back to the modules and the modules whose values changed are notified.
+ *
+ *  The same representation can be used by tuning tools and optimizers through getValues() and setValues().
+ */
+class ParameterVector {
+ public:
+  //! Called after the values of a slice have been written to the module and at least one of them has changed
+  typedef std::function<void()> ParametersChangedCallback;
+
+  ParameterVector();
+  virtual ~ParameterVector();
+
+  /*! Registers a slice of parameters.
+   * @param name        name of the slice, e.g. the name of the module
+   * @param parameters  addresses of the parameters in the module
+   * @param callback    optional notification if the parameters have been changed
+   */
+  void addSlice(const std::string& name, const std::vector<double*>& parameters,
+                const ParametersChangedCallback& callback = ParametersChangedCallback());
+
+  /*! Replaces the addresses of the parameters of a slice, e.g. after the module has reallocated its parameters.
+   * The slices behind it are moved if the number of parameters changed. The values of the slice are read from the module.
+   * @param name        name of the slice
+   * @param parameters  addresses of the parameters in the module
+   * @returns false if the slice is not found or the vector is detached from the modules
+   */
+  bool setSliceParameters(const std::string& name, const std::vector<double*>& parameters);
+
+  //! Removes all slices
+  void clear();
+
+  /*! Drops the addresses of the modules, but keeps the slices and the values.
+   * A detached vector only serves as source of setToInterpolated, e.g. to keep the parameters of a gait after its modules are destroyed.
+   * readFromModules() and writeToModules() have no effect on it.
+   */
+  void detachFromModules();
+
+  //! @returns true if the vector is connected to the parameters of the modules
+  bool isAttachedToModules() const;
+
+  //! Copies the parameters of the modules to the vector
+  void readFromModules();
+
+  //! Copies the vector to the parameters of the modules and notifies the modules whose parameters changed
+  void writeToModules();
+
+  /*! Sets the vector to the linear interpolation of two vectors with the same layout and writes it to the modules.
+   * @param parameterVector1  values if t is 0
+   * @param parameterVector2  values if t is 1
+   * @param t                 interpolation parameter in [0, 1]
+   * @returns false if the layouts differ
+   */
+  bool setToInterpolated(const ParameterVector& parameterVector1, const ParameterVector& parameterVector2, double t);
+
+  //! @returns true if the vectors have the same slices
+  bool hasSameLayout(const ParameterVector& parameterVector) const;
+
+  const Eigen::VectorXd& getValues() const;
+
+  /*! Sets the values and writes them to the modules.
+   * @returns false if the size does not match
+   */
+  bool setValues(const Eigen::VectorXd& values);
+
+  int getSize() const;
+  int getNumberOfSlices() const;
+  const std::string& getSliceName(int sliceIndex) const;
+  int getSliceOffset(int sliceIndex) const;
+  int getSliceSize(int sliceIndex) const;
+
+  /*! @returns the index of a slice or -1 if not found
+   */
+  int getSliceIndex(const std::string& name) const;
+
+ private:
+  struct Slice {
+    std::string name_;
+    int offset_;
+    int size_;
+    ParametersChangedCallback callback_;
+  };
+
+  std::vector<Slice> slices_;
+  //! addresses of the parameters in the modules
+  std::vector<double*> parameters_;
+  Eigen::VectorXd values_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_PARAMETERVECTOR_HPP_ */
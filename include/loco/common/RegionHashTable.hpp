@@ -0,0 +1,109 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * RegionHashTable.hpp
+ */
+
+#ifndef LOCO_REGIONHASHTABLE_HPP_
+#define LOCO_REGIONHASHTABLE_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace loco {
+
+//! Hash table that maps the keys of grid regions to the slots of a preallocated pool
+/*! The table uses open addressing with linear probing and at most half of the buckets are occupied.
+ *  The memory is allocated by setCapacity(), inserting and erasing keys does not allocate memory,
+ *  hence the table can be used in the control loop. The slots are in [0, capacity) and can be used
+ *  as indices of arrays of the same capacity.
+ */
+class RegionHashTable {
+ public:
+  /*! Constructor
+   * @param capacity  maximal number of keys
+   */
+  RegionHashTable(int capacity = 0);
+  virtual ~RegionHashTable();
+
+  //! Sets the maximal number of keys and removes all keys
+  void setCapacity(int capacity);
+
+  //! Removes all keys
+  void clear();
+
+  //! @returns slot of the key or -1 if the key is not in the table
+  int find(int64_t key) const;
+
+  /*! Inserts a key.
+   * @returns slot of the key, or -1 if the table is full
+   */
+  int insert(int64_t key);
+
+  /*! Removes a key. Its slot is reused by a later insertion.
+   * @returns false if the key is not in the table
+   */
+  bool erase(int64_t key);
+
+  //! @returns true if the slot holds a key
+  bool isUsed(int slot) const;
+
+  //! @returns key of a used slot
+  int64_t getKey(int slot) const;
+
+  int size() const;
+  int getCapacity() const;
+
+ protected:
+  //! @returns index of the first bucket to probe for the key
+  int getBucketIndex(int64_t key) const;
+
+  //! @returns index of the bucket that holds the key or -1
+  int findBucketIndex(int64_t key) const;
+
+ protected:
+  int capacity_;
+  int size_;
+  //! Slot of each bucket, -1 if empty
+  std::vector<int> buckets_;
+  int bucketMask_;
+  std::vector<int64_t> keys_;
+  std::vector<bool> isUsed_;
+  std::vector<int> freeSlots_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_REGIONHASHTABLE_HPP_ */
@@ -0,0 +1,135 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * StabilityMargins.hpp
+ */
+
+#ifndef LOCO_STABILITYMARGINS_HPP_
+#define LOCO_STABILITYMARGINS_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+#include "loco/common/LegGroup.hpp"
+#include "loco/common/TorsoBase.hpp"
+#include "loco/common/ConvexPolygon.hpp"
+
+namespace loco {
+
+class ContactForceDistributionBase;
+class WholeBodyController;
+
+//! Stability margins of the robot, evaluated once per control tick
+/*! All margins are signed distances in the x-y plane of the world frame to the edges of the support
+ *  polygon of the grounded feet, positive inside:
+ *
+ *  - support polygon margin: projection of the center of mass (static stability)
+ *  - center of pressure margin: CoP of the ground reaction forces of the whole-body controller if it is set,
+ *    otherwise of the contact force distribution
+ *  - capture point margin: instantaneous capture point c + dc/omega with omega = sqrt(g/h) of the
+ *    linear inverted pendulum, h is the height of the center of mass above the grounded feet
+ *
+ *  If only one or two feet are grounded, the margin is the negative distance to the foot or to the line
+ *  between the feet. The locomotion controller updates the margins after the measurements, hence the
+ *  center of pressure belongs to the contact forces of the previous tick. Nothing is allocated.
+ */
+class StabilityMargins {
+ public:
+  StabilityMargins(LegGroup* legs, TorsoBase* torso);
+  virtual ~StabilityMargins();
+
+  //! Sets the contact force distribution for the center of pressure (nullptr disables it)
+  void setContactForceDistribution(const ContactForceDistributionBase* contactForceDistribution);
+
+  //! Sets the whole-body controller for the center of pressure, it replaces the contact force distribution (nullptr disables it)
+  void setWholeBodyController(const WholeBodyController* wholeBodyController);
+
+  /*! Evaluates the margins with the measured state of the torso and the legs.
+   * @returns false if no foot is grounded
+   */
+  bool update();
+
+  //! Marks the margins as outdated
+  void invalidate();
+
+  //! @returns true if the margins were updated since the last invalidation
+  bool isValid() const;
+
+  double getSupportPolygonMargin() const;
+  double getCenterOfPressureMargin() const;
+  double getCapturePointMargin() const;
+
+  /*! Capture point margin on the support polygon of the grounded feet without the foot of the leg,
+   *  i.e. the margin that remains if the leg lifts off. It is evaluated with the feet of the last update.
+   * @returns the capture point margin if the leg was not grounded
+   */
+  double getCapturePointMarginWithoutLeg(const LegBase& leg) const;
+
+  //! @returns true if the contact forces of the last update had a positive normal component
+  bool isCenterOfPressureValid() const;
+
+  const Position& getPositionWorldToCenterOfMassInWorldFrame() const;
+  const Position& getPositionWorldToCenterOfPressureInWorldFrame() const;
+  const Position& getPositionWorldToCapturePointInWorldFrame() const;
+
+  //! Convex hull of the grounded feet in the x-y plane of the world frame
+  const ConvexPolygon& getSupportPolygon() const;
+
+ protected:
+  //! Signed distance to the support polygon, also for less than three vertices
+  static double getMargin(const ConvexPolygon& supportPolygon, const Position& positionWorldToPointInWorldFrame);
+
+  LegGroup* legs_;
+  TorsoBase* torso_;
+  const ContactForceDistributionBase* contactForceDistribution_;
+  const WholeBodyController* wholeBodyController_;
+  bool isValid_;
+  bool isCenterOfPressureValid_;
+
+  ConvexPolygon supportPolygon_;
+  //! grounded feet of the last update in the x-y plane of the world frame
+  ConvexPolygon::Points feet_;
+  //! leg id of each column of feet_
+  int legIdsOfFeet_[ConvexPolygon::maxNumberOfVertices];
+  double supportPolygonMargin_;
+  double centerOfPressureMargin_;
+  double capturePointMargin_;
+
+  Position positionWorldToCenterOfMassInWorldFrame_;
+  Position positionWorldToCenterOfPressureInWorldFrame_;
+  Position positionWorldToCapturePointInWorldFrame_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_STABILITYMARGINS_HPP_ */
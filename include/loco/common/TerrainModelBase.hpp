@@ -44,6 +44,8 @@
 
 #include "loco/common/TypeDefs.hpp"
 
+#include <vector>
+
 namespace loco {
 
 /*! Base class for model of the terrain used for control
@@ -92,6 +94,28 @@ class TerrainModelBase {
   virtual Position getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& positionInWorldFrame) const = 0;
   virtual double getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const = 0;
 
+  /*! Gets the heights of the terrain at several positions in one call.
+   * The default implementation calls getHeight for each position, models override it with a batch evaluation.
+   * @param[in] positionsWorldToLocationInWorldFrame   positions of the requested locations expressed in world frame
+   * @param[out] heightsInWorldFrame   heights of the terrain in world frame (resized to the number of positions)
+   * @returns true if all queries were successful, false otherwise
+   */
+  virtual bool getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const;
+
+  /*! Gets the surface normals of the terrain at several positions in one call.
+   * @param[in] positionsWorldToLocationInWorldFrame   positions of the requested locations expressed in world frame
+   * @param[out] normalsInWorldFrame   surface normals in world frame (resized to the number of positions)
+   * @returns true if all queries were successful, false otherwise
+   */
+  virtual bool getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const;
+
+  /*! Projects several positions along the surface normal on the terrain in one call.
+   * @param[in] positionsInWorldFrame   positions to project expressed in world frame
+   * @param[out] projectedPositionsInWorldFrame   projected positions in world frame (resized to the number of positions)
+   * @returns true if all queries were successful, false otherwise
+   */
+  virtual bool getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const;
+
 };
 
 } /* namespace loco */
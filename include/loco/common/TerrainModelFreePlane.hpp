@@ -96,6 +96,12 @@ namespace loco {
       Position getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& position)  const;
       double getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const;
 
+      /*! Batch queries, the plane coefficients are computed once and the points are evaluated in a branch-free loop.
+       */
+      virtual bool getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const;
+      virtual bool getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const;
+      virtual bool getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const;
+
    public:
       double frictionCoefficientBetweenTerrainAndFoot_;
 
@@ -0,0 +1,251 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainModelHeightMap.hpp
+ */
+
+#ifndef LOCO_TERRAINMODELHEIGHTMAP_HPP_
+#define LOCO_TERRAINMODELHEIGHTMAP_HPP_
+
+#include "loco/common/TerrainModelBase.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace loco {
+
+//! Terrain model given by an elevation grid
+/*! The heights are sampled on a regular grid in the x-y plane of the world frame. The grid is stored
+ *  in square tiles of tileSize x tileSize cells such that the cells of a neighborhood are close in memory.
+ *  Each cell stores its height, its surface normal and its friction coefficient. The normals are
+ *  precomputed whenever a height changes, hence every query is O(1).
+ *
+ *  The map is local: it covers numberOfTilesX x numberOfTilesY tiles around a center that can be moved
+ *  with the robot by moveTo(). The tiles are kept in a ring buffer such that moving the map only clears
+ *  the tiles that enter it. Queries outside of the map are clamped to its border and return false.
+ */
+class TerrainModelHeightMap: public TerrainModelBase {
+ public:
+  enum InterpolationMethod {
+    InterpolationBilinear = 0,
+    InterpolationBicubic
+  };
+
+  //! Number of cells along one side of a tile
+  static const int tileSize = 16;
+
+  //! Version of the binary map file format
+  static const uint32_t fileVersion;
+
+  /*! Constructor
+   * @param resolution        side length of a cell [m]
+   * @param numberOfTilesX    number of tiles of the local map along the x-axis
+   * @param numberOfTilesY    number of tiles of the local map along the y-axis
+   */
+  TerrainModelHeightMap(double resolution = 0.02, int numberOfTilesX = 16, int numberOfTilesY = 16);
+  virtual ~TerrainModelHeightMap();
+
+  /*! Resets the map to a flat ground at the default height if no map has been loaded.
+   * @param dt  time step
+   * @returns true
+   */
+  virtual bool initialize(double dt);
+
+  /*! Gets the surface normal of the terrain at a certain position.
+   * @param[in] positionWorldToLocationInWorldFrame the place to get the surface normal from (in the world frame)
+   * @param[out] normalInWorldFrame the surface normal (in the world frame)
+   * @return true if the position is inside the map, false otherwise
+   */
+  virtual bool getNormal(const loco::Position& positionWorldToLocationInWorldFrame, loco::Vector& normalInWorldFrame) const;
+
+  /*! Gets the height of the terrain at the coordinate (positionWorldToLocationInWorldFrame(), positionWorldToLocationInWorldFrame())
+   * (in world frame) and sets the position.z() as the height (in world frame).
+   * @param[in/out] positionWorldToLocationInWorldFrame   position from origin of world frame to the requested location expressed in world frame
+   * @return true if the position is inside the map, false otherwise
+   */
+  virtual bool getHeight(loco::Position& positionWorldToLocationInWorldFrame) const;
+
+  /*! Gets the height of the terrain at the coordinate (positionWorldToLocationInWorldFrame(), positionWorldToLocationInWorldFrame())
+   * (in world frame) and sets heightInWorldFrame as the height (in world frame).
+   * @param[in] positionWorldToLocationInWorldFrame   position from origin of world frame to the requested location expressed in world frame
+   * @param[out] heightInWorldFrame   height in world frame evaluated at position positionWorldToLocationInWorldFrame
+   * @return true if the position is inside the map, false otherwise
+   */
+  virtual bool getHeight(const loco::Position& positionWorldToLocationInWorldFrame, double& heightInWorldFrame) const;
+
+  /*! Return friction coefficient for a foot at a certain position.
+   * @param[in] positionWorldToLocationInWorldFrame position from origin of world frame to the requested location expressed in world frame
+   * @param[out] frictionCoefficient friction coefficient of the closest cell
+   * @return true if the position is inside the map, false otherwise
+   */
+  virtual bool getFrictionCoefficientForFoot(const loco::Position& positionWorldToLocationInWorldFrame, double& frictionCoefficient) const;
+
+  /*! Projects a position along the surface normal onto the tangent plane of the terrain below the position.
+   * @param positionInWorldFrame  position to project
+   * @returns projected position
+   */
+  virtual Position getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& positionInWorldFrame) const;
+
+  /*! Distance of a position to the tangent plane of the terrain below the position.
+   * @param positionInWorldFrame  position
+   * @returns distance along the surface normal
+   */
+  virtual double getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const;
+
+  /*! Batch queries, evaluated without virtual dispatch per point.
+   */
+  virtual bool getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const;
+  virtual bool getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const;
+  virtual bool getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const;
+
+  /*! Centers the local map at a position. Tiles that enter the map are reset to the default height.
+   * @param positionWorldToCenterInWorldFrame   new center of the map (only x and y are used)
+   */
+  void moveTo(const loco::Position& positionWorldToCenterInWorldFrame);
+
+  /*! Updates the map with a measured foothold. The cells within the foot radius are filtered towards the
+   * measured height and the normals of the affected cells are recomputed.
+   * @param positionWorldToFootholdInWorldFrame  measured position of the foot on the ground
+   * @returns false if the foothold is outside of the map
+   */
+  bool addFootholdMeasurement(const loco::Position& positionWorldToFootholdInWorldFrame);
+
+  /*! Sets the height of the cell at a position and updates the normals of its neighbors.
+   * @returns false if the position is outside of the map
+   */
+  bool setHeight(const loco::Position& positionWorldToLocationInWorldFrame, double heightInWorldFrame);
+
+  /*! Sets the friction coefficient of the cell at a position.
+   * @returns false if the position is outside of the map
+   */
+  bool setFrictionCoefficient(const loco::Position& positionWorldToLocationInWorldFrame, double frictionCoefficient);
+
+  /*! Loads a map from a binary map file. The file is memory-mapped and copied into the tiles, the
+   * local map is resized and centered such that it covers the whole file.
+   * @param filename  path of the map file
+   * @returns true if successful
+   */
+  bool loadFromFile(const std::string& filename);
+
+  /*! Saves the local map to a binary map file.
+   * @param filename  path of the map file
+   * @returns true if successful
+   */
+  bool saveToFile(const std::string& filename) const;
+
+  //! @returns true if the x-y coordinates of the position are inside of the local map
+  bool isInside(const loco::Position& positionWorldToLocationInWorldFrame) const;
+
+  void setInterpolationMethod(InterpolationMethod method);
+  InterpolationMethod getInterpolationMethod() const;
+
+  void setDefaultHeight(double height);
+  double getDefaultHeight() const;
+
+  void setDefaultFrictionCoefficient(double frictionCoefficient);
+  double getDefaultFrictionCoefficient() const;
+
+  /*! Sets the parameters of the foothold update.
+   * @param footRadius  radius around the foothold in which the cells are updated [m]
+   * @param filterGain  gain of the first-order filter towards the measured height (1: overwrite)
+   */
+  void setFootholdUpdateParameters(double footRadius, double filterGain);
+
+  double getResolution() const;
+  int getNumberOfCellsX() const;
+  int getNumberOfCellsY() const;
+
+ protected:
+  //! Cells of a tile, stored as structure of arrays
+  struct Tile {
+    float height_[tileSize*tileSize];
+    float normalX_[tileSize*tileSize];
+    float normalY_[tileSize*tileSize];
+    float normalZ_[tileSize*tileSize];
+    float friction_[tileSize*tileSize];
+  };
+
+  void resize(int numberOfTilesX, int numberOfTilesY);
+  void clearTile(Tile& tile);
+
+  //! Global index of the cell whose sample is closest to the lower left of the coordinate
+  long getCellIndexX(double x) const;
+  long getCellIndexY(double y) const;
+  bool isCellInside(long i, long j) const;
+  long clampCellIndexX(long i) const;
+  long clampCellIndexY(long j) const;
+
+  //! Tile and offset inside the tile of a cell that is inside the map
+  Tile& getTile(long i, long j);
+  const Tile& getTile(long i, long j) const;
+  int getCellOffset(long i, long j) const;
+
+  //! Height of a cell, clamped to the border of the map
+  double getCellHeight(long i, long j) const;
+
+  //! Recomputes the normals of the cells in [iMin, iMax] x [jMin, jMax] by central differences
+  void updateNormals(long iMin, long iMax, long jMin, long jMax);
+
+  double getHeightBilinear(double x, double y) const;
+  double getHeightBicubic(double x, double y) const;
+
+  //! Height and normal of the tangent plane below the position
+  void getTangentPlane(const Position& positionInWorldFrame, Position& pointOnPlane, Vector& normal) const;
+
+ protected:
+  double resolution_;
+  int numberOfTilesX_;
+  int numberOfTilesY_;
+
+  //! Global index of the tile at the lower left corner of the map
+  long originTileIndexX_;
+  long originTileIndexY_;
+
+  std::vector<Tile> tiles_;
+
+  InterpolationMethod interpolationMethod_;
+  double defaultHeight_;
+  double defaultFrictionCoefficient_;
+  double footRadius_;
+  double footholdFilterGain_;
+
+  //! True if the map was loaded from a file and should not be reset by initialize()
+  bool isMapLoaded_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_TERRAINMODELHEIGHTMAP_HPP_ */
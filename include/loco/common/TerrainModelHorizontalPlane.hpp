@@ -96,6 +96,10 @@ class TerrainModelHorizontalPlane: public TerrainModelBase {
   virtual Position getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& positionInWorldFrame) const;
   virtual double getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const;
 
+  virtual bool getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const;
+  virtual bool getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const;
+  virtual bool getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const;
+
  protected:
   //! Height of the horizontal plane expressed in world frame
   double heightInWorldFrame_;
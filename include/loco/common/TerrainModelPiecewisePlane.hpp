@@ -0,0 +1,152 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainModelPiecewisePlane.hpp
+ */
+
+#ifndef LOCO_TERRAINMODELPIECEWISEPLANE_HPP_
+#define LOCO_TERRAINMODELPIECEWISEPLANE_HPP_
+
+#include "loco/common/TerrainModelBase.hpp"
+#include "loco/common/RegionHashTable.hpp"
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <vector>
+
+namespace loco {
+
+//! Terrain model given by local planes on a grid of square regions in the x-y plane of the world frame
+/*! Each region (i, j) covers [i*regionSize, (i+1)*regionSize) x [j*regionSize, (j+1)*regionSize) and may
+ *  have a plane z = d - a*x - b*y with the parameters [a b d]^T. The planes are stored in a preallocated
+ *  hash table, hence a query is O(1) and setting a plane does not allocate memory. A position in a region without plane uses the plane of the closest of the eight
+ *  neighboring regions and the default plane if none of them has a plane.
+ */
+class TerrainModelPiecewisePlane: public TerrainModelBase {
+ public:
+  /*! Constructor
+   * @param regionSize              side length of a region [m]
+   * @param maximumNumberOfPlanes   maximal number of regions with a plane
+   */
+  TerrainModelPiecewisePlane(double regionSize = 0.3, int maximumNumberOfPlanes = 256);
+  virtual ~TerrainModelPiecewisePlane();
+
+  /*! Removes all local planes and sets the default plane to the horizontal plane at zero height.
+   * @param dt  time step
+   * @returns true
+   */
+  virtual bool initialize(double dt);
+
+  /*! Gets the surface normal of the local plane at a certain position.
+   * @param[in] positionWorldToLocationInWorldFrame the place to get the surface normal from (in the world frame)
+   * @param[out] normalInWorldFrame the surface normal (in the world frame)
+   * @return true if a local plane was found, false if the default plane was used
+   */
+  virtual bool getNormal(const loco::Position& positionWorldToLocationInWorldFrame, loco::Vector& normalInWorldFrame) const;
+
+  /*! Gets the height of the local plane at the coordinate (positionWorldToLocationInWorldFrame(), positionWorldToLocationInWorldFrame())
+   * (in world frame) and sets the position.z() as the height (in world frame).
+   * @param[in/out] positionWorldToLocationInWorldFrame   position from origin of world frame to the requested location expressed in world frame
+   * @return true if a local plane was found, false if the default plane was used
+   */
+  virtual bool getHeight(loco::Position& positionWorldToLocationInWorldFrame) const;
+
+  /*! Gets the height of the local plane at the coordinate (positionWorldToLocationInWorldFrame(), positionWorldToLocationInWorldFrame())
+   * (in world frame) and sets heightInWorldFrame as the height (in world frame).
+   * @param[in] positionWorldToLocationInWorldFrame   position from origin of world frame to the requested location expressed in world frame
+   * @param[out] heightInWorldFrame   height in world frame evaluated at position positionWorldToLocationInWorldFrame
+   * @return true if a local plane was found, false if the default plane was used
+   */
+  virtual bool getHeight(const loco::Position& positionWorldToLocationInWorldFrame, double& heightInWorldFrame) const;
+
+  /*! Return friction coefficient for a foot at a certain position.
+   * @param[in] positionWorldToLocationInWorldFrame position from origin of world frame to the requested location expressed in world frame
+   * @param[out] frictionCoefficient friction coefficient evaluated at the given position
+   * @return true
+   */
+  virtual bool getFrictionCoefficientForFoot(const loco::Position& positionWorldToLocationInWorldFrame, double& frictionCoefficient) const;
+
+  virtual Position getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& positionInWorldFrame) const;
+  virtual double getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const;
+
+  /*! Sets the plane of a region.
+   * @param i, j        index of the region
+   * @param parameters  parameters [a b d]^T of the plane z = d - a*x - b*y
+   * @returns false if the maximal number of planes is reached
+   */
+  bool setPlane(long i, long j, const Eigen::Vector3d& parameters);
+
+  //! Removes the plane of a region
+  void removePlane(long i, long j);
+
+  //! Removes the planes of all regions
+  void clearPlanes();
+
+  //! Sets the maximal number of regions with a plane, the planes are removed
+  void setMaximumNumberOfPlanes(int maximumNumberOfPlanes);
+
+  /*! Sets the plane that is used far from all local planes.
+   * @param parameters  parameters [a b d]^T of the plane z = d - a*x - b*y
+   */
+  void setDefaultPlane(const Eigen::Vector3d& parameters);
+
+  void setFrictionCoefficient(double frictionCoefficient);
+
+  //! @returns index of the region that contains the coordinate
+  long getRegionIndex(double coordinate) const;
+
+  //! @returns key of the region (i, j) in the hash maps
+  static int64_t getRegionKey(long i, long j);
+
+  double getRegionSize() const;
+  int getNumberOfPlanes() const;
+  int getMaximumNumberOfPlanes() const;
+
+ protected:
+  //! @returns parameters of the plane that models the terrain at the position, and whether it is a local plane
+  const Eigen::Vector3d& getPlane(const Position& positionInWorldFrame, bool& isLocalPlane) const;
+
+ protected:
+  double regionSize_;
+  double frictionCoefficientBetweenTerrainAndFoot_;
+  Eigen::Vector3d defaultPlane_;
+  //! Slot of the plane of each region
+  RegionHashTable planeSlots_;
+  std::vector<Eigen::Vector3d> planes_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_TERRAINMODELPIECEWISEPLANE_HPP_ */
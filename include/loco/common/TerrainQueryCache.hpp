@@ -0,0 +1,107 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainQueryCache.hpp
+ */
+
+#ifndef LOCO_TERRAINQUERYCACHE_HPP_
+#define LOCO_TERRAINQUERYCACHE_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+#include "loco/common/LegGroup.hpp"
+#include "loco/common/TerrainModelBase.hpp"
+
+#include <vector>
+
+namespace loco {
+
+//! Terrain queries at the feet and hips of all legs, evaluated once per control tick
+/*! The locomotion controller updates the cache after the terrain perception and invalidates it when
+ *  new measurements arrive. The stages (foot placement, contact force distribution, ...) look up the
+ *  results by leg id instead of querying the terrain model for the same points several times.
+ *  Stages have to fall back to the terrain model if the cache is not valid.
+ */
+class TerrainQueryCache {
+ public:
+  TerrainQueryCache(LegGroup* legs, TerrainModelBase* terrain);
+  virtual ~TerrainQueryCache();
+
+  /*! Evaluates the terrain at the current feet and hips with the batch queries of the terrain model.
+   * @returns true if all queries were successful
+   */
+  bool update();
+
+  //! Marks the cached values as outdated, e.g. when the measured state of the legs changed
+  void invalidate();
+
+  //! @returns true if the values were updated since the last invalidation
+  bool isValid() const;
+
+  //! Height of the terrain below the foot
+  double getHeightAtFootInWorldFrame(int legId) const;
+
+  //! Surface normal of the terrain at the foot
+  const Vector& getNormalAtFootInWorldFrame(int legId) const;
+
+  //! Friction coefficient of the terrain at the foot
+  double getFrictionCoefficientAtFoot(int legId) const;
+
+  //! Hip projected on the terrain along the z-axis of the world frame
+  const Position& getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(int legId) const;
+
+  //! Hip projected on the terrain along the surface normal
+  const Position& getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(int legId) const;
+
+  TerrainModelBase* getTerrainModel();
+
+ protected:
+  LegGroup* legs_;
+  TerrainModelBase* terrain_;
+  bool isValid_;
+
+  //! Query points and results, indexed by leg id
+  std::vector<Position> positionsWorldToFootInWorldFrame_;
+  std::vector<Position> positionsWorldToHipInWorldFrame_;
+  std::vector<double> heightsAtFootInWorldFrame_;
+  std::vector<Vector> normalsAtFootInWorldFrame_;
+  std::vector<double> frictionCoefficientsAtFoot_;
+  std::vector<double> heightsAtHipInWorldFrame_;
+  std::vector<Position> positionsWorldToHipOnTerrainAlongWorldZInWorldFrame_;
+  std::vector<Position> positionsWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_TERRAINQUERYCACHE_HPP_ */
@@ -43,11 +43,34 @@
 #include "ContactForceDistributionBase.hpp"
 #include "loco/common/LegBase.hpp"
 #include "loco/common/TorsoBase.hpp"
+#include "loco/common/ParameterSchema.hpp"
 #include <Eigen/SparseCore>
 #include "tinyxml.h"
 
 namespace loco {
 
+//! Parameters of the contact force distribution
+/*! The values are read from the parameter file by the schema and used by the distribution as they are.
+ * The friction coefficient and the load factor are only initial values of the legs.
+ */
+struct ContactForceDistributionParameters {
+  ContactForceDistributionParameters();
+
+  //! Diagonal elements of the weighting matrix for the desired virtual forces (heading, lateral, vertical) and torques (roll, pitch, yaw).
+  double virtualForceWeights_[6];
+  //! Diagonal element of the weighting matrix for the ground reaction forces (regularizer).
+  double groundForceWeight_;
+  //! Friction coefficient of all legs.
+  double frictionCoefficient_;
+  //! Minimal normal ground force (in N).
+  double minimalNormalGroundForce_;
+  //! Desired load factor of all legs.
+  double loadFactor_;
+
+  //! @returns the schema to read the parameters from the XML file
+  static const ParameterSchema<ContactForceDistributionParameters>& getSchema();
+};
+
 //! This class distributes a virtual force and torque on the base as forces to the leg contact points.
 /*!
  * Based on 'Control of Dynamic Gaits for a Quadrupedal Robot', C. Gehring, ICRA, 2013.
@@ -80,6 +103,8 @@ class ContactForceDistribution : public ContactForceDistributionBase
     Vector normalDirectionOfFrictionPyramidInWorldFrame_;
     //! Assumed friction coefficient (mu).
     double frictionCoefficient_;
+    //! Surface normal at the foot, queried once per computation.
+    Vector footContactNormalInWorldFrame_;
 
   };
 
@@ -129,6 +154,7 @@ class ContactForceDistribution : public ContactForceDistributionBase
    double getGroundForceWeight() const;
    double getMinimalNormalGroundForce() const;
    double getVirtualForceWeight(int index) const;
+   const ContactForceDistributionParameters& getParameters() const;
 
    const Vector& getFirstDirectionOfFrictionPyramidInWorldFrame(LegBase* leg) const;
    const Vector& getSecondDirectionOfFrictionPyramidInWorldFrame(LegBase* leg) const;
@@ -139,8 +165,14 @@ class ContactForceDistribution : public ContactForceDistributionBase
 
    const LegInfo& getLegInfo(LegBase* leg) const;
 
+   virtual bool getGroundReactionForceInWorldFrame(LegBase* leg, Force& forceInWorldFrame) const;
+
+   virtual bool computeJointTorquesFromGroundReactionForces(const Force* groundReactionForcesInWorldFrame);
+
    virtual bool setToInterpolated(const ContactForceDistributionBase& contactForceDistribution1, const ContactForceDistributionBase& contactForceDistribution2, double t);
 
+   virtual bool addParametersToVector(ParameterVector* parameterVector);
+
    const LegGroup* getLegs() const;
  private:
   //! Number of legs in stance phase
@@ -148,12 +180,8 @@ class ContactForceDistribution : public ContactForceDistributionBase
   //! Number of variables to optimize (size of x, n = nTranslationalDofPerFoot_ * nLegsInStance_)
   int n_;
 
-  //! Diagonal elements of the weighting matrix for the desired virtual forces and torques (for S).
-  Eigen::Matrix<double, nElementsVirtualForceTorqueVector_, 1> virtualForceWeights_;
-  //! Diagonal element of the weighting matrix for the ground reaction forces (regularizer, for W).
-  double groundForceWeight_;
-  //! Minimal normal ground force (F_min^n, in N).
-  double minimalNormalGroundForce_;
+  //! Weights (for S and W) and minimal normal ground force (F_min^n), the parameter vector points into this struct.
+  ContactForceDistributionParameters parameters_;
 
   //! Stacked contact forces (in base frame)
   Eigen::VectorXd x_;
@@ -186,6 +214,13 @@ private:
    */
   bool prepareLegLoading();
 
+  /*!
+   * Gets the surface normals at the feet of the legs in the force distribution,
+   * from the terrain query cache if it is valid and with one batch query otherwise.
+   * @return true if successful.
+   */
+  bool updateFootContactNormals();
+
   /*!
    * Prepare matrices for the optimization problem.
    * @return true if successful
@@ -193,6 +228,9 @@ private:
   bool prepareOptimization(const Force& virtualForce,
                            const Torque& virtualTorque);
 
+  //! Updates the weighting matrix S after the virtual force weights have been changed.
+  void updateVirtualForceWeights();
+
 
   bool addMinimalForceConstraints();
 
@@ -44,7 +44,9 @@
 #include "loco/common/TorsoBase.hpp"
 #include "loco/common/LegGroup.hpp"
 #include "loco/common/TerrainModelBase.hpp"
+#include "loco/common/TerrainQueryCache.hpp"
 #include "tinyxml.h"
+#include "loco/common/ParameterVector.hpp"
 
 #include <memory>
 
@@ -107,6 +109,32 @@ class ContactForceDistributionBase
     */
    virtual bool setToInterpolated(const ContactForceDistributionBase& contactForceDistribution1, const ContactForceDistributionBase& contactForceDistribution2, double t);
 
+   /*! Adds the continuous parameters to the parameter vector of the locomotion controller,
+    * which interpolates them during gait transitions.
+    * @param parameterVector   parameter vector
+    * @returns true if successful
+    */
+   virtual bool addParametersToVector(ParameterVector* parameterVector);
+
+   /*! Sets the per-tick terrain queries shared with the other stages of the locomotion controller.
+    * @param terrainQueryCache   cache that is updated by the locomotion controller (nullptr to query the terrain directly)
+    */
+   void setTerrainQueryCache(const TerrainQueryCache* terrainQueryCache);
+
+   /*! Gets the distributed force of the ground on the foot of a leg.
+    * @param leg                    leg
+    * @param[out] forceInWorldFrame ground reaction force expressed in world frame
+    * @returns false if the force distribution was not computed or the leg is not part of it
+    */
+   virtual bool getGroundReactionForceInWorldFrame(LegBase* leg, Force& forceInWorldFrame) const;
+
+   /*! Applies ground reaction forces that were computed elsewhere, e.g. by a model-predictive controller,
+    * instead of distributing a virtual force and torque.
+    * @param groundReactionForcesInWorldFrame   force of the ground on the foot of each leg (indexed by the id of the leg)
+    * @returns true if the joint torques were computed
+    */
+   virtual bool computeJointTorquesFromGroundReactionForces(const Force* groundReactionForcesInWorldFrame);
+
  protected:
   constexpr static int nLegs_ = 4; // TODO move to robotModel
   constexpr static int nTranslationalDofPerFoot_ = 3; // TODO move to robotModel
@@ -116,6 +144,9 @@ class ContactForceDistributionBase
   std::shared_ptr<LegGroup> legs_;
   std::shared_ptr<loco::TerrainModelBase> terrain_;
 
+  //! Per-tick terrain queries, only used if valid
+  const TerrainQueryCache* terrainQueryCache_;
+
   //! True if parameters are successfully loaded.
   bool isParametersLoaded_;
 
@@ -49,6 +49,8 @@
 
 #include <Eigen/Core>
 #include <tinyxml.h>
+#include "loco/common/ParameterVector.hpp"
+#include "loco/common/TerrainQueryCache.hpp"
 
 namespace loco {
 
@@ -85,9 +87,31 @@ public:
    */
 	virtual bool setToInterpolated(const FootPlacementStrategyBase& footPlacementStrategy1, const FootPlacementStrategyBase& footPlacementStrategy2, double t);
 
+  /*! Adds the continuous parameters to the parameter vector of the locomotion controller,
+   * which interpolates them during gait transitions. setToInterpolated only needs to handle the remaining parameters.
+   * @param parameterVector   parameter vector
+   * @returns true if successful
+   */
+	virtual bool addParametersToVector(ParameterVector* parameterVector);
+
+  /*! Sets the per-tick terrain queries shared with the other stages of the locomotion controller.
+   * @param terrainQueryCache   cache that is updated by the locomotion controller (nullptr to query the terrain directly)
+   */
+	void setTerrainQueryCache(const TerrainQueryCache* terrainQueryCache);
+
+  /*! Gets the planned foothold of a leg, i.e. where the foot touches down at the end of the current or next swing phase.
+   * @param legId                 id of the leg
+   * @param[out] positionWorldToFootHoldInWorldFrame   foothold
+   * @returns false if the strategy does not plan footholds
+   */
+	virtual bool getPositionWorldToFootHoldInWorldFrame(int legId, Position& positionWorldToFootHoldInWorldFrame) const;
+
 protected:
 	bool isFirstTimeInit_;
 
+	//! Per-tick terrain queries, only used if valid
+	const TerrainQueryCache* terrainQueryCache_;
+
 };
 
 } // namespace loco
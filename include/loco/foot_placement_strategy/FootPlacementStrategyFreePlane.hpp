@@ -47,6 +47,9 @@
 #include "loco/common/LegGroup.hpp"
 
 #include "loco/foot_placement_strategy/FootPlacementStrategyInvertedPendulum.hpp"
+#include "loco/foot_placement_strategy/FootholdOptimizer.hpp"
+#include "loco/foot_placement_strategy/SwingFootClearancePlanner.hpp"
+#include "loco/foot_placement_strategy/FootstepPreviewPlanner.hpp"
 
 #include "tinyxml.h"
 #include <Eigen/Core>
@@ -60,15 +63,76 @@
 
 namespace loco {
 
+  //! Quantities that all legs share within a control tick
+  /*! The context is evaluated once at the beginning of FootPlacementStrategyFreePlane::advance and
+   *  invalidated at its end. The per-leg computations fall back to the torso and the terrain model
+   *  if they are called outside of advance.
+   */
+  struct FootPlacementContext {
+    FootPlacementContext():
+      isValid_(false)
+    {
+
+    }
+    bool isValid_;
+    RotationQuaternion orientationWorldToControl_;
+    RotationQuaternion orientationWorldToBase_;
+    //! heading component of the desired velocity in world frame
+    LinearVelocity linearVelocityDesiredHeadingInWorldFrame_;
+    //! measured velocity of the base in world frame
+    LinearVelocity linearVelocityBaseInWorldFrame_;
+    Position positionWorldToHipOnTerrainAlongWorldZInWorldFrame_[4];
+    Position positionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_[4];
+    Position positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame_[4];
+    Vector normalAtFootInWorldFrame_[4];
+  };
+
   class FootPlacementStrategyFreePlane: public FootPlacementStrategyInvertedPendulum {
 
    public:
     FootPlacementStrategyFreePlane(LegGroup* legs, TorsoBase* torso, loco::TerrainModelBase* terrain);
     virtual ~FootPlacementStrategyFreePlane();
 
+    virtual bool loadParameters(const TiXmlHandle& handle);
     virtual bool advance(double dt);
     virtual bool initialize(double dt);
 
+    /*! Sets the optimizer that moves the nominal foot holds to better terrain (nullptr disables it).
+     * The foot hold is optimized at lift-off and again if the nominal foot hold moves farther than
+     * the threshold (see setFootholdReoptimizationThreshold).
+     * The optimizer is not owned by the foot placement strategy.
+     */
+    virtual void setFootholdOptimizer(FootholdOptimizer* footholdOptimizer);
+    FootholdOptimizer* getFootholdOptimizer();
+
+    //! Sets the distance the nominal foot hold has to move before it is optimized again [m]
+    void setFootholdReoptimizationThreshold(double threshold);
+    double getFootholdReoptimizationThreshold() const;
+
+    /*! Sets the planner that checks the polynomial swing trajectory against the terrain at lift-off (nullptr disables it).
+     * The planner is not owned by the foot placement strategy.
+     */
+    virtual void setSwingFootClearancePlanner(SwingFootClearancePlanner* swingFootClearancePlanner);
+    SwingFootClearancePlanner* getSwingFootClearancePlanner();
+
+    /*! Sets the planner that previews the next footsteps of each leg (nullptr disables it).
+     * If set, the desired foot hold is the first planned step instead of the inverted pendulum foot hold.
+     * The planner is not owned by the foot placement strategy.
+     */
+    virtual void setFootstepPreviewPlanner(FootstepPreviewPlanner* footstepPreviewPlanner);
+    FootstepPreviewPlanner* getFootstepPreviewPlanner();
+
+    //! Returns the result of the clearance check of the current swing.
+    const SwingFootClearanceResult& getSwingFootClearance(const LegBase& leg) const;
+
+    //! Returns true if the swing foot will hit the terrain even with the raised apex.
+    bool isSwingFootCollisionPredicted(const LegBase& leg) const;
+
+    //! nominal foot holds before the optimization
+    Position positionWorldToNominalFootHoldInWorldFrame_[4];
+    //! offsets from the nominal to the optimized foot holds (x-y)
+    Position positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[4];
+
     Position positionWorldToHipOnPlaneAlongNormalInWorldFrame_[4];
     Position positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInWorldFrame_[4];
     Position positionDesiredFootOnTerrainToDesiredFootInWorldFrame_[4];
@@ -78,13 +142,31 @@ namespace loco {
 
     Position positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[4];
 
+    //! Returns the context of the current control tick.
+    const FootPlacementContext& getContext() const;
+
    protected:
 
+    //! Evaluates the shared quantities of the current control tick.
+    virtual void updateContext();
+
+    //! Marks the context as outdated, the per-leg computations query the torso and the terrain model again.
+    void invalidateContext();
+
+    //! Orientation of the control frame, taken from the context if it is valid
+    const RotationQuaternion& getOrientationWorldToControl() const;
+
+    //! Orientation of the base, taken from the context if it is valid
+    const RotationQuaternion& getOrientationWorldToBase() const;
+
+    //! Surface normal at the current foot, taken from the context if it is valid
+    Vector getNormalAtFootInWorldFrame(const LegBase& leg);
+
     /*! Compute and return the current desired foot position in world frame.
      * @params[in] leg The leg relative to the desired foot.
      * @returns The desired foot position in world frame.
      */
-    virtual Position getDesiredWorldToFootPositionInWorldFrame(LegBase* leg, double tinyTimeStep);
+    virtual Position getDesiredWorldToFootPositionInWorldFrame(LegBase* leg);
 
 
     /*! Project a point on a plane along the plane's normal.
@@ -93,9 +175,41 @@ namespace loco {
      */
     virtual Position getPositionProjectedOnPlaneAlongSurfaceNormal(const Position& position);
 
+    /*! Project the current hip of a leg on the terrain along the z-axis of the world frame.
+     * Uses the terrain query cache if it is valid.
+     */
+    Position getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(const LegBase& leg);
+
+    /*! Project the current hip of a leg on the terrain along the surface normal.
+     * Uses the terrain query cache if it is valid.
+     */
+    Position getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(const LegBase& leg);
+
 
     virtual Position getPositionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame(const LegBase& leg);
 
+    /*! Evaluate the desired foot hold (feed forward and feedback component)
+     * @params[in] leg The leg relative the to the desired foot hold.
+     * @returns The position from the hip projected on the terrain to the desired foot hold in control frame.
+     */
+    virtual Position getPositionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame(const LegBase& leg);
+
+    /*! Evaluate the nominal foot hold, i.e. the desired foot hold before the optimization.
+     * Updates positionWorldToNominalFootHoldInWorldFrame_.
+     * @params[in] leg The leg relative the to the nominal foot hold.
+     * @returns The position from the hip projected on the terrain to the nominal foot hold in control frame.
+     */
+    virtual Position getPositionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame(const LegBase& leg);
+
+    //! Returns the measured position of the center of mass of the torso.
+    Position getPositionWorldToCenterOfMassInWorldFrame() const;
+
+    /*! Plans the swing trajectory at lift-off and re-fits it if the desired foot hold moved.
+     * @params[in] leg The swing leg.
+     * @params[in] positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame The desired foot hold.
+     */
+    virtual void updateSwingFootTrajectory(const LegBase& leg, const Position& positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame);
+
     /*! Return the height component of the desired foot position in control frame.
      * @params[in] leg The desired foot's leg.
      * @params[in] positionHipOnTerrainToDesiredFootOnTerrainInControlFrame Position of the projection of the hip according to the desired configuration (from telescopic to lever)
@@ -134,6 +248,16 @@ namespace loco {
      */
     virtual Position getOffsetDesiredFootOnTerrainToCorrectedFootOnTerrainInControlFrame(const LegBase& leg);
 
+    //! Updates the footstep preview of all legs with the desired twist and the timing of the gait.
+    virtual void planFootsteps();
+
+    /*! Optimizes the foot holds of the swing legs in parallel around their current nominal foot holds.
+     * A foot hold is optimized at lift-off and whenever its nominal foot hold has moved farther than
+     * footholdReoptimizationThreshold_ since the last optimization.
+     * The offsets are applied in getPositionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame.
+     */
+    virtual void optimizeFootHolds();
+
 
     /*! 0: telescopic
      *  1: lever
@@ -141,6 +265,28 @@ namespace loco {
      */
     double telescopicLeverConfiguration_;
 
+    FootholdOptimizer* footholdOptimizer_;
+    //! indicates if a feasible foot hold of the leg was found since lift-off
+    bool isFootHoldOptimized_[4];
+    //! indicates if the optimizer was run since lift-off
+    bool isFootHoldOptimizationDone_[4];
+    //! nominal foot holds of the last optimization
+    Position positionWorldToOptimizedNominalFootHoldInWorldFrame_[4];
+    //! distance the nominal foot hold has to move before it is optimized again [m]
+    double footholdReoptimizationThreshold_;
+    std::vector<FootholdOptimizationProblem> footholdOptimizationProblems_;
+    std::vector<FootholdOptimizationResult> footholdOptimizationResults_;
+    std::vector<int> footholdOptimizationLegIds_;
+
+    SwingFootClearancePlanner* swingFootClearancePlanner_;
+    SwingFootClearanceResult swingFootClearanceResults_[4];
+
+    FootstepPreviewPlanner* footstepPreviewPlanner_;
+    //! support state of the legs at the last preview, used to detect touch-downs
+    bool wasSupportLeg_[4];
+
+    FootPlacementContext context_;
+
   };
 
 } /* namespace loco */
@@ -47,6 +47,7 @@
 #include "loco/common/LegGroup.hpp"
 
 #include "loco/foot_placement_strategy/FootPlacementStrategyBase.hpp"
+#include "loco/foot_placement_strategy/SwingFootTrajectoryPolynomial.hpp"
 
 #include "tinyxml.h"
 #include <Eigen/Core>
@@ -56,6 +57,7 @@
 #include "kindr/rotations/RotationEigen.hpp"
 #include "robotUtils/loggers/logger.hpp"
 #include "loco/common/TerrainModelBase.hpp"
+#include "loco/common/ParameterSchema.hpp"
 
 //#include "PeriodicRBF1DC3.hpp"
 //#include "PeriodicRBF1DC1.hpp"
@@ -63,7 +65,25 @@
 
 namespace loco {
 
-
+//! Parameters of the inverted pendulum foot placement strategy
+/*! The values are read from the parameter file by the schema. The offsets are the initial default stepping positions
+ * of the legs, the right legs are mirrored.
+ */
+struct FootPlacementStrategyInvertedPendulumParameters {
+  FootPlacementStrategyInvertedPendulumParameters();
+
+  //! scale of the inverted pendulum feedback for the stepping location
+  double stepFeedbackScale_;
+  //! default stepping offset of the left fore leg from the hip (heading, lateral) in control frame
+  double offsetFore_[2];
+  //! default stepping offset of the left hind leg from the hip (heading, lateral) in control frame
+  double offsetHind_[2];
+  //! distance the desired foot hold has to move before the swing trajectory is re-fitted [m]
+  double swingFootTrajectoryRefitThreshold_;
+
+  //! @returns the schema to read the parameters from the XML file
+  static const ParameterSchema<FootPlacementStrategyInvertedPendulumParameters>& getSchema();
+};
 
 //! This class implements a push recovery strategy based on the inverted pendulum.
 /*! Each leg computes independently the next foothold location.
@@ -101,9 +121,22 @@ public:
   * @returns true if successful
   */
   virtual bool setToInterpolated(const FootPlacementStrategyBase& footPlacementStrategy1, const FootPlacementStrategyBase& footPlacementStrategy2, double t);
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
   const LegGroup& getLegs() const;
 
   const Position& getPositionWorldToDesiredFootHoldInWorldFrame(LegBase* leg) const;
+  virtual bool getPositionWorldToFootHoldInWorldFrame(int legId, Position& positionWorldToFootHoldInWorldFrame) const;
+
+  /*! Returns the desired velocity of the swing foot relative to the hip expressed in world frame.
+   * Only available if the swing trajectory is planned by polynomials, zero otherwise.
+   * The same feedforward is passed to the leg (see LegBase::getDesiredLinearVelocityHipToFootInWorldFrame).
+   */
+  const LinearVelocity& getLinearVelocityHipToDesiredFootInWorldFrame(const LegBase& leg) const;
+
+  /*! Returns the desired acceleration of the swing foot relative to the hip expressed in world frame.
+   * Only available if the swing trajectory is planned by polynomials, zero otherwise.
+   */
+  const LinearAcceleration& getLinearAccelerationHipToDesiredFootInWorldFrame(const LegBase& leg) const;
 public:
   //! Reference to the legs
   LegGroup* legs_;
@@ -118,20 +151,51 @@ public:
 	//! and this swing-phase based trajectory is used to control the desired swing foot position (interpolating between initial location of the step, and final target) during swing.
 	Trajectory1D stepInterpolationFunction_;
 
-	//! this value is used to scale the default feedback contribution for the stepping location
-	double stepFeedbackScale_;
+	//! feedback scale for the stepping location and the other scalar parameters, the parameter vector points into this struct
+	FootPlacementStrategyInvertedPendulumParameters parameters_;
 
   //! trajectory of the height of the swing foot above ground over the swing phase
   SwingFootHeightTrajectory swingFootHeightTrajectory_;
 
+  //! lookup state of the trajectories for each leg, the legs are at different phases of the trajectories
+  TrajectoryCursor stepInterpolationFunctionCursors_[4];
+  TrajectoryCursor swingFootHeightTrajectoryCursors_[4];
+
+  LinearVelocity linearVelocityHipToDesiredFootInWorldFrame_[4];
+  LinearAcceleration linearAccelerationHipToDesiredFootInWorldFrame_[4];
+
 protected:
+  //! if true (default), the swing trajectory is planned by polynomials at lift-off instead of interpolating at each time step
+  bool isUsingSwingFootTrajectoryPolynomial_;
+  SwingFootTrajectoryPolynomial swingFootTrajectories_[4];
+  //! indicates if the swing trajectory needs to be planned, set at lift-off
+  bool isSwingFootTrajectoryToBePlanned_[4];
+
   /*! Gets the foot position for the swing leg
-   *
+   * If the swing trajectory is planned by polynomials, the desired velocity and acceleration of the foot are set as well.
    * @param leg reference to the leg
-   * @param tinyTimeStep  tiny time step in the future to compute the desired velocities
-   * @return
+   * @return desired foot position in world frame
+   */
+  virtual Position getDesiredWorldToFootPositionInWorldFrame(LegBase* leg);
+
+  /*! Plans the swing trajectory at lift-off and re-fits it if the desired foot hold moved.
+   * The horizontal components are measured from the hip to the foot, the height is the height in control frame.
+   * @param leg The swing leg.
+   * @param positionHipToDesiredFootHoldInControlFrame The desired foot hold.
+   */
+  virtual void updateSwingFootTrajectory(const LegBase& leg, const Position& positionHipToDesiredFootHoldInControlFrame);
+
+  //! Returns the time since lift-off and the duration of the remaining swing phase.
+  virtual void getSwingTimes(const LegBase& leg, double& time, double& duration);
+
+  /*! Takes the heights at lift-off, apex and touch-down of the swing trajectory from the knots of the height trajectory.
+   * @param leg The swing leg.
+   * @param[out] heightStart   height at lift-off
+   * @param[out] heightApex    highest knot inside the swing phase
+   * @param[out] heightTarget  height at touch-down
+   * @param[out] apexPhase     swing phase of the apex, 0.5 if no knot is higher than the start
    */
-  virtual Position getDesiredWorldToFootPositionInWorldFrame(LegBase* leg, double tinyTimeStep);
+  void getSwingFootHeights(const LegBase& leg, double& heightStart, double& heightApex, double& heightTarget, double& apexPhase);
 
 	double getLateralComponentOfFootStep(double phase, double initialStepOffset, double stepGuess, LegBase* leg);
 	double getHeadingComponentOfFootStep(double phase, double initialStepOffset, double stepGuess, LegBase* leg);
@@ -50,16 +50,8 @@
 #include "loco/common/TerrainModelBase.hpp"
 #include "loco/common/LegGroup.hpp"
 
-
-/****************************
- * Includes for ROS service *
- ****************************/
-//#undef USE_ROS_SERVICE
-//#define USE_ROS_SERVICE
-#ifdef USE_ROS_SERVICE
-#include "RosService.hpp"
-#endif
-/****************************/
+#include "loco/foot_placement_strategy/FootholdValidatorBase.hpp"
+#include "loco/foot_placement_strategy/FootholdValidatorTerrainModel.hpp"
 
 
 namespace loco {
@@ -72,7 +64,7 @@ class FootPlacementStrategyStaticGait: public FootPlacementStrategyFreePlane {
   virtual bool advance(double dt);
   virtual bool initialize(double dt);
 
-  virtual Position getDesiredWorldToFootPositionInWorldFrame(LegBase* leg, double tinyTimeStep);
+  virtual Position getDesiredWorldToFootPositionInWorldFrame(LegBase* leg);
   virtual Position getPositionFootAtLiftOffToDesiredFootHoldInControlFrame(const LegBase& leg);
   virtual Position getPositionDesiredFootHoldOrientationOffsetInWorldFrame(const LegBase& leg, const Position& positionWorldToDesiredFootHoldBeforeOrientationOffsetInWorldFrame);
   virtual Position getPositionWorldToValidatedDesiredFootHoldInWorldFrame(int legId) const;
@@ -85,16 +77,20 @@ class FootPlacementStrategyStaticGait: public FootPlacementStrategyFreePlane {
 
   virtual bool loadParameters(const TiXmlHandle& handle);
 
-  virtual bool isUsingRosService();
-  virtual void setUseRosService(bool useRosService);
+  virtual bool isUsingFootholdValidation();
+  virtual void setUseFootholdValidation(bool useFootholdValidation);
 
-  std::vector<Position> positionWorldToInterpolatedFootPositionInWorldFrame_;
+  /*! Sets the validator of the generated footholds (e.g. a ROS service).
+   * The validator is not owned by the foot placement strategy. By default, the footholds are validated
+   * against the terrain model by an owned FootholdValidatorTerrainModel, which is configured with
+   * FootPlacementStrategy/StaticGait/FootholdValidation. Passing nullptr restores the default validator.
+   * If the worker thread of the validator is not running, the requests are processed in advance().
+   */
+  virtual void setFootholdValidator(FootholdValidatorBase* footholdValidator);
+  FootholdValidatorBase* getFootholdValidator();
 
+  std::vector<Position> positionWorldToInterpolatedFootPositionInWorldFrame_;
 
-#ifdef USE_ROS_SERVICE
-  robotUtils::RosService footholdRosService_;
-#endif
-  int serviceTestCounter_;
 
  protected:
 
@@ -103,9 +99,13 @@ class FootPlacementStrategyStaticGait: public FootPlacementStrategyFreePlane {
   bool goToStand_, resumeWalking_;
   bool mustValidateNextFootHold_;
   bool validationRequestSent_,validationReceived_;
-  bool useRosService_;
-  double rosWatchdogCounter_;
-  double rosWatchdogLimit_;
+  bool useFootholdValidation_;
+  //! Value of useFootholdValidation_ after initialization, from the parameter file
+  bool useFootholdValidationOnInitialize_;
+  FootholdValidatorBase* footholdValidator_;
+  FootholdValidatorTerrainModel* terrainModelFootholdValidator_;
+  //! Leg of the foothold that is being validated
+  int validatingLegId_;
 
   int footStepNumber_;
 
@@ -128,6 +128,16 @@ class FootPlacementStrategyStaticGait: public FootPlacementStrategyFreePlane {
 
   virtual Position generateFootHold(LegBase* leg);
 
+  /*! Generates the foothold of the next swing leg and starts its validation. The CoM control gets the
+   * foothold only once it is validated, until then it plans with the previous foothold of the leg.
+   */
+  virtual void planFootHold(LegBase* leg);
+
+  /*! Sends the validation request, polls the response and passes the validated foothold to the CoM control.
+   * If no response arrives before the late swing phase of the current swing leg, the generated foothold is used.
+   */
+  virtual void updateFootHoldValidation(const LegBase& currentSwingLeg);
+
   virtual bool getValidatedFootHold(const int legId, const Position& positionWorldToDesiredFootHoldInWorldFrame);
 
   virtual bool sendValidationRequest(const int legId, const Position& positionWorldToDesiredFootHoldInWorldFrame);
@@ -0,0 +1,230 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdOptimizer.hpp
+* @brief
+*/
+#ifndef LOCO_FOOTHOLDOPTIMIZER_HPP_
+#define LOCO_FOOTHOLDOPTIMIZER_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+#include "loco/common/TerrainModelBase.hpp"
+
+#include <Eigen/Core>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace loco {
+
+struct FootholdOptimizationProblem {
+  FootholdOptimizationProblem():
+    numberOfSupportFeet_(0),
+    hasPreviousFoothold_(false)
+  {
+
+  }
+
+  //! Foothold of the foot placement strategy, the candidates are sampled around it
+  Position positionWorldToNominalFootholdInWorldFrame_;
+  //! Hip of the leg, used for the kinematic reachability
+  Position positionWorldToHipInWorldFrame_;
+  //! Feet that support the robot together with the new foothold (support polygon margin is skipped with less than two)
+  Position positionWorldToSupportFeetInWorldFrame_[4];
+  int numberOfSupportFeet_;
+  //! Point whose margin in the support polygon is maximized (e.g. the center of mass)
+  Position positionWorldToCenterOfMassInWorldFrame_;
+  //! Optimal foothold of the last call, used to avoid jumping between candidates
+  Position positionWorldToPreviousFootholdInWorldFrame_;
+  bool hasPreviousFoothold_;
+};
+
+struct FootholdOptimizationResult {
+  //! Best candidate or the nominal foothold if no candidate is feasible
+  Position positionWorldToFootholdInWorldFrame_;
+  double cost_;
+  //! False if no feasible candidate has been found
+  bool isFeasible_;
+  //! Number of candidates whose terrain has been evaluated within the time budget
+  int numberOfEvaluatedCandidates_;
+};
+
+//! Selects footholds from a grid of candidates around the nominal footholds
+/*! The terrain is sampled on a square grid (with one additional ring of samples) around the nominal foothold.
+ *  All costs are computed with array operations over the whole grid:
+ *    - slope:          1 - z-component of the surface normal
+ *    - roughness:      largest deviation of the four grid neighbours from the tangent plane
+ *    - edge distance:  distance to the closest sample with a height step larger than the edge height
+ *    - reachability:   distance from the hip relative to the maximal leg length
+ *    - support margin: margin of the center of mass in the convex hull of the support feet and the candidate
+ *    - distance to the nominal (and the previous) foothold
+ *  Candidates are infeasible if the terrain is unknown, too steep or too rough, closer to an edge than the
+ *  foot radius or out of reach.
+ *
+ *  The terrain is sampled row by row starting at the nominal foothold. Rows that are not sampled before the
+ *  time budget elapses are infeasible, so the optimizer always returns within the budget (plus one row).
+ *
+ *  Several legs are optimized in parallel on a pool of worker threads. The terrain model is only read
+ *  while optimize() is running.
+ */
+class FootholdOptimizer {
+ public:
+  FootholdOptimizer(TerrainModelBase* terrain);
+  virtual ~FootholdOptimizer();
+
+  /*! Sets the grid of candidates.
+   * @param spacing     distance between two candidates [m]
+   * @param halfWidth   number of candidates on each side of the nominal foothold
+   */
+  bool setGrid(double spacing, int halfWidth);
+
+  /*! Sets the feasibility limits.
+   * @param maxSlope        largest inclination of the terrain [rad]
+   * @param maxRoughness    largest deviation from the tangent plane [m]
+   * @param edgeHeight      height step that is considered as an edge [m]
+   * @param footRadius      smallest distance to an edge [m]
+   * @param maxLegLength    largest distance from the hip to the foothold [m]
+   */
+  bool setLimits(double maxSlope, double maxRoughness, double edgeHeight, double footRadius, double maxLegLength);
+
+  /*! Sets the weights of the costs.
+   * @param edgeClearance   distance to an edge from which on the edge cost vanishes [m]
+   * @param supportMargin   margin of the support polygon from which on the support cost vanishes [m]
+   */
+  void setWeights(double distanceWeight, double slopeWeight, double roughnessWeight,
+                  double edgeWeight, double edgeClearance,
+                  double reachabilityWeight, double supportMarginWeight, double supportMargin,
+                  double previousFootholdWeight);
+
+  //! Sets the time budget of one call of optimize() [s]
+  void setTimeBudget(double timeBudget);
+  double getTimeBudget() const;
+
+  //! Sets the number of threads (including the calling thread) that optimize the legs in parallel
+  void setNumberOfThreads(int numberOfThreads);
+  int getNumberOfThreads() const;
+
+  int getNumberOfCandidates() const;
+
+  //! Optimizes the foothold of one leg.
+  bool optimize(const FootholdOptimizationProblem& problem, FootholdOptimizationResult& result);
+
+  //! Optimizes the footholds of several legs in parallel.
+  bool optimize(const std::vector<FootholdOptimizationProblem>& problems, std::vector<FootholdOptimizationResult>& results);
+
+ protected:
+  typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic> Grid;
+  typedef std::chrono::steady_clock Clock;
+
+  //! Memory of the optimization of one leg
+  struct Workspace {
+    std::vector<Position> positions_;
+    std::vector<double> heights_;
+    std::vector<Vector> normals_;
+    Grid height_;
+    Grid normalX_;
+    Grid normalY_;
+    Grid normalZ_;
+    Grid isValid_;
+    Grid roughness_;
+    Grid edgeDistanceSquared_;
+    Grid cost_;
+  };
+
+  void resizeWorkspace(Workspace& workspace) const;
+  void sampleTerrain(const FootholdOptimizationProblem& problem, Workspace& workspace, int& numberOfSampledRows) const;
+  void optimizeLeg(const FootholdOptimizationProblem& problem, FootholdOptimizationResult& result, Workspace& workspace) const;
+  double getSupportMargin(const FootholdOptimizationProblem& problem, double x, double y) const;
+
+  void startWorkers(int numberOfWorkers);
+  void stopWorkers();
+  void work();
+  void runJobs();
+
+ protected:
+  TerrainModelBase* terrain_;
+
+  double spacing_;
+  int halfWidth_;
+  //! Offsets of the samples from the nominal foothold (including the additional ring)
+  Grid offsetX_;
+  Grid offsetY_;
+  //! Order in which the rows are sampled
+  std::vector<int> rowOrder_;
+
+  double minNormalZ_;
+  double maxRoughness_;
+  double edgeHeight_;
+  double footRadius_;
+  double maxLegLength_;
+
+  double distanceWeight_;
+  double slopeWeight_;
+  double roughnessWeight_;
+  double edgeWeight_;
+  double edgeClearance_;
+  double reachabilityWeight_;
+  double supportMarginWeight_;
+  double supportMargin_;
+  double previousFootholdWeight_;
+
+  double timeBudget_;
+  Clock::time_point deadline_;
+
+  std::vector<Workspace> workspaces_;
+
+  //--- worker pool
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable jobsAvailable_;
+  std::condition_variable jobsDone_;
+  int generation_;
+  bool isStopping_;
+  const std::vector<FootholdOptimizationProblem>* problems_;
+  std::vector<FootholdOptimizationResult>* results_;
+  int numberOfJobs_;
+  int numberOfActiveWorkers_;
+  std::atomic<int> nextJob_;
+  std::atomic<int> numberOfDoneJobs_;
+  //---
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_FOOTHOLDOPTIMIZER_HPP_ */
@@ -0,0 +1,143 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdValidatorBase.hpp
+* @brief
+*/
+#ifndef LOCO_FOOTHOLDVALIDATORBASE_HPP_
+#define LOCO_FOOTHOLDVALIDATORBASE_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+#include "loco/temp_helpers/LockFreeQueue.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace loco {
+
+//! Result of a foothold validation
+enum FootholdValidationFlag {
+  FootholdUnknown=0,      // the validator has no information, the foothold may be used
+  FootholdDoNotChange,    // the foothold must not be changed
+  FootholdVerified,       // the (adapted) foothold is safe
+  FootholdBad             // no safe foothold has been found
+};
+
+struct FootholdValidationRequest {
+  int legId_;
+  //! Number of the step, the response carries the same number
+  int stepNumber_;
+  Position positionWorldToDesiredFootHoldInWorldFrame_;
+  //! Slot of the data prepared by prepareRequest(), set by sendRequest()
+  int slot_;
+};
+
+struct FootholdValidationResponse {
+  int legId_;
+  int stepNumber_;
+  FootholdValidationFlag flag_;
+  Position positionWorldToValidatedFootHoldInWorldFrame_;
+  //! Cost of the validated foothold (lower is better)
+  double cost_;
+};
+
+//! Asynchronous foothold validation
+/*! The control thread sends requests with sendRequest() and polls the responses with receiveResponse().
+ *  Neither call allocates, locks or blocks: requests and responses are passed through single-producer
+ *  single-consumer lock-free queues.
+ *
+ *  The requests are validated either on a worker thread (start()/stop()) or on the calling thread with
+ *  processRequests(), which makes the validation deterministic for testing and benchmarking.
+ *  The transport (in-process, ROS service, ...) is implemented by the derived class in validateFoothold(),
+ *  which is always called on the thread that processes the requests. Data that the control thread modifies,
+ *  e.g. the terrain model, must not be read there, but copied in prepareRequest() on the sending thread.
+ */
+class FootholdValidatorBase {
+ public:
+  FootholdValidatorBase();
+  virtual ~FootholdValidatorBase();
+
+  //! Starts the worker thread that processes the requests.
+  bool start();
+  //! Stops and joins the worker thread.
+  void stop();
+  bool isRunning() const;
+
+  //! Prepares and queues a request. Returns false if the request queue is full or the request could not be prepared.
+  bool sendRequest(const FootholdValidationRequest& request);
+  //! Returns true and pops the oldest response if one has been completed.
+  bool receiveResponse(FootholdValidationResponse& response);
+
+  /*! Validates all queued requests on the calling thread.
+   * @returns number of processed requests, or -1 if the worker thread is running
+   */
+  int processRequests();
+
+  //! Discards all queued requests and responses. Must not be called while the worker thread is running.
+  void clear();
+
+ protected:
+  static const int queueCapacity_ = 8;
+  //! Number of requests that can be queued or processed at the same time, one more is being prepared
+  static const int numberOfRequestSlots_ = queueCapacity_+2;
+
+  /*! Prepares a request on the thread that sends it before it is queued, e.g. takes a snapshot of the data
+   * that validateFoothold() needs. The default implementation does nothing.
+   * @param request   request whose slot_ in [0, numberOfRequestSlots_) identifies the prepared data
+   * @returns false if the request cannot be sent
+   */
+  virtual bool prepareRequest(const FootholdValidationRequest& request);
+
+  /*! Validates a single foothold.
+   * @returns false if the request could not be processed, no response is sent in this case
+   */
+  virtual bool validateFoothold(const FootholdValidationRequest& request, FootholdValidationResponse& response) = 0;
+
+ private:
+  int processQueuedRequests();
+  void work();
+
+ private:
+  LockFreeQueue<FootholdValidationRequest, queueCapacity_> requestQueue_;
+  LockFreeQueue<FootholdValidationResponse, queueCapacity_> completionQueue_;
+  std::thread worker_;
+  std::atomic<bool> isRunning_;
+  //! Slot of the next request, only used by the sending thread
+  int nextSlot_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_FOOTHOLDVALIDATORBASE_HPP_ */
@@ -0,0 +1,125 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdValidatorTerrainModel.hpp
+* @brief
+*/
+#ifndef LOCO_FOOTHOLDVALIDATORTERRAINMODEL_HPP_
+#define LOCO_FOOTHOLDVALIDATORTERRAINMODEL_HPP_
+
+#include "loco/foot_placement_strategy/FootholdValidatorBase.hpp"
+#include "loco/common/TerrainModelBase.hpp"
+
+#include <vector>
+
+namespace loco {
+
+//! In-process foothold validation against a terrain model
+/*! The candidates are the desired foothold and the points on rings around it up to the search radius.
+ *  A candidate is admissible if the terrain model knows its height, the slope, the roughness (largest height
+ *  deviation from the tangent plane at four points at the foot radius) and the friction coefficient are within
+ *  their limits.
+ *  Of the admissible candidates the one with the lowest cost
+ *    distanceWeight*distance + slopeWeight*(1-normalZ) + roughnessWeight*roughness
+ *  is returned. If none is admissible, the response is flagged as bad.
+ *
+ *  The terrain model is modified by the terrain perception on the control thread. Hence the terrain at the
+ *  candidates is sampled into a snapshot when the request is sent, and the candidates are evaluated on the
+ *  snapshot, which can be done on the worker thread.
+ */
+class FootholdValidatorTerrainModel: public FootholdValidatorBase {
+ public:
+  FootholdValidatorTerrainModel(TerrainModelBase* terrain);
+  virtual ~FootholdValidatorTerrainModel();
+
+  /*! Sets the parameters of the search.
+   * @param searchRadius      largest distance of a candidate to the desired foothold [m]
+   * @param searchResolution  distance between the rings of candidates [m]
+   * @param footRadius        distance of the points that are used to evaluate the roughness [m]
+   * @param maxRoughness      largest admissible height difference within the foot radius [m]
+   * @param maxSlope          largest admissible inclination of the terrain [rad]
+   * @param minFriction       smallest admissible friction coefficient
+   * @returns false if the parameters are invalid
+   */
+  bool setParameters(double searchRadius, double searchResolution, double footRadius,
+                     double maxRoughness, double maxSlope, double minFriction);
+  void setCostWeights(double distanceWeight, double slopeWeight, double roughnessWeight);
+
+  int getNumberOfCandidates() const;
+
+ protected:
+  //! Terrain at the candidates of a request
+  struct TerrainSnapshot {
+    //! height of the terrain at the candidates, NaN if unknown
+    std::vector<double> heights_;
+    //! surface normals at the candidates
+    std::vector<Vector> normals_;
+    //! friction coefficients at the candidates, NaN if unknown
+    std::vector<double> frictionCoefficients_;
+    //! heights at the four points at the foot radius around each candidate, NaN if unknown
+    std::vector<double> heightsAround_;
+  };
+
+  //! Samples the terrain at the candidates, called on the control thread by sendRequest()
+  virtual bool prepareRequest(const FootholdValidationRequest& request);
+  virtual bool validateFoothold(const FootholdValidationRequest& request, FootholdValidationResponse& response);
+
+  /*! Evaluates a candidate.
+   * @param snapshot                              terrain at the candidates
+   * @param candidate                             index of the candidate
+   * @param positionWorldToCandidateInWorldFrame  candidate, the height is set to the height of the terrain
+   * @param cost                                  cost of the candidate
+   * @returns true if the candidate is admissible
+   */
+  bool evaluateCandidate(const TerrainSnapshot& snapshot, int candidate, Position& positionWorldToCandidateInWorldFrame, double& cost) const;
+
+ protected:
+  TerrainModelBase* terrain_;
+  //! Snapshots of the terrain, one for each request slot
+  std::vector<TerrainSnapshot> snapshots_;
+  //! Offsets of the candidates from the desired foothold, the first one is zero
+  std::vector<Position> candidateOffsets_;
+  double footRadius_;
+  double maxRoughness_;
+  double minNormalZ_;
+  double minFriction_;
+  double distanceWeight_;
+  double slopeWeight_;
+  double roughnessWeight_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_FOOTHOLDVALIDATORTERRAINMODEL_HPP_ */
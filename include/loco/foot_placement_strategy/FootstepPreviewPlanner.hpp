@@ -0,0 +1,171 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootstepPreviewPlanner.hpp
+* @brief
+*/
+#ifndef LOCO_FOOTSTEPPREVIEWPLANNER_HPP_
+#define LOCO_FOOTSTEPPREVIEWPLANNER_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+
+#include <Eigen/Core>
+
+namespace loco {
+
+//! State of the robot and of one leg at the time of planning
+struct FootstepPreviewInput {
+  FootstepPreviewInput():
+    angularVelocityDesiredZ_(0.0),
+    heightCenterOfMass_(0.45),
+    gravity_(9.81),
+    timeToTouchDown_(0.0),
+    strideDuration_(0.8),
+    didTouchDown_(false)
+  {
+
+  }
+  Position positionWorldToCenterOfMassInWorldFrame_;
+  LinearVelocity linearVelocityCenterOfMassInWorldFrame_;
+  //! desired velocity of mission control (the z-component is ignored)
+  LinearVelocity linearVelocityDesiredInWorldFrame_;
+  //! desired yaw rate of mission control
+  double angularVelocityDesiredZ_;
+  //! height of the center of mass above the terrain
+  double heightCenterOfMass_;
+  double gravity_;
+  //! time until the next touch-down of the leg (the preview of the gait)
+  double timeToTouchDown_;
+  //! time between two touch-downs of the leg
+  double strideDuration_;
+  //! nominal foothold relative to the center of mass (hip offset and default stepping offset)
+  Position positionCenterOfMassToNominalFootHoldInWorldFrame_;
+  //! true if the leg touched down since the last plan, the previous plan is shifted by one step
+  bool didTouchDown_;
+};
+
+//! Plans the next footsteps of each leg with a linear inverted pendulum
+/*! The center of mass is modelled as a linear inverted pendulum that pivots about the point u_k while the
+ *  leg is between its k-th and (k+1)-th touch-down (one stride T). The foothold of step k is the pivot plus
+ *  the nominal offset of the leg, p_k = u_k + r_k, where r_k and the desired velocity are rotated by the
+ *  desired yaw rate. The center of mass keeps its current velocity until the first touch-down.
+ *
+ *  The pivots of the K steps minimize
+ *
+ *    sum_k  wv*|v_(k+1) - v_des,k|^2                 (reach the desired velocity after each step)
+ *         + wn*|u_k - x_k - d*v_des,k|^2             (stay close to the neutral point)
+ *         + ws*|u_k - u_(k-1) - 2*d*v_des,k|^2       (regular step lengths)
+ *
+ *  with d = tanh(omega*T/2)/omega, for which walking with the desired velocity is a periodic solution.
+ *
+ *  The states are affine in the pivots, so this is a linear least-squares problem with K unknowns. The x and
+ *  y axes share the same normal matrix. The problem is solved exactly (Cholesky) when a leg is planned for the
+ *  first time. Afterwards, the previous plan is shifted by one step at touch-down and refined by a few
+ *  conjugate gradient iterations per tick, which keeps the cost per tick bounded.
+ */
+class FootstepPreviewPlanner {
+ public:
+  static const int maxNumberOfSteps = 8;
+
+  FootstepPreviewPlanner();
+  virtual ~FootstepPreviewPlanner();
+
+  /*! Sets the number of planned steps per leg, resets all plans.
+   * @returns false if the number is not in [1, maxNumberOfSteps]
+   */
+  bool setNumberOfSteps(int numberOfSteps);
+  int getNumberOfSteps() const;
+
+  //! Sets the weights of the cost terms, the neutral point weight has to be positive.
+  void setWeights(double velocityWeight, double neutralPointWeight, double stepLengthWeight);
+
+  //! Sets the number of conjugate gradient iterations per tick (the plan is exact after numberOfSteps iterations)
+  void setNumberOfIterations(int numberOfIterations);
+
+  //! Discards the plan of a leg, the next plan is solved exactly
+  void reset(int legId);
+  void reset();
+
+  /*! Updates the plan of a leg.
+   * @returns false if the input is invalid
+   */
+  bool plan(int legId, const FootstepPreviewInput& input);
+
+  //! @returns true if the leg has a plan
+  bool hasPlan(int legId) const;
+
+  /*! Returns a planned foothold.
+   * @param legId   leg
+   * @param step    0 for the next foothold
+   */
+  Position getPositionWorldToFootHoldInWorldFrame(int legId, int step) const;
+
+  //! Returns the predicted velocity of the center of mass after the step.
+  LinearVelocity getLinearVelocityCenterOfMassInWorldFrame(int legId, int step) const;
+
+ protected:
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 3*maxNumberOfSteps, maxNumberOfSteps> Matrix;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, maxNumberOfSteps, maxNumberOfSteps> NormalMatrix;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 2, 0, 3*maxNumberOfSteps, 2> Vectors;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 2, 0, maxNumberOfSteps, 2> Plan;
+
+  //! Shifts the plan of a leg by one step and extrapolates the last step.
+  void shift(int legId, const Eigen::Vector2d& stepLength);
+
+  //! Refines the solution of H*u = g with conjugate gradient iterations, starting from u.
+  void solveConjugateGradient(const NormalMatrix& H, const Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfSteps, 1>& g,
+                              Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfSteps, 1>& u) const;
+
+  int numberOfSteps_;
+  int numberOfIterations_;
+  double velocityWeight_;
+  double neutralPointWeight_;
+  double stepLengthWeight_;
+
+  //! pivots, footholds and predicted velocities of the legs (rows: steps, columns: x and y)
+  Plan pivots_[4];
+  Plan footHolds_[4];
+  Plan velocities_[4];
+  double heightFootHolds_[4];
+  bool hasPlan_[4];
+
+  //! least-squares problem, M*u = b for both axes
+  Matrix M_;
+  Vectors b_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_FOOTSTEPPREVIEWPLANNER_HPP_ */
@@ -0,0 +1,141 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     SwingFootClearancePlanner.hpp
+* @brief
+*/
+#ifndef LOCO_SWINGFOOTCLEARANCEPLANNER_HPP_
+#define LOCO_SWINGFOOTCLEARANCEPLANNER_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+#include "loco/common/TerrainModelBase.hpp"
+
+#include <vector>
+
+namespace loco {
+
+struct SwingFootClearanceResult {
+  SwingFootClearanceResult():
+    heightApex_(0.0),
+    isApexRaised_(false),
+    numberOfPredictedCollisions_(0),
+    phaseOfFirstPredictedCollision_(1.0),
+    minClearance_(0.0),
+    isColliding_(false)
+  {
+
+  }
+  //! apex height that clears the terrain (or the maximal apex height)
+  double heightApex_;
+  bool isApexRaised_;
+  //! number of samples that would touch the terrain with the nominal apex height
+  int numberOfPredictedCollisions_;
+  //! swing phase of the first sample that would touch the terrain with the nominal apex height
+  double phaseOfFirstPredictedCollision_;
+  //! smallest clearance along the swing path with the planned apex height [m]
+  double minClearance_;
+  //! true if the terrain cannot be cleared by raising the apex
+  bool isColliding_;
+};
+
+//! Checks the planned swing path against the terrain and raises the apex where needed
+/*! The swing path is the one of SwingFootTrajectoryPolynomial: the foot moves on a minimum-jerk path from lift-off to
+ *  the foothold, the height above the straight line from lift-off to foothold consists of two minimum-jerk
+ *  polynomials that meet at the apex. The height along the path is therefore linear in the apex height,
+ *
+ *    height(s) = a(s) + w(s)*heightApex,
+ *
+ *  and the lowest apex height that keeps the desired clearance at all samples is found in closed form. The desired
+ *  clearance is scaled by w(s), i.e. it is reached at the apex and vanishes at lift-off and touch-down. The terrain
+ *  is queried once per plan with a batch query. Samples at the very beginning and end of the swing cannot be lifted
+ *  by the apex (w(s) is small); terrain there is reported as a collision.
+ *
+ *  The height is measured along the world z-axis, which is a good approximation of the normal of the free plane
+ *  for moderate slopes.
+ */
+class SwingFootClearancePlanner {
+ public:
+  SwingFootClearancePlanner(TerrainModelBase* terrain);
+  virtual ~SwingFootClearancePlanner();
+
+  /*! Sets the number of samples along the swing path (including lift-off and touch-down).
+   * @returns false if less than 3 samples are requested
+   */
+  bool setNumberOfSamples(int numberOfSamples);
+  int getNumberOfSamples() const;
+
+  /*! Sets the limits.
+   * @param clearance       desired distance between the foot and the terrain at the apex [m]
+   * @param maxHeightApex   the apex is not raised beyond this height [m]
+   */
+  bool setLimits(double clearance, double maxHeightApex);
+
+  /*! Checks the swing path and computes the apex height.
+   * @param positionWorldToFootAtLiftOffInWorldFrame   foot position at lift-off
+   * @param positionWorldToFootHoldInWorldFrame        predicted foothold
+   * @param heightStart       height at lift-off above the path
+   * @param heightApex        nominal apex height
+   * @param heightTarget      height at touch-down above the path
+   * @param apexPhase         swing phase in (0,1) at which the apex is reached
+   * @param result            planned apex height and predicted collisions
+   * @returns false if the terrain cannot be cleared
+   */
+  bool plan(const Position& positionWorldToFootAtLiftOffInWorldFrame, const Position& positionWorldToFootHoldInWorldFrame,
+            double heightStart, double heightApex, double heightTarget, double apexPhase,
+            SwingFootClearanceResult& result);
+
+ protected:
+  //! minimum-jerk profile from 0 to 1
+  static double getMinimumJerkProfile(double phase);
+
+  //! height of the swing profile at the phase is offset + weight*heightApex
+  static void getHeightProfile(double phase, double apexPhase, double heightStart, double heightTarget,
+                               double& offset, double& weight);
+
+  TerrainModelBase* terrain_;
+  int numberOfSamples_;
+  double clearance_;
+  double maxHeightApex_;
+  //! samples with a smaller weight of the apex height are not lifted by the apex
+  double minWeightApex_;
+
+  std::vector<Position> positions_;
+  std::vector<double> heights_;
+  std::vector<bool> isValid_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_SWINGFOOTCLEARANCEPLANNER_HPP_ */
@@ -0,0 +1,111 @@
+/*******************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     SwingFootTrajectoryPolynomial.hpp
+* @brief
+*/
+#ifndef LOCO_SWINGFOOTTRAJECTORYPOLYNOMIAL_HPP_
+#define LOCO_SWINGFOOTTRAJECTORYPOLYNOMIAL_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+#include "loco/temp_helpers/QuinticPolynomial.hpp"
+
+namespace loco {
+
+//! Swing foot trajectory made of closed-form quintic polynomials
+/*! The trajectory is planned once at lift-off. The horizontal components (x, y) are minimum-jerk polynomials
+ *  from the lift-off position to the predicted foothold. The height (z) consists of two minimum-jerk polynomials
+ *  that meet at the apex.
+ *
+ *  If the predicted foothold moves by more than a threshold during the swing, the horizontal polynomials are
+ *  re-fitted from the current position, velocity and acceleration to the new foothold over the remaining time.
+ *  Hence, the trajectory stays continuous up to the acceleration.
+ *
+ *  The positions are expressed in an arbitrary frame (e.g. hip on terrain to foot in control frame), the time
+ *  is measured in seconds since lift-off.
+ */
+class SwingFootTrajectoryPolynomial {
+ public:
+  SwingFootTrajectoryPolynomial();
+  virtual ~SwingFootTrajectoryPolynomial();
+
+  /*! Plans the trajectory from the current state of the foot.
+   * If the trajectory is planned after lift-off (time > 0), the polynomials start at the given time with zero velocity
+   * and acceleration. If the apex has already been passed, the height goes straight to the target height.
+   * @param time              current time since lift-off [s]
+   * @param duration          duration of the swing phase [s]
+   * @param positionStart     current position of the foot, the height (z) is ignored
+   * @param positionTarget    predicted foothold, the height (z) is ignored
+   * @param heightStart       current height
+   * @param heightApex        height at apex
+   * @param heightTarget      height at touch-down
+   * @param apexPhase         swing phase in (0,1) at which the apex is reached
+   */
+  void plan(double time, double duration,
+            const Position& positionStart, const Position& positionTarget,
+            double heightStart, double heightApex, double heightTarget, double apexPhase);
+
+  /*! Re-fits the horizontal polynomials if the target moved by more than the threshold.
+   * @param time              current time since lift-off [s]
+   * @param positionTarget    predicted foothold, the height (z) is ignored
+   * @param threshold         distance the target has to move before the trajectory is re-fitted [m]
+   * @returns true if the trajectory has been re-fitted
+   */
+  bool updateTarget(double time, const Position& positionTarget, double threshold);
+
+  Position getPosition(double time) const;
+  LinearVelocity getLinearVelocity(double time) const;
+  LinearAcceleration getLinearAcceleration(double time) const;
+
+  const Position& getPositionTarget() const;
+  double getDuration() const;
+
+ protected:
+  double duration_;
+  //! time at which the horizontal polynomials start
+  double timeStartHorizontal_;
+  //! time at which the height polynomial towards the apex starts
+  double timeStartHeight_;
+  //! time at which the apex is reached
+  double timeApex_;
+  Position positionTarget_;
+  QuinticPolynomial horizontal_[2];
+  QuinticPolynomial heightToApex_;
+  QuinticPolynomial heightFromApex_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_SWINGFOOTTRAJECTORYPOLYNOMIAL_HPP_ */
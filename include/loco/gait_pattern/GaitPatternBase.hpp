@@ -44,6 +44,7 @@
 #define LOCO_GAITPATTERNBASE_HPP_
 
 #include "tinyxml.h"
+#include "loco/common/ParameterVector.hpp"
 
 namespace loco {
 
@@ -177,6 +178,13 @@ public:
   */
   virtual bool setToInterpolated(const GaitPatternBase& gaitPattern1, const GaitPatternBase& gaitPattern2, double t);
 
+  /*! Adds the continuous parameters to the parameter vector of the locomotion controller,
+   * which interpolates them during gait transitions. setToInterpolated only needs to handle the remaining parameters.
+   * @param parameterVector   parameter vector
+   * @returns true if successful
+   */
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
+
 protected:
   std::string name_;
 };
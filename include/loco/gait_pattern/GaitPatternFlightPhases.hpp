@@ -148,6 +148,7 @@ class GaitPatternFlightPhases: public GaitPatternBase {
       correspond to interpolated gaits.
     */
     virtual bool setToInterpolated(const GaitPatternBase& gaitPattern1, const GaitPatternBase& gaitPattern2, double t);
+    virtual bool addParametersToVector(ParameterVector* parameterVector);
 
     void clear();
 
@@ -172,6 +173,15 @@ class GaitPatternFlightPhases: public GaitPatternBase {
 
     std::vector<FootFallPattern> stepPatterns_;
 
+    //! parameter vector that holds the addresses of the foot fall patterns or nullptr
+    ParameterVector* parameterVector_;
+
+    //! @returns the addresses of the stride duration and the phases of the foot fall patterns
+    std::vector<double*> getContinuousParameters();
+
+    //! Registers the addresses of the foot fall patterns again after they have been reallocated
+    void updateParametersInVector();
+
  protected:
     /*!
       Given a "circular" domain:
@@ -42,12 +42,18 @@
 #ifndef LOCO_GaitSwitcherDynamicGaitDefault_HPP_
 #define LOCO_GaitSwitcherDynamicGaitDefault_HPP_
 
+#include "loco/common/BackgroundJobQueue.hpp"
 #include "loco/common/ParameterSet.hpp"
+#include "loco/common/ParameterFileWatcher.hpp"
 #include "loco/gait_switcher/GaitSwitcherBase.hpp"
 #include "loco/gait_switcher/GaitTransition.hpp"
 #include "loco/locomotion_controller/LocomotionControllerDynamicGaitDefault.hpp"
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <boost/ptr_container/ptr_vector.hpp>
 
 #include "starlethModel/RobotModel.hpp"
@@ -56,6 +62,14 @@ namespace loco {
 
 class GaitSwitcherDynamicGaitDefault: public GaitSwitcherBase {
  public:
+  //! State of the parameter set that is loaded in the background
+  enum ParameterSetLoadingState {
+    Idle,     // the loader thread is idle
+    Loading,  // the loader thread loads a parameter set and the parameters of its transitions
+    Ready,    // the parameter set is loaded and will be swapped in at the next tick without transition
+    Failed    // the parameter set could not be loaded
+  };
+
   GaitSwitcherDynamicGaitDefault(robotModel::RobotModel* robotModel,
                                  robotTerrain::TerrainBase* terrain,
                                  double dt);
@@ -75,20 +89,136 @@ class GaitSwitcherDynamicGaitDefault: public GaitSwitcherBase {
   void setAutoTransition(bool isActive);
   bool isTransiting();
 
-  /*! Transit to another gait given by the name of the parameter file
+  /*! Transit to another gait given by the name of the parameter file.
+   * The parameter files are never parsed by the control thread. If the parameters of the gaits are not loaded yet,
+   * they are requested from the loader thread and the transition starts once they are available.
    * @param name  filename of the parameter set
    * @return  true if the gait transition is valid
    */
   bool transitToGait(const std::string& name);
   bool loadParameterSet(int parameterSetIdx);
 
+  /*! Parses and validates a parameter set and loads the parameters of all its transitions on a loader thread.
+   * The controller is initialized and replaces the current one at the beginning of the next call of advance() when no
+   * transition is active, since its initialization reads the robot model.
+   * A running prefetch of gait parameters is cancelled and the parameter set is loaded right after it.
+   * @param parameterSetIdx index of the parameter set
+   * @return  true if the loading has been started, false if another parameter set is being loaded
+   */
+  bool loadParameterSetAsync(int parameterSetIdx);
+  ParameterSetLoadingState getParameterSetLoadingState() const;
+
+  //! @returns the progress of the parameter set loading in [0,1]
+  double getParameterSetLoadingProgress() const;
+
+  /*! Watches the parameter files for modifications. A modified file is parsed and validated on a reloader thread.
+   * Only the parameters of a gait that are also interpolated by the transitions, i.e. the continuous parameters and
+   * the height trajectories, can be modified while the controller is running. A file that modifies other parameters,
+   * e.g. the selection of a module or the number of foot fall patterns, or that adds or removes elements is rejected
+   * and the modified parameters are printed. Invalid files are rejected as well.
+   * Accepted parameters are swapped in at the beginning of the next call of advance() when no transition is active:
+   * if the file belongs to the current gait, the values are written into the modules of the running controller,
+   * hence the gait phase, the filters and the terrain are kept. The parameters of the gait transitions are replaced as well.
+   * @return  true if the parameter directory is watched
+   */
+  bool startParameterHotReload();
+  void stopParameterHotReload();
+  bool isParameterHotReloadOn() const;
+
   bool interpolateParameters(double t);
 
   LocomotionControllerDynamicGaitDefault* getLocomotionController();
 
  private:
-  bool getLocomotionControllerByName(const std::string& name, LocomotionControllerDynamicGaitDefault* loco);
+  /*! Returns the parameters of a gait. The parameter file is parsed on first use and the parameters are shared by all transitions.
+   * This must only be called by the loader thread.
+   * @param name  name of the gait
+   * @return  the parameters or nullptr if they could not be loaded
+   */
+  std::shared_ptr<const GaitParameters> getGaitParameters(const std::string& name);
+
+  /*! Parses a parameter file into the parameters of a gait, runs on the loader or reloader thread.
+   * The controller that parses the file is destroyed afterwards, only the parameters are kept.
+   * @param name                name of the gait
+   * @param parameterFilePath   path to the parameter file
+   * @param parameterCache      cache of the precompiled parameter files or nullptr to parse the file
+   * @param document            if not null, the parameters are parsed from this version of the file instead
+   * @return  the parameters or nullptr if the file is invalid
+   */
+  std::shared_ptr<const GaitParameters> parseGaitParameters(const std::string& name,
+                                                            const std::string& parameterFilePath,
+                                                            const ParameterCache* parameterCache,
+                                                            const TiXmlDocument* document = nullptr) const;
+
+  /*! Returns the parameters of a gait if they have been loaded, never parses a parameter file.
+   * @param name  name of the gait
+   * @param[out] isFailed   true if the parameter file could not be loaded
+   * @return  the parameters or nullptr if they are not available
+   */
+  std::shared_ptr<const GaitParameters> findGaitParameters(const std::string& name, bool* isFailed);
+
+  /*! Looks up the parameters of the start and end gait of a transition, which can be done by the control thread.
+   * Missing parameters are requested from the loader thread.
+   * @param[out] isFailed   true if the parameters of a gait could not be loaded
+   * @return  true if the parameters of both gaits are available
+   */
+  bool prepareTransition(GaitTransition* gaitTransition, bool* isFailed);
+
+  /*! Loads the parameters of the start and end gait of a transition if not done yet, runs on the loader thread.
+   * @return  true if successful
+   */
+  bool loadTransition(GaitTransition* gaitTransition);
+
+  void startTransition(GaitTransition* gaitTransition);
+
   bool updateTransition(double simulatedTime);
+
+  //! Parameter set that is loaded but not yet used by the control thread
+  struct PreparedParameterSet {
+    PreparedParameterSet() : hasGaitTransitions_(false) { }
+    std::string parameterFilePath_;
+    std::shared_ptr<LocomotionControllerDynamicGaitDefault> locomotionController_;
+    bool hasGaitTransitions_;
+    boost::ptr_vector<GaitTransition> gaitTransitions_;
+  };
+
+  /*! Reads the parameter set from the config file and loads the parameter file without initializing the controller.
+   * This can be called by the loader thread.
+   */
+  bool prepareParameterSet(int parameterSetIdx, PreparedParameterSet* parameterSet);
+
+  /*! Initializes the prepared controller and replaces the current one, needs to be called by the control thread
+   * because the initialization of the legs and the torso advances and reads the robot model.
+   * @return  false if the controller could not be initialized, the current controller is kept
+   */
+  bool installParameterSet(PreparedParameterSet* parameterSet);
+
+  //! Swaps in the parameter set loaded by the loader thread if it is ready
+  bool updateParameterSetLoading();
+
+  //! Loads the parameters of the current transitions into the cache on the loader thread
+  void prefetchGaitParameters();
+
+  //! @returns the path to the parameter file of a gait
+  std::string getParameterFilePath(const std::string& name) const;
+
+  //! Parses and validates modified parameter files, runs on the reloader thread
+  void reloadModifiedParameterFiles();
+
+  /*! Checks if all modifications of a parameter file can be swapped into the running controller, runs on the reloader thread.
+   * A modified attribute can be swapped if modifying only this attribute changes the parameters of the gait.
+   * The parameters that cannot be swapped are printed.
+   * @param name                name of the gait
+   * @param parameterFilePath   path to the parameter file
+   * @param acceptedDocument    version of the file the controller runs with
+   * @param modifiedDocument    modified version of the file
+   * @return  true if the modified file can be swapped in
+   */
+  bool isModificationSwappable(const std::string& name, const std::string& parameterFilePath,
+                               const TiXmlDocument& acceptedDocument, const TiXmlDocument& modifiedDocument) const;
+
+  //! Swaps in the parameters reloaded by the reloader thread, needs to be called by the control thread
+  bool updateParameterReloading();
  private:
   robotModel::RobotModel* robotModel_;
   robotTerrain::TerrainBase* terrain_;
@@ -109,6 +239,9 @@ class GaitSwitcherDynamicGaitDefault: public GaitSwitcherBase {
   //! Current gait transition map
   GaitTransition* currentGaitTransition;
 
+  //! Transition that starts once the parameters of its gaits are loaded
+  GaitTransition* requestedGaitTransition_;
+
 
   //! Path to the configuration file
   std::string pathToConfigFile_;
@@ -123,6 +256,9 @@ class GaitSwitcherDynamicGaitDefault: public GaitSwitcherBase {
 
   double interpolationParameter_;
 
+  //! Precompiled parameter files of pathToParameterFiles_
+  ParameterCache parameterCache_;
+
   //! XML Configuration file
   ParameterSet config_;
 
@@ -130,7 +266,32 @@ class GaitSwitcherDynamicGaitDefault: public GaitSwitcherBase {
   boost::ptr_vector<GaitTransition> gaitTransitions_;
 
   std::shared_ptr<LocomotionControllerDynamicGaitDefault> locomotionController_;
-  boost::ptr_vector<LocomotionControllerDynamicGaitDefault> locomotionControllers_;
+
+  //! Parameters of the gaits with the parameter file path as key, nullptr if the file could not be loaded
+  std::map<std::string, std::shared_ptr<const GaitParameters> > gaitParameters_;
+  std::mutex gaitParametersMutex_;
+
+  //! Parameter set that is loaded in the background
+  std::unique_ptr<PreparedParameterSet> preparedParameterSet_;
+  std::atomic<ParameterSetLoadingState> parameterSetLoadingState_;
+  std::atomic<int> numberOfLoadedGaits_;
+  std::atomic<int> numberOfGaitsToLoad_;
+  //! true while the parameters of the transitions are prefetched
+  std::atomic<bool> isPrefetching_;
+  std::atomic<bool> isPrefetchCancelled_;
+  //! Loads the parameter sets and the gait parameters in the order they are requested
+  BackgroundJobQueue parameterSetLoader_;
+
+  //! Watches the parameter files for hot reloading
+  ParameterFileWatcher parameterFileWatcher_;
+  //! Thread that parses the modified parameter files
+  std::thread parameterReloader_;
+  std::atomic<bool> isParameterHotReloadOn_;
+  //! Last accepted version of each parameter file with the parameter file path as key, only used by the reloader thread
+  std::map<std::string, TiXmlDocument> acceptedParameterDocuments_;
+  //! Parameters of the accepted parameter files that are swapped in by the control thread with the parameter file path as key
+  std::map<std::string, std::shared_ptr<const GaitParameters> > reloadedParameterFiles_;
+  std::mutex reloadedParameterFilesMutex_;
 
 
 };
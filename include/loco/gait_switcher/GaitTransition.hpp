@@ -42,10 +42,11 @@
 #ifndef LOCO_GAITTRANSITION_HPP_
 #define LOCO_GAITTRANSITION_HPP_
 
-#include "loco/locomotion_controller/LocomotionControllerDynamicGaitDefault.hpp"
+#include "loco/locomotion_controller/GaitParameters.hpp"
 #include <string>
 #include "loco/gait_pattern/APS.hpp"
 #include <list>
+#include <memory>
 
 namespace loco {
 
@@ -53,8 +54,9 @@ class GaitTransition {
 public:
 	GaitTransition();
 	virtual ~GaitTransition();
-	LocomotionControllerDynamicGaitDefault* startLocomotionSettings;
-	LocomotionControllerDynamicGaitDefault* endLocomotionSettings;
+	//! parameters of the start and end gait, loaded by the loader thread before the transition starts
+	std::shared_ptr<const GaitParameters> startGaitParameters;
+	std::shared_ptr<const GaitParameters> endGaitParameters;
 
 	double timeInterval;
 //	double stridePhaseTrigger;
@@ -44,6 +44,7 @@
 #define LOCO_LIMBCOORDINATIONBASE_HPP_
 
 #include "loco/gait_pattern/GaitPatternBase.hpp"
+#include "loco/common/StabilityMargins.hpp"
 #include "tinyxml.h"
 
 
@@ -74,6 +75,23 @@ class LimbCoordinatorBase {
    * @returns true if successful
    */
   virtual bool setToInterpolated(const LimbCoordinatorBase& limbCoordinator1, const LimbCoordinatorBase& limbCoordinator2, double t);
+
+  /*! Sets the stability margins, which are updated by the locomotion controller after the measurements.
+   * @param stabilityMargins  margins of the current tick (nullptr if not available)
+   */
+  void setStabilityMargins(const StabilityMargins* stabilityMargins);
+  const StabilityMargins* getStabilityMargins() const;
+
+  /*! Sets the control mode of the joints of the swing legs. The locomotion controller enables torque control
+   * if the joint torques of all legs are computed by the whole-body controller.
+   * @param isUsingTorqueControlForSwingLegs  true for torque control, false for position control (default)
+   */
+  void setIsUsingTorqueControlForSwingLegs(bool isUsingTorqueControlForSwingLegs);
+  bool isUsingTorqueControlForSwingLegs() const;
+
+ protected:
+  const StabilityMargins* stabilityMargins_;
+  bool isUsingTorqueControlForSwingLegs_;
 };
 
 } /* namespace loco */
@@ -47,9 +47,23 @@
 #include "loco/gait_pattern/GaitPatternBase.hpp"
 #include "loco/common/LegGroup.hpp"
 #include "loco/common/TorsoBase.hpp"
+#include "loco/common/ParameterSchema.hpp"
 
 namespace loco {
 
+//! Parameters of the dynamic gait limb coordinator
+/*! The values are read from the parameter file by the schema.
+ */
+struct LimbCoordinatorDynamicGaitParameters {
+  LimbCoordinatorDynamicGaitParameters();
+
+  //! capture point margin below which a late lift-off is delayed [m], -infinity disables the delay
+  double minCapturePointMarginForLiftOff_;
+
+  //! @returns the schema to read the parameters from the XML file
+  static const ParameterSchema<LimbCoordinatorDynamicGaitParameters>& getSchema();
+};
+
 class LimbCoordinatorDynamicGait: public LimbCoordinatorBase {
  public:
 	int state_[4];
@@ -80,8 +94,23 @@ class LimbCoordinatorDynamicGait: public LimbCoordinatorBase {
   virtual GaitPatternBase* getGaitPattern();
   const GaitPatternBase& getGaitPattern() const;
 
+  /*! Loads the parameters. The optional stability element delays the lift-off of a grounded swing leg
+   *  while the capture point margin on the support polygon without this leg is below the threshold
+   *  (disabled by default):
+   *  \code
+   *  <LimbCoordination>
+   *    <StabilityMargins minCapturePointMarginForLiftOff="0.02"/>
+   *  </LimbCoordination>
+   *  \endcode
+   * @param handle  handle of the locomotion controller element
+   */
   virtual bool loadParameters(const TiXmlHandle& handle);
 
+  //! Sets the capture point margin below which a late lift-off is delayed (-infinity disables it)
+  void setMinCapturePointMarginForLiftOff(double margin);
+  double getMinCapturePointMarginForLiftOff() const;
+  const LimbCoordinatorDynamicGaitParameters& getParameters() const;
+
 
   /*! Computes an interpolated version of the two controllers passed in as parameters.
    *  If t is 0, the current setting is set to limbCoordinator1, 1 -> limbCoordinator2, and values in between
@@ -97,11 +126,15 @@ class LimbCoordinatorDynamicGait: public LimbCoordinatorBase {
    * @param stridePhase cycle phase in [0, 1]
    */
   void setStridePhase(double stridePhase);
+ protected:
+  //! @returns true if the capture point margin without the grounded swing leg is too small for its lift-off
+  bool isLiftOffDelayedByStabilityMargins(const LegBase& leg) const;
  private:
   bool isUpdatingStridePhase_;
   LegGroup* legs_;
   TorsoBase* torso_;
   GaitPatternBase* gaitPattern_;
+  LimbCoordinatorDynamicGaitParameters parameters_;
 };
 
 } /* namespace loco */
@@ -0,0 +1,67 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * GaitParameters.hpp
+ */
+
+#ifndef LOCO_GAITPARAMETERS_HPP_
+#define LOCO_GAITPARAMETERS_HPP_
+
+#include "loco/common/ParameterVector.hpp"
+#include "loco/torso_control/TorsoControlGaitContainer.hpp"
+
+#include <string>
+
+namespace loco {
+
+//! Parameters of a gait that serve as start or end of a gait transition
+/*! The parameters only hold values and the shared height trajectories, but no modules. They are extracted
+ *  from a controller after its parameter file has been parsed, which is done by a loader thread, and
+ *  are not modified afterwards. Hence they can be kept for all gaits and shared between threads.
+ */
+struct GaitParameters {
+  GaitParameters() { }
+
+  std::string gaitName_;
+  std::string parameterFilePath_;
+  //! Continuous parameters of all modules, detached from the modules
+  ParameterVector parameterVector_;
+  TorsoControlGaitContainer::HeightTrajectory desiredTorsoForeHeightTrajectory_;
+  TorsoControlGaitContainer::HeightTrajectory desiredTorsoHindHeightTrajectory_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_GAITPARAMETERS_HPP_ */
@@ -52,13 +52,18 @@
 #include "loco/torso_control/TorsoControlBase.hpp"
 #include "loco/contact_force_distribution/ContactForceDistributionBase.hpp"
 #include "loco/motion_control/VirtualModelController.hpp"
+#include "loco/motion_control/CentroidalModelPredictiveController.hpp"
+#include "loco/motion_control/WholeBodyController.hpp"
 
 #include "loco/event_detection/EventDetector.hpp"
 
 #include "loco/common/LegGroup.hpp"
 #include "loco/common/TorsoBase.hpp"
 #include "loco/common/ParameterSet.hpp"
+#include "loco/common/ParameterVector.hpp"
 #include "loco/common/TerrainModelBase.hpp"
+#include "loco/common/TerrainQueryCache.hpp"
+#include "loco/common/StabilityMargins.hpp"
 
 
 namespace loco {
@@ -84,11 +89,25 @@ class LocomotionControllerDynamicGait: public LocomotionControllerBase {
 
   /*!
    * Initializes locomotion controller
+   * The parameters are (re)loaded from the parameter file and validated before any module is initialized.
    * @param dt the time step [s]
    * @return true if successfull.
    */
   virtual bool initialize(double dt);
 
+  /*! Initializes the modules with the parameters that have been loaded by loadParameters().
+   * @param dt the time step [s]
+   * @return true if successfull.
+   */
+  bool initializeWithLoadedParameters(double dt);
+
+  /*! Loads only the parameters of the modules without initializing the robot state.
+   * Such a controller cannot be advanced, but serves as parameter source for setToInterpolated.
+   * If the XML document has been released, it is loaded again from the parameter file.
+   * @return true if successfull.
+   */
+  virtual bool loadParameters();
+
   /*! Advance in time
    * @param dt  time step [s]
    */
@@ -97,6 +116,10 @@ class LocomotionControllerDynamicGait: public LocomotionControllerBase {
 
   virtual bool isInitialized() const;
 
+  /*! @returns true if the parameters of all modules have been loaded.
+   */
+  bool isParametersLoaded() const;
+
   virtual TorsoBase* getTorso();
   virtual LegGroup* getLegs();
 
@@ -109,16 +132,52 @@ class LocomotionControllerDynamicGait: public LocomotionControllerBase {
   const TorsoControlBase& getTorsoController() const;
   TorsoControlBase& getTorsoController();
   const VirtualModelController& getVirtualModelController() const;
+
+  /*! Sets a model-predictive controller of the torso that computes the joint torques instead of the virtual model controller.
+   * Has to be set before the parameters are loaded, the controller is not owned.
+   * @param modelPredictiveController   controller (nullptr to use the virtual model controller)
+   */
+  void setModelPredictiveController(CentroidalModelPredictiveController* modelPredictiveController);
+  CentroidalModelPredictiveController* getModelPredictiveController();
+
+  /*! Sets a whole-body controller that computes the joint torques of all legs in a single solve.
+   * It takes precedence over the model-predictive and the virtual model controller. The swing legs are torque controlled
+   * with it, otherwise they are position controlled.
+   * Has to be set before the parameters are loaded, the controller is not owned.
+   * @param wholeBodyController   controller (nullptr to disable it)
+   */
+  void setWholeBodyController(WholeBodyController* wholeBodyController);
+  WholeBodyController* getWholeBodyController();
   TerrainPerceptionBase* getTerrainPerception();
   TerrainModelBase* getTerrainModel();
 
+  /*! Sets the parameters to the interpolated ones between controller1 and controller2.
+   * The continuous parameters of the modules are interpolated at once by the parameter vector,
+   * the modules only interpolate the remaining parameters (e.g. trajectories and gait patterns).
+   */
   bool setToInterpolated(const LocomotionControllerDynamicGait& controller1, const LocomotionControllerDynamicGait& controller2, double t);
 
+  /*! @returns the continuous parameters of all modules, which is available after the parameters are loaded.
+   */
+  const ParameterVector& getParameterVector() const;
+  ParameterVector& getParameterVector();
+
+  /*! @returns the terrain queries at the feet and hips, which are updated once per tick after the terrain perception.
+   */
+  const TerrainQueryCache& getTerrainQueryCache() const;
+
+  /*! @returns the stability margins, which are updated once per tick after the measurements,
+   * e.g. to scale the desired speed or to time gait transitions.
+   */
+  const StabilityMargins& getStabilityMargins() const;
+
   /*! @returns the run time of the controller in seconds.
    */
   virtual double getRuntime() const;
  protected:
   bool isInitialized_;
+  //! true if the parameters of all modules have been loaded
+  bool isParametersLoaded_;
   //! Run time of the controller in seconds.
   double runtime_;
   LegGroup* legs_;
@@ -129,11 +188,21 @@ class LocomotionControllerDynamicGait: public LocomotionControllerBase {
   FootPlacementStrategyBase* footPlacementStrategy_;
   TorsoControlBase* torsoController_;
   VirtualModelController* virtualModelController_;
+  //! Optional alternative to the virtual model controller
+  CentroidalModelPredictiveController* modelPredictiveController_;
+  //! Optional replacement of the torso control and the contact force distribution
+  WholeBodyController* wholeBodyController_;
   ContactForceDistributionBase* contactForceDistribution_;
   ParameterSet* parameterSet_;
   EventDetectorBase* eventDetector_;
   GaitPatternBase* gaitPattern_;
   TerrainModelBase* terrainModel_;
+  //! Continuous parameters of the modules
+  ParameterVector parameterVector_;
+  //! Terrain queries shared by the foot placement and the contact force distribution
+  TerrainQueryCache terrainQueryCache_;
+  //! Support polygon, center of pressure and capture point margins shared by the stages
+  StabilityMargins stabilityMargins_;
 };
 
 } /* namespace loco */
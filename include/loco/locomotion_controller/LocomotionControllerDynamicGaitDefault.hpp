@@ -56,6 +56,8 @@
 #include "loco/torso_control/TorsoControlDynamicGait.hpp"
 #include "loco/torso_control/TorsoControlDynamicGaitFreePlane.hpp"
 #include "loco/motion_control/VirtualModelController.hpp"
+#include "loco/motion_control/CentroidalModelPredictiveController.hpp"
+#include "loco/motion_control/WholeBodyController.hpp"
 #include "loco/contact_force_distribution/ContactForceDistribution.hpp"
 #include "loco/contact_detection/ContactDetectorBase.hpp"
 
@@ -69,6 +71,7 @@
 #include "loco/common/TorsoStarlETH.hpp"
 #include "loco/common/TerrainModelBase.hpp"
 #include "loco/common/ParameterSet.hpp"
+#include "loco/locomotion_controller/GaitParameters.hpp"
 #include <memory>
 #include <string>
 
@@ -81,16 +84,31 @@ class LocomotionControllerDynamicGaitDefault: public LocomotionControllerBase {
   LocomotionControllerDynamicGaitDefault(const std::string& parameterFile,
                                          robotModel::RobotModel* robotModel,
                                          robotTerrain::TerrainBase* terrain,
-                                         double dt);
+                                         double dt,
+                                         const ParameterCache* parameterCache = nullptr);
   virtual ~LocomotionControllerDynamicGaitDefault();
 
   /*!
    * Initializes locomotion controller
+   * The parameters are (re)loaded from the parameter file before the modules are initialized.
    * @param dt the time step [s]
    * @return true if successfull.
    */
   virtual bool initialize(double dt);
 
+  /*! Initializes the modules with the parameters that have been loaded by loadParameters().
+   * @param dt the time step [s]
+   * @return true if successfull.
+   */
+  bool initializeWithLoadedParameters(double dt);
+
+  /*! Loads only the parameters without initializing the robot state.
+   * Such a controller cannot be advanced, but serves as parameter source for setToInterpolated.
+   * The XML document is loaded again if it has been released and released once all parameters have been parsed.
+   * @return true if successfull.
+   */
+  bool loadParameters();
+
   /*! Advance in time
    * @param dt  time step [s]
    */
@@ -111,7 +129,21 @@ class LocomotionControllerDynamicGaitDefault: public LocomotionControllerBase {
 
   double getStrideDuration() const;
   double getStridePhase() const;
-  bool setToInterpolated(const LocomotionControllerDynamicGaitDefault& controller1,  const LocomotionControllerDynamicGaitDefault& controller2, double t);
+
+  /*! Copies the loaded parameters into a bundle that does not depend on this controller.
+   * @param gaitParameters  parameters of the gait
+   * @return true if successful
+   */
+  bool getGaitParameters(GaitParameters* gaitParameters) const;
+
+  /*! Sets the parameters to the interpolated ones between two gaits without initializing the controller.
+   * Only the values are combined, hence this does not allocate memory or parse a parameter file.
+   * @param gaitParameters1   parameters if t is 0
+   * @param gaitParameters2   parameters if t is 1
+   * @param t                 interpolation parameter in [0,1]
+   * @return true if successful
+   */
+  bool setToInterpolated(const GaitParameters& gaitParameters1, const GaitParameters& gaitParameters2, double t);
   GaitPatternFlightPhases* getGaitPattern();
   TorsoBase* getTorso();
   LegGroup* getLegs();
@@ -136,9 +168,12 @@ class LocomotionControllerDynamicGaitDefault: public LocomotionControllerBase {
   std::shared_ptr<GaitPatternFlightPhases> gaitPatternFlightPhases_;
   std::shared_ptr<LimbCoordinatorDynamicGait> limbCoordinator_;
   std::shared_ptr<FootPlacementStrategyBase> footPlacementStrategy_;
+  std::shared_ptr<FootholdOptimizer> footholdOptimizer_;
   std::shared_ptr<TorsoControlDynamicGaitFreePlane> torsoController_;
   std::shared_ptr<ContactForceDistribution> contactForceDistribution_;
   std::shared_ptr<VirtualModelController> virtualModelController_;
+  std::shared_ptr<CentroidalModelPredictiveController> modelPredictiveController_;
+  std::shared_ptr<WholeBodyController> wholeBodyController_;
   std::shared_ptr<ContactDetectorBase> contactDetector_;
   std::shared_ptr<MissionControlSpeedFilter> missionController_;
   std::shared_ptr<LocomotionControllerDynamicGait> locomotionController_;
@@ -43,6 +43,7 @@
 #define LOCO_MISSIONCONTROLBASE_HPP_
 
 #include "loco/common/TypeDefs.hpp"
+#include "loco/common/ParameterVector.hpp"
 #include "tinyxml.h"
 
 namespace loco {
@@ -67,6 +68,13 @@ class MissionControlBase {
    */
   virtual bool setToInterpolated(const MissionControlBase& missionController1, const MissionControlBase& missionController2, double t);
 
+  /*! Adds the continuous parameters to the parameter vector of the locomotion controller,
+   * which interpolates them during gait transitions. setToInterpolated only needs to handle the remaining parameters.
+   * @param parameterVector   parameter vector
+   * @returns true if successful
+   */
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
+
 };
 
 } /* namespace loco */
@@ -60,6 +60,12 @@ class MissionControlDynamicGait: public MissionControlBase
   bool switchToWalkingTrot();
   bool switchToStand();
   bool switchToStaticLateralWalk();
+
+  /*! Switches to another parameter set of the config file, which is loaded in the background.
+   * @param parameterSetIdx   index of the parameter set
+   * @return  true if the loading has been started
+   */
+  bool switchToParameterSet(int parameterSetIdx);
   void setDesiredPositionOffsetInControlFrame(const Position& desiredPositionOffsetInControlFrame);
   void setDesiredOrientationOffset(const RotationQuaternion& desiredOrientationOffset);
   void setDesiredLinearVelocityBaseInControlFrame(const LinearVelocity& desiredLinearVelocityBaseInControlFrame);
@@ -44,7 +44,7 @@
 
 #include "loco/mission_control/MissionControlBase.hpp"
 #include "starlethModel/RobotModel.hpp"
-#include "loco/temp_helpers/FilteredVariable.hpp"
+#include "loco/temp_helpers/FilterBank.hpp"
 
 namespace loco {
 
@@ -76,7 +76,7 @@ class MissionControlJoystick: public MissionControlBase {
   EulerAnglesZyx maximalOrientationHeadingToBase_;
 
   //! filtered speeds [sagittal; coronal; turning]
-  FilteredDouble filteredVelocities_[3];
+  FilterBank<3> velocityFilter_;
 
 
 
@@ -43,7 +43,7 @@
 #define LOCO_MissionControlSpeedFilter_HPP_
 
 #include "loco/mission_control/MissionControlBase.hpp"
-#include "loco/temp_helpers/FilteredVariable.hpp"
+#include "loco/temp_helpers/FilterBank.hpp"
 
 namespace loco {
 
@@ -62,6 +62,7 @@ class MissionControlSpeedFilter: public MissionControlBase {
   virtual bool loadParameters(const TiXmlHandle& handle);
 
   bool setToInterpolated(const MissionControlBase& missionController1, const MissionControlBase& missionController2, double t);
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
 
   const Position& getDesiredPositionOffsetInWorldFrame() const;
   const Position& getMinimalPositionOffsetInWorldFrame() const;
@@ -90,7 +91,7 @@ class MissionControlSpeedFilter: public MissionControlBase {
 
 
   //! filtered speeds [sagittal; coronal; turning]
-  FilteredDouble filteredVelocities_[3];
+  FilterBank<3> velocityFilter_;
 
 
 
@@ -66,7 +66,7 @@ class MissionControlStaticGait : public MissionControlBase {
   MissionControlSpeedFilter speedFilter_;
   LocomotionControllerDynamicGait* locomotionController_;
 
-  bool useRosService_;
+  bool useFootholdValidation_;
 
 };
 
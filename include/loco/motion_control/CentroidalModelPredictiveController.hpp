@@ -0,0 +1,200 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     CentroidalModelPredictiveController.hpp
+* @brief
+*/
+#ifndef LOCO_CENTROIDALMODELPREDICTIVECONTROLLER_HPP_
+#define LOCO_CENTROIDALMODELPREDICTIVECONTROLLER_HPP_
+
+// Motion Controller
+#include "loco/motion_control/MotionControllerBase.hpp"
+#include "loco/motion_control/CentroidalMpcSolver.hpp"
+// Contact force distribution
+#include "loco/contact_force_distribution/ContactForceDistributionBase.hpp"
+// Gait pattern and foot placement
+#include "loco/gait_pattern/GaitPatternBase.hpp"
+#include "loco/foot_placement_strategy/FootPlacementStrategyBase.hpp"
+// Locomotion controller commons
+#include "loco/common/TypeDefs.hpp"
+// Eigen
+#include <Eigen/Core>
+#include "tinyxml.h"
+
+#include "loco/common/ParameterSchema.hpp"
+
+namespace loco {
+
+//! Parameters of the centroidal model-predictive controller
+struct CentroidalModelPredictiveControllerParameters {
+  CentroidalModelPredictiveControllerParameters();
+
+  //! Number of stages N and duration of a stage [s] of the horizon.
+  double numberOfStages_;
+  double stageDuration_;
+
+  //! Principal moments of inertia of the robot about its CoM in base frame [kg m^2].
+  Eigen::Vector3d inertia_;
+
+  //! Weights of the orientation, position, angular and linear velocity errors about and along the axes of the world frame.
+  Eigen::Vector3d orientationWeights_;
+  Eigen::Vector3d positionWeights_;
+  Eigen::Vector3d angularVelocityWeights_;
+  Eigen::Vector3d linearVelocityWeights_;
+  //! Weight of the ground reaction forces.
+  double forceWeight_;
+
+  //! Friction coefficient and bounds of the normal force of a leg in contact [N].
+  double frictionCoefficient_;
+  double minimalNormalForce_;
+  double maximalNormalForce_;
+
+  //! ADMM penalty, maximal number of iterations per control tick and tolerance of the residuals [N].
+  double penalty_;
+  double maximalNumberOfIterations_;
+  double tolerance_;
+
+  //! @returns the schema to read the parameters from the XML file
+  static const ParameterSchema<CentroidalModelPredictiveControllerParameters>& getSchema();
+};
+
+//! Model-predictive control of the torso with the centroidal dynamics
+/*! Alternative to the VirtualModelController. Instead of a virtual force and torque of a PD law, the ground reaction
+ *  forces are optimized over a horizon of a few hundred milliseconds with the single rigid body model of the robot.
+ *  The contact schedule over the horizon is taken from the gait pattern and the footholds of the legs that touch down
+ *  within the horizon from the foot placement strategy. The forces of the first stage are converted to joint torques
+ *  by the contact force distribution.
+ *
+ *  LocomotionControllerDynamicGaitDefault uses this controller if the parameter file contains the element below
+ *  the LocomotionController element. The Solver element is optional, the values are its defaults.
+ *  \code
+ *  <CentroidalModelPredictiveController>
+ *    <Horizon numberOfStages="15" stageDuration="0.03"/>
+ *    <Inertia xx="0.8" yy="2.0" zz="2.2"/>
+ *    <Weights>
+ *      <X position="100.0" velocity="10.0"/>
+ *      <Y position="100.0" velocity="10.0"/>
+ *      <Z position="500.0" velocity="10.0"/>
+ *      <Roll orientation="50.0" velocity="1.0"/>
+ *      <Pitch orientation="50.0" velocity="1.0"/>
+ *      <Yaw orientation="10.0" velocity="1.0"/>
+ *      <Force weight="1.0e-6"/>
+ *    </Weights>
+ *    <Friction coefficient="0.6" minimalNormalForce="5.0" maximalNormalForce="400.0"/>
+ *    <Solver penalty="1.0e-3" maximalNumberOfIterations="20" tolerance="1.0"/>
+ *  </CentroidalModelPredictiveController>
+ *  \endcode
+ */
+class CentroidalModelPredictiveController : public MotionControllerBase
+{
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /*!
+   * Constructor.
+   */
+  CentroidalModelPredictiveController(std::shared_ptr<LegGroup> legs, std::shared_ptr<TorsoBase> torso,
+                                      std::shared_ptr<ContactForceDistributionBase> contactForceDistribution);
+  /*!
+   * Destructor.
+   */
+  virtual ~CentroidalModelPredictiveController();
+
+  /*!
+   * Load parameters.
+   * @return true if successful
+   */
+  virtual bool loadParameters(const TiXmlHandle& handle);
+
+  /*!
+   * Add data to logger (optional).
+   * @return true if successful.
+   */
+  bool addToLogger();
+
+  /*!
+   * Computes the joint torques from the desired base pose.
+   * @return true if successful.
+   */
+  bool compute();
+
+  /*! Sets the gait pattern that provides the contact schedule over the horizon.
+   * Without a gait pattern, the current contact state is kept over the horizon.
+   */
+  void setGaitPattern(GaitPatternBase* gaitPattern);
+  GaitPatternBase* getGaitPattern();
+
+  /*! Sets the foot placement strategy that provides the footholds of the swing legs.
+   * Without a foot placement strategy, the footholds are extrapolated with the desired velocity.
+   */
+  void setFootPlacementStrategy(FootPlacementStrategyBase* footPlacementStrategy);
+  FootPlacementStrategyBase* getFootPlacementStrategy();
+
+  //! Ground reaction force of a leg that is applied in the current control tick (world frame).
+  const Force& getGroundReactionForceInWorldFrame(int legId) const;
+  const CentroidalMpcSolver& getSolver() const;
+  const ContactForceDistributionBase& getContactForceDistribution() const;
+  const CentroidalModelPredictiveControllerParameters& getParameters() const;
+
+ private:
+  std::shared_ptr<ContactForceDistributionBase> contactForceDistribution_;
+  GaitPatternBase* gaitPattern_;
+  FootPlacementStrategyBase* footPlacementStrategy_;
+
+  CentroidalModelPredictiveControllerParameters parameters_;
+  CentroidalMpcSolver solver_;
+
+  //! Force of the ground on the foot of each leg of the first stage.
+  Force groundReactionForcesInWorldFrame_[CentroidalMpcSolver::numberOfLegs];
+  //! Sum of the ground reaction forces.
+  Force netForceInWorldFrame_;
+
+ private:
+  /*!
+   * Sets the initial state, the reference, the contact schedule and the lever arms of the problem.
+   * @param[out] initialState   measured state of the torso
+   * @return true if successful.
+   */
+  bool setUpProblem(CentroidalMpcSolver::State& initialState);
+
+  /*!
+   * Check if parameters are loaded.
+   * @return true if parameters are loaded
+   */
+  bool isParametersLoaded() const;
+};
+
+} /* namespace loco */
+#endif /* LOCO_CENTROIDALMODELPREDICTIVECONTROLLER_HPP_ */
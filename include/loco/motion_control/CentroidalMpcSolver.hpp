@@ -0,0 +1,217 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     CentroidalMpcSolver.hpp
+* @brief
+*/
+
+#ifndef LOCO_CENTROIDALMPCSOLVER_HPP_
+#define LOCO_CENTROIDALMPCSOLVER_HPP_
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+
+namespace loco {
+
+//! Solves the condensed model-predictive control problem of the centroidal dynamics of the torso
+/*! The torso is modelled as a single rigid body with the mass m and the inertia I (in world frame) that is
+ *  driven by the ground reaction forces f_i of the legs at the lever arms r_i (from the CoM to the foot).
+ *  The dynamics are linearized about the reference orientation and discretized with the stage duration dt:
+ *
+ *    x = [theta, p, omega, v]           (orientation error, CoM position, angular and linear velocity in world frame)
+ *    u = [f_0, f_1, f_2, f_3]           (ground reaction forces in world frame)
+ *
+ *    theta(k+1) = theta(k) + dt*omega(k)
+ *    p(k+1)     = p(k) + dt*v(k)
+ *    omega(k+1) = omega(k) + dt*I^-1*sum_i r_i(k) x f_i(k)
+ *    v(k+1)     = v(k) + dt*(sum_i f_i(k)/m + g)
+ *
+ *  The forces of legs that are not in contact at a stage are removed from the model. The cost
+ *
+ *    sum_(k=1..N) (x(k)-x_ref(k))'*Q*(x(k)-x_ref(k)) + sum_(k=0..N-1) u(k)'*R*u(k)
+ *
+ *  is minimized subject to the friction pyramid |f_x|, |f_y| <= mu*f_z and the bounds f_min <= f_z <= f_max of the
+ *  legs in contact with the alternating direction method of multipliers (ADMM): the forces are split into u and a
+ *  copy z that satisfies the constraints,
+ *
+ *    u = argmin cost + rho/2*|u - z + w|^2       (Riccati recursion)
+ *    z = projection of u + w on the constraints  (per leg and stage)
+ *    w = w + u - z
+ *
+ *  The Riccati gains do not depend on z and w and are factorized once per solve, an iteration only repeats the
+ *  affine backward pass and the rollout. z and w are kept for the next call (warm start) and the number of
+ *  iterations is bounded, which bounds the computation time.
+ */
+class CentroidalMpcSolver {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static const int maxNumberOfStages = 25;
+  static const int numberOfLegs = 4;
+  static const int numberOfStates = 12;
+  static const int numberOfInputs = 3*numberOfLegs;
+
+  typedef Eigen::Matrix<double, numberOfStates, 1> State;
+  typedef Eigen::Matrix<double, numberOfInputs, 1> Input;
+
+  CentroidalMpcSolver();
+  virtual ~CentroidalMpcSolver();
+
+  /*! Sets the horizon.
+   * @param numberOfStages    number of stages N
+   * @param stageDuration     duration of a stage dt [s]
+   * @returns false if the horizon is invalid
+   */
+  bool initialize(int numberOfStages, double stageDuration);
+
+  int getNumberOfStages() const;
+  double getStageDuration() const;
+
+  void setMass(double mass);
+  //! Sets the inertia about the CoM in world frame.
+  void setInertiaInWorldFrame(const Eigen::Matrix3d& inertia);
+  void setGravity(const Eigen::Vector3d& gravity);
+
+  //! Sets the diagonal of the state weight Q.
+  void setStateWeights(const State& weights);
+  //! Sets the weight of the ground reaction forces (R = weight*I).
+  void setForceWeight(double weight);
+  void setFrictionCoefficient(double frictionCoefficient);
+  void setNormalForceLimits(double minimalNormalForce, double maximalNormalForce);
+  /*! Sets the parameters of the ADMM iterations.
+   * @param penalty                 penalty rho of the difference between u and z
+   * @param maximalNumberOfIterations   maximal number of iterations per solve
+   * @param tolerance               the iterations stop if the residuals are smaller [N]
+   */
+  void setAdmmParameters(double penalty, int maximalNumberOfIterations, double tolerance);
+
+  /*! Sets the contact of a leg at a stage.
+   * @param stage                     stage k in [0, N-1]
+   * @param iLeg                      index of the leg
+   * @param isInContact               true if the leg can exert a force during the stage
+   * @param positionCoMToFootInWorldFrame   lever arm r_i(k)
+   */
+  void setContact(int stage, int iLeg, bool isInContact, const Eigen::Vector3d& positionCoMToFootInWorldFrame);
+
+  //! Sets the reference of the state at a stage in [1, N].
+  void setReference(int stage, const State& reference);
+
+  //! Clears the warm start.
+  void reset();
+
+  /*! Solves the problem for the initial state.
+   * @returns false if the solver is not initialized or the recursion failed
+   */
+  bool solve(const State& initialState);
+
+  //! Ground reaction forces of the first stage that satisfy the constraints, which are applied to the robot
+  const Input& getInputOfFirstStage() const;
+  //! Ground reaction forces of a stage that satisfy the constraints
+  const Input& getInput(int stage) const;
+  const State& getPredictedState(int stage) const;
+
+  //! Largest difference between u and z or between z of the last two iterations [N]
+  double getResidual() const;
+  int getNumberOfIterations() const;
+
+  /*! Projects the force of a leg on the friction pyramid |f_x|, |f_y| <= mu*f_z with f_min <= f_z <= f_max.
+   * @param force                 force in world frame
+   * @param frictionCoefficient   mu (positive)
+   * @param minimalNormalForce    f_min
+   * @param maximalNormalForce    f_max
+   * @returns the closest force that satisfies the constraints
+   */
+  static Eigen::Vector3d projectOnFrictionPyramid(const Eigen::Vector3d& force, double frictionCoefficient,
+                                                  double minimalNormalForce, double maximalNormalForce);
+
+ protected:
+  typedef Eigen::Matrix<double, numberOfStates, numberOfStates> StateMatrix;
+  typedef Eigen::Matrix<double, numberOfStates, numberOfInputs> InputMatrix;
+  typedef Eigen::Matrix<double, numberOfInputs, numberOfStates> GainMatrix;
+  typedef Eigen::Matrix<double, numberOfInputs, numberOfInputs> InputWeightMatrix;
+
+  bool isInitialized_;
+  int numberOfStages_;
+  double stageDuration_;
+
+  double mass_;
+  Eigen::Matrix3d inverseInertia_;
+  Eigen::Vector3d gravity_;
+
+  State stateWeights_;
+  double forceWeight_;
+  double frictionCoefficient_;
+  double minimalNormalForce_;
+  double maximalNormalForce_;
+  double penalty_;
+  int maximalNumberOfIterations_;
+  double tolerance_;
+
+  //! per stage
+  bool isInContact_[maxNumberOfStages][numberOfLegs];
+  Eigen::Vector3d positionsCoMToFoot_[maxNumberOfStages][numberOfLegs];
+  State references_[maxNumberOfStages+1];
+  InputMatrix B_[maxNumberOfStages];
+  //! factorization of the Hessian of the forces
+  Eigen::LLT<InputWeightMatrix> hessians_[maxNumberOfStages];
+  //! cross terms B'*P(k+1)*A
+  GainMatrix crossTerms_[maxNumberOfStages];
+  GainMatrix feedbackGains_[maxNumberOfStages];
+  Input feedforwardInputs_[maxNumberOfStages];
+  //! Hessians P(k) of the value function
+  StateMatrix valueHessians_[maxNumberOfStages+1];
+  Input inputs_[maxNumberOfStages];
+  State states_[maxNumberOfStages+1];
+
+  //! forces that satisfy the constraints (z) and scaled dual variables (w)
+  Input projectedInputs_[maxNumberOfStages];
+  Input duals_[maxNumberOfStages];
+
+  double residual_;
+  int numberOfIterations_;
+
+  void updateModel();
+  //! Computes the feedback gains, which do not depend on the iterates of the ADMM.
+  bool factorize();
+  //! Computes the feedforward terms for the current z and w.
+  void solveAffineTerms();
+  void rollout(const State& initialState);
+  //! Updates z and w and returns the larger of the primal and dual residual.
+  double updateProjection();
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_CENTROIDALMPCSOLVER_HPP_ */
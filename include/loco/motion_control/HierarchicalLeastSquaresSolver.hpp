@@ -0,0 +1,125 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     HierarchicalLeastSquaresSolver.hpp
+* @brief
+*/
+
+#ifndef LOCO_HIERARCHICALLEASTSQUARESSOLVER_HPP_
+#define LOCO_HIERARCHICALLEASTSQUARESSOLVER_HPP_
+
+#include <Eigen/Core>
+#include <Eigen/SVD>
+
+namespace loco {
+
+//! Solves a hierarchy of linear least squares tasks with strict priorities
+/*! The tasks A_k*x = b_k are added in the order of their priority. Each task is solved in the least squares sense
+ *  within the nullspace of all tasks with higher priority,
+ *
+ *    x_k = x_(k-1) + Z_(k-1)*z_k,   z_k = argmin |A_k*Z_(k-1)*z - (b_k - A_k*x_(k-1))|
+ *
+ *  and the nullspace basis is shrunk to Z_k = Z_(k-1)*N_k, where N_k spans the nullspace of A_k*Z_(k-1).
+ *  A task is therefore only decomposed in the remaining free variables, the tasks of higher priority are not
+ *  stacked and decomposed again. All matrices have a fixed maximal size and the solver does not allocate memory.
+ */
+class HierarchicalLeastSquaresSolver {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static const int maxNumberOfVariables = 30;
+  static const int maxNumberOfTaskRows = 30;
+
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, maxNumberOfTaskRows, maxNumberOfVariables> TaskMatrix;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfTaskRows, 1> TaskVector;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfVariables, 1> Solution;
+
+  HierarchicalLeastSquaresSolver();
+  virtual ~HierarchicalLeastSquaresSolver();
+
+  /*! Starts a new hierarchy, all variables are free and zero.
+   * @param numberOfVariables   number of variables n
+   * @returns false if the number of variables is not supported
+   */
+  bool reset(int numberOfVariables);
+
+  /*! Sets the threshold of the singular values relative to the largest one, below which a direction is
+   * considered as not controllable by a task (and left free for the tasks with lower priority).
+   */
+  void setSingularValueThreshold(double threshold);
+
+  /*! Solves a task in the nullspace of the tasks added before.
+   * @param A   task matrix (m x n)
+   * @param b   task vector (m)
+   * @returns false if the dimensions do not match
+   */
+  bool addTask(const TaskMatrix& A, const TaskVector& b);
+
+  /*! Stores the solution and the nullspace of the tasks added so far.
+   * A hierarchy whose first levels do not change, e.g. in the passes of an active set method, is continued
+   * from here with restoreCheckpoint, such that these levels are only decomposed once.
+   */
+  void setCheckpoint();
+
+  //! Removes the tasks that were added after the last setCheckpoint
+  void restoreCheckpoint();
+
+  //! Solution x of the tasks added so far
+  const Solution& getSolution() const;
+
+  //! Dimension of the nullspace of the tasks added so far
+  int getNumberOfFreeVariables() const;
+
+  //! Norm of the residual A*x - b of the last task
+  double getResidualOfLastTask() const;
+
+ protected:
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, maxNumberOfVariables, maxNumberOfVariables> NullspaceBasis;
+
+  int numberOfVariables_;
+  double singularValueThreshold_;
+  Solution solution_;
+  NullspaceBasis nullspaceBasis_;
+  double residualOfLastTask_;
+  Eigen::JacobiSVD<TaskMatrix> svd_;
+
+  Solution solutionAtCheckpoint_;
+  NullspaceBasis nullspaceBasisAtCheckpoint_;
+  double residualOfLastTaskAtCheckpoint_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_HIERARCHICALLEASTSQUARESSOLVER_HPP_ */
@@ -50,6 +50,7 @@
 #include "loco/contact_force_distribution/ContactForceDistributionBase.hpp"
 // Parameters
 #include "tinyxml.h"
+#include "loco/common/ParameterVector.hpp"
 
 namespace loco {
 
@@ -94,6 +95,13 @@ class MotionControllerBase
    */
   virtual bool setToInterpolated(const MotionControllerBase& motionController1, const MotionControllerBase& motionController2, double t);
 
+  /*! Adds the continuous parameters to the parameter vector of the locomotion controller,
+   * which interpolates them during gait transitions.
+   * @param parameterVector   parameter vector
+   * @returns true if successful
+   */
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
+
  protected:
   std::shared_ptr<LegGroup> legs_;
   std::shared_ptr<TorsoBase> torso_;
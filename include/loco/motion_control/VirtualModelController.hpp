@@ -53,10 +53,32 @@
 #include <iostream>
 #include "tinyxml.h"
 
-#include "tinyxml.h"
+#include "loco/common/ParameterSchema.hpp"
 
 namespace loco {
 
+//! Parameters of the virtual model controller
+/*! The gains are stored contiguously and are read from the parameter file by the schema.
+ */
+struct VirtualModelControllerParameters {
+  VirtualModelControllerParameters();
+
+  //! Proportional gain vector (k_p)  for translational error (force).
+  Eigen::Vector3d proportionalGainTranslation_;
+  //! Derivative gain vector (k_d) for translational error (force).
+  Eigen::Vector3d derivativeGainTranslation_;
+  //! Feedforward gain vector (k_ff) for translational error (force).
+  Eigen::Vector3d feedforwardGainTranslation_;
+
+  //! Proportional (k_p), derivative (k_d), and feedforward gain vector (k_ff) for rotational error (torque).
+  Eigen::Vector3d proportionalGainRotation_;
+  Eigen::Vector3d derivativeGainRotation_;
+  Eigen::Vector3d feedforwardGainRotation_;
+
+  //! @returns the schema to read the parameters from the XML file
+  static const ParameterSchema<VirtualModelControllerParameters>& getSchema();
+};
+
 class VirtualModelController : public MotionControllerBase
 {
  public:
@@ -133,6 +155,7 @@ class VirtualModelController : public MotionControllerBase
   double getGravityCompensationForcePercentage() const;
   void setGravityCompensationForcePercentage(double percentage);
   const ContactForceDistributionBase& getContactForceDistribution() const;
+  const VirtualModelControllerParameters& getParameters() const;
 
   /*! Sets the parameters to the interpolated ones between motionController1 and controller2.
    * @param motionController1     If the interpolation parameter is 0, then the parameter set is equal to the one of motionController1.
@@ -142,6 +165,8 @@ class VirtualModelController : public MotionControllerBase
    */
   virtual bool setToInterpolated(const MotionControllerBase& motionController1, const MotionControllerBase& motionController2, double t);
 
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
+
  private:
   std::shared_ptr<ContactForceDistributionBase> contactForceDistribution_;
 
@@ -159,17 +184,8 @@ class VirtualModelController : public MotionControllerBase
   //! Torque on torso to compensate for gravity (in base frame).
   Torque gravityCompensationTorqueInBaseFrame_;
 
-  //! Proportional gain vector (k_p)  for translational error (force).
-  Eigen::Vector3d proportionalGainTranslation_;
-  //! Derivative gain vector (k_d) for translational error (force).
-  Eigen::Vector3d derivativeGainTranslation_;
-  //! Feedforward gain vector (k_ff) for translational error (force).
-  Eigen::Vector3d feedforwardGainTranslation_;
-
-  //! Proportional (k_p), derivative (k_d), and feedforward gain vector (k_ff) for rotational error (torque).
-  Eigen::Vector3d proportionalGainRotation_;
-  Eigen::Vector3d derivativeGainRotation_;
-  Eigen::Vector3d feedforwardGainRotation_;
+  //! Gains of the controller
+  VirtualModelControllerParameters parameters_;
 
   double gravityCompensationForcePercentage_;
 
@@ -0,0 +1,244 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     WholeBodyController.hpp
+* @brief
+*/
+#ifndef LOCO_WHOLEBODYCONTROLLER_HPP_
+#define LOCO_WHOLEBODYCONTROLLER_HPP_
+
+// Motion Controller
+#include "loco/motion_control/MotionControllerBase.hpp"
+#include "loco/motion_control/HierarchicalLeastSquaresSolver.hpp"
+// Locomotion controller commons
+#include "loco/common/TypeDefs.hpp"
+// Eigen
+#include <Eigen/Core>
+#include "tinyxml.h"
+
+#include "loco/common/ParameterSchema.hpp"
+
+namespace loco {
+
+//! Parameters of the whole-body controller
+struct WholeBodyControllerParameters {
+  WholeBodyControllerParameters();
+
+  //! Proportional and derivative gains of the desired linear acceleration of the torso (heading, lateral, vertical).
+  Eigen::Vector3d proportionalGainTranslation_;
+  Eigen::Vector3d derivativeGainTranslation_;
+  //! Proportional and derivative gains of the desired angular acceleration of the torso (roll, pitch, yaw).
+  Eigen::Vector3d proportionalGainRotation_;
+  Eigen::Vector3d derivativeGainRotation_;
+
+  //! Principal moments of inertia of the torso about its CoM in base frame [kg m^2].
+  Eigen::Vector3d inertiaOfTorso_;
+
+  //! Proportional and derivative gains of the desired joint motion of the swing legs.
+  double proportionalGainSwingLeg_;
+  double derivativeGainSwingLeg_;
+
+  //! Weights of the regularization of the tangential and normal contact forces and of the joint accelerations.
+  double tangentialForceWeight_;
+  double normalForceWeight_;
+  double jointAccelerationWeight_;
+
+  //! Friction coefficient and minimal normal force of a leg in contact [N].
+  double frictionCoefficient_;
+  double minimalNormalForce_;
+
+  //! Relative threshold of the singular values and maximal number of passes to activate violated friction constraints.
+  double singularValueThreshold_;
+  double maximalNumberOfActiveSetIterations_;
+
+  //! @returns the schema to read the parameters from the XML file
+  static const ParameterSchema<WholeBodyControllerParameters>& getSchema();
+};
+
+//! Whole-body controller that computes the joint torques of all legs in one prioritized problem
+/*! Replaces the virtual model controller and the contact force distribution. The variables are the accelerations
+ *  of the base and of the joints and the ground reaction forces, x = [a_B, alpha_B, ddq, f] (base frame). The
+ *  rigid body model consists of the torso and the point masses of the leg links (LegLinkGroup), whose translation
+ *  Jacobians are provided by the legs. The tasks are solved with strict priorities:
+ *
+ *    1. floating base dynamics, feet in contact do not accelerate, no force at the swing legs
+ *    2. active friction constraints
+ *    3. desired acceleration of the torso (PD law on the torso errors) and of the swing feet (PD law on the desired joint positions)
+ *    4. regularization of the contact forces and joint accelerations
+ *
+ *  The joint torques follow from the joint rows of the equations of motion. If a contact force violates the friction
+ *  pyramid, the violated constraints are added to the second level at their bound and the levels below the dynamics
+ *  are solved again. The dynamics are decomposed once per tick, the passes continue from the solver's checkpoint.
+ *  Coriolis and centrifugal terms are neglected since the legs do not provide the derivatives of their Jacobians.
+ *  The limb coordinator switches the swing legs to torque control if this controller is used.
+ *
+ *  LocomotionControllerDynamicGaitDefault uses this controller if the parameter file contains the element below
+ *  the LocomotionController element. The Solver element is optional, the values are its defaults.
+ *  \code
+ *  <WholeBodyController>
+ *    <Torso>
+ *      <Gains>
+ *        <Heading kp="100.0" kd="20.0"/>
+ *        <Lateral kp="100.0" kd="20.0"/>
+ *        <Vertical kp="400.0" kd="40.0"/>
+ *        <Roll kp="200.0" kd="20.0"/>
+ *        <Pitch kp="200.0" kd="20.0"/>
+ *        <Yaw kp="100.0" kd="10.0"/>
+ *      </Gains>
+ *      <Inertia xx="0.8" yy="2.0" zz="2.2"/>
+ *    </Torso>
+ *    <SwingLeg>
+ *      <Gains kp="400.0" kd="40.0"/>
+ *    </SwingLeg>
+ *    <Regularization tangentialForce="1.0" normalForce="0.1" jointAcceleration="0.01"/>
+ *    <Friction coefficient="0.6" minimalNormalForce="5.0"/>
+ *    <Solver singularValueThreshold="1.0e-6" maximalNumberOfActiveSetIterations="2"/>
+ *  </WholeBodyController>
+ *  \endcode
+ */
+class WholeBodyController : public MotionControllerBase
+{
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static const int numberOfLegs = 4;
+  static const int numberOfJointsPerLeg = 3;
+  static const int numberOfGeneralizedCoordinates = 6 + numberOfLegs*numberOfJointsPerLeg;
+  static const int numberOfVariables = numberOfGeneralizedCoordinates + 3*numberOfLegs;
+
+  typedef Eigen::Matrix<double, numberOfGeneralizedCoordinates, numberOfGeneralizedCoordinates> MassMatrix;
+  typedef Eigen::Matrix<double, numberOfGeneralizedCoordinates, 1> GeneralizedForces;
+  typedef Eigen::Matrix<double, 3, numberOfGeneralizedCoordinates> PointJacobian;
+
+  /*!
+   * Constructor.
+   */
+  WholeBodyController(std::shared_ptr<LegGroup> legs, std::shared_ptr<TorsoBase> torso);
+
+  /*!
+   * Destructor.
+   */
+  virtual ~WholeBodyController();
+
+  /*!
+   * Load parameters.
+   * @return true if successful
+   */
+  virtual bool loadParameters(const TiXmlHandle& handle);
+
+  /*!
+   * Add data to logger (optional).
+   * @return true if successful.
+   */
+  bool addToLogger();
+
+  /*!
+   * Computes the joint torques from the desired base pose and the desired joint positions of the swing legs.
+   * @return true if successful.
+   */
+  bool compute();
+
+  //! Ground reaction force of a leg (world frame).
+  const Force& getGroundReactionForceInWorldFrame(int legId) const;
+  //! Desired linear and angular acceleration of the base (base frame).
+  const Eigen::Matrix<double, 6, 1>& getDesiredAccelerationOfBase() const;
+  //! Mass matrix and gravity terms of the generalized coordinates [base (6), joints (12)].
+  const MassMatrix& getMassMatrix() const;
+  const GeneralizedForces& getGravityTerms() const;
+  const HierarchicalLeastSquaresSolver& getSolver() const;
+  //! Number of times the levels below the dynamics were solved in the last compute (1 if no friction constraint was violated).
+  int getNumberOfActiveSetPasses() const;
+  const WholeBodyControllerParameters& getParameters() const;
+
+ private:
+  WholeBodyControllerParameters parameters_;
+  HierarchicalLeastSquaresSolver solver_;
+
+  //! rigid body model in base frame
+  MassMatrix massMatrix_;
+  GeneralizedForces gravityTerms_;
+  PointJacobian contactJacobians_[numberOfLegs];
+  bool isInContact_[numberOfLegs];
+  //! rotation from base to world frame
+  Eigen::Matrix3d orientationBaseToWorld_;
+
+  Eigen::Matrix<double, 6, 1> desiredAccelerationOfBase_;
+  Eigen::Vector3d desiredAccelerationsOfFeet_[numberOfLegs];
+
+  //! friction constraints that are active at their bound, rows of the world frame force [x, -x, y, -y, minimal normal]
+  bool isFrictionConstraintActive_[numberOfLegs][5];
+
+  Force groundReactionForcesInWorldFrame_[numberOfLegs];
+  int numberOfActiveSetPasses_;
+
+  //! tasks of the desired accelerations and of the regularization, they do not change between the passes
+  HierarchicalLeastSquaresSolver::TaskMatrix accelerationTaskMatrix_;
+  HierarchicalLeastSquaresSolver::TaskVector accelerationTaskVector_;
+  HierarchicalLeastSquaresSolver::TaskMatrix regularizationTaskMatrix_;
+  HierarchicalLeastSquaresSolver::TaskVector regularizationTaskVector_;
+
+ private:
+  //! Computes the mass matrix, the gravity terms and the contact Jacobians.
+  bool updateModel();
+
+  //! Computes the desired accelerations of the torso and of the swing feet.
+  void updateDesiredAccelerations();
+
+  //! Starts the hierarchy with the dynamics and sets the checkpoint of the solver.
+  bool addDynamicsTask();
+
+  //! Sets up the tasks of the desired accelerations and of the regularization.
+  void updateTasks();
+
+  //! Solves the levels below the dynamics with the active friction constraints.
+  bool solveHierarchy();
+
+  /*! Activates the friction constraints that are violated by the forces of the last solution.
+   * @return true if a constraint was activated
+   */
+  bool activateViolatedFrictionConstraints();
+
+  //! Sets the joint torques from the equations of motion.
+  void setJointTorques();
+
+  /*!
+   * Check if parameters are loaded.
+   * @return true if parameters are loaded
+   */
+  bool isParametersLoaded() const;
+};
+
+} /* namespace loco */
+#endif /* LOCO_WHOLEBODYCONTROLLER_HPP_ */
@@ -0,0 +1,138 @@
+/*******************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * BlendedTrajectory.hpp
+ */
+
+#ifndef LOCO_BLENDEDTRAJECTORY_HPP_
+#define LOCO_BLENDEDTRAJECTORY_HPP_
+
+#include <memory>
+#include <vector>
+
+namespace loco {
+
+/*! Weighted sum of immutable 1D trajectories that is evaluated on demand.
+ *
+ * Interpolating between two blends only combines the weights and shares the underlying trajectories,
+ * i.e. no trajectory is re-sampled or re-fitted. This makes gait transitions as cheap as steady-state
+ * walking. Terms with zero weight are dropped, hence the blend collapses to a single trajectory again
+ * at the end of a transition.
+ *
+ * The trajectory type needs to provide double evaluate(double) const.
+ */
+template<typename Trajectory_>
+class BlendedTrajectory {
+ public:
+  typedef std::shared_ptr<const Trajectory_> TrajectoryPtr;
+
+  BlendedTrajectory() {
+
+  }
+
+  //! Sets a single trajectory with weight 1.
+  void setTrajectory(const TrajectoryPtr& trajectory) {
+    terms_.clear();
+    if (trajectory) {
+      terms_.push_back(Term(1.0, trajectory));
+    }
+  }
+
+  /*! Sets the blend to (1-t)*blend1 + t*blend2.
+   * @param blend1  blend at t=0, may be this blend
+   * @param blend2  blend at t=1, may be this blend
+   * @param t       interpolation parameter in [0,1]
+   * @returns true if successful
+   */
+  bool setToInterpolated(const BlendedTrajectory& blend1, const BlendedTrajectory& blend2, double t) {
+    if (t < 0.0) t = 0.0;
+    if (t > 1.0) t = 1.0;
+
+    // the arguments may alias this blend, hence the terms are collected in a scratch buffer that keeps its capacity
+    scratch_.clear();
+    addTerms(blend1, 1.0-t);
+    addTerms(blend2, t);
+    terms_.swap(scratch_);
+    scratch_.clear();
+    return true;
+  }
+
+  double evaluate(double t) const {
+    double value = 0.0;
+    for (const Term& term : terms_) {
+      value += term.weight_*term.trajectory_->evaluate(t);
+    }
+    return value;
+  }
+
+  //! Returns the number of trajectories that are blended.
+  int getNumberOfTrajectories() const {
+    return static_cast<int>(terms_.size());
+  }
+
+ private:
+  struct Term {
+    Term(double weight, const TrajectoryPtr& trajectory) : weight_(weight), trajectory_(trajectory) { }
+    double weight_;
+    TrajectoryPtr trajectory_;
+  };
+
+  void addTerms(const BlendedTrajectory& blend, double weight) {
+    if (weight == 0.0) {
+      return;
+    }
+    for (const Term& term : blend.terms_) {
+      bool isMerged = false;
+      for (Term& existingTerm : scratch_) {
+        if (existingTerm.trajectory_ == term.trajectory_) {
+          existingTerm.weight_ += weight*term.weight_;
+          isMerged = true;
+          break;
+        }
+      }
+      if (!isMerged) {
+        scratch_.push_back(Term(weight*term.weight_, term.trajectory_));
+      }
+    }
+  }
+
+ private:
+  std::vector<Term> terms_;
+  std::vector<Term> scratch_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_BLENDEDTRAJECTORY_HPP_ */
@@ -0,0 +1,276 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * FilterBank.hpp
+ */
+
+#ifndef LOCO_FILTERBANK_HPP_
+#define LOCO_FILTERBANK_HPP_
+
+#include <Eigen/Core>
+
+#include <cmath>
+
+namespace loco {
+namespace filter_bank {
+
+/*! Matrix exponential of a 3x3 matrix by scaling and squaring of a truncated Taylor series.
+ * It is only evaluated when the time step or the filter parameters change.
+ */
+inline Eigen::Matrix3d computeExponential(const Eigen::Matrix3d& matrix) {
+  const double norm = matrix.cwiseAbs().rowwise().sum().maxCoeff();
+  int nSquarings = 0;
+  if (norm > 0.5) {
+    nSquarings = static_cast<int>(std::ceil(std::log2(norm/0.5)));
+  }
+  const Eigen::Matrix3d scaledMatrix = matrix/std::pow(2.0, nSquarings);
+
+  Eigen::Matrix3d exponential = Eigen::Matrix3d::Identity();
+  Eigen::Matrix3d term = Eigen::Matrix3d::Identity();
+  for (int k=1; k<=12; k++) {
+    term = term*scaledMatrix/static_cast<double>(k);
+    exponential += term;
+  }
+  for (int k=0; k<nSquarings; k++) {
+    exponential = exponential*exponential;
+  }
+  return exponential;
+}
+
+} /* namespace filter_bank */
+
+
+/*! Bank of N independent first- or second-order low-pass filters that are advanced in one step.
+ *
+ * A first-order channel implements tau*dy/dt + y = K*u, a second-order channel
+ * d2y/dt2 + 2*zeta*omega*dy/dt + omega^2*y = K*omega^2*u. Both are discretized exactly under the
+ * assumption that the input is constant over the time step (zero-order hold), so the response does not
+ * depend on the rate at which advance() is called. The discrete coefficients are cached and only
+ * recomputed when the time step or the parameters change.
+ *
+ * All channels share the same state update
+ *    y[k+1] = a11*y[k] + a12*dy[k] + b1*u[k]
+ *   dy[k+1] = a21*y[k] + a22*dy[k] + b2*u[k]
+ * with coefficient-wise array operations, where the first-order channels have a12 = a21 = a22 = b2 = 0.
+ * The rate dy is therefore only meaningful for second-order channels.
+ *
+ * A channel with a non-positive time constant or a non-positive natural frequency passes its
+ * input through (times the gain). Until it is initialized, the bank is set to K*u by the first call to advance().
+ */
+template<int N>
+class FilterBank {
+ public:
+  //! The arrays are not aligned, such that the bank can be a member of any class.
+  typedef Eigen::Array<double, N, 1, Eigen::DontAlign> Array;
+
+  enum FilterType {
+    FirstOrder=0,
+    SecondOrder
+  };
+
+ public:
+  FilterBank():
+    dt_(-1.0),
+    isInitialized_(false),
+    areCoefficientsValid_(false)
+  {
+    for (int i=0; i<N; i++) {
+      filterType_[i] = FirstOrder;
+    }
+    timeConstant_.setZero();
+    naturalFrequency_.setZero();
+    dampingRatio_.setOnes();
+    gain_.setOnes();
+    output_.setZero();
+    rate_.setZero();
+    a11_.setZero();
+    a12_.setZero();
+    a21_.setZero();
+    a22_.setZero();
+    b1_.setOnes();
+    b2_.setZero();
+  }
+
+  //! Sets a first-order filter with time constant [s] and gain on all channels.
+  void setFirstOrder(double timeConstant, double gain = 1.0) {
+    for (int i=0; i<N; i++) {
+      setFirstOrder(i, timeConstant, gain);
+    }
+  }
+
+  //! Sets a first-order filter with time constant [s] and gain on one channel.
+  void setFirstOrder(int channel, double timeConstant, double gain = 1.0) {
+    filterType_[channel] = FirstOrder;
+    timeConstant_(channel) = timeConstant;
+    gain_(channel) = gain;
+    areCoefficientsValid_ = false;
+  }
+
+  //! Sets a second-order filter with natural frequency [rad/s], damping ratio and gain on all channels.
+  void setSecondOrder(double naturalFrequency, double dampingRatio, double gain = 1.0) {
+    for (int i=0; i<N; i++) {
+      setSecondOrder(i, naturalFrequency, dampingRatio, gain);
+    }
+  }
+
+  //! Sets a second-order filter with natural frequency [rad/s], damping ratio and gain on one channel.
+  void setSecondOrder(int channel, double naturalFrequency, double dampingRatio, double gain = 1.0) {
+    filterType_[channel] = SecondOrder;
+    naturalFrequency_(channel) = naturalFrequency;
+    dampingRatio_(channel) = dampingRatio;
+    gain_(channel) = gain;
+    areCoefficientsValid_ = false;
+  }
+
+  //! Sets the outputs of all channels and sets their rates to zero.
+  void initialize(const Array& output) {
+    output_ = output;
+    rate_.setZero();
+    isInitialized_ = true;
+  }
+
+  //! Sets the output of one channel and sets its rate to zero.
+  void initialize(int channel, double output) {
+    output_(channel) = output;
+    rate_(channel) = 0.0;
+  }
+
+  //! The next call to advance() sets the outputs to the (scaled) inputs.
+  void reset() {
+    isInitialized_ = false;
+  }
+
+  //! Advances all channels by the time step dt [s] with the given inputs and returns the outputs.
+  const Array& advance(double dt, const Array& input) {
+    if (!isInitialized_) {
+      output_ = gain_*input;
+      rate_.setZero();
+      isInitialized_ = true;
+      return output_;
+    }
+    if (dt <= 0.0) {
+      return output_;
+    }
+    if (!areCoefficientsValid_ || dt != dt_) {
+      updateCoefficients(dt);
+    }
+    const Array output = a11_*output_ + a12_*rate_ + b1_*input;
+    rate_ = a21_*output_ + a22_*rate_ + b2_*input;
+    output_ = output;
+    return output_;
+  }
+
+  const Array& getOutput() const {
+    return output_;
+  }
+
+  double getOutput(int channel) const {
+    return output_(channel);
+  }
+
+  //! Rates of the outputs (zero for first-order channels).
+  const Array& getRate() const {
+    return rate_;
+  }
+
+  FilterType getFilterType(int channel) const {
+    return filterType_[channel];
+  }
+
+  bool isInitialized() const {
+    return isInitialized_;
+  }
+
+ protected:
+  void updateCoefficients(double dt) {
+    for (int i=0; i<N; i++) {
+      if (filterType_[i] == FirstOrder) {
+        const double a = (timeConstant_(i) > 0.0) ? std::exp(-dt/timeConstant_(i)) : 0.0;
+        a11_(i) = a;
+        a12_(i) = 0.0;
+        a21_(i) = 0.0;
+        a22_(i) = 0.0;
+        b1_(i) = (1.0-a)*gain_(i);
+        b2_(i) = 0.0;
+      }
+      else if (naturalFrequency_(i) <= 0.0) {
+        a11_(i) = 0.0;
+        a12_(i) = 0.0;
+        a21_(i) = 0.0;
+        a22_(i) = 0.0;
+        b1_(i) = gain_(i);
+        b2_(i) = 0.0;
+      }
+      else {
+        // exponential of the continuous system augmented by the constant input: [A B; 0 0]*dt
+        const double omega = naturalFrequency_(i);
+        Eigen::Matrix3d augmentedSystem = Eigen::Matrix3d::Zero();
+        augmentedSystem(0,1) = 1.0;
+        augmentedSystem(1,0) = -omega*omega;
+        augmentedSystem(1,1) = -2.0*dampingRatio_(i)*omega;
+        augmentedSystem(1,2) = gain_(i)*omega*omega;
+        const Eigen::Matrix3d discreteSystem = filter_bank::computeExponential(augmentedSystem*dt);
+        a11_(i) = discreteSystem(0,0);
+        a12_(i) = discreteSystem(0,1);
+        a21_(i) = discreteSystem(1,0);
+        a22_(i) = discreteSystem(1,1);
+        b1_(i) = discreteSystem(0,2);
+        b2_(i) = discreteSystem(1,2);
+      }
+    }
+    dt_ = dt;
+    areCoefficientsValid_ = true;
+  }
+
+ protected:
+  FilterType filterType_[N];
+  Array timeConstant_;
+  Array naturalFrequency_;
+  Array dampingRatio_;
+  Array gain_;
+
+  Array output_;
+  Array rate_;
+
+  //! discrete coefficients of the time step dt_
+  Array a11_, a12_, a21_, a22_, b1_, b2_;
+  double dt_;
+  bool isInitialized_;
+  bool areCoefficientsValid_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_FILTERBANK_HPP_ */
@@ -0,0 +1,113 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * LockFreeQueue.hpp
+ */
+
+#ifndef LOCO_LOCKFREEQUEUE_HPP_
+#define LOCO_LOCKFREEQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+namespace loco {
+
+/*! Bounded queue for exactly one producer thread and one consumer thread.
+ *
+ * The items are stored in a fixed ring buffer, so neither push() nor pop() allocates, locks or blocks.
+ * push() fails if the queue is full and pop() fails if it is empty.
+ */
+template<typename T, int Capacity>
+class LockFreeQueue {
+ public:
+  LockFreeQueue():
+    head_(0),
+    tail_(0)
+  {
+
+  }
+
+  //! Called by the producer. Returns false if the queue is full.
+  bool push(const T& item) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t nextTail = increment(tail);
+    if (nextTail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    buffer_[tail] = item;
+    tail_.store(nextTail, std::memory_order_release);
+    return true;
+  }
+
+  //! Called by the consumer. Returns false if the queue is empty.
+  bool pop(T& item) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = buffer_[head];
+    head_.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+  bool isEmpty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  //! Removes all items. Must not be called while the producer or the consumer is active.
+  void clear() {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+  }
+
+  int getCapacity() const {
+    return Capacity;
+  }
+
+ protected:
+  static std::size_t increment(std::size_t index) {
+    return (index+1 == Capacity+1) ? 0 : index+1;
+  }
+
+ protected:
+  //! One slot is kept free to distinguish a full from an empty queue.
+  T buffer_[Capacity+1];
+  std::atomic<std::size_t> head_;
+  std::atomic<std::size_t> tail_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_LOCKFREEQUEUE_HPP_ */
@@ -0,0 +1,130 @@
+/*******************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * QuinticPolynomial.hpp
+ */
+
+#ifndef LOCO_QUINTICPOLYNOMIAL_HPP_
+#define LOCO_QUINTICPOLYNOMIAL_HPP_
+
+namespace loco {
+
+/*! Polynomial of fifth order p(t) = c0 + c1*t + ... + c5*t^5 defined on [0, duration].
+ *
+ * The polynomial is fitted in closed form to the position, velocity and acceleration at both ends.
+ * With zero velocity and acceleration at both ends, this is the minimum-jerk trajectory.
+ * Outside of [0, duration], the polynomial is clamped to the boundary values.
+ */
+class QuinticPolynomial {
+ public:
+  QuinticPolynomial() :
+    duration_(0.0)
+  {
+    for (int i=0; i<6; i++) {
+      coefficients_[i] = 0.0;
+    }
+  }
+
+  /*! Fits the polynomial to the boundary conditions.
+   * @param duration  duration of the polynomial, must be positive
+   * @param p0, v0, a0  position, velocity and acceleration at t=0
+   * @param p1, v1, a1  position, velocity and acceleration at t=duration
+   */
+  void fit(double duration, double p0, double v0, double a0, double p1, double v1, double a1) {
+    if (duration <= 0.0) {
+      // degenerated: jump to the target
+      duration_ = 0.0;
+      coefficients_[0] = p1;
+      for (int i=1; i<6; i++) {
+        coefficients_[i] = 0.0;
+      }
+      return;
+    }
+    const double T = duration;
+    const double T2 = T*T;
+    const double T3 = T2*T;
+    const double h = p1-p0;
+    duration_ = duration;
+    coefficients_[0] = p0;
+    coefficients_[1] = v0;
+    coefficients_[2] = 0.5*a0;
+    coefficients_[3] = (20.0*h - (8.0*v1 + 12.0*v0)*T - (3.0*a0 - a1)*T2) / (2.0*T3);
+    coefficients_[4] = (-30.0*h + (14.0*v1 + 16.0*v0)*T + (3.0*a0 - 2.0*a1)*T2) / (2.0*T3*T);
+    coefficients_[5] = (12.0*h - 6.0*(v1 + v0)*T + (a1 - a0)*T2) / (2.0*T3*T2);
+  }
+
+  //! Fits a minimum-jerk polynomial from p0 to p1, i.e. the velocity and acceleration are zero at both ends.
+  void fitMinimumJerk(double duration, double p0, double p1) {
+    fit(duration, p0, 0.0, 0.0, p1, 0.0, 0.0);
+  }
+
+  double getPosition(double t) const {
+    t = clamp(t);
+    const double* c = coefficients_;
+    return c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5]))));
+  }
+
+  double getVelocity(double t) const {
+    t = clamp(t);
+    const double* c = coefficients_;
+    return c[1] + t*(2.0*c[2] + t*(3.0*c[3] + t*(4.0*c[4] + t*5.0*c[5])));
+  }
+
+  double getAcceleration(double t) const {
+    t = clamp(t);
+    const double* c = coefficients_;
+    return 2.0*c[2] + t*(6.0*c[3] + t*(12.0*c[4] + t*20.0*c[5]));
+  }
+
+  double getDuration() const {
+    return duration_;
+  }
+
+ private:
+  double clamp(double t) const {
+    if (t < 0.0) return 0.0;
+    if (t > duration_) return duration_;
+    return t;
+  }
+
+ private:
+  //! coefficients c0..c5
+  double coefficients_[6];
+  double duration_;
+};
+
+} // namespace loco
+
+#endif /* LOCO_QUINTICPOLYNOMIAL_HPP_ */
@@ -39,7 +39,10 @@
 #include "kindr/rotations/RotationEigen.hpp"
 #include "kindr/rotations/RotationDiffEigen.hpp"
 
+#include "loco/temp_helpers/TrajectoryBatchEvaluation.hpp"
+
 #include <limits>
+#include <memory>
 
 
 
@@ -55,102 +58,193 @@
 
 namespace loco {
 
+/**
+	This class holds the lookup state that is used to find the interval of a trajectory in which a parameter value lies.
+	The knots of a trajectory are shared and never modified in place, hence several users (e.g. threads or legs) can
+	evaluate the same trajectory concurrently as long as each of them uses its own cursor.
+*/
+class TrajectoryCursor {
+public:
+	TrajectoryCursor(void){
+		lastIndex = 0;
+	}
+
+	void reset(){
+		lastIndex = 0;
+	}
+
+	// A caching variable to optimize searching
+	int lastIndex;
+};
+
 /**
 	This class is used to represent generic trajectories. The class parameter T can be anything that provides basic operation such as addition and subtraction.
 	We'll define a trajectory that can be parameterized by a one-d parameter (called t). Based on a set of knots ( tuples <t, T>), we can evaluate the
 	trajectory at any t, through interpolation. This is not used for extrapolation. Outside the range of the knots, the closest known value is returned instead.
+
+	The knots are reference-counted and shared between copies of a trajectory. They are copied on write, i.e. only when a trajectory that
+	shares its knots is modified. The const evaluation methods take an external TrajectoryCursor and are safe to call from several threads.
 */
 
 template <class T> class GenericTrajectory {
+public:
+	/**
+		The knots of a trajectory. An instance is not modified anymore once it is shared.
+	*/
+	struct KnotData {
+		std::vector<double> tValues;
+		std::vector<T> values;
+	};
+
 protected:
-	std::vector<double> tValues;
-	std::vector<T> values;
+	std::shared_ptr<KnotData> knots_;
 
-	// A caching variable to optimize searching
-	volatile int lastIndex;
+	// Cursor used by the non-const evaluation methods
+	TrajectoryCursor cursor_;
+
+	/**
+		Returns the knots that are shared by all copies of an empty trajectory.
+	*/
+	static const std::shared_ptr<KnotData>& getEmptyKnotData(){
+		static const std::shared_ptr<KnotData> empty = std::make_shared<KnotData>();
+		return empty;
+	}
 
+	/**
+		Returns the knots for modification. The knots are copied first if they are shared with another trajectory.
+	*/
+	KnotData& getMutableKnotData(){
+		if (knots_.use_count() != 1) {
+			knots_ = std::make_shared<KnotData>(*knots_);
+		}
+		cursor_.reset();
+		return *knots_;
+	}
 
 	/**
 		This method returns the index of the first knot whose value is larger than the parameter value t. If no such index exists (t is larger than any
 		of the values stored), then values.size() is returned.
 	*/
-	int getFirstLargerIndex(double t){
+	int getFirstLargerIndex(double t, TrajectoryCursor& cursor) const {
+		const std::vector<double>& tValues = knots_->tValues;
 		int size = tValues.size();
 		if( size == 0 )
 			return 0;
-		if( t < tValues[(lastIndex+size-1)%size] )
-			lastIndex = 0;
+		if( cursor.lastIndex >= size || t < tValues[(cursor.lastIndex+size-1)%size] )
+			cursor.lastIndex = 0;
 		for (int i = 0; i<size;i++){
-			int index = (i + lastIndex) % size;
+			int index = (i + cursor.lastIndex) % size;
 			if (t < tValues[index]) {
-				lastIndex = index;
+				cursor.lastIndex = index;
 				return index;
 			}
 		}
 		return size;
 	}
 
+	int getFirstLargerIndex(double t){
+		return getFirstLargerIndex(t, cursor_);
+	}
+
 public:
 	typedef T Type;
 
-	GenericTrajectory(void){
-		lastIndex = 0;
+	GenericTrajectory(void) :
+		knots_(getEmptyKnotData()),
+		cursor_()
+	{
 	}
-	GenericTrajectory( GenericTrajectory<T>& other ){
-		lastIndex = 0;
-		copy( other );
+
+	/**
+		The copy shares the knots with other.
+	*/
+	GenericTrajectory( const GenericTrajectory<T>& other ) :
+		knots_(other.knots_),
+		cursor_()
+	{
 	}
+
 	GenericTrajectory<T>& operator =( const GenericTrajectory<T>& other ){
-    lastIndex = 0;
-    copy( other );
-    return *this;
-  }
+		copy( other );
+		return *this;
+	}
 
 
 	virtual ~GenericTrajectory(void){
-		clear();
 	}
 
 	/**
 		This method performs linear interpolation to evaluate the trajectory at the point t
 	*/
-	T evaluate_linear(double t){
+	T evaluate_linear(double t, TrajectoryCursor& cursor) const {
+		const std::vector<double>& tValues = knots_->tValues;
+		const std::vector<T>& values = knots_->values;
 		int size = tValues.size();
 		if (t<=tValues[0]) return values[0];
 		if (t>=tValues[size-1])	return values[size-1];
-		int index = getFirstLargerIndex(t);
+		int index = getFirstLargerIndex(t, cursor);
 
 		//now linearly interpolate between inedx-1 and index
 		t = (t-tValues[index-1]) / (tValues[index]-tValues[index-1]);
 		return (values[index-1]) * (1-t) + (values[index]) * t;
 	}
 
-	void evaluate_catmull_rom_traj(const int nPoints, std::vector<double>& tArray, std::vector<T>& valArray) {
+	T evaluate_linear(double t){
+		return evaluate_linear(t, cursor_);
+	}
+
+	/**
+		This method evaluates the trajectory by linear interpolation at nPoints parameter values.
+		The result is written to the preallocated array valArray. The samples are vectorized for
+		T = double and T = Eigen::Vector3d. The lookup cache is not used, hence the method is const.
+	*/
+	void evaluate_linear(const double* tArray, T* valArray, int nPoints) const {
+		trajectory_batch::evaluate(knots_->tValues, knots_->values, tArray, nPoints, valArray, false);
+	}
+
+	/**
+		This method interprets the trajectory as a Catmul-Rom spline and evaluates it at nPoints parameter values.
+		The result is written to the preallocated array valArray. The samples are vectorized for
+		T = double and T = Eigen::Vector3d. The lookup cache is not used, hence the method is const.
+	*/
+	void evaluate_catmull_rom(const double* tArray, T* valArray, int nPoints) const {
+		trajectory_batch::evaluate(knots_->tValues, knots_->values, tArray, nPoints, valArray, true);
+	}
+
+	void evaluate_catmull_rom_traj(const int nPoints, std::vector<double>& tArray, std::vector<T>& valArray) const {
+		if (nPoints <= 0) return;
 		double tmax = getMaxPosition();
 		double tmin = getMinPosition();
-		double tstep = (tmax-tmin)/(double)(nPoints-1);
-		double t = tmin;
+		double tstep = (nPoints > 1) ? (tmax-tmin)/(double)(nPoints-1) : 0.0;
 
+		const int offset = tArray.size();
+		tArray.resize(offset+nPoints);
 		for (int i=0; i<nPoints; i++) {
-			tArray.push_back(t);
-			valArray.push_back(evaluate_catmull_rom(t));
-			t +=tstep;
+			tArray[offset+i] = tmin + i*tstep;
 		}
+		valArray.resize(valArray.size()+nPoints);
+		evaluate_catmull_rom(&tArray[offset], &valArray[valArray.size()-nPoints], nPoints);
+	}
+
+	T evaluate(double t, TrajectoryCursor& cursor) const {
+		return evaluate_catmull_rom(t, cursor);
 	}
 
 	T evaluate(double t) {
-		return evaluate_catmull_rom(t);
+		return evaluate_catmull_rom(t, cursor_);
 	}
 
 	/**
 		This method interprets the trajectory as a Catmul-Rom spline, and evaluates it at the point t
 	*/
-	T evaluate_catmull_rom(double t){
+	T evaluate_catmull_rom(double t, TrajectoryCursor& cursor) const {
+		const std::vector<double>& tValues = knots_->tValues;
+		const std::vector<T>& values = knots_->values;
 		const double tiny_number = 0.000000001;
 		int size = tValues.size();
 		if (t<=tValues[0]) return values[0];
 		if (t>=tValues[size-1])	return values[size-1];
-		int index = getFirstLargerIndex(t);
+		int index = getFirstLargerIndex(t, cursor);
 
 		//now that we found the interval, get a value that indicates how far we are along it
 		t = (t-tValues[index-1]) / (tValues[index]-tValues[index-1]);
@@ -191,56 +285,72 @@ public:
 		return p1*(2*t3-3*t2+1) + m1*(t3-2*t2+t) + p2*(-2*t3+3*t2) + m2 * (t3 - t2);
 	}
 
+	T evaluate_catmull_rom(double t){
+		return evaluate_catmull_rom(t, cursor_);
+	}
+
+	/**
+		Returns the knots of the trajectory. They can be shared with other trajectories.
+	*/
+	std::shared_ptr<const KnotData> getKnotData() const {
+		return knots_;
+	}
+
+	/**
+		Returns true if the knots are shared with another trajectory.
+	*/
+	bool isSharingKnots(const GenericTrajectory<T>& other) const {
+		return knots_ == other.knots_;
+	}
+
 	/**
 		Returns the value of the ith knot. It is assumed that i is within the correct range.
+		Use setKnotValue to modify it, the knots may be shared with other trajectories.
 	*/
 	const T& getKnotValue(int i) const {
-		return values[i];
+		return knots_->values[i];
 	}
 
-  T& getKnotValue(int i) {
-    return values[i];
-  }
-
 	/**
 		Returns the position of the ith knot. It is assumed that i is within the correct range.
 	*/
 	double getKnotPosition(int i) const{
-		return tValues[i];
+		return knots_->tValues[i];
 	}
 
 	/**
 		Sets the value of the ith knot to val. It is assumed that i is within the correct range.
 	*/
 	void setKnotValue(int i, const T& val){
-		values[i] = val;
+		getMutableKnotData().values[i] = val;
 	}
 
 	/**
 		Sets the position of the ith knot to pos. It is assumed that i is within the correct range.
 	*/
 	void setKnotPosition(int i, double pos){
+		const std::vector<double>& tValues = knots_->tValues;
 		if( i-1 >= 0               && tValues[i-1] >= pos ) return;
 		if( (uint)(i+1) < tValues.size()-1 && tValues[i+1] <= pos ) return;
-		tValues[i] = pos;
+		getMutableKnotData().tValues[i] = pos;
 	}
 
 	/**
 		Return the smallest tValue or infinity if none
 	*/
-	double getMinPosition(){
-		if( tValues.empty() )
+	double getMinPosition() const {
+		if( knots_->tValues.empty() )
 			return std::numeric_limits<double>::infinity();
-		return tValues.front();
+		return knots_->tValues.front();
 	}
 
 	/**
 		Return the largest tValue or -infinity if none
 	*/
-	double getMaxPosition(){
-		if( tValues.empty() )
+	double getMaxPosition() const {
+		if( knots_->tValues.empty() )
 			return -std::numeric_limits<double>::infinity();
-		return tValues.back();
+		return knots_->tValues.back();
 	}
 
 
@@ -248,7 +358,7 @@ public:
 		returns the number of knots in this trajectory
 	*/
 	int getKnotCount() const{
-		return tValues.size();
+		return knots_->tValues.size();
 	}
 
 	/**
@@ -258,8 +368,9 @@ public:
 		//first we need to know where to insert it, based on the t-values
 		int index = getFirstLargerIndex(t);
 
-		tValues.insert(tValues.begin()+index, t);
-		values.insert(values.begin()+index, val);
+		KnotData& knots = getMutableKnotData();
+		knots.tValues.insert(knots.tValues.begin()+index, t);
+		knots.values.insert(knots.values.begin()+index, val);
 	}
 
 	/**
@@ -267,16 +378,17 @@ public:
 		It is assumed that i is within the correct range.
 	*/
 	void removeKnot(int i){
-		tValues.erase(tValues.begin()+i);
-		values.erase(values.begin()+i);
+		KnotData& knots = getMutableKnotData();
+		knots.tValues.erase(knots.tValues.begin()+i);
+		knots.values.erase(knots.values.begin()+i);
 	}
 
 	/**
 		This method removes everything from the trajectory.
 	*/
 	void clear(){
-		tValues.clear();
-		values.clear();
+		knots_ = getEmptyKnotData();
+		cursor_.reset();
 	}
 
 	/**
@@ -287,12 +399,12 @@ public:
 		if( getKnotCount() < 3 )
 			return;
 
-		double startTime = tValues.front();
-		double endTime = tValues.back();
+		double startTime = knots_->tValues.front();
+		double endTime = knots_->tValues.back();
 
 		GenericTrajectory<T> result;
-		result.addKnot( startTime, values.front() );
-		result.addKnot( endTime, values.back() );
+		result.addKnot( startTime, knots_->values.front() );
+		result.addKnot( endTime, knots_->values.back() );
 
 
 		while( true ) {
@@ -318,35 +430,14 @@ public:
 		copy( result );
 	}
 
-
-	void copy( GenericTrajectory<T>& other ) {
-
-		tValues.clear();
-		values.clear();
-		int size = other.getKnotCount();
-
-		tValues.reserve(size);
-		values.reserve(size);
-		for( int i=0; i < size; ++i ) {
-			tValues.push_back( other.tValues[i] );
-			values.push_back( other.values[i] );
-		}
+	/**
+		Shares the knots of other.
+	*/
+	void copy( const GenericTrajectory<T>& other ) {
+		knots_ = other.knots_;
+		cursor_.reset();
 	}
 
-  void copy( const GenericTrajectory<T>& other ) {
-
-    tValues.clear();
-    values.clear();
-    int size = other.getKnotCount();
-
-    tValues.reserve(size);
-    values.reserve(size);
-    for( int i=0; i < size; ++i ) {
-      tValues.push_back( other.tValues[i] );
-      values.push_back( other.values[i] );
-    }
-  }
-
 };
 
 class Trajectory1D: public GenericTrajectory<double> {
@@ -411,17 +502,23 @@ public:
   void evaluate_catmull_rom_traj(const int nPoints, std::vector<double>& tArray, std::vector<ValueType>& valArray) = delete;
   ValueType evaluate(double t) = delete;
 
-  ValueType evaluate_linear(double t) {
+  ValueType evaluate_linear(double t, TrajectoryCursor& cursor) const {
+    const std::vector<double>& tValues = knots_->tValues;
+    const std::vector<ValueType>& values = knots_->values;
     int size = tValues.size();
     if (t<=tValues[0]) return values[0];
     if (t>=tValues[size-1]) return values[size-1];
-    int index = getFirstLargerIndex(t);
+    int index = getFirstLargerIndex(t, cursor);
 
     //now linearly interpolate between inedx-1 and index
     t = (t-tValues[index-1]) / (tValues[index]-tValues[index-1]);
 //    return (values[index-1]) * (1-t) + (values[index]) * t;
     return values[index-1].boxPlus(values[index].boxMinus(values[index-1])*t);
   }
+
+  ValueType evaluate_linear(double t) {
+    return evaluate_linear(t, cursor_);
+  }
 };
 
 typedef GenericTrajectory<kindr::phys_quant::eigen_impl::VectorTypeless3D> TrajectoryVector;
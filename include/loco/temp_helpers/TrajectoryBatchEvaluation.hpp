@@ -0,0 +1,307 @@
+/*******************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TrajectoryBatchEvaluation.hpp
+ */
+
+#ifndef LOCO_TRAJECTORYBATCHEVALUATION_HPP_
+#define LOCO_TRAJECTORYBATCHEVALUATION_HPP_
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace loco {
+namespace trajectory_batch {
+
+//! Number of samples that are processed at once. The scratch memory of a block lives on the stack.
+const int kBlockSize = 64;
+
+/*! Scratch memory of one block of samples.
+ *
+ * Both the linear and the Catmull-Rom interpolation are written as a weighted sum of four
+ * consecutive knots starting at firstKnotIndex_[k] (indices are clamped to the valid range).
+ * Linear interpolation simply has zero weights for the outer two knots.
+ */
+struct Block {
+  int knotIndex_[4][kBlockSize];
+  double weight_[4][kBlockSize];
+  double u_[kBlockSize];
+  int segmentIndex_[kBlockSize];
+};
+
+/*! Finds the segment of each sample and the normalized position within the segment.
+ *
+ * The segment index is the index of the first knot whose position is larger than t.
+ * Samples outside the range of the knots are clamped to the first or last knot, which
+ * reproduces the behavior of GenericTrajectory::evaluate_linear and evaluate_catmull_rom.
+ * Sorted samples (the common case when plotting) are searched with a moving hint.
+ */
+inline void computeSegments(const std::vector<double>& knots, const double* t, int nSamples, Block& block) {
+  const int nKnots = knots.size();
+  const double tMin = knots.front();
+  const double tMax = knots.back();
+  int hint = 1;
+  for (int k=0; k<nSamples; k++) {
+    const double time = t[k];
+    if (time <= tMin) {
+      block.segmentIndex_[k] = 1;
+      block.u_[k] = 0.0;
+      continue;
+    }
+    if (time >= tMax) {
+      block.segmentIndex_[k] = nKnots-1;
+      block.u_[k] = 1.0;
+      continue;
+    }
+    if (!(knots[hint-1] <= time && time < knots[hint])) {
+      if (hint+1 < nKnots && knots[hint] <= time && time < knots[hint+1]) {
+        hint++;
+      }
+      else {
+        hint = std::upper_bound(knots.begin(), knots.end(), time) - knots.begin();
+      }
+    }
+    block.segmentIndex_[k] = hint;
+    block.u_[k] = time;
+  }
+
+  // normalize the samples inside the range: u = (t - t_{i-1})/(t_i - t_{i-1})
+  const double* knotData = knots.data();
+  int k = 0;
+#ifdef __AVX2__
+  for (; k+4<=nSamples; k+=4) {
+    const __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&block.segmentIndex_[k]));
+    const __m128i indexPrevious = _mm_sub_epi32(index, _mm_set1_epi32(1));
+    const __m256d tStart = _mm256_i32gather_pd(knotData, indexPrevious, 8);
+    const __m256d tEnd = _mm256_i32gather_pd(knotData, index, 8);
+    const __m256d time = _mm256_loadu_pd(&t[k]);
+    const __m256d u = _mm256_div_pd(_mm256_sub_pd(time, tStart), _mm256_sub_pd(tEnd, tStart));
+    // keep the clamped values of samples outside the range
+    const __m256d isInside = _mm256_and_pd(_mm256_cmp_pd(time, _mm256_set1_pd(tMin), _CMP_GT_OQ),
+                                           _mm256_cmp_pd(time, _mm256_set1_pd(tMax), _CMP_LT_OQ));
+    _mm256_storeu_pd(&block.u_[k], _mm256_blendv_pd(_mm256_loadu_pd(&block.u_[k]), u, isInside));
+  }
+#endif
+  for (; k<nSamples; k++) {
+    if (t[k] > tMin && t[k] < tMax) {
+      const int index = block.segmentIndex_[k];
+      block.u_[k] = (t[k]-knotData[index-1]) / (knotData[index]-knotData[index-1]);
+    }
+  }
+
+  // indices of the four knots (i-2, i-1, i, i+1) clamped to the valid range
+  const int lastKnot = nKnots-1;
+  for (int k=0; k<nSamples; k++) {
+    const int index = block.segmentIndex_[k];
+    block.knotIndex_[0][k] = std::max(index-2, 0);
+    block.knotIndex_[1][k] = index-1;
+    block.knotIndex_[2][k] = index;
+    block.knotIndex_[3][k] = std::min(index+1, lastKnot);
+  }
+}
+
+//! Weights of the linear interpolation: (0, 1-u, u, 0).
+inline void computeLinearWeights(int nSamples, Block& block) {
+  for (int k=0; k<nSamples; k++) {
+    const double u = block.u_[k];
+    block.weight_[0][k] = 0.0;
+    block.weight_[1][k] = 1.0-u;
+    block.weight_[2][k] = u;
+    block.weight_[3][k] = 0.0;
+  }
+}
+
+/*! Weights of the Catmull-Rom spline.
+ *
+ * The Hermite form p1*h00 + m1*h10 + p2*h01 + m2*h11 with m1 = (p2-p0)/2 and m2 = (p3-p1)/2
+ * is rewritten as a weighted sum of the four knots p0..p3.
+ */
+inline void computeCatmullRomWeights(int nSamples, Block& block) {
+  int k = 0;
+#ifdef __AVX2__
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d three = _mm256_set1_pd(3.0);
+  const __m256d half = _mm256_set1_pd(0.5);
+  for (; k+4<=nSamples; k+=4) {
+    const __m256d u = _mm256_loadu_pd(&block.u_[k]);
+    const __m256d u2 = _mm256_mul_pd(u, u);
+    const __m256d u3 = _mm256_mul_pd(u2, u);
+    const __m256d h00 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(two, u3), _mm256_mul_pd(three, u2)), one);
+    const __m256d h10 = _mm256_add_pd(_mm256_sub_pd(u3, _mm256_mul_pd(two, u2)), u);
+    const __m256d h01 = _mm256_sub_pd(_mm256_mul_pd(three, u2), _mm256_mul_pd(two, u3));
+    const __m256d h11 = _mm256_sub_pd(u3, u2);
+    _mm256_storeu_pd(&block.weight_[0][k], _mm256_mul_pd(_mm256_set1_pd(-0.5), h10));
+    _mm256_storeu_pd(&block.weight_[1][k], _mm256_sub_pd(h00, _mm256_mul_pd(half, h11)));
+    _mm256_storeu_pd(&block.weight_[2][k], _mm256_add_pd(h01, _mm256_mul_pd(half, h10)));
+    _mm256_storeu_pd(&block.weight_[3][k], _mm256_mul_pd(half, h11));
+  }
+#endif
+  for (; k<nSamples; k++) {
+    const double u = block.u_[k];
+    const double u2 = u*u;
+    const double u3 = u2*u;
+    const double h00 = 2.0*u3-3.0*u2+1.0;
+    const double h10 = u3-2.0*u2+u;
+    const double h01 = -2.0*u3+3.0*u2;
+    const double h11 = u3-u2;
+    block.weight_[0][k] = -0.5*h10;
+    block.weight_[1][k] = h00-0.5*h11;
+    block.weight_[2][k] = h01+0.5*h10;
+    block.weight_[3][k] = 0.5*h11;
+  }
+}
+
+/*! Computes the weighted sum of the knot values.
+ *
+ * The generic version works with any type that supports multiplication with a scalar and addition.
+ * Specializations for double and Eigen::Vector3d vectorize across samples.
+ */
+template <typename T>
+struct Combiner {
+  static void combine(const std::vector<T>& values, int nSamples, const Block& block, T* result) {
+    for (int k=0; k<nSamples; k++) {
+      result[k] = values[block.knotIndex_[0][k]]*block.weight_[0][k]
+                + values[block.knotIndex_[1][k]]*block.weight_[1][k]
+                + values[block.knotIndex_[2][k]]*block.weight_[2][k]
+                + values[block.knotIndex_[3][k]]*block.weight_[3][k];
+    }
+  }
+};
+
+/*! Sums up the four weighted knots of samples k..k+3.
+ *
+ * @param data      pointer to the first component of the first knot
+ * @param stride    number of doubles between two knots
+ */
+#ifdef __AVX2__
+inline __m256d combineFour(const double* data, int stride, const Block& block, int k) {
+  const __m128i vStride = _mm_set1_epi32(stride);
+  __m256d sum = _mm256_setzero_pd();
+  for (int iTap=0; iTap<4; iTap++) {
+    const __m128i index = _mm_mullo_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&block.knotIndex_[iTap][k])), vStride);
+    const __m256d value = _mm256_i32gather_pd(data, index, 8);
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(value, _mm256_loadu_pd(&block.weight_[iTap][k])));
+  }
+  return sum;
+}
+#endif
+
+template <>
+struct Combiner<double> {
+  static void combine(const std::vector<double>& values, int nSamples, const Block& block, double* result) {
+    int k = 0;
+#ifdef __AVX2__
+    for (; k+4<=nSamples; k+=4) {
+      _mm256_storeu_pd(&result[k], combineFour(values.data(), 1, block, k));
+    }
+#endif
+    for (; k<nSamples; k++) {
+      result[k] = values[block.knotIndex_[0][k]]*block.weight_[0][k]
+                + values[block.knotIndex_[1][k]]*block.weight_[1][k]
+                + values[block.knotIndex_[2][k]]*block.weight_[2][k]
+                + values[block.knotIndex_[3][k]]*block.weight_[3][k];
+    }
+  }
+};
+
+template <>
+struct Combiner<Eigen::Vector3d> {
+  static void combine(const std::vector<Eigen::Vector3d>& values, int nSamples, const Block& block, Eigen::Vector3d* result) {
+    static_assert(sizeof(Eigen::Vector3d) == 3*sizeof(double), "Knots of TrajectoryEigen3D are expected to be packed.");
+    int k = 0;
+#ifdef __AVX2__
+    const double* data = values[0].data();
+    double component[3][4];
+    for (; k+4<=nSamples; k+=4) {
+      for (int iDim=0; iDim<3; iDim++) {
+        _mm256_storeu_pd(component[iDim], combineFour(data+iDim, 3, block, k));
+      }
+      for (int j=0; j<4; j++) {
+        result[k+j] = Eigen::Vector3d(component[0][j], component[1][j], component[2][j]);
+      }
+    }
+#endif
+    for (; k<nSamples; k++) {
+      result[k] = values[block.knotIndex_[0][k]]*block.weight_[0][k]
+                + values[block.knotIndex_[1][k]]*block.weight_[1][k]
+                + values[block.knotIndex_[2][k]]*block.weight_[2][k]
+                + values[block.knotIndex_[3][k]]*block.weight_[3][k];
+    }
+  }
+};
+
+/*! Evaluates a trajectory given by its knots at nSamples parameter values.
+ *
+ * @param knots        positions of the knots (sorted)
+ * @param values       values of the knots
+ * @param t            array of nSamples parameter values
+ * @param nSamples     number of samples
+ * @param result       preallocated array of nSamples values
+ * @param catmullRom   if true, the trajectory is interpreted as Catmull-Rom spline, otherwise it is linearly interpolated
+ */
+template <typename T>
+void evaluate(const std::vector<double>& knots, const std::vector<T>& values, const double* t, int nSamples, T* result, bool catmullRom) {
+  if (knots.empty()) {
+    return;
+  }
+  if (knots.size() == 1) {
+    std::fill(result, result+nSamples, values[0]);
+    return;
+  }
+  Block block;
+  for (int start=0; start<nSamples; start+=kBlockSize) {
+    const int n = std::min(kBlockSize, nSamples-start);
+    computeSegments(knots, t+start, n, block);
+    if (catmullRom) {
+      computeCatmullRomWeights(n, block);
+    }
+    else {
+      computeLinearWeights(n, block);
+    }
+    Combiner<T>::combine(values, n, block, result+start);
+  }
+}
+
+} // namespace trajectory_batch
+} // namespace loco
+
+#endif /* LOCO_TRAJECTORYBATCHEVALUATION_HPP_ */
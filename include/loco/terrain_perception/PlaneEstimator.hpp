@@ -0,0 +1,147 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * PlaneEstimator.hpp
+ */
+
+#ifndef LOCO_PLANEESTIMATOR_HPP_
+#define LOCO_PLANEESTIMATOR_HPP_
+
+#include "loco/common/TypeDefs.hpp"
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace loco {
+
+//! Recursive least squares fit of a plane to a sliding window of points
+/*! The plane is parameterized as z = d - a*x - b*y with the parameters [a b d]^T, i.e. the
+ *  regressor of a point is h = [-x -y 1]^T. The estimator keeps the information matrix
+ *  A = sum_k w_k*h_k*h_k^T and the vector b = sum_k w_k*h_k*z_k of the last N points with the
+ *  weights w_k = lambda^age. Adding a point scales the sums by the forgetting factor lambda,
+ *  adds the new point and removes the point that leaves the window, hence an update is O(1).
+ *  The parameters are obtained from the 3x3 normal equations A*theta = b.
+ */
+class PlaneEstimator {
+ public:
+  /*! Constructor
+   * @param windowSize        maximal number of points in the window
+   * @param forgettingFactor  weight factor lambda in (0, 1] per added point (1: no forgetting)
+   */
+  PlaneEstimator(int windowSize = 8, double forgettingFactor = 1.0);
+  virtual ~PlaneEstimator();
+
+  //! Removes all points
+  void reset();
+
+  /*! Sets the size of the window and the forgetting factor, the points are removed.
+   * @param windowSize        maximal number of points in the window
+   * @param forgettingFactor  weight factor lambda in (0, 1] per added point
+   */
+  void setParameters(int windowSize, double forgettingFactor);
+
+  /*! Sets the weight of a prior that pulls the slope parameters a and b towards a horizontal plane.
+   * With a positive weight, the fit is also defined for less than three or collinear points.
+   * @param weight  weight of the prior (0: no prior)
+   */
+  void setSlopePriorWeight(double weight);
+
+  /*! Adds a point to the window and drops the oldest point if the window is full.
+   * @param positionInWorldFrame  measured point on the plane
+   */
+  void addPoint(const Position& positionInWorldFrame);
+
+  /*! Solves the normal equations with the points in the window.
+   * @returns false if there are less than three points or the points are (close to) collinear
+   *          and no slope prior is set, in this case the previous estimate is kept
+   */
+  bool estimate();
+
+  //! @returns parameters [a b d]^T of the plane z = d - a*x - b*y
+  const Eigen::Vector3d& getParameters() const;
+
+  //! @returns covariance of the parameters [a b d]^T
+  const Eigen::Matrix3d& getCovariance() const;
+
+  //! @returns weighted variance of the height residuals
+  double getResidualVariance() const;
+
+  //! @returns normal of the plane with unit length
+  Vector getNormalInWorldFrame() const;
+
+  //! @returns point on the plane below the origin of the world frame
+  Position getPositionInWorldFrame() const;
+
+  //! @returns the number of points in the window
+  int getNumberOfPoints() const;
+
+  /*! @param index  index of the point in the window, 0 is the oldest point
+   *  @returns point of the window
+   */
+  const Eigen::Vector3d& getPoint(int index) const;
+
+  int getWindowSize() const;
+  double getForgettingFactor() const;
+
+ protected:
+  //! Recomputes the weighted sums from the window to remove the round-off of the recursive updates
+  void recomputeSums();
+
+ protected:
+  int windowSize_;
+  double forgettingFactor_;
+  double slopePriorWeight_;
+
+  //! Ring buffer with the points of the window
+  std::vector<Eigen::Vector3d> points_;
+  int indexOfOldestPoint_;
+  int numberOfPoints_;
+  //! Number of updates since the sums were recomputed
+  int numberOfRecursiveUpdates_;
+
+  //! Weighted sums
+  Eigen::Matrix3d informationMatrix_;
+  Eigen::Vector3d informationVector_;
+  double sumOfWeightedSquaredHeights_;
+  double sumOfWeights_;
+
+  Eigen::Vector3d parameters_;
+  Eigen::Matrix3d covariance_;
+  double residualVariance_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_PLANEESTIMATOR_HPP_ */
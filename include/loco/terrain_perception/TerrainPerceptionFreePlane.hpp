@@ -43,11 +43,12 @@
 #define LOCO_TERRAINPERCEPTIONFREEPLANE_HPP_
 
 #include "loco/terrain_perception/TerrainPerceptionBase.hpp"
+#include "loco/terrain_perception/PlaneEstimator.hpp"
 #include "loco/common/TerrainModelFreePlane.hpp"
 #include "loco/common/LegGroup.hpp"
 #include "loco/common/TorsoStarlETH.hpp"
 
-#include "robotUtils/filters/FirstOrderFilter.hpp"
+#include "loco/temp_helpers/FilterBank.hpp"
 
 namespace loco {
 
@@ -101,6 +102,16 @@ namespace loco {
     void updateControlFrameOrigin();
     void updateControlFrameAttitude();
 
+    /*! Set the parameters of the plane estimation.
+     * @param windowSize Number of most recent footholds used for the fit
+     * @param forgettingFactor Weight factor in (0, 1] applied to the older footholds at each new foothold
+     */
+    void setPlaneEstimatorParameters(int windowSize, double forgettingFactor);
+
+    /*! Get the plane estimator, which provides the covariance of the plane parameters.
+     */
+    const PlaneEstimator& getPlaneEstimator() const;
+
     std::vector<double> planeParameters_;
 
    protected:
@@ -111,15 +122,13 @@ namespace loco {
      std::vector<loco::Position> lastWorldToBasePositionInWorldFrameForFoot_;
      std::vector<RotationQuaternion> lastWorldToBaseOrientationForFoot_;
      std::vector<bool> gotFirstTouchDownOfFoot_;
+     //! True if the foothold of the current stance phase has been added to the plane estimator
+     std::vector<bool> isFootholdAddedOfFoot_;
+     PlaneEstimator planeEstimator_;
      TerrainPerceptionFreePlane::EstimatePlaneInFrame estimatePlaneInFrame_;
 
-     //--- First order filters
-     robotUtils::FirstOrderFilter filterNormalX_;
-     robotUtils::FirstOrderFilter filterNormalY_;
-     robotUtils::FirstOrderFilter filterNormalZ_;
-     robotUtils::FirstOrderFilter filterPositionX_;
-     robotUtils::FirstOrderFilter filterPositionY_;
-     robotUtils::FirstOrderFilter filterPositionZ_;
+     //--- First order filters [normal x y z; position x y z]
+     FilterBank<6> filterBank_;
 
      double filterNormalTimeConstant_;
      double filterPositionTimeConstant_;
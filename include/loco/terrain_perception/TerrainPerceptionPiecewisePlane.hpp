@@ -0,0 +1,141 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainPerceptionPiecewisePlane.hpp
+ */
+
+#ifndef LOCO_TERRAINPERCEPTIONPIECEWISEPLANE_HPP_
+#define LOCO_TERRAINPERCEPTIONPIECEWISEPLANE_HPP_
+
+#include "loco/terrain_perception/TerrainPerceptionBase.hpp"
+#include "loco/terrain_perception/PlaneEstimator.hpp"
+#include "loco/common/TorsoBase.hpp"
+#include "loco/common/TerrainModelPiecewisePlane.hpp"
+#include "loco/common/LegGroup.hpp"
+#include "loco/common/RegionHashTable.hpp"
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace loco {
+
+//! Estimates local planes from the foothold history, e.g. for stairs and ramps with edges
+/*! The footholds are hashed into the regions of the terrain model. Each region keeps the last footholds
+ *  that belong to its plane. A foothold that is an inlier of the plane of its region is added with an O(1)
+ *  recursive least squares update. Otherwise the region is segmented again with a RANSAC over its footholds
+ *  and the new one, where every hypothesis passes through the new foothold and the footholds that do not
+ *  belong to the winning plane are dropped. Both the number of footholds per region and the number of
+ *  iterations are bounded, hence the cost per touchdown is bounded. The regions and the buffers of the
+ *  segmentation are allocated by setParameters(), adding a foothold does not allocate memory.
+ */
+class TerrainPerceptionPiecewisePlane: public TerrainPerceptionBase {
+ public:
+  TerrainPerceptionPiecewisePlane(TerrainModelPiecewisePlane* terrainModel, LegGroup* legs, TorsoBase* torso);
+  virtual ~TerrainPerceptionPiecewisePlane();
+
+  virtual bool initialize(double dt);
+
+  /*! Advance in time. Adds the foothold of each leg once per stance phase.
+   * @param dt  time step [s]
+   */
+  virtual bool advance(double dt);
+
+  virtual void updateControlFrameOrigin();
+  virtual void updateControlFrameAttitude();
+
+  /*! Adds a foothold and updates the plane of its region.
+   * @param positionWorldToFootholdInWorldFrame  measured foothold
+   */
+  void addFoothold(const Position& positionWorldToFootholdInWorldFrame);
+
+  /*! Set the parameters of the segmentation and allocates the regions. The history is cleared.
+   * @param maximumNumberOfFootholdsPerRegion   size of the foothold window of a region
+   * @param inlierThreshold                     maximal height difference of a foothold to a plane [m]
+   * @param numberOfRansacIterations            number of plane hypotheses per segmentation
+   * @param maximumNumberOfRegions              regions that are farthest from the new foothold are dropped beyond this number
+   */
+  void setParameters(int maximumNumberOfFootholdsPerRegion, double inlierThreshold, int numberOfRansacIterations, int maximumNumberOfRegions);
+
+  int getNumberOfRegions() const;
+
+ protected:
+  struct Region {
+    Region(int windowSize, double slopePriorWeight);
+    long i_;
+    long j_;
+    //! Footholds of the plane of the region and their least squares fit
+    PlaneEstimator estimator_;
+    bool hasPlane_;
+  };
+
+  /*! Finds the plane through the new foothold with the most inliers among the footholds of the region
+   * and keeps only its inliers.
+   */
+  void segmentRegion(Region& region, const Eigen::Vector3d& foothold);
+
+  //! Removes the region that is farthest from a position
+  void removeFarthestRegion(const Position& positionInWorldFrame);
+
+ protected:
+  TerrainModelPiecewisePlane* terrainModel_;
+  LegGroup* legs_;
+  TorsoBase* torso_;
+
+  //! Slot of each region in the pool
+  RegionHashTable regionSlots_;
+  std::vector<Region> regions_;
+  std::vector<bool> isFootholdAddedOfFoot_;
+
+  int maximumNumberOfFootholdsPerRegion_;
+  double inlierThreshold_;
+  int numberOfRansacIterations_;
+  int maximumNumberOfRegions_;
+  //! Minimal z-component of the normal of a plane hypothesis
+  double minimalNormalZ_;
+  //! Pulls planes with few or collinear footholds towards horizontal
+  double slopePriorWeight_;
+
+  std::minstd_rand randomNumberGenerator_;
+  //! Buffers of the segmentation
+  std::vector<Eigen::Vector3d> footholds_;
+  std::vector<bool> isInlier_;
+  std::vector<bool> isBestInlier_;
+};
+
+} /* namespace loco */
+
+#endif /* LOCO_TERRAINPERCEPTIONPIECEWISEPLANE_HPP_ */
@@ -45,6 +45,7 @@
 #define LOCO_TORSOCONTROLBASE_HPP_
 
 #include "tinyxml.h"
+#include "loco/common/ParameterVector.hpp"
 #include "robotUtils/function_approximators/polyharmonicSplines/PeriodicRBF1DC1.hpp"
 #include "loco/common/TypeDefs.hpp"
 #include "kindr/rotations/RotationEigen.hpp"
@@ -70,6 +71,13 @@ class TorsoControlBase {
    */
   virtual bool setToInterpolated(const TorsoControlBase& torsoController1, const TorsoControlBase& torsoController2, double t) = 0;
 
+  /*! Adds the continuous parameters to the parameter vector of the locomotion controller,
+   * which interpolates them during gait transitions. setToInterpolated only needs to handle the remaining parameters.
+   * @param parameterVector   parameter vector
+   * @returns true if successful
+   */
+  virtual bool addParametersToVector(ParameterVector* parameterVector);
+
   /*! Set a position offset to the CoM in world frame (used by the mission controller to move the robot while standing)
    * @param[in] positionOffsetInWorldFrame The position offset
    */
@@ -43,7 +43,7 @@
 #define LOCO_TORSOCONTROLDYNAMICGAITFREEPLANE_HPP_
 
 #include "loco/torso_control/TorsoControlGaitContainer.hpp"
-#include "robotUtils/filters/FirstOrderFilter.hpp"
+#include "loco/temp_helpers/FilterBank.hpp"
 
 namespace loco {
 
@@ -61,6 +61,7 @@ class TorsoControlDynamicGaitFreePlane: public TorsoControlGaitContainer {
     virtual bool loadParameters(const TiXmlHandle& handle);
 
     virtual bool setToInterpolated(const TorsoControlBase& torsoController1, const TorsoControlBase& torsoController2, double t);
+    virtual bool addParametersToVector(ParameterVector* parameterVector);
 
 
   protected:
@@ -74,7 +75,7 @@ class TorsoControlDynamicGaitFreePlane: public TorsoControlGaitContainer {
 
     //--- Height offset parameters
     //double maxHeightOffset_;
-    robotUtils:: FirstOrderFilter* firstOrderFilter_;
+    FilterBank<1> firstOrderFilter_;
     //---
 
     template <typename T> int sgn(T val);
@@ -49,11 +49,16 @@
 #include "loco/common/TorsoBase.hpp"
 #include "loco/common/TerrainModelBase.hpp"
 
+#include "loco/temp_helpers/BlendedTrajectory.hpp"
+
 namespace loco {
 
 class TorsoControlGaitContainer : public TorsoControlBase {
 
  public:
+  //! height trajectory that is shared with the parameter sets it is interpolated from
+  typedef BlendedTrajectory<rbf::PeriodicRBF1DC1> HeightTrajectory;
+
   TorsoControlGaitContainer(LegGroup* legs, TorsoBase* torso, loco::TerrainModelBase* terrain);
   virtual ~TorsoControlGaitContainer();
 
@@ -87,6 +92,16 @@ class TorsoControlGaitContainer : public TorsoControlBase {
   virtual void setDesiredOrientationOffset(const RotationQuaternion& orientationOffset);
 
   const CoMOverSupportPolygonControlBase& getCoMOverSupportPolygonControl() const;
+
+  const HeightTrajectory& getDesiredTorsoForeHeightTrajectory() const;
+  const HeightTrajectory& getDesiredTorsoHindHeightTrajectory() const;
+
+  /*! Blends the fore and hind height trajectories of two gaits without re-fitting.
+   * @returns true if successful
+   */
+  bool setHeightTrajectoriesToInterpolated(const HeightTrajectory& foreTrajectory1, const HeightTrajectory& hindTrajectory1,
+                                           const HeightTrajectory& foreTrajectory2, const HeightTrajectory& hindTrajectory2,
+                                           double t);
   CoMOverSupportPolygonControlBase* getCoMControl();
 
  protected:
@@ -99,8 +114,8 @@ class TorsoControlGaitContainer : public TorsoControlBase {
   double desiredTorsoForeHeightAboveGroundInWorldFrameOffset_;
   double desiredTorsoHindHeightAboveGroundInWorldFrameOffset_;
   double desiredTorsoCoMHeightAboveGroundInControlFrameOffset_;
-  rbf::PeriodicRBF1DC1 desiredTorsoForeHeightAboveGroundInWorldFrame_;
-  rbf::PeriodicRBF1DC1 desiredTorsoHindHeightAboveGroundInWorldFrame_;
+  HeightTrajectory desiredTorsoForeHeightAboveGroundInWorldFrame_;
+  HeightTrajectory desiredTorsoHindHeightAboveGroundInWorldFrame_;
   Position desiredPositionOffsetInWorldFrame_;
   RotationQuaternion desiredOrientationOffset_;
 
@@ -116,10 +131,14 @@ class TorsoControlGaitContainer : public TorsoControlBase {
    */
   virtual bool loadParametersHipConfiguration(const TiXmlHandle &hParameterSet);
 
-  virtual bool loadHeightTrajectory(const TiXmlHandle &hTrajectory, rbf::PeriodicRBF1DC1& trajectory);
-  virtual bool interpolateHeightTrajectory(rbf::PeriodicRBF1DC1& interpolatedTrajectory,
-                                           const rbf::PeriodicRBF1DC1& trajectory1,
-                                           const rbf::PeriodicRBF1DC1& trajectory2,
+  virtual bool loadHeightTrajectory(const TiXmlHandle &hTrajectory, HeightTrajectory& trajectory);
+
+  /*! Blends the two height trajectories without re-fitting, the knots are shared with trajectory1 and trajectory2.
+   * @returns true if successful
+   */
+  virtual bool interpolateHeightTrajectory(HeightTrajectory& interpolatedTrajectory,
+                                           const HeightTrajectory& trajectory1,
+                                           const HeightTrajectory& trajectory2,
                                            double t);
 
   RotationQuaternion getOrientationHeadingToDesiredHeadingBasedOnFeetLocations(const Position& positionWorldToDesiredHorizontalBaseInWorldFrame) const;
@@ -52,6 +52,7 @@
 #include "loco/locomotion_controller/LocomotionControllerBase.hpp"
 #include "loco/motion_control/VirtualModelController.hpp"
 #include "loco/contact_force_distribution/ContactForceDistribution.hpp"
+#include "loco/common/ConvexPolygon.hpp"
 
 #include "loco/foot_placement_strategy/FootPlacementStrategyInvertedPendulum.hpp"
 
@@ -135,6 +136,9 @@ class VisualizerSC: public VisualizerBase, public TaskVisualizer {
   loco::TrajectoryPosition predictedDefaultFootHoldTrajectories_[4];
   loco::TrajectoryPosition predictedFootHoldInvertedPendulumTrajectories_[4];
   loco::TrajectoryPosition baseTrajectory_;
+  //! buffers to sample the trajectories in batches
+  std::vector<double> sampleTimes_;
+  std::vector<Position> samplePositions_;
 };
 
 } /* namespace loco */
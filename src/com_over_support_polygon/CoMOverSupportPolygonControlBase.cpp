@@ -132,6 +132,17 @@ bool CoMOverSupportPolygonControlBase::saveParameters(TiXmlHandle &hParameterSet
 
 }
 
+bool CoMOverSupportPolygonControlBase::addParametersToVector(ParameterVector* parameterVector) {
+  std::vector<double*> parameters;
+  parameters.push_back(&minSwingLegWeight_);
+  parameters.push_back(&startShiftAwayFromLegAtStancePhase_);
+  parameters.push_back(&startShiftTowardsLegAtSwingPhase_);
+  parameters.push_back(&lateralOffset_);
+  parameters.push_back(&headingOffset_);
+  parameterVector->addSlice("CoMOverSupportPolygonControl", parameters);
+  return true;
+}
+
 double CoMOverSupportPolygonControlBase::getMinSwingLegWeight() const {
   return minSwingLegWeight_;
 }
@@ -109,6 +109,17 @@ void CoMOverSupportPolygonControlDynamicGait::advance(double dt) {
   positionWorldToDesiredCoMInWorldFrame_ = comTarget + Position(headingOffset_, lateralOffset_, 0.0);
   positionWorldToDesiredCoMInWorldFrame_.z() = 0.0;
 
+  ConvexPolygon::Points feet(2, nLegs);
+  int nGroundedLegs = 0;
+  for (auto leg : *legs_) {
+    if (leg->isGrounded()) {
+      const Position& positionWorldToFootInWorldFrame = leg->getPositionWorldToFootInWorldFrame();
+      feet.col(nGroundedLegs++) << positionWorldToFootInWorldFrame.x(), positionWorldToFootInWorldFrame.y();
+    }
+  }
+  feet.conservativeResize(2, nGroundedLegs);
+  supportPolygon_.setToConvexHull(feet);
+
 //  std::cout << "desired world to foot pos: " << positionWorldToHorizontalDesiredBaseInWorldFrame_ << std::endl;
 
 }
@@ -119,6 +130,17 @@ const Position& CoMOverSupportPolygonControlDynamicGait::getPositionWorldToDesir
 }
 
 
+const ConvexPolygon& CoMOverSupportPolygonControlDynamicGait::getSupportPolygon() const {
+  return supportPolygon_;
+}
+
+
+double CoMOverSupportPolygonControlDynamicGait::getStabilityMarginOfDesiredCoM() const {
+  return supportPolygon_.getSignedDistance(ConvexPolygon::Point(positionWorldToDesiredCoMInWorldFrame_.x(),
+                                                                positionWorldToDesiredCoMInWorldFrame_.y()));
+}
+
+
 bool CoMOverSupportPolygonControlDynamicGait::setToInterpolated(const CoMOverSupportPolygonControlBase& supportPolygon1,
                                                                 const CoMOverSupportPolygonControlBase& supportPolygon2, double t) {
 
@@ -41,7 +41,10 @@
 
 #include "loco/com_over_support_polygon/CoMOverSupportPolygonControlStaticGait.hpp"
 #include "loco/foot_placement_strategy/FootPlacementStrategyStaticGait.hpp"
-#include <Eigen/LU>
+#include "loco/common/ConvexPolygon.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 //#include <algorithm>
 
 //colored strings
@@ -73,10 +76,16 @@ CoMOverSupportPolygonControlStaticGait::CoMOverSupportPolygonControlStaticGait(L
     defaultDeltaBackward_(0.0),
     defaultFilterTimeConstant_(0.0),
     delta_(0.0),
-    filterCoMX_(nullptr),
-    filterCoMY_(nullptr),
     isInStandConfiguration_(true),
-    isSafeToResumeWalking_(false)
+    isSafeToResumeWalking_(false),
+    zmpPreviewController_(nullptr),
+    timeSinceZmpPreviewUpdate_(0.0),
+    zmpPreviewSamplingTime_(0.02),
+    zmpPreviewTime_(1.6),
+    zmpPreviewHeightOfCoM_(0.45),
+    zmpPreviewWeightZmpError_(1.0),
+    zmpPreviewWeightJerk_(1.0e-6),
+    defaultZmpPreviewController_(new ZmpPreviewController)
 {
 
 
@@ -94,15 +103,11 @@ CoMOverSupportPolygonControlStaticGait::CoMOverSupportPolygonControlStaticGait(L
   safeTriangleNext_.setZero();
   safeTriangleOverNext_.setZero();
 
-  filterCoMX_ = new robotUtils::FirstOrderFilter();
-  filterCoMY_ = new robotUtils::FirstOrderFilter();
-
 }
 
 
 CoMOverSupportPolygonControlStaticGait::~CoMOverSupportPolygonControlStaticGait() {
-  delete filterCoMX_;
-  delete filterCoMY_;
+  delete defaultZmpPreviewController_;
 }
 
 
@@ -113,8 +118,8 @@ bool CoMOverSupportPolygonControlStaticGait::initialize() {
 
   comTarget_.setZero();
 
-  filterCoMX_->initialize(filterInputCoMX_, defaultFilterTimeConstant_, 1.0);
-  filterCoMY_->initialize(filterInputCoMY_, defaultFilterTimeConstant_, 1.0);
+  filterCoM_.setFirstOrder(defaultFilterTimeConstant_, 1.0);
+  filterCoM_.initialize(FilterBank<2>::Array(filterInputCoMX_, filterInputCoMY_));
 
   delta_ = defaultDeltaForward_;
 
@@ -137,6 +142,16 @@ bool CoMOverSupportPolygonControlStaticGait::initialize() {
 
   updateSafeSupportTriangles();
 
+  if (zmpPreviewController_ != nullptr) {
+    // the gains are computed only once, the update is a matrix-vector product
+    if (!zmpPreviewController_->initialize(zmpPreviewSamplingTime_, zmpPreviewTime_, zmpPreviewHeightOfCoM_,
+                                           zmpPreviewWeightZmpError_, zmpPreviewWeightJerk_)) {
+      return false;
+    }
+    zmpPreviewController_->reset(feetConfigurationCurrent_.rowwise().mean());
+    timeSinceZmpPreviewUpdate_ = zmpPreviewSamplingTime_;
+  }
+
   return true;
 }
 
@@ -214,6 +229,40 @@ bool CoMOverSupportPolygonControlStaticGait::loadParametersStaticGait(TiXmlHandl
   }
   /**************/
 
+  /***************
+   * ZMP Preview *
+   ***************/
+  pElem = handle.FirstChild("ZmpPreview").Element();
+  if (pElem) {
+    if (pElem->QueryDoubleAttribute("samplingTime", &this->zmpPreviewSamplingTime_) != TIXML_SUCCESS) {
+      printf("Could not find ZmpPreview:samplingTime!\n");
+      return false;
+    }
+    if (pElem->QueryDoubleAttribute("previewTime", &this->zmpPreviewTime_) != TIXML_SUCCESS) {
+      printf("Could not find ZmpPreview:previewTime!\n");
+      return false;
+    }
+    if (pElem->QueryDoubleAttribute("heightOfCoM", &this->zmpPreviewHeightOfCoM_) != TIXML_SUCCESS) {
+      printf("Could not find ZmpPreview:heightOfCoM!\n");
+      return false;
+    }
+    if (pElem->QueryDoubleAttribute("weightZmpError", &this->zmpPreviewWeightZmpError_) != TIXML_SUCCESS) {
+      printf("Could not find ZmpPreview:weightZmpError!\n");
+      return false;
+    }
+    if (pElem->QueryDoubleAttribute("weightJerk", &this->zmpPreviewWeightJerk_) != TIXML_SUCCESS) {
+      printf("Could not find ZmpPreview:weightJerk!\n");
+      return false;
+    }
+    if (zmpPreviewController_ == nullptr) {
+      zmpPreviewController_ = defaultZmpPreviewController_;
+    }
+  }
+  else if (zmpPreviewController_ == defaultZmpPreviewController_) {
+    zmpPreviewController_ = nullptr;
+  }
+  /***************/
+
   return true;
 }
 
@@ -231,6 +280,11 @@ void CoMOverSupportPolygonControlStaticGait::setFootHold(int legId, Position foo
 }
 
 
+const Position& CoMOverSupportPolygonControlStaticGait::getFootHold(int legId) const {
+  return plannedFootHolds_[legId];
+}
+
+
 int CoMOverSupportPolygonControlStaticGait::getNextSwingLeg() { return swingLegIndexNext_; }
 int CoMOverSupportPolygonControlStaticGait::getBeforeLandingSwingLeg() { return swingLegIndexBeforeLanding_; }
 int CoMOverSupportPolygonControlStaticGait::getOverNextSwingLeg() { return swingLegIndexOverNext_; }
@@ -275,54 +329,33 @@ void CoMOverSupportPolygonControlStaticGait::updateSafeSupportTriangles() {
 
   feetConfigurationNext_ = getNextStanceConfig(feetConfigurationCurrent_, swingLegIndexNext_);
 
-  int j=0;
-
   // Get support triangles
-  j=0;
-  for (int k=0; k<legs_->size(); k++) {
-    if (k != swingLegIndexBeforeLanding_) {
-      supportTriangleCurrent_.col(j) = feetConfigurationCurrent_.col(k);
-      j++;
-    }
-  }
+  supportTriangleCurrent_ = getSupportTriangle(feetConfigurationCurrent_, swingLegIndexBeforeLanding_);
   safeTriangleCurrent_ = getSafeTriangle(supportTriangleCurrent_);
 
-  j=0;
-  for (int k=0; k<legs_->size(); k++) {
-    if (k != swingLegIndexNext_) {
-      supportTriangleNext_.col(j) = feetConfigurationCurrent_.col(k);
-      j++;
-    }
-  }
+  supportTriangleNext_ = getSupportTriangle(feetConfigurationCurrent_, swingLegIndexNext_);
   safeTriangleNext_ = getSafeTriangle(supportTriangleNext_);
 
-  j=0;
-  for (int k=0; k<legs_->size(); k++) {
-    if (k != swingLegIndexOverNext_) {
-      supportTriangleOverNext_.col(j) = feetConfigurationNext_.col(k);
-      j++;
-    }
-  }
+  supportTriangleOverNext_ = getSupportTriangle(feetConfigurationNext_, swingLegIndexOverNext_);
   safeTriangleOverNext_ = getSafeTriangle(supportTriangleOverNext_);
 
-  std::vector<int> diagonalSwingLegsLast(2), diagonalSwingLegsNext(2), diagonalSwingLegsOverNext(2);
-  diagonalSwingLegsLast = getDiagonalElements(swingLegIndexBeforeLanding_);
-  diagonalSwingLegsNext = getDiagonalElements(swingLegIndexNext_);
-  diagonalSwingLegsOverNext = getDiagonalElements(swingLegIndexOverNext_);
+  const Eigen::Vector2i diagonalSwingLegsLast = getDiagonalElements(swingLegIndexBeforeLanding_);
+  const Eigen::Vector2i diagonalSwingLegsNext = getDiagonalElements(swingLegIndexNext_);
+  const Eigen::Vector2i diagonalSwingLegsOverNext = getDiagonalElements(swingLegIndexOverNext_);
 
   Pos2d intersection;
   intersection.setZero();
 
   Line lineSafeLast, lineSafeNext, lineSafeOverNext;
 
-  lineSafeLast << safeTriangleCurrent_.col(diagonalSwingLegsLast[0]),
-                  safeTriangleCurrent_.col(diagonalSwingLegsLast[1]);
+  lineSafeLast << safeTriangleCurrent_.col(diagonalSwingLegsLast(0)),
+                  safeTriangleCurrent_.col(diagonalSwingLegsLast(1));
 
-  lineSafeNext << safeTriangleNext_.col(diagonalSwingLegsNext[0]),
-                  safeTriangleNext_.col(diagonalSwingLegsNext[1]);
+  lineSafeNext << safeTriangleNext_.col(diagonalSwingLegsNext(0)),
+                  safeTriangleNext_.col(diagonalSwingLegsNext(1));
 
-  lineSafeOverNext << safeTriangleOverNext_.col(diagonalSwingLegsOverNext[0]),
-                      safeTriangleOverNext_.col(diagonalSwingLegsOverNext[1]);
+  lineSafeOverNext << safeTriangleOverNext_.col(diagonalSwingLegsOverNext(0)),
+                      safeTriangleOverNext_.col(diagonalSwingLegsOverNext(1));
 
   if (lineIntersect(lineSafeLast, lineSafeNext, intersection)) {
     comTarget_ = intersection;
@@ -333,7 +366,7 @@ void CoMOverSupportPolygonControlStaticGait::updateSafeSupportTriangles() {
     makeShift_ = true;
   }
   else {
-    comTarget_ = (safeTriangleNext_.col(0)+safeTriangleNext_.col(1)+safeTriangleNext_.col(2))/3.0;
+    comTarget_ = safeTriangleNext_.rowwise().mean();
     makeShift_ = true;
   }
 
@@ -382,8 +415,9 @@ void CoMOverSupportPolygonControlStaticGait::advance(double dt) {
      ****************************/
     filterInputCoMX_ = comTarget_.x();
     filterInputCoMY_ = comTarget_.y();
-    filterOutputCoMX_ = filterCoMX_->advance(dt,filterInputCoMX_);
-    filterOutputCoMY_ = filterCoMY_->advance(dt,filterInputCoMY_);
+    const FilterBank<2>::Array& filterOutputCoM = filterCoM_.advance(dt, FilterBank<2>::Array(filterInputCoMX_, filterInputCoMY_));
+    filterOutputCoMX_ = filterOutputCoM(0);
+    filterOutputCoMY_ = filterOutputCoM(1);
 
     if (isInStandConfiguration_) {
       isSafeToResumeWalking_ = false;
@@ -400,6 +434,18 @@ void CoMOverSupportPolygonControlStaticGait::advance(double dt) {
                                                           centerOfCurrentStanceConfig(1),
                                                           0.0);
       }
+
+      if (zmpPreviewController_ != nullptr) {
+        zmpPreviewController_->reset(Pos2d(positionWorldToDesiredCoMInWorldFrame_.x(), positionWorldToDesiredCoMInWorldFrame_.y()));
+        timeSinceZmpPreviewUpdate_ = zmpPreviewController_->getSamplingTime();
+      }
+    }
+    else if (zmpPreviewController_ != nullptr && zmpPreviewController_->isInitialized()) {
+      // the CoM shifts towards the next support triangle while the legs swing
+      advanceZmpPreview(dt);
+      const Pos2d positionCoM = zmpPreviewController_->getPositionCoM();
+      positionWorldToDesiredCoMInWorldFrame_ = Position(positionCoM.x(), positionCoM.y(), 0.0);
+      isSafeToResumeWalking_ = true;
     }
     else {
       if (makeShift_) {
@@ -413,6 +459,140 @@ void CoMOverSupportPolygonControlStaticGait::advance(double dt) {
 
 
 
+void CoMOverSupportPolygonControlStaticGait::setZmpPreviewController(ZmpPreviewController* zmpPreviewController) {
+  zmpPreviewController_ = zmpPreviewController;
+}
+
+
+ZmpPreviewController* CoMOverSupportPolygonControlStaticGait::getZmpPreviewController() {
+  return zmpPreviewController_;
+}
+
+
+void CoMOverSupportPolygonControlStaticGait::advanceZmpPreview(double dt) {
+  if (timeSinceZmpPreviewUpdate_ >= zmpPreviewController_->getSamplingTime()-0.5*dt) {
+    updateLegPreviews();
+    const int nSamples = zmpPreviewController_->getNumberOfPreviewSamples();
+    const double samplingTime = zmpPreviewController_->getSamplingTime();
+    zmpReference_.resize(nSamples+1, 2);
+    for (int j=0; j<=nSamples; j++) {
+      zmpReference_.row(j) = getZmpReferenceInPreview(j*samplingTime).transpose();
+    }
+    zmpPreviewController_->update(zmpReference_);
+    timeSinceZmpPreviewUpdate_ = 0.0;
+  }
+  zmpPreviewController_->integrate(dt);
+  timeSinceZmpPreviewUpdate_ += dt;
+}
+
+
+void CoMOverSupportPolygonControlStaticGait::updateLegPreviews() {
+  RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+  LinearVelocity desiredLinearVelocityInWorldFrame = orientationWorldToControl.inverseRotate(torso_->getDesiredState().getLinearVelocityBaseInControlFrame());
+  const Pos2d desiredLinearVelocity(desiredLinearVelocityInWorldFrame.x(), desiredLinearVelocityInWorldFrame.y());
+
+  for (auto leg: *legs_) {
+    LegPreview& legPreview = legPreviews_[leg->getId()];
+    const Position& positionWorldToFootInWorldFrame = leg->getPositionWorldToFootInWorldFrame();
+    legPreview.positionFoot_ << positionWorldToFootInWorldFrame.x(), positionWorldToFootInWorldFrame.y();
+    legPreview.swingDuration_ = leg->getSwingDuration();
+    legPreview.strideDuration_ = leg->getStanceDuration() + leg->getSwingDuration();
+    legPreview.step_ = desiredLinearVelocity*legPreview.strideDuration_;
+
+    if (legPreview.strideDuration_ <= 0.0) {
+      legPreview.timeOfLiftOff_ = std::numeric_limits<double>::infinity();
+      legPreview.positionFirstFootHold_ = legPreview.positionFoot_;
+    }
+    else if (leg->getSwingPhase() != -1) {
+      legPreview.timeOfLiftOff_ = -leg->getSwingPhase()*leg->getSwingDuration();
+      legPreview.positionFirstFootHold_ << plannedFootHolds_[leg->getId()].x(), plannedFootHolds_[leg->getId()].y();
+    }
+    else if (leg->getStancePhase() != -1) {
+      legPreview.timeOfLiftOff_ = (1.0-leg->getStancePhase())*leg->getStanceDuration();
+      legPreview.positionFirstFootHold_ = legPreview.positionFoot_ + legPreview.step_;
+    }
+    else {
+      legPreview.timeOfLiftOff_ = std::numeric_limits<double>::infinity();
+      legPreview.positionFirstFootHold_ = legPreview.positionFoot_;
+    }
+  }
+}
+
+
+bool CoMOverSupportPolygonControlStaticGait::isSwingingInPreview(int legId, double time) const {
+  const LegPreview& legPreview = legPreviews_[legId];
+  if (time < legPreview.timeOfLiftOff_) {
+    return false;
+  }
+  const double timeSinceLiftOff = std::fmod(time-legPreview.timeOfLiftOff_, legPreview.strideDuration_);
+  return (timeSinceLiftOff < legPreview.swingDuration_);
+}
+
+
+double CoMOverSupportPolygonControlStaticGait::getTimeOfNextLiftOffInPreview(int legId, double time) const {
+  const LegPreview& legPreview = legPreviews_[legId];
+  if (time < legPreview.timeOfLiftOff_) {
+    return legPreview.timeOfLiftOff_;
+  }
+  return legPreview.timeOfLiftOff_ + (std::floor((time-legPreview.timeOfLiftOff_)/legPreview.strideDuration_)+1.0)*legPreview.strideDuration_;
+}
+
+
+CoMOverSupportPolygonControlStaticGait::Pos2d CoMOverSupportPolygonControlStaticGait::getPositionFootInPreview(int legId, double time) const {
+  const LegPreview& legPreview = legPreviews_[legId];
+  const double timeOfTouchDown = legPreview.timeOfLiftOff_ + legPreview.swingDuration_;
+  if (time < timeOfTouchDown) {
+    return legPreview.positionFoot_;
+  }
+  const double numberOfTouchDowns = std::floor((time-timeOfTouchDown)/legPreview.strideDuration_) + 1.0;
+  return legPreview.positionFirstFootHold_ + (numberOfTouchDowns-1.0)*legPreview.step_;
+}
+
+
+CoMOverSupportPolygonControlStaticGait::Pos2d CoMOverSupportPolygonControlStaticGait::getZmpReferenceInPreview(double time) const {
+  const int nLegs = legs_->size();
+
+  // in the four-leg support phase the ZMP is shifted to the next support triangle
+  bool isAnyLegSwinging = false;
+  for (int k=0; k<nLegs; k++) {
+    isAnyLegSwinging = isAnyLegSwinging || isSwingingInPreview(k, time);
+  }
+  if (!isAnyLegSwinging) {
+    double timeOfNextLiftOff = std::numeric_limits<double>::infinity();
+    for (int k=0; k<nLegs; k++) {
+      timeOfNextLiftOff = std::min(timeOfNextLiftOff, getTimeOfNextLiftOffInPreview(k, time));
+    }
+    if (timeOfNextLiftOff < std::numeric_limits<double>::infinity()) {
+      time = timeOfNextLiftOff + 1.0e-6;
+    }
+  }
+
+  FeetConfiguration feetConfiguration;
+  int swingLeg = -1;
+  int nSupportLegs = 0;
+  Pos2d centerOfSupportFeet = Pos2d::Zero();
+  for (int k=0; k<nLegs; k++) {
+    feetConfiguration.col(k) = getPositionFootInPreview(k, time);
+    if (isSwingingInPreview(k, time)) {
+      swingLeg = k;
+    }
+    else {
+      centerOfSupportFeet += feetConfiguration.col(k);
+      nSupportLegs++;
+    }
+  }
+
+  if (nSupportLegs == 3) {
+    SupportTriangle supportTriangle = getSupportTriangle(feetConfiguration, swingLeg);
+    return getSafeTriangle(supportTriangle).rowwise().mean();
+  }
+  if (nSupportLegs == 0) {
+    return feetConfiguration.rowwise().mean();
+  }
+  return centerOfSupportFeet/nSupportLegs;
+}
+
+
 bool CoMOverSupportPolygonControlStaticGait::getSwingFootChanged() {
   return swingFootChanged_;
 }
@@ -461,36 +641,16 @@ Eigen::Matrix<double,2,4> CoMOverSupportPolygonControlStaticGait::getNextStanceC
 
 
 bool CoMOverSupportPolygonControlStaticGait::lineIntersect(const Line& l1, const Line& l2, Pos2d& intersection) {
-  Pos2d l1_1 = l1.col(0);
-  Pos2d l1_2 = l1.col(1);
-
-  Pos2d l2_1 = l2.col(0);
-  Pos2d l2_2 = l2.col(1);
-
-  // Check if line length is zero
-  if ( (l1_1-l1_2).isZero() || (l2_1-l2_2).isZero() ) {
+  double s = 0.0;
+  double t = 0.0;
+  if (!ConvexPolygon::intersectLines(l1.col(0), l1.col(1), l2.col(0), l2.col(1), s, t)) {
     return false;
   }
 
-  Pos2d v1 = l1_2-l1_1;
-  v1 = v1/v1.norm();
-
-  Pos2d v2 = l2_2-l2_1;
-  v2 = v2/v2.norm();
-
-  // Check if v1 and v2 are parallel (matrix would not be invertible)
-  Eigen::Matrix2d A;
-  Pos2d x;
-  x(0) = -1; x(1) = -1;
-  A << -v1, v2;
-  Eigen::FullPivLU<Eigen::Matrix2d> Apiv(A);
-  if (Apiv.rank() == 2) {
-    x = A.lu().solve(l1_1-l2_1);
-  }
-
-  if (x(0)>=0.0 && x(0)<=1.0) {
-    intersection << l1_1(0) + x(0)*v1(0),
-                    l1_1(1) + x(0)*v1(1);
+  // the intersection has to lie within unit distance from the start of l1 in direction of l1
+  const double distance = s*(l1.col(1)-l1.col(0)).norm();
+  if (distance>=0.0 && distance<=1.0) {
+    intersection = l1.col(0) + s*(l1.col(1)-l1.col(0));
     return true;
   } else {
     return false;
@@ -498,35 +658,28 @@ bool CoMOverSupportPolygonControlStaticGait::lineIntersect(const Line& l1, const
 }
 
 
-Eigen::Matrix<double,2,3> CoMOverSupportPolygonControlStaticGait::getSafeTriangle(const Eigen::Matrix<double,2,3>& supportTriangle) {
-  Eigen::Matrix<double,2,3> safeTriangle;
-  safeTriangle.setZero();
-
-  Pos2d v1, v2;
-
-  for (int k=0; k<3; k++) {
-    int vertex1, vertex2;
-    if (k==0) {
-      vertex1 = 1;
-      vertex2 = 2;
-    } else if (k==1) {
-      vertex1 = 2;
-      vertex2 = 0;
-    } else if (k==2) {
-      vertex1 = 0;
-      vertex2 = 1;
+CoMOverSupportPolygonControlStaticGait::SupportTriangle CoMOverSupportPolygonControlStaticGait::getSupportTriangle(const FeetConfiguration& feetConfiguration, int swingLeg) const {
+  SupportTriangle supportTriangle;
+  int j = 0;
+  for (int k=0; k<feetConfiguration.cols() && j<supportTriangle.cols(); k++) {
+    if (k != swingLeg) {
+      supportTriangle.col(j++) = feetConfiguration.col(k);
     }
+  }
+  return supportTriangle;
+}
 
-    v1 = supportTriangle.col(vertex1) - supportTriangle.col(k);
-    v1 = v1/v1.norm();
-    v2 = supportTriangle.col(vertex2) - supportTriangle.col(k);
-    v2 = v2/v2.norm();
 
-    double phiv1v2 = acos(v1.dot(v2));
-    safeTriangle.col(k) = supportTriangle.col(k)+delta_/sin(phiv1v2)*(v1+v2);
+Eigen::Matrix<double,2,3> CoMOverSupportPolygonControlStaticGait::getSafeTriangle(const Eigen::Matrix<double,2,3>& supportTriangle) const {
+  /* shift the edges by delta towards the inside, the vertices keep the order of the support triangle */
+  ConvexPolygon supportPolygon;
+  ConvexPolygon safePolygon;
+  supportPolygon.setVertices(supportTriangle);
+  supportPolygon.getInwardOffset(delta_, safePolygon);
+  if (safePolygon.getNumberOfVertices() != 3) {
+    return supportTriangle;
   }
-
-  return safeTriangle;
+  return safePolygon.getVertices();
 }
 
 
@@ -578,8 +731,8 @@ int CoMOverSupportPolygonControlStaticGait::getNextSwingFoot(const int currentSw
 }
 
 
-std::vector<int> CoMOverSupportPolygonControlStaticGait::getDiagonalElements(int swingLeg) {
-  std::vector<int> diagonalSwingLegs(2);
+Eigen::Vector2i CoMOverSupportPolygonControlStaticGait::getDiagonalElements(int swingLeg) {
+  Eigen::Vector2i diagonalSwingLegs = Eigen::Vector2i::Zero();
 
 //  switch(swingLeg) {
 //    case(0):
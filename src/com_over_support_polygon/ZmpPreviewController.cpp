@@ -0,0 +1,210 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ZmpPreviewController.cpp
+* @brief
+*/
+
+#include "loco/com_over_support_polygon/ZmpPreviewController.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace loco {
+
+ZmpPreviewController::ZmpPreviewController() :
+    isInitialized_(false),
+    samplingTime_(0.0),
+    heightOfCoM_(0.0),
+    gravity_(9.81),
+    numberOfPreviewSamples_(0),
+    gainIntegral_(0.0)
+{
+  A_.setIdentity();
+  B_.setZero();
+  C_.setZero();
+  gainState_.setZero();
+  gainsPreview_.resize(1, 0);
+  reset(Eigen::Vector2d::Zero());
+}
+
+
+ZmpPreviewController::~ZmpPreviewController() {
+
+}
+
+
+bool ZmpPreviewController::initialize(double samplingTime, double previewTime, double heightOfCoM,
+                                      double weightZmpError, double weightJerk, double gravity) {
+  isInitialized_ = false;
+  if (samplingTime <= 0.0 || heightOfCoM <= 0.0 || weightZmpError <= 0.0 || weightJerk <= 0.0 || gravity <= 0.0) {
+    printf("[ZmpPreviewController] invalid parameters!\n");
+    return false;
+  }
+  const int numberOfPreviewSamples = (int)std::floor(previewTime/samplingTime + 0.5);
+  if (numberOfPreviewSamples < 1 || numberOfPreviewSamples > maxNumberOfPreviewSamples) {
+    printf("[ZmpPreviewController] The preview horizon has %d samples, allowed are 1 to %d!\n", numberOfPreviewSamples, maxNumberOfPreviewSamples);
+    return false;
+  }
+
+  samplingTime_ = samplingTime;
+  heightOfCoM_ = heightOfCoM;
+  gravity_ = gravity;
+  numberOfPreviewSamples_ = numberOfPreviewSamples;
+
+  const double T = samplingTime;
+  A_ << 1.0, T, T*T/2.0,
+        0.0, 1.0, T,
+        0.0, 0.0, 1.0;
+  B_ << T*T*T/6.0, T*T/2.0, T;
+  C_ << 1.0, 0.0, -heightOfCoM/gravity;
+
+  /* system augmented with the ZMP error: [e(k); dx(k)] */
+  Eigen::Matrix4d At = Eigen::Matrix4d::Zero();
+  At(0,0) = 1.0;
+  At.block<1,3>(0,1) = C_*A_;
+  At.block<3,3>(1,1) = A_;
+  Eigen::Vector4d Bt;
+  Bt(0) = C_*B_;
+  Bt.tail<3>() = B_;
+  Eigen::Matrix4d Q = Eigen::Matrix4d::Zero();
+  Q(0,0) = weightZmpError;
+  const double R = weightJerk;
+
+  /* discrete algebraic Riccati equation by fixed point iteration */
+  Eigen::Matrix4d P = Q;
+  bool isConverged = false;
+  for (int iter=0; iter<100000; iter++) {
+    const Eigen::Vector4d PB = P*Bt;
+    const Eigen::RowVector4d BPA = PB.transpose()*At;
+    const Eigen::Matrix4d PNew = At.transpose()*P*At - BPA.transpose()*BPA/(R + Bt.dot(PB)) + Q;
+    const double change = (PNew-P).norm();
+    P = PNew;
+    if (change <= 1.0e-10*P.norm()) {
+      isConverged = true;
+      break;
+    }
+  }
+  if (!isConverged) {
+    printf("[ZmpPreviewController] The Riccati equation did not converge!\n");
+    return false;
+  }
+
+  const double S = R + Bt.dot(P*Bt);
+  const Eigen::RowVector4d K = Bt.transpose()*P*At/S;
+  gainIntegral_ = K(0);
+  gainState_ = K.tail<3>();
+
+  /* gains of the previewed reference */
+  const Eigen::Matrix4d Ac = At - Bt*K;
+  gainsPreview_.resize(1, numberOfPreviewSamples_);
+  gainsPreview_(0) = -gainIntegral_;
+  Eigen::Vector4d X = -Ac.transpose()*P.col(0);
+  for (int j=1; j<numberOfPreviewSamples_; j++) {
+    gainsPreview_(j) = Bt.dot(X)/S;
+    X = Ac.transpose()*X;
+  }
+
+  isInitialized_ = true;
+  return true;
+}
+
+
+bool ZmpPreviewController::isInitialized() const {
+  return isInitialized_;
+}
+
+
+double ZmpPreviewController::getSamplingTime() const {
+  return samplingTime_;
+}
+
+
+int ZmpPreviewController::getNumberOfPreviewSamples() const {
+  return numberOfPreviewSamples_;
+}
+
+
+void ZmpPreviewController::reset(const Eigen::Vector2d& positionCoM) {
+  state_.setZero();
+  state_.row(0) = positionCoM.transpose();
+  integralOfZmpError_.setZero();
+  jerk_.setZero();
+}
+
+
+bool ZmpPreviewController::update(const ZmpReference& zmpReference) {
+  if (!isInitialized_ || zmpReference.rows() != numberOfPreviewSamples_+1) {
+    jerk_.setZero();
+    return false;
+  }
+  integralOfZmpError_ += C_*state_ - zmpReference.row(0);
+  jerk_ = -gainIntegral_*integralOfZmpError_ - gainState_*state_ - gainsPreview_*zmpReference.bottomRows(numberOfPreviewSamples_);
+  return true;
+}
+
+
+void ZmpPreviewController::integrate(double dt) {
+  state_.row(0) += dt*state_.row(1) + dt*dt/2.0*state_.row(2) + dt*dt*dt/6.0*jerk_;
+  state_.row(1) += dt*state_.row(2) + dt*dt/2.0*jerk_;
+  state_.row(2) += dt*jerk_;
+}
+
+
+Eigen::Vector2d ZmpPreviewController::getPositionCoM() const {
+  return state_.row(0).transpose();
+}
+
+
+Eigen::Vector2d ZmpPreviewController::getVelocityCoM() const {
+  return state_.row(1).transpose();
+}
+
+
+Eigen::Vector2d ZmpPreviewController::getAccelerationCoM() const {
+  return state_.row(2).transpose();
+}
+
+
+Eigen::Vector2d ZmpPreviewController::getZmp() const {
+  return (C_*state_).transpose();
+}
+
+
+const Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, ZmpPreviewController::maxNumberOfPreviewSamples>& ZmpPreviewController::getPreviewGains() const {
+  return gainsPreview_;
+}
+
+} /* namespace loco */
@@ -0,0 +1,112 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * BackgroundJobQueue.cpp
+ */
+
+#include "loco/common/BackgroundJobQueue.hpp"
+
+namespace loco {
+
+BackgroundJobQueue::BackgroundJobQueue() :
+    jobs_(),
+    isRunningJob_(false),
+    isStopped_(false)
+{
+  // the worker is started last since it accesses the other members
+  worker_ = std::thread(&BackgroundJobQueue::run, this);
+}
+
+BackgroundJobQueue::~BackgroundJobQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.clear();
+    isStopped_ = true;
+  }
+  jobAddedCondition_.notify_all();
+  worker_.join();
+}
+
+void BackgroundJobQueue::addJob(const Job& job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(job);
+  }
+  jobAddedCondition_.notify_one();
+}
+
+void BackgroundJobQueue::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  jobs_.clear();
+  if (!isRunningJob_) {
+    jobsDoneCondition_.notify_all();
+  }
+}
+
+void BackgroundJobQueue::waitUntilDone() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  jobsDoneCondition_.wait(lock, [this]() { return jobs_.empty() && !isRunningJob_; });
+}
+
+bool BackgroundJobQueue::isBusy() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return isRunningJob_ || !jobs_.empty();
+}
+
+void BackgroundJobQueue::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    jobAddedCondition_.wait(lock, [this]() { return isStopped_ || !jobs_.empty(); });
+    if (isStopped_) {
+      return;
+    }
+
+    Job job = jobs_.front();
+    jobs_.pop_front();
+    isRunningJob_ = true;
+
+    // the job runs without holding the lock such that jobs can be added in the meantime
+    lock.unlock();
+    job();
+    lock.lock();
+
+    isRunningJob_ = false;
+    if (jobs_.empty()) {
+      jobsDoneCondition_.notify_all();
+    }
+  }
+}
+
+} /* namespace loco */
@@ -0,0 +1,305 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ConvexPolygon.cpp
+ */
+
+#include "loco/common/ConvexPolygon.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace loco {
+
+namespace {
+
+inline double cross(const ConvexPolygon::Point& a, const ConvexPolygon::Point& b) {
+  return a.x()*b.y() - a.y()*b.x();
+}
+
+} /* namespace */
+
+
+ConvexPolygon::ConvexPolygon() :
+    numberOfVertices_(0)
+{
+  clear();
+}
+
+
+ConvexPolygon::~ConvexPolygon() {
+
+}
+
+
+void ConvexPolygon::clear() {
+  numberOfVertices_ = 0;
+  vertices_.resize(2, 0);
+  edgeNormals_.resize(2, 0);
+  edgeOffsets_.resize(1, 0);
+}
+
+
+bool ConvexPolygon::setToConvexHull(const Points& points) {
+  const int nPoints = points.cols();
+  clear();
+  if (nPoints > maxNumberOfVertices) {
+    return false;
+  }
+
+  /* sort the points lexicographically by x and y */
+  int order[maxNumberOfVertices];
+  for (int k=0; k<nPoints; k++) {
+    order[k] = k;
+    for (int l=k; l>0; l--) {
+      const Point& a = points.col(order[l]);
+      const Point& b = points.col(order[l-1]);
+      if (a.x() < b.x() || (a.x() == b.x() && a.y() < b.y())) {
+        std::swap(order[l], order[l-1]);
+      }
+      else {
+        break;
+      }
+    }
+  }
+
+  if (nPoints < 3) {
+    vertices_.resize(2, nPoints);
+    for (int k=0; k<nPoints; k++) {
+      vertices_.col(k) = points.col(order[k]);
+      indicesOfVertices_[k] = order[k];
+    }
+    numberOfVertices_ = nPoints;
+    return false;
+  }
+
+  /* lower and upper hull, counter-clockwise */
+  int hull[2*maxNumberOfVertices];
+  int nHull = 0;
+  for (int k=0; k<nPoints; k++) {
+    while (nHull >= 2 && cross(points.col(hull[nHull-1])-points.col(hull[nHull-2]), points.col(order[k])-points.col(hull[nHull-2])) <= 0.0) {
+      nHull--;
+    }
+    hull[nHull++] = order[k];
+  }
+  for (int k=nPoints-2, lower=nHull+1; k>=0; k--) {
+    while (nHull >= lower && cross(points.col(hull[nHull-1])-points.col(hull[nHull-2]), points.col(order[k])-points.col(hull[nHull-2])) <= 0.0) {
+      nHull--;
+    }
+    hull[nHull++] = order[k];
+  }
+  nHull--;
+
+  vertices_.resize(2, nHull);
+  for (int k=0; k<nHull; k++) {
+    vertices_.col(k) = points.col(hull[k]);
+    indicesOfVertices_[k] = hull[k];
+  }
+  numberOfVertices_ = nHull;
+
+  if (nHull < 3) {
+    return false;
+  }
+  return updateEdges();
+}
+
+
+bool ConvexPolygon::setVertices(const Points& vertices) {
+  const int nVertices = vertices.cols();
+  if (nVertices > maxNumberOfVertices) {
+    clear();
+    return false;
+  }
+  vertices_ = vertices;
+  numberOfVertices_ = nVertices;
+  for (int k=0; k<nVertices; k++) {
+    indicesOfVertices_[k] = k;
+  }
+  if (nVertices < 3) {
+    edgeNormals_.resize(2, 0);
+    edgeOffsets_.resize(1, 0);
+    return false;
+  }
+  return updateEdges();
+}
+
+
+bool ConvexPolygon::updateEdges() {
+  const int n = numberOfVertices_;
+
+  Points next(2, n);
+  next.leftCols(n-1) = vertices_.rightCols(n-1);
+  next.col(n-1) = vertices_.col(0);
+  const Points edges = next - vertices_;
+  const EdgeValues lengths = edges.colwise().norm();
+
+  /* shoelace formula for the orientation */
+  const double twiceArea = (vertices_.row(0).cwiseProduct(next.row(1)) - vertices_.row(1).cwiseProduct(next.row(0))).sum();
+
+  edgeNormals_.resize(2, n);
+  edgeOffsets_.resize(1, n);
+  if (twiceArea == 0.0 || lengths.minCoeff() == 0.0) {
+    edgeNormals_.setZero();
+    edgeOffsets_.setZero();
+    return false;
+  }
+  const double orientation = (twiceArea > 0.0) ? 1.0 : -1.0;
+
+  edgeNormals_.row(0) = -orientation*edges.row(1).cwiseQuotient(lengths);
+  edgeNormals_.row(1) = orientation*edges.row(0).cwiseQuotient(lengths);
+  edgeOffsets_ = edgeNormals_.cwiseProduct(vertices_).colwise().sum();
+  return true;
+}
+
+
+bool ConvexPolygon::getInwardOffset(double margin, ConvexPolygon& offsetPolygon) const {
+  const int n = numberOfVertices_;
+  if (n < 3 || edgeNormals_.cols() != n) {
+    offsetPolygon = *this;
+    return false;
+  }
+
+  const EdgeValues offsets = edgeOffsets_.array() + margin;
+
+  /* vertex k is the intersection of the shifted edges k-1 and k */
+  Points vertices(2, n);
+  for (int k=0; k<n; k++) {
+    const int kPrevious = (k == 0) ? n-1 : k-1;
+    const Point& n1 = edgeNormals_.col(kPrevious);
+    const Point& n2 = edgeNormals_.col(k);
+    const double determinant = cross(n1, n2);
+    if (std::fabs(determinant) < 1.0e-12) {
+      // collinear edges
+      vertices.col(k) = vertices_.col(k) + margin*n2;
+    }
+    else {
+      vertices.col(k) << (offsets(kPrevious)*n2.y() - offsets(k)*n1.y())/determinant,
+                         (n1.x()*offsets(k) - n2.x()*offsets(kPrevious))/determinant;
+    }
+  }
+
+  const Points normals = edgeNormals_;
+  offsetPolygon.setVertices(vertices);
+  for (int k=0; k<n; k++) {
+    offsetPolygon.indicesOfVertices_[k] = indicesOfVertices_[k];
+  }
+
+  /* the edges turn around if the margin is too large */
+  if (offsetPolygon.edgeNormals_.cols() != n) {
+    return false;
+  }
+  return offsetPolygon.edgeNormals_.cwiseProduct(normals).colwise().sum().minCoeff() > 0.0;
+}
+
+
+void ConvexPolygon::getSignedDistancesToEdges(const Point& point, EdgeValues& distances) const {
+  distances = point.transpose()*edgeNormals_ - edgeOffsets_;
+}
+
+
+double ConvexPolygon::getSignedDistance(const Point& point) const {
+  if (numberOfVertices_ < 3 || edgeNormals_.cols() == 0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  EdgeValues distances;
+  getSignedDistancesToEdges(point, distances);
+  return distances.minCoeff();
+}
+
+
+bool ConvexPolygon::isInside(const Point& point, double tolerance) const {
+  return getSignedDistance(point) >= -tolerance;
+}
+
+
+ConvexPolygon::Point ConvexPolygon::getCentroid() const {
+  if (numberOfVertices_ == 0) {
+    return Point::Zero();
+  }
+  return vertices_.rowwise().mean();
+}
+
+
+int ConvexPolygon::getNumberOfVertices() const {
+  return numberOfVertices_;
+}
+
+
+const ConvexPolygon::Points& ConvexPolygon::getVertices() const {
+  return vertices_;
+}
+
+
+ConvexPolygon::Point ConvexPolygon::getVertex(int k) const {
+  return vertices_.col(k);
+}
+
+
+int ConvexPolygon::getIndexOfVertex(int k) const {
+  return indicesOfVertices_[k];
+}
+
+
+bool ConvexPolygon::intersectLines(const Point& a0, const Point& a1, const Point& b0, const Point& b1, double& s, double& t) {
+  const Point da = a1-a0;
+  const Point db = b1-b0;
+  if (da.isZero() || db.isZero()) {
+    return false;
+  }
+  const double denominator = cross(da, db);
+  if (std::fabs(denominator) <= 1.0e-12*da.norm()*db.norm()) {
+    return false;
+  }
+  const Point w = b0-a0;
+  s = cross(w, db)/denominator;
+  t = cross(w, da)/denominator;
+  return true;
+}
+
+
+bool ConvexPolygon::intersectSegments(const Point& a0, const Point& a1, const Point& b0, const Point& b1, Point& intersection) {
+  double s = 0.0;
+  double t = 0.0;
+  if (!intersectLines(a0, a1, b0, b1, s, t)) {
+    return false;
+  }
+  if (s < 0.0 || s > 1.0 || t < 0.0 || t > 1.0) {
+    return false;
+  }
+  intersection = a0 + s*(a1-a0);
+  return true;
+}
+
+} /* namespace loco */
@@ -68,6 +68,9 @@ LegBase::LegBase() :
   measuredJointVelocities_(),
   desiredJointTorques_(),
   measuredJointTorques_(),
+  positionWorldToDesiredFootInWorldFrame_(),
+  linearVelocityHipToDesiredFootInWorldFrame_(),
+  linearAccelerationHipToDesiredFootInWorldFrame_(),
   stateSwitcher_(nullptr),
   isInStandConfiguration_(false)
 {
@@ -99,6 +102,9 @@ LegBase::LegBase(const std::string& name, LegLinkGroup* links) :
   measuredJointVelocities_(),
   desiredJointTorques_(),
   measuredJointTorques_(),
+  positionWorldToDesiredFootInWorldFrame_(),
+  linearVelocityHipToDesiredFootInWorldFrame_(),
+  linearAccelerationHipToDesiredFootInWorldFrame_(),
   stateSwitcher_(nullptr),
   isInStandConfiguration_(false)
 {
@@ -364,6 +370,22 @@ void LegBase::setDesireWorldToFootPositionInWorldFrame(const Position& position)
   positionWorldToDesiredFootInWorldFrame_ = position;
 }
 
+const LinearVelocity& LegBase::getDesiredLinearVelocityHipToFootInWorldFrame() const {
+  return linearVelocityHipToDesiredFootInWorldFrame_;
+}
+
+void LegBase::setDesiredLinearVelocityHipToFootInWorldFrame(const LinearVelocity& linearVelocity) {
+  linearVelocityHipToDesiredFootInWorldFrame_ = linearVelocity;
+}
+
+const LinearAcceleration& LegBase::getDesiredLinearAccelerationHipToFootInWorldFrame() const {
+  return linearAccelerationHipToDesiredFootInWorldFrame_;
+}
+
+void LegBase::setDesiredLinearAccelerationHipToFootInWorldFrame(const LinearAcceleration& linearAcceleration) {
+  linearAccelerationHipToDesiredFootInWorldFrame_ = linearAcceleration;
+}
+
 
 void LegBase::setIsInStandConfiguration(bool isInStandConfiguration) {
   isInStandConfiguration_ = isInStandConfiguration;
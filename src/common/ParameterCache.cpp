@@ -0,0 +1,480 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterCache.cpp
+ */
+
+#include "loco/common/ParameterCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace loco {
+
+namespace {
+
+const char magic[8] = {'L', 'O', 'C', 'O', 'P', 'A', 'R', 'C'};
+const uint32_t noString = 0xffffffff;
+
+struct CacheHeader {
+  char magic_[8];
+  uint32_t version_;
+  uint32_t numberOfFiles_;
+  uint32_t numberOfElements_;
+  uint32_t numberOfAttributes_;
+  uint32_t stringTableSize_;
+  //! CRC-32 of everything after the header
+  uint32_t checksum_;
+};
+
+struct CacheFile {
+  uint32_t name_;
+  uint32_t firstElement_;
+  uint32_t numberOfElements_;
+  //! CRC-32 of the XML source
+  uint32_t sourceChecksum_;
+  //! modification time in nanoseconds
+  int64_t modificationTime_;
+  uint64_t size_;
+};
+
+//! Elements are stored in document order, i.e. a parent is always stored before its children.
+struct CacheElement {
+  uint32_t name_;
+  //! index of the parent relative to the first element of the file or -1 for the root elements
+  int32_t parent_;
+  uint32_t text_;
+  uint32_t firstAttribute_;
+  uint32_t numberOfAttributes_;
+};
+
+struct CacheAttribute {
+  uint32_t name_;
+  uint32_t value_;
+};
+
+std::vector<uint32_t> createCrc32Table() {
+  std::vector<uint32_t> table(256);
+  for (uint32_t i=0; i<256; i++) {
+    uint32_t c = i;
+    for (int k=0; k<8; k++) {
+      c = (c & 1) ? 0xedb88320 ^ (c >> 1) : (c >> 1);
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+uint32_t computeCrc32(const char* data, std::size_t size, uint32_t crc = 0) {
+  static const std::vector<uint32_t> table = createCrc32Table();
+  crc = ~crc;
+  for (std::size_t i=0; i<size; i++) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+bool getFileStatus(const std::string& path, int64_t* modificationTime, uint64_t* size) {
+  struct stat status;
+  if (stat(path.c_str(), &status) != 0) {
+    return false;
+  }
+  *modificationTime = static_cast<int64_t>(status.st_mtim.tv_sec)*1000000000 + static_cast<int64_t>(status.st_mtim.tv_nsec);
+  *size = static_cast<uint64_t>(status.st_size);
+  return true;
+}
+
+bool readFile(const std::string& path, std::string* content) {
+  std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << stream.rdbuf();
+  *content = buffer.str();
+  return true;
+}
+
+//! Collects the elements, attributes and strings of the XML files
+class CacheWriter {
+ public:
+  uint32_t addString(const char* string) {
+    if (string == nullptr) {
+      return noString;
+    }
+    auto it = stringOffsets_.find(string);
+    if (it != stringOffsets_.end()) {
+      return it->second;
+    }
+    const uint32_t offset = static_cast<uint32_t>(strings_.size());
+    strings_.insert(strings_.end(), string, string + strlen(string) + 1);
+    stringOffsets_[string] = offset;
+    return offset;
+  }
+
+  void addElement(const TiXmlElement* element, int32_t parent, uint32_t firstElement) {
+    CacheElement cacheElement;
+    cacheElement.name_ = addString(element->Value());
+    cacheElement.parent_ = parent;
+    cacheElement.text_ = addString(element->GetText());
+    cacheElement.firstAttribute_ = static_cast<uint32_t>(attributes_.size());
+    cacheElement.numberOfAttributes_ = 0;
+    for (const TiXmlAttribute* attribute = element->FirstAttribute(); attribute; attribute = attribute->Next()) {
+      CacheAttribute cacheAttribute;
+      cacheAttribute.name_ = addString(attribute->Name());
+      cacheAttribute.value_ = addString(attribute->Value());
+      attributes_.push_back(cacheAttribute);
+      cacheElement.numberOfAttributes_++;
+    }
+    const int32_t index = static_cast<int32_t>(elements_.size() - firstElement);
+    elements_.push_back(cacheElement);
+    for (const TiXmlElement* child = element->FirstChildElement(); child; child = child->NextSiblingElement()) {
+      addElement(child, index, firstElement);
+    }
+  }
+
+  bool addFile(const std::string& directory, const std::string& fileName) {
+    const std::string path = directory + "/" + fileName;
+    std::string source;
+    if (!readFile(path, &source)) {
+      printf("Could not read parameter file %s\n", path.c_str());
+      return false;
+    }
+
+    TiXmlDocument document;
+    document.Parse(source.c_str());
+    if (document.Error()) {
+      printf("Could not parse parameter file %s: %s\n", path.c_str(), document.ErrorDesc());
+      return false;
+    }
+
+    CacheFile cacheFile;
+    cacheFile.name_ = addString(fileName.c_str());
+    cacheFile.firstElement_ = static_cast<uint32_t>(elements_.size());
+    cacheFile.sourceChecksum_ = computeCrc32(source.data(), source.size());
+    if (!getFileStatus(path, &cacheFile.modificationTime_, &cacheFile.size_)) {
+      return false;
+    }
+    for (const TiXmlElement* element = document.FirstChildElement(); element; element = element->NextSiblingElement()) {
+      addElement(element, -1, cacheFile.firstElement_);
+    }
+    cacheFile.numberOfElements_ = static_cast<uint32_t>(elements_.size()) - cacheFile.firstElement_;
+    files_.push_back(cacheFile);
+    return true;
+  }
+
+  bool write(const std::string& cacheFile) const {
+    std::string payload;
+    payload.append(reinterpret_cast<const char*>(files_.data()), files_.size()*sizeof(CacheFile));
+    payload.append(reinterpret_cast<const char*>(elements_.data()), elements_.size()*sizeof(CacheElement));
+    payload.append(reinterpret_cast<const char*>(attributes_.data()), attributes_.size()*sizeof(CacheAttribute));
+    payload.append(strings_.data(), strings_.size());
+
+    CacheHeader header;
+    memcpy(header.magic_, magic, sizeof(magic));
+    header.version_ = ParameterCache::version;
+    header.numberOfFiles_ = static_cast<uint32_t>(files_.size());
+    header.numberOfElements_ = static_cast<uint32_t>(elements_.size());
+    header.numberOfAttributes_ = static_cast<uint32_t>(attributes_.size());
+    header.stringTableSize_ = static_cast<uint32_t>(strings_.size());
+    header.checksum_ = computeCrc32(payload.data(), payload.size());
+
+    // write to a temporary file first such that a process mapping the old cache never sees a partial file
+    const std::string temporaryFile = cacheFile + ".tmp";
+    {
+      std::ofstream stream(temporaryFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!stream) {
+        printf("Could not write parameter cache %s\n", temporaryFile.c_str());
+        return false;
+      }
+      stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      stream.write(payload.data(), payload.size());
+      if (!stream) {
+        printf("Could not write parameter cache %s\n", temporaryFile.c_str());
+        return false;
+      }
+    }
+    if (rename(temporaryFile.c_str(), cacheFile.c_str()) != 0) {
+      printf("Could not replace parameter cache %s\n", cacheFile.c_str());
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  std::vector<CacheFile> files_;
+  std::vector<CacheElement> elements_;
+  std::vector<CacheAttribute> attributes_;
+  std::vector<char> strings_;
+  std::map<std::string, uint32_t> stringOffsets_;
+};
+
+const CacheHeader* getHeader(const char* data) {
+  return reinterpret_cast<const CacheHeader*>(data);
+}
+const CacheFile* getFiles(const char* data) {
+  return reinterpret_cast<const CacheFile*>(data + sizeof(CacheHeader));
+}
+const CacheElement* getElements(const char* data) {
+  return reinterpret_cast<const CacheElement*>(getFiles(data) + getHeader(data)->numberOfFiles_);
+}
+const CacheAttribute* getAttributes(const char* data) {
+  return reinterpret_cast<const CacheAttribute*>(getElements(data) + getHeader(data)->numberOfElements_);
+}
+const char* getStringTable(const char* data) {
+  return reinterpret_cast<const char*>(getAttributes(data) + getHeader(data)->numberOfAttributes_);
+}
+
+} /* namespace */
+
+
+const uint32_t ParameterCache::version = 2;
+const char* ParameterCache::defaultFileName = "parameters.cache";
+
+ParameterCache::ParameterCache() :
+    data_(nullptr),
+    size_(0),
+    directory_()
+{
+
+}
+
+ParameterCache::~ParameterCache() {
+  close();
+}
+
+bool ParameterCache::compile(const std::string& directory, const std::vector<std::string>& fileNames, const std::string& cacheFile) {
+  CacheWriter writer;
+  for (const std::string& fileName : fileNames) {
+    if (!writer.addFile(directory, fileName)) {
+      return false;
+    }
+  }
+  return writer.write(cacheFile);
+}
+
+bool ParameterCache::listXmlFiles(const std::string& directory, std::vector<std::string>* fileNames) {
+  DIR* dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    printf("Could not open parameter directory %s\n", directory.c_str());
+    return false;
+  }
+  fileNames->clear();
+  for (struct dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    const std::string name(entry->d_name);
+    if (name.size() > 4 && name.compare(name.size()-4, 4, ".xml") == 0) {
+      fileNames->push_back(name);
+    }
+  }
+  closedir(dir);
+  std::sort(fileNames->begin(), fileNames->end());
+  return true;
+}
+
+bool ParameterCache::compileDirectory(const std::string& directory, const std::string& cacheFile) {
+  std::vector<std::string> fileNames;
+  if (!listXmlFiles(directory, &fileNames)) {
+    return false;
+  }
+  return compile(directory, fileNames, cacheFile);
+}
+
+bool ParameterCache::open(const std::string& directory, const std::string& cacheFile) {
+  close();
+
+  int fileDescriptor = ::open(cacheFile.c_str(), O_RDONLY);
+  if (fileDescriptor < 0) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(fileDescriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(CacheHeader)) {
+    ::close(fileDescriptor);
+    return false;
+  }
+  const std::size_t size = static_cast<std::size_t>(status.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  ::close(fileDescriptor);
+  if (data == MAP_FAILED) {
+    printf("Could not map parameter cache %s\n", cacheFile.c_str());
+    return false;
+  }
+  data_ = static_cast<const char*>(data);
+  size_ = size;
+
+  const CacheHeader* header = getHeader(data_);
+  if (memcmp(header->magic_, magic, sizeof(magic)) != 0 || header->version_ != version) {
+    printf("Parameter cache %s has an unknown format or version\n", cacheFile.c_str());
+    close();
+    return false;
+  }
+  const std::size_t expectedSize = sizeof(CacheHeader) + header->numberOfFiles_*sizeof(CacheFile)
+      + header->numberOfElements_*sizeof(CacheElement) + header->numberOfAttributes_*sizeof(CacheAttribute)
+      + header->stringTableSize_;
+  if (size_ != expectedSize
+      || computeCrc32(data_ + sizeof(CacheHeader), size_ - sizeof(CacheHeader)) != header->checksum_) {
+    printf("Parameter cache %s is corrupted\n", cacheFile.c_str());
+    close();
+    return false;
+  }
+
+  directory_ = directory;
+  return true;
+}
+
+bool ParameterCache::openOrRebuild(const std::string& directory, const std::string& cacheFile) {
+  if (open(directory, cacheFile) && isUpToDate()) {
+    return true;
+  }
+  close();
+  if (!compileDirectory(directory, cacheFile)) {
+    printf("Could not compile parameter cache %s\n", cacheFile.c_str());
+    return false;
+  }
+  return open(directory, cacheFile);
+}
+
+void ParameterCache::close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  directory_.clear();
+}
+
+bool ParameterCache::isOpen() const {
+  return data_ != nullptr;
+}
+
+bool ParameterCache::isUpToDate() const {
+  if (!isOpen()) {
+    return false;
+  }
+  std::vector<std::string> fileNames;
+  if (!listXmlFiles(directory_, &fileNames)) {
+    return false;
+  }
+  if (fileNames.size() != getHeader(data_)->numberOfFiles_) {
+    return false;
+  }
+  for (const std::string& fileName : fileNames) {
+    const int fileIndex = findFile(fileName);
+    if (fileIndex < 0 || !isFileUpToDate(fileIndex)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParameterCache::loadXmlDocument(const std::string& filename, TiXmlDocument* document) const {
+  if (!isOpen() || filename.compare(0, directory_.size()+1, directory_ + "/") != 0) {
+    return false;
+  }
+  const int fileIndex = findFile(filename.substr(directory_.size()+1));
+  if (fileIndex < 0 || !isFileUpToDate(fileIndex)) {
+    return false;
+  }
+
+  const CacheFile& file = getFiles(data_)[fileIndex];
+  const CacheElement* elements = getElements(data_) + file.firstElement_;
+  const CacheAttribute* attributes = getAttributes(data_);
+
+  document->Clear();
+  std::vector<TiXmlElement*> nodes(file.numberOfElements_, nullptr);
+  for (uint32_t i=0; i<file.numberOfElements_; i++) {
+    const CacheElement& element = elements[i];
+    TiXmlElement* node = new TiXmlElement(getString(element.name_));
+    for (uint32_t k=0; k<element.numberOfAttributes_; k++) {
+      const CacheAttribute& attribute = attributes[element.firstAttribute_+k];
+      node->SetAttribute(getString(attribute.name_), getString(attribute.value_));
+    }
+    if (element.text_ != noString) {
+      node->LinkEndChild(new TiXmlText(getString(element.text_)));
+    }
+    if (element.parent_ < 0) {
+      document->LinkEndChild(node);
+    }
+    else {
+      nodes[element.parent_]->LinkEndChild(node);
+    }
+    nodes[i] = node;
+  }
+  return true;
+}
+
+int ParameterCache::findFile(const std::string& fileName) const {
+  const CacheFile* files = getFiles(data_);
+  for (uint32_t i=0; i<getHeader(data_)->numberOfFiles_; i++) {
+    if (fileName == getString(files[i].name_)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool ParameterCache::isFileUpToDate(int fileIndex) const {
+  const CacheFile& file = getFiles(data_)[fileIndex];
+  int64_t modificationTime;
+  uint64_t size;
+  const std::string path = directory_ + "/" + getString(file.name_);
+  if (!getFileStatus(path, &modificationTime, &size) || size != file.size_) {
+    return false;
+  }
+  if (modificationTime == file.modificationTime_) {
+    return true;
+  }
+  // the file has been written since the cache was compiled, it is only outdated if its content changed
+  std::string source;
+  if (!readFile(path, &source)) {
+    return false;
+  }
+  return computeCrc32(source.data(), source.size()) == file.sourceChecksum_;
+}
+
+const char* ParameterCache::getString(uint32_t offset) const {
+  return getStringTable(data_) + offset;
+}
+
+} /* namespace loco */
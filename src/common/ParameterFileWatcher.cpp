@@ -0,0 +1,133 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterFileWatcher.cpp
+ */
+
+#include "loco/common/ParameterFileWatcher.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace loco {
+
+ParameterFileWatcher::ParameterFileWatcher() :
+    fileDescriptor_(-1),
+    watchDescriptor_(-1),
+    directory_()
+{
+
+}
+
+ParameterFileWatcher::~ParameterFileWatcher() {
+  stop();
+}
+
+bool ParameterFileWatcher::watch(const std::string& directory) {
+  stop();
+
+  fileDescriptor_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fileDescriptor_ < 0) {
+    printf("Could not initialize inotify to watch %s\n", directory.c_str());
+    return false;
+  }
+  watchDescriptor_ = inotify_add_watch(fileDescriptor_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+  if (watchDescriptor_ < 0) {
+    printf("Could not watch parameter directory %s\n", directory.c_str());
+    stop();
+    return false;
+  }
+  directory_ = directory;
+  return true;
+}
+
+void ParameterFileWatcher::stop() {
+  if (fileDescriptor_ >= 0) {
+    if (watchDescriptor_ >= 0) {
+      inotify_rm_watch(fileDescriptor_, watchDescriptor_);
+    }
+    close(fileDescriptor_);
+  }
+  fileDescriptor_ = -1;
+  watchDescriptor_ = -1;
+  directory_.clear();
+}
+
+bool ParameterFileWatcher::isWatching() const {
+  return fileDescriptor_ >= 0;
+}
+
+bool ParameterFileWatcher::waitForModifiedFiles(std::vector<std::string>* fileNames, int timeout) {
+  fileNames->clear();
+  if (!isWatching()) {
+    return false;
+  }
+
+  struct pollfd pollDescriptor;
+  pollDescriptor.fd = fileDescriptor_;
+  pollDescriptor.events = POLLIN;
+  pollDescriptor.revents = 0;
+  if (poll(&pollDescriptor, 1, timeout) <= 0 || !(pollDescriptor.revents & POLLIN)) {
+    return false;
+  }
+
+  char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  for (ssize_t length = read(fileDescriptor_, buffer, sizeof(buffer)); length > 0; length = read(fileDescriptor_, buffer, sizeof(buffer))) {
+    for (char* pointer = buffer; pointer < buffer + length; ) {
+      const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(pointer);
+      pointer += sizeof(struct inotify_event) + event->len;
+
+      if (event->len == 0 || (event->mask & IN_ISDIR)) {
+        continue;
+      }
+      const std::string name(event->name);
+      if (name.size() > 4 && name.compare(name.size()-4, 4, ".xml") == 0
+          && std::find(fileNames->begin(), fileNames->end(), name) == fileNames->end()) {
+        fileNames->push_back(name);
+      }
+    }
+  }
+  return !fileNames->empty();
+}
+
+const std::string& ParameterFileWatcher::getDirectory() const {
+  return directory_;
+}
+
+} /* namespace loco */
@@ -46,7 +46,9 @@ namespace loco {
 ParameterSet::ParameterSet() :
     isDocumentLoaded_(false),
     xmlDocument_(),
-    xmlDocumentHandle_(&xmlDocument_)
+    xmlDocumentHandle_(&xmlDocument_),
+    parameterFile_(),
+    parameterCache_(nullptr)
 {
 
 
@@ -55,7 +57,9 @@ ParameterSet::ParameterSet() :
 ParameterSet::ParameterSet(const std::string& filename) :
     isDocumentLoaded_(false),
     xmlDocument_(),
-    xmlDocumentHandle_(&xmlDocument_)
+    xmlDocumentHandle_(&xmlDocument_),
+    parameterFile_(),
+    parameterCache_(nullptr)
 {
   loadXmlDocument(filename);
   if (!isDocumentLoaded_) {
@@ -71,16 +75,42 @@ bool ParameterSet::isDocumentLoaded() {
   return isDocumentLoaded_;
 }
 
-bool ParameterSet::loadXmlDocument(const std::string& filename) {
+bool ParameterSet::loadXmlDocument(const std::string& filename, const ParameterCache* parameterCache) {
   parameterFile_ = filename;
+  parameterCache_ = parameterCache;
+  if (parameterCache != nullptr && parameterCache->loadXmlDocument(filename, &xmlDocument_)) {
+    isDocumentLoaded_ = true;
+    return isDocumentLoaded_;
+  }
   isDocumentLoaded_ = xmlDocument_.LoadFile(filename);
   return isDocumentLoaded_;
 }
 
+bool ParameterSet::reloadXmlDocument() {
+  if (parameterFile_.empty()) {
+    return false;
+  }
+  return loadXmlDocument(parameterFile_, parameterCache_);
+}
+
+void ParameterSet::setXmlDocument(const TiXmlDocument& document) {
+  xmlDocument_ = document;
+  isDocumentLoaded_ = true;
+}
+
 TiXmlHandle& ParameterSet::getHandle() {
   return xmlDocumentHandle_;
 }
 
+void ParameterSet::releaseXmlDocument() {
+  xmlDocument_.Clear();
+  isDocumentLoaded_ = false;
+}
+
+const std::string& ParameterSet::getParameterFile() const {
+  return parameterFile_;
+}
+
 } /* namespace loco */
 
 
@@ -0,0 +1,208 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * ParameterVector.cpp
+ */
+
+#include "loco/common/ParameterVector.hpp"
+
+#include <cstdio>
+
+namespace loco {
+
+ParameterVector::ParameterVector() :
+    slices_(),
+    parameters_(),
+    values_()
+{
+
+}
+
+ParameterVector::~ParameterVector() {
+
+}
+
+void ParameterVector::addSlice(const std::string& name, const std::vector<double*>& parameters,
+                               const ParametersChangedCallback& callback) {
+  Slice slice;
+  slice.name_ = name;
+  slice.offset_ = static_cast<int>(parameters_.size());
+  slice.size_ = static_cast<int>(parameters.size());
+  slice.callback_ = callback;
+  slices_.push_back(slice);
+  parameters_.insert(parameters_.end(), parameters.begin(), parameters.end());
+
+  values_.conservativeResize(parameters_.size());
+  for (int i=slice.offset_; i<slice.offset_+slice.size_; i++) {
+    values_(i) = *parameters_[i];
+  }
+}
+
+bool ParameterVector::setSliceParameters(const std::string& name, const std::vector<double*>& parameters) {
+  const int sliceIndex = getSliceIndex(name);
+  if (sliceIndex == -1 || !isAttachedToModules()) {
+    return false;
+  }
+  Slice& slice = slices_[sliceIndex];
+  const int sizeChange = static_cast<int>(parameters.size())-slice.size_;
+  if (sizeChange != 0) {
+    Eigen::VectorXd values(getSize()+sizeChange);
+    values.head(slice.offset_) = values_.head(slice.offset_);
+    const int sizeBehind = getSize()-slice.offset_-slice.size_;
+    values.tail(sizeBehind) = values_.tail(sizeBehind);
+    values_.swap(values);
+    parameters_.erase(parameters_.begin()+slice.offset_, parameters_.begin()+slice.offset_+slice.size_);
+    parameters_.insert(parameters_.begin()+slice.offset_, parameters.size(), nullptr);
+    slice.size_ = static_cast<int>(parameters.size());
+    for (int i=sliceIndex+1; i<getNumberOfSlices(); i++) {
+      slices_[i].offset_ += sizeChange;
+    }
+  }
+  for (int i=0; i<slice.size_; i++) {
+    parameters_[slice.offset_+i] = parameters[i];
+    values_(slice.offset_+i) = *parameters[i];
+  }
+  return true;
+}
+
+void ParameterVector::clear() {
+  slices_.clear();
+  parameters_.clear();
+  values_.resize(0);
+}
+
+void ParameterVector::detachFromModules() {
+  parameters_.clear();
+  for (Slice& slice : slices_) {
+    slice.callback_ = ParametersChangedCallback();
+  }
+}
+
+bool ParameterVector::isAttachedToModules() const {
+  return static_cast<int>(parameters_.size()) == getSize();
+}
+
+void ParameterVector::readFromModules() {
+  if (!isAttachedToModules()) {
+    return;
+  }
+  for (int i=0; i<getSize(); i++) {
+    values_(i) = *parameters_[i];
+  }
+}
+
+void ParameterVector::writeToModules() {
+  if (!isAttachedToModules()) {
+    return;
+  }
+  for (const Slice& slice : slices_) {
+    bool isChanged = false;
+    for (int i=slice.offset_; i<slice.offset_+slice.size_; i++) {
+      if (*parameters_[i] != values_(i)) {
+        *parameters_[i] = values_(i);
+        isChanged = true;
+      }
+    }
+    if (isChanged && slice.callback_) {
+      slice.callback_();
+    }
+  }
+}
+
+bool ParameterVector::setToInterpolated(const ParameterVector& parameterVector1, const ParameterVector& parameterVector2, double t) {
+  if (!hasSameLayout(parameterVector1) || !hasSameLayout(parameterVector2)) {
+    printf("ParameterVector: Cannot interpolate between parameter vectors with different layouts!\n");
+    return false;
+  }
+  values_ = parameterVector1.values_ + t*(parameterVector2.values_ - parameterVector1.values_);
+  writeToModules();
+  return true;
+}
+
+bool ParameterVector::hasSameLayout(const ParameterVector& parameterVector) const {
+  if (slices_.size() != parameterVector.slices_.size()) {
+    return false;
+  }
+  for (int i=0; i<getNumberOfSlices(); i++) {
+    if (slices_[i].size_ != parameterVector.slices_[i].size_ || slices_[i].name_ != parameterVector.slices_[i].name_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const Eigen::VectorXd& ParameterVector::getValues() const {
+  return values_;
+}
+
+bool ParameterVector::setValues(const Eigen::VectorXd& values) {
+  if (values.size() != values_.size()) {
+    return false;
+  }
+  values_ = values;
+  writeToModules();
+  return true;
+}
+
+int ParameterVector::getSize() const {
+  return static_cast<int>(values_.size());
+}
+
+int ParameterVector::getNumberOfSlices() const {
+  return static_cast<int>(slices_.size());
+}
+
+const std::string& ParameterVector::getSliceName(int sliceIndex) const {
+  return slices_[sliceIndex].name_;
+}
+
+int ParameterVector::getSliceOffset(int sliceIndex) const {
+  return slices_[sliceIndex].offset_;
+}
+
+int ParameterVector::getSliceSize(int sliceIndex) const {
+  return slices_[sliceIndex].size_;
+}
+
+int ParameterVector::getSliceIndex(const std::string& name) const {
+  for (int i=0; i<getNumberOfSlices(); i++) {
+    if (slices_[i].name_ == name) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+} /* namespace loco */
@@ -0,0 +1,180 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * RegionHashTable.cpp
+ */
+
+#include "loco/common/RegionHashTable.hpp"
+
+#include <algorithm>
+
+namespace loco {
+
+RegionHashTable::RegionHashTable(int capacity) :
+    capacity_(0),
+    size_(0),
+    bucketMask_(0)
+{
+  setCapacity(capacity);
+}
+
+
+RegionHashTable::~RegionHashTable() {
+
+}
+
+
+void RegionHashTable::setCapacity(int capacity) {
+  capacity_ = std::max(capacity, 0);
+
+  // The number of buckets is a power of two and at least twice the capacity
+  int numberOfBuckets = 2;
+  while (numberOfBuckets < 2*capacity_) {
+    numberOfBuckets *= 2;
+  }
+  buckets_.resize(numberOfBuckets);
+  bucketMask_ = numberOfBuckets - 1;
+  keys_.resize(capacity_);
+  isUsed_.resize(capacity_);
+  freeSlots_.reserve(capacity_);
+  clear();
+}
+
+
+void RegionHashTable::clear() {
+  std::fill(buckets_.begin(), buckets_.end(), -1);
+  std::fill(isUsed_.begin(), isUsed_.end(), false);
+  // The lowest slots are used first
+  freeSlots_.clear();
+  for (int slot = capacity_ - 1; slot >= 0; slot--) {
+    freeSlots_.push_back(slot);
+  }
+  size_ = 0;
+}
+
+
+int RegionHashTable::find(int64_t key) const {
+  const int bucketIndex = findBucketIndex(key);
+  return (bucketIndex < 0) ? -1 : buckets_[bucketIndex];
+}
+
+
+int RegionHashTable::insert(int64_t key) {
+  int bucketIndex = getBucketIndex(key);
+  while (buckets_[bucketIndex] >= 0) {
+    if (keys_[buckets_[bucketIndex]] == key) {
+      return buckets_[bucketIndex];
+    }
+    bucketIndex = (bucketIndex + 1) & bucketMask_;
+  }
+  if (freeSlots_.empty()) {
+    return -1;
+  }
+
+  const int slot = freeSlots_.back();
+  freeSlots_.pop_back();
+  buckets_[bucketIndex] = slot;
+  keys_[slot] = key;
+  isUsed_[slot] = true;
+  size_++;
+  return slot;
+}
+
+
+bool RegionHashTable::erase(int64_t key) {
+  int bucketIndex = findBucketIndex(key);
+  if (bucketIndex < 0) {
+    return false;
+  }
+  const int slot = buckets_[bucketIndex];
+  isUsed_[slot] = false;
+  freeSlots_.push_back(slot);
+  size_--;
+
+  // Shift the following keys of the probe sequence back, such that no key is behind an empty bucket
+  buckets_[bucketIndex] = -1;
+  int nextBucketIndex = (bucketIndex + 1) & bucketMask_;
+  while (buckets_[nextBucketIndex] >= 0) {
+    const int homeBucketIndex = getBucketIndex(keys_[buckets_[nextBucketIndex]]);
+    if (((nextBucketIndex - homeBucketIndex) & bucketMask_) >= ((nextBucketIndex - bucketIndex) & bucketMask_)) {
+      buckets_[bucketIndex] = buckets_[nextBucketIndex];
+      buckets_[nextBucketIndex] = -1;
+      bucketIndex = nextBucketIndex;
+    }
+    nextBucketIndex = (nextBucketIndex + 1) & bucketMask_;
+  }
+  return true;
+}
+
+
+bool RegionHashTable::isUsed(int slot) const {
+  return isUsed_[slot];
+}
+
+
+int64_t RegionHashTable::getKey(int slot) const {
+  return keys_[slot];
+}
+
+
+int RegionHashTable::size() const {
+  return size_;
+}
+
+
+int RegionHashTable::getCapacity() const {
+  return capacity_;
+}
+
+
+int RegionHashTable::getBucketIndex(int64_t key) const {
+  // Fibonacci hashing mixes the bits of both region indices
+  const uint64_t hash = static_cast<uint64_t>(key)*0x9E3779B97F4A7C15ull;
+  return static_cast<int>(hash >> 32) & bucketMask_;
+}
+
+
+int RegionHashTable::findBucketIndex(int64_t key) const {
+  int bucketIndex = getBucketIndex(key);
+  while (buckets_[bucketIndex] >= 0) {
+    if (keys_[buckets_[bucketIndex]] == key) {
+      return bucketIndex;
+    }
+    bucketIndex = (bucketIndex + 1) & bucketMask_;
+  }
+  return -1;
+}
+
+} /* namespace loco */
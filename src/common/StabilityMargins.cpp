@@ -0,0 +1,249 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * StabilityMargins.cpp
+ */
+
+#include "loco/common/StabilityMargins.hpp"
+#include "loco/contact_force_distribution/ContactForceDistributionBase.hpp"
+#include "loco/motion_control/WholeBodyController.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace loco {
+
+StabilityMargins::StabilityMargins(LegGroup* legs, TorsoBase* torso) :
+    legs_(legs),
+    torso_(torso),
+    contactForceDistribution_(nullptr),
+    wholeBodyController_(nullptr),
+    isValid_(false),
+    isCenterOfPressureValid_(false),
+    supportPolygonMargin_(-std::numeric_limits<double>::infinity()),
+    centerOfPressureMargin_(-std::numeric_limits<double>::infinity()),
+    capturePointMargin_(-std::numeric_limits<double>::infinity())
+{
+
+}
+
+
+StabilityMargins::~StabilityMargins() {
+
+}
+
+
+void StabilityMargins::setContactForceDistribution(const ContactForceDistributionBase* contactForceDistribution) {
+  contactForceDistribution_ = contactForceDistribution;
+}
+
+
+void StabilityMargins::setWholeBodyController(const WholeBodyController* wholeBodyController) {
+  wholeBodyController_ = wholeBodyController;
+}
+
+
+bool StabilityMargins::update() {
+  isValid_ = false;
+  isCenterOfPressureValid_ = false;
+  supportPolygonMargin_ = -std::numeric_limits<double>::infinity();
+  centerOfPressureMargin_ = -std::numeric_limits<double>::infinity();
+  capturePointMargin_ = -std::numeric_limits<double>::infinity();
+  if (legs_ == nullptr || torso_ == nullptr) {
+    return false;
+  }
+
+  /* support polygon of the grounded feet and center of pressure of the ground reaction forces */
+  feet_.resize(2, std::min(static_cast<int>(legs_->size()), static_cast<int>(ConvexPolygon::maxNumberOfVertices)));
+  int nGroundedLegs = 0;
+  double heightOfFeet = 0.0;
+  double normalForce = 0.0;
+  Position positionWorldToCenterOfPressureInWorldFrame;
+  for (auto leg : *legs_) {
+    if (!leg->isGrounded() || nGroundedLegs >= ConvexPolygon::maxNumberOfVertices) {
+      continue;
+    }
+    const Position& positionWorldToFootInWorldFrame = leg->getPositionWorldToFootInWorldFrame();
+    feet_.col(nGroundedLegs) << positionWorldToFootInWorldFrame.x(), positionWorldToFootInWorldFrame.y();
+    legIdsOfFeet_[nGroundedLegs] = leg->getId();
+    heightOfFeet += positionWorldToFootInWorldFrame.z();
+    nGroundedLegs++;
+
+    Force forceInWorldFrame;
+    bool isForceAvailable = false;
+    if (wholeBodyController_ != nullptr) {
+      if (leg->getId() >= 0 && leg->getId() < WholeBodyController::numberOfLegs) {
+        forceInWorldFrame = wholeBodyController_->getGroundReactionForceInWorldFrame(leg->getId());
+        isForceAvailable = true;
+      }
+    }
+    else if (contactForceDistribution_ != nullptr) {
+      isForceAvailable = contactForceDistribution_->getGroundReactionForceInWorldFrame(leg, forceInWorldFrame);
+    }
+    if (isForceAvailable && forceInWorldFrame.z() > 0.0) {
+      positionWorldToCenterOfPressureInWorldFrame += positionWorldToFootInWorldFrame*forceInWorldFrame.z();
+      normalForce += forceInWorldFrame.z();
+    }
+  }
+  feet_.conservativeResize(2, nGroundedLegs);
+  supportPolygon_.setToConvexHull(feet_);
+  if (nGroundedLegs == 0) {
+    return false;
+  }
+  heightOfFeet /= nGroundedLegs;
+
+  /* center of mass */
+  const RotationQuaternion& orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+  positionWorldToCenterOfMassInWorldFrame_ = torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame()
+      + orientationWorldToBase.inverseRotate(torso_->getProperties().getBaseToCenterOfMassPositionInBaseFrame());
+  supportPolygonMargin_ = getMargin(supportPolygon_, positionWorldToCenterOfMassInWorldFrame_);
+
+  if (normalForce > 0.0) {
+    positionWorldToCenterOfPressureInWorldFrame_ = positionWorldToCenterOfPressureInWorldFrame/normalForce;
+    centerOfPressureMargin_ = getMargin(supportPolygon_, positionWorldToCenterOfPressureInWorldFrame_);
+    isCenterOfPressureValid_ = true;
+  }
+
+  /* instantaneous capture point of the linear inverted pendulum */
+  const LinearVelocity linearVelocityBaseInWorldFrame = orientationWorldToBase.inverseRotate(torso_->getMeasuredState().getLinearVelocityBaseInBaseFrame());
+  const double height = positionWorldToCenterOfMassInWorldFrame_.z() - heightOfFeet;
+  const double gravity = torso_->getProperties().getGravity().norm();
+  if (height > 0.0 && gravity > 0.0) {
+    const double timeConstant = std::sqrt(height/gravity);
+    positionWorldToCapturePointInWorldFrame_ = positionWorldToCenterOfMassInWorldFrame_
+        + Position(linearVelocityBaseInWorldFrame.x()*timeConstant, linearVelocityBaseInWorldFrame.y()*timeConstant, 0.0);
+    capturePointMargin_ = getMargin(supportPolygon_, positionWorldToCapturePointInWorldFrame_);
+  }
+  else {
+    positionWorldToCapturePointInWorldFrame_ = positionWorldToCenterOfMassInWorldFrame_;
+  }
+
+  isValid_ = true;
+  return true;
+}
+
+
+double StabilityMargins::getMargin(const ConvexPolygon& supportPolygon, const Position& positionWorldToPointInWorldFrame) {
+  const ConvexPolygon::Point point(positionWorldToPointInWorldFrame.x(), positionWorldToPointInWorldFrame.y());
+  const int nVertices = supportPolygon.getNumberOfVertices();
+  if (nVertices >= 3) {
+    return supportPolygon.getSignedDistance(point);
+  }
+  if (nVertices == 2) {
+    const ConvexPolygon::Point a = supportPolygon.getVertex(0);
+    const ConvexPolygon::Point ab = supportPolygon.getVertex(1) - a;
+    const double s = std::min(std::max((point-a).dot(ab)/ab.squaredNorm(), 0.0), 1.0);
+    return -(point - a - s*ab).norm();
+  }
+  if (nVertices == 1) {
+    return -(point - supportPolygon.getVertex(0)).norm();
+  }
+  return -std::numeric_limits<double>::infinity();
+}
+
+
+void StabilityMargins::invalidate() {
+  isValid_ = false;
+}
+
+
+bool StabilityMargins::isValid() const {
+  return isValid_;
+}
+
+
+double StabilityMargins::getSupportPolygonMargin() const {
+  return supportPolygonMargin_;
+}
+
+
+double StabilityMargins::getCenterOfPressureMargin() const {
+  return centerOfPressureMargin_;
+}
+
+
+double StabilityMargins::getCapturePointMargin() const {
+  return capturePointMargin_;
+}
+
+
+double StabilityMargins::getCapturePointMarginWithoutLeg(const LegBase& leg) const {
+  if (!isValid_ || !std::isfinite(capturePointMargin_)) {
+    return capturePointMargin_;
+  }
+  const int nFeet = feet_.cols();
+  ConvexPolygon::Points feet(2, nFeet);
+  int nRemainingFeet = 0;
+  for (int k=0; k<nFeet; k++) {
+    if (legIdsOfFeet_[k] != leg.getId()) {
+      feet.col(nRemainingFeet++) = feet_.col(k);
+    }
+  }
+  if (nRemainingFeet == nFeet) {
+    return capturePointMargin_;
+  }
+  feet.conservativeResize(2, nRemainingFeet);
+  ConvexPolygon supportPolygon;
+  supportPolygon.setToConvexHull(feet);
+  return getMargin(supportPolygon, positionWorldToCapturePointInWorldFrame_);
+}
+
+
+bool StabilityMargins::isCenterOfPressureValid() const {
+  return isCenterOfPressureValid_;
+}
+
+
+const Position& StabilityMargins::getPositionWorldToCenterOfMassInWorldFrame() const {
+  return positionWorldToCenterOfMassInWorldFrame_;
+}
+
+
+const Position& StabilityMargins::getPositionWorldToCenterOfPressureInWorldFrame() const {
+  return positionWorldToCenterOfPressureInWorldFrame_;
+}
+
+
+const Position& StabilityMargins::getPositionWorldToCapturePointInWorldFrame() const {
+  return positionWorldToCapturePointInWorldFrame_;
+}
+
+
+const ConvexPolygon& StabilityMargins::getSupportPolygon() const {
+  return supportPolygon_;
+}
+
+} /* namespace loco */
@@ -52,4 +52,30 @@ TerrainModelBase::~TerrainModelBase() {
 
 }
 
+bool TerrainModelBase::getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const {
+  bool isSuccessful = true;
+  heightsInWorldFrame.resize(positionsWorldToLocationInWorldFrame.size());
+  for (size_t i = 0; i < positionsWorldToLocationInWorldFrame.size(); i++) {
+    isSuccessful &= getHeight(positionsWorldToLocationInWorldFrame[i], heightsInWorldFrame[i]);
+  }
+  return isSuccessful;
+}
+
+bool TerrainModelBase::getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const {
+  bool isSuccessful = true;
+  normalsInWorldFrame.resize(positionsWorldToLocationInWorldFrame.size());
+  for (size_t i = 0; i < positionsWorldToLocationInWorldFrame.size(); i++) {
+    isSuccessful &= getNormal(positionsWorldToLocationInWorldFrame[i], normalsInWorldFrame[i]);
+  }
+  return isSuccessful;
+}
+
+bool TerrainModelBase::getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const {
+  projectedPositionsInWorldFrame.resize(positionsInWorldFrame.size());
+  for (size_t i = 0; i < positionsInWorldFrame.size(); i++) {
+    projectedPositionsInWorldFrame[i] = getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(positionsInWorldFrame[i]);
+  }
+  return true;
+}
+
 } /* namespace loco */
@@ -158,6 +158,45 @@ namespace loco {
   }
 
 
+  bool TerrainModelFreePlane::getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const {
+    // Same plane equation as getHeight, written as z = c + a*x + b*y
+    const double a = -normalInWorldFrame_.x()/normalInWorldFrame_.z();
+    const double b = -normalInWorldFrame_.y()/normalInWorldFrame_.z();
+    const double c = (positionInWorldFrame_.z() + normalInWorldFrame_.x()*positionInWorldFrame_.x()
+                      + normalInWorldFrame_.y()*positionInWorldFrame_.y())/normalInWorldFrame_.z();
+
+    const size_t numberOfPositions = positionsWorldToLocationInWorldFrame.size();
+    heightsInWorldFrame.resize(numberOfPositions);
+    for (size_t i = 0; i < numberOfPositions; i++) {
+      heightsInWorldFrame[i] = c + a*positionsWorldToLocationInWorldFrame[i].x() + b*positionsWorldToLocationInWorldFrame[i].y();
+    }
+    return true;
+  } // get heights
+
+
+  bool TerrainModelFreePlane::getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const {
+    normalsInWorldFrame.assign(positionsWorldToLocationInWorldFrame.size(), normalInWorldFrame_);
+    return true;
+  } // get normals
+
+
+  bool TerrainModelFreePlane::getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const {
+    // Signed version of getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame with the point on the plane at the origin precomputed
+    Position r1 = Position::Zero();
+    this->getHeight(r1);
+    const Eigen::Vector3d n = normalInWorldFrame_.toImplementation();
+    const double normOfNormal = n.norm();
+
+    const size_t numberOfPositions = positionsInWorldFrame.size();
+    projectedPositionsInWorldFrame.resize(numberOfPositions);
+    for (size_t i = 0; i < numberOfPositions; i++) {
+      const double signedDistance = n.dot(positionsInWorldFrame[i].toImplementation() - r1.toImplementation())/normOfNormal;
+      projectedPositionsInWorldFrame[i] = Position(positionsInWorldFrame[i].toImplementation() - signedDistance*n);
+    }
+    return true;
+  } // get projected positions
+
+
 } /* namespace loco */
 
 
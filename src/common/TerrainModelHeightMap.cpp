@@ -0,0 +1,632 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainModelHeightMap.cpp
+ */
+
+#include "loco/common/TerrainModelHeightMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace loco {
+
+namespace {
+
+const char magic[8] = {'L', 'O', 'C', 'O', 'H', 'M', 'A', 'P'};
+
+struct HeightMapFileHeader {
+  char magic_[8];
+  uint32_t version_;
+  uint32_t numberOfCellsX_;
+  uint32_t numberOfCellsY_;
+  uint32_t hasFriction_;
+  double resolution_;
+  //! Global index of the first cell, the cell (i, j) is located at (i*resolution, j*resolution)
+  int64_t originCellIndexX_;
+  int64_t originCellIndexY_;
+};
+
+//! Division that rounds towards negative infinity
+inline long floorDivide(long a, long b) {
+  return (a >= 0) ? a/b : -((-a + b - 1)/b);
+}
+
+//! Modulo that is always non-negative
+inline long positiveModulo(long a, long b) {
+  const long r = a % b;
+  return (r < 0) ? r + b : r;
+}
+
+//! Catmull-Rom spline through p1 and p2, t in [0, 1]
+inline double interpolateCubic(double p0, double p1, double p2, double p3, double t) {
+  return p1 + 0.5*t*(p2 - p0 + t*(2.0*p0 - 5.0*p1 + 4.0*p2 - p3 + t*(3.0*(p1 - p2) + p3 - p0)));
+}
+
+} // namespace
+
+const uint32_t TerrainModelHeightMap::fileVersion = 1;
+
+
+TerrainModelHeightMap::TerrainModelHeightMap(double resolution, int numberOfTilesX, int numberOfTilesY) :
+    TerrainModelBase(),
+    resolution_(resolution),
+    numberOfTilesX_(0),
+    numberOfTilesY_(0),
+    originTileIndexX_(0),
+    originTileIndexY_(0),
+    interpolationMethod_(InterpolationBilinear),
+    defaultHeight_(0.0),
+    defaultFrictionCoefficient_(0.6),
+    footRadius_(0.03),
+    footholdFilterGain_(0.5),
+    isMapLoaded_(false)
+{
+  resize(numberOfTilesX, numberOfTilesY);
+  originTileIndexX_ = -numberOfTilesX_/2;
+  originTileIndexY_ = -numberOfTilesY_/2;
+} // constructor
+
+
+TerrainModelHeightMap::~TerrainModelHeightMap() {
+
+} // destructor
+
+
+bool TerrainModelHeightMap::initialize(double /*dt*/) {
+  if (!isMapLoaded_) {
+    for (Tile& tile : tiles_) {
+      clearTile(tile);
+    }
+  }
+  return true;
+} // initialize
+
+
+bool TerrainModelHeightMap::getNormal(const loco::Position& positionWorldToLocationInWorldFrame, loco::Vector& normalInWorldFrame) const {
+  const double x = positionWorldToLocationInWorldFrame.x()/resolution_;
+  const double y = positionWorldToLocationInWorldFrame.y()/resolution_;
+  const long i = static_cast<long>(std::floor(x));
+  const long j = static_cast<long>(std::floor(y));
+  const double tx = x - i;
+  const double ty = y - j;
+
+  // Bilinear interpolation of the precomputed normals of the four surrounding cells
+  Eigen::Vector3d normal = Eigen::Vector3d::Zero();
+  const long is[2] = {clampCellIndexX(i), clampCellIndexX(i + 1)};
+  const long js[2] = {clampCellIndexY(j), clampCellIndexY(j + 1)};
+  const double wx[2] = {1.0 - tx, tx};
+  const double wy[2] = {1.0 - ty, ty};
+  for (int k = 0; k < 2; k++) {
+    for (int l = 0; l < 2; l++) {
+      const Tile& tile = getTile(is[k], js[l]);
+      const int offset = getCellOffset(is[k], js[l]);
+      const double weight = wx[k]*wy[l];
+      normal.x() += weight*tile.normalX_[offset];
+      normal.y() += weight*tile.normalY_[offset];
+      normal.z() += weight*tile.normalZ_[offset];
+    }
+  }
+  normalInWorldFrame = loco::Vector(normal.normalized());
+
+  return isInside(positionWorldToLocationInWorldFrame);
+} // get normal
+
+
+bool TerrainModelHeightMap::getHeight(loco::Position& positionWorldToLocationInWorldFrame) const {
+  double height;
+  const bool isInside = getHeight(positionWorldToLocationInWorldFrame, height);
+  positionWorldToLocationInWorldFrame.z() = height;
+  return isInside;
+} // get height at position, update position
+
+
+bool TerrainModelHeightMap::getHeight(const loco::Position& positionWorldToLocationInWorldFrame, double& heightInWorldFrame) const {
+  const double x = positionWorldToLocationInWorldFrame.x()/resolution_;
+  const double y = positionWorldToLocationInWorldFrame.y()/resolution_;
+
+  switch (interpolationMethod_) {
+    case InterpolationBicubic:
+      heightInWorldFrame = getHeightBicubic(x, y);
+      break;
+    case InterpolationBilinear:
+    default:
+      heightInWorldFrame = getHeightBilinear(x, y);
+      break;
+  }
+
+  return isInside(positionWorldToLocationInWorldFrame);
+} // get height at position, return height
+
+
+bool TerrainModelHeightMap::getFrictionCoefficientForFoot(const loco::Position& positionWorldToLocationInWorldFrame, double& frictionCoefficient) const {
+  const long i = clampCellIndexX(std::lround(positionWorldToLocationInWorldFrame.x()/resolution_));
+  const long j = clampCellIndexY(std::lround(positionWorldToLocationInWorldFrame.y()/resolution_));
+  frictionCoefficient = getTile(i, j).friction_[getCellOffset(i, j)];
+  return isInside(positionWorldToLocationInWorldFrame);
+} // get friction
+
+
+Position TerrainModelHeightMap::getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& positionInWorldFrame) const {
+  Position pointOnPlane;
+  Vector normal;
+  getTangentPlane(positionInWorldFrame, pointOnPlane, normal);
+  const double distance = normal.dot(Vector(positionInWorldFrame - pointOnPlane));
+  return positionInWorldFrame - distance*Position(normal);
+}
+
+
+double TerrainModelHeightMap::getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const {
+  Position pointOnPlane;
+  Vector normal;
+  getTangentPlane(positionInWorldFrame, pointOnPlane, normal);
+  return std::fabs(normal.dot(Vector(positionInWorldFrame - pointOnPlane)));
+}
+
+
+bool TerrainModelHeightMap::getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const {
+  bool isSuccessful = true;
+  heightsInWorldFrame.resize(positionsWorldToLocationInWorldFrame.size());
+  for (size_t i = 0; i < positionsWorldToLocationInWorldFrame.size(); i++) {
+    isSuccessful &= TerrainModelHeightMap::getHeight(positionsWorldToLocationInWorldFrame[i], heightsInWorldFrame[i]);
+  }
+  return isSuccessful;
+}
+
+
+bool TerrainModelHeightMap::getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const {
+  bool isSuccessful = true;
+  normalsInWorldFrame.resize(positionsWorldToLocationInWorldFrame.size());
+  for (size_t i = 0; i < positionsWorldToLocationInWorldFrame.size(); i++) {
+    isSuccessful &= TerrainModelHeightMap::getNormal(positionsWorldToLocationInWorldFrame[i], normalsInWorldFrame[i]);
+  }
+  return isSuccessful;
+}
+
+
+bool TerrainModelHeightMap::getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const {
+  bool isSuccessful = true;
+  projectedPositionsInWorldFrame.resize(positionsInWorldFrame.size());
+  for (size_t i = 0; i < positionsInWorldFrame.size(); i++) {
+    Position pointOnPlane;
+    Vector normal;
+    isSuccessful &= isInside(positionsInWorldFrame[i]);
+    getTangentPlane(positionsInWorldFrame[i], pointOnPlane, normal);
+    const double distance = normal.dot(Vector(positionsInWorldFrame[i] - pointOnPlane));
+    projectedPositionsInWorldFrame[i] = positionsInWorldFrame[i] - distance*Position(normal);
+  }
+  return isSuccessful;
+}
+
+
+void TerrainModelHeightMap::moveTo(const loco::Position& positionWorldToCenterInWorldFrame) {
+  const long originTileIndexX = floorDivide(getCellIndexX(positionWorldToCenterInWorldFrame.x()), tileSize) - numberOfTilesX_/2;
+  const long originTileIndexY = floorDivide(getCellIndexY(positionWorldToCenterInWorldFrame.y()), tileSize) - numberOfTilesY_/2;
+  if (originTileIndexX == originTileIndexX_ && originTileIndexY == originTileIndexY_) {
+    return;
+  }
+
+  const long previousOriginTileIndexX = originTileIndexX_;
+  const long previousOriginTileIndexY = originTileIndexY_;
+  // A tile is kept if it is inside of the map before and after the move
+  auto isKept = [&](long tx, long ty) {
+    return tx >= previousOriginTileIndexX && tx < previousOriginTileIndexX + numberOfTilesX_
+        && ty >= previousOriginTileIndexY && ty < previousOriginTileIndexY + numberOfTilesY_
+        && tx >= originTileIndexX && tx < originTileIndexX + numberOfTilesX_
+        && ty >= originTileIndexY && ty < originTileIndexY + numberOfTilesY_;
+  };
+
+  // The ring buffer slot of a tile does not change, only the tiles that enter the map are cleared
+  for (long tx = originTileIndexX; tx < originTileIndexX + numberOfTilesX_; tx++) {
+    for (long ty = originTileIndexY; ty < originTileIndexY + numberOfTilesY_; ty++) {
+      if (!isKept(tx, ty)) {
+        clearTile(tiles_[positiveModulo(ty, numberOfTilesY_)*numberOfTilesX_ + positiveModulo(tx, numberOfTilesX_)]);
+      }
+    }
+  }
+  originTileIndexX_ = originTileIndexX;
+  originTileIndexY_ = originTileIndexY;
+
+  // The normals only change in the tiles at the boundary between kept and cleared tiles,
+  // and at the border of the map, where the neighbors are clamped now.
+  for (long tx = originTileIndexX; tx < originTileIndexX + numberOfTilesX_; tx++) {
+    for (long ty = originTileIndexY; ty < originTileIndexY + numberOfTilesY_; ty++) {
+      const bool isTileKept = isKept(tx, ty);
+      bool hasChangedNeighbor = false;
+      for (long nx = tx - 1; nx <= tx + 1 && !hasChangedNeighbor; nx++) {
+        for (long ny = ty - 1; ny <= ty + 1 && !hasChangedNeighbor; ny++) {
+          hasChangedNeighbor = (isKept(nx, ny) != isTileKept);
+        }
+      }
+      if (hasChangedNeighbor) {
+        updateNormals(tx*tileSize, tx*tileSize + tileSize - 1, ty*tileSize, ty*tileSize + tileSize - 1);
+      }
+    }
+  }
+}
+
+
+bool TerrainModelHeightMap::addFootholdMeasurement(const loco::Position& positionWorldToFootholdInWorldFrame) {
+  if (!isInside(positionWorldToFootholdInWorldFrame)) {
+    return false;
+  }
+
+  const double x = positionWorldToFootholdInWorldFrame.x();
+  const double y = positionWorldToFootholdInWorldFrame.y();
+  const long iCenter = std::lround(x/resolution_);
+  const long jCenter = std::lround(y/resolution_);
+  const long iMin = clampCellIndexX(getCellIndexX(x - footRadius_));
+  const long iMax = clampCellIndexX(getCellIndexX(x + footRadius_) + 1);
+  const long jMin = clampCellIndexY(getCellIndexY(y - footRadius_));
+  const long jMax = clampCellIndexY(getCellIndexY(y + footRadius_) + 1);
+
+  for (long i = iMin; i <= iMax; i++) {
+    for (long j = jMin; j <= jMax; j++) {
+      const double dx = i*resolution_ - x;
+      const double dy = j*resolution_ - y;
+      if (dx*dx + dy*dy > footRadius_*footRadius_ && !(i == iCenter && j == jCenter)) {
+        continue;
+      }
+      float& height = getTile(i, j).height_[getCellOffset(i, j)];
+      height += footholdFilterGain_*(positionWorldToFootholdInWorldFrame.z() - height);
+    }
+  }
+  updateNormals(iMin - 1, iMax + 1, jMin - 1, jMax + 1);
+
+  return true;
+}
+
+
+bool TerrainModelHeightMap::setHeight(const loco::Position& positionWorldToLocationInWorldFrame, double heightInWorldFrame) {
+  const long i = std::lround(positionWorldToLocationInWorldFrame.x()/resolution_);
+  const long j = std::lround(positionWorldToLocationInWorldFrame.y()/resolution_);
+  if (!isCellInside(i, j)) {
+    return false;
+  }
+  getTile(i, j).height_[getCellOffset(i, j)] = heightInWorldFrame;
+  updateNormals(i - 1, i + 1, j - 1, j + 1);
+  return true;
+}
+
+
+bool TerrainModelHeightMap::setFrictionCoefficient(const loco::Position& positionWorldToLocationInWorldFrame, double frictionCoefficient) {
+  const long i = std::lround(positionWorldToLocationInWorldFrame.x()/resolution_);
+  const long j = std::lround(positionWorldToLocationInWorldFrame.y()/resolution_);
+  if (!isCellInside(i, j)) {
+    return false;
+  }
+  getTile(i, j).friction_[getCellOffset(i, j)] = frictionCoefficient;
+  return true;
+}
+
+
+bool TerrainModelHeightMap::loadFromFile(const std::string& filename) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    printf("Could not open height map %s!\n", filename.c_str());
+    return false;
+  }
+  struct stat fileStatus;
+  if (fstat(fd, &fileStatus) != 0 || fileStatus.st_size < static_cast<off_t>(sizeof(HeightMapFileHeader))) {
+    printf("Height map %s is too small!\n", filename.c_str());
+    ::close(fd);
+    return false;
+  }
+  const size_t size = fileStatus.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    printf("Could not map height map %s!\n", filename.c_str());
+    return false;
+  }
+
+  const HeightMapFileHeader* header = static_cast<const HeightMapFileHeader*>(data);
+  const size_t numberOfCells = static_cast<size_t>(header->numberOfCellsX_)*header->numberOfCellsY_;
+  const size_t expectedSize = sizeof(HeightMapFileHeader) + (header->hasFriction_ ? 2 : 1)*numberOfCells*sizeof(float);
+  if (std::memcmp(header->magic_, magic, sizeof(magic)) != 0 || header->version_ != fileVersion
+      || header->resolution_ <= 0.0 || numberOfCells == 0 || size != expectedSize) {
+    printf("Height map %s is invalid!\n", filename.c_str());
+    munmap(data, size);
+    return false;
+  }
+
+  // Resize the local map such that it covers all cells of the file
+  const long originCellIndexX = header->originCellIndexX_;
+  const long originCellIndexY = header->originCellIndexY_;
+  const long numberOfCellsX = header->numberOfCellsX_;
+  const long numberOfCellsY = header->numberOfCellsY_;
+  const long firstTileX = floorDivide(originCellIndexX, tileSize);
+  const long firstTileY = floorDivide(originCellIndexY, tileSize);
+  resolution_ = header->resolution_;
+  resize(floorDivide(originCellIndexX + numberOfCellsX - 1, tileSize) - firstTileX + 1,
+         floorDivide(originCellIndexY + numberOfCellsY - 1, tileSize) - firstTileY + 1);
+  originTileIndexX_ = firstTileX;
+  originTileIndexY_ = firstTileY;
+
+  const float* heights = reinterpret_cast<const float*>(header + 1);
+  const float* frictions = header->hasFriction_ ? heights + numberOfCells : nullptr;
+  for (long jFile = 0; jFile < numberOfCellsY; jFile++) {
+    for (long iFile = 0; iFile < numberOfCellsX; iFile++) {
+      const long i = originCellIndexX + iFile;
+      const long j = originCellIndexY + jFile;
+      Tile& tile = getTile(i, j);
+      const int offset = getCellOffset(i, j);
+      const size_t index = jFile*numberOfCellsX + iFile;
+      tile.height_[offset] = heights[index];
+      if (frictions != nullptr) {
+        tile.friction_[offset] = frictions[index];
+      }
+    }
+  }
+  munmap(data, size);
+
+  const long iMin = originTileIndexX_*tileSize;
+  const long jMin = originTileIndexY_*tileSize;
+  updateNormals(iMin, iMin + numberOfTilesX_*tileSize - 1, jMin, jMin + numberOfTilesY_*tileSize - 1);
+  isMapLoaded_ = true;
+
+  return true;
+}
+
+
+bool TerrainModelHeightMap::saveToFile(const std::string& filename) const {
+  HeightMapFileHeader header;
+  std::memcpy(header.magic_, magic, sizeof(magic));
+  header.version_ = fileVersion;
+  header.numberOfCellsX_ = getNumberOfCellsX();
+  header.numberOfCellsY_ = getNumberOfCellsY();
+  header.hasFriction_ = 1;
+  header.resolution_ = resolution_;
+  header.originCellIndexX_ = originTileIndexX_*tileSize;
+  header.originCellIndexY_ = originTileIndexY_*tileSize;
+
+  const size_t numberOfCells = static_cast<size_t>(header.numberOfCellsX_)*header.numberOfCellsY_;
+  std::vector<float> heights(numberOfCells);
+  std::vector<float> frictions(numberOfCells);
+  for (long jFile = 0; jFile < header.numberOfCellsY_; jFile++) {
+    for (long iFile = 0; iFile < header.numberOfCellsX_; iFile++) {
+      const long i = header.originCellIndexX_ + iFile;
+      const long j = header.originCellIndexY_ + jFile;
+      const Tile& tile = getTile(i, j);
+      const int offset = getCellOffset(i, j);
+      heights[jFile*header.numberOfCellsX_ + iFile] = tile.height_[offset];
+      frictions[jFile*header.numberOfCellsX_ + iFile] = tile.friction_[offset];
+    }
+  }
+
+  FILE* file = fopen(filename.c_str(), "wb");
+  if (file == nullptr) {
+    printf("Could not write height map %s!\n", filename.c_str());
+    return false;
+  }
+  const bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1
+                      && fwrite(heights.data(), sizeof(float), numberOfCells, file) == numberOfCells
+                      && fwrite(frictions.data(), sizeof(float), numberOfCells, file) == numberOfCells;
+  if (fclose(file) != 0 || !isWritten) {
+    printf("Could not write height map %s!\n", filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+
+bool TerrainModelHeightMap::isInside(const loco::Position& positionWorldToLocationInWorldFrame) const {
+  return isCellInside(getCellIndexX(positionWorldToLocationInWorldFrame.x()), getCellIndexY(positionWorldToLocationInWorldFrame.y()));
+}
+
+
+void TerrainModelHeightMap::setInterpolationMethod(InterpolationMethod method) {
+  interpolationMethod_ = method;
+}
+
+
+TerrainModelHeightMap::InterpolationMethod TerrainModelHeightMap::getInterpolationMethod() const {
+  return interpolationMethod_;
+}
+
+
+void TerrainModelHeightMap::setDefaultHeight(double height) {
+  defaultHeight_ = height;
+}
+
+
+double TerrainModelHeightMap::getDefaultHeight() const {
+  return defaultHeight_;
+}
+
+
+void TerrainModelHeightMap::setDefaultFrictionCoefficient(double frictionCoefficient) {
+  defaultFrictionCoefficient_ = frictionCoefficient;
+}
+
+
+double TerrainModelHeightMap::getDefaultFrictionCoefficient() const {
+  return defaultFrictionCoefficient_;
+}
+
+
+void TerrainModelHeightMap::setFootholdUpdateParameters(double footRadius, double filterGain) {
+  footRadius_ = footRadius;
+  footholdFilterGain_ = filterGain;
+}
+
+
+double TerrainModelHeightMap::getResolution() const {
+  return resolution_;
+}
+
+
+int TerrainModelHeightMap::getNumberOfCellsX() const {
+  return numberOfTilesX_*tileSize;
+}
+
+
+int TerrainModelHeightMap::getNumberOfCellsY() const {
+  return numberOfTilesY_*tileSize;
+}
+
+
+void TerrainModelHeightMap::resize(int numberOfTilesX, int numberOfTilesY) {
+  numberOfTilesX_ = std::max(numberOfTilesX, 1);
+  numberOfTilesY_ = std::max(numberOfTilesY, 1);
+  tiles_.resize(numberOfTilesX_*numberOfTilesY_);
+  for (Tile& tile : tiles_) {
+    clearTile(tile);
+  }
+}
+
+
+void TerrainModelHeightMap::clearTile(Tile& tile) {
+  std::fill(tile.height_, tile.height_ + tileSize*tileSize, static_cast<float>(defaultHeight_));
+  std::fill(tile.normalX_, tile.normalX_ + tileSize*tileSize, 0.0f);
+  std::fill(tile.normalY_, tile.normalY_ + tileSize*tileSize, 0.0f);
+  std::fill(tile.normalZ_, tile.normalZ_ + tileSize*tileSize, 1.0f);
+  std::fill(tile.friction_, tile.friction_ + tileSize*tileSize, static_cast<float>(defaultFrictionCoefficient_));
+}
+
+
+long TerrainModelHeightMap::getCellIndexX(double x) const {
+  return static_cast<long>(std::floor(x/resolution_));
+}
+
+
+long TerrainModelHeightMap::getCellIndexY(double y) const {
+  return static_cast<long>(std::floor(y/resolution_));
+}
+
+
+bool TerrainModelHeightMap::isCellInside(long i, long j) const {
+  const long iMin = originTileIndexX_*tileSize;
+  const long jMin = originTileIndexY_*tileSize;
+  return i >= iMin && i < iMin + getNumberOfCellsX() && j >= jMin && j < jMin + getNumberOfCellsY();
+}
+
+
+long TerrainModelHeightMap::clampCellIndexX(long i) const {
+  const long iMin = originTileIndexX_*tileSize;
+  return std::min(std::max(i, iMin), iMin + getNumberOfCellsX() - 1);
+}
+
+
+long TerrainModelHeightMap::clampCellIndexY(long j) const {
+  const long jMin = originTileIndexY_*tileSize;
+  return std::min(std::max(j, jMin), jMin + getNumberOfCellsY() - 1);
+}
+
+
+TerrainModelHeightMap::Tile& TerrainModelHeightMap::getTile(long i, long j) {
+  return tiles_[positiveModulo(floorDivide(j, tileSize), numberOfTilesY_)*numberOfTilesX_
+                + positiveModulo(floorDivide(i, tileSize), numberOfTilesX_)];
+}
+
+
+const TerrainModelHeightMap::Tile& TerrainModelHeightMap::getTile(long i, long j) const {
+  return tiles_[positiveModulo(floorDivide(j, tileSize), numberOfTilesY_)*numberOfTilesX_
+                + positiveModulo(floorDivide(i, tileSize), numberOfTilesX_)];
+}
+
+
+int TerrainModelHeightMap::getCellOffset(long i, long j) const {
+  return positiveModulo(j, tileSize)*tileSize + positiveModulo(i, tileSize);
+}
+
+
+double TerrainModelHeightMap::getCellHeight(long i, long j) const {
+  i = clampCellIndexX(i);
+  j = clampCellIndexY(j);
+  return getTile(i, j).height_[getCellOffset(i, j)];
+}
+
+
+void TerrainModelHeightMap::updateNormals(long iMin, long iMax, long jMin, long jMax) {
+  iMin = clampCellIndexX(iMin);
+  iMax = clampCellIndexX(iMax);
+  jMin = clampCellIndexY(jMin);
+  jMax = clampCellIndexY(jMax);
+
+  for (long j = jMin; j <= jMax; j++) {
+    for (long i = iMin; i <= iMax; i++) {
+      const double dzdx = (getCellHeight(i + 1, j) - getCellHeight(i - 1, j))/(2.0*resolution_);
+      const double dzdy = (getCellHeight(i, j + 1) - getCellHeight(i, j - 1))/(2.0*resolution_);
+      const double norm = std::sqrt(dzdx*dzdx + dzdy*dzdy + 1.0);
+      Tile& tile = getTile(i, j);
+      const int offset = getCellOffset(i, j);
+      tile.normalX_[offset] = -dzdx/norm;
+      tile.normalY_[offset] = -dzdy/norm;
+      tile.normalZ_[offset] = 1.0/norm;
+    }
+  }
+}
+
+
+double TerrainModelHeightMap::getHeightBilinear(double x, double y) const {
+  const long i = static_cast<long>(std::floor(x));
+  const long j = static_cast<long>(std::floor(y));
+  const double tx = x - i;
+  const double ty = y - j;
+  const double h0 = (1.0 - tx)*getCellHeight(i, j) + tx*getCellHeight(i + 1, j);
+  const double h1 = (1.0 - tx)*getCellHeight(i, j + 1) + tx*getCellHeight(i + 1, j + 1);
+  return (1.0 - ty)*h0 + ty*h1;
+}
+
+
+double TerrainModelHeightMap::getHeightBicubic(double x, double y) const {
+  const long i = static_cast<long>(std::floor(x));
+  const long j = static_cast<long>(std::floor(y));
+  const double tx = x - i;
+  const double ty = y - j;
+  double rows[4];
+  for (int l = 0; l < 4; l++) {
+    const long jl = j - 1 + l;
+    rows[l] = interpolateCubic(getCellHeight(i - 1, jl), getCellHeight(i, jl), getCellHeight(i + 1, jl), getCellHeight(i + 2, jl), tx);
+  }
+  return interpolateCubic(rows[0], rows[1], rows[2], rows[3], ty);
+}
+
+
+void TerrainModelHeightMap::getTangentPlane(const Position& positionInWorldFrame, Position& pointOnPlane, Vector& normal) const {
+  pointOnPlane = positionInWorldFrame;
+  TerrainModelHeightMap::getHeight(pointOnPlane);
+  TerrainModelHeightMap::getNormal(positionInWorldFrame, normal);
+}
+
+} /* namespace loco */
@@ -106,4 +106,25 @@ double TerrainModelHorizontalPlane::getDistanceFromSurfaceAlongSurfaceNormalToPo
 }
 
 
+bool TerrainModelHorizontalPlane::getHeights(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<double>& heightsInWorldFrame) const {
+  heightsInWorldFrame.assign(positionsWorldToLocationInWorldFrame.size(), heightInWorldFrame_);
+  return true;
+}
+
+
+bool TerrainModelHorizontalPlane::getNormals(const std::vector<Position>& positionsWorldToLocationInWorldFrame, std::vector<Vector>& normalsInWorldFrame) const {
+  normalsInWorldFrame.assign(positionsWorldToLocationInWorldFrame.size(), normalInWorldFrame_);
+  return true;
+}
+
+
+bool TerrainModelHorizontalPlane::getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const std::vector<Position>& positionsInWorldFrame, std::vector<Position>& projectedPositionsInWorldFrame) const {
+  projectedPositionsInWorldFrame = positionsInWorldFrame;
+  for (auto& position : projectedPositionsInWorldFrame) {
+    position.z() = heightInWorldFrame_;
+  }
+  return true;
+}
+
+
 } /* namespace loco */
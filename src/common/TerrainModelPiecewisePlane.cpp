@@ -0,0 +1,214 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainModelPiecewisePlane.cpp
+ */
+
+#include "loco/common/TerrainModelPiecewisePlane.hpp"
+
+#include <cmath>
+
+namespace loco {
+
+TerrainModelPiecewisePlane::TerrainModelPiecewisePlane(double regionSize, int maximumNumberOfPlanes) :
+    TerrainModelBase(),
+    regionSize_(regionSize),
+    frictionCoefficientBetweenTerrainAndFoot_(0.6),
+    defaultPlane_(Eigen::Vector3d::Zero())
+{
+  setMaximumNumberOfPlanes(maximumNumberOfPlanes);
+} // constructor
+
+
+TerrainModelPiecewisePlane::~TerrainModelPiecewisePlane() {
+
+} // destructor
+
+
+bool TerrainModelPiecewisePlane::initialize(double /*dt*/) {
+  planeSlots_.clear();
+  defaultPlane_.setZero();
+  frictionCoefficientBetweenTerrainAndFoot_ = 0.6;
+  return true;
+} // initialize
+
+
+bool TerrainModelPiecewisePlane::getNormal(const loco::Position& positionWorldToLocationInWorldFrame, loco::Vector& normalInWorldFrame) const {
+  bool isLocalPlane;
+  const Eigen::Vector3d& plane = getPlane(positionWorldToLocationInWorldFrame, isLocalPlane);
+  normalInWorldFrame = loco::Vector(Eigen::Vector3d(plane(0), plane(1), 1.0).normalized());
+  return isLocalPlane;
+} // get normal
+
+
+bool TerrainModelPiecewisePlane::getHeight(loco::Position& positionWorldToLocationInWorldFrame) const {
+  double height;
+  const bool isLocalPlane = getHeight(positionWorldToLocationInWorldFrame, height);
+  positionWorldToLocationInWorldFrame.z() = height;
+  return isLocalPlane;
+} // get height at position, update position
+
+
+bool TerrainModelPiecewisePlane::getHeight(const loco::Position& positionWorldToLocationInWorldFrame, double& heightInWorldFrame) const {
+  bool isLocalPlane;
+  const Eigen::Vector3d& plane = getPlane(positionWorldToLocationInWorldFrame, isLocalPlane);
+  heightInWorldFrame = plane(2) - plane(0)*positionWorldToLocationInWorldFrame.x() - plane(1)*positionWorldToLocationInWorldFrame.y();
+  return isLocalPlane;
+} // get height at position, return height
+
+
+bool TerrainModelPiecewisePlane::getFrictionCoefficientForFoot(const loco::Position& /*positionWorldToLocationInWorldFrame*/, double& frictionCoefficient) const {
+  frictionCoefficient = frictionCoefficientBetweenTerrainAndFoot_;
+  return true;
+} // get friction
+
+
+Position TerrainModelPiecewisePlane::getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(const Position& positionInWorldFrame) const {
+  bool isLocalPlane;
+  const Eigen::Vector3d& plane = getPlane(positionInWorldFrame, isLocalPlane);
+  const Eigen::Vector3d normal = Eigen::Vector3d(plane(0), plane(1), 1.0).normalized();
+  const Eigen::Vector3d pointOnPlane(0.0, 0.0, plane(2));
+  const double signedDistance = normal.dot(positionInWorldFrame.toImplementation() - pointOnPlane);
+  return Position(positionInWorldFrame.toImplementation() - signedDistance*normal);
+}
+
+
+double TerrainModelPiecewisePlane::getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(const Position& positionInWorldFrame) const {
+  bool isLocalPlane;
+  const Eigen::Vector3d& plane = getPlane(positionInWorldFrame, isLocalPlane);
+  const Eigen::Vector3d normal = Eigen::Vector3d(plane(0), plane(1), 1.0).normalized();
+  const Eigen::Vector3d pointOnPlane(0.0, 0.0, plane(2));
+  return std::fabs(normal.dot(positionInWorldFrame.toImplementation() - pointOnPlane));
+}
+
+
+bool TerrainModelPiecewisePlane::setPlane(long i, long j, const Eigen::Vector3d& parameters) {
+  const int slot = planeSlots_.insert(getRegionKey(i, j));
+  if (slot < 0) {
+    return false;
+  }
+  planes_[slot] = parameters;
+  return true;
+}
+
+
+void TerrainModelPiecewisePlane::removePlane(long i, long j) {
+  planeSlots_.erase(getRegionKey(i, j));
+}
+
+
+void TerrainModelPiecewisePlane::clearPlanes() {
+  planeSlots_.clear();
+}
+
+
+void TerrainModelPiecewisePlane::setMaximumNumberOfPlanes(int maximumNumberOfPlanes) {
+  planeSlots_.setCapacity(maximumNumberOfPlanes);
+  planes_.resize(planeSlots_.getCapacity());
+}
+
+
+void TerrainModelPiecewisePlane::setDefaultPlane(const Eigen::Vector3d& parameters) {
+  defaultPlane_ = parameters;
+}
+
+
+void TerrainModelPiecewisePlane::setFrictionCoefficient(double frictionCoefficient) {
+  frictionCoefficientBetweenTerrainAndFoot_ = frictionCoefficient;
+}
+
+
+long TerrainModelPiecewisePlane::getRegionIndex(double coordinate) const {
+  return static_cast<long>(std::floor(coordinate/regionSize_));
+}
+
+
+int64_t TerrainModelPiecewisePlane::getRegionKey(long i, long j) {
+  return (static_cast<int64_t>(i) << 32) ^ (static_cast<int64_t>(j) & 0xffffffff);
+}
+
+
+double TerrainModelPiecewisePlane::getRegionSize() const {
+  return regionSize_;
+}
+
+
+int TerrainModelPiecewisePlane::getNumberOfPlanes() const {
+  return planeSlots_.size();
+}
+
+
+int TerrainModelPiecewisePlane::getMaximumNumberOfPlanes() const {
+  return planeSlots_.getCapacity();
+}
+
+
+const Eigen::Vector3d& TerrainModelPiecewisePlane::getPlane(const Position& positionInWorldFrame, bool& isLocalPlane) const {
+  const long i = getRegionIndex(positionInWorldFrame.x());
+  const long j = getRegionIndex(positionInWorldFrame.y());
+
+  isLocalPlane = true;
+  const int slot = planeSlots_.find(getRegionKey(i, j));
+  if (slot >= 0) {
+    return planes_[slot];
+  }
+
+  // Closest neighbor with respect to the center of the region
+  const Eigen::Vector3d* closestPlane = nullptr;
+  double closestSquaredDistance = 0.0;
+  for (long di = -1; di <= 1; di++) {
+    for (long dj = -1; dj <= 1; dj++) {
+      const int neighborSlot = planeSlots_.find(getRegionKey(i + di, j + dj));
+      if (neighborSlot < 0) {
+        continue;
+      }
+      const double dx = (i + di + 0.5)*regionSize_ - positionInWorldFrame.x();
+      const double dy = (j + dj + 0.5)*regionSize_ - positionInWorldFrame.y();
+      const double squaredDistance = dx*dx + dy*dy;
+      if (closestPlane == nullptr || squaredDistance < closestSquaredDistance) {
+        closestPlane = &planes_[neighborSlot];
+        closestSquaredDistance = squaredDistance;
+      }
+    }
+  }
+  if (closestPlane != nullptr) {
+    return *closestPlane;
+  }
+
+  isLocalPlane = false;
+  return defaultPlane_;
+}
+
+} /* namespace loco */
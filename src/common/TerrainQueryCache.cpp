@@ -0,0 +1,136 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainQueryCache.cpp
+ */
+
+#include "loco/common/TerrainQueryCache.hpp"
+
+#include <cstdio>
+
+namespace loco {
+
+TerrainQueryCache::TerrainQueryCache(LegGroup* legs, TerrainModelBase* terrain) :
+    legs_(legs),
+    terrain_(terrain),
+    isValid_(false)
+{
+
+}
+
+
+TerrainQueryCache::~TerrainQueryCache() {
+
+}
+
+
+bool TerrainQueryCache::update() {
+  isValid_ = false;
+  if (legs_ == nullptr || terrain_ == nullptr) {
+    return false;
+  }
+
+  const size_t numberOfLegs = legs_->size();
+  positionsWorldToFootInWorldFrame_.resize(numberOfLegs);
+  positionsWorldToHipInWorldFrame_.resize(numberOfLegs);
+  frictionCoefficientsAtFoot_.resize(numberOfLegs);
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    if (legId < 0 || legId >= static_cast<int>(numberOfLegs)) {
+      printf("TerrainQueryCache: leg id %d is out of range!\n", legId);
+      return false;
+    }
+    positionsWorldToFootInWorldFrame_[legId] = leg->getPositionWorldToFootInWorldFrame();
+    positionsWorldToHipInWorldFrame_[legId] = leg->getPositionWorldToHipInWorldFrame();
+  }
+
+  bool isSuccessful = true;
+  isSuccessful &= terrain_->getHeights(positionsWorldToFootInWorldFrame_, heightsAtFootInWorldFrame_);
+  isSuccessful &= terrain_->getNormals(positionsWorldToFootInWorldFrame_, normalsAtFootInWorldFrame_);
+  isSuccessful &= terrain_->getHeights(positionsWorldToHipInWorldFrame_, heightsAtHipInWorldFrame_);
+  isSuccessful &= terrain_->getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(positionsWorldToHipInWorldFrame_,
+                                                                                      positionsWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_);
+  positionsWorldToHipOnTerrainAlongWorldZInWorldFrame_ = positionsWorldToHipInWorldFrame_;
+  for (size_t i = 0; i < numberOfLegs; i++) {
+    positionsWorldToHipOnTerrainAlongWorldZInWorldFrame_[i].z() = heightsAtHipInWorldFrame_[i];
+    isSuccessful &= terrain_->getFrictionCoefficientForFoot(positionsWorldToFootInWorldFrame_[i], frictionCoefficientsAtFoot_[i]);
+  }
+
+  // Points outside of the terrain model still get the (extrapolated) values, the stages decide how to handle them
+  isValid_ = true;
+  return isSuccessful;
+}
+
+
+void TerrainQueryCache::invalidate() {
+  isValid_ = false;
+}
+
+
+bool TerrainQueryCache::isValid() const {
+  return isValid_;
+}
+
+
+double TerrainQueryCache::getHeightAtFootInWorldFrame(int legId) const {
+  return heightsAtFootInWorldFrame_[legId];
+}
+
+
+const Vector& TerrainQueryCache::getNormalAtFootInWorldFrame(int legId) const {
+  return normalsAtFootInWorldFrame_[legId];
+}
+
+
+double TerrainQueryCache::getFrictionCoefficientAtFoot(int legId) const {
+  return frictionCoefficientsAtFoot_[legId];
+}
+
+
+const Position& TerrainQueryCache::getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(int legId) const {
+  return positionsWorldToHipOnTerrainAlongWorldZInWorldFrame_[legId];
+}
+
+
+const Position& TerrainQueryCache::getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(int legId) const {
+  return positionsWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_[legId];
+}
+
+
+TerrainModelBase* TerrainQueryCache::getTerrainModel() {
+  return terrain_;
+}
+
+} /* namespace loco */
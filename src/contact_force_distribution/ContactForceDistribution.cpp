@@ -58,6 +58,45 @@ using namespace Eigen;
 
 namespace loco {
 
+namespace {
+
+ParameterSchema<ContactForceDistributionParameters> createContactForceDistributionSchema() {
+  typedef ContactForceDistributionParameters P;
+  ParameterSchema<P> schema;
+  const char* forceDirections[3] = {"heading", "lateral", "vertical"};
+  const char* torqueDirections[3] = {"roll", "pitch", "yaw"};
+  for (int i=0; i<3; i++) {
+    schema.add("ContactForceDistribution/Weights/Force", forceDirections[i], &P::virtualForceWeights_, i);
+  }
+  for (int i=0; i<3; i++) {
+    schema.add("ContactForceDistribution/Weights/Torque", torqueDirections[i], &P::virtualForceWeights_, 3+i);
+  }
+  schema.add("ContactForceDistribution/Weights/Regularizer", "value", &P::groundForceWeight_);
+  schema.add("ContactForceDistribution/Constraints", "frictionCoefficient", &P::frictionCoefficient_);
+  schema.add("ContactForceDistribution/Constraints", "minimalNormalForce", &P::minimalNormalGroundForce_);
+  schema.add("ContactForceDistribution/LoadFactor", "loadFactor", &P::loadFactor_);
+  return schema;
+}
+
+} /* namespace */
+
+ContactForceDistributionParameters::ContactForceDistributionParameters() :
+    groundForceWeight_(0.0),
+    frictionCoefficient_(0.6),
+    minimalNormalGroundForce_(0.0),
+    loadFactor_(1.0)
+{
+  for (int i=0; i<6; i++) {
+    virtualForceWeights_[i] = 0.0;
+  }
+}
+
+const ParameterSchema<ContactForceDistributionParameters>& ContactForceDistributionParameters::getSchema() {
+  // Built once in a thread-safe static initialization since the parameters are also parsed on the loader thread.
+  static const ParameterSchema<ContactForceDistributionParameters> schema = createContactForceDistributionSchema();
+  return schema;
+}
+
 ContactForceDistribution::ContactForceDistribution(std::shared_ptr<TorsoBase> torso, std::shared_ptr<LegGroup> legs, std::shared_ptr<loco::TerrainModelBase> terrain)
     : ContactForceDistributionBase(torso, legs, terrain)
 {
@@ -149,6 +188,42 @@ bool ContactForceDistribution::prepareLegLoading()
     }
   }
 
+  return updateFootContactNormals();
+}
+
+bool ContactForceDistribution::updateFootContactNormals()
+{
+  if (terrainQueryCache_ != nullptr && terrainQueryCache_->isValid())
+  {
+    for (auto& legInfo : legInfos_)
+    {
+      if (legInfo.second.isPartOfForceDistribution_)
+      {
+        legInfo.second.footContactNormalInWorldFrame_ = terrainQueryCache_->getNormalAtFootInWorldFrame(legInfo.first->getId());
+      }
+    }
+    return true;
+  }
+
+  std::vector<Position> positionsWorldToFootInWorldFrame;
+  std::vector<Vector> footContactNormalsInWorldFrame;
+  for (auto& legInfo : legInfos_)
+  {
+    if (legInfo.second.isPartOfForceDistribution_)
+    {
+      positionsWorldToFootInWorldFrame.push_back(legInfo.first->getPositionWorldToFootInWorldFrame());
+    }
+  }
+  terrain_->getNormals(positionsWorldToFootInWorldFrame, footContactNormalsInWorldFrame);
+
+  int index = 0;
+  for (auto& legInfo : legInfos_)
+  {
+    if (legInfo.second.isPartOfForceDistribution_)
+    {
+      legInfo.second.footContactNormalInWorldFrame_ = footContactNormalsInWorldFrame[index++];
+    }
+  }
   return true;
 }
 
@@ -165,8 +240,6 @@ bool ContactForceDistribution::prepareOptimization(
   b_.segment(0, virtualForce.toImplementation().size()) = virtualForce.toImplementation();
   b_.segment(virtualForce.toImplementation().size(), virtualTorque.toImplementation().size()) = virtualTorque.toImplementation();
 
-  S_ = virtualForceWeights_.asDiagonal();
-
   A_.resize(nElementsVirtualForceTorqueVector_, n_);
   A_.setZero();
   A_.middleRows(0, nTranslationalDofPerFoot_) = (Matrix3d::Identity().replicate(1, nLegsInForceDistribution_)).sparseView();
@@ -184,7 +257,7 @@ bool ContactForceDistribution::prepareOptimization(
   A_.middleRows(nTranslationalDofPerFoot_, A_bottomMatrix.rows()) = A_bottomMatrix.sparseView();
 
   W_.setIdentity(nTranslationalDofPerFoot_ * nLegsInForceDistribution_);
-  W_ = W_ * groundForceWeight_;
+  W_ = W_ * parameters_.groundForceWeight_;
 
   return true;
 }
@@ -209,16 +282,14 @@ bool ContactForceDistribution::addMinimalForceConstraints()
   {
     if (legInfo.second.isPartOfForceDistribution_)
     {
-      Position positionWorldToFootInWorldFrame = legInfo.first->getPositionWorldToFootInWorldFrame();
-      Vector footContactNormalInWorldFrame;
-      terrain_->getNormal(positionWorldToFootInWorldFrame, footContactNormalInWorldFrame);
+      const Vector& footContactNormalInWorldFrame = legInfo.second.footContactNormalInWorldFrame_;
       Vector footContactNormalInBaseFrame = orientationWorldToBase.rotate(footContactNormalInWorldFrame);
 
       MatrixXd D_row = MatrixXd::Zero(1, n_);
       D_row.block(0, legInfo.second.startIndexInVectorX_, 1, nTranslationalDofPerFoot_)
         = footContactNormalInBaseFrame.toImplementation().transpose();
       D_.middleRows(rowIndex, 1) = D_row.sparseView();
-      d_(rowIndex) = minimalNormalGroundForce_;
+      d_(rowIndex) = parameters_.minimalNormalGroundForce_;
       f_(rowIndex) = std::numeric_limits<double>::max();
       rowIndex++;
     }
@@ -255,9 +326,7 @@ bool ContactForceDistribution::addFrictionConstraints()
       MatrixXd D_rows = MatrixXd::Zero(nDirections, n_);
 
 
-      Position positionWorldToFootInWorldFrame = legInfo.first->getPositionWorldToFootInWorldFrame();
-      Vector footContactNormalInWorldFrame;
-      terrain_->getNormal(positionWorldToFootInWorldFrame, footContactNormalInWorldFrame);
+      const Vector& footContactNormalInWorldFrame = legInfo.second.footContactNormalInWorldFrame_;
       Vector footContactNormalInBaseFrame = orientationWorldToBase.rotate(footContactNormalInWorldFrame);
 
 //      const Vector3d& normalDirection = legInfo.first->getFootContactNormalInWorldFrame().toImplementation();
@@ -474,14 +543,18 @@ bool ContactForceDistribution::updateLoggerData()
 }
 
 double ContactForceDistribution::getGroundForceWeight() const {
-  return groundForceWeight_;
+  return parameters_.groundForceWeight_;
 }
 
 double ContactForceDistribution::getMinimalNormalGroundForce() const {
-  return minimalNormalGroundForce_;
+  return parameters_.minimalNormalGroundForce_;
 }
 double ContactForceDistribution::getVirtualForceWeight(int index) const {
-  return virtualForceWeights_(index);
+  return parameters_.virtualForceWeights_[index];
+}
+
+const ContactForceDistributionParameters& ContactForceDistribution::getParameters() const {
+  return parameters_;
 }
 
 const Vector& ContactForceDistribution::getFirstDirectionOfFrictionPyramidInWorldFrame(LegBase* leg) const {
@@ -512,6 +585,42 @@ const ContactForceDistribution::LegInfo& ContactForceDistribution::getLegInfo(Le
   return legInfos_.at(leg);
 }
 
+bool ContactForceDistribution::getGroundReactionForceInWorldFrame(LegBase* leg, Force& forceInWorldFrame) const {
+  if (!checkIfForceDistributionComputed()) {
+    return false;
+  }
+  auto legInfo = legInfos_.find(leg);
+  if (legInfo == legInfos_.end() || !legInfo->second.isPartOfForceDistribution_) {
+    return false;
+  }
+  // the desired contact force is the force of the leg on the ground (in base frame)
+  const Force groundReactionForceInBaseFrame = Force(-legInfo->second.desiredContactForce_);
+  forceInWorldFrame = torso_->getMeasuredState().getOrientationWorldToBase().inverseRotate(groundReactionForceInBaseFrame);
+  return true;
+}
+
+bool ContactForceDistribution::computeJointTorquesFromGroundReactionForces(const Force* groundReactionForcesInWorldFrame) {
+  if(!checkIfParametersLoaded()) return false;
+
+  resetOptimization();
+  prepareLegLoading();
+
+  const RotationQuaternion& orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+  for (auto& legInfo : legInfos_)
+  {
+    if (legInfo.second.isPartOfForceDistribution_)
+    {
+      // the desired contact force is the force of the leg on the ground (in base frame)
+      legInfo.second.desiredContactForce_ = Force(-orientationWorldToBase.rotate(groundReactionForcesInWorldFrame[legInfo.first->getId()]));
+    }
+  }
+  isForceDistributionComputed_ = true;
+  computeJointTorques();
+
+  if (isLogging_) updateLoggerData();
+  return isForceDistributionComputed_;
+}
+
 bool ContactForceDistribution::setToInterpolated(const ContactForceDistributionBase& contactForceDistribution1, const ContactForceDistributionBase& contactForceDistribution2, double t) {
   const ContactForceDistribution& distribution1 = static_cast<const ContactForceDistribution&>(contactForceDistribution1);
   const ContactForceDistribution& distribution2 = static_cast<const ContactForceDistribution&>(contactForceDistribution2);
@@ -528,118 +637,56 @@ bool ContactForceDistribution::setToInterpolated(const ContactForceDistributionB
     legInfos_.at(leg).frictionCoefficient_ = linearlyInterpolate(distribution1.getFrictionCoefficient(leg->getId()) , distribution2.getFrictionCoefficient(leg->getId()), 0.0, 1.0, t);
   }
 
-  this->groundForceWeight_ = linearlyInterpolate(distribution1.getGroundForceWeight(), distribution2.getGroundForceWeight(), 0.0, 1.0, t);
-  this->minimalNormalGroundForce_ = linearlyInterpolate(distribution1.getMinimalNormalGroundForce(), distribution2.getMinimalNormalGroundForce(), 0.0, 1.0, t);
+  parameters_.groundForceWeight_ = linearlyInterpolate(distribution1.getGroundForceWeight(), distribution2.getGroundForceWeight(), 0.0, 1.0, t);
+  parameters_.minimalNormalGroundForce_ = linearlyInterpolate(distribution1.getMinimalNormalGroundForce(), distribution2.getMinimalNormalGroundForce(), 0.0, 1.0, t);
+
+  for (int i=0; i<nElementsVirtualForceTorqueVector_; i++) {
+    parameters_.virtualForceWeights_[i] = linearlyInterpolate(distribution1.getVirtualForceWeight(i), distribution2.getVirtualForceWeight(i), 0.0, 1.0, t);
+  }
+  updateVirtualForceWeights();
+  return true;
+}
 
-  for (int i=0; i<(int)this->virtualForceWeights_.size(); i++) {
-    this->virtualForceWeights_(i) = linearlyInterpolate(distribution1.getVirtualForceWeight(i), distribution2.getVirtualForceWeight(i), 0.0, 1.0, t);
+bool ContactForceDistribution::addParametersToVector(ParameterVector* parameterVector) {
+  std::vector<double*> parameters;
+  for (auto leg : *legs_) {
+    parameters.push_back(&legInfos_.at(leg).frictionCoefficient_);
   }
+  parameters.push_back(&parameters_.groundForceWeight_);
+  parameters.push_back(&parameters_.minimalNormalGroundForce_);
+  for (int i=0; i<nElementsVirtualForceTorqueVector_; i++) {
+    parameters.push_back(&parameters_.virtualForceWeights_[i]);
+  }
+  parameterVector->addSlice("ContactForceDistribution", parameters, std::bind(&ContactForceDistribution::updateVirtualForceWeights, this));
   return true;
 }
 
+void ContactForceDistribution::updateVirtualForceWeights() {
+  S_ = Eigen::Map<const Eigen::Matrix<double, nElementsVirtualForceTorqueVector_, 1> >(parameters_.virtualForceWeights_).asDiagonal();
+}
+
 
 bool ContactForceDistribution::loadParameters(const TiXmlHandle& handle)
 {
   isParametersLoaded_ = false;
 
-  TiXmlElement* element = handle.FirstChild("ContactForceDistribution").ToElement();
-  if (!element) {
+  if (!handle.FirstChild("ContactForceDistribution").Element()) {
     printf("Could not find ContactForceDistribution\n");
     return false;
   }
-  TiXmlHandle forceDistributionHandle(handle.FirstChild("ContactForceDistribution"));
-
-  // Weights
-  element = forceDistributionHandle.FirstChild("Weights").Element();
-  if (!element) {
-    printf("Could not find ContactForceDistribution:Weights\n");
-    return false;
-  }
-  TiXmlHandle weightsHandle(handle.FirstChild("ContactForceDistribution").FirstChild("Weights"));
-
-  // Virtual force weights
-  element = weightsHandle.FirstChild("Force").Element();
-  if (!element) {
-    printf("Could not find ContactForceDistribution:Weights:Force!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("heading", &virtualForceWeights_(0))!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Force:heading!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("lateral", &virtualForceWeights_(1))!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Force:lateral!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("vertical", &virtualForceWeights_(2))!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Force:vertical!\n");
-    return false;
-  }
-
-  // Virtual torque weights
-  element = weightsHandle.FirstChild("Torque").Element();
-  if (!element) {
-    printf("Could not find ContactForceDistribution:Weights:Torque!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("roll", &virtualForceWeights_(3))!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Torque:roll!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("pitch", &virtualForceWeights_(4))!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Torque:pitch!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("yaw", &virtualForceWeights_(5))!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Torque:yaw!\n");
-    return false;
-  }
-
-  // Regularizer
-  element = weightsHandle.FirstChild("Regularizer").Element();
-  if (!element) {
-    printf("Could not find ContactForceDistribution:Weights:Regularizer!\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("value", &groundForceWeight_)!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Weights:Regularizer:value!\n");
-    return false;
-  }
 
-  // Constraints
-  element = forceDistributionHandle.FirstChild("Constraints").Element();
-  if (!element) {
-    printf("Could not find ContactForceDistribution:Constraints\n");
-    return false;
-  }
-  double frictionCoefficient = 0.6;
-  if (element->QueryDoubleAttribute("frictionCoefficient", &frictionCoefficient)!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Constraints:frictionCoefficient!\n");
-    return false;
-  }
-  for (auto& legInfo : legInfos_) {
-    legInfo.second.frictionCoefficient_ = frictionCoefficient;
-  }
-  if (element->QueryDoubleAttribute("minimalNormalForce", &minimalNormalGroundForce_)!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:Constraints:minimalNormalForce!\n");
+  // parameters_ is left unchanged if the file is invalid
+  if (!ContactForceDistributionParameters::getSchema().parse(handle, parameters_)) {
     return false;
   }
 
-  // Load factor
-  element = forceDistributionHandle.FirstChild("LoadFactor").Element();
-  if (!element) {
-    printf("Could not find ContactForceDistribution:Constraints\n");
-    return false;
-  }
-  double loadFactor = 1.0;
-  if (element->QueryDoubleAttribute("loadFactor", &loadFactor)!=TIXML_SUCCESS) {
-    printf("Could not find ContactForceDistribution:LoadFactor:loadFactor!\n");
-    return false;
-  }
+  // the legs start with the same friction coefficient and load factor, which are adapted per leg afterwards
   for (auto& legInfo : legInfos_) {
-    legInfo.first->setDesiredLoadFactor(loadFactor);
+    legInfo.second.frictionCoefficient_ = parameters_.frictionCoefficient_;
+    legInfo.first->setDesiredLoadFactor(parameters_.loadFactor_);
   }
 
+  updateVirtualForceWeights();
 
   isParametersLoaded_ = true;
   return true;
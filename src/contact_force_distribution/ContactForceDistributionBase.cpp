@@ -48,7 +48,8 @@ namespace loco {
 ContactForceDistributionBase::ContactForceDistributionBase(std::shared_ptr<TorsoBase> torso, std::shared_ptr<LegGroup> legs, std::shared_ptr<loco::TerrainModelBase> terrain)
 : torso_(torso),
   legs_(legs),
-  terrain_(terrain)
+  terrain_(terrain),
+  terrainQueryCache_(nullptr)
 {
   isParametersLoaded_ = false;
   isLogging_ = false;
@@ -74,8 +75,24 @@ bool ContactForceDistributionBase::checkIfForceDistributionComputed() const
   return false;
 }
 
+void ContactForceDistributionBase::setTerrainQueryCache(const TerrainQueryCache* terrainQueryCache) {
+  terrainQueryCache_ = terrainQueryCache;
+}
+
+bool ContactForceDistributionBase::getGroundReactionForceInWorldFrame(LegBase* leg, Force& forceInWorldFrame) const {
+  return false;
+}
+
+bool ContactForceDistributionBase::computeJointTorquesFromGroundReactionForces(const Force* groundReactionForcesInWorldFrame) {
+  return false;
+}
+
 bool ContactForceDistributionBase::setToInterpolated(const ContactForceDistributionBase& contactForceDistribution1, const ContactForceDistributionBase& contactForceDistribution2, double t) {
   return false;
 }
 
+bool ContactForceDistributionBase::addParametersToVector(ParameterVector* parameterVector) {
+  return true;
+}
+
 } /* namespace loco */
@@ -46,7 +46,8 @@
 namespace loco  {
 
 FootPlacementStrategyBase::FootPlacementStrategyBase() :
-    isFirstTimeInit_(true)
+    isFirstTimeInit_(true),
+    terrainQueryCache_(nullptr)
 {
 
 }
@@ -60,6 +61,18 @@ bool FootPlacementStrategyBase::setToInterpolated(const FootPlacementStrategyBas
   return false;
 }
 
+bool FootPlacementStrategyBase::addParametersToVector(ParameterVector* parameterVector) {
+  return true;
+}
+
+void FootPlacementStrategyBase::setTerrainQueryCache(const TerrainQueryCache* terrainQueryCache) {
+  terrainQueryCache_ = terrainQueryCache;
+}
+
+bool FootPlacementStrategyBase::getPositionWorldToFootHoldInWorldFrame(int legId, Position& positionWorldToFootHoldInWorldFrame) const {
+  return false;
+}
+
 bool FootPlacementStrategyBase::goToStand() {
   return false;
 }
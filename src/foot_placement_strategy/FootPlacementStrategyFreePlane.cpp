@@ -49,7 +49,11 @@ namespace loco {
 
 FootPlacementStrategyFreePlane::FootPlacementStrategyFreePlane(LegGroup* legs, TorsoBase* torso, loco::TerrainModelBase* terrain) :
     FootPlacementStrategyInvertedPendulum(legs, torso, terrain),
-    telescopicLeverConfiguration_(0.0)
+    telescopicLeverConfiguration_(0.0),
+    footholdOptimizer_(nullptr),
+    footholdReoptimizationThreshold_(0.02),
+    swingFootClearancePlanner_(nullptr),
+    footstepPreviewPlanner_(nullptr)
 {
 
   for (auto leg : *legs_) {
@@ -59,7 +63,16 @@ FootPlacementStrategyFreePlane::FootPlacementStrategyFreePlane(LegGroup* legs, T
     positionDesiredFootHoldOnTerrainFeedForwardInControlFrame_[leg->getId()].setZero();
     positionDesiredFootHoldOnTerrainFeedBackInControlFrame_[leg->getId()].setZero();
     positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[leg->getId()].setZero();
+    positionWorldToNominalFootHoldInWorldFrame_[leg->getId()].setZero();
+    positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[leg->getId()].setZero();
+    isFootHoldOptimized_[leg->getId()] = false;
+    isFootHoldOptimizationDone_[leg->getId()] = false;
+    positionWorldToOptimizedNominalFootHoldInWorldFrame_[leg->getId()].setZero();
+    wasSupportLeg_[leg->getId()] = true;
   }
+  footholdOptimizationProblems_.reserve(legs_->size());
+  footholdOptimizationResults_.reserve(legs_->size());
+  footholdOptimizationLegIds_.reserve(legs_->size());
 
 }
 
@@ -69,6 +82,21 @@ FootPlacementStrategyFreePlane::~FootPlacementStrategyFreePlane() {
 }
 
 
+bool FootPlacementStrategyFreePlane::loadParameters(const TiXmlHandle& handle) {
+  if (!FootPlacementStrategyInvertedPendulum::loadParameters(handle)) {
+    return false;
+  }
+
+  /* optional: distance the nominal foot hold has to move before it is optimized again */
+  TiXmlElement* pElem = handle.FirstChild("FootPlacementStrategy").FirstChild("FootholdOptimizer").Element();
+  if (pElem) {
+    pElem->QueryDoubleAttribute("reoptimizationThreshold", &footholdReoptimizationThreshold_);
+  }
+
+  return true;
+}
+
+
 bool FootPlacementStrategyFreePlane::initialize(double dt) {
 
   FootPlacementStrategyInvertedPendulum::initialize(dt);
@@ -81,6 +109,10 @@ bool FootPlacementStrategyFreePlane::initialize(double dt) {
     positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[leg->getId()] = getPositionProjectedOnPlaneAlongSurfaceNormal(positionWorldToHipAtLiftOffInWorldFrame);
     Position positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame = positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[leg->getId()];
     leg->getStateLiftOff()->setPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame);
+    isSwingFootTrajectoryToBePlanned_[leg->getId()] = true;
+    positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[leg->getId()].setZero();
+    isFootHoldOptimized_[leg->getId()] = false;
+    isFootHoldOptimizationDone_[leg->getId()] = false;
   }
 
 
@@ -98,19 +130,22 @@ bool FootPlacementStrategyFreePlane::initialize(double dt) {
 
 bool FootPlacementStrategyFreePlane::advance(double dt) {
 
+  updateContext();
+
+  planFootsteps();
+  optimizeFootHolds();
+
   for (auto leg : *legs_) {
     // save the hip position at lift off for trajectory generation
     if (leg->shouldBeGrounded() ||
         (!leg->shouldBeGrounded() && leg->isGrounded() && leg->getSwingPhase() < 0.25)
     ) {
       // Project the hip at lift off along the normal to the plane that models the ground
-      Position positionWorldToHipAtLiftOffInWorldFrame = leg->getPositionWorldToHipInWorldFrame();
-      positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[leg->getId()] = getPositionProjectedOnPlaneAlongSurfaceNormal(positionWorldToHipAtLiftOffInWorldFrame);
+      positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[leg->getId()] = getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(*leg);
       Position positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame = positionWorldToHipOnTerrainAlongNormalAtLiftOffInWorldFrame_[leg->getId()];
 
       // Project the hip at lift off along the z axis in world frame
-      Position positionWorldToHipOnTerrainAlongWorldZInWorldFrame = positionWorldToHipAtLiftOffInWorldFrame;
-      terrain_->getHeight(positionWorldToHipOnTerrainAlongWorldZInWorldFrame);
+      Position positionWorldToHipOnTerrainAlongWorldZInWorldFrame = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(*leg);
 
       /*
        * WARNING: these were also updated by the event detector
@@ -119,8 +154,19 @@ bool FootPlacementStrategyFreePlane::advance(double dt) {
       leg->getStateLiftOff()->setPositionWorldToFootInWorldFrame(leg->getPositionWorldToFootInWorldFrame());
       leg->getStateLiftOff()->setPositionWorldToHipInWorldFrame(leg->getPositionWorldToHipInWorldFrame());
 //      leg->setSwingPhase(leg->getSwingPhase());
+
+      // the swing trajectory starts from the new lift-off state
+      isSwingFootTrajectoryToBePlanned_[leg->getId()] = true;
+      positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[leg->getId()].setZero();
+      isFootHoldOptimized_[leg->getId()] = false;
+      isFootHoldOptimizationDone_[leg->getId()] = false;
+      swingFootClearanceResults_[leg->getId()] = SwingFootClearanceResult();
     }
 
+    // the feedforward is only set while the foot tracks the swing trajectory
+    linearVelocityHipToDesiredFootInWorldFrame_[leg->getId()].setZero();
+    linearAccelerationHipToDesiredFootInWorldFrame_[leg->getId()].setZero();
+
     // Decide what to do based on the current state
     if (!leg->isSupportLeg()) {
       StateSwitcher* stateSwitcher = leg->getStateSwitcher();
@@ -139,27 +185,277 @@ bool FootPlacementStrategyFreePlane::advance(double dt) {
           break;
       }
     }
+    leg->setDesiredLinearVelocityHipToFootInWorldFrame(linearVelocityHipToDesiredFootInWorldFrame_[leg->getId()]);
+    leg->setDesiredLinearAccelerationHipToFootInWorldFrame(linearAccelerationHipToDesiredFootInWorldFrame_[leg->getId()]);
 
   }
 
+  invalidateContext();
   return true;
 }
 
 
+const FootPlacementContext& FootPlacementStrategyFreePlane::getContext() const {
+  return context_;
+}
+
+
+void FootPlacementStrategyFreePlane::updateContext() {
+  context_.isValid_ = false;
+
+  const TorsoStateMeasured& measuredState = torso_->getMeasuredState();
+  context_.orientationWorldToControl_ = measuredState.getOrientationWorldToControl();
+  context_.orientationWorldToBase_ = measuredState.getOrientationWorldToBase();
+  context_.linearVelocityBaseInWorldFrame_ = context_.orientationWorldToBase_.inverseRotate(measuredState.getLinearVelocityBaseInBaseFrame());
+
+  const LinearVelocity& linearVelocityDesiredInControlFrame = torso_->getDesiredState().getLinearVelocityBaseInControlFrame();
+  context_.linearVelocityDesiredHeadingInWorldFrame_ = context_.orientationWorldToControl_.inverseRotate(LinearVelocity(linearVelocityDesiredInControlFrame.x(), 0.0, 0.0));
+
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    context_.positionWorldToHipOnTerrainAlongWorldZInWorldFrame_[legId] = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(*leg);
+    context_.positionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_[legId] = getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(*leg);
+    context_.positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame_[legId] = (context_.positionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_[legId]
+                                                                                               - context_.positionWorldToHipOnTerrainAlongWorldZInWorldFrame_[legId])*telescopicLeverConfiguration_;
+    context_.normalAtFootInWorldFrame_[legId] = getNormalAtFootInWorldFrame(*leg);
+  }
+
+  context_.isValid_ = true;
+}
+
+
+void FootPlacementStrategyFreePlane::invalidateContext() {
+  context_.isValid_ = false;
+}
+
+
+const RotationQuaternion& FootPlacementStrategyFreePlane::getOrientationWorldToControl() const {
+  if (context_.isValid_) {
+    return context_.orientationWorldToControl_;
+  }
+  return torso_->getMeasuredState().getOrientationWorldToControl();
+}
+
+
+const RotationQuaternion& FootPlacementStrategyFreePlane::getOrientationWorldToBase() const {
+  if (context_.isValid_) {
+    return context_.orientationWorldToBase_;
+  }
+  return torso_->getMeasuredState().getOrientationWorldToBase();
+}
+
+
+Vector FootPlacementStrategyFreePlane::getNormalAtFootInWorldFrame(const LegBase& leg) {
+  if (context_.isValid_) {
+    return context_.normalAtFootInWorldFrame_[leg.getId()];
+  }
+  if (terrainQueryCache_ != nullptr && terrainQueryCache_->isValid()) {
+    return terrainQueryCache_->getNormalAtFootInWorldFrame(leg.getId());
+  }
+  Vector normalInWorldFrame = Vector::UnitZ();
+  terrain_->getNormal(leg.getPositionWorldToFootInWorldFrame(), normalInWorldFrame);
+  return normalInWorldFrame;
+}
+
+
+void FootPlacementStrategyFreePlane::setFootholdOptimizer(FootholdOptimizer* footholdOptimizer) {
+  footholdOptimizer_ = footholdOptimizer;
+}
+
+
+FootholdOptimizer* FootPlacementStrategyFreePlane::getFootholdOptimizer() {
+  return footholdOptimizer_;
+}
+
+
+void FootPlacementStrategyFreePlane::setFootholdReoptimizationThreshold(double threshold) {
+  footholdReoptimizationThreshold_ = threshold;
+}
+
+
+double FootPlacementStrategyFreePlane::getFootholdReoptimizationThreshold() const {
+  return footholdReoptimizationThreshold_;
+}
+
+
+void FootPlacementStrategyFreePlane::setSwingFootClearancePlanner(SwingFootClearancePlanner* swingFootClearancePlanner) {
+  swingFootClearancePlanner_ = swingFootClearancePlanner;
+}
+
+
+SwingFootClearancePlanner* FootPlacementStrategyFreePlane::getSwingFootClearancePlanner() {
+  return swingFootClearancePlanner_;
+}
+
+
+const SwingFootClearanceResult& FootPlacementStrategyFreePlane::getSwingFootClearance(const LegBase& leg) const {
+  return swingFootClearanceResults_[leg.getId()];
+}
+
+
+bool FootPlacementStrategyFreePlane::isSwingFootCollisionPredicted(const LegBase& leg) const {
+  return (swingFootClearancePlanner_ != nullptr && swingFootClearanceResults_[leg.getId()].isColliding_);
+}
+
+
+void FootPlacementStrategyFreePlane::setFootstepPreviewPlanner(FootstepPreviewPlanner* footstepPreviewPlanner) {
+  footstepPreviewPlanner_ = footstepPreviewPlanner;
+  if (footstepPreviewPlanner_ != nullptr) {
+    footstepPreviewPlanner_->reset();
+  }
+}
+
+
+FootstepPreviewPlanner* FootPlacementStrategyFreePlane::getFootstepPreviewPlanner() {
+  return footstepPreviewPlanner_;
+}
+
+
+void FootPlacementStrategyFreePlane::planFootsteps() {
+  if (footstepPreviewPlanner_ == nullptr) {
+    return;
+  }
+
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
+  const Position& positionWorldToBaseInWorldFrame = torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame();
+  Position positionWorldToBaseOnTerrainInWorldFrame = positionWorldToBaseInWorldFrame;
+  terrain_->getHeight(positionWorldToBaseOnTerrainInWorldFrame);
+
+  FootstepPreviewInput input;
+  input.positionWorldToCenterOfMassInWorldFrame_ = positionWorldToBaseInWorldFrame;
+  input.linearVelocityCenterOfMassInWorldFrame_ = context_.isValid_ ? context_.linearVelocityBaseInWorldFrame_
+                                                  : getOrientationWorldToBase().inverseRotate(torso_->getMeasuredState().getLinearVelocityBaseInBaseFrame());
+  input.linearVelocityDesiredInWorldFrame_ = orientationWorldToControl.inverseRotate(torso_->getDesiredState().getLinearVelocityBaseInControlFrame());
+  input.angularVelocityDesiredZ_ = torso_->getDesiredState().getAngularVelocityBaseInControlFrame().z();
+  input.heightCenterOfMass_ = positionWorldToBaseInWorldFrame.z() - positionWorldToBaseOnTerrainInWorldFrame.z();
+  input.gravity_ = torso_->getProperties().getGravity().norm();
+
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    if (leg->isSupportLeg()) {
+      input.timeToTouchDown_ = (1.0-leg->getStancePhase())*leg->getStanceDuration() + leg->getSwingDuration();
+    }
+    else {
+      input.timeToTouchDown_ = (1.0-leg->getSwingPhase())*leg->getSwingDuration();
+    }
+    input.strideDuration_ = leg->getStanceDuration() + leg->getSwingDuration();
+    input.positionCenterOfMassToNominalFootHoldInWorldFrame_ = leg->getPositionWorldToHipInWorldFrame() - positionWorldToBaseInWorldFrame
+                                                               + orientationWorldToControl.inverseRotate(leg->getProperties().getDesiredDefaultSteppingPositionHipToFootInControlFrame());
+    input.didTouchDown_ = (leg->isSupportLeg() && !wasSupportLeg_[legId]);
+    wasSupportLeg_[legId] = leg->isSupportLeg();
+
+    if (!footstepPreviewPlanner_->plan(legId, input)) {
+      footstepPreviewPlanner_->reset(legId);
+    }
+  }
+}
+
+
+void FootPlacementStrategyFreePlane::optimizeFootHolds() {
+  if (footholdOptimizer_ == nullptr) {
+    return;
+  }
+
+  /* the support polygon of a dynamic gait is not a stability criterion, only the terrain is scored */
+  footholdOptimizationProblems_.clear();
+  footholdOptimizationLegIds_.clear();
+  for (auto leg : *legs_) {
+    if (leg->isSupportLeg() || leg->isGrounded()) {
+      continue;
+    }
+    const int legId = leg->getId();
+
+    /* optimize at lift-off and if the nominal foot hold moved, otherwise the last offset is kept */
+    getPositionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame(*leg);
+    if (isFootHoldOptimizationDone_[legId]) {
+      Position positionOptimizedNominalToNominalFootHoldInWorldFrame = positionWorldToNominalFootHoldInWorldFrame_[legId]
+                                                                       - positionWorldToOptimizedNominalFootHoldInWorldFrame_[legId];
+      positionOptimizedNominalToNominalFootHoldInWorldFrame.z() = 0.0;
+      if (positionOptimizedNominalToNominalFootHoldInWorldFrame.norm() < footholdReoptimizationThreshold_) {
+        continue;
+      }
+    }
+
+    FootholdOptimizationProblem problem;
+    problem.positionWorldToNominalFootholdInWorldFrame_ = positionWorldToNominalFootHoldInWorldFrame_[legId];
+    problem.positionWorldToHipInWorldFrame_ = leg->getPositionWorldToHipInWorldFrame();
+    problem.positionWorldToCenterOfMassInWorldFrame_ = getPositionWorldToCenterOfMassInWorldFrame();
+    problem.positionWorldToPreviousFootholdInWorldFrame_ = positionWorldToNominalFootHoldInWorldFrame_[legId]
+                                                           + positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[legId];
+    problem.hasPreviousFoothold_ = isFootHoldOptimized_[legId];
+    footholdOptimizationProblems_.push_back(problem);
+    footholdOptimizationLegIds_.push_back(legId);
+  }
+  if (footholdOptimizationProblems_.empty()) {
+    return;
+  }
+
+  footholdOptimizer_->optimize(footholdOptimizationProblems_, footholdOptimizationResults_);
+  for (int k=0; k<(int)footholdOptimizationLegIds_.size(); k++) {
+    const int legId = footholdOptimizationLegIds_[k];
+    const FootholdOptimizationResult& result = footholdOptimizationResults_[k];
+    isFootHoldOptimizationDone_[legId] = true;
+    positionWorldToOptimizedNominalFootHoldInWorldFrame_[legId] = footholdOptimizationProblems_[k].positionWorldToNominalFootholdInWorldFrame_;
+    if (!result.isFeasible_) {
+      /* keep the last feasible foot hold */
+      continue;
+    }
+    positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[legId] = result.positionWorldToFootholdInWorldFrame_
+                                                                     - footholdOptimizationProblems_[k].positionWorldToNominalFootholdInWorldFrame_;
+    positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[legId].z() = 0.0;
+    isFootHoldOptimized_[legId] = true;
+  }
+}
+
+
+Position FootPlacementStrategyFreePlane::getPositionWorldToCenterOfMassInWorldFrame() const {
+  const RotationQuaternion& orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+  return torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame()
+      + orientationWorldToBase.inverseRotate(torso_->getProperties().getBaseToCenterOfMassPositionInBaseFrame());
+}
+
+
 Position FootPlacementStrategyFreePlane::getPositionProjectedOnPlaneAlongSurfaceNormal(const Position& position) {
   return terrain_->getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(position);
 }
 
 
+Position FootPlacementStrategyFreePlane::getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(const LegBase& leg) {
+  if (context_.isValid_) {
+    return context_.positionWorldToHipOnTerrainAlongWorldZInWorldFrame_[leg.getId()];
+  }
+  if (terrainQueryCache_ != nullptr && terrainQueryCache_->isValid()) {
+    return terrainQueryCache_->getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg.getId());
+  }
+  Position positionWorldToHipOnTerrainAlongWorldZInWorldFrame = leg.getPositionWorldToHipInWorldFrame();
+  terrain_->getHeight(positionWorldToHipOnTerrainAlongWorldZInWorldFrame);
+  return positionWorldToHipOnTerrainAlongWorldZInWorldFrame;
+}
+
+
+Position FootPlacementStrategyFreePlane::getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(const LegBase& leg) {
+  if (context_.isValid_) {
+    return context_.positionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame_[leg.getId()];
+  }
+  if (terrainQueryCache_ != nullptr && terrainQueryCache_->isValid()) {
+    return terrainQueryCache_->getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(leg.getId());
+  }
+  return getPositionProjectedOnPlaneAlongSurfaceNormal(leg.getPositionWorldToHipInWorldFrame());
+}
+
+
 Position FootPlacementStrategyFreePlane::getPositionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame(const LegBase& leg) {
+  if (context_.isValid_) {
+    return context_.positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame_[leg.getId()];
+  }
+
   Position positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame;
 
   // Project hip on terrain along world frame z axis
-  Position positionWorldToHipOnPlaneAlongWorldNormalInWorldFrame = leg.getPositionWorldToHipInWorldFrame();
-  terrain_->getHeight(positionWorldToHipOnPlaneAlongWorldNormalInWorldFrame);
+  Position positionWorldToHipOnPlaneAlongWorldNormalInWorldFrame = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg);
 
   // Project hip on terrain along surface normal
-  Position positionWorldToHipOnPlaneAlongSurfaceNormalInWorldFrame = getPositionProjectedOnPlaneAlongSurfaceNormal(leg.getPositionWorldToHipInWorldFrame());
+  Position positionWorldToHipOnPlaneAlongSurfaceNormalInWorldFrame = getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(leg);
 
   positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame = (positionWorldToHipOnPlaneAlongSurfaceNormalInWorldFrame
                                                                               - positionWorldToHipOnPlaneAlongWorldNormalInWorldFrame)*telescopicLeverConfiguration_;
@@ -169,13 +465,12 @@ Position FootPlacementStrategyFreePlane::getPositionVerticalHeightOnTerrainToLev
 }
 
 
-Position FootPlacementStrategyFreePlane::getDesiredWorldToFootPositionInWorldFrame(LegBase* leg, double tinyTimeStep) {
+Position FootPlacementStrategyFreePlane::getDesiredWorldToFootPositionInWorldFrame(LegBase* leg) {
 
-  RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
 
   // Find starting point: hip projected vertically on ground
-  Position positionWorldToHipOnPlaneAlongNormalInWorldFrame = leg->getPositionWorldToHipInWorldFrame();
-  terrain_->getHeight(positionWorldToHipOnPlaneAlongNormalInWorldFrame);
+  Position positionWorldToHipOnPlaneAlongNormalInWorldFrame = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(*leg);
 
   // Get offset to change between telescopic and lever configuration
   Position positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame = getPositionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame(*leg);
@@ -273,19 +568,42 @@ Position FootPlacementStrategyFreePlane::getOffsetDesiredFootOnTerrainToCorrecte
  * Interpolate height: get the vector pointing from the current interpolated foot hold to the height of the desired foot based on the interpolation phase
  */
 Position FootPlacementStrategyFreePlane::getPositionDesiredFootOnTerrainToDesiredFootInControlFrame(const LegBase& leg, const Position& positionHipOnTerrainToDesiredFootOnTerrainInControlFrame)  {
-  const double interpolationParameter = getInterpolationPhase(leg);
-  const double desiredFootHeight = const_cast<SwingFootHeightTrajectory*>(&swingFootHeightTrajectory_)->evaluate(interpolationParameter);
-
-  RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
-  Position positionHipOnTerrainToDesiredFootOnTerrainInWorldFrame = orientationWorldToControl.inverseRotate(positionHipOnTerrainToDesiredFootOnTerrainInControlFrame);
+  const bool isUsingPolynomial = (isUsingSwingFootTrajectoryPolynomial_ && !leg.isSupportLeg());
+  double desiredFootHeight = 0.0;
+  double time = 0.0;
+  double duration = 0.0;
+  if (isUsingPolynomial) {
+    getSwingTimes(leg, time, duration);
+    desiredFootHeight = swingFootTrajectories_[leg.getId()].getPosition(time).z();
+  }
+  else {
+    const double interpolationParameter = getInterpolationPhase(leg);
+    desiredFootHeight = swingFootHeightTrajectory_.evaluate(interpolationParameter, swingFootHeightTrajectoryCursors_[leg.getId()]);
+  }
 
-  Vector normalToPlaneAtCurrentFootPositionInWorldFrame;
-  terrain_->getNormal(positionHipOnTerrainToDesiredFootOnTerrainInWorldFrame,
-                      normalToPlaneAtCurrentFootPositionInWorldFrame);
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
+  const Vector normalToPlaneAtCurrentFootPositionInWorldFrame = getNormalAtFootInWorldFrame(leg);
 
   Vector normalToPlaneAtCurrentFootPositionInControlFrame = orientationWorldToControl.rotate(normalToPlaneAtCurrentFootPositionInWorldFrame);
 
   Position positionDesiredFootOnTerrainToDesiredFootInControlFrame = desiredFootHeight*Position(normalToPlaneAtCurrentFootPositionInControlFrame);
+
+  //--- analytic velocity and acceleration of the swing foot: horizontal components in control frame, height along the normal
+  if (isUsingPolynomial) {
+    const SwingFootTrajectoryPolynomial& trajectory = swingFootTrajectories_[leg.getId()];
+    const LinearVelocity linearVelocityInControlFrame = trajectory.getLinearVelocity(time);
+    const LinearAcceleration linearAccelerationInControlFrame = trajectory.getLinearAcceleration(time);
+    linearVelocityHipToDesiredFootInWorldFrame_[leg.getId()] = orientationWorldToControl.inverseRotate(LinearVelocity(linearVelocityInControlFrame.x(), linearVelocityInControlFrame.y(), 0.0))
+                                                          + LinearVelocity(normalToPlaneAtCurrentFootPositionInWorldFrame.toImplementation()*linearVelocityInControlFrame.z());
+    linearAccelerationHipToDesiredFootInWorldFrame_[leg.getId()] = orientationWorldToControl.inverseRotate(LinearAcceleration(linearAccelerationInControlFrame.x(), linearAccelerationInControlFrame.y(), 0.0))
+                                                              + LinearAcceleration(normalToPlaneAtCurrentFootPositionInWorldFrame.toImplementation()*linearAccelerationInControlFrame.z());
+  }
+  else {
+    linearVelocityHipToDesiredFootInWorldFrame_[leg.getId()].setZero();
+    linearAccelerationHipToDesiredFootInWorldFrame_[leg.getId()].setZero();
+  }
+  //---
+
   return positionDesiredFootOnTerrainToDesiredFootInControlFrame;
 }
 
@@ -310,19 +628,27 @@ Position FootPlacementStrategyFreePlane::getPositionDesiredFootHoldOnTerrainFeed
 
 // Evaluate feedback component given by the inverted pendulum model
 Position FootPlacementStrategyFreePlane::getPositionDesiredFootHoldOnTerrainFeedBackInControlFrame(const LegBase& leg) {
-  RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
-  RotationQuaternion orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
-
-  //--- Get desired velocity heading component in control frame
-  Vector axisXOfControlFrame = Vector::UnitX();
-  LinearVelocity linearVeloctyDesiredInControlFrame = torso_->getDesiredState().getLinearVelocityBaseInControlFrame();
-  LinearVelocity linearVeloctyDesiredHeadingInControlFrame = LinearVelocity(linearVeloctyDesiredInControlFrame.toImplementation().cwiseProduct(axisXOfControlFrame.toImplementation()));
-  LinearVelocity linearVeloctyDesiredInWorldFrame = orientationWorldToControl.inverseRotate(linearVeloctyDesiredHeadingInControlFrame);
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
+
+  //--- Get desired velocity heading component in world frame and the measured velocity of the base
+  LinearVelocity linearVeloctyDesiredInWorldFrame;
+  LinearVelocity linearVelocityBaseInWorldFrame;
+  if (context_.isValid_) {
+    linearVeloctyDesiredInWorldFrame = context_.linearVelocityDesiredHeadingInWorldFrame_;
+    linearVelocityBaseInWorldFrame = context_.linearVelocityBaseInWorldFrame_;
+  }
+  else {
+    Vector axisXOfControlFrame = Vector::UnitX();
+    LinearVelocity linearVeloctyDesiredInControlFrame = torso_->getDesiredState().getLinearVelocityBaseInControlFrame();
+    LinearVelocity linearVeloctyDesiredHeadingInControlFrame = LinearVelocity(linearVeloctyDesiredInControlFrame.toImplementation().cwiseProduct(axisXOfControlFrame.toImplementation()));
+    linearVeloctyDesiredInWorldFrame = orientationWorldToControl.inverseRotate(linearVeloctyDesiredHeadingInControlFrame);
+    linearVelocityBaseInWorldFrame = getOrientationWorldToBase().inverseRotate(torso_->getMeasuredState().getLinearVelocityBaseInBaseFrame());
+  }
   //---
 
   //--- Get reference velocity estimation
   LinearVelocity linearVeloctyReferenceInWorldFrame = (leg.getLinearVelocityHipInWorldFrame()
-                                                      + orientationWorldToBase.inverseRotate(torso_->getMeasuredState().getLinearVelocityBaseInBaseFrame())
+                                                      + linearVelocityBaseInWorldFrame
                                                       )/2.0;
   //---
 
@@ -337,8 +663,7 @@ Position FootPlacementStrategyFreePlane::getPositionDesiredFootHoldOnTerrainFeed
   /**********************************************************
    * Method I: project pendulum along z axis in world frame *
    **********************************************************/
-  double terrainHeightAtHipInWorldFrame;
-  terrain_->getHeight(leg.getPositionWorldToHipInWorldFrame(), terrainHeightAtHipInWorldFrame);
+  const double terrainHeightAtHipInWorldFrame = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg).z();
   const double heightInvertedPendulum = fabs(leg.getPositionWorldToHipInWorldFrame().z() - terrainHeightAtHipInWorldFrame);
   /****************
    * End Method I *
@@ -355,7 +680,7 @@ Position FootPlacementStrategyFreePlane::getPositionDesiredFootHoldOnTerrainFeed
 
   const double gravitationalAccleration = torso_->getProperties().getGravity().norm();
   Position positionDesiredFootHoldOnTerrainFeedBackInWorldFrame = Position(linearVelocityErrorInWorldFrame
-                                                                  *stepFeedbackScale_
+                                                                  *parameters_.stepFeedbackScale_
                                                                   *std::sqrt(heightInvertedPendulum/gravitationalAccleration));
   //--- hack
   //  positionDesiredFootHoldOnTerrainFeedBackInWorldFrame.z() = 0.0;
@@ -377,32 +702,81 @@ double FootPlacementStrategyFreePlane::getInterpolationPhase(const LegBase& leg)
 }
 
 
-Position FootPlacementStrategyFreePlane::getPositionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame(const LegBase& leg) {
-  const RotationQuaternion& orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+Position FootPlacementStrategyFreePlane::getPositionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame(const LegBase& leg) {
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
 
   positionDesiredFootHoldOnTerrainFeedForwardInControlFrame_[leg.getId()] = getPositionDesiredFootHoldOnTerrainFeedForwardInControlFrame(leg);
   positionDesiredFootHoldOnTerrainFeedBackInControlFrame_[leg.getId()] = getPositionDesiredFootHoldOnTerrainFeedBackInControlFrame(leg);
 
-  Position positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame = positionDesiredFootHoldOnTerrainFeedForwardInControlFrame_[leg.getId()]
+  Position positionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame = positionDesiredFootHoldOnTerrainFeedForwardInControlFrame_[leg.getId()]
                                                                                      + positionDesiredFootHoldOnTerrainFeedBackInControlFrame_[leg.getId()];
 
+  //--- the first step of the footstep preview replaces the inverted pendulum foot hold
+  if (footstepPreviewPlanner_ != nullptr && footstepPreviewPlanner_->hasPlan(leg.getId())) {
+    const Position positionHipOnTerrainToPlannedFootHoldInWorldFrame = footstepPreviewPlanner_->getPositionWorldToFootHoldInWorldFrame(leg.getId(), 0)
+                                                                       - getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg);
+    positionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame = orientationWorldToControl.rotate(positionHipOnTerrainToPlannedFootHoldInWorldFrame);
+    positionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame.z() = 0.0;
+  }
+  //---
+
   /* TESTING */
   //--- add offset
 //  Position offset = getOffsetDesiredFootOnTerrainToCorrectedFootOnTerrainInControlFrame(leg);
 //  std::cout << "offset: " << offset << std::endl;
-//  positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame -= offset;
+//  positionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame -= offset;
   //---
 
   //--- save for debug
   //Position positionWorldToHipOnPlaneAlongNormalInWorldFrame = getPositionProjectedOnPlaneAlongSurfaceNormal(leg.getWorldToHipPositionInWorldFrame());
 
-  Position positionWorldToHipVerticalOnPlaneInWorldFrame = leg.getPositionWorldToHipInWorldFrame();
-  terrain_->getHeight(positionWorldToHipVerticalOnPlaneInWorldFrame);
+  Position positionWorldToHipVerticalOnPlaneInWorldFrame = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg);
+
+  positionWorldToNominalFootHoldInWorldFrame_[leg.getId()] = positionWorldToHipVerticalOnPlaneInWorldFrame
+                                                             + orientationWorldToControl.inverseRotate(positionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame);
+  //---
 
+  return positionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame;
+}
+
+
+Position FootPlacementStrategyFreePlane::getPositionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame(const LegBase& leg) {
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
+
+  Position positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame = getPositionHipOnTerrainAlongNormalToNominalFootHoldOnTerrainInControlFrame(leg);
+  const Position positionWorldToHipVerticalOnPlaneInWorldFrame = getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg);
+
+  //--- move the foot hold to the optimized one
+  if (footholdOptimizer_ != nullptr && !leg.isSupportLeg()) {
+    Position positionNominalFootHoldToOptimizedFootHoldInControlFrame = orientationWorldToControl.rotate(positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[leg.getId()]);
+    positionNominalFootHoldToOptimizedFootHoldInControlFrame.z() = 0.0;
+    positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame += positionNominalFootHoldToOptimizedFootHoldInControlFrame;
+  }
   positionWorldToFootHoldInWorldFrame_[leg.getId()] = positionWorldToHipVerticalOnPlaneInWorldFrame
                                                       + orientationWorldToControl.inverseRotate(positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame);
   //---
 
+  return positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame;
+}
+
+
+Position FootPlacementStrategyFreePlane::getPositionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame(const LegBase& leg) {
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
+
+  const Position positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame = getPositionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame(leg);
+
+  //--- evaluate the polynomial swing trajectory
+  if (isUsingSwingFootTrajectoryPolynomial_ && !leg.isSupportLeg()) {
+    updateSwingFootTrajectory(leg, positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame);
+    double time = 0.0;
+    double duration = 0.0;
+    getSwingTimes(leg, time, duration);
+    Position positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame = swingFootTrajectories_[leg.getId()].getPosition(time);
+    positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame.z() = 0.0;
+    return positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame;
+  }
+  //---
+
   //--- starting point for trajectory interpolation
   const Position positionHipOnTerrainAlongNormalToFootAtLiftOffInWorldFrame = leg.getStateLiftOff().getPositionWorldToFootInWorldFrame()
                                                                               -leg.getStateLiftOff().getPositionWorldToHipOnTerrainAlongNormalToSurfaceAtLiftOffInWorldFrame();
@@ -430,4 +804,63 @@ Position FootPlacementStrategyFreePlane::getPositionHipOnTerrainAlongNormalToDes
 }
 
 
+void FootPlacementStrategyFreePlane::updateSwingFootTrajectory(const LegBase& leg, const Position& positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame) {
+  double time = 0.0;
+  double duration = 0.0;
+  getSwingTimes(leg, time, duration);
+
+  if (!isSwingFootTrajectoryToBePlanned_[leg.getId()]) {
+    swingFootTrajectories_[leg.getId()].updateTarget(time, positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame, parameters_.swingFootTrajectoryRefitThreshold_);
+    return;
+  }
+
+  //--- starting point of the swing trajectory
+  const RotationQuaternion& orientationWorldToControl = getOrientationWorldToControl();
+  const Position positionHipOnTerrainAlongNormalToFootAtLiftOffInWorldFrame = leg.getStateLiftOff().getPositionWorldToFootInWorldFrame()
+                                                                              -leg.getStateLiftOff().getPositionWorldToHipOnTerrainAlongNormalToSurfaceAtLiftOffInWorldFrame();
+  Position positionHipOnTerrainAlongNormalToFootStartInControlFrame = orientationWorldToControl.rotate(positionHipOnTerrainAlongNormalToFootAtLiftOffInWorldFrame);
+
+  //--- heights at lift-off, apex and touch-down are taken from the knots of the height trajectory
+  double heightStart = 0.0;
+  double heightApex = 0.0;
+  double heightTarget = 0.0;
+  double apexPhase = 0.5;
+  getSwingFootHeights(leg, heightStart, heightApex, heightTarget, apexPhase);
+  //---
+
+  if (time > 0.0) {
+    /* The trajectory is planned after lift-off (e.g. the polynomials have been enabled during the swing).
+     * It starts from the current foot position decomposed as in getDesiredWorldToFootPositionInWorldFrame
+     * such that the desired foot position does not jump.
+     */
+    const Vector normalInControlFrame = orientationWorldToControl.rotate(getNormalAtFootInWorldFrame(leg));
+    const Position positionHipOnTerrainToFootInControlFrame = orientationWorldToControl.rotate(Position(leg.getPositionWorldToFootInWorldFrame()
+                                                                                                       - getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg)
+                                                                                                       - getPositionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame(leg)));
+    if (normalInControlFrame.z() > 1.0e-3) {
+      heightStart = positionHipOnTerrainToFootInControlFrame.z()/normalInControlFrame.z();
+      positionHipOnTerrainAlongNormalToFootStartInControlFrame = Position(positionHipOnTerrainToFootInControlFrame.x() - heightStart*normalInControlFrame.x(),
+                                                                          positionHipOnTerrainToFootInControlFrame.y() - heightStart*normalInControlFrame.y(),
+                                                                          0.0);
+    }
+  }
+  //---
+
+  //--- raise the apex if the swing path does not clear the terrain
+  if (swingFootClearancePlanner_ != nullptr) {
+    SwingFootClearanceResult& clearance = swingFootClearanceResults_[leg.getId()];
+    swingFootClearancePlanner_->plan(leg.getStateLiftOff().getPositionWorldToFootInWorldFrame(), positionWorldToFootHoldInWorldFrame_[leg.getId()],
+                                     heightStart, heightApex, heightTarget, apexPhase, clearance);
+    heightApex = clearance.heightApex_;
+  }
+  //---
+
+  swingFootTrajectories_[leg.getId()].plan(time, duration,
+                                           positionHipOnTerrainAlongNormalToFootStartInControlFrame,
+                                           positionHipOnTerrainAlongNormalToDesiredFootHoldOnTerrainInControlFrame,
+                                           heightStart, heightApex, heightTarget, apexPhase);
+  isSwingFootTrajectoryToBePlanned_[leg.getId()] = false;
+}
+
+
 } /* namespace loco */
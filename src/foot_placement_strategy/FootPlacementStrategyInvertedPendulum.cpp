@@ -50,17 +50,61 @@
 
 namespace loco {
 
+FootPlacementStrategyInvertedPendulumParameters::FootPlacementStrategyInvertedPendulumParameters() :
+    stepFeedbackScale_(1.1),
+    swingFootTrajectoryRefitThreshold_(0.01)
+{
+  for (int i=0; i<2; i++) {
+    offsetFore_[i] = 0.0;
+    offsetHind_[i] = 0.0;
+  }
+}
+
+
+const ParameterSchema<FootPlacementStrategyInvertedPendulumParameters>& FootPlacementStrategyInvertedPendulumParameters::getSchema() {
+  typedef FootPlacementStrategyInvertedPendulumParameters P;
+  // Built once in a thread-safe static initialization since the parameters are also parsed on the loader thread.
+  static const ParameterSchema<P> schema = [](){
+    ParameterSchema<P> schema;
+    schema.add("FootPlacementStrategy/InvertedPendulum/Gains", "feedbackScale", &P::stepFeedbackScale_);
+    schema.add("FootPlacementStrategy/InvertedPendulum/Offset/Fore", "heading", &P::offsetFore_, 0);
+    schema.add("FootPlacementStrategy/InvertedPendulum/Offset/Fore", "lateral", &P::offsetFore_, 1);
+    schema.add("FootPlacementStrategy/InvertedPendulum/Offset/Hind", "heading", &P::offsetHind_, 0);
+    schema.add("FootPlacementStrategy/InvertedPendulum/Offset/Hind", "lateral", &P::offsetHind_, 1);
+    schema.addOptional("FootPlacementStrategy/InvertedPendulum/SwingTrajectory", "refitThreshold", &P::swingFootTrajectoryRefitThreshold_, 0.01);
+    return schema;
+  }();
+  return schema;
+}
+
+
+/*! The default step interpolation function is identical for all instances, hence they share its knots.
+ */
+static const Trajectory1D& getDefaultStepInterpolationFunction() {
+  static const Trajectory1D stepInterpolationFunction = [](){
+    Trajectory1D trajectory;
+    trajectory.addKnot(0, 0);
+    trajectory.addKnot(0.6, 1);
+    return trajectory;
+  }();
+  return stepInterpolationFunction;
+}
+
 FootPlacementStrategyInvertedPendulum::FootPlacementStrategyInvertedPendulum(LegGroup* legs, TorsoBase* torso, loco::TerrainModelBase* terrain) :
     FootPlacementStrategyBase(),
     legs_(legs),
     torso_(torso),
-    terrain_(terrain)
+    terrain_(terrain),
+    isUsingSwingFootTrajectoryPolynomial_(true)
 {
 
-	stepFeedbackScale_ = 1.1;
-	stepInterpolationFunction_.clear();
-	stepInterpolationFunction_.addKnot(0, 0);
-	stepInterpolationFunction_.addKnot(0.6, 1);
+	stepInterpolationFunction_ = getDefaultStepInterpolationFunction();
+
+  for (int iLeg=0; iLeg<4; iLeg++) {
+    linearVelocityHipToDesiredFootInWorldFrame_[iLeg].setZero();
+    linearAccelerationHipToDesiredFootInWorldFrame_[iLeg].setZero();
+    isSwingFootTrajectoryToBePlanned_[iLeg] = true;
+  }
 
 
 //	swingFootHeightTrajectory_.clear();
@@ -76,7 +120,7 @@ FootPlacementStrategyInvertedPendulum::~FootPlacementStrategyInvertedPendulum()
 
 }
 
-Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInWorldFrame(LegBase* leg, double tinyTimeStep) {
+Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInWorldFrame(LegBase* leg) {
 
   //--- Get rotations
   const RotationQuaternion& orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
@@ -134,7 +178,7 @@ Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInW
 	const double gravitationalAccleration = torso_->getProperties().getGravity().norm();
 
 	Position invertedPendulumPositionHipToFootHoldInWorldFrame = orientationWorldToControl.inverseRotate(
-	                                                              stepFeedbackScale_
+	                                                              parameters_.stepFeedbackScale_
 	                                                             * orientationWorldToControl.rotate(Position(linearVelocityErrorInWorldFrame))
 	                                                             * std::sqrt(invertedPendulumHeightInControlFrame/gravitationalAccleration)
 	                                                            );
@@ -188,8 +232,21 @@ Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInW
 
 	testingHipToDesiredFootHold_[leg->getId()] = positionHipToDesiredFootholdInWorldFrame;
 
-	const Position positionHipToFootInWorldFrameAtLiftOff = leg->getStateLiftOff()->getPositionWorldToFootInWorldFrame()-leg->getStateLiftOff()->getPositionWorldToHipInWorldFrame();
-	Position positionOffsetFromHipProjectedOnTerrainToDesiredFoot = getCurrentFootPositionFromPredictedFootHoldLocationInWorldFrame(std::min(swingPhase + tinyTimeStep, 1.0),  positionHipToFootInWorldFrameAtLiftOff, positionHipToDesiredFootholdInWorldFrame, leg);
+	const bool isUsingPolynomial = (isUsingSwingFootTrajectoryPolynomial_ && !leg->isSupportLeg());
+	double time = 0.0;
+	double duration = 0.0;
+	Position positionOffsetFromHipProjectedOnTerrainToDesiredFoot;
+	if (isUsingPolynomial) {
+	  updateSwingFootTrajectory(*leg, orientationWorldToControl.rotate(positionHipToDesiredFootholdInWorldFrame));
+	  getSwingTimes(*leg, time, duration);
+	  Position positionHipToDesiredFootInControlFrame = swingFootTrajectories_[leg->getId()].getPosition(time);
+	  positionHipToDesiredFootInControlFrame.z() = 0.0;
+	  positionOffsetFromHipProjectedOnTerrainToDesiredFoot = orientationWorldToControl.inverseRotate(positionHipToDesiredFootInControlFrame);
+	}
+	else {
+	  const Position positionHipToFootInWorldFrameAtLiftOff = leg->getStateLiftOff()->getPositionWorldToFootInWorldFrame()-leg->getStateLiftOff()->getPositionWorldToHipInWorldFrame();
+	  positionOffsetFromHipProjectedOnTerrainToDesiredFoot = getCurrentFootPositionFromPredictedFootHoldLocationInWorldFrame(swingPhase,  positionHipToFootInWorldFrameAtLiftOff, positionHipToDesiredFootholdInWorldFrame, leg);
+	}
 //
 //	defaultPositionHipToFootHoldInWorldFrame = orientationWorldToControl.rotate(defaultPositionHipToFootHoldInWorldFrame);
 //	defaultPositionHipToFootHoldInWorldFrame.z() = 0.0;
@@ -205,8 +262,6 @@ Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInW
 	                                                  + positionOffsetFromHipProjectedOnTerrainToDesiredFoot;
 
 
-	//Position positionWorldToDesiredFootInWorldFrame = refPositionWorldToHipInWorldFrame + (Position(refLinearVelocityAtHipInWorldFrame)*tinyTimeStep + positionOffsetFromHipProjectedOnTerrainToDesiredFoot);
-
 //  std::cout << "leg: " << leg->getId() << std::endl;
 //  std::cout << "defaultPositionHipToFootHoldInWorldFrame: " << defaultHipToFoot << std::endl;
 //  std::cout << "feedForwardPositionHipToFootHoldInWorldFrame: " << feedForwardPositionHipToFootHoldInWorldFrame << std::endl;
@@ -216,8 +271,7 @@ Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInW
   // log the predicted foot hold location which has the the same height as the terrain.
 	// green
   positionWorldToFootHoldInWorldFrame_[leg->getId()] = refPositionWorldToHipInWorldFrame
-                                                       + (Position(refLinearVelocityAtHipInWorldFrame)*tinyTimeStep
-                                                       + positionHipToDesiredFootholdInWorldFrame);
+                                                       + positionHipToDesiredFootholdInWorldFrame;
   terrain_->getHeight(positionWorldToFootHoldInWorldFrame_[leg->getId()],positionWorldToFootHoldInWorldFrame_[leg->getId()].z());
 
   // black
@@ -242,22 +296,34 @@ Position FootPlacementStrategyInvertedPendulum::getDesiredWorldToFootPositionInW
 	//positionWorldToDesiredFootInWorldFrame.z() = 0.0;
 	//terrain_->getHeight(positionWorldToDesiredFootInWorldFrame);
 
-	// Set desired foot height according to linear height interpolation
+	// Set desired foot height according to the height trajectory
+	const double desiredFootHeight = (isUsingPolynomial ? swingFootTrajectories_[leg->getId()].getPosition(time).z()
+	                                                    : swingFootHeightTrajectory_.evaluate(swingPhase, swingFootHeightTrajectoryCursors_[leg->getId()]));
 	positionWorldToDesiredFootInWorldFrame = orientationWorldToControl.rotate(positionWorldToDesiredFootInWorldFrame);
-	positionWorldToDesiredFootInWorldFrame.z() = swingFootHeightTrajectory_.evaluate(std::min(swingPhase + tinyTimeStep, 1.0));
+	positionWorldToDesiredFootInWorldFrame.z() = desiredFootHeight;
 	positionWorldToDesiredFootInWorldFrame = orientationWorldToControl.inverseRotate(positionWorldToDesiredFootInWorldFrame);
 
-
-//	positionWorldToDesiredFootInWorldFrame += (loco::Position)surfaceNormalInWorldFrame*swingFootHeightTrajectory_.evaluate(std::min(swingPhase + tinyTimeStep, 1.0));
+	//--- analytic velocity and acceleration of the swing foot in control frame, the foot is not moved horizontally while it is grounded
+	if (isUsingPolynomial) {
+	  LinearVelocity linearVelocityInControlFrame = swingFootTrajectories_[leg->getId()].getLinearVelocity(time);
+	  LinearAcceleration linearAccelerationInControlFrame = swingFootTrajectories_[leg->getId()].getLinearAcceleration(time);
+	  if (leg->isGrounded()) {
+	    linearVelocityInControlFrame = LinearVelocity(0.0, 0.0, linearVelocityInControlFrame.z());
+	    linearAccelerationInControlFrame = LinearAcceleration(0.0, 0.0, linearAccelerationInControlFrame.z());
+	  }
+	  linearVelocityHipToDesiredFootInWorldFrame_[leg->getId()] = orientationWorldToControl.inverseRotate(linearVelocityInControlFrame);
+	  linearAccelerationHipToDesiredFootInWorldFrame_[leg->getId()] = orientationWorldToControl.inverseRotate(linearAccelerationInControlFrame);
+	}
+	//---
 
 	//--- Add offset to height to take into accoutn the difference between real foot position and its projection on estimated plane
 //	double footPositionAtLiftOffOnFreePlane;
 //	terrain_->getHeight(leg->getStateLiftOff()->getFootPositionInWorldFrame(), footPositionAtLiftOffOnFreePlane);
 //	double realFootHeightInWorldFrameOffset = leg->getStateLiftOff()->getFootPositionInWorldFrame().z()- footPositionAtLiftOffOnFreePlane;
-//	positionWorldToDesiredFootInWorldFrame.z() = realFootHeightInWorldFrameOffset + getHeightOfTerrainInWorldFrame(positionWorldToDesiredFootInWorldFrame) + swingFootHeightTrajectory_.evaluate(std::min(swingPhase + tinyTimeStep, 1.0));
+//	positionWorldToDesiredFootInWorldFrame.z() = realFootHeightInWorldFrameOffset + getHeightOfTerrainInWorldFrame(positionWorldToDesiredFootInWorldFrame) + swingFootHeightTrajectory_.evaluate(swingPhase);
 	//---
 
-	heightByTrajectory_[leg->getId()] =  swingFootHeightTrajectory_.evaluate(std::min(swingPhase + tinyTimeStep, 1.0));
+	heightByTrajectory_[leg->getId()] = desiredFootHeight;
 	return positionWorldToDesiredFootInWorldFrame;
 
 }
@@ -297,7 +363,7 @@ double FootPlacementStrategyInvertedPendulum::getLateralComponentOfFootStep(doub
 
 double FootPlacementStrategyInvertedPendulum::getHeadingComponentOfFootStep(double phase, double initialStepOffset, double stepGuess, LegBase* leg)
 {
-	phase = stepInterpolationFunction_.evaluate_linear(phase);
+	phase = stepInterpolationFunction_.evaluate_linear(phase, stepInterpolationFunctionCursors_[leg->getId()]);
 //	return stepGuess * phase + initialStepOffset * (1-phase);
 	double result = stepGuess * phase + initialStepOffset * (1.0-phase);
 	const double legLength =  leg->getProperties().getLegLength();
@@ -318,74 +384,28 @@ bool FootPlacementStrategyInvertedPendulum::loadParameters(const TiXmlHandle& ha
     return false;
   }
 
-  pElem = hFPS.FirstChild("Gains").Element();
-  if (pElem->QueryDoubleAttribute("feedbackScale", &stepFeedbackScale_)!=TIXML_SUCCESS) {
-    printf("Could not find Gains:feedbackScale\n");
+  /* gains, offsets and swing trajectory, parameters_ is left unchanged if the file is invalid */
+  if (!FootPlacementStrategyInvertedPendulumParameters::getSchema().parse(handle, parameters_)) {
     return false;
   }
-
-
-  /* offset */
-  pElem = hFPS.FirstChild("Offset").Element();
-  if (!pElem) {
-    printf("Could not find Offset\n");
-    return false;
-  }
-
-  {
-    pElem = hFPS.FirstChild("Offset").FirstChild("Fore").Element();
-    if (!pElem) {
-      printf("Could not find Offset:Fore\n");
-      return false;
-    }
-    double offsetHeading = 0.0;
-    double offsetLateral = 0.0;
-    if (pElem->QueryDoubleAttribute("heading", &offsetHeading)!=TIXML_SUCCESS) {
-      printf("Could not find Offset:Fore:heading!\n");
-      return false;
-    }
-
-    if (pElem->QueryDoubleAttribute("lateral", &offsetLateral)!=TIXML_SUCCESS) {
-      printf("Could not find Offset:Fore:lateral!\n");
-      return false;
-    }
-    Position leftOffset(offsetHeading, offsetLateral, 0.0);
-    Position rightOffset(offsetHeading, -offsetLateral, 0.0);
-    legs_->getLeftForeLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(leftOffset);
-    legs_->getRightForeLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(rightOffset);
-
-  }
-
-  {
-    pElem = hFPS.FirstChild("Offset").FirstChild("Hind").Element();
-    if (!pElem) {
-      printf("Could not find Offset:Hind\n");
-      return false;
-    }
-    double offsetHeading = 0.0;
-    double offsetLateral = 0.0;
-    if (pElem->QueryDoubleAttribute("heading", &offsetHeading)!=TIXML_SUCCESS) {
-      printf("Could not find Offset:Hind:heading!\n");
-      return false;
-    }
-
-    if (pElem->QueryDoubleAttribute("lateral", &offsetLateral)!=TIXML_SUCCESS) {
-      printf("Could not find Offset:Hind:lateral!\n");
-      return false;
-    }
-    Position leftOffset(offsetHeading, offsetLateral, 0.0);
-    Position rightOffset(offsetHeading, -offsetLateral, 0.0);
-    legs_->getLeftHindLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(leftOffset);
-    legs_->getRightHindLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(rightOffset);
-  }
-
-
+  legs_->getLeftForeLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(Position(parameters_.offsetFore_[0], parameters_.offsetFore_[1], 0.0));
+  legs_->getRightForeLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(Position(parameters_.offsetFore_[0], -parameters_.offsetFore_[1], 0.0));
+  legs_->getLeftHindLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(Position(parameters_.offsetHind_[0], parameters_.offsetHind_[1], 0.0));
+  legs_->getRightHindLeg()->getProperties().setDesiredDefaultSteppingPositionHipToFootInControlFrame(Position(parameters_.offsetHind_[0], -parameters_.offsetHind_[1], 0.0));
 
   /* height trajectory */
   if(!loadHeightTrajectory(hFPS.FirstChild("HeightTrajectory"))) {
     return false;
   }
 
+  /* optional: the swing trajectory is planned by polynomials at lift-off unless polynomial="0",
+   * the switch selects the type of the trajectory and is not a numeric parameter of the schema */
+  pElem = hFPS.FirstChild("SwingTrajectory").Element();
+  if (pElem) {
+    int isPolynomial = (isUsingSwingFootTrajectoryPolynomial_ ? 1 : 0);
+    pElem->QueryIntAttribute("polynomial", &isPolynomial);
+    isUsingSwingFootTrajectoryPolynomial_ = (isPolynomial != 0);
+  }
 
   return true;
 }
@@ -421,6 +441,11 @@ bool FootPlacementStrategyInvertedPendulum::loadHeightTrajectory(const TiXmlHand
 }
 
 bool FootPlacementStrategyInvertedPendulum::initialize(double dt) {
+  for (auto leg : *legs_) {
+    isSwingFootTrajectoryToBePlanned_[leg->getId()] = true;
+    linearVelocityHipToDesiredFootInWorldFrame_[leg->getId()].setZero();
+    linearAccelerationHipToDesiredFootInWorldFrame_[leg->getId()].setZero();
+  }
   return true;
 }
 
@@ -448,8 +473,15 @@ bool FootPlacementStrategyInvertedPendulum::advance(double dt)
       leg->getStateLiftOff()->setPositionWorldToFootInWorldFrame(leg->getPositionWorldToFootInWorldFrame());
       leg->getStateLiftOff()->setPositionWorldToHipInWorldFrame(leg->getPositionWorldToHipInWorldFrame());
       leg->setSwingPhase(leg->getSwingPhase());
+
+      // the swing trajectory starts from the new lift-off state
+      isSwingFootTrajectoryToBePlanned_[leg->getId()] = true;
     }
 
+    // the feedforward is only set while the foot tracks the swing trajectory
+    linearVelocityHipToDesiredFootInWorldFrame_[leg->getId()].setZero();
+    linearAccelerationHipToDesiredFootInWorldFrame_[leg->getId()].setZero();
+
 
 	  /* this default desired swing behaviour
 	   *
@@ -486,6 +518,8 @@ bool FootPlacementStrategyInvertedPendulum::advance(double dt)
 				  }
 		  }
 	  }
+    leg->setDesiredLinearVelocityHipToFootInWorldFrame(linearVelocityHipToDesiredFootInWorldFrame_[leg->getId()]);
+    leg->setDesiredLinearAccelerationHipToFootInWorldFrame(linearAccelerationHipToDesiredFootInWorldFrame_[leg->getId()]);
 
   }
   return true;
@@ -513,7 +547,7 @@ void FootPlacementStrategyInvertedPendulum::regainContact(LegBase* leg, double d
 }
 
 void FootPlacementStrategyInvertedPendulum::setFootTrajectory(LegBase* leg) {
-    const Position positionWorldToFootInWorldFrame = getDesiredWorldToFootPositionInWorldFrame(leg, 0.0);
+    const Position positionWorldToFootInWorldFrame = getDesiredWorldToFootPositionInWorldFrame(leg);
     leg->setDesireWorldToFootPositionInWorldFrame(positionWorldToFootInWorldFrame); // for debugging
     const Position positionBaseToFootInWorldFrame = positionWorldToFootInWorldFrame - torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame();
     const Position positionBaseToFootInBaseFrame  = torso_->getMeasuredState().getOrientationWorldToBase().rotate(positionBaseToFootInWorldFrame);
@@ -522,6 +556,77 @@ void FootPlacementStrategyInvertedPendulum::setFootTrajectory(LegBase* leg) {
 }
 
 
+void FootPlacementStrategyInvertedPendulum::getSwingTimes(const LegBase& leg, double& time, double& duration) {
+  double swingPhase = 1.0;
+  if (!leg.isSupportLeg()) {
+    swingPhase = leg.getSwingPhase();
+  }
+  duration = (1.0-leg.getStateLiftOff().getSwingPhase())*leg.getSwingDuration();
+  time = mapTo01Range(swingPhase, leg.getStateLiftOff().getSwingPhase(), 1.0)*duration;
+}
+
+
+void FootPlacementStrategyInvertedPendulum::getSwingFootHeights(const LegBase& leg, double& heightStart, double& heightApex, double& heightTarget, double& apexPhase) {
+  heightStart = swingFootHeightTrajectory_.evaluate(0.0, swingFootHeightTrajectoryCursors_[leg.getId()]);
+  heightTarget = swingFootHeightTrajectory_.evaluate(1.0, swingFootHeightTrajectoryCursors_[leg.getId()]);
+  heightApex = heightStart;
+  apexPhase = 0.5;
+  const auto knots = swingFootHeightTrajectory_.getKnotData();
+  for (int i=0; i<(int)knots->values.size(); i++) {
+    if (knots->values[i] > heightApex && knots->tValues[i] > 0.0 && knots->tValues[i] < 1.0) {
+      heightApex = knots->values[i];
+      apexPhase = knots->tValues[i];
+    }
+  }
+}
+
+
+void FootPlacementStrategyInvertedPendulum::updateSwingFootTrajectory(const LegBase& leg, const Position& positionHipToDesiredFootHoldInControlFrame) {
+  double time = 0.0;
+  double duration = 0.0;
+  getSwingTimes(leg, time, duration);
+
+  if (!isSwingFootTrajectoryToBePlanned_[leg.getId()]) {
+    swingFootTrajectories_[leg.getId()].updateTarget(time, positionHipToDesiredFootHoldInControlFrame, parameters_.swingFootTrajectoryRefitThreshold_);
+    return;
+  }
+
+  const RotationQuaternion& orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+  double heightStart = 0.0;
+  double heightApex = 0.0;
+  double heightTarget = 0.0;
+  double apexPhase = 0.5;
+  getSwingFootHeights(leg, heightStart, heightApex, heightTarget, apexPhase);
+
+  //--- starting point of the swing trajectory, the current foot position if the trajectory is planned after lift-off
+  Position positionHipToFootStartInControlFrame = orientationWorldToControl.rotate(Position(leg.getStateLiftOff().getPositionWorldToFootInWorldFrame()
+                                                                                            - leg.getStateLiftOff().getPositionWorldToHipInWorldFrame()));
+  if (time > 0.0) {
+    const Position defaultHipToFootInControlFrame = leg.getProperties().getDesiredDefaultSteppingPositionHipToFootInControlFrame();
+    positionHipToFootStartInControlFrame = orientationWorldToControl.rotate(Position(leg.getPositionWorldToFootInWorldFrame() - leg.getPositionWorldToHipInWorldFrame()))
+                                           - defaultHipToFootInControlFrame;
+    heightStart = orientationWorldToControl.rotate(leg.getPositionWorldToFootInWorldFrame()).z();
+  }
+  //---
+
+  swingFootTrajectories_[leg.getId()].plan(time, duration,
+                                           positionHipToFootStartInControlFrame,
+                                           positionHipToDesiredFootHoldInControlFrame,
+                                           heightStart, heightApex, heightTarget, apexPhase);
+  isSwingFootTrajectoryToBePlanned_[leg.getId()] = false;
+}
+
+
+const LinearVelocity& FootPlacementStrategyInvertedPendulum::getLinearVelocityHipToDesiredFootInWorldFrame(const LegBase& leg) const {
+  return linearVelocityHipToDesiredFootInWorldFrame_[leg.getId()];
+}
+
+
+const LinearAcceleration& FootPlacementStrategyInvertedPendulum::getLinearAccelerationHipToDesiredFootInWorldFrame(const LegBase& leg) const {
+  return linearAccelerationHipToDesiredFootInWorldFrame_[leg.getId()];
+}
+
+
 const LegGroup& FootPlacementStrategyInvertedPendulum::getLegs() const {
   return *legs_;
 }
@@ -529,7 +634,7 @@ const LegGroup& FootPlacementStrategyInvertedPendulum::getLegs() const {
 bool FootPlacementStrategyInvertedPendulum::setToInterpolated(const FootPlacementStrategyBase& footPlacementStrategy1, const FootPlacementStrategyBase& footPlacementStrategy2, double t) {
   const FootPlacementStrategyInvertedPendulum& footPlacement1 = static_cast<const FootPlacementStrategyInvertedPendulum&>(footPlacementStrategy1);
   const FootPlacementStrategyInvertedPendulum& footPlacement2 = static_cast<const FootPlacementStrategyInvertedPendulum&>(footPlacementStrategy2);
-  this->stepFeedbackScale_ = linearlyInterpolate(footPlacement1.stepFeedbackScale_, footPlacement2.stepFeedbackScale_, 0.0, 1.0, t);
+  /* the step feedback scale is interpolated by the parameter vector (see addParametersToVector) */
 //  if (!interpolateHeightTrajectory(this->swingFootHeightTrajectory_, footPlacement1.swingFootHeightTrajectory_, footPlacement2.swingFootHeightTrajectory_, t)) {
 //    return false;
 //  }
@@ -548,6 +653,19 @@ bool FootPlacementStrategyInvertedPendulum::setToInterpolated(const FootPlacemen
   return true;
 }
 
+bool FootPlacementStrategyInvertedPendulum::addParametersToVector(ParameterVector* parameterVector) {
+  std::vector<double*> parameters;
+  parameters.push_back(&parameters_.stepFeedbackScale_);
+  for (auto leg : *legs_) {
+    Position& defaultSteppingPosition = leg->getProperties().getDesiredDefaultSteppingPositionHipToFootInControlFrame();
+    for (int k=0; k<3; k++) {
+      parameters.push_back(&defaultSteppingPosition.toImplementation()(k));
+    }
+  }
+  parameterVector->addSlice("FootPlacementStrategyInvertedPendulum", parameters);
+  return true;
+}
+
 bool FootPlacementStrategyInvertedPendulum::interpolateHeightTrajectory(rbf::BoundedRBF1D& interpolatedTrajectory, const rbf::BoundedRBF1D& trajectory1, const rbf::BoundedRBF1D& trajectory2, double t) {
 
   const int nKnots = std::max<int>(trajectory1.getKnotCount(), trajectory2.getKnotCount());
@@ -576,4 +694,9 @@ const Position& FootPlacementStrategyInvertedPendulum::getPositionWorldToDesired
   return positionWorldToFootHoldInWorldFrame_[leg->getId()];
 }
 
+bool FootPlacementStrategyInvertedPendulum::getPositionWorldToFootHoldInWorldFrame(int legId, Position& positionWorldToFootHoldInWorldFrame) const {
+  positionWorldToFootHoldInWorldFrame = positionWorldToFootHoldInWorldFrame_[legId];
+  return true;
+}
+
 } // namespace loco
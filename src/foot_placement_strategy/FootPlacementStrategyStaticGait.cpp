@@ -43,15 +43,6 @@
 #include "loco/foot_placement_strategy/FootPlacementStrategyStaticGait.hpp"
 #include "robotUtils/loggers/logger.hpp"
 
-
-/****************************
- * Includes for ROS service *
- ****************************/
-#include <ctime>
-#include <ratio>
-#include <chrono>
-/****************************/
-
 const bool DEBUG_FPS = false;
 
 namespace loco {
@@ -71,11 +62,13 @@ FootPlacementStrategyStaticGait::FootPlacementStrategyStaticGait(LegGroup* legs,
     mustValidateNextFootHold_(false),
     validationRequestSent_(false),
     validationReceived_(false),
-    useRosService_(false),
+    useFootholdValidation_(false),
+    useFootholdValidationOnInitialize_(false),
+    footholdValidator_(nullptr),
+    terrainModelFootholdValidator_(nullptr),
+    validatingLegId_(-1),
     defaultMaxStepLength_(0.0),
     footStepNumber_(0),
-    rosWatchdogCounter_(0.0),
-    rosWatchdogLimit_(0.125*(legs_->getLeftForeLeg()->getStanceDuration()+legs_->getLeftForeLeg()->getStanceDuration())),
     firstFootHoldAfterStand_(legs_->size())
 {
 
@@ -83,7 +76,7 @@ FootPlacementStrategyStaticGait::FootPlacementStrategyStaticGait(LegGroup* legs,
   stepInterpolationFunction_.addKnot(0, 0);
   stepInterpolationFunction_.addKnot(1.0, 1);
 
-  stepFeedbackScale_ = 0.0;
+  parameters_.stepFeedbackScale_ = 0.0;
 
   positionWorldToCenterOfValidatedFeetInWorldFrame_ = Position();
 
@@ -101,19 +94,13 @@ FootPlacementStrategyStaticGait::FootPlacementStrategyStaticGait(LegGroup* legs,
     firstFootHoldAfterStand_[leg->getId()] = leg->isInStandConfiguration();
   }
 
-  serviceTestCounter_ = 0;
-
-
-#ifdef USE_ROS_SERVICE
-  if (useRosService_) {
-    printf("FootPlacementStrategyStaticGait: uses ros service\n");
-  }
-#endif
+  terrainModelFootholdValidator_ = new FootholdValidatorTerrainModel(terrain);
+  footholdValidator_ = terrainModelFootholdValidator_;
 }
 
 
 FootPlacementStrategyStaticGait::~FootPlacementStrategyStaticGait() {
-
+  delete terrainModelFootholdValidator_;
 }
 
 
@@ -121,12 +108,20 @@ void FootPlacementStrategyStaticGait::setCoMControl(CoMOverSupportPolygonControl
   comControl_ = static_cast<CoMOverSupportPolygonControlStaticGait*>(comControl);
 }
 
-bool FootPlacementStrategyStaticGait::isUsingRosService() {
-  return useRosService_;
+bool FootPlacementStrategyStaticGait::isUsingFootholdValidation() {
+  return useFootholdValidation_;
+}
+
+void FootPlacementStrategyStaticGait::setUseFootholdValidation(bool useFootholdValidation) {
+  useFootholdValidation_ = useFootholdValidation;
+}
+
+void FootPlacementStrategyStaticGait::setFootholdValidator(FootholdValidatorBase* footholdValidator) {
+  footholdValidator_ = (footholdValidator == nullptr) ? terrainModelFootholdValidator_ : footholdValidator;
 }
 
-void FootPlacementStrategyStaticGait::setUseRosService(bool useRosService) {
-  useRosService_ = useRosService;
+FootholdValidatorBase* FootPlacementStrategyStaticGait::getFootholdValidator() {
+  return footholdValidator_;
 }
 
 
@@ -134,13 +129,10 @@ bool FootPlacementStrategyStaticGait::initialize(double dt) {
   //FootPlacementStrategyFreePlane::initialize(dt);
   initLogger();
 
-  useRosService_ = false;
-
-  rosWatchdogCounter_ = 0.0;
-  rosWatchdogLimit_ = 0.125*7.0*0.5;
-  std::cout << "ros wd limit: " << rosWatchdogLimit_ << std::endl;
+  useFootholdValidation_ = useFootholdValidationOnInitialize_;
 
   footStepNumber_ = 0;
+  validatingLegId_ = -1;
 
   goToStand_ = true;
   resumeWalking_ = false;
@@ -183,147 +175,52 @@ void FootPlacementStrategyStaticGait::initLogger() {
 
 
 bool FootPlacementStrategyStaticGait::sendValidationRequest(const int legId, const Position& positionWorldToDesiredFootHoldInWorldFrame) {
-  bool ready = true;
-
-#ifdef USE_ROS_SERVICE
-  robotUtils::RosService::ServiceType srv;
-  ready = footholdRosService_.isReadyForRequest();
-    if (ready) {
-      std::cout << "validating position: " << positionWorldToDesiredFootHoldInWorldFrame << " for leg: " << legId << std::endl;
-        foothold_finding_msg::Foothold foothold;
-        foothold.header.seq = serviceTestCounter_;
-        foothold.header.frame_id = "/starleth/odometry";
-        struct timeval timeofday;
-        gettimeofday(&timeofday,NULL);
-        foothold.header.stamp.sec  = timeofday.tv_sec;
-        foothold.header.stamp.nsec = timeofday.tv_usec * 1000;
-        foothold.stepNumber = ++footStepNumber_;   // step number
-
-        std::string legName;
-        switch(legId) {
-          case(0): legName = "LF"; break;
-          case(1): legName = "RF"; break;
-          case(2): legName = "LH"; break;
-          case(3): legName = "RH"; break;
-          default: break;
-        }
-
-        //foothold.type.data = legName;
-	foothold.type = legName;
-        foothold.pose.position.x = positionWorldToDesiredFootHoldInWorldFrame.x(); // required
-        foothold.pose.position.y = positionWorldToDesiredFootHoldInWorldFrame.y(); // required
-        foothold.pose.position.z = positionWorldToDesiredFootHoldInWorldFrame.z();
-
-        foothold.pose.orientation.w = 1.0; // surface normal
-        foothold.pose.orientation.x = 0.0;
-        foothold.pose.orientation.y = 0.0;
-        foothold.pose.orientation.z = 0.0;
-
-        foothold.flag = 0;      // 0: unknown, 1: do not change position, 2: verified, 3: bad)
-        srv.request.initialFootholds.push_back(foothold);
-
-        if (!footholdRosService_.sendRequest(srv)) {
-          std::cout << "Could not send request!\n";
-          return false;
-        }
-    }// if serviceTestCounter
-    else {
-//      std::cout << "Service is not ready for request!" << std::endl;
-    }
-#endif
+  if (footholdValidator_ == nullptr) {
+    return false;
+  }
 
-  return ready;
+  FootholdValidationRequest request;
+  request.legId_ = legId;
+  request.stepNumber_ = footStepNumber_+1;
+  request.positionWorldToDesiredFootHoldInWorldFrame_ = positionWorldToDesiredFootHoldInWorldFrame;
+  if (!footholdValidator_->sendRequest(request)) {
+    return false;
+  }
+  footStepNumber_ = request.stepNumber_;
+  return true;
 }
 
 
 bool FootPlacementStrategyStaticGait::getValidationResponse(Position& positionWorldToValidatedFootHoldInWorldFrame) {
-  bool success = false;
-
-#ifdef USE_ROS_SERVICE
-  robotUtils::RosService::ServiceType srv;
-  if (footholdRosService_.hasReceivedResponse()) {
-    bool isValid;
-    if (footholdRosService_.receiveResponse(srv, isValid)) {
-      if (isValid) {
-        success = true;
-//        std::cout << "Received request:\n";
-
-       if (!srv.response.adaptedFootholds.empty() ){
-
-         foothold_finding_msg::Foothold receviedFoothold = srv.response.adaptedFootholds[0];
-
-//         std::cout << "header.seq: " << receviedFoothold.header.seq << std::endl;
-//         std::cout << "header.stamp: " << receviedFoothold.header.stamp.sec << "." << receviedFoothold.header.stamp.nsec << std::endl;
-//         std::cout << "data: " << receviedFoothold.type.data << std::endl;
-
-         // save validated foothold
-         positionWorldToValidatedFootHoldInWorldFrame.x() = receviedFoothold.pose.position.x;
-         positionWorldToValidatedFootHoldInWorldFrame.y() = receviedFoothold.pose.position.y;
-         positionWorldToValidatedFootHoldInWorldFrame.z() = receviedFoothold.pose.position.z;
-
-         int legId = -1;
-
-         //std::string dataField = receviedFoothold.type.data;
-	std::string dataField = receviedFoothold.type;
-
-         switch(receviedFoothold.flag) {
-           case(0):
-              std::cout << "unknown" << std::endl;
-              if (dataField.compare("LF") == 0) {
-                legId = 0;
-              } else if (dataField.compare("RF") == 0) {
-                legId = 1;
-              } else if (dataField.compare("LH") == 0) {
-                legId = 2;
-              } else if (dataField.compare("RH") == 0) {
-                legId = 3;
-              }
-           break;
-           case(1):
-                std::cout << "do not change" << std::endl;
-           break;
-           case(2):{
-                std::cout << "verified" << std::endl;
-//             std::cout << "data: " << receviedFoothold.type.data << std::endl;
-              if ( dataField.compare("LF") == 0 ) {
-                legId = 0;
-              } else if ( dataField.compare("RF") == 0 ) {
-                legId = 1;
-              } else if ( dataField.compare("LH") == 0 ) {
-                legId = 2;
-              } else if ( dataField.compare("RH") == 0 ) {
-                legId = 3;
-              }
-//              std::cout << "leg id: " << legId << std::endl;
-           }
-           break;
-           case(3):
-               std::cout << "bad" << std::endl;
-           break;
-           default: break;
-         }
-
-         if (legId != -1) {
-//           std::cout << "leg id:    " << legId << std::endl;
-//           std::cout << "rec state: " << (int)receviedFoothold.flag << std::endl;
-           std::cout << "Setting validated foothold to leg: " << legId << std::endl
-                     << "difference: " << positionWorldToValidatedFootHoldInWorldFrame - positionWorldToFootHoldInWorldFrame_[legId] << std::endl;
-           positionWorldToValidatedDesiredFootHoldInWorldFrame_[legId] = positionWorldToValidatedFootHoldInWorldFrame;
-           comControl_->setFootHold(legId, positionWorldToValidatedFootHoldInWorldFrame);
-         }
-
-       }
+  if (footholdValidator_ == nullptr) {
+    return false;
+  }
 
-      }
-      else {
-        std::cout << "Received error!\n" << std::endl;
-      }
+  FootholdValidationResponse response;
+  while (footholdValidator_->receiveResponse(response)) {
+    /* skip responses of previous steps that arrived too late */
+    if (response.stepNumber_ != footStepNumber_) {
+      continue;
+    }
+
+    const int legId = response.legId_;
+    switch (response.flag_) {
+      case FootholdUnknown:
+      case FootholdVerified: {
+        positionWorldToValidatedDesiredFootHoldInWorldFrame_[legId] = response.positionWorldToValidatedFootHoldInWorldFrame_;
+      } break;
+      case FootholdDoNotChange:
+      case FootholdBad:
+      default:
+        /* keep the generated foothold */
+        break;
     }
+    positionWorldToValidatedFootHoldInWorldFrame = positionWorldToValidatedDesiredFootHoldInWorldFrame_[legId];
+    comControl_->setFootHold(legId, positionWorldToValidatedFootHoldInWorldFrame);
+    return true;
   }
-  serviceTestCounter_++;
-#endif
 
-  return success;
+  return false;
 }
 
 
@@ -373,7 +270,7 @@ bool FootPlacementStrategyStaticGait::advance(double dt) {
 
 
   for (auto leg: *legs_) {
-    if (leg->getStateTouchDown()->isNow()) {
+    if (DEBUG_FPS && leg->getStateTouchDown()->isNow()) {
       std::cout << "leg: " << leg->getId() << " did touchdown. " << std::endl
                 << "des fh: " << positionWorldToValidatedDesiredFootHoldInWorldFrame_[leg->getId()] << std::endl
                 << "td  fh: " << leg->getStateTouchDown()->getFootPositionInWorldFrame() << std::endl
@@ -413,26 +310,8 @@ bool FootPlacementStrategyStaticGait::advance(double dt) {
 
     if (resumeWalking_ && comControl_->isSafeToResumeWalking()) {
 
-      // generate foothold
-      generateFootHold(nextSwingLeg);
-
-      // Reset ROS flags after foothold generation
-      mustValidateNextFootHold_ = true;
-      rosWatchdogCounter_ = 0.0;
-      validationRequestSent_ = false;
-      validationReceived_ = false;
-      footHoldPlanned_ = true;
-
-      // send the generated foothold to the ROS validation service
-//      sendValidationRequest(nextSwingLegId_, positionWorldToFootHoldInWorldFrame_[nextSwingLegId_]);
-
-      // old code
-//#ifndef USE_ROS_SERVICE
-      if (!useRosService_) {
-        positionWorldToValidatedDesiredFootHoldInWorldFrame_[nextSwingLegId_] = positionWorldToFootHoldInWorldFrame_[nextSwingLegId_];
-        comControl_->setFootHold(nextSwingLegId_, positionWorldToValidatedDesiredFootHoldInWorldFrame_[nextSwingLegId_]);
-      }
-//#endif
+      // generate foothold and start its validation
+      planFootHold(nextSwingLeg);
 
       /**********************************************************************************************************************************
        * temporary solution:        when going backwards, use a smaller distance for safe triangle evaluation.                          *
@@ -463,57 +342,11 @@ bool FootPlacementStrategyStaticGait::advance(double dt) {
   /************************************************/
 
 
-  /*********************
-   * Query ROS service *
-   *********************/
-#ifdef USE_ROS_SERVICE
-  if (useRosService_ && mustValidateNextFootHold_) {
-
-    if (!validationRequestSent_) {
-      validationRequestSent_ = sendValidationRequest(nextSwingLegId_, positionWorldToFootHoldInWorldFrame_[nextSwingLegId_]);
-      if (validationRequestSent_) {
-        std::cout << "sent request!" << std::endl;
-      }
-      else {
-#ifdef USE_ROS_SERVICE
-//        std::cout << "service was not ready. state: " << footholdRosService_.getState() << std::endl;
-#endif
-      }
-    }
-
-    if (validationRequestSent_ && !validationReceived_) {
-      if (getValidatedFootHold(nextSwingLegId_, positionWorldToFootHoldInWorldFrame_[nextSwingLegId_])) {
-        std::cout << "got validation! time: " << rosWatchdogCounter_ << std::endl;
-        validationReceived_ = true;
-        mustValidateNextFootHold_ = false;
-      }
-    }
-    rosWatchdogCounter_ += dt;
-
-
-    //if (currentSwingLeg->getSwingPhase() > 0.5 && !validationReceived_) {
-    if (currentSwingLeg->getSwingPhase() > 0.8 && !validationReceived_) {
-      std::cout << "leg id: " << currentSwingLeg->getId() << ". valid not received and swing phase is: " << currentSwingLeg->getSwingPhase() << std::endl;
-      footholdRosService_.resetState();
-      validationReceived_ = true;
-      mustValidateNextFootHold_ = false;
-    }
-//    if (rosWatchdogCounter_ >= rosWatchdogLimit_) {
-//      std::cout << "*******ros watchdog limit: " << rosWatchdogCounter_ << std::endl;
-//
-//      std::cout << "state: " << footholdRosService_.getState() << std::endl;
-//
-//      mustValidateNextFootHold_ = false;
-//
-//      validationRequestSent_ = false;
-//      rosWatchdogCounter_ = 0.0;
-//      validationReceived_ = false;
-//      footHoldPlanned_ = true;
-//    }
-
-  }
-#endif
-  /*********************/
+  /*******************************
+   * Query the foothold validator *
+   *******************************/
+  updateFootHoldValidation(*currentSwingLeg);
+  /*******************************/
 
 
   /*********************************************
@@ -546,7 +379,7 @@ bool FootPlacementStrategyStaticGait::advance(double dt) {
 
 
 void FootPlacementStrategyStaticGait::setFootTrajectory(LegBase* leg) {
-  const Position positionWorldToFootInWorldFrame = getDesiredWorldToFootPositionInWorldFrame(leg, 0.0);
+  const Position positionWorldToFootInWorldFrame = getDesiredWorldToFootPositionInWorldFrame(leg);
   leg->setDesireWorldToFootPositionInWorldFrame(positionWorldToFootInWorldFrame); // for debugging
   const Position positionBaseToFootInWorldFrame = positionWorldToFootInWorldFrame - torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame();
   const Position positionBaseToFootInBaseFrame  = torso_->getMeasuredState().getOrientationWorldToBase().rotate(positionBaseToFootInWorldFrame);
@@ -596,11 +429,80 @@ Position FootPlacementStrategyStaticGait::generateFootHold(LegBase* leg) {
   // update class member and get correct terrain height at foot hold
   positionWorldToFootHoldInWorldFrame_[leg->getId()] = positionWorldToFootHoldInWorldFrame;
   terrain_->getHeight(positionWorldToFootHoldInWorldFrame_[leg->getId()]);
+  positionWorldToNominalFootHoldInWorldFrame_[leg->getId()] = positionWorldToFootHoldInWorldFrame_[leg->getId()];
+
+  // move the foot hold to better terrain, the other feet span the support polygon during the swing
+  if (footholdOptimizer_ != nullptr) {
+    FootholdOptimizationProblem problem;
+    problem.positionWorldToNominalFootholdInWorldFrame_ = positionWorldToFootHoldInWorldFrame_[leg->getId()];
+    problem.positionWorldToHipInWorldFrame_ = leg->getPositionWorldToHipInWorldFrame();
+    problem.positionWorldToCenterOfMassInWorldFrame_ = getPositionWorldToCenterOfMassInWorldFrame();
+    for (auto supportLeg : *legs_) {
+      if (supportLeg != leg) {
+        problem.positionWorldToSupportFeetInWorldFrame_[problem.numberOfSupportFeet_++] = supportLeg->getPositionWorldToFootInWorldFrame();
+      }
+    }
+    FootholdOptimizationResult result;
+    if (footholdOptimizer_->optimize(problem, result)) {
+      positionWorldToFootHoldInWorldFrame_[leg->getId()] = result.positionWorldToFootholdInWorldFrame_;
+    }
+    positionNominalFootHoldToOptimizedFootHoldInWorldFrame_[leg->getId()] = positionWorldToFootHoldInWorldFrame_[leg->getId()]
+                                                                            - positionWorldToNominalFootHoldInWorldFrame_[leg->getId()];
+  }
 
   return positionWorldToFootHoldInWorldFrame_[leg->getId()];
 }
 
 
+void FootPlacementStrategyStaticGait::planFootHold(LegBase* leg) {
+  const int legId = leg->getId();
+  generateFootHold(leg);
+
+  // Reset validation flags after foothold generation
+  mustValidateNextFootHold_ = useFootholdValidation_ && (footholdValidator_ != nullptr);
+  validationRequestSent_ = false;
+  validationReceived_ = false;
+  validatingLegId_ = legId;
+  footHoldPlanned_ = true;
+
+  // the swing trajectory uses the generated foothold until a validated one is received
+  positionWorldToValidatedDesiredFootHoldInWorldFrame_[legId] = positionWorldToFootHoldInWorldFrame_[legId];
+  if (!mustValidateNextFootHold_) {
+    comControl_->setFootHold(legId, positionWorldToValidatedDesiredFootHoldInWorldFrame_[legId]);
+  }
+}
+
+
+void FootPlacementStrategyStaticGait::updateFootHoldValidation(const LegBase& currentSwingLeg) {
+  if (!mustValidateNextFootHold_) {
+    return;
+  }
+
+  if (!validationRequestSent_) {
+    validationRequestSent_ = sendValidationRequest(validatingLegId_, positionWorldToFootHoldInWorldFrame_[validatingLegId_]);
+  }
+
+  // without worker thread, the requests are validated on the control thread
+  if (validationRequestSent_ && !footholdValidator_->isRunning()) {
+    footholdValidator_->processRequests();
+  }
+
+  if (validationRequestSent_ && !validationReceived_) {
+    if (getValidatedFootHold(validatingLegId_, positionWorldToFootHoldInWorldFrame_[validatingLegId_])) {
+      validationReceived_ = true;
+      mustValidateNextFootHold_ = false;
+    }
+  }
+
+  // give up if the response is too late, the generated foothold is used
+  if (currentSwingLeg.getSwingPhase() > 0.8 && !validationReceived_) {
+    comControl_->setFootHold(validatingLegId_, positionWorldToValidatedDesiredFootHoldInWorldFrame_[validatingLegId_]);
+    validationReceived_ = true;
+    mustValidateNextFootHold_ = false;
+  }
+}
+
+
 /*
  * Check if a desired foothold is valid. Return a validated foothold.
  */
@@ -618,7 +520,7 @@ bool FootPlacementStrategyStaticGait::getValidatedFootHold(const int legId, cons
 /*
  * Foot holds are evaluated with respect to the foot positions at generation time.
  */
-Position FootPlacementStrategyStaticGait::getDesiredWorldToFootPositionInWorldFrame(LegBase* leg, double tinyTimeStep) {
+Position FootPlacementStrategyStaticGait::getDesiredWorldToFootPositionInWorldFrame(LegBase* leg) {
   RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
 
   // get the actual (validated) step that must be taken
@@ -676,7 +578,7 @@ Position FootPlacementStrategyStaticGait::getPositionWorldToValidatedDesiredFoot
  */
 Position FootPlacementStrategyStaticGait::getPositionDesiredFootOnTerrainToDesiredFootInControlFrame(const LegBase& leg, const Position& positionHipOnTerrainToDesiredFootOnTerrainInControlFrame)  {
   const double interpolationParameter = getInterpolationPhase(leg);
-  const double desiredFootHeight = const_cast<SwingFootHeightTrajectory*>(&swingFootHeightTrajectory_)->evaluate(interpolationParameter);
+  const double desiredFootHeight = swingFootHeightTrajectory_.evaluate(interpolationParameter, swingFootHeightTrajectoryCursors_[leg.getId()]);
 
   RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
   Position positionHipOnTerrainToDesiredFootOnTerrainInWorldFrame = orientationWorldToControl.inverseRotate(positionHipOnTerrainToDesiredFootOnTerrainInControlFrame);
@@ -788,6 +690,29 @@ bool FootPlacementStrategyStaticGait::loadParameters(const TiXmlHandle& handle)
     return false;
   }
 
+  /* validation of the footholds against the terrain model, optional */
+  pElem = hFPS.FirstChild("FootholdValidation").Element();
+  useFootholdValidationOnInitialize_ = false;
+  if (pElem) {
+    double searchRadius = 0.1;
+    double searchResolution = 0.025;
+    double footRadius = 0.03;
+    double maxRoughness = 0.02;
+    double maxSlope = 30.0*M_PI/180.0;
+    double minFriction = 0.3;
+    pElem->QueryBoolAttribute("enable", &useFootholdValidationOnInitialize_);
+    pElem->QueryDoubleAttribute("searchRadius", &searchRadius);
+    pElem->QueryDoubleAttribute("searchResolution", &searchResolution);
+    pElem->QueryDoubleAttribute("footRadius", &footRadius);
+    pElem->QueryDoubleAttribute("maxRoughness", &maxRoughness);
+    pElem->QueryDoubleAttribute("maxSlope", &maxSlope);
+    pElem->QueryDoubleAttribute("minFriction", &minFriction);
+    if (!terrainModelFootholdValidator_->setParameters(searchRadius, searchResolution, footRadius, maxRoughness, maxSlope, minFriction)) {
+      printf("*******Invalid parameters of FootPlacementStrategy:StaticGait:FootholdValidation\n");
+      return false;
+    }
+  }
+
   return success;
 
 }
@@ -0,0 +1,452 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdOptimizer.cpp
+* @brief
+*/
+
+#include "loco/foot_placement_strategy/FootholdOptimizer.hpp"
+#include "loco/common/ConvexPolygon.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace loco {
+
+FootholdOptimizer::FootholdOptimizer(TerrainModelBase* terrain):
+  terrain_(terrain),
+  spacing_(0.02),
+  halfWidth_(5),
+  minNormalZ_(std::cos(35.0*M_PI/180.0)),
+  maxRoughness_(0.02),
+  edgeHeight_(0.04),
+  footRadius_(0.03),
+  maxLegLength_(0.55),
+  distanceWeight_(5.0),
+  slopeWeight_(1.0),
+  roughnessWeight_(1.0),
+  edgeWeight_(1.0),
+  edgeClearance_(0.08),
+  reachabilityWeight_(1.0),
+  supportMarginWeight_(1.0),
+  supportMargin_(0.05),
+  previousFootholdWeight_(2.0),
+  timeBudget_(0.0005),
+  generation_(0),
+  isStopping_(false),
+  problems_(nullptr),
+  results_(nullptr),
+  numberOfJobs_(0),
+  numberOfActiveWorkers_(0),
+  nextJob_(0),
+  numberOfDoneJobs_(0)
+{
+  setGrid(spacing_, halfWidth_);
+}
+
+
+FootholdOptimizer::~FootholdOptimizer() {
+  stopWorkers();
+}
+
+
+bool FootholdOptimizer::setGrid(double spacing, int halfWidth) {
+  if (spacing <= 0.0 || halfWidth < 0) {
+    printf("FootholdOptimizer: invalid grid!\n");
+    return false;
+  }
+  spacing_ = spacing;
+  halfWidth_ = halfWidth;
+
+  const int nSamples = 2*halfWidth_+3;
+  const int center = halfWidth_+1;
+  offsetX_.resize(nSamples, nSamples);
+  offsetY_.resize(nSamples, nSamples);
+  for (int i=0; i<nSamples; i++) {
+    for (int j=0; j<nSamples; j++) {
+      offsetX_(i,j) = (i-center)*spacing_;
+      offsetY_(i,j) = (j-center)*spacing_;
+    }
+  }
+
+  /* rows are sampled from the nominal foothold outwards */
+  rowOrder_.clear();
+  rowOrder_.push_back(center);
+  for (int k=1; k<=center; k++) {
+    rowOrder_.push_back(center-k);
+    rowOrder_.push_back(center+k);
+  }
+  return true;
+}
+
+
+bool FootholdOptimizer::setLimits(double maxSlope, double maxRoughness, double edgeHeight, double footRadius, double maxLegLength) {
+  if (maxSlope < 0.0 || maxRoughness <= 0.0 || edgeHeight <= 0.0 || footRadius < 0.0 || maxLegLength <= 0.0) {
+    printf("FootholdOptimizer: invalid limits!\n");
+    return false;
+  }
+  minNormalZ_ = std::cos(maxSlope);
+  maxRoughness_ = maxRoughness;
+  edgeHeight_ = edgeHeight;
+  footRadius_ = footRadius;
+  maxLegLength_ = maxLegLength;
+  return true;
+}
+
+
+void FootholdOptimizer::setWeights(double distanceWeight, double slopeWeight, double roughnessWeight,
+                                   double edgeWeight, double edgeClearance,
+                                   double reachabilityWeight, double supportMarginWeight, double supportMargin,
+                                   double previousFootholdWeight) {
+  distanceWeight_ = distanceWeight;
+  slopeWeight_ = slopeWeight;
+  roughnessWeight_ = roughnessWeight;
+  edgeWeight_ = edgeWeight;
+  edgeClearance_ = std::max(edgeClearance, 1.0e-6);
+  reachabilityWeight_ = reachabilityWeight;
+  supportMarginWeight_ = supportMarginWeight;
+  supportMargin_ = std::max(supportMargin, 1.0e-6);
+  previousFootholdWeight_ = previousFootholdWeight;
+}
+
+
+void FootholdOptimizer::setTimeBudget(double timeBudget) {
+  timeBudget_ = timeBudget;
+}
+
+
+double FootholdOptimizer::getTimeBudget() const {
+  return timeBudget_;
+}
+
+
+void FootholdOptimizer::setNumberOfThreads(int numberOfThreads) {
+  stopWorkers();
+  if (numberOfThreads > 1) {
+    startWorkers(numberOfThreads-1);
+  }
+}
+
+
+int FootholdOptimizer::getNumberOfThreads() const {
+  return workers_.size()+1;
+}
+
+
+int FootholdOptimizer::getNumberOfCandidates() const {
+  return (2*halfWidth_+1)*(2*halfWidth_+1);
+}
+
+
+bool FootholdOptimizer::optimize(const FootholdOptimizationProblem& problem, FootholdOptimizationResult& result) {
+  if (workspaces_.empty()) {
+    workspaces_.resize(1);
+  }
+  deadline_ = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeBudget_));
+  optimizeLeg(problem, result, workspaces_[0]);
+  return result.isFeasible_;
+}
+
+
+bool FootholdOptimizer::optimize(const std::vector<FootholdOptimizationProblem>& problems, std::vector<FootholdOptimizationResult>& results) {
+  results.resize(problems.size());
+  if (workspaces_.size() < problems.size()) {
+    workspaces_.resize(problems.size());
+  }
+  const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeBudget_));
+
+  if (workers_.empty() || problems.size() < 2) {
+    deadline_ = deadline;
+    for (int k=0; k<(int)problems.size(); k++) {
+      optimizeLeg(problems[k], results[k], workspaces_[k]);
+    }
+  }
+  else {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      deadline_ = deadline;
+      problems_ = &problems;
+      results_ = &results;
+      numberOfJobs_ = problems.size();
+      nextJob_ = 0;
+      numberOfDoneJobs_ = 0;
+      generation_++;
+    }
+    jobsAvailable_.notify_all();
+    runJobs();
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobsDone_.wait(lock, [this]() { return numberOfDoneJobs_ == numberOfJobs_ && numberOfActiveWorkers_ == 0; });
+  }
+
+  bool isFeasible = true;
+  for (const FootholdOptimizationResult& result : results) {
+    isFeasible &= result.isFeasible_;
+  }
+  return isFeasible;
+}
+
+
+void FootholdOptimizer::resizeWorkspace(Workspace& workspace) const {
+  const int nSamples = offsetX_.rows();
+  if (workspace.height_.rows() == nSamples) {
+    return;
+  }
+  workspace.positions_.resize(nSamples);
+  workspace.heights_.resize(nSamples);
+  workspace.normals_.resize(nSamples);
+  workspace.height_.resize(nSamples, nSamples);
+  workspace.normalX_.resize(nSamples, nSamples);
+  workspace.normalY_.resize(nSamples, nSamples);
+  workspace.normalZ_.resize(nSamples, nSamples);
+  workspace.isValid_.resize(nSamples, nSamples);
+  workspace.roughness_.resize(nSamples-2, nSamples-2);
+  workspace.edgeDistanceSquared_.resize(nSamples-2, nSamples-2);
+  workspace.cost_.resize(nSamples-2, nSamples-2);
+}
+
+
+void FootholdOptimizer::sampleTerrain(const FootholdOptimizationProblem& problem, Workspace& workspace, int& numberOfSampledRows) const {
+  const int nSamples = offsetX_.rows();
+  const Position& positionWorldToNominalFootholdInWorldFrame = problem.positionWorldToNominalFootholdInWorldFrame_;
+  workspace.isValid_.setZero();
+  workspace.height_.setZero();
+  workspace.normalX_.setZero();
+  workspace.normalY_.setZero();
+  workspace.normalZ_.setOnes();
+
+  numberOfSampledRows = 0;
+  for (int i : rowOrder_) {
+    if (numberOfSampledRows > 0 && Clock::now() > deadline_) {
+      break;
+    }
+    for (int j=0; j<nSamples; j++) {
+      workspace.positions_[j] = Position(positionWorldToNominalFootholdInWorldFrame.x()+offsetX_(i,j),
+                                         positionWorldToNominalFootholdInWorldFrame.y()+offsetY_(i,j),
+                                         positionWorldToNominalFootholdInWorldFrame.z());
+    }
+
+    /* one batch query per row, the samples are only checked one by one if the row leaves the terrain model */
+    const bool isRowValid = terrain_->getHeights(workspace.positions_, workspace.heights_)
+                            && terrain_->getNormals(workspace.positions_, workspace.normals_);
+    for (int j=0; j<nSamples; j++) {
+      bool isValid = isRowValid;
+      if (!isRowValid) {
+        isValid = terrain_->getHeight(workspace.positions_[j], workspace.heights_[j])
+                  && terrain_->getNormal(workspace.positions_[j], workspace.normals_[j]);
+      }
+      if (isValid) {
+        workspace.isValid_(i,j) = 1.0;
+        workspace.height_(i,j) = workspace.heights_[j];
+        workspace.normalX_(i,j) = workspace.normals_[j].x();
+        workspace.normalY_(i,j) = workspace.normals_[j].y();
+        workspace.normalZ_(i,j) = std::max(workspace.normals_[j].z(), 1.0e-6);
+      }
+    }
+    numberOfSampledRows++;
+  }
+}
+
+
+void FootholdOptimizer::optimizeLeg(const FootholdOptimizationProblem& problem, FootholdOptimizationResult& result, Workspace& workspace) const {
+  resizeWorkspace(workspace);
+  int numberOfSampledRows = 0;
+  sampleTerrain(problem, workspace, numberOfSampledRows);
+
+  const int m = offsetX_.rows()-2;
+  const Position& positionWorldToNominalFootholdInWorldFrame = problem.positionWorldToNominalFootholdInWorldFrame_;
+
+  /* candidates are the inner samples, the outer ring only provides neighbours */
+  const auto offsetX = offsetX_.block(1, 1, m, m);
+  const auto offsetY = offsetY_.block(1, 1, m, m);
+  const auto height = workspace.height_.block(1, 1, m, m);
+  const auto normalX = workspace.normalX_.block(1, 1, m, m);
+  const auto normalY = workspace.normalY_.block(1, 1, m, m);
+  const auto normalZ = workspace.normalZ_.block(1, 1, m, m);
+  Grid& roughness = workspace.roughness_;
+  Grid& cost = workspace.cost_;
+
+  result.numberOfEvaluatedCandidates_ = (workspace.isValid_.block(1, 1, m, m) > 0.0).count();
+
+  /* roughness and height steps from the four neighbours */
+  Grid isValid = workspace.isValid_.block(1, 1, m, m);
+  Grid heightStep = Grid::Zero(m, m);
+  roughness.setZero();
+  const int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+  for (int k=0; k<4; k++) {
+    const int di = neighbours[k][0];
+    const int dj = neighbours[k][1];
+    const auto heightNeighbour = workspace.height_.block(1+di, 1+dj, m, m);
+    const Grid heightOnTangentPlane = height - (normalX*(di*spacing_) + normalY*(dj*spacing_))/normalZ;
+    roughness = roughness.max((heightNeighbour-heightOnTangentPlane).abs());
+    heightStep = heightStep.max((heightNeighbour-height).abs());
+    isValid *= workspace.isValid_.block(1+di, 1+dj, m, m);
+  }
+
+  /* squared distance to the closest edge */
+  Grid& edgeDistanceSquared = workspace.edgeDistanceSquared_;
+  edgeDistanceSquared.setConstant(std::numeric_limits<double>::max());
+  for (int j=0; j<m; j++) {
+    for (int i=0; i<m; i++) {
+      if (isValid(i,j) > 0.0 && heightStep(i,j) > edgeHeight_) {
+        edgeDistanceSquared = edgeDistanceSquared.min((offsetX-offsetX(i,j)).square() + (offsetY-offsetY(i,j)).square());
+      }
+    }
+  }
+
+  /* squared distance from the hip */
+  const Position& positionWorldToHipInWorldFrame = problem.positionWorldToHipInWorldFrame_;
+  const Grid hipDistance = ((offsetX + (positionWorldToNominalFootholdInWorldFrame.x()-positionWorldToHipInWorldFrame.x())).square()
+                           + (offsetY + (positionWorldToNominalFootholdInWorldFrame.y()-positionWorldToHipInWorldFrame.y())).square()
+                           + (height - positionWorldToHipInWorldFrame.z()).square()).sqrt();
+
+  const Grid isFeasible = (isValid > 0.0 && normalZ >= minNormalZ_ && roughness <= maxRoughness_
+                           && edgeDistanceSquared >= footRadius_*footRadius_ && hipDistance <= maxLegLength_).cast<double>();
+
+  cost = distanceWeight_*(offsetX.square() + offsetY.square()).sqrt()
+         + slopeWeight_*(1.0-normalZ)
+         + (roughnessWeight_/maxRoughness_)*roughness
+         + edgeWeight_*(1.0-edgeDistanceSquared.min(edgeClearance_*edgeClearance_).sqrt()/edgeClearance_)
+         + (reachabilityWeight_/0.2)*(hipDistance/maxLegLength_-0.8).max(0.0);
+  if (problem.hasPreviousFoothold_) {
+    const double previousX = problem.positionWorldToPreviousFootholdInWorldFrame_.x()-positionWorldToNominalFootholdInWorldFrame.x();
+    const double previousY = problem.positionWorldToPreviousFootholdInWorldFrame_.y()-positionWorldToNominalFootholdInWorldFrame.y();
+    cost += previousFootholdWeight_*((offsetX-previousX).square() + (offsetY-previousY).square()).sqrt();
+  }
+  cost = (isFeasible > 0.0).select(cost, std::numeric_limits<double>::infinity());
+
+  /* the support polygon changes with every candidate, it is only evaluated for the feasible ones */
+  if (problem.numberOfSupportFeet_ >= 2 && supportMarginWeight_ > 0.0) {
+    for (int j=0; j<m; j++) {
+      for (int i=0; i<m; i++) {
+        if (isFeasible(i,j) > 0.0) {
+          const double margin = getSupportMargin(problem, positionWorldToNominalFootholdInWorldFrame.x()+offsetX(i,j),
+                                                 positionWorldToNominalFootholdInWorldFrame.y()+offsetY(i,j));
+          cost(i,j) += (supportMarginWeight_/supportMargin_)*std::max(supportMargin_-margin, 0.0);
+        }
+      }
+    }
+  }
+
+  int iBest = 0;
+  int jBest = 0;
+  const double minCost = cost.minCoeff(&iBest, &jBest);
+  if (!(minCost < std::numeric_limits<double>::infinity())) {
+    result.positionWorldToFootholdInWorldFrame_ = positionWorldToNominalFootholdInWorldFrame;
+    result.cost_ = minCost;
+    result.isFeasible_ = false;
+    return;
+  }
+  result.positionWorldToFootholdInWorldFrame_ = Position(positionWorldToNominalFootholdInWorldFrame.x()+offsetX(iBest, jBest),
+                                                         positionWorldToNominalFootholdInWorldFrame.y()+offsetY(iBest, jBest),
+                                                         height(iBest, jBest));
+  result.cost_ = minCost;
+  result.isFeasible_ = true;
+}
+
+
+double FootholdOptimizer::getSupportMargin(const FootholdOptimizationProblem& problem, double x, double y) const {
+  /* convex hull of the support feet and the candidate */
+  const int nPoints = problem.numberOfSupportFeet_+1;
+  ConvexPolygon::Points points(2, nPoints);
+  for (int k=0; k<problem.numberOfSupportFeet_; k++) {
+    points.col(k) << problem.positionWorldToSupportFeetInWorldFrame_[k].x(), problem.positionWorldToSupportFeetInWorldFrame_[k].y();
+  }
+  points.col(nPoints-1) << x, y;
+  ConvexPolygon supportPolygon;
+  if (!supportPolygon.setToConvexHull(points)) {
+    return 0.0;
+  }
+
+  /* signed distance of the center of mass to the closest edge (positive inside) */
+  return supportPolygon.getSignedDistance(ConvexPolygon::Point(problem.positionWorldToCenterOfMassInWorldFrame_.x(),
+                                                               problem.positionWorldToCenterOfMassInWorldFrame_.y()));
+}
+
+
+void FootholdOptimizer::startWorkers(int numberOfWorkers) {
+  isStopping_ = false;
+  for (int k=0; k<numberOfWorkers; k++) {
+    workers_.push_back(std::thread(&FootholdOptimizer::work, this));
+  }
+}
+
+
+void FootholdOptimizer::stopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStopping_ = true;
+  }
+  jobsAvailable_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+
+void FootholdOptimizer::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  int seenGeneration = generation_;
+  while (true) {
+    jobsAvailable_.wait(lock, [this, &seenGeneration]() { return isStopping_ || generation_ != seenGeneration; });
+    if (isStopping_) {
+      return;
+    }
+    seenGeneration = generation_;
+    /* the calling thread may have done all jobs before this worker woke up */
+    if (numberOfDoneJobs_ == numberOfJobs_) {
+      continue;
+    }
+    numberOfActiveWorkers_++;
+    lock.unlock();
+    runJobs();
+    lock.lock();
+    numberOfActiveWorkers_--;
+    jobsDone_.notify_all();
+  }
+}
+
+
+void FootholdOptimizer::runJobs() {
+  int k;
+  while ((k = nextJob_++) < numberOfJobs_) {
+    optimizeLeg((*problems_)[k], (*results_)[k], workspaces_[k]);
+    numberOfDoneJobs_++;
+  }
+}
+
+} /* namespace loco */
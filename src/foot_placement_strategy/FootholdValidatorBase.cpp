@@ -0,0 +1,155 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdValidatorBase.cpp
+* @brief
+*/
+
+#include "loco/foot_placement_strategy/FootholdValidatorBase.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace loco {
+
+FootholdValidatorBase::FootholdValidatorBase():
+  isRunning_(false),
+  nextSlot_(0)
+{
+
+}
+
+
+FootholdValidatorBase::~FootholdValidatorBase() {
+  stop();
+}
+
+
+bool FootholdValidatorBase::start() {
+  if (isRunning_) {
+    return true;
+  }
+  isRunning_ = true;
+  worker_ = std::thread(&FootholdValidatorBase::work, this);
+  return true;
+}
+
+
+void FootholdValidatorBase::stop() {
+  isRunning_ = false;
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+
+bool FootholdValidatorBase::isRunning() const {
+  return isRunning_;
+}
+
+
+bool FootholdValidatorBase::sendRequest(const FootholdValidationRequest& request) {
+  /* the queued and the processed requests occupy at most numberOfRequestSlots_-1 slots, hence the data of the
+   * next slot is not in use */
+  FootholdValidationRequest preparedRequest = request;
+  preparedRequest.slot_ = nextSlot_;
+  if (!prepareRequest(preparedRequest) || !requestQueue_.push(preparedRequest)) {
+    return false;
+  }
+  nextSlot_ = (nextSlot_+1) % numberOfRequestSlots_;
+  return true;
+}
+
+
+bool FootholdValidatorBase::prepareRequest(const FootholdValidationRequest& request) {
+  return true;
+}
+
+
+bool FootholdValidatorBase::receiveResponse(FootholdValidationResponse& response) {
+  return completionQueue_.pop(response);
+}
+
+
+int FootholdValidatorBase::processRequests() {
+  if (isRunning_) {
+    printf("FootholdValidatorBase: requests are processed by the worker thread!\n");
+    return -1;
+  }
+  return processQueuedRequests();
+}
+
+
+void FootholdValidatorBase::clear() {
+  if (isRunning_) {
+    printf("FootholdValidatorBase: cannot clear the queues while the worker thread is running!\n");
+    return;
+  }
+  requestQueue_.clear();
+  completionQueue_.clear();
+}
+
+
+int FootholdValidatorBase::processQueuedRequests() {
+  int nProcessed = 0;
+  FootholdValidationRequest request;
+  while (requestQueue_.pop(request)) {
+    FootholdValidationResponse response;
+    response.legId_ = request.legId_;
+    response.stepNumber_ = request.stepNumber_;
+    response.flag_ = FootholdUnknown;
+    response.positionWorldToValidatedFootHoldInWorldFrame_ = request.positionWorldToDesiredFootHoldInWorldFrame_;
+    response.cost_ = 0.0;
+    if (validateFoothold(request, response)) {
+      if (!completionQueue_.push(response)) {
+        printf("FootholdValidatorBase: response of step %d is dropped, the completion queue is full!\n", request.stepNumber_);
+      }
+    }
+    nProcessed++;
+  }
+  return nProcessed;
+}
+
+
+void FootholdValidatorBase::work() {
+  while (isRunning_) {
+    if (processQueuedRequests() == 0) {
+      /* wake up regularly to check for new requests and if the worker has been stopped */
+      std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+  }
+}
+
+} /* namespace loco */
@@ -0,0 +1,222 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdValidatorTerrainModel.cpp
+* @brief
+*/
+
+#include "loco/foot_placement_strategy/FootholdValidatorTerrainModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace loco {
+
+FootholdValidatorTerrainModel::FootholdValidatorTerrainModel(TerrainModelBase* terrain):
+  FootholdValidatorBase(),
+  terrain_(terrain),
+  footRadius_(0.03),
+  maxRoughness_(0.02),
+  minNormalZ_(std::cos(30.0*M_PI/180.0)),
+  minFriction_(0.3),
+  distanceWeight_(1.0),
+  slopeWeight_(0.5),
+  roughnessWeight_(5.0)
+{
+  setParameters(0.1, 0.025, 0.03, 0.02, 30.0*M_PI/180.0, 0.3);
+}
+
+
+FootholdValidatorTerrainModel::~FootholdValidatorTerrainModel() {
+  /* the worker must not call validateFoothold() of a destroyed object */
+  stop();
+}
+
+
+bool FootholdValidatorTerrainModel::setParameters(double searchRadius, double searchResolution, double footRadius,
+                                                  double maxRoughness, double maxSlope, double minFriction) {
+  if (searchRadius < 0.0 || searchResolution <= 0.0 || footRadius <= 0.0 || maxRoughness < 0.0 || maxSlope < 0.0) {
+    printf("FootholdValidatorTerrainModel: invalid parameters!\n");
+    return false;
+  }
+  if (isRunning()) {
+    printf("FootholdValidatorTerrainModel: cannot change the parameters while the worker thread is running!\n");
+    return false;
+  }
+
+  footRadius_ = footRadius;
+  maxRoughness_ = maxRoughness;
+  minNormalZ_ = std::cos(maxSlope);
+  minFriction_ = minFriction;
+
+  /* rings of candidates with roughly equidistant points, sorted by their distance to the desired foothold */
+  candidateOffsets_.clear();
+  candidateOffsets_.push_back(Position());
+  const int nRings = static_cast<int>(std::floor(searchRadius/searchResolution + 1.0e-9));
+  for (int iRing=1; iRing<=nRings; iRing++) {
+    const double radius = iRing*searchResolution;
+    const int nPoints = 6*iRing;
+    for (int k=0; k<nPoints; k++) {
+      const double angle = 2.0*M_PI*k/nPoints;
+      candidateOffsets_.push_back(Position(radius*std::cos(angle), radius*std::sin(angle), 0.0));
+    }
+  }
+
+  /* the snapshots are allocated here such that sending a request does not allocate */
+  snapshots_.resize(numberOfRequestSlots_);
+  for (TerrainSnapshot& snapshot : snapshots_) {
+    snapshot.heights_.resize(candidateOffsets_.size());
+    snapshot.normals_.resize(candidateOffsets_.size());
+    snapshot.frictionCoefficients_.resize(candidateOffsets_.size());
+    snapshot.heightsAround_.resize(4*candidateOffsets_.size());
+  }
+  return true;
+}
+
+
+void FootholdValidatorTerrainModel::setCostWeights(double distanceWeight, double slopeWeight, double roughnessWeight) {
+  distanceWeight_ = distanceWeight;
+  slopeWeight_ = slopeWeight;
+  roughnessWeight_ = roughnessWeight;
+}
+
+
+int FootholdValidatorTerrainModel::getNumberOfCandidates() const {
+  return candidateOffsets_.size();
+}
+
+
+bool FootholdValidatorTerrainModel::prepareRequest(const FootholdValidationRequest& request) {
+  const double unknown = std::numeric_limits<double>::quiet_NaN();
+  const double offsets[4][2] = {{footRadius_, 0.0}, {-footRadius_, 0.0}, {0.0, footRadius_}, {0.0, -footRadius_}};
+  TerrainSnapshot& snapshot = snapshots_[request.slot_];
+  for (int k=0; k<(int)candidateOffsets_.size(); k++) {
+    Position positionWorldToCandidateInWorldFrame = request.positionWorldToDesiredFootHoldInWorldFrame_ + candidateOffsets_[k];
+    double& height = snapshot.heights_[k];
+    double& frictionCoefficient = snapshot.frictionCoefficients_[k];
+    if (!terrain_->getHeight(positionWorldToCandidateInWorldFrame, height)) {
+      height = unknown;
+      continue;
+    }
+    positionWorldToCandidateInWorldFrame.z() = height;
+    if (!terrain_->getNormal(positionWorldToCandidateInWorldFrame, snapshot.normals_[k])
+        || !terrain_->getFrictionCoefficientForFoot(positionWorldToCandidateInWorldFrame, frictionCoefficient)) {
+      frictionCoefficient = unknown;
+    }
+    for (int i=0; i<4; i++) {
+      double& heightAround = snapshot.heightsAround_[4*k+i];
+      if (!terrain_->getHeight(positionWorldToCandidateInWorldFrame + Position(offsets[i][0], offsets[i][1], 0.0), heightAround)) {
+        heightAround = unknown;
+      }
+    }
+  }
+  return true;
+}
+
+
+bool FootholdValidatorTerrainModel::validateFoothold(const FootholdValidationRequest& request, FootholdValidationResponse& response) {
+  const Position& positionWorldToDesiredFootHoldInWorldFrame = request.positionWorldToDesiredFootHoldInWorldFrame_;
+  const TerrainSnapshot& snapshot = snapshots_[request.slot_];
+
+  double minCost = std::numeric_limits<double>::max();
+  int bestCandidate = -1;
+  Position positionWorldToBestCandidateInWorldFrame;
+  for (int k=0; k<(int)candidateOffsets_.size(); k++) {
+    /* the rings are sorted by distance, no farther candidate can beat the current one */
+    const double distance = candidateOffsets_[k].norm();
+    if (distanceWeight_*distance >= minCost) {
+      break;
+    }
+
+    Position positionWorldToCandidateInWorldFrame = positionWorldToDesiredFootHoldInWorldFrame + candidateOffsets_[k];
+    double cost;
+    if (!evaluateCandidate(snapshot, k, positionWorldToCandidateInWorldFrame, cost)) {
+      continue;
+    }
+    cost += distanceWeight_*distance;
+    if (cost < minCost) {
+      minCost = cost;
+      bestCandidate = k;
+      positionWorldToBestCandidateInWorldFrame = positionWorldToCandidateInWorldFrame;
+    }
+  }
+
+  if (bestCandidate == -1) {
+    response.flag_ = FootholdBad;
+    response.cost_ = std::numeric_limits<double>::max();
+    return true;
+  }
+  response.flag_ = FootholdVerified;
+  response.positionWorldToValidatedFootHoldInWorldFrame_ = positionWorldToBestCandidateInWorldFrame;
+  response.cost_ = minCost;
+  return true;
+}
+
+
+bool FootholdValidatorTerrainModel::evaluateCandidate(const TerrainSnapshot& snapshot, int candidate, Position& positionWorldToCandidateInWorldFrame, double& cost) const {
+  const double height = snapshot.heights_[candidate];
+  if (std::isnan(height)) {
+    return false;
+  }
+  positionWorldToCandidateInWorldFrame.z() = height;
+
+  const double frictionCoefficient = snapshot.frictionCoefficients_[candidate];
+  const Vector& normalInWorldFrame = snapshot.normals_[candidate];
+  if (std::isnan(frictionCoefficient) || frictionCoefficient < minFriction_ || normalInWorldFrame.z() < minNormalZ_) {
+    return false;
+  }
+
+  /* largest deviation from the tangent plane within the foot radius */
+  double roughness = 0.0;
+  const double offsets[4][2] = {{footRadius_, 0.0}, {-footRadius_, 0.0}, {0.0, footRadius_}, {0.0, -footRadius_}};
+  for (int i=0; i<4; i++) {
+    const double heightAround = snapshot.heightsAround_[4*candidate+i];
+    if (std::isnan(heightAround)) {
+      return false;
+    }
+    const double heightOnTangentPlane = height - (normalInWorldFrame.x()*offsets[i][0] + normalInWorldFrame.y()*offsets[i][1])/normalInWorldFrame.z();
+    roughness = std::max(roughness, std::fabs(heightAround-heightOnTangentPlane));
+  }
+  if (roughness > maxRoughness_) {
+    return false;
+  }
+
+  cost = slopeWeight_*(1.0-normalInWorldFrame.z()) + roughnessWeight_*roughness;
+  return true;
+}
+
+} /* namespace loco */
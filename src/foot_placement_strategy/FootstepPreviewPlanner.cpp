@@ -0,0 +1,265 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootstepPreviewPlanner.cpp
+* @brief
+*/
+
+#include "loco/foot_placement_strategy/FootstepPreviewPlanner.hpp"
+
+#include <Eigen/Cholesky>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace loco {
+
+FootstepPreviewPlanner::FootstepPreviewPlanner():
+    numberOfSteps_(3),
+    numberOfIterations_(3),
+    velocityWeight_(1.0),
+    neutralPointWeight_(0.1),
+    stepLengthWeight_(0.1)
+{
+  reset();
+}
+
+
+FootstepPreviewPlanner::~FootstepPreviewPlanner() {
+
+}
+
+
+bool FootstepPreviewPlanner::setNumberOfSteps(int numberOfSteps) {
+  if (numberOfSteps < 1 || numberOfSteps > maxNumberOfSteps) {
+    printf("FootstepPreviewPlanner: the number of steps has to be in [1, %d]!\n", maxNumberOfSteps);
+    return false;
+  }
+  numberOfSteps_ = numberOfSteps;
+  reset();
+  return true;
+}
+
+
+int FootstepPreviewPlanner::getNumberOfSteps() const {
+  return numberOfSteps_;
+}
+
+
+void FootstepPreviewPlanner::setWeights(double velocityWeight, double neutralPointWeight, double stepLengthWeight) {
+  velocityWeight_ = velocityWeight;
+  neutralPointWeight_ = std::max(neutralPointWeight, 1.0e-6);
+  stepLengthWeight_ = stepLengthWeight;
+}
+
+
+void FootstepPreviewPlanner::setNumberOfIterations(int numberOfIterations) {
+  numberOfIterations_ = numberOfIterations;
+}
+
+
+void FootstepPreviewPlanner::reset(int legId) {
+  pivots_[legId].setZero(numberOfSteps_, 2);
+  footHolds_[legId].setZero(numberOfSteps_, 2);
+  velocities_[legId].setZero(numberOfSteps_, 2);
+  heightFootHolds_[legId] = 0.0;
+  hasPlan_[legId] = false;
+}
+
+
+void FootstepPreviewPlanner::reset() {
+  for (int legId=0; legId<4; legId++) {
+    reset(legId);
+  }
+}
+
+
+bool FootstepPreviewPlanner::hasPlan(int legId) const {
+  return hasPlan_[legId];
+}
+
+
+Position FootstepPreviewPlanner::getPositionWorldToFootHoldInWorldFrame(int legId, int step) const {
+  return Position(footHolds_[legId](step, 0), footHolds_[legId](step, 1), heightFootHolds_[legId]);
+}
+
+
+LinearVelocity FootstepPreviewPlanner::getLinearVelocityCenterOfMassInWorldFrame(int legId, int step) const {
+  return LinearVelocity(velocities_[legId](step, 0), velocities_[legId](step, 1), 0.0);
+}
+
+
+bool FootstepPreviewPlanner::plan(int legId, const FootstepPreviewInput& input) {
+  if (legId < 0 || legId >= 4 || input.heightCenterOfMass_ <= 0.0 || input.gravity_ <= 0.0 || input.strideDuration_ <= 0.0) {
+    printf("FootstepPreviewPlanner: invalid input!\n");
+    return false;
+  }
+  typedef Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, maxNumberOfSteps> Row;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfSteps, 1> Column;
+
+  const int K = numberOfSteps_;
+  const double T = input.strideDuration_;
+  const double omega = std::sqrt(input.gravity_/input.heightCenterOfMass_);
+  const double C = std::cosh(omega*T);
+  const double S = std::sinh(omega*T);
+  // distance from the center of mass to the pivot at touch-down for a periodic gait, v*tanh(omega*T/2)/omega
+  const double neutralPointGain = std::tanh(0.5*omega*T)/omega;
+  const double timeToTouchDown = std::max(input.timeToTouchDown_, 0.0);
+
+  //--- state at the first touch-down, affine in the pivots: x = a + G*u
+  Eigen::Vector2d ax(input.positionWorldToCenterOfMassInWorldFrame_.x() + input.linearVelocityCenterOfMassInWorldFrame_.x()*timeToTouchDown,
+                     input.positionWorldToCenterOfMassInWorldFrame_.y() + input.linearVelocityCenterOfMassInWorldFrame_.y()*timeToTouchDown);
+  Eigen::Vector2d av(input.linearVelocityCenterOfMassInWorldFrame_.x(), input.linearVelocityCenterOfMassInWorldFrame_.y());
+  Row Gx = Row::Zero(K);
+  Row Gv = Row::Zero(K);
+  //---
+
+  const double sqrtVelocityWeight = std::sqrt(velocityWeight_);
+  const double sqrtNeutralPointWeight = std::sqrt(neutralPointWeight_);
+  const double sqrtStepLengthWeight = std::sqrt(stepLengthWeight_);
+
+  M_.setZero(3*K-1, K);
+  b_.setZero(3*K-1, 2);
+  Eigen::Matrix<double, Eigen::Dynamic, 2, 0, maxNumberOfSteps, 2> offsets(K, 2);
+  Eigen::Matrix<double, Eigen::Dynamic, 2, 0, maxNumberOfSteps, 2> av1(K, 2);
+  NormalMatrix Gv1(K, K);
+  int iRow = 0;
+  for (int k=0; k<K; k++) {
+    //--- references rotated by the desired yaw rate
+    const double yaw = input.angularVelocityDesiredZ_*(timeToTouchDown + k*T);
+    const Eigen::Matrix2d rotation = (Eigen::Matrix2d() << std::cos(yaw), -std::sin(yaw), std::sin(yaw), std::cos(yaw)).finished();
+    const Eigen::Vector2d velocityDesired = rotation*Eigen::Vector2d(input.linearVelocityDesiredInWorldFrame_.x(), input.linearVelocityDesiredInWorldFrame_.y());
+    offsets.row(k) = (rotation*Eigen::Vector2d(input.positionCenterOfMassToNominalFootHoldInWorldFrame_.x(), input.positionCenterOfMassToNominalFootHoldInWorldFrame_.y())).transpose();
+    //---
+
+    // neutral point
+    M_.row(iRow) = -sqrtNeutralPointWeight*Gx;
+    M_(iRow, k) += sqrtNeutralPointWeight;
+    b_.row(iRow) = sqrtNeutralPointWeight*(ax + neutralPointGain*velocityDesired).transpose();
+    iRow++;
+
+    // step length
+    if (k > 0) {
+      M_(iRow, k) = sqrtStepLengthWeight;
+      M_(iRow, k-1) = -sqrtStepLengthWeight;
+      b_.row(iRow) = sqrtStepLengthWeight*2.0*neutralPointGain*velocityDesired.transpose();
+      iRow++;
+    }
+
+    // pendulum over one stride
+    const Eigen::Vector2d axNext = C*ax + (S/omega)*av;
+    const Eigen::Vector2d avNext = (omega*S)*ax + C*av;
+    const Row GxNext = C*Gx + (S/omega)*Gv;
+    const Row GvNext = (omega*S)*Gx + C*Gv;
+    ax = axNext;
+    av = avNext;
+    Gx = GxNext;
+    Gv = GvNext;
+    Gx(k) += 1.0-C;
+    Gv(k) -= omega*S;
+    av1.row(k) = av.transpose();
+    Gv1.row(k) = Gv;
+
+    // velocity after the step
+    M_.row(iRow) = sqrtVelocityWeight*Gv;
+    b_.row(iRow) = sqrtVelocityWeight*(velocityDesired - av).transpose();
+    iRow++;
+  }
+
+  //--- normal equations, shared by both axes (positive definite, every pivot has its own neutral point row)
+  const NormalMatrix H = M_.transpose()*M_;
+  const Plan g = M_.transpose()*b_;
+  //---
+
+  Plan& pivots = pivots_[legId];
+  if (!hasPlan_[legId] || pivots.rows() != K) {
+    // cold start
+    Eigen::LLT<NormalMatrix> llt(H);
+    pivots = llt.solve(g);
+    hasPlan_[legId] = true;
+  }
+  else {
+    // warm start from the previous plan
+    if (input.didTouchDown_) {
+      shift(legId, 2.0*neutralPointGain*Eigen::Vector2d(input.linearVelocityDesiredInWorldFrame_.x(), input.linearVelocityDesiredInWorldFrame_.y()));
+    }
+    for (int axis=0; axis<2; axis++) {
+      Column u = pivots.col(axis);
+      solveConjugateGradient(H, g.col(axis), u);
+      pivots.col(axis) = u;
+    }
+  }
+
+  footHolds_[legId] = pivots + offsets;
+  velocities_[legId] = av1 + Gv1*pivots;
+  heightFootHolds_[legId] = input.positionWorldToCenterOfMassInWorldFrame_.z() - input.heightCenterOfMass_;
+  return true;
+}
+
+
+void FootstepPreviewPlanner::shift(int legId, const Eigen::Vector2d& stepLength) {
+  Plan& pivots = pivots_[legId];
+  const int K = pivots.rows();
+  for (int k=0; k<K-1; k++) {
+    pivots.row(k) = pivots.row(k+1);
+  }
+  if (K > 1) {
+    pivots.row(K-1) = pivots.row(K-2) + stepLength.transpose();
+  }
+}
+
+
+void FootstepPreviewPlanner::solveConjugateGradient(const NormalMatrix& H, const Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfSteps, 1>& g,
+                                                    Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfSteps, 1>& u) const {
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxNumberOfSteps, 1> Column;
+  Column r = g - H*u;
+  Column p = r;
+  double rr = r.squaredNorm();
+  for (int i=0; i<numberOfIterations_; i++) {
+    if (rr <= 1.0e-24) {
+      break;
+    }
+    const Column Hp = H*p;
+    const double alpha = rr/p.dot(Hp);
+    u += alpha*p;
+    r -= alpha*Hp;
+    const double rrNext = r.squaredNorm();
+    p = r + (rrNext/rr)*p;
+    rr = rrNext;
+  }
+}
+
+} /* namespace loco */
@@ -0,0 +1,179 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     SwingFootClearancePlanner.cpp
+* @brief
+*/
+
+#include "loco/foot_placement_strategy/SwingFootClearancePlanner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace loco {
+
+SwingFootClearancePlanner::SwingFootClearancePlanner(TerrainModelBase* terrain):
+    terrain_(terrain),
+    numberOfSamples_(0),
+    clearance_(0.03),
+    maxHeightApex_(0.25),
+    minWeightApex_(0.1)
+{
+  setNumberOfSamples(21);
+}
+
+
+SwingFootClearancePlanner::~SwingFootClearancePlanner() {
+
+}
+
+
+bool SwingFootClearancePlanner::setNumberOfSamples(int numberOfSamples) {
+  if (numberOfSamples < 3) {
+    printf("SwingFootClearancePlanner: at least 3 samples are needed!\n");
+    return false;
+  }
+  numberOfSamples_ = numberOfSamples;
+  positions_.resize(numberOfSamples_);
+  heights_.resize(numberOfSamples_);
+  isValid_.resize(numberOfSamples_);
+  return true;
+}
+
+
+int SwingFootClearancePlanner::getNumberOfSamples() const {
+  return numberOfSamples_;
+}
+
+
+bool SwingFootClearancePlanner::setLimits(double clearance, double maxHeightApex) {
+  if (clearance < 0.0 || maxHeightApex <= 0.0) {
+    printf("SwingFootClearancePlanner: invalid limits!\n");
+    return false;
+  }
+  clearance_ = clearance;
+  maxHeightApex_ = maxHeightApex;
+  return true;
+}
+
+
+double SwingFootClearancePlanner::getMinimumJerkProfile(double phase) {
+  const double s = std::min(std::max(phase, 0.0), 1.0);
+  return s*s*s*(10.0 + s*(-15.0 + s*6.0));
+}
+
+
+void SwingFootClearancePlanner::getHeightProfile(double phase, double apexPhase, double heightStart, double heightTarget,
+                                                 double& offset, double& weight) {
+  if (phase < apexPhase) {
+    weight = getMinimumJerkProfile(phase/apexPhase);
+    offset = heightStart*(1.0-weight);
+  }
+  else {
+    weight = 1.0-getMinimumJerkProfile((phase-apexPhase)/(1.0-apexPhase));
+    offset = heightTarget*(1.0-weight);
+  }
+}
+
+
+bool SwingFootClearancePlanner::plan(const Position& positionWorldToFootAtLiftOffInWorldFrame, const Position& positionWorldToFootHoldInWorldFrame,
+                                     double heightStart, double heightApex, double heightTarget, double apexPhase,
+                                     SwingFootClearanceResult& result) {
+  apexPhase = std::min(std::max(apexPhase, 0.01), 0.99);
+  const Position positionFootAtLiftOffToFootHoldInWorldFrame = positionWorldToFootHoldInWorldFrame - positionWorldToFootAtLiftOffInWorldFrame;
+
+  //--- sample the terrain along the path
+  for (int i=0; i<numberOfSamples_; i++) {
+    const double phase = (double)i/(numberOfSamples_-1);
+    positions_[i] = positionWorldToFootAtLiftOffInWorldFrame + positionFootAtLiftOffToFootHoldInWorldFrame*getMinimumJerkProfile(phase);
+  }
+  const bool areAllSamplesValid = terrain_->getHeights(positions_, heights_);
+  //---
+
+  result.heightApex_ = heightApex;
+  result.isApexRaised_ = false;
+  result.numberOfPredictedCollisions_ = 0;
+  result.phaseOfFirstPredictedCollision_ = 1.0;
+  result.isColliding_ = false;
+
+  /* the foot is on the ground at lift-off and touch-down, only the inner samples are checked */
+  double heightApexRequired = heightApex;
+  for (int i=1; i<numberOfSamples_-1; i++) {
+    isValid_[i] = areAllSamplesValid || terrain_->getHeight(positions_[i], heights_[i]);
+    if (!isValid_[i]) {
+      /* outside of the terrain model */
+      continue;
+    }
+    const double phase = (double)i/(numberOfSamples_-1);
+    double offset, weight;
+    getHeightProfile(phase, apexPhase, heightStart, heightTarget, offset, weight);
+
+    // height of the terrain above the path
+    const double heightTerrain = heights_[i] - positions_[i].z();
+    if (offset + weight*heightApex < heightTerrain) {
+      if (result.numberOfPredictedCollisions_ == 0) {
+        result.phaseOfFirstPredictedCollision_ = phase;
+      }
+      result.numberOfPredictedCollisions_++;
+    }
+    if (weight >= minWeightApex_) {
+      heightApexRequired = std::max(heightApexRequired, (heightTerrain + clearance_*weight - offset)/weight);
+    }
+  }
+
+  if (heightApexRequired > heightApex) {
+    result.heightApex_ = std::min(heightApexRequired, std::max(maxHeightApex_, heightApex));
+    result.isApexRaised_ = true;
+  }
+
+  //--- clearance with the planned apex height
+  result.minClearance_ = std::numeric_limits<double>::max();
+  for (int i=1; i<numberOfSamples_-1; i++) {
+    if (!isValid_[i]) {
+      continue;
+    }
+    const double phase = (double)i/(numberOfSamples_-1);
+    double offset, weight;
+    getHeightProfile(phase, apexPhase, heightStart, heightTarget, offset, weight);
+    result.minClearance_ = std::min(result.minClearance_, offset + weight*result.heightApex_ - (heights_[i] - positions_[i].z()));
+  }
+  //---
+
+  result.isColliding_ = (result.minClearance_ < 0.0);
+  return !result.isColliding_;
+}
+
+} /* namespace loco */
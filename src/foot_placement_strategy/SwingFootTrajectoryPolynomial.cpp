@@ -0,0 +1,132 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     SwingFootTrajectoryPolynomial.cpp
+* @brief
+*/
+
+#include "loco/foot_placement_strategy/SwingFootTrajectoryPolynomial.hpp"
+
+#include <algorithm>
+
+namespace loco {
+
+SwingFootTrajectoryPolynomial::SwingFootTrajectoryPolynomial() :
+    duration_(0.0),
+    timeStartHorizontal_(0.0),
+    timeStartHeight_(0.0),
+    timeApex_(0.0),
+    positionTarget_()
+{
+
+}
+
+SwingFootTrajectoryPolynomial::~SwingFootTrajectoryPolynomial() {
+
+}
+
+void SwingFootTrajectoryPolynomial::plan(double time, double duration,
+                                         const Position& positionStart, const Position& positionTarget,
+                                         double heightStart, double heightApex, double heightTarget, double apexPhase) {
+  duration_ = duration;
+  timeStartHorizontal_ = time;
+  positionTarget_ = positionTarget;
+
+  const double remainingDuration = duration_-time;
+  horizontal_[0].fitMinimumJerk(remainingDuration, positionStart.x(), positionTarget.x());
+  horizontal_[1].fitMinimumJerk(remainingDuration, positionStart.y(), positionTarget.y());
+
+  timeStartHeight_ = time;
+  timeApex_ = std::min(std::max(apexPhase, 0.0), 1.0)*duration_;
+  if (time < timeApex_) {
+    heightToApex_.fitMinimumJerk(timeApex_-time, heightStart, heightApex);
+    heightFromApex_.fitMinimumJerk(duration_-timeApex_, heightApex, heightTarget);
+  }
+  else {
+    // the apex has been passed already
+    timeApex_ = time;
+    heightToApex_.fitMinimumJerk(0.0, heightStart, heightStart);
+    heightFromApex_.fitMinimumJerk(remainingDuration, heightStart, heightTarget);
+  }
+}
+
+bool SwingFootTrajectoryPolynomial::updateTarget(double time, const Position& positionTarget, double threshold) {
+  const double dx = positionTarget.x()-positionTarget_.x();
+  const double dy = positionTarget.y()-positionTarget_.y();
+  if (dx*dx+dy*dy <= threshold*threshold) {
+    return false;
+  }
+
+  const double remainingDuration = duration_-time;
+  const double t = time-timeStartHorizontal_;
+  const double target[2] = {positionTarget.x(), positionTarget.y()};
+  for (int i=0; i<2; i++) {
+    const double position = horizontal_[i].getPosition(t);
+    const double velocity = horizontal_[i].getVelocity(t);
+    const double acceleration = horizontal_[i].getAcceleration(t);
+    horizontal_[i].fit(remainingDuration, position, velocity, acceleration, target[i], 0.0, 0.0);
+  }
+  timeStartHorizontal_ = time;
+  positionTarget_ = positionTarget;
+  return true;
+}
+
+Position SwingFootTrajectoryPolynomial::getPosition(double time) const {
+  const double t = time-timeStartHorizontal_;
+  const double height = (time < timeApex_) ? heightToApex_.getPosition(time-timeStartHeight_) : heightFromApex_.getPosition(time-timeApex_);
+  return Position(horizontal_[0].getPosition(t), horizontal_[1].getPosition(t), height);
+}
+
+LinearVelocity SwingFootTrajectoryPolynomial::getLinearVelocity(double time) const {
+  const double t = time-timeStartHorizontal_;
+  const double height = (time < timeApex_) ? heightToApex_.getVelocity(time-timeStartHeight_) : heightFromApex_.getVelocity(time-timeApex_);
+  return LinearVelocity(horizontal_[0].getVelocity(t), horizontal_[1].getVelocity(t), height);
+}
+
+LinearAcceleration SwingFootTrajectoryPolynomial::getLinearAcceleration(double time) const {
+  const double t = time-timeStartHorizontal_;
+  const double height = (time < timeApex_) ? heightToApex_.getAcceleration(time-timeStartHeight_) : heightFromApex_.getAcceleration(time-timeApex_);
+  return LinearAcceleration(horizontal_[0].getAcceleration(t), horizontal_[1].getAcceleration(t), height);
+}
+
+const Position& SwingFootTrajectoryPolynomial::getPositionTarget() const {
+  return positionTarget_;
+}
+
+double SwingFootTrajectoryPolynomial::getDuration() const {
+  return duration_;
+}
+
+} /* namespace loco */
@@ -57,6 +57,10 @@ bool GaitPatternBase::setToInterpolated(const GaitPatternBase& gaitPattern1, con
   return false;
 }
 
+bool GaitPatternBase::addParametersToVector(ParameterVector* parameterVector) {
+  return true;
+}
+
 const std::string& GaitPatternBase::getName() const {
   return name_;
 }
@@ -53,6 +53,7 @@ GaitPatternFlightPhases::GaitPatternFlightPhases(LegGroup* legs, TorsoBase* tors
   cyclePhase_(0.0),
   numGaitCycles_(0),
   strideDuration_(0.0),
+  parameterVector_(nullptr),
   torso_(torso),
   legs_(legs)
 {
@@ -247,10 +248,8 @@ bool loco::GaitPatternFlightPhases::loadParameters(const TiXmlHandle& handle) {
       return false;
     }
 
-    /* foot fall pattern */
-
-
-    stepPatterns_.clear();
+    /* foot fall pattern, the current patterns are kept if the parameters are invalid */
+    std::vector<FootFallPattern> stepPatterns;
 
     pElem = hFootFallPattern.FirstChild("LF").Element();
     if(!pElem) {
@@ -267,7 +266,7 @@ bool loco::GaitPatternFlightPhases::loadParameters(const TiXmlHandle& handle) {
       printf("Could not find LF:touchDown\n");
       return false;
     }
-    stepPatterns_.push_back(FootFallPattern(0, liftOff, touchDown));
+    stepPatterns.push_back(FootFallPattern(0, liftOff, touchDown));
 
 
     pElem = hFootFallPattern.FirstChild("RF").Element();
@@ -284,7 +283,7 @@ bool loco::GaitPatternFlightPhases::loadParameters(const TiXmlHandle& handle) {
       printf("Could not find GaitPattern:FootFallPattern:RF:touchDown\n");
       return false;
     }
-    stepPatterns_.push_back(FootFallPattern(1, liftOff, touchDown));
+    stepPatterns.push_back(FootFallPattern(1, liftOff, touchDown));
 
     pElem = hFootFallPattern.FirstChild("LH").Element();
     if(!pElem) {
@@ -299,7 +298,7 @@ bool loco::GaitPatternFlightPhases::loadParameters(const TiXmlHandle& handle) {
       printf("Could not find LH:touchDown\n");
       return false;
     }
-    stepPatterns_.push_back(FootFallPattern(2, liftOff, touchDown));
+    stepPatterns.push_back(FootFallPattern(2, liftOff, touchDown));
 
     pElem = hFootFallPattern.FirstChild("RH").Element();
     if(!pElem) {
@@ -314,8 +313,10 @@ bool loco::GaitPatternFlightPhases::loadParameters(const TiXmlHandle& handle) {
       printf("Could not find RH:touchDown\n");
       return false;
     }
-    stepPatterns_.push_back(FootFallPattern(3, liftOff, touchDown));
+    stepPatterns.push_back(FootFallPattern(3, liftOff, touchDown));
 
+    stepPatterns_ = stepPatterns;
+    updateParametersInVector();
     numGaitCycles_ = 0;
     return true;
 }
@@ -419,7 +420,7 @@ bool GaitPatternFlightPhases::setToInterpolated(const GaitPatternBase& gaitPatte
   //we'll also assume that the order the leg foot pattern is specified is the same...
   strideDuration_ = linearlyInterpolate(gait1.strideDuration_, gait2.strideDuration_, 0, 1, t);
 
-  stepPatterns_.clear();
+//  stepPatterns_.clear();
 //  if (gait1.stepPatterns_.size() != gait2.stepPatterns_.size())
 //    throw std::runtime_error("Don't know how to interpolated between incompatible foot fall patterns");
 //  for (uint i=0;i<gait1.stepPatterns_.size();i++){
@@ -433,16 +434,46 @@ bool GaitPatternFlightPhases::setToInterpolated(const GaitPatternBase& gaitPatte
 //
   if (gait1.stepPatterns_.size() != gait2.stepPatterns_.size())
     throw std::runtime_error("Don't know how to interpolated between incompatible foot fall patterns");
+  // the patterns are updated in place since the parameter vector holds their addresses
+  const bool isResized = (stepPatterns_.size() != gait1.stepPatterns_.size());
+  stepPatterns_.resize(gait1.stepPatterns_.size(), FootFallPattern(0, 0.0, 0.0));
   for (int i=0;i<(int)gait1.stepPatterns_.size();i++){
-    stepPatterns_.push_back(FootFallPattern(gait1.stepPatterns_[i].legId_,
+    stepPatterns_[i] = FootFallPattern(gait1.stepPatterns_[i].legId_,
         linearlyInterpolate(gait1.stepPatterns_[i].liftOffPhase, gait2.stepPatterns_[i].liftOffPhase, 0, 1, t),
-        linearlyInterpolate(gait1.stepPatterns_[i].strikePhase, gait2.stepPatterns_[i].strikePhase, 0, 1, t)));
+        linearlyInterpolate(gait1.stepPatterns_[i].strikePhase, gait2.stepPatterns_[i].strikePhase, 0, 1, t));
+  }
+  if (isResized) {
+    updateParametersInVector();
   }
   return true;
 }
 
+bool GaitPatternFlightPhases::addParametersToVector(ParameterVector* parameterVector) {
+  parameterVector->addSlice("GaitPatternFlightPhases", getContinuousParameters());
+  parameterVector_ = parameterVector;
+  return true;
+}
+
+std::vector<double*> GaitPatternFlightPhases::getContinuousParameters() {
+  std::vector<double*> parameters;
+  parameters.push_back(&strideDuration_);
+  for (FootFallPattern& stepPattern : stepPatterns_) {
+    parameters.push_back(&stepPattern.liftOffPhase);
+    parameters.push_back(&stepPattern.strikePhase);
+  }
+  return parameters;
+}
+
+void GaitPatternFlightPhases::updateParametersInVector() {
+  /* the vector of the patterns may have been reallocated and the number of patterns may have changed */
+  if (parameterVector_ != nullptr) {
+    parameterVector_->setSliceParameters("GaitPatternFlightPhases", getContinuousParameters());
+  }
+}
+
 void GaitPatternFlightPhases::clear() {
   stepPatterns_.clear();
+  updateParametersInVector();
 }
 
 int GaitPatternFlightPhases::getNumberOfLegs() const {
@@ -470,6 +501,7 @@ void GaitPatternFlightPhases::addFootFallPattern(int legId, double liftOffPhase,
   int pIndex = getStepPatternIndexForLeg(legId);
   if (pIndex == -1){
     stepPatterns_.push_back(FootFallPattern(legId, liftOffPhase, strikePhase));
+    updateParametersInVector();
   }else{
     throw std::runtime_error("There is already a footfall pattern for this leg!\n");
   }
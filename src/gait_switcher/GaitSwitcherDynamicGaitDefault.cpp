@@ -42,8 +42,125 @@
 #include "loco/gait_switcher/GaitSwitcherDynamicGaitDefault.hpp"
 #include "loco/temp_helpers/math.hpp"
 
+#include <cstdlib>
+#include <cstring>
+
 namespace loco {
 
+namespace {
+
+//! Attribute whose value differs between two versions of a parameter file
+struct ModifiedAttribute {
+  //! indices of the element and its ancestors among their sibling elements
+  std::vector<int> elementIndices_;
+  std::string path_;
+  std::string name_;
+  std::string value_;
+};
+
+//! @returns true if both values are equal as strings or as numbers, e.g. 1.0 and 1.00
+bool isEqualValue(const char* value1, const char* value2) {
+  if (std::strcmp(value1, value2) == 0) {
+    return true;
+  }
+  char* end1 = nullptr;
+  char* end2 = nullptr;
+  const double number1 = std::strtod(value1, &end1);
+  const double number2 = std::strtod(value2, &end2);
+  return end1 != value1 && *end1 == '\0' && end2 != value2 && *end2 == '\0' && number1 == number2;
+}
+
+/*! Compares two versions of a parameter document element by element.
+ * @param node1                 node of the first version
+ * @param node2                 node of the second version
+ * @param path                  path of the node
+ * @param elementIndices        indices of the node and its ancestors
+ * @param modifiedAttributes    attributes whose values differ with the values of the second version
+ * @param modifiedElement       path of the element whose attributes or child elements have been added or removed
+ * @returns false if elements or attributes have been added or removed
+ */
+bool findModifiedAttributes(const TiXmlNode* node1, const TiXmlNode* node2, const std::string& path, std::vector<int>* elementIndices,
+                            std::vector<ModifiedAttribute>* modifiedAttributes, std::string* modifiedElement) {
+  const TiXmlElement* element1 = node1->ToElement();
+  const TiXmlElement* element2 = node2->ToElement();
+  if (element1 != nullptr && element2 != nullptr) {
+    int numberOfAttributes = 0;
+    for (const TiXmlAttribute* attribute = element1->FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
+      const char* value = element2->Attribute(attribute->Name());
+      if (value == nullptr) {
+        *modifiedElement = path;
+        return false;
+      }
+      if (!isEqualValue(attribute->Value(), value)) {
+        ModifiedAttribute modifiedAttribute;
+        modifiedAttribute.elementIndices_ = *elementIndices;
+        modifiedAttribute.path_ = path;
+        modifiedAttribute.name_ = attribute->Name();
+        modifiedAttribute.value_ = value;
+        modifiedAttributes->push_back(modifiedAttribute);
+      }
+      numberOfAttributes++;
+    }
+    for (const TiXmlAttribute* attribute = element2->FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
+      numberOfAttributes--;
+    }
+    if (numberOfAttributes != 0) {
+      *modifiedElement = path;
+      return false;
+    }
+  }
+
+  const TiXmlElement* child1 = node1->FirstChildElement();
+  const TiXmlElement* child2 = node2->FirstChildElement();
+  for (int index = 0; child1 != nullptr || child2 != nullptr; index++) {
+    if (child1 == nullptr || child2 == nullptr || std::strcmp(child1->Value(), child2->Value()) != 0) {
+      *modifiedElement = path;
+      return false;
+    }
+    elementIndices->push_back(index);
+    const std::string childPath = path.empty() ? std::string(child1->Value()) : path + "/" + child1->Value();
+    if (!findModifiedAttributes(child1, child2, childPath, elementIndices, modifiedAttributes, modifiedElement)) {
+      return false;
+    }
+    elementIndices->pop_back();
+    child1 = child1->NextSiblingElement();
+    child2 = child2->NextSiblingElement();
+  }
+  return true;
+}
+
+//! @returns the element at the indices found by findModifiedAttributes
+TiXmlElement* getElement(TiXmlNode* node, const std::vector<int>& elementIndices) {
+  for (int index : elementIndices) {
+    TiXmlElement* child = node->FirstChildElement();
+    for (int i=0; i<index; i++) {
+      child = child->NextSiblingElement();
+    }
+    node = child;
+  }
+  return node->ToElement();
+}
+
+//! @returns true if both gaits have the same continuous parameters and height trajectories
+bool isEqual(const GaitParameters& gaitParameters1, const GaitParameters& gaitParameters2) {
+  if (!gaitParameters1.parameterVector_.hasSameLayout(gaitParameters2.parameterVector_)
+      || gaitParameters1.parameterVector_.getValues() != gaitParameters2.parameterVector_.getValues()) {
+    return false;
+  }
+  /* the trajectories are parsed into different objects, hence they are compared over the stride */
+  const int numberOfSamples = 100;
+  for (int i=0; i<=numberOfSamples; i++) {
+    const double stridePhase = static_cast<double>(i)/numberOfSamples;
+    if (gaitParameters1.desiredTorsoForeHeightTrajectory_.evaluate(stridePhase) != gaitParameters2.desiredTorsoForeHeightTrajectory_.evaluate(stridePhase)
+        || gaitParameters1.desiredTorsoHindHeightTrajectory_.evaluate(stridePhase) != gaitParameters2.desiredTorsoHindHeightTrajectory_.evaluate(stridePhase)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} /* namespace */
+
 GaitSwitcherDynamicGaitDefault::GaitSwitcherDynamicGaitDefault(robotModel::RobotModel* robotModel,
                                                                robotTerrain::TerrainBase* terrain,
                                                                double dt) :
@@ -56,11 +173,18 @@ GaitSwitcherDynamicGaitDefault::GaitSwitcherDynamicGaitDefault(robotModel::Robot
     startTimeOfTransition_(0.0),
     endTimeOfTransition_(0.0),
     currentGaitTransition(nullptr),
+    requestedGaitTransition_(nullptr),
     pathToConfigFile_(),
     pathToParameterFiles_(),
     isAutoTransitionOn_(false),
     time_(0.0),
-    interpolationParameter_(0.0)
+    interpolationParameter_(0.0),
+    parameterSetLoadingState_(Idle),
+    numberOfLoadedGaits_(0),
+    numberOfGaitsToLoad_(0),
+    isPrefetching_(false),
+    isPrefetchCancelled_(false),
+    isParameterHotReloadOn_(false)
 {
 
 }
@@ -68,8 +192,12 @@ GaitSwitcherDynamicGaitDefault::GaitSwitcherDynamicGaitDefault(robotModel::Robot
 
 
 GaitSwitcherDynamicGaitDefault::~GaitSwitcherDynamicGaitDefault() {
+  stopParameterHotReload();
+  isPrefetchCancelled_ = true;
+  parameterSetLoader_.clear();
+  parameterSetLoader_.waitUntilDone();
   gaitTransitions_.clear();
-  locomotionControllers_.clear();
+  gaitParameters_.clear();
 }
 
 
@@ -77,7 +205,24 @@ bool GaitSwitcherDynamicGaitDefault::initialize(double dt) {
   time_ = 0.0;
   interpolationParameter_ = 0.0;
 
-  if (!config_.loadXmlDocument(pathToConfigFile_)) {
+  /* stop loading in the background */
+  isPrefetchCancelled_ = true;
+  parameterSetLoader_.clear();
+  parameterSetLoader_.waitUntilDone();
+  isPrefetching_ = false;
+  preparedParameterSet_.reset();
+  parameterSetLoadingState_ = Idle;
+
+  /* the reloader thread reads from the cache while it is reopened */
+  const bool isParameterHotReloadOn = isParameterHotReloadOn_;
+  stopParameterHotReload();
+
+  /* restore the parameter files from the precompiled cache, which is rebuilt if a parameter file is newer */
+  if (!parameterCache_.openOrRebuild(pathToParameterFiles_, pathToParameterFiles_ + "/" + ParameterCache::defaultFileName)) {
+    printf("Warning: parameter cache is not available, the parameter files are parsed instead.\n");
+  }
+
+  if (!config_.loadXmlDocument(pathToConfigFile_, &parameterCache_)) {
      std::cout << "Could not load config file: " << pathToConfigFile_  << std::endl;
      return false;
    }
@@ -86,12 +231,29 @@ bool GaitSwitcherDynamicGaitDefault::initialize(double dt) {
     printf("Error: could not load initial parameter set!\n");
     return false;
   }
+
+  /* load the parameters of the transitions in the background */
+  prefetchGaitParameters();
+
+  if (isParameterHotReloadOn && !startParameterHotReload()) {
+    printf("Warning: could not restart the hot reload of the parameter files.\n");
+  }
   return true;
 
 }
 
 bool GaitSwitcherDynamicGaitDefault::advance(double dt) {
 
+  /* swap in a parameter set that has been loaded in the background */
+  if (!updateParameterSetLoading()) {
+    return false;
+  }
+
+  /* swap in parameters of modified parameter files */
+  if (!updateParameterReloading()) {
+    return false;
+  }
+
   bool isSuccessful = updateTransition(time_);
 
   if (!locomotionController_->advanceMeasurements(dt)) {
@@ -127,11 +289,11 @@ bool GaitSwitcherDynamicGaitDefault::updateTransition(double simulatedTime) {
             isGood = true;
           }
           if (isGood) {
-            /* start transition */
-            isTransiting_ = true;
-            initTransit_ = true;
-            locomotionController_->setGaitName(gaitTransitions_[i].endName);
-            currentGaitTransition = &gaitTransitions_[i];
+            /* start transition once the parameters have been loaded in the background */
+            bool isFailed = false;
+            if (prepareTransition(&gaitTransitions_[i], &isFailed)) {
+              startTransition(&gaitTransitions_[i]);
+            }
             break;
           }
         }
@@ -140,6 +302,17 @@ bool GaitSwitcherDynamicGaitDefault::updateTransition(double simulatedTime) {
   }
 
 
+  if (requestedGaitTransition_ != nullptr && !isTransiting_) {
+    /* start the requested transition as soon as the loader thread provides the parameters */
+    bool isFailed = false;
+    if (prepareTransition(requestedGaitTransition_, &isFailed)) {
+      startTransition(requestedGaitTransition_);
+    } else if (isFailed) {
+      printf("Could not load the parameters of the transition!\n");
+      requestedGaitTransition_ = nullptr;
+    }
+  }
+
   if (!isTransiting_) {
     /* is not transiting -> terminate */
     return true;
@@ -193,7 +366,7 @@ bool GaitSwitcherDynamicGaitDefault::updateTransition(double simulatedTime) {
 
 bool GaitSwitcherDynamicGaitDefault::interpolateParameters(double t) {
   boundToRange(&t, 0, 1);
-  if(!locomotionController_->setToInterpolated(*currentGaitTransition->startLocomotionSettings, *currentGaitTransition->endLocomotionSettings, t)) {
+  if(!locomotionController_->setToInterpolated(*currentGaitTransition->startGaitParameters, *currentGaitTransition->endGaitParameters, t)) {
     printf("GaitSwitcherDynamicGaitDefault: Error while interpolating!\n");
     return false;
   }
@@ -201,19 +374,127 @@ bool GaitSwitcherDynamicGaitDefault::interpolateParameters(double t) {
 }
 
 
-bool GaitSwitcherDynamicGaitDefault::getLocomotionControllerByName(const std::string& name, LocomotionControllerDynamicGaitDefault* loco) {
-  for (unsigned int i=0; i<locomotionControllers_.size();i++){
-    if(locomotionControllers_[i].getGaitName() == name) {
-      /* is found */
+std::string GaitSwitcherDynamicGaitDefault::getParameterFilePath(const std::string& name) const {
+  std::string parameterFileSuffix = isRealRobot_ ? "" : "Sim";
+  return pathToParameterFiles_ +"/" + name + parameterFileSuffix + ".xml";
+}
 
-      loco = &locomotionControllers_[i];
-      return true;
+
+std::shared_ptr<const GaitParameters> GaitSwitcherDynamicGaitDefault::getGaitParameters(const std::string& name) {
+  const std::string parameterFilePath = getParameterFilePath(name);
+
+  {
+    std::lock_guard<std::mutex> lock(gaitParametersMutex_);
+    auto it = gaitParameters_.find(parameterFilePath);
+    if (it != gaitParameters_.end()) {
+      /* gait has already been loaded */
+      return it->second;
     }
   }
+
+  // the file is parsed without holding the lock such that the control thread can look up other gaits in the meantime
+  std::shared_ptr<const GaitParameters> gaitParameters = parseGaitParameters(name, parameterFilePath, &parameterCache_);
+  if (!gaitParameters) {
+    printf("Error: Could not load parameters for gait %s\n", name.c_str());
+  }
+
+  std::lock_guard<std::mutex> lock(gaitParametersMutex_);
+  auto it = gaitParameters_.find(parameterFilePath);
+  if (it != gaitParameters_.end()) {
+    /* gait has been loaded in the meantime by the other thread */
+    return it->second;
+  }
+  // a failed gait is remembered such that a requested transition does not wait for it
+  gaitParameters_[parameterFilePath] = gaitParameters;
+  return gaitParameters;
+}
+
+
+std::shared_ptr<const GaitParameters> GaitSwitcherDynamicGaitDefault::parseGaitParameters(const std::string& name,
+                                                                                          const std::string& parameterFilePath,
+                                                                                          const ParameterCache* parameterCache,
+                                                                                          const TiXmlDocument* document) const {
+  LocomotionControllerDynamicGaitDefault locomotionController(parameterFilePath, robotModel_, terrain_, time_step_, parameterCache);
+  locomotionController.setGaitName(name);
+  if (!locomotionController.getParameterSet()->isDocumentLoaded()) {
+    return std::shared_ptr<const GaitParameters>();
+  }
+  /* the modules have been created from the file, only the parameters are parsed from the given version */
+  if (document != nullptr) {
+    locomotionController.getParameterSet()->setXmlDocument(*document);
+  }
+  if (!locomotionController.loadParameters()) {
+    return std::shared_ptr<const GaitParameters>();
+  }
+
+  std::shared_ptr<GaitParameters> gaitParameters(new GaitParameters());
+  if (!locomotionController.getGaitParameters(gaitParameters.get())) {
+    return std::shared_ptr<const GaitParameters>();
+  }
+  return gaitParameters;
+}
+
+
+std::shared_ptr<const GaitParameters> GaitSwitcherDynamicGaitDefault::findGaitParameters(const std::string& name, bool* isFailed) {
+  std::lock_guard<std::mutex> lock(gaitParametersMutex_);
+  auto it = gaitParameters_.find(getParameterFilePath(name));
+  if (it == gaitParameters_.end()) {
+    return std::shared_ptr<const GaitParameters>();
+  }
+  if (!it->second) {
+    *isFailed = true;
+  }
+  return it->second;
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::prepareTransition(GaitTransition* gaitTransition, bool* isFailed) {
+  *isFailed = false;
+  if (!gaitTransition->startGaitParameters) {
+    gaitTransition->startGaitParameters = findGaitParameters(gaitTransition->startName, isFailed);
+  }
+  if (!gaitTransition->endGaitParameters) {
+    gaitTransition->endGaitParameters = findGaitParameters(gaitTransition->endName, isFailed);
+  }
+  if (gaitTransition->startGaitParameters && gaitTransition->endGaitParameters) {
+    return true;
+  }
+
+  /* the parameter files are never parsed by the control thread */
+  if (!*isFailed) {
+    prefetchGaitParameters();
+  }
   return false;
 }
 
 
+bool GaitSwitcherDynamicGaitDefault::loadTransition(GaitTransition* gaitTransition) {
+  if (!gaitTransition->startGaitParameters) {
+    gaitTransition->startGaitParameters = getGaitParameters(gaitTransition->startName);
+    if (!gaitTransition->startGaitParameters) {
+      return false;
+    }
+  }
+  if (!gaitTransition->endGaitParameters) {
+    gaitTransition->endGaitParameters = getGaitParameters(gaitTransition->endName);
+    if (!gaitTransition->endGaitParameters) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void GaitSwitcherDynamicGaitDefault::startTransition(GaitTransition* gaitTransition) {
+  isTransiting_ = true;
+  initTransit_ = true;
+  requestedGaitTransition_ = nullptr;
+  locomotionController_->setGaitName(gaitTransition->endName);
+  currentGaitTransition = gaitTransition;
+  printf("Init transition: %s -> %s\n",currentGaitTransition->startName.c_str(), currentGaitTransition->endName.c_str());
+}
+
+
 void GaitSwitcherDynamicGaitDefault::setPathToConfigFile(const std::string& pathToConfigFile) {
   pathToConfigFile_ = pathToConfigFile;
 }
@@ -243,11 +524,18 @@ bool GaitSwitcherDynamicGaitDefault::transitToGait(const std::string& targetGait
   for (unsigned int i=0;i<gaitTransitions_.size();i++){
     if (gaitTransitions_[i].startName == currentGaitName && gaitTransitions_[i].endName == targetGaitName) {
       /* found transition */
-      isTransiting_ = true;
-      initTransit_ = true;
-      locomotionController_->setGaitName(targetGaitName);
-      currentGaitTransition = &gaitTransitions_[i];
-      printf("Init transition: %s -> %s\n",currentGaitTransition->startName.c_str(), currentGaitTransition->endName.c_str());
+      bool isFailed = false;
+      if (!prepareTransition(&gaitTransitions_[i], &isFailed)) {
+        if (isFailed) {
+          printf("Could not load the parameters of the transition!\n");
+          return false;
+        }
+        /* the transition is started by advance() once the loader thread provides the parameters */
+        requestedGaitTransition_ = &gaitTransitions_[i];
+        printf("Requested transition: %s -> %s\n", gaitTransitions_[i].startName.c_str(), gaitTransitions_[i].endName.c_str());
+        return true;
+      }
+      startTransition(&gaitTransitions_[i]);
       return true;
     }
 
@@ -266,6 +554,303 @@ bool GaitSwitcherDynamicGaitDefault::loadParameterSet(int parameterSetIdx)
     return false;
   }
 
+  PreparedParameterSet parameterSet;
+  if (!prepareParameterSet(parameterSetIdx, &parameterSet)) {
+    return false;
+  }
+  return installParameterSet(&parameterSet);
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::loadParameterSetAsync(int parameterSetIdx)
+{
+  if (parameterSetLoadingState_ == Loading || parameterSetLoadingState_ == Ready) {
+    printf("Cannot load parameter set because another parameter set is being loaded!\n");
+    return false;
+  }
+
+  /* the parameter set loads the parameters of its transitions itself, hence a prefetch is not needed anymore */
+  isPrefetchCancelled_ = true;
+
+  preparedParameterSet_.reset(new PreparedParameterSet());
+  numberOfLoadedGaits_ = 0;
+  numberOfGaitsToLoad_ = 1;
+  parameterSetLoadingState_ = Loading;
+
+  parameterSetLoader_.addJob([this, parameterSetIdx]() {
+    bool isSuccessful = prepareParameterSet(parameterSetIdx, preparedParameterSet_.get());
+    numberOfLoadedGaits_ = 1;
+
+    // load the parameters of all transitions in advance such that a transition never blocks the control thread
+    if (isSuccessful) {
+      numberOfGaitsToLoad_ = 1 + 2*static_cast<int>(preparedParameterSet_->gaitTransitions_.size());
+      for (GaitTransition& gaitTransition : preparedParameterSet_->gaitTransitions_) {
+        if (!loadTransition(&gaitTransition)) {
+          isSuccessful = false;
+          break;
+        }
+        numberOfLoadedGaits_ += 2;
+      }
+    }
+
+    // the controller reads the robot model during initialization, hence it is initialized by the control thread
+    parameterSetLoadingState_ = isSuccessful ? Ready : Failed;
+  });
+
+  return true;
+}
+
+
+void GaitSwitcherDynamicGaitDefault::prefetchGaitParameters()
+{
+  if (isPrefetching_) {
+    return;
+  }
+
+  std::vector<std::string> names;
+  for (const GaitTransition& gaitTransition : gaitTransitions_) {
+    names.push_back(gaitTransition.startName);
+    names.push_back(gaitTransition.endName);
+  }
+  isPrefetching_ = true;
+  isPrefetchCancelled_ = false;
+
+  // only the shared cache is filled, the transitions are updated by the control thread
+  parameterSetLoader_.addJob([this, names]() {
+    for (const std::string& name : names) {
+      if (isPrefetchCancelled_) {
+        break;
+      }
+      getGaitParameters(name);
+    }
+    isPrefetching_ = false;
+  });
+}
+
+
+GaitSwitcherDynamicGaitDefault::ParameterSetLoadingState GaitSwitcherDynamicGaitDefault::getParameterSetLoadingState() const {
+  return parameterSetLoadingState_;
+}
+
+
+double GaitSwitcherDynamicGaitDefault::getParameterSetLoadingProgress() const {
+  const int numberOfGaitsToLoad = numberOfGaitsToLoad_;
+  if (numberOfGaitsToLoad <= 0) {
+    return 1.0;
+  }
+  return std::min(1.0, static_cast<double>(numberOfLoadedGaits_)/numberOfGaitsToLoad);
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::updateParameterSetLoading() {
+  const ParameterSetLoadingState state = parameterSetLoadingState_;
+
+  if (state == Failed) {
+    preparedParameterSet_.reset();
+    parameterSetLoadingState_ = Idle;
+    printf("Error: could not load parameter set!\n");
+    return true;
+  }
+
+  if (state != Ready || isTransiting_) {
+    /* nothing to do or wait until the transition is finished */
+    return true;
+  }
+
+  std::unique_ptr<PreparedParameterSet> parameterSet(std::move(preparedParameterSet_));
+  parameterSetLoadingState_ = Idle;
+  if (!installParameterSet(parameterSet.get())) {
+    printf("Error: could not install parameter set, the current parameter set is kept!\n");
+  }
+  return true;
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::startParameterHotReload() {
+  if (isParameterHotReloadOn_) {
+    return true;
+  }
+
+  /* the modified files are compared with these versions to find the modified parameters */
+  acceptedParameterDocuments_.clear();
+  std::vector<std::string> fileNames;
+  if (ParameterCache::listXmlFiles(pathToParameterFiles_, &fileNames)) {
+    for (const std::string& fileName : fileNames) {
+      const std::string parameterFilePath = pathToParameterFiles_ + "/" + fileName;
+      TiXmlDocument& document = acceptedParameterDocuments_[parameterFilePath];
+      if (!parameterCache_.loadXmlDocument(parameterFilePath, &document) && !document.LoadFile(parameterFilePath)) {
+        acceptedParameterDocuments_.erase(parameterFilePath);
+      }
+    }
+  }
+
+  if (!parameterFileWatcher_.watch(pathToParameterFiles_)) {
+    return false;
+  }
+  isParameterHotReloadOn_ = true;
+  parameterReloader_ = std::thread(&GaitSwitcherDynamicGaitDefault::reloadModifiedParameterFiles, this);
+  return true;
+}
+
+
+void GaitSwitcherDynamicGaitDefault::stopParameterHotReload() {
+  isParameterHotReloadOn_ = false;
+  if (parameterReloader_.joinable()) {
+    parameterReloader_.join();
+  }
+  parameterFileWatcher_.stop();
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::isParameterHotReloadOn() const {
+  return isParameterHotReloadOn_;
+}
+
+
+void GaitSwitcherDynamicGaitDefault::reloadModifiedParameterFiles() {
+  std::vector<std::string> fileNames;
+  while (isParameterHotReloadOn_) {
+    /* wake up regularly to check if the reloading has been stopped */
+    if (!parameterFileWatcher_.waitForModifiedFiles(&fileNames, 100)) {
+      continue;
+    }
+
+    for (const std::string& fileName : fileNames) {
+      const std::string parameterFilePath = pathToParameterFiles_ + "/" + fileName;
+      if (parameterFilePath == pathToConfigFile_) {
+        printf("Modified config file is not reloaded.\n");
+        continue;
+      }
+
+      /* the file is parsed into a new controller such that an invalid file does not affect the current parameters */
+      TiXmlDocument document;
+      const std::string gaitName = fileName.substr(0, fileName.rfind("."));
+      std::shared_ptr<const GaitParameters> gaitParameters;
+      if (document.LoadFile(parameterFilePath)) {
+        gaitParameters = parseGaitParameters(gaitName, parameterFilePath, nullptr, &document);
+      }
+      if (!gaitParameters) {
+        printf("Rejected modified parameter file %s, the current parameters are kept.\n", parameterFilePath.c_str());
+        continue;
+      }
+      auto acceptedDocument = acceptedParameterDocuments_.find(parameterFilePath);
+      if (acceptedDocument != acceptedParameterDocuments_.end()
+          && !isModificationSwappable(gaitName, parameterFilePath, acceptedDocument->second, document)) {
+        printf("Rejected modified parameter file %s, it cannot be swapped into the running controller.\n", parameterFilePath.c_str());
+        continue;
+      }
+      acceptedParameterDocuments_[parameterFilePath] = document;
+
+      std::lock_guard<std::mutex> lock(reloadedParameterFilesMutex_);
+      reloadedParameterFiles_[parameterFilePath] = gaitParameters;
+    }
+  }
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::isModificationSwappable(const std::string& name, const std::string& parameterFilePath,
+                                                             const TiXmlDocument& acceptedDocument, const TiXmlDocument& modifiedDocument) const {
+  std::vector<ModifiedAttribute> modifiedAttributes;
+  std::vector<int> elementIndices;
+  std::string modifiedElement;
+  if (!findModifiedAttributes(&acceptedDocument, &modifiedDocument, "", &elementIndices, &modifiedAttributes, &modifiedElement)) {
+    printf("Elements or attributes of %s have been added or removed.\n", modifiedElement.empty() ? parameterFilePath.c_str() : modifiedElement.c_str());
+    return false;
+  }
+  if (modifiedAttributes.empty()) {
+    return true;
+  }
+
+  std::shared_ptr<const GaitParameters> acceptedGaitParameters = parseGaitParameters(name, parameterFilePath, nullptr, &acceptedDocument);
+  if (!acceptedGaitParameters) {
+    return false;
+  }
+
+  /* an attribute that is not part of the gait parameters, e.g. the selection of a module, does not change them */
+  bool isSwappable = true;
+  for (const ModifiedAttribute& modifiedAttribute : modifiedAttributes) {
+    TiXmlDocument document(acceptedDocument);
+    getElement(&document, modifiedAttribute.elementIndices_)->SetAttribute(modifiedAttribute.name_.c_str(), modifiedAttribute.value_.c_str());
+    std::shared_ptr<const GaitParameters> gaitParameters = parseGaitParameters(name, parameterFilePath, nullptr, &document);
+    if (!gaitParameters || isEqual(*gaitParameters, *acceptedGaitParameters)) {
+      printf("Parameter %s:%s cannot be modified while the controller is running.\n", modifiedAttribute.path_.c_str(), modifiedAttribute.name_.c_str());
+      isSwappable = false;
+    }
+  }
+  return isSwappable;
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::updateParameterReloading() {
+  if (isTransiting_) {
+    /* wait until the transition is finished */
+    return true;
+  }
+
+  std::map<std::string, std::shared_ptr<const GaitParameters> > reloadedParameterFiles;
+  {
+    /* do not block the control thread if the reloader thread holds the lock */
+    std::unique_lock<std::mutex> lock(reloadedParameterFilesMutex_, std::try_to_lock);
+    if (!lock.owns_lock() || reloadedParameterFiles_.empty()) {
+      return true;
+    }
+    reloadedParameterFiles.swap(reloadedParameterFiles_);
+  }
+
+  const std::string currentParameterFilePath = locomotionController_->getParameterSet()->getParameterFile();
+  for (const auto& reloaded : reloadedParameterFiles) {
+    const std::string& parameterFilePath = reloaded.first;
+
+    if (parameterFilePath == currentParameterFilePath) {
+      /* the reloader thread has only accepted modifications of the parameters that are interpolated by the transitions,
+       * hence they are written into the modules of the running controller like at the end of a transition */
+      const GaitParameters& gaitParameters = *reloaded.second;
+      if (!locomotionController_->setToInterpolated(gaitParameters, gaitParameters, 1.0)) {
+        printf("Rejected modified parameter file %s, its parameters do not match the running controller.\n", parameterFilePath.c_str());
+        continue;
+      }
+      printf("Reloaded parameter file %s into the running controller.\n", parameterFilePath.c_str());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(gaitParametersMutex_);
+      auto it = gaitParameters_.find(parameterFilePath);
+      if (it != gaitParameters_.end()) {
+        it->second = reloaded.second;
+      }
+    }
+
+    for (GaitTransition& gaitTransition : gaitTransitions_) {
+      if (gaitTransition.startGaitParameters && getParameterFilePath(gaitTransition.startName) == parameterFilePath) {
+        gaitTransition.startGaitParameters = reloaded.second;
+      }
+      if (gaitTransition.endGaitParameters && getParameterFilePath(gaitTransition.endName) == parameterFilePath) {
+        gaitTransition.endGaitParameters = reloaded.second;
+      }
+    }
+  }
+  return true;
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::installParameterSet(PreparedParameterSet* parameterSet) {
+  /* the parameters have already been loaded by prepareParameterSet */
+  if(!parameterSet->locomotionController_->initializeWithLoadedParameters(time_step_)) {
+    printf("Could not initialize the controller of parameter file %s\n", parameterSet->parameterFilePath_.c_str());
+    return false;
+  }
+  locomotionController_ = parameterSet->locomotionController_;
+
+  if (parameterSet->hasGaitTransitions_) {
+    gaitTransitions_.swap(parameterSet->gaitTransitions_);
+    requestedGaitTransition_ = nullptr;
+  }
+  return true;
+}
+
+
+bool GaitSwitcherDynamicGaitDefault::prepareParameterSet(int parameterSetIdx, PreparedParameterSet* parameterSet)
+{
   TiXmlHandle hTask(config_.getHandle().FirstChild("GaitSwitcherDynamicGaitDefault"));
   TiXmlElement* pElem;
   int idx = 0;
@@ -330,15 +915,21 @@ bool GaitSwitcherDynamicGaitDefault::loadParameterSet(int parameterSetIdx)
         std::string parameterFileSuffix = isRealRobot_ ? "" : "Sim";
         std::string parameterFilePath = pathToParameterFiles_ +"/" + init + parameterFileSuffix + ".xml";
 
-        locomotionController_.reset(new LocomotionControllerDynamicGaitDefault(parameterFilePath, robotModel_, terrain_, time_step_));
-        locomotionController_->setGaitName(init);
-        if(!locomotionController_->initialize(time_step_)) {
+        parameterSet->parameterFilePath_ = parameterFilePath;
+        parameterSet->locomotionController_.reset(new LocomotionControllerDynamicGaitDefault(parameterFilePath, robotModel_, terrain_, time_step_, &parameterCache_));
+        parameterSet->locomotionController_->setGaitName(init);
+        if(!parameterSet->locomotionController_->getParameterSet()->isDocumentLoaded()) {
           printf("Could not load parameter sets for initial parameter set! (%s)\n",parameterFilePath.c_str());
           return false;
         }
+        if(!parameterSet->locomotionController_->loadParameters()) {
+          printf("Could not load parameters of initial parameter set! (%s)\n",parameterFilePath.c_str());
+          return false;
+        }
 
         /* load the transitions */
-        gaitTransitions_.clear();
+        parameterSet->gaitTransitions_.clear();
+        parameterSet->hasGaitTransitions_ = true;
 
         int isAllowed = 0;
         TiXmlElement* child = hParameterSets.Child(counter).FirstChild( "Transition" ).ToElement();
@@ -354,56 +945,12 @@ bool GaitSwitcherDynamicGaitDefault::loadParameterSet(int parameterSetIdx)
             continue;
           }
 
-          gaitTransitions_.push_back(new GaitTransition());
-          GaitTransition*  gaitTransition = &gaitTransitions_.back();
+          parameterSet->gaitTransitions_.push_back(new GaitTransition());
+          GaitTransition*  gaitTransition = &parameterSet->gaitTransitions_.back();
 
-          // check start gait
+          // the parameters of the start and end gait are loaded on first use of the transition
           child->QueryStringAttribute("start", &gaitTransition->startName);
-          if(!getLocomotionControllerByName(gaitTransition->startName, gaitTransition->startLocomotionSettings)) {
-            // gait hasn't been been loaded yet
-            std::string myParameterFilePath = pathToParameterFiles_ +"/" + gaitTransition->startName + parameterFileSuffix + ".xml";
-            locomotionControllers_.push_back(new LocomotionControllerDynamicGaitDefault(myParameterFilePath, robotModel_, terrain_, time_step_));
-            gaitTransition->startLocomotionSettings =  &locomotionControllers_.back();
-            gaitTransition->startLocomotionSettings->setGaitName(gaitTransition->startName);
-            if(!gaitTransition->startLocomotionSettings->initialize(time_step_)) {
-              printf("Error: Could not initialize controller for gait %s\n", gaitTransition->startName.c_str());
-              return false;
-            }
-          }
-          else {
-            // gait has already been loaded
-            for (unsigned int i=0; i<locomotionControllers_.size();i++){
-              if(locomotionControllers_[i].getGaitName() == gaitTransition->startName) {
-                gaitTransition->startLocomotionSettings = &locomotionControllers_[i];
-                break;
-              }
-            }
-          }
-
-          // check end gait
           child->QueryStringAttribute("end", &gaitTransition->endName);
-          if(!getLocomotionControllerByName(gaitTransition->endName, gaitTransition->endLocomotionSettings)) {
-            // gait hasn't been been loaded yet
-            std::string myParameterFilePath = pathToParameterFiles_ +"/" + gaitTransition->endName + parameterFileSuffix + ".xml";
-            locomotionControllers_.push_back(new LocomotionControllerDynamicGaitDefault(myParameterFilePath, robotModel_, terrain_, time_step_));
-            gaitTransition->endLocomotionSettings = &locomotionControllers_.back();
-            gaitTransition->endLocomotionSettings->setGaitName(gaitTransition->endName);
-
-            if(!gaitTransition->endLocomotionSettings->initialize(time_step_)) {
-              printf("Error: Could not initialize controller for gait %s\n", gaitTransition->endName.c_str());
-              return false;
-            }
-
-          }
-          else {
-            // gait has already been loaded
-              for (unsigned int i=0; i<locomotionControllers_.size();i++){
-                if(locomotionControllers_[i].getGaitName() == gaitTransition->endName) {
-                  gaitTransition->endLocomotionSettings = &locomotionControllers_[i];
-                  break;
-                }
-              }
-          }
 
           /* check speed triggers */
           double value = 0.0;
@@ -578,11 +1125,16 @@ bool GaitSwitcherDynamicGaitDefault::loadParameterSet(int parameterSetIdx)
 
         std::string parameterFileSuffix = isRealRobot_ ? "" : "Sim";
         std::string parameterFilePath = pathToParameterFiles_ +"/" + name + parameterFileSuffix + ".xml";
-        locomotionController_.reset(new LocomotionControllerDynamicGaitDefault(parameterFilePath, robotModel_, terrain_, time_step_));
-        if(!locomotionController_->initialize(time_step_)) {
+        parameterSet->parameterFilePath_ = parameterFilePath;
+        parameterSet->locomotionController_.reset(new LocomotionControllerDynamicGaitDefault(parameterFilePath, robotModel_, terrain_, time_step_, &parameterCache_));
+        if(!parameterSet->locomotionController_->getParameterSet()->isDocumentLoaded()) {
           printf("Could not load parameter file %s\n", parameterFilePath.c_str());
           return false;
         }
+        if(!parameterSet->locomotionController_->loadParameters()) {
+          printf("Could not load parameters from file %s\n", parameterFilePath.c_str());
+          return false;
+        }
 
 
       }
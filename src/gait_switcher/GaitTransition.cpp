@@ -44,8 +44,8 @@
 namespace loco {
 
 GaitTransition::GaitTransition():
-startLocomotionSettings(0),
-endLocomotionSettings(0),
+startGaitParameters(),
+endGaitParameters(),
 timeInterval(-1),
 //stridePhaseTrigger(-1),
 smallerSpeedTrigger(-1),
@@ -44,7 +44,10 @@
 
 namespace loco {
 
-LimbCoordinatorBase::LimbCoordinatorBase() {
+LimbCoordinatorBase::LimbCoordinatorBase() :
+    stabilityMargins_(nullptr),
+    isUsingTorqueControlForSwingLegs_(false)
+{
 
 
 }
@@ -57,4 +60,20 @@ bool LimbCoordinatorBase::setToInterpolated(const LimbCoordinatorBase& limbCoord
   return false;
 }
 
+void LimbCoordinatorBase::setStabilityMargins(const StabilityMargins* stabilityMargins) {
+  stabilityMargins_ = stabilityMargins;
+}
+
+const StabilityMargins* LimbCoordinatorBase::getStabilityMargins() const {
+  return stabilityMargins_;
+}
+
+void LimbCoordinatorBase::setIsUsingTorqueControlForSwingLegs(bool isUsingTorqueControlForSwingLegs) {
+  isUsingTorqueControlForSwingLegs_ = isUsingTorqueControlForSwingLegs;
+}
+
+bool LimbCoordinatorBase::isUsingTorqueControlForSwingLegs() const {
+  return isUsingTorqueControlForSwingLegs_;
+}
+
 } /* namespace loco */
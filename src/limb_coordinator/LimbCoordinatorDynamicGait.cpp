@@ -44,16 +44,41 @@
 #include "starlethModel/RobotModel_common.hpp"
 
 #include "loco/state_switcher/StateSwitcher.hpp"
+#include "loco/temp_helpers/math.hpp"
+
+#include <cmath>
+#include <limits>
 
 namespace loco {
 
 
+LimbCoordinatorDynamicGaitParameters::LimbCoordinatorDynamicGaitParameters() :
+    minCapturePointMarginForLiftOff_(-std::numeric_limits<double>::infinity())
+{
+
+}
+
+
+const ParameterSchema<LimbCoordinatorDynamicGaitParameters>& LimbCoordinatorDynamicGaitParameters::getSchema() {
+  typedef LimbCoordinatorDynamicGaitParameters P;
+  // Built once in a thread-safe static initialization since the parameters are also parsed on the loader thread.
+  static const ParameterSchema<P> schema = [](){
+    ParameterSchema<P> schema;
+    schema.addOptional("LimbCoordination/StabilityMargins", "minCapturePointMarginForLiftOff", &P::minCapturePointMarginForLiftOff_,
+                       -std::numeric_limits<double>::infinity());
+    return schema;
+  }();
+  return schema;
+}
+
+
 LimbCoordinatorDynamicGait::LimbCoordinatorDynamicGait(LegGroup* legs, TorsoBase* torso, GaitPatternBase* gaitPattern, bool isUpdatingStridePhase) :
     LimbCoordinatorBase(),
     isUpdatingStridePhase_(isUpdatingStridePhase),
     legs_(legs),
     torso_(torso),
-    gaitPattern_(gaitPattern)
+    gaitPattern_(gaitPattern),
+    parameters_()
 {
   // initialize state for each leg
 	for (auto leg: *legs_) {
@@ -153,8 +178,8 @@ bool LimbCoordinatorDynamicGait::advance(double dt) {
 		  if (leg->isGrounded()) {
 
 			  if (leg->getSwingPhase() <= 0.3) {
-				  // leg should lift-off (late lift-off)
-				  leg->setIsSupportLeg(false);
+				  // leg should lift-off (late lift-off), but keeps supporting the torso if the capture point would be close to the edge of the support polygon without it
+				  leg->setIsSupportLeg(isLiftOffDelayedByStabilityMargins(*leg));
 //				  state_[iLeg] = 4;
 				  stateSwitcher->setState(StateSwitcher::States::SwingLateLiftOff);
 			  }
@@ -188,6 +213,10 @@ bool LimbCoordinatorDynamicGait::advance(double dt) {
       desiredJointControlModes.setConstant(robotModel::AM_Torque);
       leg->setDesiredJointPositions(leg->getMeasuredJointPositions());
     }
+    else if (isUsingTorqueControlForSwingLegs_) {
+      // the torques that track the desired joint positions are set by the whole-body controller
+      desiredJointControlModes.setConstant(robotModel::AM_Torque);
+    }
     else {
       desiredJointControlModes.setConstant(robotModel::AM_Position);
       leg->setDesiredJointTorques(leg->getMeasuredJointTorques());
@@ -227,7 +256,28 @@ const GaitPatternBase& LimbCoordinatorDynamicGait::getGaitPattern() const {
 
 bool LimbCoordinatorDynamicGait::loadParameters(const TiXmlHandle& handle)
 {
-  return true;
+  return LimbCoordinatorDynamicGaitParameters::getSchema().parse(handle, parameters_);
+}
+
+
+void LimbCoordinatorDynamicGait::setMinCapturePointMarginForLiftOff(double margin) {
+  parameters_.minCapturePointMarginForLiftOff_ = margin;
+}
+
+
+double LimbCoordinatorDynamicGait::getMinCapturePointMarginForLiftOff() const {
+  return parameters_.minCapturePointMarginForLiftOff_;
+}
+
+
+const LimbCoordinatorDynamicGaitParameters& LimbCoordinatorDynamicGait::getParameters() const {
+  return parameters_;
+}
+
+
+bool LimbCoordinatorDynamicGait::isLiftOffDelayedByStabilityMargins(const LegBase& leg) const {
+  return (stabilityMargins_ != nullptr && stabilityMargins_->isValid()
+      && stabilityMargins_->getCapturePointMarginWithoutLeg(leg) < parameters_.minCapturePointMarginForLiftOff_);
 }
 
 
@@ -237,6 +287,16 @@ bool LimbCoordinatorDynamicGait::setToInterpolated(const LimbCoordinatorBase& li
   if (!gaitPattern_->setToInterpolated(coordinator1.getGaitPattern(), coordinator2.getGaitPattern(), t)) {
     return false;
   }
+
+  /* a disabled delay (-infinity) cannot be interpolated, the setting of the closer controller is taken */
+  const double margin1 = coordinator1.getMinCapturePointMarginForLiftOff();
+  const double margin2 = coordinator2.getMinCapturePointMarginForLiftOff();
+  if (std::isfinite(margin1) && std::isfinite(margin2)) {
+    parameters_.minCapturePointMarginForLiftOff_ = linearlyInterpolate(margin1, margin2, 0.0, 1.0, t);
+  }
+  else {
+    parameters_.minCapturePointMarginForLiftOff_ = (t < 0.5) ? margin1 : margin2;
+  }
   return true;
 }
 
@@ -56,6 +56,7 @@ LocomotionControllerDynamicGait::LocomotionControllerDynamicGait(LegGroup* legs,
                                                                  TerrainModelBase* terrainModel) :
     LocomotionControllerBase(),
     isInitialized_(false),
+    isParametersLoaded_(false),
     runtime_(0.0),
     legs_(legs),
     torso_(torso),
@@ -65,11 +66,15 @@ LocomotionControllerDynamicGait::LocomotionControllerDynamicGait(LegGroup* legs,
     footPlacementStrategy_(footPlacementStrategy),
     torsoController_(baseController),
     virtualModelController_(virtualModelController),
+    modelPredictiveController_(nullptr),
+    wholeBodyController_(nullptr),
     contactForceDistribution_(contactForceDistribution),
     parameterSet_(parameterSet),
     eventDetector_(new loco::EventDetector),
     gaitPattern_(gaitPattern),
-    terrainModel_(terrainModel)
+    terrainModel_(terrainModel),
+    terrainQueryCache_(legs, terrainModel),
+    stabilityMargins_(legs, torso)
 {
 
 }
@@ -77,6 +82,7 @@ LocomotionControllerDynamicGait::LocomotionControllerDynamicGait(LegGroup* legs,
 LocomotionControllerDynamicGait::LocomotionControllerDynamicGait() :
     LocomotionControllerBase(),
     isInitialized_(false),
+    isParametersLoaded_(false),
     runtime_(0.0),
     legs_(nullptr),
     torso_(nullptr),
@@ -86,11 +92,15 @@ LocomotionControllerDynamicGait::LocomotionControllerDynamicGait() :
     footPlacementStrategy_(nullptr),
     torsoController_(nullptr),
     virtualModelController_(nullptr),
+    modelPredictiveController_(nullptr),
+    wholeBodyController_(nullptr),
     contactForceDistribution_(nullptr),
     parameterSet_(nullptr),
     eventDetector_(nullptr),
     gaitPattern_(nullptr),
-    terrainModel_(nullptr)
+    terrainModel_(nullptr),
+    terrainQueryCache_(nullptr, nullptr),
+    stabilityMargins_(nullptr, nullptr)
 {
 
 }
@@ -100,15 +110,28 @@ LocomotionControllerDynamicGait::~LocomotionControllerDynamicGait() {
 }
 
 bool LocomotionControllerDynamicGait::initialize(double dt)
+{
+  /* parse and validate the parameters of all modules before anything is initialized */
+  if (!loadParameters()) {
+    return false;
+  }
+  return initializeWithLoadedParameters(dt);
+}
+
+bool LocomotionControllerDynamicGait::initializeWithLoadedParameters(double dt)
 {
   isInitialized_ = false;
 
+  if (!isParametersLoaded_) {
+    printf("LocomotionControllerDynamicGait: Cannot initialize without parameters!\n");
+    return false;
+  }
+
   for (auto leg : *legs_) {
     if(!leg->initialize(dt)) { return false; }
   }
 
   if (!torso_->initialize(dt)) { return false; }
-  TiXmlHandle hLoco(parameterSet_->getHandle().FirstChild("LocomotionController"));
 
   if (!terrainModel_->initialize(dt)) {
     return false;
@@ -118,6 +141,21 @@ bool LocomotionControllerDynamicGait::initialize(double dt)
     return false;
   }
 
+  terrainQueryCache_.invalidate();
+  footPlacementStrategy_->setTerrainQueryCache(&terrainQueryCache_);
+  contactForceDistribution_->setTerrainQueryCache(&terrainQueryCache_);
+
+  stabilityMargins_.invalidate();
+  stabilityMargins_.setContactForceDistribution(contactForceDistribution_);
+  stabilityMargins_.setWholeBodyController(wholeBodyController_);
+  limbCoordinator_->setStabilityMargins(&stabilityMargins_);
+  limbCoordinator_->setIsUsingTorqueControlForSwingLegs(wholeBodyController_ != nullptr);
+
+  if (modelPredictiveController_ != nullptr) {
+    modelPredictiveController_->setGaitPattern(gaitPattern_);
+    modelPredictiveController_->setFootPlacementStrategy(footPlacementStrategy_);
+  }
+
   if (!contactDetector_->initialize(dt)) {
     return false;
   }
@@ -126,57 +164,97 @@ bool LocomotionControllerDynamicGait::initialize(double dt)
     return false;
   }
 
-  if (!limbCoordinator_->loadParameters(hLoco)) {
-    return false;
-  }
   if (!limbCoordinator_->initialize(dt)) {
     return false;
   }
-  if (!footPlacementStrategy_->loadParameters(hLoco)) {
+  if (!footPlacementStrategy_->initialize(dt)) {
     return false;
   }
-  if (!footPlacementStrategy_->initialize(dt)) {
+  if (!torsoController_->initialize(dt)) {
     return false;
   }
+  if(!gaitPattern_->initialize(dt)) {
+	return false;
+  }
+
+  runtime_ = 0.0;
+  
+  isInitialized_ = true;
+  return isInitialized_;
+}
 
 
-  if (!torsoController_->loadParameters(hLoco)) {
+bool LocomotionControllerDynamicGait::loadParameters()
+{
+  isInitialized_ = false;
+  isParametersLoaded_ = false;
+
+  if (!parameterSet_->isDocumentLoaded() && !parameterSet_->reloadXmlDocument()) {
+    printf("Could not load parameter file %s\n", parameterSet_->getParameterFile().c_str());
     return false;
   }
-  if (!torsoController_->initialize(dt)) {
+
+  TiXmlHandle hLoco(parameterSet_->getHandle().FirstChild("LocomotionController"));
+  if (!hLoco.Element()) {
+    printf("Could not find LocomotionController in parameter file %s\n", parameterSet_->getParameterFile().c_str());
     return false;
   }
 
-
+  if (!limbCoordinator_->loadParameters(hLoco)) {
+    return false;
+  }
+  if (!footPlacementStrategy_->loadParameters(hLoco)) {
+    return false;
+  }
+  if (!torsoController_->loadParameters(hLoco)) {
+    return false;
+  }
   if (!contactForceDistribution_->loadParameters(hLoco)) {
     return false;
   }
-
   if (!virtualModelController_->loadParameters(hLoco)) {
     return false;
   }
-
-
+  if (modelPredictiveController_ != nullptr && !modelPredictiveController_->loadParameters(hLoco)) {
+    return false;
+  }
+  if (wholeBodyController_ != nullptr && !wholeBodyController_->loadParameters(hLoco)) {
+    return false;
+  }
   if (!gaitPattern_->loadParameters(TiXmlHandle(hLoco.FirstChild("LimbCoordination")))) {
-	return false;
+    return false;
   }
-  if(!gaitPattern_->initialize(dt)) {
-	return false;
+
+  /* collect the continuous parameters of the modules */
+  parameterVector_.clear();
+  if (!torsoController_->addParametersToVector(&parameterVector_)) {
+    return false;
+  }
+  if (!footPlacementStrategy_->addParametersToVector(&parameterVector_)) {
+    return false;
+  }
+  if (!virtualModelController_->addParametersToVector(&parameterVector_)) {
+    return false;
+  }
+  if (!contactForceDistribution_->addParametersToVector(&parameterVector_)) {
+    return false;
+  }
+  if (!gaitPattern_->addParametersToVector(&parameterVector_)) {
+    return false;
   }
 
-  runtime_ = 0.0;
-  
-  isInitialized_ = true;
-  return isInitialized_;
+  isParametersLoaded_ = true;
+  return true;
 }
 
-
 bool LocomotionControllerDynamicGait::advanceMeasurements(double dt) {
   if (!isInitialized_) {
     return false;
   }
 
   //--- Update sensor measurements.
+  terrainQueryCache_.invalidate();
+  stabilityMargins_.invalidate();
   for (auto leg : *legs_) {
     if (!leg->advance(dt)) {
       return false;
@@ -190,6 +268,9 @@ bool LocomotionControllerDynamicGait::advanceMeasurements(double dt) {
   if (!contactDetector_->advance(dt)) {
     return false;
   }
+
+  // the center of pressure is evaluated with the contact forces of the previous tick
+  stabilityMargins_.update();
   //---
   return true;
 }
@@ -217,6 +298,7 @@ bool LocomotionControllerDynamicGait::advanceSetPoints(double dt) {
   if (!terrainPerception_->advance(dt)) {
     return false;
   }
+  terrainQueryCache_.update();
   //---
 
   /* Decide if a leg is a supporting one */
@@ -231,7 +313,17 @@ bool LocomotionControllerDynamicGait::advanceSetPoints(double dt) {
   if (!torsoController_->advance(dt)) {
     return false;
   }
-  if(!virtualModelController_->compute()) {
+  if (wholeBodyController_ != nullptr) {
+    if (!wholeBodyController_->compute()) {
+      return false;
+    }
+  }
+  else if (modelPredictiveController_ != nullptr) {
+    if (!modelPredictiveController_->compute()) {
+      return false;
+    }
+  }
+  else if(!virtualModelController_->compute()) {
     return false;
   }
 
@@ -293,6 +385,23 @@ const VirtualModelController& LocomotionControllerDynamicGait::getVirtualModelCo
 }
 
 
+void LocomotionControllerDynamicGait::setModelPredictiveController(CentroidalModelPredictiveController* modelPredictiveController) {
+  modelPredictiveController_ = modelPredictiveController;
+}
+
+CentroidalModelPredictiveController* LocomotionControllerDynamicGait::getModelPredictiveController() {
+  return modelPredictiveController_;
+}
+
+void LocomotionControllerDynamicGait::setWholeBodyController(WholeBodyController* wholeBodyController) {
+  wholeBodyController_ = wholeBodyController;
+}
+
+WholeBodyController* LocomotionControllerDynamicGait::getWholeBodyController() {
+  return wholeBodyController_;
+}
+
+
 TerrainPerceptionBase* LocomotionControllerDynamicGait::getTerrainPerception() {
   return terrainPerception_;
 }
@@ -302,6 +411,10 @@ bool LocomotionControllerDynamicGait::isInitialized() const {
   return isInitialized_;
 }
 
+bool LocomotionControllerDynamicGait::isParametersLoaded() const {
+  return isParametersLoaded_;
+}
+
 
 
 double LocomotionControllerDynamicGait::getRuntime() const {
@@ -309,6 +422,16 @@ double LocomotionControllerDynamicGait::getRuntime() const {
 }
 
 bool LocomotionControllerDynamicGait::setToInterpolated(const LocomotionControllerDynamicGait& controller1, const LocomotionControllerDynamicGait& controller2, double t) {
+  if (!controller1.isParametersLoaded() || !controller2.isParametersLoaded()) {
+    printf("LocomotionControllerDynamicGait: Cannot interpolate between controllers without parameters!\n");
+    return false;
+  }
+
+  /* continuous parameters of all modules */
+  if (!parameterVector_.setToInterpolated(controller1.getParameterVector(), controller2.getParameterVector(), t)) {
+    return false;
+  }
+
   if (!limbCoordinator_->setToInterpolated(controller1.getLimbCoordinator(), controller2.getLimbCoordinator(), t)) {
     return false;
   }
@@ -320,12 +443,26 @@ bool LocomotionControllerDynamicGait::setToInterpolated(const LocomotionControll
      return false;
    }
 
-  if (!virtualModelController_->setToInterpolated(controller1.getVirtualModelController(), controller2.getVirtualModelController(), t)) {
-    return false;
-  }
+  /* the parameters of the virtual model controller and the contact force distribution are entirely continuous */
 
   return true;
 }
 
+const ParameterVector& LocomotionControllerDynamicGait::getParameterVector() const {
+  return parameterVector_;
+}
+
+ParameterVector& LocomotionControllerDynamicGait::getParameterVector() {
+  return parameterVector_;
+}
+
+const TerrainQueryCache& LocomotionControllerDynamicGait::getTerrainQueryCache() const {
+  return terrainQueryCache_;
+}
+
+const StabilityMargins& LocomotionControllerDynamicGait::getStabilityMargins() const {
+  return stabilityMargins_;
+}
+
 } /* namespace loco */
 
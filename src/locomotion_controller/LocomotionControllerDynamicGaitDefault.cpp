@@ -42,8 +42,12 @@
 #include "loco/locomotion_controller/LocomotionControllerDynamicGaitDefault.hpp"
 #include "loco/common/TerrainModelHorizontalPlane.hpp"
 #include "loco/common/TerrainModelFreePlane.hpp"
+#include "loco/common/TerrainModelPiecewisePlane.hpp"
+#include "loco/common/TerrainModelHeightMap.hpp"
 #include "loco/terrain_perception/TerrainPerceptionHorizontalPlane.hpp"
 #include "loco/terrain_perception/TerrainPerceptionFreePlane.hpp"
+#include "loco/terrain_perception/TerrainPerceptionPiecewisePlane.hpp"
+#include "loco/terrain_perception/TerrainPerceptionHeightMap.hpp"
 #include "loco/common/LegLinkGroup.hpp"
 
 #include "loco/contact_detection/ContactDetectorConstantDuringStance.hpp"
@@ -55,10 +59,11 @@ namespace loco {
 LocomotionControllerDynamicGaitDefault::LocomotionControllerDynamicGaitDefault(const std::string& parameterFile,
                                                                                robotModel::RobotModel* robotModel,
                                                                                robotTerrain::TerrainBase* terrain,
-                                                                               double dt): LocomotionControllerBase(), robotModel_(robotModel)
+                                                                               double dt,
+                                                                               const ParameterCache* parameterCache): LocomotionControllerBase(), robotModel_(robotModel)
 {
     parameterSet_.reset(new loco::ParameterSet());
-    if (!parameterSet_->loadXmlDocument(parameterFile)) {
+    if (!parameterSet_->loadXmlDocument(parameterFile, parameterCache)) {
       std::cout << "Could not load parameter file: " << parameterFile  << std::endl;
       return;
     }
@@ -66,10 +71,6 @@ LocomotionControllerDynamicGaitDefault::LocomotionControllerDynamicGaitDefault(c
   //  parameterSet_->getHandle().ToNode()->ToDocument()->Print();
 
 
-    /* create terrain */
-    terrainModel_.reset(new loco::TerrainModelFreePlane);
-    //terrainModel_.reset(new loco::TerrainModelHorizontalPlane);
-
     /* create legs */
     leftForeLeg_.reset(new loco::LegStarlETH("leftFore", 0,  robotModel));
     rightForeLeg_.reset(new loco::LegStarlETH("rightFore", 1,  robotModel));
@@ -81,7 +82,53 @@ LocomotionControllerDynamicGaitDefault::LocomotionControllerDynamicGaitDefault(c
 
     /* create torso */
     torso_.reset(new loco::TorsoStarlETH(robotModel));
-    terrainPerception_.reset(new loco::TerrainPerceptionFreePlane((loco::TerrainModelFreePlane*)terrainModel_.get(), legs_.get(), torso_.get()));
+
+    /* create terrain, the model is selected by the optional element LocomotionController/TerrainModel,
+     * type is FreePlane (default), HeightMap or PiecewisePlane */
+    std::string terrainModelType = "FreePlane";
+    TiXmlElement* pTerrainElem = parameterSet_->getHandle().FirstChild("LocomotionController").FirstChild("TerrainModel").Element();
+    if (pTerrainElem != nullptr) {
+      pTerrainElem->QueryStringAttribute("type", &terrainModelType);
+    }
+    if (terrainModelType == "HeightMap") {
+      double resolution = 0.02;
+      int numberOfTiles = 16;
+      double footRadius = 0.03;
+      double filterGain = 0.5;
+      pTerrainElem->QueryDoubleAttribute("resolution", &resolution);
+      pTerrainElem->QueryIntAttribute("numberOfTiles", &numberOfTiles);
+      pTerrainElem->QueryDoubleAttribute("footRadius", &footRadius);
+      pTerrainElem->QueryDoubleAttribute("filterGain", &filterGain);
+      loco::TerrainModelHeightMap* terrainModelHeightMap = new loco::TerrainModelHeightMap(resolution, numberOfTiles, numberOfTiles);
+      terrainModelHeightMap->setFootholdUpdateParameters(footRadius, filterGain);
+      terrainModel_.reset(terrainModelHeightMap);
+      terrainPerception_.reset(new loco::TerrainPerceptionHeightMap(terrainModelHeightMap, legs_.get(), torso_.get()));
+    }
+    else if (terrainModelType == "PiecewisePlane") {
+      double regionSize = 0.3;
+      int maximumNumberOfFootholdsPerRegion = 12;
+      double inlierThreshold = 0.03;
+      int numberOfRansacIterations = 16;
+      int maximumNumberOfRegions = 256;
+      pTerrainElem->QueryDoubleAttribute("regionSize", &regionSize);
+      pTerrainElem->QueryIntAttribute("maximumNumberOfFootholdsPerRegion", &maximumNumberOfFootholdsPerRegion);
+      pTerrainElem->QueryDoubleAttribute("inlierThreshold", &inlierThreshold);
+      pTerrainElem->QueryIntAttribute("numberOfRansacIterations", &numberOfRansacIterations);
+      pTerrainElem->QueryIntAttribute("maximumNumberOfRegions", &maximumNumberOfRegions);
+      loco::TerrainModelPiecewisePlane* terrainModelPiecewisePlane = new loco::TerrainModelPiecewisePlane(regionSize, maximumNumberOfRegions);
+      terrainModel_.reset(terrainModelPiecewisePlane);
+      loco::TerrainPerceptionPiecewisePlane* terrainPerceptionPiecewisePlane = new loco::TerrainPerceptionPiecewisePlane(terrainModelPiecewisePlane, legs_.get(), torso_.get());
+      terrainPerceptionPiecewisePlane->setParameters(maximumNumberOfFootholdsPerRegion, inlierThreshold, numberOfRansacIterations, maximumNumberOfRegions);
+      terrainPerception_.reset(terrainPerceptionPiecewisePlane);
+    }
+    else {
+      if (terrainModelType != "FreePlane") {
+        printf("Unknown terrain model %s, the free plane is used instead.\n", terrainModelType.c_str());
+      }
+      terrainModel_.reset(new loco::TerrainModelFreePlane);
+      terrainPerception_.reset(new loco::TerrainPerceptionFreePlane((loco::TerrainModelFreePlane*)terrainModel_.get(), legs_.get(), torso_.get()));
+    }
+    //terrainModel_.reset(new loco::TerrainModelHorizontalPlane);
 //    terrainPerception_.reset(new loco::TerrainPerceptionHorizontalPlane((loco::TerrainModelHorizontalPlane*)terrainModel_.get(), legs_.get(), torso_.get()));
 
     /* create locomotion controller */
@@ -91,7 +138,26 @@ LocomotionControllerDynamicGaitDefault::LocomotionControllerDynamicGaitDefault(c
     gaitPatternFlightPhases_.reset(new loco::GaitPatternFlightPhases(legs_.get(), torso_.get()));
     limbCoordinator_.reset(new loco::LimbCoordinatorDynamicGait(legs_.get(), torso_.get(), gaitPatternFlightPhases_.get()));
     //footPlacementStrategy_.reset(new loco::FootPlacementStrategyInvertedPendulum(legs_.get(), torso_.get(), terrainModel_.get()));
-    footPlacementStrategy_.reset(new loco::FootPlacementStrategyFreePlane(legs_.get(), torso_.get(), terrainModel_.get()));
+    loco::FootPlacementStrategyFreePlane* footPlacementStrategyFreePlane = new loco::FootPlacementStrategyFreePlane(legs_.get(), torso_.get(), terrainModel_.get());
+    footPlacementStrategy_.reset(footPlacementStrategyFreePlane);
+
+    /* the foot holds are optimized on the terrain model if the optional element LocomotionController/FootPlacementStrategy/FootholdOptimizer exists */
+    TiXmlElement* pFootholdOptimizerElem = parameterSet_->getHandle().FirstChild("LocomotionController").FirstChild("FootPlacementStrategy").FirstChild("FootholdOptimizer").Element();
+    if (pFootholdOptimizerElem) {
+      double spacing = 0.02;
+      int halfWidth = 5;
+      double timeBudget = 0.0005;
+      int numberOfThreads = 1;
+      pFootholdOptimizerElem->QueryDoubleAttribute("spacing", &spacing);
+      pFootholdOptimizerElem->QueryIntAttribute("halfWidth", &halfWidth);
+      pFootholdOptimizerElem->QueryDoubleAttribute("timeBudget", &timeBudget);
+      pFootholdOptimizerElem->QueryIntAttribute("numberOfThreads", &numberOfThreads);
+      footholdOptimizer_.reset(new loco::FootholdOptimizer(terrainModel_.get()));
+      footholdOptimizer_->setGrid(spacing, halfWidth);
+      footholdOptimizer_->setTimeBudget(timeBudget);
+      footholdOptimizer_->setNumberOfThreads(numberOfThreads);
+      footPlacementStrategyFreePlane->setFootholdOptimizer(footholdOptimizer_.get());
+    }
     torsoController_.reset(new loco::TorsoControlDynamicGaitFreePlane(legs_.get(), torso_.get(), terrainModel_.get()));
     contactForceDistribution_.reset(new loco::ContactForceDistribution(torso_, legs_, terrainModel_));
     virtualModelController_.reset(new loco::VirtualModelController(legs_, torso_, contactForceDistribution_));
@@ -111,6 +177,19 @@ LocomotionControllerDynamicGaitDefault::LocomotionControllerDynamicGaitDefault(c
                                                                           gaitPatternFlightPhases_.get(),
                                                                           terrainModel_.get()));
 
+    /* the torso is controlled by the centroidal model-predictive controller instead of the virtual model controller
+     * if the optional element LocomotionController/CentroidalModelPredictiveController exists */
+    if (parameterSet_->getHandle().FirstChild("LocomotionController").FirstChild("CentroidalModelPredictiveController").Element()) {
+      modelPredictiveController_.reset(new loco::CentroidalModelPredictiveController(legs_, torso_, contactForceDistribution_));
+      locomotionController_->setModelPredictiveController(modelPredictiveController_.get());
+    }
+
+    /* the joint torques of all legs are computed by the whole-body controller
+     * if the optional element LocomotionController/WholeBodyController exists */
+    if (parameterSet_->getHandle().FirstChild("LocomotionController").FirstChild("WholeBodyController").Element()) {
+      wholeBodyController_.reset(new loco::WholeBodyController(legs_, torso_));
+      locomotionController_->setWholeBodyController(wholeBodyController_.get());
+    }
 }
 
 LocomotionControllerDynamicGaitDefault::~LocomotionControllerDynamicGaitDefault() {
@@ -119,21 +198,47 @@ LocomotionControllerDynamicGaitDefault::~LocomotionControllerDynamicGaitDefault(
 
 bool LocomotionControllerDynamicGaitDefault::initialize(double dt) {
 
-  if (!missionController_->loadParameters(parameterSet_->getHandle())) {
-    std::cout << "Could not parameters for mission controller: " << std::endl;
+  if (!loadParameters()) {
     return false;
   }
+  return initializeWithLoadedParameters(dt);
+}
+
+bool LocomotionControllerDynamicGaitDefault::initializeWithLoadedParameters(double dt) {
 
   if (!missionController_->initialize(dt)) {
     return false;
   }
 
-  if (!locomotionController_->initialize(dt)) {
+  if (!locomotionController_->initializeWithLoadedParameters(dt)) {
     return false;
   }
   return true;
 }
 
+bool LocomotionControllerDynamicGaitDefault::loadParameters() {
+  if (!parameterSet_->isDocumentLoaded() && !parameterSet_->reloadXmlDocument()) {
+    std::cout << "Could not load parameter file: " << parameterSet_->getParameterFile() << std::endl;
+    return false;
+  }
+
+  if (!missionController_->loadParameters(parameterSet_->getHandle())) {
+    std::cout << "Could not parameters for mission controller: " << std::endl;
+    return false;
+  }
+
+  if (!locomotionController_->loadParameters()) {
+    return false;
+  }
+  if (!missionController_->addParametersToVector(&locomotionController_->getParameterVector())) {
+    return false;
+  }
+
+  /* all parameters are stored in the modules, the document is not needed anymore */
+  parameterSet_->releaseXmlDocument();
+  return true;
+}
+
 bool LocomotionControllerDynamicGaitDefault::advanceMeasurements(double dt) {
 
   if (!locomotionController_->advanceMeasurements(dt)) {
@@ -208,16 +313,30 @@ void LocomotionControllerDynamicGaitDefault::setGaitName(const std::string& name
   limbCoordinator_->getGaitPattern()->setName(name);
 }
 
-bool LocomotionControllerDynamicGaitDefault::setToInterpolated(const LocomotionControllerDynamicGaitDefault& controller1,  const LocomotionControllerDynamicGaitDefault& controller2, double t) {
-  if(!missionController_->setToInterpolated(controller1.getMissionController(),
-                                            controller2.getMissionController(),
-                                            t)) {
+bool LocomotionControllerDynamicGaitDefault::getGaitParameters(GaitParameters* gaitParameters) const {
+  if (!locomotionController_->isParametersLoaded()) {
+    printf("Cannot get the gait parameters since the parameters are not loaded!\n");
+    return false;
+  }
+  gaitParameters->gaitName_ = getGaitName();
+  gaitParameters->parameterFilePath_ = parameterSet_->getParameterFile();
+  gaitParameters->parameterVector_ = locomotionController_->getParameterVector();
+  gaitParameters->parameterVector_.readFromModules();
+  gaitParameters->parameterVector_.detachFromModules();
+  gaitParameters->desiredTorsoForeHeightTrajectory_ = torsoController_->getDesiredTorsoForeHeightTrajectory();
+  gaitParameters->desiredTorsoHindHeightTrajectory_ = torsoController_->getDesiredTorsoHindHeightTrajectory();
+  return true;
+}
+
+bool LocomotionControllerDynamicGaitDefault::setToInterpolated(const GaitParameters& gaitParameters1, const GaitParameters& gaitParameters2, double t) {
+  /* continuous parameters of all modules including the mission controller */
+  if (!locomotionController_->getParameterVector().setToInterpolated(gaitParameters1.parameterVector_, gaitParameters2.parameterVector_, t)) {
     return false;
   }
 
-  if(!locomotionController_->setToInterpolated(controller1.getLocomotionControllerDynamicGait(),
-                                               controller2.getLocomotionControllerDynamicGait(),
-                                               t)) {
+  if (!torsoController_->setHeightTrajectoriesToInterpolated(gaitParameters1.desiredTorsoForeHeightTrajectory_, gaitParameters1.desiredTorsoHindHeightTrajectory_,
+                                                             gaitParameters2.desiredTorsoForeHeightTrajectory_, gaitParameters2.desiredTorsoHindHeightTrajectory_,
+                                                             t)) {
     return false;
   }
   return true;
@@ -56,4 +56,8 @@ bool MissionControlBase::setToInterpolated(const MissionControlBase& missionCont
   return false;
 }
 
+bool MissionControlBase::addParametersToVector(ParameterVector* parameterVector) {
+  return true;
+}
+
 } /* namespace loco */
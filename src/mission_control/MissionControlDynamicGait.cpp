@@ -104,6 +104,9 @@ bool MissionControlDynamicGait::switchToStand() {
 bool MissionControlDynamicGait::switchToStaticLateralWalk() {
   return gaitSwitcher_->transitToGait("StaticLateralWalk");
 }
+bool MissionControlDynamicGait::switchToParameterSet(int parameterSetIdx) {
+  return gaitSwitcher_->loadParameterSetAsync(parameterSetIdx);
+}
 
 void MissionControlDynamicGait::setDesiredPositionOffsetInControlFrame(const Position& desiredPositionOffsetInControlFrame) {
   desiredPositionOffsetInControlFrame_ = desiredPositionOffsetInControlFrame;
@@ -56,9 +56,10 @@ MissionControlJoystick::MissionControlJoystick(robotModel::RobotModel* robotMode
   minimalOrientationHeadingToBase_(),
   maximalOrientationHeadingToBase_()
 {
-  filteredVelocities_[0].setAlpha(0.005);
-  filteredVelocities_[1].setAlpha(0.05);
-  filteredVelocities_[2].setAlpha(0.05);
+  // time constants [s] of the former per-sample smoothing factors 0.005 and 0.05 at 400 Hz
+  velocityFilter_.setFirstOrder(0, 0.5);
+  velocityFilter_.setFirstOrder(1, 0.05);
+  velocityFilter_.setFirstOrder(2, 0.05);
 }
 
 MissionControlJoystick::~MissionControlJoystick() {
@@ -72,21 +73,21 @@ bool MissionControlJoystick::initialize(double dt) {
 
 bool MissionControlJoystick::advance(double dt) {
   robotUtils::Joystick* joyStick = robotModel_->sensors().getJoystick();
+  FilterBank<3>::Array velocityInput;
+  velocityInput << joyStick->getSagittal(), joyStick->getCoronal(), joyStick->getYaw();
+  const FilterBank<3>::Array& filteredVelocity = velocityFilter_.advance(dt, velocityInput);
+
   const double maxHeadingVel = maximumBaseTwistInHeadingFrame_.getTranslationalVelocity().x();
-  filteredVelocities_[0].update(joyStick->getSagittal());
-  double headingVel = filteredVelocities_[0].val();
+  double headingVel = filteredVelocity(0);
   boundToRange(&headingVel, -maxHeadingVel, maxHeadingVel);
 
   const double maxLateralVel = maximumBaseTwistInHeadingFrame_.getTranslationalVelocity().y();
-  filteredVelocities_[1].update(joyStick->getCoronal());
-
-  double lateralVel = filteredVelocities_[1].val();
+  double lateralVel = filteredVelocity(1);
   boundToRange(&lateralVel, -maxLateralVel, maxLateralVel);
   LinearVelocity linearVelocity(headingVel, lateralVel, 0.0);
 
   const double maxTurningVel = maximumBaseTwistInHeadingFrame_.getRotationalVelocity().z();
-  filteredVelocities_[2].update(joyStick->getYaw());
-  double turningVel = filteredVelocities_[2].val();
+  double turningVel = filteredVelocity(2);
   boundToRange(&turningVel, -maxTurningVel, maxTurningVel);
   LocalAngularVelocity angularVelocity(0.0, 0.0, turningVel);
 
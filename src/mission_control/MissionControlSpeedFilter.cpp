@@ -55,9 +55,10 @@ MissionControlSpeedFilter::MissionControlSpeedFilter()
                                                        std::numeric_limits<LinearVelocity::Scalar>::max(),
                                                        std::numeric_limits<LinearVelocity::Scalar>::max()) )
 {
-  filteredVelocities_[0].setAlpha(0.005);
-  filteredVelocities_[1].setAlpha(0.05);
-  filteredVelocities_[2].setAlpha(0.05);
+  // time constants [s] of the former per-sample smoothing factors 0.005 and 0.05 at 400 Hz
+  velocityFilter_.setFirstOrder(0, 0.5);
+  velocityFilter_.setFirstOrder(1, 0.05);
+  velocityFilter_.setFirstOrder(2, 0.05);
 }
 
 MissionControlSpeedFilter::~MissionControlSpeedFilter() {
@@ -76,16 +77,19 @@ T mapInRange (T x, T in_min, T in_max, T out_min, T out_max) {
 
 
 bool MissionControlSpeedFilter::advance(double dt) {
+  FilterBank<3>::Array velocityInput;
+  velocityInput << unfilteredBaseTwistInHeadingFrame_.getTranslationalVelocity().x(),
+                   unfilteredBaseTwistInHeadingFrame_.getTranslationalVelocity().y(),
+                   unfilteredBaseTwistInHeadingFrame_.getRotationalVelocity().z();
+  const FilterBank<3>::Array& filteredVelocity = velocityFilter_.advance(dt, velocityInput);
+
   const double maxHeadingVel = maximumBaseTwistInHeadingFrame_.getTranslationalVelocity().x();
-  filteredVelocities_[0].update(unfilteredBaseTwistInHeadingFrame_.getTranslationalVelocity().x());
-  double headingVel = filteredVelocities_[0].val();
+  double headingVel = filteredVelocity(0);
 //  boundToRange(&headingVel, -maxHeadingVel, maxHeadingVel);
   headingVel = mapInRange(headingVel, -1.0, 1.0, -maxHeadingVel, maxHeadingVel);
 
   const double maxLateralVel = maximumBaseTwistInHeadingFrame_.getTranslationalVelocity().y();
-  filteredVelocities_[1].update(unfilteredBaseTwistInHeadingFrame_.getTranslationalVelocity().y());
-
-  double lateralVel = filteredVelocities_[1].val();
+  double lateralVel = filteredVelocity(1);
 //  boundToRange(&lateralVel, -maxLateralVel, maxLateralVel);
   lateralVel = mapInRange(lateralVel, -1.0, 1.0, -maxLateralVel, maxLateralVel);
 
@@ -93,8 +97,7 @@ bool MissionControlSpeedFilter::advance(double dt) {
   LinearVelocity linearVelocity(headingVel, lateralVel, 0.0);
 
   const double maxTurningVel = maximumBaseTwistInHeadingFrame_.getRotationalVelocity().z();
-  filteredVelocities_[2].update(unfilteredBaseTwistInHeadingFrame_.getRotationalVelocity().z());
-  double turningVel = filteredVelocities_[2].val();
+  double turningVel = filteredVelocity(2);
   //boundToRange(&turningVel, -maxTurningVel, maxTurningVel);
   turningVel = mapInRange(turningVel, -1.0, 1.0, -maxTurningVel, maxTurningVel);
 
@@ -387,6 +390,21 @@ bool MissionControlSpeedFilter::setToInterpolated(const MissionControlBase& miss
   return true;
 }
 
+bool MissionControlSpeedFilter::addParametersToVector(ParameterVector* parameterVector) {
+  std::vector<double*> parameters;
+  for (int k=0; k<3; k++) {
+    parameters.push_back(&maximumBaseTwistInHeadingFrame_.getTranslationalVelocity().toImplementation()(k));
+  }
+  parameters.push_back(&maximumBaseTwistInHeadingFrame_.getRotationalVelocity().toImplementation()(2));
+  for (int k=0; k<3; k++) {
+    parameters.push_back(&minimalDesiredPositionOffsetInWorldFrame_.toImplementation()(k));
+  }
+  for (int k=0; k<3; k++) {
+    parameters.push_back(&maximalDesiredPositionOffsetInWorldFrame_.toImplementation()(k));
+  }
+  parameterVector->addSlice("MissionControlSpeedFilter", parameters);
+  return true;
+}
 
 const Position& MissionControlSpeedFilter::getDesiredPositionOffsetInWorldFrame() const {
   return desiredPositionOffsetInWorldFrame_;
@@ -67,7 +67,7 @@ MissionControlStaticGait::MissionControlStaticGait(robotModel::RobotModel* robot
     isExternallyVelocityControlled_(false),
     locomotionController_(locomotionController),
     speedFilter_(),
-    useRosService_(false)
+    useFootholdValidation_(false)
 {
 
 }
@@ -79,11 +79,11 @@ MissionControlStaticGait::~MissionControlStaticGait() {
 bool MissionControlStaticGait::initialize(double dt) {
   isExternallyVelocityControlled_ = false;
   loco::FootPlacementStrategyStaticGait* fps = static_cast<loco::FootPlacementStrategyStaticGait*>(locomotionController_->getFootPlacementStrategy());
-  useRosService_ = fps->isUsingRosService();
+  useFootholdValidation_ = fps->isUsingFootholdValidation();
 
   std::cout << magenta << "[MissionController/init] "
-            << blue << "ROS foothold service is: "
-            << red << ( useRosService_ ? std::string{"enabled"} : std::string{"disabled"} )
+            << blue << "Foothold validation is: "
+            << red << ( useFootholdValidation_ ? std::string{"enabled"} : std::string{"disabled"} )
             << def << std::endl;
 
   return true;
@@ -152,12 +152,12 @@ bool MissionControlStaticGait::advance(double dt) {
 
   if (joyStick->getButtonOneClick(3)) {
     loco::FootPlacementStrategyStaticGait* fps = static_cast<loco::FootPlacementStrategyStaticGait*>(locomotionController_->getFootPlacementStrategy());
-    useRosService_ = !useRosService_;
-    fps->setUseRosService(useRosService_);
+    useFootholdValidation_ = !useFootholdValidation_;
+    fps->setUseFootholdValidation(useFootholdValidation_);
 
     std::cout << magenta << "[MissionController/advance] "
-              << blue << "ROS foothold service is now: "
-              << red << ( fps->isUsingRosService() ? std::string{"enabled"} : std::string{"disabled"} )
+              << blue << "Foothold validation is now: "
+              << red << ( fps->isUsingFootholdValidation() ? std::string{"enabled"} : std::string{"disabled"} )
               << def << std::endl;
   }
 
@@ -0,0 +1,303 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     CentroidalModelPredictiveController.cpp
+* @brief
+*/
+#include "loco/motion_control/CentroidalModelPredictiveController.hpp"
+#include "robotUtils/loggers/logger.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace loco {
+
+CentroidalModelPredictiveControllerParameters::CentroidalModelPredictiveControllerParameters() :
+    numberOfStages_(15.0),
+    stageDuration_(0.03),
+    inertia_(Eigen::Vector3d::Ones()),
+    orientationWeights_(Eigen::Vector3d::Zero()),
+    positionWeights_(Eigen::Vector3d::Zero()),
+    angularVelocityWeights_(Eigen::Vector3d::Zero()),
+    linearVelocityWeights_(Eigen::Vector3d::Zero()),
+    forceWeight_(1.0e-6),
+    frictionCoefficient_(0.6),
+    minimalNormalForce_(0.0),
+    maximalNormalForce_(1000.0),
+    penalty_(1.0e-3),
+    maximalNumberOfIterations_(20.0),
+    tolerance_(1.0)
+{
+
+}
+
+const ParameterSchema<CentroidalModelPredictiveControllerParameters>& CentroidalModelPredictiveControllerParameters::getSchema() {
+  static ParameterSchema<CentroidalModelPredictiveControllerParameters> schema;
+  if (schema.getEntries().empty()) {
+    typedef CentroidalModelPredictiveControllerParameters P;
+    schema.add("CentroidalModelPredictiveController/Horizon", "numberOfStages", &P::numberOfStages_);
+    schema.add("CentroidalModelPredictiveController/Horizon", "stageDuration", &P::stageDuration_);
+    const char* inertiaAttributes[3] = {"xx", "yy", "zz"};
+    const char* translationalDirections[3] = {"X", "Y", "Z"};
+    const char* rotationalDirections[3] = {"Roll", "Pitch", "Yaw"};
+    for (int i=0; i<3; i++) {
+      schema.add("CentroidalModelPredictiveController/Inertia", inertiaAttributes[i], &P::inertia_, i);
+      const std::string translationPath = std::string("CentroidalModelPredictiveController/Weights/") + translationalDirections[i];
+      schema.add(translationPath, "position", &P::positionWeights_, i);
+      schema.add(translationPath, "velocity", &P::linearVelocityWeights_, i);
+      const std::string rotationPath = std::string("CentroidalModelPredictiveController/Weights/") + rotationalDirections[i];
+      schema.add(rotationPath, "orientation", &P::orientationWeights_, i);
+      schema.add(rotationPath, "velocity", &P::angularVelocityWeights_, i);
+    }
+    schema.add("CentroidalModelPredictiveController/Weights/Force", "weight", &P::forceWeight_);
+    schema.add("CentroidalModelPredictiveController/Friction", "coefficient", &P::frictionCoefficient_);
+    schema.add("CentroidalModelPredictiveController/Friction", "minimalNormalForce", &P::minimalNormalForce_);
+    schema.add("CentroidalModelPredictiveController/Friction", "maximalNormalForce", &P::maximalNormalForce_);
+    schema.addOptional("CentroidalModelPredictiveController/Solver", "penalty", &P::penalty_, 1.0e-3);
+    schema.addOptional("CentroidalModelPredictiveController/Solver", "maximalNumberOfIterations", &P::maximalNumberOfIterations_, 20.0);
+    schema.addOptional("CentroidalModelPredictiveController/Solver", "tolerance", &P::tolerance_, 1.0);
+  }
+  return schema;
+}
+
+
+CentroidalModelPredictiveController::CentroidalModelPredictiveController(std::shared_ptr<LegGroup> legs, std::shared_ptr<TorsoBase> torso,
+                                                                         std::shared_ptr<ContactForceDistributionBase> contactForceDistribution)
+    : MotionControllerBase(legs, torso),
+      contactForceDistribution_(contactForceDistribution),
+      gaitPattern_(nullptr),
+      footPlacementStrategy_(nullptr)
+{
+  for (int iLeg=0; iLeg<CentroidalMpcSolver::numberOfLegs; iLeg++) {
+    groundReactionForcesInWorldFrame_[iLeg].setZero();
+  }
+  netForceInWorldFrame_.setZero();
+}
+
+CentroidalModelPredictiveController::~CentroidalModelPredictiveController()
+{
+
+}
+
+bool CentroidalModelPredictiveController::addToLogger()
+{
+  robotUtils::logger->addDoubleKindrForceToLog(netForceInWorldFrame_, "des_force", "MPC", "N", true);
+  robotUtils::logger->updateLogger(true);
+  return true;
+}
+
+bool CentroidalModelPredictiveController::loadParameters(const TiXmlHandle& handle)
+{
+  isParametersLoaded_ = false;
+
+  if (!handle.FirstChild("CentroidalModelPredictiveController").Element()) {
+    printf("Could not find CentroidalModelPredictiveController\n");
+    return false;
+  }
+
+  if (!CentroidalModelPredictiveControllerParameters::getSchema().parse(handle, parameters_)) {
+    return false;
+  }
+
+  if (!solver_.initialize((int)std::floor(parameters_.numberOfStages_ + 0.5), parameters_.stageDuration_)) {
+    return false;
+  }
+  CentroidalMpcSolver::State stateWeights;
+  stateWeights << parameters_.orientationWeights_, parameters_.positionWeights_,
+                  parameters_.angularVelocityWeights_, parameters_.linearVelocityWeights_;
+  solver_.setStateWeights(stateWeights);
+  solver_.setForceWeight(parameters_.forceWeight_);
+  solver_.setFrictionCoefficient(parameters_.frictionCoefficient_);
+  solver_.setNormalForceLimits(parameters_.minimalNormalForce_, parameters_.maximalNormalForce_);
+  solver_.setAdmmParameters(parameters_.penalty_, (int)std::floor(parameters_.maximalNumberOfIterations_ + 0.5), parameters_.tolerance_);
+
+  isParametersLoaded_ = true;
+  return true;
+}
+
+bool CentroidalModelPredictiveController::compute()
+{
+  if (!isParametersLoaded()) return false;
+
+  CentroidalMpcSolver::State initialState;
+  if (!setUpProblem(initialState)) {
+    return false;
+  }
+  if (!solver_.solve(initialState)) {
+    return false;
+  }
+
+  netForceInWorldFrame_.setZero();
+  const CentroidalMpcSolver::Input& forces = solver_.getInputOfFirstStage();
+  for (int iLeg=0; iLeg<CentroidalMpcSolver::numberOfLegs; iLeg++) {
+    groundReactionForcesInWorldFrame_[iLeg] = Force(forces.segment<3>(3*iLeg));
+    netForceInWorldFrame_ += groundReactionForcesInWorldFrame_[iLeg];
+  }
+  return contactForceDistribution_->computeJointTorquesFromGroundReactionForces(groundReactionForcesInWorldFrame_);
+}
+
+bool CentroidalModelPredictiveController::setUpProblem(CentroidalMpcSolver::State& initialState)
+{
+  const TorsoStateMeasured& measuredState = torso_->getMeasuredState();
+  const TorsoStateDesired& desiredState = torso_->getDesiredState();
+  const RotationQuaternion& orientationWorldToBase = measuredState.getOrientationWorldToBase();
+  const RotationQuaternion& orientationWorldToControl = measuredState.getOrientationWorldToControl();
+
+  /* single rigid body model of the whole robot */
+  double mass = torso_->getProperties().getMass();
+  for (const auto& leg : *legs_) {
+    mass += leg->getProperties().getMass();
+  }
+  solver_.setMass(mass);
+  solver_.setGravity(torso_->getProperties().getGravity().toImplementation());
+
+  // rotate the principal moments of inertia to the world frame
+  Eigen::Matrix3d orientationBaseToWorld;
+  for (int i=0; i<3; i++) {
+    orientationBaseToWorld.col(i) = orientationWorldToBase.inverseRotate(Vector(Eigen::Vector3d::Unit(i))).toImplementation();
+  }
+  solver_.setInertiaInWorldFrame(orientationBaseToWorld*parameters_.inertia_.asDiagonal()*orientationBaseToWorld.transpose());
+
+  /* initial state, the orientation is expressed as the error to the desired orientation */
+  const Position positionBaseToCoMInWorldFrame = orientationWorldToBase.inverseRotate(torso_->getProperties().getBaseToCenterOfMassPositionInBaseFrame());
+  const Eigen::Vector3d orientationError = desiredState.getOrientationControlToBase().boxMinus(measuredState.getOrientationControlToBase());
+  initialState.segment<3>(0) = -orientationWorldToBase.inverseRotate(Vector(orientationError)).toImplementation();
+  initialState.segment<3>(3) = measuredState.getPositionWorldToBaseInWorldFrame().toImplementation() + positionBaseToCoMInWorldFrame.toImplementation();
+  initialState.segment<3>(6) = orientationWorldToBase.inverseRotate(measuredState.getAngularVelocityBaseInBaseFrame()).toImplementation();
+  initialState.segment<3>(9) = orientationWorldToBase.inverseRotate(measuredState.getLinearVelocityBaseInBaseFrame()).toImplementation();
+
+  /* reference, the desired state is extrapolated with the desired velocities */
+  const Position positionWorldToDesiredCoMInWorldFrame = measuredState.getPositionWorldToControlInWorldFrame()
+      + orientationWorldToControl.inverseRotate(desiredState.getPositionControlToBaseInControlFrame())
+      + positionBaseToCoMInWorldFrame;
+  const Eigen::Vector3d desiredAngularVelocityInWorldFrame = orientationWorldToControl.inverseRotate(desiredState.getAngularVelocityBaseInControlFrame()).toImplementation();
+  const LinearVelocity desiredLinearVelocityInWorldFrame = orientationWorldToControl.inverseRotate(desiredState.getLinearVelocityBaseInControlFrame());
+
+  const double stageDuration = solver_.getStageDuration();
+  const int numberOfStages = solver_.getNumberOfStages();
+  for (int k=1; k<=numberOfStages; k++) {
+    const double time = k*stageDuration;
+    CentroidalMpcSolver::State reference;
+    reference.segment<3>(0) = time*desiredAngularVelocityInWorldFrame;
+    reference.segment<3>(3) = positionWorldToDesiredCoMInWorldFrame.toImplementation() + time*desiredLinearVelocityInWorldFrame.toImplementation();
+    reference.segment<3>(6) = desiredAngularVelocityInWorldFrame;
+    reference.segment<3>(9) = desiredLinearVelocityInWorldFrame.toImplementation();
+    solver_.setReference(k, reference);
+  }
+
+  /* contact schedule and lever arms */
+  double strideDuration = 0.0;
+  double stridePhase = 0.0;
+  if (gaitPattern_ != nullptr) {
+    strideDuration = gaitPattern_->getStrideDuration();
+    stridePhase = gaitPattern_->getStridePhase();
+  }
+
+  for (const auto& leg : *legs_) {
+    const int legId = leg->getId();
+    if (legId < 0 || legId >= CentroidalMpcSolver::numberOfLegs) {
+      printf("[CentroidalModelPredictiveController] Invalid id %d of a leg!\n", legId);
+      return false;
+    }
+
+    // the next foothold of a swing leg is planned by the foot placement strategy,
+    // a leg that lifts off within the horizon is assumed to step by the desired velocity times the stride duration
+    const bool isSwingLeg = !leg->isSupportLeg();
+    Position positionWorldToFootHoldInWorldFrame = leg->getPositionWorldToFootInWorldFrame();
+    if (!isSwingLeg || footPlacementStrategy_ == nullptr
+        || !footPlacementStrategy_->getPositionWorldToFootHoldInWorldFrame(legId, positionWorldToFootHoldInWorldFrame)) {
+      positionWorldToFootHoldInWorldFrame = leg->getPositionWorldToFootInWorldFrame()
+          + Position(strideDuration*desiredLinearVelocityInWorldFrame.toImplementation());
+    }
+
+    bool hasSwung = isSwingLeg;
+    for (int k=0; k<numberOfStages; k++) {
+      bool isInContact = leg->isSupportLeg();
+      if (k > 0 && gaitPattern_ != nullptr && strideDuration > 0.0) {
+        const double phase = std::fmod(stridePhase + k*stageDuration/strideDuration, 1.0);
+        isInContact = (gaitPattern_->getStancePhaseForLeg(legId, phase) >= 0.0);
+      }
+      hasSwung = hasSwung || !isInContact;
+
+      const Position& positionWorldToFootInWorldFrame = hasSwung ? positionWorldToFootHoldInWorldFrame : leg->getPositionWorldToFootInWorldFrame();
+      const Position positionWorldToCoMInWorldFrame = positionWorldToDesiredCoMInWorldFrame + Position(k*stageDuration*desiredLinearVelocityInWorldFrame.toImplementation());
+      solver_.setContact(k, legId, isInContact, positionWorldToFootInWorldFrame.toImplementation() - positionWorldToCoMInWorldFrame.toImplementation());
+    }
+  }
+
+  return true;
+}
+
+void CentroidalModelPredictiveController::setGaitPattern(GaitPatternBase* gaitPattern) {
+  gaitPattern_ = gaitPattern;
+}
+
+GaitPatternBase* CentroidalModelPredictiveController::getGaitPattern() {
+  return gaitPattern_;
+}
+
+void CentroidalModelPredictiveController::setFootPlacementStrategy(FootPlacementStrategyBase* footPlacementStrategy) {
+  footPlacementStrategy_ = footPlacementStrategy;
+}
+
+FootPlacementStrategyBase* CentroidalModelPredictiveController::getFootPlacementStrategy() {
+  return footPlacementStrategy_;
+}
+
+const Force& CentroidalModelPredictiveController::getGroundReactionForceInWorldFrame(int legId) const {
+  return groundReactionForcesInWorldFrame_[legId];
+}
+
+const CentroidalMpcSolver& CentroidalModelPredictiveController::getSolver() const {
+  return solver_;
+}
+
+const ContactForceDistributionBase& CentroidalModelPredictiveController::getContactForceDistribution() const {
+  return *contactForceDistribution_;
+}
+
+const CentroidalModelPredictiveControllerParameters& CentroidalModelPredictiveController::getParameters() const {
+  return parameters_;
+}
+
+bool CentroidalModelPredictiveController::isParametersLoaded() const
+{
+  if (isParametersLoaded_) return true;
+
+  printf("Centroidal model-predictive controller parameters are not loaded.\n");
+  return false;
+}
+
+} /* namespace loco */
@@ -0,0 +1,368 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     CentroidalMpcSolver.cpp
+* @brief
+*/
+
+#include "loco/motion_control/CentroidalMpcSolver.hpp"
+
+#include <Eigen/LU>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace loco {
+
+namespace {
+
+//! Squared distance of the force to the friction pyramid for the normal force fz
+double getSquaredDistanceToFrictionPyramid(double fz, const Eigen::Vector3d& force, double frictionCoefficient) {
+  const double errorX = std::max(0.0, std::fabs(force.x()) - frictionCoefficient*fz);
+  const double errorY = std::max(0.0, std::fabs(force.y()) - frictionCoefficient*fz);
+  return (fz - force.z())*(fz - force.z()) + errorX*errorX + errorY*errorY;
+}
+
+} // namespace
+
+CentroidalMpcSolver::CentroidalMpcSolver() :
+    isInitialized_(false),
+    numberOfStages_(0),
+    stageDuration_(0.0),
+    mass_(1.0),
+    gravity_(0.0, 0.0, -9.81),
+    forceWeight_(1.0e-6),
+    frictionCoefficient_(0.6),
+    minimalNormalForce_(0.0),
+    maximalNormalForce_(1000.0),
+    penalty_(1.0e-3),
+    maximalNumberOfIterations_(20),
+    tolerance_(1.0),
+    residual_(0.0),
+    numberOfIterations_(0)
+{
+  inverseInertia_.setIdentity();
+  stateWeights_.setOnes();
+  for (int k=0; k<maxNumberOfStages; k++) {
+    for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+      isInContact_[k][iLeg] = false;
+      positionsCoMToFoot_[k][iLeg].setZero();
+    }
+    B_[k].setZero();
+    crossTerms_[k].setZero();
+    feedbackGains_[k].setZero();
+    feedforwardInputs_[k].setZero();
+  }
+  for (int k=0; k<=maxNumberOfStages; k++) {
+    references_[k].setZero();
+    states_[k].setZero();
+    valueHessians_[k].setZero();
+  }
+  reset();
+}
+
+
+CentroidalMpcSolver::~CentroidalMpcSolver() {
+
+}
+
+
+bool CentroidalMpcSolver::initialize(int numberOfStages, double stageDuration) {
+  isInitialized_ = false;
+  if (numberOfStages < 1 || numberOfStages > maxNumberOfStages) {
+    printf("[CentroidalMpcSolver] The horizon has %d stages, allowed are 1 to %d!\n", numberOfStages, maxNumberOfStages);
+    return false;
+  }
+  if (stageDuration <= 0.0) {
+    printf("[CentroidalMpcSolver] The stage duration has to be positive!\n");
+    return false;
+  }
+  numberOfStages_ = numberOfStages;
+  stageDuration_ = stageDuration;
+  reset();
+  isInitialized_ = true;
+  return true;
+}
+
+int CentroidalMpcSolver::getNumberOfStages() const {
+  return numberOfStages_;
+}
+
+double CentroidalMpcSolver::getStageDuration() const {
+  return stageDuration_;
+}
+
+void CentroidalMpcSolver::setMass(double mass) {
+  mass_ = mass;
+}
+
+void CentroidalMpcSolver::setInertiaInWorldFrame(const Eigen::Matrix3d& inertia) {
+  inverseInertia_ = inertia.inverse();
+}
+
+void CentroidalMpcSolver::setGravity(const Eigen::Vector3d& gravity) {
+  gravity_ = gravity;
+}
+
+void CentroidalMpcSolver::setStateWeights(const State& weights) {
+  stateWeights_ = weights;
+}
+
+void CentroidalMpcSolver::setForceWeight(double weight) {
+  forceWeight_ = weight;
+}
+
+void CentroidalMpcSolver::setFrictionCoefficient(double frictionCoefficient) {
+  frictionCoefficient_ = frictionCoefficient;
+}
+
+void CentroidalMpcSolver::setNormalForceLimits(double minimalNormalForce, double maximalNormalForce) {
+  minimalNormalForce_ = minimalNormalForce;
+  maximalNormalForce_ = maximalNormalForce;
+}
+
+void CentroidalMpcSolver::setAdmmParameters(double penalty, int maximalNumberOfIterations, double tolerance) {
+  penalty_ = penalty;
+  maximalNumberOfIterations_ = std::max(maximalNumberOfIterations, 1);
+  tolerance_ = tolerance;
+}
+
+void CentroidalMpcSolver::setContact(int stage, int iLeg, bool isInContact, const Eigen::Vector3d& positionCoMToFootInWorldFrame) {
+  isInContact_[stage][iLeg] = isInContact;
+  positionsCoMToFoot_[stage][iLeg] = positionCoMToFootInWorldFrame;
+}
+
+void CentroidalMpcSolver::setReference(int stage, const State& reference) {
+  references_[stage] = reference;
+}
+
+void CentroidalMpcSolver::reset() {
+  for (int k=0; k<maxNumberOfStages; k++) {
+    inputs_[k].setZero();
+    projectedInputs_[k].setZero();
+    duals_[k].setZero();
+  }
+  residual_ = 0.0;
+  numberOfIterations_ = 0;
+}
+
+bool CentroidalMpcSolver::solve(const State& initialState) {
+  if (!isInitialized_) {
+    printf("[CentroidalMpcSolver] The solver is not initialized!\n");
+    return false;
+  }
+
+  updateModel();
+  if (!factorize()) {
+    printf("[CentroidalMpcSolver] The Riccati recursion failed!\n");
+    return false;
+  }
+  for (numberOfIterations_=1; numberOfIterations_<=maximalNumberOfIterations_; numberOfIterations_++) {
+    solveAffineTerms();
+    rollout(initialState);
+    residual_ = updateProjection();
+    if (residual_ < tolerance_) {
+      break;
+    }
+  }
+  numberOfIterations_ = std::min(numberOfIterations_, maximalNumberOfIterations_);
+  return true;
+}
+
+const CentroidalMpcSolver::Input& CentroidalMpcSolver::getInputOfFirstStage() const {
+  return projectedInputs_[0];
+}
+
+const CentroidalMpcSolver::Input& CentroidalMpcSolver::getInput(int stage) const {
+  return projectedInputs_[stage];
+}
+
+const CentroidalMpcSolver::State& CentroidalMpcSolver::getPredictedState(int stage) const {
+  return states_[stage];
+}
+
+double CentroidalMpcSolver::getResidual() const {
+  return residual_;
+}
+
+int CentroidalMpcSolver::getNumberOfIterations() const {
+  return numberOfIterations_;
+}
+
+Eigen::Vector3d CentroidalMpcSolver::projectOnFrictionPyramid(const Eigen::Vector3d& force, double frictionCoefficient,
+                                                              double minimalNormalForce, double maximalNormalForce) {
+  /* For a given normal force, the tangential forces are clamped independently. The remaining distance is a convex
+   * piecewise quadratic function of the normal force with the breakpoints |f_x|/mu and |f_y|/mu, the minimum
+   * lies on one of the three pieces and is clamped to the bounds of the normal force afterwards.
+   */
+  const double mu = frictionCoefficient;
+  const double smallerTangentialForce = std::min(std::fabs(force.x()), std::fabs(force.y()));
+  const double largerTangentialForce = std::max(std::fabs(force.x()), std::fabs(force.y()));
+  const double smallerBreakpoint = smallerTangentialForce/mu;
+  const double largerBreakpoint = largerTangentialForce/mu;
+
+  double candidates[3];
+  // both tangential forces are inside
+  candidates[0] = std::max(force.z(), largerBreakpoint);
+  // the larger tangential force is clamped
+  candidates[1] = std::min(std::max((force.z() + mu*largerTangentialForce)/(1.0 + mu*mu), smallerBreakpoint), largerBreakpoint);
+  // both tangential forces are clamped
+  candidates[2] = std::min((force.z() + mu*(smallerTangentialForce + largerTangentialForce))/(1.0 + 2.0*mu*mu), smallerBreakpoint);
+
+  double normalForce = candidates[0];
+  double minimalDistance = std::numeric_limits<double>::max();
+  for (int i=0; i<3; i++) {
+    const double distance = getSquaredDistanceToFrictionPyramid(candidates[i], force, mu);
+    if (distance < minimalDistance) {
+      minimalDistance = distance;
+      normalForce = candidates[i];
+    }
+  }
+  normalForce = std::min(std::max(normalForce, minimalNormalForce), maximalNormalForce);
+
+  const double maximalTangentialForce = mu*normalForce;
+  return Eigen::Vector3d(std::min(std::max(force.x(), -maximalTangentialForce), maximalTangentialForce),
+                         std::min(std::max(force.y(), -maximalTangentialForce), maximalTangentialForce),
+                         normalForce);
+}
+
+void CentroidalMpcSolver::updateModel() {
+  for (int k=0; k<numberOfStages_; k++) {
+    B_[k].setZero();
+    for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+      if (!isInContact_[k][iLeg]) {
+        // the force of a leg without contact is zero
+        projectedInputs_[k].segment<3>(3*iLeg).setZero();
+        duals_[k].segment<3>(3*iLeg).setZero();
+        continue;
+      }
+      const Eigen::Vector3d& r = positionsCoMToFoot_[k][iLeg];
+      Eigen::Matrix3d skewMatrix;
+      skewMatrix <<   0.0, -r.z(),  r.y(),
+                    r.z(),    0.0, -r.x(),
+                   -r.y(),  r.x(),    0.0;
+      B_[k].block<3,3>(6, 3*iLeg) = stageDuration_*inverseInertia_*skewMatrix;
+      B_[k].block<3,3>(9, 3*iLeg) = stageDuration_/mass_*Eigen::Matrix3d::Identity();
+    }
+  }
+}
+
+bool CentroidalMpcSolver::factorize() {
+  // the state matrix A only couples the positions with the velocities
+  StateMatrix A = StateMatrix::Identity();
+  A.block<6,6>(0, 6).diagonal().setConstant(stageDuration_);
+
+  valueHessians_[numberOfStages_] = stateWeights_.asDiagonal();
+  for (int k=numberOfStages_-1; k>=0; k--) {
+    const StateMatrix& P = valueHessians_[k+1];
+    const InputMatrix& B = B_[k];
+    const StateMatrix PA = P*A;
+
+    InputWeightMatrix Quu = B.transpose()*P*B;
+    Quu.diagonal().array() += forceWeight_ + penalty_;
+    hessians_[k].compute(Quu);
+    if (hessians_[k].info() != Eigen::Success) {
+      return false;
+    }
+    crossTerms_[k] = B.transpose()*PA;
+    feedbackGains_[k] = -hessians_[k].solve(crossTerms_[k]);
+
+    StateMatrix& Pk = valueHessians_[k];
+    Pk = A.transpose()*PA + crossTerms_[k].transpose()*feedbackGains_[k];
+    if (k > 0) {
+      Pk.diagonal() += stateWeights_;
+    }
+    Pk = 0.5*(Pk + Pk.transpose()).eval();
+  }
+  return true;
+}
+
+void CentroidalMpcSolver::solveAffineTerms() {
+  State c = State::Zero();
+  c.segment<3>(9) = stageDuration_*gravity_;
+
+  // linear term p of the value function V(x) = 1/2*x'*P*x + p'*x
+  State p = -stateWeights_.cwiseProduct(references_[numberOfStages_]);
+  for (int k=numberOfStages_-1; k>=0; k--) {
+    const State Pcp = valueHessians_[k+1]*c + p;
+    const Input qu = B_[k].transpose()*Pcp - penalty_*(projectedInputs_[k] - duals_[k]);
+    feedforwardInputs_[k] = -hessians_[k].solve(qu);
+
+    // A'*Pcp, A only couples the positions with the velocities
+    State qx = Pcp;
+    qx.tail<6>() += stageDuration_*Pcp.head<6>();
+    if (k > 0) {
+      qx -= stateWeights_.cwiseProduct(references_[k]);
+    }
+    p = qx + crossTerms_[k].transpose()*feedforwardInputs_[k];
+  }
+}
+
+void CentroidalMpcSolver::rollout(const State& initialState) {
+  const double dt = stageDuration_;
+  states_[0] = initialState;
+  for (int k=0; k<numberOfStages_; k++) {
+    const State& x = states_[k];
+    inputs_[k] = feedbackGains_[k]*x + feedforwardInputs_[k];
+    State& xNext = states_[k+1];
+    xNext = x;
+    xNext.head<6>() += dt*x.tail<6>();
+    xNext.tail<6>() += B_[k].bottomRows<6>()*inputs_[k];
+    xNext.segment<3>(9) += dt*gravity_;
+  }
+}
+
+double CentroidalMpcSolver::updateProjection() {
+  double residual = 0.0;
+  for (int k=0; k<numberOfStages_; k++) {
+    for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+      if (!isInContact_[k][iLeg]) {
+        continue;
+      }
+      const Eigen::Vector3d force = inputs_[k].segment<3>(3*iLeg);
+      const Eigen::Vector3d shiftedForce = force + duals_[k].segment<3>(3*iLeg);
+      const Eigen::Vector3d projectedForce = projectOnFrictionPyramid(shiftedForce, frictionCoefficient_, minimalNormalForce_, maximalNormalForce_);
+      // primal residual (distance to the constraints) and dual residual (change of the projected force)
+      residual = std::max(residual, (force - projectedForce).cwiseAbs().maxCoeff());
+      residual = std::max(residual, (projectedForce - projectedInputs_[k].segment<3>(3*iLeg)).cwiseAbs().maxCoeff());
+      projectedInputs_[k].segment<3>(3*iLeg) = projectedForce;
+      duals_[k].segment<3>(3*iLeg) = shiftedForce - projectedForce;
+    }
+  }
+  return residual;
+}
+
+} /* namespace loco */
@@ -0,0 +1,129 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     HierarchicalLeastSquaresSolver.cpp
+* @brief
+*/
+
+#include "loco/motion_control/HierarchicalLeastSquaresSolver.hpp"
+
+#include <cstdio>
+
+namespace loco {
+
+HierarchicalLeastSquaresSolver::HierarchicalLeastSquaresSolver() :
+    numberOfVariables_(0),
+    singularValueThreshold_(1.0e-6),
+    residualOfLastTask_(0.0),
+    svd_(maxNumberOfTaskRows, maxNumberOfVariables, Eigen::ComputeThinU | Eigen::ComputeFullV),
+    residualOfLastTaskAtCheckpoint_(0.0)
+{
+  reset(0);
+}
+
+
+HierarchicalLeastSquaresSolver::~HierarchicalLeastSquaresSolver() {
+
+}
+
+
+bool HierarchicalLeastSquaresSolver::reset(int numberOfVariables) {
+  if (numberOfVariables < 0 || numberOfVariables > maxNumberOfVariables) {
+    printf("[HierarchicalLeastSquaresSolver] %d variables are not supported, allowed are up to %d!\n", numberOfVariables, maxNumberOfVariables);
+    return false;
+  }
+  numberOfVariables_ = numberOfVariables;
+  solution_.setZero(numberOfVariables);
+  nullspaceBasis_.setIdentity(numberOfVariables, numberOfVariables);
+  residualOfLastTask_ = 0.0;
+  setCheckpoint();
+  return true;
+}
+
+void HierarchicalLeastSquaresSolver::setCheckpoint() {
+  solutionAtCheckpoint_ = solution_;
+  nullspaceBasisAtCheckpoint_ = nullspaceBasis_;
+  residualOfLastTaskAtCheckpoint_ = residualOfLastTask_;
+}
+
+void HierarchicalLeastSquaresSolver::restoreCheckpoint() {
+  solution_ = solutionAtCheckpoint_;
+  nullspaceBasis_ = nullspaceBasisAtCheckpoint_;
+  residualOfLastTask_ = residualOfLastTaskAtCheckpoint_;
+}
+
+void HierarchicalLeastSquaresSolver::setSingularValueThreshold(double threshold) {
+  singularValueThreshold_ = threshold;
+}
+
+bool HierarchicalLeastSquaresSolver::addTask(const TaskMatrix& A, const TaskVector& b) {
+  if (A.cols() != numberOfVariables_ || A.rows() != b.rows()) {
+    printf("[HierarchicalLeastSquaresSolver] The task has the wrong dimensions!\n");
+    return false;
+  }
+
+  const int numberOfFreeVariables = (int)nullspaceBasis_.cols();
+  if (numberOfFreeVariables > 0 && A.rows() > 0) {
+    const TaskMatrix projectedA = A*nullspaceBasis_;
+    const TaskVector error = b - A*solution_;
+    svd_.compute(projectedA, Eigen::ComputeThinU | Eigen::ComputeFullV);
+    svd_.setThreshold(singularValueThreshold_);
+
+    // the solution only changes within the nullspace of the tasks with higher priority
+    solution_ += nullspaceBasis_*svd_.solve(error);
+
+    // the directions that are not used by this task are left to the tasks with lower priority
+    const int rank = (int)svd_.rank();
+    const NullspaceBasis nullspaceBasis = nullspaceBasis_*svd_.matrixV().rightCols(numberOfFreeVariables - rank);
+    nullspaceBasis_ = nullspaceBasis;
+  }
+
+  residualOfLastTask_ = (A*solution_ - b).norm();
+  return true;
+}
+
+const HierarchicalLeastSquaresSolver::Solution& HierarchicalLeastSquaresSolver::getSolution() const {
+  return solution_;
+}
+
+int HierarchicalLeastSquaresSolver::getNumberOfFreeVariables() const {
+  return (int)nullspaceBasis_.cols();
+}
+
+double HierarchicalLeastSquaresSolver::getResidualOfLastTask() const {
+  return residualOfLastTask_;
+}
+
+} /* namespace loco */
@@ -69,4 +69,8 @@ bool MotionControllerBase::setToInterpolated(const MotionControllerBase& motionC
   return true;
 }
 
+bool MotionControllerBase::addParametersToVector(ParameterVector* parameterVector) {
+  return true;
+}
+
 } /* namespace loco */
@@ -49,6 +49,48 @@ using namespace Eigen;
 
 namespace loco {
 
+VirtualModelControllerParameters::VirtualModelControllerParameters() :
+    proportionalGainTranslation_(Eigen::Vector3d::Zero()),
+    derivativeGainTranslation_(Eigen::Vector3d::Zero()),
+    feedforwardGainTranslation_(Eigen::Vector3d::Zero()),
+    proportionalGainRotation_(Eigen::Vector3d::Zero()),
+    derivativeGainRotation_(Eigen::Vector3d::Zero()),
+    feedforwardGainRotation_(Eigen::Vector3d::Zero())
+{
+
+}
+
+namespace {
+
+ParameterSchema<VirtualModelControllerParameters> createVirtualModelControllerSchema() {
+  typedef VirtualModelControllerParameters P;
+  ParameterSchema<P> schema;
+  const char* translationalDirections[3] = {"Heading", "Lateral", "Vertical"};
+  const char* rotationalDirections[3] = {"Roll", "Pitch", "Yaw"};
+  for (int i=0; i<3; i++) {
+    const std::string translationPath = std::string("VirtualModelController/Gains/") + translationalDirections[i];
+    schema.add(translationPath, "kp", &P::proportionalGainTranslation_, i);
+    schema.add(translationPath, "kd", &P::derivativeGainTranslation_, i);
+    schema.add(translationPath, "kff", &P::feedforwardGainTranslation_, i);
+  }
+  for (int i=0; i<3; i++) {
+    const std::string rotationPath = std::string("VirtualModelController/Gains/") + rotationalDirections[i];
+    schema.add(rotationPath, "kp", &P::proportionalGainRotation_, i);
+    schema.add(rotationPath, "kd", &P::derivativeGainRotation_, i);
+    schema.add(rotationPath, "kff", &P::feedforwardGainRotation_, i);
+  }
+  return schema;
+}
+
+} /* namespace */
+
+const ParameterSchema<VirtualModelControllerParameters>& VirtualModelControllerParameters::getSchema() {
+  // Built once in a thread-safe static initialization since the parameters are also parsed on the loader thread.
+  static const ParameterSchema<VirtualModelControllerParameters> schema = createVirtualModelControllerSchema();
+  return schema;
+}
+
+
 VirtualModelController::VirtualModelController(std::shared_ptr<LegGroup> legs, std::shared_ptr<TorsoBase> torso,
                                                std::shared_ptr<ContactForceDistributionBase> contactForceDistribution)
     : MotionControllerBase(legs, torso),
@@ -179,24 +221,24 @@ bool VirtualModelController::computeVirtualForce()
   feedforwardTermInControlFrame.y() += torso_->getDesiredState().getLinearVelocityBaseInControlFrame().y();
 
   Position positionErrorInWorldFrame = orientationWorldToControl.inverseRotate(positionErrorInControlFrame_);
-  Force gravityCompensationFeedbackInWorldFrame = Force(proportionalGainTranslation_.cwiseProduct(Position(0.0,0.0,positionErrorInWorldFrame.z()).toImplementation()));
+  Force gravityCompensationFeedbackInWorldFrame = Force(parameters_.proportionalGainTranslation_.cwiseProduct(Position(0.0,0.0,positionErrorInWorldFrame.z()).toImplementation()));
 
   LinearVelocity velocityErrorInWorldFrame = orientationWorldToControl.inverseRotate(linearVelocityErrorInControlFrame_);
-  Force gravityDampingCompensationFeedbackInWorldFrame = Force(derivativeGainTranslation_.cwiseProduct(Position(0.0,0.0,velocityErrorInWorldFrame.z()).toImplementation()));
+  Force gravityDampingCompensationFeedbackInWorldFrame = Force(parameters_.derivativeGainTranslation_.cwiseProduct(Position(0.0,0.0,velocityErrorInWorldFrame.z()).toImplementation()));
 
   Force gravityCompensationFeedbackInBaseFrame = orientationWorldToBase.rotate(gravityCompensationFeedbackInWorldFrame);
   Force gravityDampingCompensationFeedbackInBaseFrame = orientationWorldToBase.rotate(gravityDampingCompensationFeedbackInWorldFrame);
 
-  virtualForceInBaseFrame_ = orientationControlToBase.rotate(Force(proportionalGainTranslation_.cwiseProduct(positionErrorInControlFrame_.toImplementation())))
-                       + orientationControlToBase.rotate(Force(derivativeGainTranslation_.cwiseProduct(linearVelocityErrorInControlFrame_.toImplementation())))
-                       + orientationControlToBase.rotate(Force(feedforwardGainTranslation_.cwiseProduct(feedforwardTermInControlFrame)))
+  virtualForceInBaseFrame_ = orientationControlToBase.rotate(Force(parameters_.proportionalGainTranslation_.cwiseProduct(positionErrorInControlFrame_.toImplementation())))
+                       + orientationControlToBase.rotate(Force(parameters_.derivativeGainTranslation_.cwiseProduct(linearVelocityErrorInControlFrame_.toImplementation())))
+                       + orientationControlToBase.rotate(Force(parameters_.feedforwardGainTranslation_.cwiseProduct(feedforwardTermInControlFrame)))
                        + gravityCompensationForceInBaseFrame_;
 //                       + gravityCompensationFeedbackInBaseFrame
 //                       + gravityDampingCompensationFeedbackInBaseFrame;
 
-//  std::cout << "proportional: " << orientationControlToBase.rotate(Force(proportionalGainTranslation_.cwiseProduct(positionErrorInControlFrame_.toImplementation()))) << std::endl;
-//  std::cout << "derivative: " << orientationControlToBase.rotate(Force(derivativeGainTranslation_.cwiseProduct(linearVelocityErrorInControlFrame_.toImplementation()))) << std::endl;
-//  std::cout << "ff: " << orientationControlToBase.rotate(Force(feedforwardGainTranslation_.cwiseProduct(feedforwardTermInControlFrame))) << std::endl;
+//  std::cout << "proportional: " << orientationControlToBase.rotate(Force(parameters_.proportionalGainTranslation_.cwiseProduct(positionErrorInControlFrame_.toImplementation()))) << std::endl;
+//  std::cout << "derivative: " << orientationControlToBase.rotate(Force(parameters_.derivativeGainTranslation_.cwiseProduct(linearVelocityErrorInControlFrame_.toImplementation()))) << std::endl;
+//  std::cout << "ff: " << orientationControlToBase.rotate(Force(parameters_.feedforwardGainTranslation_.cwiseProduct(feedforwardTermInControlFrame))) << std::endl;
 //  std::cout << "virtual force in base frame: " << virtualForceInBaseFrame_ << std::endl;
 
   return true;
@@ -210,17 +252,17 @@ bool VirtualModelController::computeVirtualTorque()
   Vector3d feedforwardTermInControlFrame = Vector3d::Zero();
   feedforwardTermInControlFrame.z() += torso_->getDesiredState().getAngularVelocityBaseInControlFrame().z();
 
-//  std::cout << "proportionalGainRotation: " << proportionalGainRotation_.transpose() << std::endl;
+//  std::cout << "proportionalGainRotation: " << parameters_.proportionalGainRotation_.transpose() << std::endl;
 
-  virtualTorqueInBaseFrame_ = Torque(proportionalGainRotation_.cwiseProduct(orientationError_))
-                       + orientationControlToBase.rotate(Torque(derivativeGainRotation_.cwiseProduct(angularVelocityErrorInControlFrame_.toImplementation())))
-                       + orientationControlToBase.rotate(Torque(feedforwardGainRotation_.cwiseProduct(feedforwardTermInControlFrame)))
+  virtualTorqueInBaseFrame_ = Torque(parameters_.proportionalGainRotation_.cwiseProduct(orientationError_))
+                       + orientationControlToBase.rotate(Torque(parameters_.derivativeGainRotation_.cwiseProduct(angularVelocityErrorInControlFrame_.toImplementation())))
+                       + orientationControlToBase.rotate(Torque(parameters_.feedforwardGainRotation_.cwiseProduct(feedforwardTermInControlFrame)))
                        + gravityCompensationTorqueInBaseFrame_;
 
 //  std::cout << "--------------------" << std::endl
-//      << "ornt err: " << Torque(proportionalGainRotation_.cwiseProduct(orientationError_)) << std::endl
-//      << "derivative err: " << orientationControlToBase.rotate(Torque(derivativeGainRotation_.cwiseProduct(angularVelocityErrorInControlFrame_.toImplementation()))) << std::endl
-//      << "ff: " << orientationControlToBase.rotate(Torque(feedforwardGainRotation_.cwiseProduct(feedforwardTermInControlFrame))) << std::endl
+//      << "ornt err: " << Torque(parameters_.proportionalGainRotation_.cwiseProduct(orientationError_)) << std::endl
+//      << "derivative err: " << orientationControlToBase.rotate(Torque(parameters_.derivativeGainRotation_.cwiseProduct(angularVelocityErrorInControlFrame_.toImplementation()))) << std::endl
+//      << "ff: " << orientationControlToBase.rotate(Torque(parameters_.feedforwardGainRotation_.cwiseProduct(feedforwardTermInControlFrame))) << std::endl
 //      << "grav comp: " << gravityCompensationTorqueInBaseFrame_ << std::endl;
 
   return true;
@@ -278,102 +320,13 @@ void VirtualModelController::getDistributedVirtualForceAndTorqueInBaseFrame(Forc
 bool VirtualModelController::loadParameters(const TiXmlHandle& handle)
 {
   isParametersLoaded_ = false;
-  TiXmlElement* element;
 
-  TiXmlHandle gainsHandle(handle.FirstChild("VirtualModelController").FirstChild("Gains"));
-  element = gainsHandle.Element();
-  if (!element) {
+  if (!handle.FirstChild("VirtualModelController").FirstChild("Gains").Element()) {
     printf("Could not find VirtualModelController:Gains\n");
     return false;
   }
 
-  // Heading
-  element = gainsHandle.FirstChild("Heading").Element();
-  if (element->QueryDoubleAttribute("kp", &proportionalGainTranslation_.x())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Heading:kp\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kd", &derivativeGainTranslation_.x())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Heading:kd\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kff", &feedforwardGainTranslation_.x())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Heading:kff\n");
-    return false;
-  }
-
-  // Lateral
-  element = gainsHandle.FirstChild("Lateral").Element();
-  if (element->QueryDoubleAttribute("kp", &proportionalGainTranslation_.y())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Lateral:kp\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kd", &derivativeGainTranslation_.y())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Lateral:kd\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kff", &feedforwardGainTranslation_.y())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Lateral:kff\n");
-    return false;
-  }
-
-  // Vertical
-  element = gainsHandle.FirstChild("Vertical").Element();
-  if (element->QueryDoubleAttribute("kp", &proportionalGainTranslation_.z())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Vertical:kp\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kd", &derivativeGainTranslation_.z())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Vertical:kd\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kff", &feedforwardGainTranslation_.z())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Vertical:kff\n");
-    return false;
-  }
-
-  // Roll
-  element = gainsHandle.FirstChild("Roll").Element();
-  if (element->QueryDoubleAttribute("kp", &proportionalGainRotation_.x())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Roll:kp\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kd", &derivativeGainRotation_.x())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Roll:kd\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kff", &feedforwardGainRotation_.x())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Roll:kff\n");
-    return false;
-  }
-
-  // Pitch
-  element = gainsHandle.FirstChild("Pitch").Element();
-  if (element->QueryDoubleAttribute("kp", &proportionalGainRotation_.y())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Pitch:kp\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kd", &derivativeGainRotation_.y())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Pitch:kd\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kff", &feedforwardGainRotation_.y())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Pitch:kff\n");
-    return false;
-  }
-
-  // Yaw
-  element = gainsHandle.FirstChild("Yaw").Element();
-  if (element->QueryDoubleAttribute("kp", &proportionalGainRotation_.z())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Yaw:kp\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kd", &derivativeGainRotation_.z())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Yaw:kd\n");
-    return false;
-  }
-  if (element->QueryDoubleAttribute("kff", &feedforwardGainRotation_.z())!=TIXML_SUCCESS) {
-    printf("Could not find VirtualModelController:Gains:Yaw:kff\n");
+  if (!VirtualModelControllerParameters::getSchema().parse(handle, parameters_)) {
     return false;
   }
 
@@ -381,107 +334,111 @@ bool VirtualModelController::loadParameters(const TiXmlHandle& handle)
   return true;
 }
 
+const VirtualModelControllerParameters& VirtualModelController::getParameters() const {
+  return parameters_;
+}
+
 const Eigen::Vector3d& VirtualModelController::getProportionalGainTranslation() const {
-  return proportionalGainTranslation_;
+  return parameters_.proportionalGainTranslation_;
 }
 const Eigen::Vector3d& VirtualModelController::getDerivativeGainTranslation() const {
-  return derivativeGainTranslation_;
+  return parameters_.derivativeGainTranslation_;
 }
 const Eigen::Vector3d& VirtualModelController::getFeedforwardGainTranslation() const {
-  return feedforwardGainTranslation_;
+  return parameters_.feedforwardGainTranslation_;
 }
 
 const Eigen::Vector3d& VirtualModelController::getProportionalGainRotation() const {
-  return proportionalGainRotation_;
+  return parameters_.proportionalGainRotation_;
 }
 const Eigen::Vector3d& VirtualModelController::getDerivativeGainRotation() const {
-  return derivativeGainRotation_;
+  return parameters_.derivativeGainRotation_;
 }
 const Eigen::Vector3d& VirtualModelController::getFeedforwardGainRotation() const {
-  return feedforwardGainRotation_;
+  return parameters_.feedforwardGainRotation_;
 }
 
 void VirtualModelController::setProportionalGainRotation(const Eigen::Vector3d& gains) {
-  proportionalGainRotation_ = gains;
+  parameters_.proportionalGainRotation_ = gains;
 }
 void VirtualModelController::setDerivativeGainRotation(const Eigen::Vector3d& gains) {
-  derivativeGainRotation_ = gains;
+  parameters_.derivativeGainRotation_ = gains;
 }
 void VirtualModelController::setFeedforwardGainRotation(const Eigen::Vector3d& gains) {
-  feedforwardGainRotation_ = gains;
+  parameters_.feedforwardGainRotation_ = gains;
 }
 
 void VirtualModelController::setProportionalGainTranslation(const Eigen::Vector3d& gains) {
-  proportionalGainTranslation_ = gains;
+  parameters_.proportionalGainTranslation_ = gains;
 }
 void VirtualModelController::setDerivativeGainTranslation(const Eigen::Vector3d& gains) {
-  derivativeGainTranslation_ = gains;
+  parameters_.derivativeGainTranslation_ = gains;
 }
 void VirtualModelController::setFeedforwardGainTranslation(const Eigen::Vector3d& gains) {
-  feedforwardGainTranslation_ = gains;
+  parameters_.feedforwardGainTranslation_ = gains;
 }
 
 void VirtualModelController::setGainsHeading(double kp, double kd, double kff) {
-  proportionalGainTranslation_.x() = kp;
-  derivativeGainTranslation_.x() = kp;
-  feedforwardGainTranslation_.x() = kp;
+  parameters_.proportionalGainTranslation_.x() = kp;
+  parameters_.derivativeGainTranslation_.x() = kp;
+  parameters_.feedforwardGainTranslation_.x() = kp;
 }
 void VirtualModelController::setGainsLateral(double kp, double kd, double kff) {
-  proportionalGainTranslation_.y() = kp;
-  derivativeGainTranslation_.y() = kp;
-  feedforwardGainTranslation_.y() = kp;
+  parameters_.proportionalGainTranslation_.y() = kp;
+  parameters_.derivativeGainTranslation_.y() = kp;
+  parameters_.feedforwardGainTranslation_.y() = kp;
 }
 void VirtualModelController::setGainsVertical(double kp, double kd, double kff) {
-  proportionalGainTranslation_.z() = kp;
-  derivativeGainTranslation_.z() = kp;
-  feedforwardGainTranslation_.z() = kp;
+  parameters_.proportionalGainTranslation_.z() = kp;
+  parameters_.derivativeGainTranslation_.z() = kp;
+  parameters_.feedforwardGainTranslation_.z() = kp;
 }
 void VirtualModelController::setGainsRoll(double kp, double kd, double kff) {
-  proportionalGainRotation_.x() = kp;
-  derivativeGainRotation_.x() = kp;
-  feedforwardGainRotation_.x() = kp;
+  parameters_.proportionalGainRotation_.x() = kp;
+  parameters_.derivativeGainRotation_.x() = kp;
+  parameters_.feedforwardGainRotation_.x() = kp;
 }
 
 void VirtualModelController::setGainsPitch(double kp, double kd, double kff) {
-  proportionalGainRotation_.y() = kp;
-  derivativeGainRotation_.y() = kp;
-  feedforwardGainRotation_.y() = kp;
+  parameters_.proportionalGainRotation_.y() = kp;
+  parameters_.derivativeGainRotation_.y() = kp;
+  parameters_.feedforwardGainRotation_.y() = kp;
 }
 void VirtualModelController::setGainsYaw(double kp, double kd, double kff) {
-  proportionalGainRotation_.z() = kp;
-  derivativeGainRotation_.z() = kp;
-  feedforwardGainRotation_.z() = kp;
+  parameters_.proportionalGainRotation_.z() = kp;
+  parameters_.derivativeGainRotation_.z() = kp;
+  parameters_.feedforwardGainRotation_.z() = kp;
 }
 
 void VirtualModelController::getGainsHeading(double& kp, double& kd, double& kff) {
-  kp = proportionalGainTranslation_.x();
-  kd = derivativeGainTranslation_.x();
-  kff = feedforwardGainTranslation_.x();
+  kp = parameters_.proportionalGainTranslation_.x();
+  kd = parameters_.derivativeGainTranslation_.x();
+  kff = parameters_.feedforwardGainTranslation_.x();
 }
 void VirtualModelController::getGainsLateral(double& kp, double& kd, double& kff) {
-  kp = proportionalGainTranslation_.y();
-  kd = derivativeGainTranslation_.y();
-  kff = feedforwardGainTranslation_.y();
+  kp = parameters_.proportionalGainTranslation_.y();
+  kd = parameters_.derivativeGainTranslation_.y();
+  kff = parameters_.feedforwardGainTranslation_.y();
 }
 void VirtualModelController::getGainsVertical(double& kp, double& kd, double& kff) {
-  kp = proportionalGainTranslation_.z();
-  kd = derivativeGainTranslation_.z();
-  kff = feedforwardGainTranslation_.z();
+  kp = parameters_.proportionalGainTranslation_.z();
+  kd = parameters_.derivativeGainTranslation_.z();
+  kff = parameters_.feedforwardGainTranslation_.z();
 }
 void VirtualModelController::getGainsRoll(double& kp, double& kd, double& kff) {
-  kp = proportionalGainRotation_.x();
-  kd = derivativeGainRotation_.x();
-  kff = feedforwardGainRotation_.x();
+  kp = parameters_.proportionalGainRotation_.x();
+  kd = parameters_.derivativeGainRotation_.x();
+  kff = parameters_.feedforwardGainRotation_.x();
 }
 void VirtualModelController::getGainsPitch(double& kp, double& kd, double& kff) {
-  kp = proportionalGainRotation_.y();
-  kd = derivativeGainRotation_.y();
-  kff = feedforwardGainRotation_.y();
+  kp = parameters_.proportionalGainRotation_.y();
+  kd = parameters_.derivativeGainRotation_.y();
+  kff = parameters_.feedforwardGainRotation_.y();
 }
 void VirtualModelController::getGainsYaw(double& kp, double& kd, double& kff) {
-  kp = proportionalGainRotation_.z();
-  kd = derivativeGainRotation_.z();
-  kff = feedforwardGainRotation_.z();
+  kp = parameters_.proportionalGainRotation_.z();
+  kd = parameters_.derivativeGainRotation_.z();
+  kff = parameters_.feedforwardGainRotation_.z();
 }
 
 void VirtualModelController::setGravityCompensationForcePercentage(double percentage) {
@@ -510,13 +467,13 @@ bool VirtualModelController::setToInterpolated(const MotionControllerBase& motio
     return false;
   }
 
-  this->proportionalGainTranslation_ = linearlyInterpolate(controller1.getProportionalGainTranslation(),  controller2.getProportionalGainTranslation(), 0.0, 1.0, t);
-  this->derivativeGainTranslation_ = linearlyInterpolate(controller1.getDerivativeGainTranslation(),  controller2.getDerivativeGainTranslation(), 0.0, 1.0, t);
-  this->feedforwardGainTranslation_ = linearlyInterpolate(controller1.getFeedforwardGainTranslation(),  controller2.getFeedforwardGainTranslation(), 0.0, 1.0, t);
+  this->parameters_.proportionalGainTranslation_ = linearlyInterpolate(controller1.getProportionalGainTranslation(),  controller2.getProportionalGainTranslation(), 0.0, 1.0, t);
+  this->parameters_.derivativeGainTranslation_ = linearlyInterpolate(controller1.getDerivativeGainTranslation(),  controller2.getDerivativeGainTranslation(), 0.0, 1.0, t);
+  this->parameters_.feedforwardGainTranslation_ = linearlyInterpolate(controller1.getFeedforwardGainTranslation(),  controller2.getFeedforwardGainTranslation(), 0.0, 1.0, t);
 
-  this->proportionalGainRotation_ = linearlyInterpolate(controller1.getProportionalGainRotation(),  controller2.getProportionalGainRotation(), 0.0, 1.0, t);
-  this->derivativeGainRotation_ = linearlyInterpolate(controller1.getDerivativeGainRotation(),  controller2.getDerivativeGainRotation(), 0.0, 1.0, t);
-  this->feedforwardGainRotation_ = linearlyInterpolate(controller1.getFeedforwardGainRotation(),  controller2.getFeedforwardGainRotation(), 0.0, 1.0, t);
+  this->parameters_.proportionalGainRotation_ = linearlyInterpolate(controller1.getProportionalGainRotation(),  controller2.getProportionalGainRotation(), 0.0, 1.0, t);
+  this->parameters_.derivativeGainRotation_ = linearlyInterpolate(controller1.getDerivativeGainRotation(),  controller2.getDerivativeGainRotation(), 0.0, 1.0, t);
+  this->parameters_.feedforwardGainRotation_ = linearlyInterpolate(controller1.getFeedforwardGainRotation(),  controller2.getFeedforwardGainRotation(), 0.0, 1.0, t);
 
 
   if (!contactForceDistribution_->setToInterpolated(controller1.getContactForceDistribution(), controller2.getContactForceDistribution(),t)) {
@@ -525,4 +482,17 @@ bool VirtualModelController::setToInterpolated(const MotionControllerBase& motio
   return true;
 }
 
+bool VirtualModelController::addParametersToVector(ParameterVector* parameterVector) {
+  Eigen::Vector3d* gains[6] = {&parameters_.proportionalGainTranslation_, &parameters_.derivativeGainTranslation_, &parameters_.feedforwardGainTranslation_,
+                               &parameters_.proportionalGainRotation_, &parameters_.derivativeGainRotation_, &parameters_.feedforwardGainRotation_};
+  std::vector<double*> parameters;
+  for (int i=0; i<6; i++) {
+    for (int k=0; k<3; k++) {
+      parameters.push_back(&(*gains[i])(k));
+    }
+  }
+  parameterVector->addSlice("VirtualModelController", parameters);
+  return true;
+}
+
 } /* namespace loco */
@@ -0,0 +1,518 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     WholeBodyController.cpp
+* @brief
+*/
+#include "loco/motion_control/WholeBodyController.hpp"
+#include "loco/common/LegLinkGroup.hpp"
+#include "robotUtils/loggers/logger.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace loco {
+
+namespace {
+
+/*! Adds a point mass to the mass matrix and the gravity terms.
+ * @param mass                    mass of the point
+ * @param jacobian                translation Jacobian of the point in base frame
+ * @param gravityInBaseFrame      gravitational acceleration in base frame
+ */
+void addPointMass(double mass, const WholeBodyController::PointJacobian& jacobian, const Eigen::Vector3d& gravityInBaseFrame,
+                  WholeBodyController::MassMatrix& massMatrix, WholeBodyController::GeneralizedForces& gravityTerms) {
+  massMatrix += mass*jacobian.transpose()*jacobian;
+  gravityTerms -= mass*jacobian.transpose()*gravityInBaseFrame;
+}
+
+/*! Computes the translation Jacobian of a point of the torso or of a leg w.r.t. the generalized coordinates.
+ * @param positionBaseToPointInBaseFrame    position of the point
+ * @param legJacobian                       Jacobian w.r.t. the joints of the leg (nullptr for a point of the torso)
+ * @param legId                             id of the leg
+ */
+WholeBodyController::PointJacobian getPointJacobian(const Eigen::Vector3d& positionBaseToPointInBaseFrame,
+                                                    const LegBase::TranslationJacobian* legJacobian, int legId) {
+  const Eigen::Vector3d& r = positionBaseToPointInBaseFrame;
+  WholeBodyController::PointJacobian jacobian = WholeBodyController::PointJacobian::Zero();
+  jacobian.block<3,3>(0, 0).setIdentity();
+  jacobian.block<3,3>(0, 3) <<    0.0,  r.z(), -r.y(),
+                               -r.z(),    0.0,  r.x(),
+                                r.y(), -r.x(),    0.0;
+  if (legJacobian != nullptr) {
+    jacobian.block<3,3>(0, 6+WholeBodyController::numberOfJointsPerLeg*legId) = *legJacobian;
+  }
+  return jacobian;
+}
+
+} // namespace
+
+WholeBodyControllerParameters::WholeBodyControllerParameters() :
+    proportionalGainTranslation_(Eigen::Vector3d::Zero()),
+    derivativeGainTranslation_(Eigen::Vector3d::Zero()),
+    proportionalGainRotation_(Eigen::Vector3d::Zero()),
+    derivativeGainRotation_(Eigen::Vector3d::Zero()),
+    inertiaOfTorso_(Eigen::Vector3d::Ones()),
+    proportionalGainSwingLeg_(0.0),
+    derivativeGainSwingLeg_(0.0),
+    tangentialForceWeight_(1.0),
+    normalForceWeight_(0.1),
+    jointAccelerationWeight_(0.01),
+    frictionCoefficient_(0.6),
+    minimalNormalForce_(0.0),
+    singularValueThreshold_(1.0e-6),
+    maximalNumberOfActiveSetIterations_(2.0)
+{
+
+}
+
+const ParameterSchema<WholeBodyControllerParameters>& WholeBodyControllerParameters::getSchema() {
+  static ParameterSchema<WholeBodyControllerParameters> schema;
+  if (schema.getEntries().empty()) {
+    typedef WholeBodyControllerParameters P;
+    const char* translationalDirections[3] = {"Heading", "Lateral", "Vertical"};
+    const char* rotationalDirections[3] = {"Roll", "Pitch", "Yaw"};
+    const char* inertiaAttributes[3] = {"xx", "yy", "zz"};
+    for (int i=0; i<3; i++) {
+      const std::string translationPath = std::string("WholeBodyController/Torso/Gains/") + translationalDirections[i];
+      schema.add(translationPath, "kp", &P::proportionalGainTranslation_, i);
+      schema.add(translationPath, "kd", &P::derivativeGainTranslation_, i);
+      const std::string rotationPath = std::string("WholeBodyController/Torso/Gains/") + rotationalDirections[i];
+      schema.add(rotationPath, "kp", &P::proportionalGainRotation_, i);
+      schema.add(rotationPath, "kd", &P::derivativeGainRotation_, i);
+      schema.add("WholeBodyController/Torso/Inertia", inertiaAttributes[i], &P::inertiaOfTorso_, i);
+    }
+    schema.add("WholeBodyController/SwingLeg/Gains", "kp", &P::proportionalGainSwingLeg_);
+    schema.add("WholeBodyController/SwingLeg/Gains", "kd", &P::derivativeGainSwingLeg_);
+    schema.add("WholeBodyController/Regularization", "tangentialForce", &P::tangentialForceWeight_);
+    schema.add("WholeBodyController/Regularization", "normalForce", &P::normalForceWeight_);
+    schema.add("WholeBodyController/Regularization", "jointAcceleration", &P::jointAccelerationWeight_);
+    schema.add("WholeBodyController/Friction", "coefficient", &P::frictionCoefficient_);
+    schema.add("WholeBodyController/Friction", "minimalNormalForce", &P::minimalNormalForce_);
+    schema.addOptional("WholeBodyController/Solver", "singularValueThreshold", &P::singularValueThreshold_, 1.0e-6);
+    schema.addOptional("WholeBodyController/Solver", "maximalNumberOfActiveSetIterations", &P::maximalNumberOfActiveSetIterations_, 2.0);
+  }
+  return schema;
+}
+
+
+WholeBodyController::WholeBodyController(std::shared_ptr<LegGroup> legs, std::shared_ptr<TorsoBase> torso)
+    : MotionControllerBase(legs, torso),
+      numberOfActiveSetPasses_(0)
+{
+  massMatrix_.setZero();
+  gravityTerms_.setZero();
+  orientationBaseToWorld_.setIdentity();
+  desiredAccelerationOfBase_.setZero();
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    contactJacobians_[iLeg].setZero();
+    isInContact_[iLeg] = false;
+    desiredAccelerationsOfFeet_[iLeg].setZero();
+    groundReactionForcesInWorldFrame_[iLeg].setZero();
+    for (int j=0; j<5; j++) {
+      isFrictionConstraintActive_[iLeg][j] = false;
+    }
+  }
+}
+
+WholeBodyController::~WholeBodyController()
+{
+
+}
+
+bool WholeBodyController::addToLogger()
+{
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    robotUtils::logger->addDoubleKindrForceToLog(groundReactionForcesInWorldFrame_[iLeg], std::string("grf_") + std::to_string(iLeg), "WBC", "N", false);
+  }
+  robotUtils::logger->updateLogger(true);
+  return true;
+}
+
+bool WholeBodyController::loadParameters(const TiXmlHandle& handle)
+{
+  isParametersLoaded_ = false;
+
+  if (!handle.FirstChild("WholeBodyController").Element()) {
+    printf("Could not find WholeBodyController\n");
+    return false;
+  }
+
+  if (!WholeBodyControllerParameters::getSchema().parse(handle, parameters_)) {
+    return false;
+  }
+  solver_.setSingularValueThreshold(parameters_.singularValueThreshold_);
+
+  isParametersLoaded_ = true;
+  return true;
+}
+
+bool WholeBodyController::compute()
+{
+  if (!isParametersLoaded()) return false;
+
+  if (!updateModel()) {
+    return false;
+  }
+  updateDesiredAccelerations();
+  if (!addDynamicsTask()) {
+    return false;
+  }
+  updateTasks();
+
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    for (int j=0; j<5; j++) {
+      isFrictionConstraintActive_[iLeg][j] = false;
+    }
+  }
+  const int maximalNumberOfActiveSetIterations = (int)std::floor(parameters_.maximalNumberOfActiveSetIterations_ + 0.5);
+  numberOfActiveSetPasses_ = 0;
+  for (int iteration=0; ; iteration++) {
+    if (!solveHierarchy()) {
+      return false;
+    }
+    numberOfActiveSetPasses_++;
+    if (iteration >= maximalNumberOfActiveSetIterations || !activateViolatedFrictionConstraints()) {
+      break;
+    }
+  }
+
+  setJointTorques();
+  return true;
+}
+
+bool WholeBodyController::updateModel()
+{
+  const RotationQuaternion& orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+  for (int i=0; i<3; i++) {
+    orientationBaseToWorld_.col(i) = orientationWorldToBase.inverseRotate(Vector(Eigen::Vector3d::Unit(i))).toImplementation();
+  }
+  const Eigen::Vector3d gravityInBaseFrame = orientationWorldToBase.rotate(torso_->getProperties().getGravity()).toImplementation();
+
+  massMatrix_.setZero();
+  gravityTerms_.setZero();
+
+  // torso
+  const PointJacobian jacobianOfTorso = getPointJacobian(torso_->getProperties().getBaseToCenterOfMassPositionInBaseFrame().toImplementation(), nullptr, 0);
+  addPointMass(torso_->getProperties().getMass(), jacobianOfTorso, gravityInBaseFrame, massMatrix_, gravityTerms_);
+  massMatrix_.block<3,3>(3, 3).diagonal() += parameters_.inertiaOfTorso_;
+
+  // links of the legs and contact points
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    isInContact_[iLeg] = false;
+    contactJacobians_[iLeg].setZero();
+  }
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    if (legId < 0 || legId >= numberOfLegs) {
+      printf("[WholeBodyController] Invalid id %d of a leg!\n", legId);
+      return false;
+    }
+    for (auto link : *leg->getLinks()) {
+      const PointJacobian jacobianOfLink = getPointJacobian(link->getBaseToCoMPositionInBaseFrame().toImplementation(),
+                                                            &link->getTranslationJacobianBaseToCoMInBaseFrame(), legId);
+      addPointMass(link->getMass(), jacobianOfLink, gravityInBaseFrame, massMatrix_, gravityTerms_);
+    }
+    contactJacobians_[legId] = getPointJacobian(leg->getPositionBaseToFootInBaseFrame().toImplementation(),
+                                                &leg->getTranslationJacobianFromBaseToFootInBaseFrame(), legId);
+    isInContact_[legId] = leg->isSupportLeg();
+  }
+  return true;
+}
+
+void WholeBodyController::updateDesiredAccelerations()
+{
+  const TorsoStateMeasured& measuredState = torso_->getMeasuredState();
+  const TorsoStateDesired& desiredState = torso_->getDesiredState();
+  const RotationQuaternion& orientationControlToBase = measuredState.getOrientationControlToBase();
+
+  /* torso, the errors are defined as in the virtual model controller */
+  const Position positionErrorInControlFrame = desiredState.getPositionControlToBaseInControlFrame() - measuredState.getPositionControlToBaseInControlFrame();
+  const LinearVelocity linearVelocityErrorInControlFrame = desiredState.getLinearVelocityBaseInControlFrame()
+      - orientationControlToBase.inverseRotate(measuredState.getLinearVelocityBaseInBaseFrame());
+  const LocalAngularVelocity angularVelocityErrorInControlFrame = desiredState.getAngularVelocityBaseInControlFrame()
+      - orientationControlToBase.inverseRotate(measuredState.getAngularVelocityBaseInBaseFrame());
+  const Eigen::Vector3d orientationError = desiredState.getOrientationControlToBase().boxMinus(measuredState.getOrientationControlToBase());
+
+  const Eigen::Vector3d linearAccelerationInControlFrame = parameters_.proportionalGainTranslation_.cwiseProduct(positionErrorInControlFrame.toImplementation())
+      + parameters_.derivativeGainTranslation_.cwiseProduct(linearVelocityErrorInControlFrame.toImplementation());
+  desiredAccelerationOfBase_.head<3>() = orientationControlToBase.rotate(Vector(linearAccelerationInControlFrame)).toImplementation();
+  desiredAccelerationOfBase_.tail<3>() = parameters_.proportionalGainRotation_.cwiseProduct(orientationError)
+      + orientationControlToBase.rotate(Vector(parameters_.derivativeGainRotation_.cwiseProduct(angularVelocityErrorInControlFrame.toImplementation()))).toImplementation();
+
+  /* swing feet, the desired joint positions and the feedforward of the swing trajectory are set by the foot placement strategy */
+  const RotationQuaternion& orientationWorldToBase = measuredState.getOrientationWorldToBase();
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    desiredAccelerationsOfFeet_[legId].setZero();
+    if (isInContact_[legId]) {
+      continue;
+    }
+    const LegBase::TranslationJacobian& jacobian = leg->getTranslationJacobianFromBaseToFootInBaseFrame();
+    const Eigen::Vector3d jointPositionErrors = (leg->getDesiredJointPositions() - leg->getMeasuredJointPositions()).matrix();
+    const Eigen::Vector3d velocityErrorInBaseFrame = orientationWorldToBase.rotate(leg->getDesiredLinearVelocityHipToFootInWorldFrame()).toImplementation()
+                                                     - jacobian*leg->getMeasuredJointVelocities().matrix();
+    desiredAccelerationsOfFeet_[legId] = orientationWorldToBase.rotate(leg->getDesiredLinearAccelerationHipToFootInWorldFrame()).toImplementation()
+        + parameters_.proportionalGainSwingLeg_*jacobian*jointPositionErrors
+        + parameters_.derivativeGainSwingLeg_*velocityErrorInBaseFrame;
+  }
+}
+
+bool WholeBodyController::addDynamicsTask()
+{
+  const int indexOfForces = numberOfGeneralizedCoordinates;
+
+  if (!solver_.reset(numberOfVariables)) {
+    return false;
+  }
+  HierarchicalLeastSquaresSolver::TaskMatrix A;
+  HierarchicalLeastSquaresSolver::TaskVector b;
+
+  /* 1. equations of motion of the floating base and contact constraints */
+  A.setZero(6 + 3*numberOfLegs, numberOfVariables);
+  b.setZero(A.rows());
+  A.block<6,numberOfGeneralizedCoordinates>(0, 0) = massMatrix_.topRows<6>();
+  b.head<6>() = -gravityTerms_.head<6>();
+  int row = 6;
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    const int indexOfForce = indexOfForces + 3*iLeg;
+    if (isInContact_[iLeg]) {
+      A.block<6,3>(0, indexOfForce) = -contactJacobians_[iLeg].leftCols<6>().transpose();
+      // the foot does not accelerate
+      A.block<3,numberOfGeneralizedCoordinates>(row, 0) = contactJacobians_[iLeg];
+    }
+    else {
+      // no force at the swing leg
+      A.block<3,3>(row, indexOfForce).setIdentity();
+    }
+    row += 3;
+  }
+  if (!solver_.addTask(A, b)) {
+    return false;
+  }
+
+  // the passes of the active set method continue from here
+  solver_.setCheckpoint();
+  return true;
+}
+
+void WholeBodyController::updateTasks()
+{
+  const int indexOfForces = numberOfGeneralizedCoordinates;
+
+  /* 3. desired accelerations of the torso and of the swing feet */
+  int numberOfSwingLegs = 0;
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    numberOfSwingLegs += isInContact_[iLeg] ? 0 : 1;
+  }
+  HierarchicalLeastSquaresSolver::TaskMatrix& A = accelerationTaskMatrix_;
+  HierarchicalLeastSquaresSolver::TaskVector& b = accelerationTaskVector_;
+  A.setZero(6 + 3*numberOfSwingLegs, numberOfVariables);
+  b.setZero(A.rows());
+  A.block<6,6>(0, 0).setIdentity();
+  b.head<6>() = desiredAccelerationOfBase_;
+  int row = 6;
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    if (!isInContact_[iLeg]) {
+      // acceleration of the foot relative to the base
+      const int indexOfJoints = 6 + numberOfJointsPerLeg*iLeg;
+      A.block<3,numberOfJointsPerLeg>(row, indexOfJoints) = contactJacobians_[iLeg].block<3,numberOfJointsPerLeg>(0, indexOfJoints);
+      b.segment<3>(row) = desiredAccelerationsOfFeet_[iLeg];
+      row += 3;
+    }
+  }
+
+  /* 4. regularization, the legs in contact share the weight and the tangential forces are small */
+  double totalMass = torso_->getProperties().getMass();
+  for (auto leg : *legs_) {
+    for (auto link : *leg->getLinks()) {
+      totalMass += link->getMass();
+    }
+  }
+  const int numberOfStanceLegs = numberOfLegs - numberOfSwingLegs;
+  const Eigen::Vector3d forceWeights(parameters_.tangentialForceWeight_, parameters_.tangentialForceWeight_, parameters_.normalForceWeight_);
+  HierarchicalLeastSquaresSolver::TaskMatrix& R = regularizationTaskMatrix_;
+  HierarchicalLeastSquaresSolver::TaskVector& r = regularizationTaskVector_;
+  R.setZero(3*numberOfStanceLegs + numberOfLegs*numberOfJointsPerLeg, numberOfVariables);
+  r.setZero(R.rows());
+  row = 0;
+  if (numberOfStanceLegs > 0) {
+    const Eigen::Vector3d referenceForceInWorldFrame = -totalMass/numberOfStanceLegs*torso_->getProperties().getGravity().toImplementation();
+    for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+      if (isInContact_[iLeg]) {
+        R.block<3,3>(row, indexOfForces + 3*iLeg) = forceWeights.asDiagonal()*orientationBaseToWorld_;
+        r.segment<3>(row) = forceWeights.cwiseProduct(referenceForceInWorldFrame);
+        row += 3;
+      }
+    }
+  }
+  R.block<numberOfLegs*numberOfJointsPerLeg,numberOfLegs*numberOfJointsPerLeg>(row, 6).diagonal().setConstant(parameters_.jointAccelerationWeight_);
+}
+
+bool WholeBodyController::solveHierarchy()
+{
+  const int indexOfForces = numberOfGeneralizedCoordinates;
+  const double mu = parameters_.frictionCoefficient_;
+  const Eigen::RowVector3d axisX = Eigen::RowVector3d::UnitX();
+  const Eigen::RowVector3d axisY = Eigen::RowVector3d::UnitY();
+  const Eigen::RowVector3d axisZ = Eigen::RowVector3d::UnitZ();
+
+  // the dynamics are only decomposed once per tick
+  solver_.restoreCheckpoint();
+
+  /* 2. friction constraints at their bound, expressed in world frame */
+  int numberOfActiveConstraints = 0;
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    for (int j=0; j<5; j++) {
+      numberOfActiveConstraints += isFrictionConstraintActive_[iLeg][j] ? 1 : 0;
+    }
+  }
+  if (numberOfActiveConstraints > 0) {
+    HierarchicalLeastSquaresSolver::TaskMatrix A;
+    HierarchicalLeastSquaresSolver::TaskVector b;
+    A.setZero(numberOfActiveConstraints, numberOfVariables);
+    b.setZero(A.rows());
+    const Eigen::RowVector3d constraintRows[5] = {axisX - mu*axisZ, -axisX - mu*axisZ, axisY - mu*axisZ, -axisY - mu*axisZ, axisZ};
+    int row = 0;
+    for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+      for (int j=0; j<5; j++) {
+        if (isFrictionConstraintActive_[iLeg][j]) {
+          A.block<1,3>(row, indexOfForces + 3*iLeg) = constraintRows[j]*orientationBaseToWorld_;
+          b(row) = (j == 4) ? parameters_.minimalNormalForce_ : 0.0;
+          row++;
+        }
+      }
+    }
+    if (!solver_.addTask(A, b)) {
+      return false;
+    }
+  }
+
+  if (!solver_.addTask(accelerationTaskMatrix_, accelerationTaskVector_)) {
+    return false;
+  }
+  return solver_.addTask(regularizationTaskMatrix_, regularizationTaskVector_);
+}
+
+bool WholeBodyController::activateViolatedFrictionConstraints()
+{
+  const double mu = parameters_.frictionCoefficient_;
+  const double tolerance = 1.0e-6;
+  const HierarchicalLeastSquaresSolver::Solution& solution = solver_.getSolution();
+
+  bool isConstraintActivated = false;
+  for (int iLeg=0; iLeg<numberOfLegs; iLeg++) {
+    if (!isInContact_[iLeg]) {
+      continue;
+    }
+    const Eigen::Vector3d forceInWorldFrame = orientationBaseToWorld_*solution.segment<3>(numberOfGeneralizedCoordinates + 3*iLeg);
+    bool* isActive = isFrictionConstraintActive_[iLeg];
+    const double maximalTangentialForce = mu*forceInWorldFrame.z() + tolerance;
+    if (!isActive[0] && !isActive[1] && forceInWorldFrame.x() > maximalTangentialForce) {
+      isActive[0] = isConstraintActivated = true;
+    }
+    if (!isActive[0] && !isActive[1] && -forceInWorldFrame.x() > maximalTangentialForce) {
+      isActive[1] = isConstraintActivated = true;
+    }
+    if (!isActive[2] && !isActive[3] && forceInWorldFrame.y() > maximalTangentialForce) {
+      isActive[2] = isConstraintActivated = true;
+    }
+    if (!isActive[2] && !isActive[3] && -forceInWorldFrame.y() > maximalTangentialForce) {
+      isActive[3] = isConstraintActivated = true;
+    }
+    if (!isActive[4] && forceInWorldFrame.z() < parameters_.minimalNormalForce_ - tolerance) {
+      isActive[4] = isConstraintActivated = true;
+    }
+  }
+  return isConstraintActivated;
+}
+
+void WholeBodyController::setJointTorques()
+{
+  const HierarchicalLeastSquaresSolver::Solution& solution = solver_.getSolution();
+  const GeneralizedForces generalizedAccelerations = solution.head<numberOfGeneralizedCoordinates>();
+
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    const int indexOfJoints = 6 + numberOfJointsPerLeg*legId;
+    const Eigen::Vector3d force = solution.segment<3>(numberOfGeneralizedCoordinates + 3*legId);
+    groundReactionForcesInWorldFrame_[legId] = Force(orientationBaseToWorld_*force);
+
+    // joint rows of the equations of motion M*ddq + h = S'*tau + J'*f
+    const Eigen::Vector3d jointTorques = massMatrix_.block<numberOfJointsPerLeg,numberOfGeneralizedCoordinates>(indexOfJoints, 0)*generalizedAccelerations
+        + gravityTerms_.segment<numberOfJointsPerLeg>(indexOfJoints)
+        - contactJacobians_[legId].block<3,numberOfJointsPerLeg>(0, indexOfJoints).transpose()*force;
+    leg->setDesiredJointTorques(LegBase::JointTorques(jointTorques.array()));
+  }
+}
+
+const Force& WholeBodyController::getGroundReactionForceInWorldFrame(int legId) const {
+  return groundReactionForcesInWorldFrame_[legId];
+}
+
+const Eigen::Matrix<double, 6, 1>& WholeBodyController::getDesiredAccelerationOfBase() const {
+  return desiredAccelerationOfBase_;
+}
+
+const WholeBodyController::MassMatrix& WholeBodyController::getMassMatrix() const {
+  return massMatrix_;
+}
+
+const WholeBodyController::GeneralizedForces& WholeBodyController::getGravityTerms() const {
+  return gravityTerms_;
+}
+
+const HierarchicalLeastSquaresSolver& WholeBodyController::getSolver() const {
+  return solver_;
+}
+
+int WholeBodyController::getNumberOfActiveSetPasses() const {
+  return numberOfActiveSetPasses_;
+}
+
+const WholeBodyControllerParameters& WholeBodyController::getParameters() const {
+  return parameters_;
+}
+
+bool WholeBodyController::isParametersLoaded() const
+{
+  if (isParametersLoaded_) return true;
+
+  printf("Whole-body controller parameters are not loaded.\n");
+  return false;
+}
+
+} /* namespace loco */
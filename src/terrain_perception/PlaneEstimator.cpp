@@ -0,0 +1,226 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * PlaneEstimator.cpp
+ */
+
+#include "loco/terrain_perception/PlaneEstimator.hpp"
+
+#include <Eigen/Cholesky>
+#include <algorithm>
+#include <cmath>
+
+namespace loco {
+
+PlaneEstimator::PlaneEstimator(int windowSize, double forgettingFactor) :
+    windowSize_(1),
+    forgettingFactor_(1.0),
+    slopePriorWeight_(0.0),
+    indexOfOldestPoint_(0),
+    numberOfPoints_(0),
+    numberOfRecursiveUpdates_(0),
+    informationMatrix_(Eigen::Matrix3d::Zero()),
+    informationVector_(Eigen::Vector3d::Zero()),
+    sumOfWeightedSquaredHeights_(0.0),
+    sumOfWeights_(0.0),
+    parameters_(Eigen::Vector3d::Zero()),
+    covariance_(Eigen::Matrix3d::Zero()),
+    residualVariance_(0.0)
+{
+  setParameters(windowSize, forgettingFactor);
+}
+
+
+PlaneEstimator::~PlaneEstimator() {
+
+}
+
+
+void PlaneEstimator::reset() {
+  indexOfOldestPoint_ = 0;
+  numberOfPoints_ = 0;
+  numberOfRecursiveUpdates_ = 0;
+  informationMatrix_.setZero();
+  informationVector_.setZero();
+  sumOfWeightedSquaredHeights_ = 0.0;
+  sumOfWeights_ = 0.0;
+  parameters_.setZero();
+  covariance_.setZero();
+  residualVariance_ = 0.0;
+}
+
+
+void PlaneEstimator::setParameters(int windowSize, double forgettingFactor) {
+  windowSize_ = std::max(windowSize, 3);
+  forgettingFactor_ = std::min(std::max(forgettingFactor, 1.0e-3), 1.0);
+  points_.resize(windowSize_);
+  reset();
+}
+
+
+void PlaneEstimator::setSlopePriorWeight(double weight) {
+  slopePriorWeight_ = std::max(weight, 0.0);
+}
+
+
+void PlaneEstimator::addPoint(const Position& positionInWorldFrame) {
+  // Drop the oldest point, its weight is lambda^(N-1)
+  if (numberOfPoints_ == windowSize_) {
+    const Eigen::Vector3d& oldestPoint = points_[indexOfOldestPoint_];
+    const Eigen::Vector3d oldestRegressor(-oldestPoint.x(), -oldestPoint.y(), 1.0);
+    const double oldestWeight = std::pow(forgettingFactor_, windowSize_ - 1);
+    informationMatrix_ -= oldestWeight*oldestRegressor*oldestRegressor.transpose();
+    informationVector_ -= oldestWeight*oldestRegressor*oldestPoint.z();
+    sumOfWeightedSquaredHeights_ -= oldestWeight*oldestPoint.z()*oldestPoint.z();
+    sumOfWeights_ -= oldestWeight;
+    points_[indexOfOldestPoint_] = positionInWorldFrame.toImplementation();
+    indexOfOldestPoint_ = (indexOfOldestPoint_ + 1) % windowSize_;
+  }
+  else {
+    points_[(indexOfOldestPoint_ + numberOfPoints_) % windowSize_] = positionInWorldFrame.toImplementation();
+    numberOfPoints_++;
+  }
+
+  // Age the points and add the new one
+  const double z = positionInWorldFrame.z();
+  const Eigen::Vector3d regressor(-positionInWorldFrame.x(), -positionInWorldFrame.y(), 1.0);
+  informationMatrix_ = forgettingFactor_*informationMatrix_ + regressor*regressor.transpose();
+  informationVector_ = forgettingFactor_*informationVector_ + regressor*z;
+  sumOfWeightedSquaredHeights_ = forgettingFactor_*sumOfWeightedSquaredHeights_ + z*z;
+  sumOfWeights_ = forgettingFactor_*sumOfWeights_ + 1.0;
+
+  // The subtractions accumulate round-off, recomputing once per window keeps the update O(1) on average
+  if (++numberOfRecursiveUpdates_ >= windowSize_) {
+    recomputeSums();
+  }
+}
+
+
+bool PlaneEstimator::estimate() {
+  if (numberOfPoints_ < ((slopePriorWeight_ > 0.0) ? 1 : 3)) {
+    return false;
+  }
+
+  Eigen::Matrix3d informationMatrix = informationMatrix_;
+  informationMatrix(0, 0) += slopePriorWeight_;
+  informationMatrix(1, 1) += slopePriorWeight_;
+  const Eigen::LDLT<Eigen::Matrix3d> ldlt(informationMatrix);
+  const Eigen::Vector3d diagonal = ldlt.vectorD();
+  if (!ldlt.isPositive() || diagonal.minCoeff() <= 1.0e-9*diagonal.maxCoeff()) {
+    // the points are collinear
+    return false;
+  }
+
+  parameters_ = ldlt.solve(informationVector_);
+
+  const double sumOfSquaredResiduals = sumOfWeightedSquaredHeights_ - 2.0*parameters_.dot(informationVector_)
+                                       + parameters_.dot(informationMatrix_*parameters_);
+  if (numberOfPoints_ > 3) {
+    const double degreesOfFreedom = sumOfWeights_*(numberOfPoints_ - 3)/numberOfPoints_;
+    residualVariance_ = std::max(sumOfSquaredResiduals, 0.0)/degreesOfFreedom;
+  }
+  else {
+    residualVariance_ = 0.0;
+  }
+  covariance_ = residualVariance_*ldlt.solve(Eigen::Matrix3d::Identity());
+
+  return true;
+}
+
+
+const Eigen::Vector3d& PlaneEstimator::getParameters() const {
+  return parameters_;
+}
+
+
+const Eigen::Matrix3d& PlaneEstimator::getCovariance() const {
+  return covariance_;
+}
+
+
+double PlaneEstimator::getResidualVariance() const {
+  return residualVariance_;
+}
+
+
+Vector PlaneEstimator::getNormalInWorldFrame() const {
+  return Vector(Eigen::Vector3d(parameters_(0), parameters_(1), 1.0).normalized());
+}
+
+
+Position PlaneEstimator::getPositionInWorldFrame() const {
+  return Position(0.0, 0.0, parameters_(2));
+}
+
+
+int PlaneEstimator::getNumberOfPoints() const {
+  return numberOfPoints_;
+}
+
+
+const Eigen::Vector3d& PlaneEstimator::getPoint(int index) const {
+  return points_[(indexOfOldestPoint_ + index) % windowSize_];
+}
+
+
+int PlaneEstimator::getWindowSize() const {
+  return windowSize_;
+}
+
+
+double PlaneEstimator::getForgettingFactor() const {
+  return forgettingFactor_;
+}
+
+
+void PlaneEstimator::recomputeSums() {
+  informationMatrix_.setZero();
+  informationVector_.setZero();
+  sumOfWeightedSquaredHeights_ = 0.0;
+  sumOfWeights_ = 0.0;
+
+  // from the oldest to the newest point
+  for (int k = 0; k < numberOfPoints_; k++) {
+    const Eigen::Vector3d& point = points_[(indexOfOldestPoint_ + k) % windowSize_];
+    const Eigen::Vector3d regressor(-point.x(), -point.y(), 1.0);
+    informationMatrix_ = forgettingFactor_*informationMatrix_ + regressor*regressor.transpose();
+    informationVector_ = forgettingFactor_*informationVector_ + regressor*point.z();
+    sumOfWeightedSquaredHeights_ = forgettingFactor_*sumOfWeightedSquaredHeights_ + point.z()*point.z();
+    sumOfWeights_ = forgettingFactor_*sumOfWeights_ + 1.0;
+  }
+  numberOfRecursiveUpdates_ = 0;
+}
+
+} /* namespace loco */
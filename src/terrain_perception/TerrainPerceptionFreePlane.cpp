@@ -59,6 +59,8 @@ namespace loco {
     lastWorldToBasePositionInWorldFrameForFoot_(legs_->size()),
     lastWorldToBaseOrientationForFoot_(legs_->size()),
     gotFirstTouchDownOfFoot_(legs_->size()),
+    isFootholdAddedOfFoot_(legs_->size()),
+    planeEstimator_(8, 1.0),
     planeParameters_(3),
     filterNormalTimeConstant_(0.05),
     filterPositionTimeConstant_(0.05),
@@ -70,18 +72,12 @@ namespace loco {
       lastWorldToBasePositionInWorldFrameForFoot_[leg->getId()].setZero();
       lastWorldToBaseOrientationForFoot_[leg->getId()].setIdentity();
       gotFirstTouchDownOfFoot_[leg->getId()] = false;
+      isFootholdAddedOfFoot_[leg->getId()] = false;
     }
 
     for (int k=0; k<planeParameters_.size(); k++) {
     	planeParameters_[k] = 0.0;
     }
-
-    filterNormalX_ = robotUtils::FirstOrderFilter();
-    filterNormalY_ = robotUtils::FirstOrderFilter();
-    filterNormalZ_ = robotUtils::FirstOrderFilter();
-    filterPositionX_ = robotUtils::FirstOrderFilter();
-    filterPositionY_ = robotUtils::FirstOrderFilter();
-    filterPositionZ_ = robotUtils::FirstOrderFilter();
   } // constructor
 
 
@@ -93,8 +89,10 @@ namespace loco {
   bool TerrainPerceptionFreePlane::initialize(double dt) {
     for (auto leg: *legs_) {
       gotFirstTouchDownOfFoot_[leg->getId()] = false;
+      isFootholdAddedOfFoot_[leg->getId()] = false;
       updateLocalMeasuresOfLeg(*leg);
     }
+    planeEstimator_.reset();
 
     //--- Initialize normal and position vectors
     normalInWorldFrameFilterOutput_ = loco::Vector::UnitZ();
@@ -107,13 +105,14 @@ namespace loco {
     filterNormalGain_ = 1.0;
     filterPositionGain_ = 1.0;
 
-    filterNormalX_.initialize(normalInWorldFrameFilterOutput_.x(), filterNormalTimeConstant_, filterNormalGain_);
-    filterNormalY_.initialize(normalInWorldFrameFilterOutput_.y(), filterNormalTimeConstant_, filterNormalGain_);
-    filterNormalZ_.initialize(normalInWorldFrameFilterOutput_.z(), filterNormalTimeConstant_, filterNormalGain_);
-
-    filterPositionX_.initialize(positionInWorldFrameFilterOutput_.x(), filterPositionTimeConstant_, filterPositionGain_);
-    filterPositionY_.initialize(positionInWorldFrameFilterOutput_.y(), filterPositionTimeConstant_, filterPositionGain_);
-    filterPositionZ_.initialize(positionInWorldFrameFilterOutput_.z(), filterPositionTimeConstant_, filterPositionGain_);
+    for (int k=0; k<3; k++) {
+      filterBank_.setFirstOrder(k, filterNormalTimeConstant_, filterNormalGain_);
+      filterBank_.setFirstOrder(k+3, filterPositionTimeConstant_, filterPositionGain_);
+    }
+    FilterBank<6>::Array filterOutput;
+    filterOutput << normalInWorldFrameFilterOutput_.x(), normalInWorldFrameFilterOutput_.y(), normalInWorldFrameFilterOutput_.z(),
+                    positionInWorldFrameFilterOutput_.x(), positionInWorldFrameFilterOutput_.y(), positionInWorldFrameFilterOutput_.z();
+    filterBank_.initialize(filterOutput);
 
     updateControlFrameOrigin();
     updateControlFrameAttitude();
@@ -214,10 +213,21 @@ namespace loco {
       //if ( leg->getStateTouchDown()->isNow() ) {
       if (leg->isAndShouldBeGrounded()) {
       //if (leg->isGrounded()) {
-        gotNewTouchDown = true;
         gotFirstTouchDownOfFoot_[legID] = true;
         updateLocalMeasuresOfLeg(*leg);
+
+        // Each stance phase contributes one foothold to the plane estimation
+        if (!isFootholdAddedOfFoot_[legID]) {
+          loco::Position footPositionInWorldFrame;
+          getMostRecentPositionOfFootInWorldFrame(footPositionInWorldFrame, legID);
+          planeEstimator_.addPoint(footPositionInWorldFrame);
+          isFootholdAddedOfFoot_[legID] = true;
+          gotNewTouchDown = true;
+        }
       } // if touchdown
+      else {
+        isFootholdAddedOfFoot_[legID] = false;
+      }
 
       allLegsGroundedAtLeastOnce *= gotFirstTouchDownOfFoot_[legID];
     } // for
@@ -235,13 +245,12 @@ namespace loco {
     }
 
     // 2. filter
-    normalInWorldFrameFilterOutput_.x() = filterNormalX_.advance(dt, normalInWorldFrameFilterInput_.x());
-    normalInWorldFrameFilterOutput_.y() = filterNormalY_.advance(dt, normalInWorldFrameFilterInput_.y());
-    normalInWorldFrameFilterOutput_.z() = filterNormalZ_.advance(dt, normalInWorldFrameFilterInput_.z());
-
-    positionInWorldFrameFilterOutput_.x() = filterPositionX_.advance(dt, positionInWorldFrameFilterInput_.x());
-    positionInWorldFrameFilterOutput_.y() = filterPositionY_.advance(dt, positionInWorldFrameFilterInput_.y());
-    positionInWorldFrameFilterOutput_.z() = filterPositionZ_.advance(dt, positionInWorldFrameFilterInput_.z());
+    FilterBank<6>::Array filterInput;
+    filterInput << normalInWorldFrameFilterInput_.x(), normalInWorldFrameFilterInput_.y(), normalInWorldFrameFilterInput_.z(),
+                   positionInWorldFrameFilterInput_.x(), positionInWorldFrameFilterInput_.y(), positionInWorldFrameFilterInput_.z();
+    const FilterBank<6>::Array& filterOutput = filterBank_.advance(dt, filterInput);
+    normalInWorldFrameFilterOutput_ = loco::Vector(filterOutput(0), filterOutput(1), filterOutput(2));
+    positionInWorldFrameFilterOutput_ = loco::Position(filterOutput(3), filterOutput(4), filterOutput(5));
 
     // 3.
     terrainModel_->setNormalandPositionInWorldFrame(normalInWorldFrameFilterOutput_, positionInWorldFrameFilterOutput_);
@@ -309,82 +318,48 @@ namespace loco {
 
 
   void TerrainPerceptionFreePlane::updatePlaneEstimation() {
-    /* estimate the plane which best fits the most recent contact points of each foot in world frame
-     * using least squares (pseudo inversion of the regressor matrix H)
+    /* estimate the plane which best fits the footholds in the window of the plane estimator
+     * using recursive least squares (3x3 normal equations)
      *
      * parameters       -> [a b d]^T
      * plane equation   -> z = d-ax-by
      * normal to plane  -> n = [a b 1]^T
      *
      * */
-    Eigen::MatrixXd linearRegressor(4,3);
-    Eigen::Vector4d measuredFootHeights;
-    Eigen::Vector3d parameters;
+    if (!planeEstimator_.estimate()) {
+      std::cout << "*******WARNING: rank-deficient regressor. Skipping terrain update.*******" << std::endl;
+      return;
+    }
 
-    linearRegressor.setZero();
-    measuredFootHeights.setZero();
-    parameters.setZero();
+    const Eigen::Vector3d& parameters = planeEstimator_.getParameters();
+    for (int k=0; k<planeParameters_.size(); k++) {
+      planeParameters_[k] = parameters(k);
+    }
 
-    if (estimatePlaneInFrame_ == EstimatePlaneInFrame::Base) {
-      std::vector<loco::Position> mostRecenPositionOfFootInWorldFrame(legs_->size());
+    /* Find a point on the plane. From z = d-ax-by, it is easy to find that p = [0 0 d]
+     * is on the plane
+     */
+    positionInWorldFrameFilterInput_ = planeEstimator_.getPositionInWorldFrame();
 
-      for (int k=0; k<legs_->size(); k++) {
-        mostRecenPositionOfFootInWorldFrame[k] = mostRecentPositionOfFoot_[k];
-        homogeneousTransformFromBaseToWorldFrame(mostRecenPositionOfFootInWorldFrame[k],k);
-      }
+    /* From the assumption that the normal has always unit z-component,
+     * its norm will always be greater than zero
+     */
+    normalInWorldFrameFilterInput_ = planeEstimator_.getNormalInWorldFrame();
 
-      linearRegressor << -mostRecenPositionOfFootInWorldFrame[0].x(), -mostRecenPositionOfFootInWorldFrame[0].y(), 1,
-                         -mostRecenPositionOfFootInWorldFrame[1].x(), -mostRecenPositionOfFootInWorldFrame[1].y(), 1,
-                         -mostRecenPositionOfFootInWorldFrame[2].x(), -mostRecenPositionOfFootInWorldFrame[2].y(), 1,
-                         -mostRecenPositionOfFootInWorldFrame[3].x(), -mostRecenPositionOfFootInWorldFrame[3].y(), 1;
-      measuredFootHeights << mostRecenPositionOfFootInWorldFrame[0].z(),
-                             mostRecenPositionOfFootInWorldFrame[1].z(),
-                             mostRecenPositionOfFootInWorldFrame[2].z(),
-                             mostRecenPositionOfFootInWorldFrame[3].z();
-    }
-    else {
-      linearRegressor << -mostRecentPositionOfFoot_[0].x(), -mostRecentPositionOfFoot_[0].y(), 1,
-                         -mostRecentPositionOfFoot_[1].x(), -mostRecentPositionOfFoot_[1].y(), 1,
-                         -mostRecentPositionOfFoot_[2].x(), -mostRecentPositionOfFoot_[2].y(), 1,
-                         -mostRecentPositionOfFoot_[3].x(), -mostRecentPositionOfFoot_[3].y(), 1;
-      measuredFootHeights << mostRecentPositionOfFoot_[0].z(),
-                             mostRecentPositionOfFoot_[1].z(),
-                             mostRecentPositionOfFoot_[2].z(),
-                             mostRecentPositionOfFoot_[3].z();
-    }
+  } // update plane estimation
 
-    /* Check if the measurements are linearly dependent */
-    Eigen::FullPivLU<Eigen::MatrixXd> piv_regressor(linearRegressor);
-    if (piv_regressor.rank() < parameters.size() ) {
-      std::cout << "*******WARNING: rank-deficient regressor. Skipping terrain update.*******" << std::endl;
-    }
-    else {
-       if (kindr::linear_algebra::pseudoInverse(linearRegressor,linearRegressor)) {
-         /* solve least squares problem */
-         parameters = linearRegressor*measuredFootHeights;
-
-         for (int k=0; k<planeParameters_.size(); k++) {
-        	 planeParameters_[k] = parameters[k];
-         }
-
-         /* Find a point on the plane. From z = d-ax-by, it is easy to find that p = [0 0 d]
-          * is on the plane
-          */
-         positionInWorldFrameFilterInput_ << 0.0, 0.0, parameters(2);
-
-         /* From the assumption that the normal has always unit z-component,
-          * its norm will always be greater than zero
-          */
-         normalInWorldFrameFilterInput_ << parameters(0), parameters(1), 1.0;
-         normalInWorldFrameFilterInput_ = normalInWorldFrameFilterInput_.normalize();
-
-       }
-       else {
-         std::cout << "*******WARNING: pseudoinversion returned error. Skipping terrain update.*******" << std::endl;
-       }
+
+  void TerrainPerceptionFreePlane::setPlaneEstimatorParameters(int windowSize, double forgettingFactor) {
+    planeEstimator_.setParameters(windowSize, forgettingFactor);
+    for (auto leg: *legs_) {
+      isFootholdAddedOfFoot_[leg->getId()] = false;
     }
+  } // set plane estimator parameters
 
-  } // update plane estimation
+
+  const PlaneEstimator& TerrainPerceptionFreePlane::getPlaneEstimator() const {
+    return planeEstimator_;
+  } // get plane estimator
 
 
   void TerrainPerceptionFreePlane::getMostRecentPositionOfFootInWorldFrame(loco::Position& footPositionInWorldFrame, int footID) {
@@ -0,0 +1,131 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainPerceptionHeightMap.cpp
+ */
+
+#include "loco/terrain_perception/TerrainPerceptionHeightMap.hpp"
+
+#include <cmath>
+
+namespace loco {
+
+TerrainPerceptionHeightMap::TerrainPerceptionHeightMap(TerrainModelHeightMap* terrainModel, LegGroup* legs, TorsoBase* torso) :
+    TerrainPerceptionBase(),
+    terrainModel_(terrainModel),
+    legs_(legs),
+    torso_(torso),
+    isFootholdAddedOfFoot_(legs->size(), false)
+{
+
+}
+
+
+TerrainPerceptionHeightMap::~TerrainPerceptionHeightMap() {
+
+}
+
+
+bool TerrainPerceptionHeightMap::initialize(double /*dt*/) {
+  for (auto leg : *legs_) {
+    isFootholdAddedOfFoot_[leg->getId()] = false;
+  }
+  terrainModel_->moveTo(torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame());
+
+  updateControlFrameOrigin();
+  updateControlFrameAttitude();
+  return true;
+}
+
+
+bool TerrainPerceptionHeightMap::advance(double /*dt*/) {
+  terrainModel_->moveTo(torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame());
+
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    if (leg->isAndShouldBeGrounded()) {
+      if (!isFootholdAddedOfFoot_[legId]) {
+        terrainModel_->addFootholdMeasurement(leg->getPositionWorldToFootInWorldFrame());
+        isFootholdAddedOfFoot_[legId] = true;
+      }
+    }
+    else {
+      isFootholdAddedOfFoot_[legId] = false;
+    }
+  }
+
+  updateControlFrameOrigin();
+  updateControlFrameAttitude();
+
+  return true;
+}
+
+
+void TerrainPerceptionHeightMap::updateControlFrameOrigin() {
+  //--- Position of the control frame is equal to the position of the world frame.
+  torso_->getMeasuredState().setPositionWorldToControlInWorldFrame(Position::Zero());
+  //---
+}
+
+
+void TerrainPerceptionHeightMap::updateControlFrameAttitude() {
+  //--- Control frame is aligned with the normal of the map below the base and the heading of the hips
+  loco::Vector normalInWorldFrame;
+  terrainModel_->getNormal(torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame(), normalInWorldFrame);
+
+  const Position positionForeHipsMidPointInWorldFrame = (legs_->getLeftForeLeg()->getPositionWorldToHipInWorldFrame() + legs_->getRightForeLeg()->getPositionWorldToHipInWorldFrame())*0.5;
+  const Position positionHindHipsMidPointInWorldFrame = (legs_->getLeftHindLeg()->getPositionWorldToHipInWorldFrame() + legs_->getRightHindLeg()->getPositionWorldToHipInWorldFrame())*0.5;
+  Vector currentHeadingDirectionInWorldFrame = Vector(positionForeHipsMidPointInWorldFrame-positionHindHipsMidPointInWorldFrame);
+  currentHeadingDirectionInWorldFrame.z() = 0.0;
+
+  RotationQuaternion orientationWorldToControlHeading;
+  Eigen::Vector3d axisX = Eigen::Vector3d::UnitX();
+  orientationWorldToControlHeading.setFromVectors(axisX, currentHeadingDirectionInWorldFrame.toImplementation());
+
+  loco::Vector normalInHeadingControlFrame = orientationWorldToControlHeading.rotate(normalInWorldFrame);
+  const double terrainPitch = atan2(normalInHeadingControlFrame.x(), normalInHeadingControlFrame.z());
+  const double terrainRoll = atan2(normalInHeadingControlFrame.y(), normalInHeadingControlFrame.z());
+
+  RotationQuaternion orientationWorldToControl = RotationQuaternion(AngleAxis(terrainRoll, -1.0, 0.0, 0.0))*RotationQuaternion(AngleAxis(terrainPitch, 0.0, 1.0, 0.0))*orientationWorldToControlHeading;
+  //---
+
+  torso_->getMeasuredState().setOrientationWorldToControl(orientationWorldToControl);
+  torso_->getMeasuredState().setPositionControlToBaseInControlFrame(orientationWorldToControl.rotate(torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame() - torso_->getMeasuredState().getPositionWorldToControlInWorldFrame()));
+
+  RotationQuaternion orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+  torso_->getMeasuredState().setOrientationControlToBase(orientationWorldToBase*orientationWorldToControl.inverted());
+}
+
+} /* namespace loco */
@@ -0,0 +1,293 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * TerrainPerceptionPiecewisePlane.cpp
+ */
+
+#include "loco/terrain_perception/TerrainPerceptionPiecewisePlane.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace loco {
+
+TerrainPerceptionPiecewisePlane::Region::Region(int windowSize, double slopePriorWeight) :
+    i_(0),
+    j_(0),
+    estimator_(windowSize, 1.0),
+    hasPlane_(false)
+{
+  estimator_.setSlopePriorWeight(slopePriorWeight);
+}
+
+
+TerrainPerceptionPiecewisePlane::TerrainPerceptionPiecewisePlane(TerrainModelPiecewisePlane* terrainModel, LegGroup* legs, TorsoBase* torso) :
+    TerrainPerceptionBase(),
+    terrainModel_(terrainModel),
+    legs_(legs),
+    torso_(torso),
+    isFootholdAddedOfFoot_(legs->size(), false),
+    maximumNumberOfFootholdsPerRegion_(12),
+    inlierThreshold_(0.03),
+    numberOfRansacIterations_(16),
+    maximumNumberOfRegions_(256),
+    minimalNormalZ_(0.5),
+    slopePriorWeight_(1.0e-3)
+{
+  setParameters(maximumNumberOfFootholdsPerRegion_, inlierThreshold_, numberOfRansacIterations_, maximumNumberOfRegions_);
+}
+
+
+TerrainPerceptionPiecewisePlane::~TerrainPerceptionPiecewisePlane() {
+
+}
+
+
+bool TerrainPerceptionPiecewisePlane::initialize(double /*dt*/) {
+  regionSlots_.clear();
+  terrainModel_->clearPlanes();
+  for (auto leg : *legs_) {
+    isFootholdAddedOfFoot_[leg->getId()] = false;
+  }
+  randomNumberGenerator_.seed();
+
+  updateControlFrameOrigin();
+  updateControlFrameAttitude();
+  return true;
+}
+
+
+bool TerrainPerceptionPiecewisePlane::advance(double /*dt*/) {
+  for (auto leg : *legs_) {
+    const int legId = leg->getId();
+    if (leg->isAndShouldBeGrounded()) {
+      if (!isFootholdAddedOfFoot_[legId]) {
+        addFoothold(leg->getPositionWorldToFootInWorldFrame());
+        isFootholdAddedOfFoot_[legId] = true;
+      }
+    }
+    else {
+      isFootholdAddedOfFoot_[legId] = false;
+    }
+  }
+
+  updateControlFrameOrigin();
+  updateControlFrameAttitude();
+
+  return true;
+}
+
+
+void TerrainPerceptionPiecewisePlane::updateControlFrameOrigin() {
+  //--- Position of the control frame is equal to the position of the world frame.
+  torso_->getMeasuredState().setPositionWorldToControlInWorldFrame(Position::Zero());
+  //---
+}
+
+
+void TerrainPerceptionPiecewisePlane::updateControlFrameAttitude() {
+  //--- Control frame is aligned with the local plane below the base and the heading of the hips
+  loco::Vector normalInWorldFrame;
+  terrainModel_->getNormal(torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame(), normalInWorldFrame);
+
+  const Position positionForeHipsMidPointInWorldFrame = (legs_->getLeftForeLeg()->getPositionWorldToHipInWorldFrame() + legs_->getRightForeLeg()->getPositionWorldToHipInWorldFrame())*0.5;
+  const Position positionHindHipsMidPointInWorldFrame = (legs_->getLeftHindLeg()->getPositionWorldToHipInWorldFrame() + legs_->getRightHindLeg()->getPositionWorldToHipInWorldFrame())*0.5;
+  Vector currentHeadingDirectionInWorldFrame = Vector(positionForeHipsMidPointInWorldFrame-positionHindHipsMidPointInWorldFrame);
+  currentHeadingDirectionInWorldFrame.z() = 0.0;
+
+  RotationQuaternion orientationWorldToControlHeading;
+  Eigen::Vector3d axisX = Eigen::Vector3d::UnitX();
+  orientationWorldToControlHeading.setFromVectors(axisX, currentHeadingDirectionInWorldFrame.toImplementation());
+
+  loco::Vector normalInHeadingControlFrame = orientationWorldToControlHeading.rotate(normalInWorldFrame);
+  const double terrainPitch = atan2(normalInHeadingControlFrame.x(), normalInHeadingControlFrame.z());
+  const double terrainRoll = atan2(normalInHeadingControlFrame.y(), normalInHeadingControlFrame.z());
+
+  RotationQuaternion orientationWorldToControl = RotationQuaternion(AngleAxis(terrainRoll, -1.0, 0.0, 0.0))*RotationQuaternion(AngleAxis(terrainPitch, 0.0, 1.0, 0.0))*orientationWorldToControlHeading;
+  //---
+
+  torso_->getMeasuredState().setOrientationWorldToControl(orientationWorldToControl);
+  torso_->getMeasuredState().setPositionControlToBaseInControlFrame(orientationWorldToControl.rotate(torso_->getMeasuredState().getPositionWorldToBaseInWorldFrame() - torso_->getMeasuredState().getPositionWorldToControlInWorldFrame()));
+
+  RotationQuaternion orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+  torso_->getMeasuredState().setOrientationControlToBase(orientationWorldToBase*orientationWorldToControl.inverted());
+}
+
+
+void TerrainPerceptionPiecewisePlane::addFoothold(const Position& positionWorldToFootholdInWorldFrame) {
+  const long i = terrainModel_->getRegionIndex(positionWorldToFootholdInWorldFrame.x());
+  const long j = terrainModel_->getRegionIndex(positionWorldToFootholdInWorldFrame.y());
+  const int64_t key = TerrainModelPiecewisePlane::getRegionKey(i, j);
+
+  int slot = regionSlots_.find(key);
+  if (slot < 0) {
+    if (regionSlots_.size() >= maximumNumberOfRegions_) {
+      removeFarthestRegion(positionWorldToFootholdInWorldFrame);
+    }
+    // The region reuses a preallocated slot of the pool
+    slot = regionSlots_.insert(key);
+    Region& newRegion = regions_[slot];
+    newRegion.i_ = i;
+    newRegion.j_ = j;
+    newRegion.estimator_.reset();
+    newRegion.hasPlane_ = false;
+  }
+  Region& region = regions_[slot];
+
+  // Inliers of the current plane are added recursively, otherwise the region is segmented again
+  const Eigen::Vector3d& plane = region.estimator_.getParameters();
+  const double residual = positionWorldToFootholdInWorldFrame.z()
+                          - (plane(2) - plane(0)*positionWorldToFootholdInWorldFrame.x() - plane(1)*positionWorldToFootholdInWorldFrame.y());
+  if (region.hasPlane_ && std::fabs(residual) <= inlierThreshold_) {
+    region.estimator_.addPoint(positionWorldToFootholdInWorldFrame);
+  }
+  else {
+    segmentRegion(region, positionWorldToFootholdInWorldFrame.toImplementation());
+  }
+
+  region.hasPlane_ = region.estimator_.estimate();
+  if (region.hasPlane_) {
+    terrainModel_->setPlane(i, j, region.estimator_.getParameters());
+  }
+
+  // Unknown terrain continues horizontally at the height of the latest foothold
+  terrainModel_->setDefaultPlane(Eigen::Vector3d(0.0, 0.0, positionWorldToFootholdInWorldFrame.z()));
+}
+
+
+void TerrainPerceptionPiecewisePlane::setParameters(int maximumNumberOfFootholdsPerRegion, double inlierThreshold, int numberOfRansacIterations, int maximumNumberOfRegions) {
+  maximumNumberOfFootholdsPerRegion_ = std::max(maximumNumberOfFootholdsPerRegion, 3);
+  inlierThreshold_ = inlierThreshold;
+  numberOfRansacIterations_ = std::max(numberOfRansacIterations, 0);
+  maximumNumberOfRegions_ = std::max(maximumNumberOfRegions, 1);
+
+  regionSlots_.setCapacity(maximumNumberOfRegions_);
+  regions_.assign(maximumNumberOfRegions_, Region(maximumNumberOfFootholdsPerRegion_, slopePriorWeight_));
+  footholds_.reserve(maximumNumberOfFootholdsPerRegion_ + 1);
+  isInlier_.reserve(maximumNumberOfFootholdsPerRegion_ + 1);
+  isBestInlier_.reserve(maximumNumberOfFootholdsPerRegion_ + 1);
+  terrainModel_->setMaximumNumberOfPlanes(maximumNumberOfRegions_);
+}
+
+
+int TerrainPerceptionPiecewisePlane::getNumberOfRegions() const {
+  return regionSlots_.size();
+}
+
+
+void TerrainPerceptionPiecewisePlane::segmentRegion(Region& region, const Eigen::Vector3d& foothold) {
+  // The footholds of the region from the oldest to the newest one
+  footholds_.clear();
+  for (int k = 0; k < region.estimator_.getNumberOfPoints(); k++) {
+    footholds_.push_back(region.estimator_.getPoint(k));
+  }
+  const int numberOfOldFootholds = footholds_.size();
+  footholds_.push_back(foothold);
+  isInlier_.resize(footholds_.size());
+  isBestInlier_.resize(footholds_.size());
+
+  auto countInliers = [this](const Eigen::Vector3d& plane, std::vector<bool>& isInlier) {
+    int numberOfInliers = 0;
+    for (size_t k = 0; k < footholds_.size(); k++) {
+      const double residual = footholds_[k].z() - (plane(2) - plane(0)*footholds_[k].x() - plane(1)*footholds_[k].y());
+      isInlier[k] = std::fabs(residual) <= inlierThreshold_;
+      numberOfInliers += isInlier[k];
+    }
+    return numberOfInliers;
+  };
+
+  // The first hypothesis is the horizontal plane through the new foothold, e.g. the tread of a stair
+  int bestNumberOfInliers = countInliers(Eigen::Vector3d(0.0, 0.0, foothold.z()), isBestInlier_);
+
+  if (numberOfOldFootholds >= 2) {
+    std::uniform_int_distribution<int> distribution(0, numberOfOldFootholds - 1);
+    for (int iteration = 0; iteration < numberOfRansacIterations_; iteration++) {
+      const int k1 = distribution(randomNumberGenerator_);
+      const int k2 = distribution(randomNumberGenerator_);
+      if (k1 == k2) {
+        continue;
+      }
+      Eigen::Vector3d normal = (footholds_[k1] - foothold).cross(footholds_[k2] - foothold);
+      if (normal.z() < 0.0) {
+        normal = -normal;
+      }
+      const double norm = normal.norm();
+      if (norm < 1.0e-9 || normal.z() < minimalNormalZ_*norm) {
+        // collinear or too steep
+        continue;
+      }
+      const double a = normal.x()/normal.z();
+      const double b = normal.y()/normal.z();
+      const Eigen::Vector3d plane(a, b, foothold.z() + a*foothold.x() + b*foothold.y());
+      const int numberOfInliers = countInliers(plane, isInlier_);
+      if (numberOfInliers > bestNumberOfInliers) {
+        bestNumberOfInliers = numberOfInliers;
+        isBestInlier_.swap(isInlier_);
+      }
+    }
+  }
+
+  // Keep only the inliers of the best plane
+  region.estimator_.reset();
+  for (size_t k = 0; k < footholds_.size(); k++) {
+    if (isBestInlier_[k]) {
+      region.estimator_.addPoint(Position(footholds_[k]));
+    }
+  }
+}
+
+
+void TerrainPerceptionPiecewisePlane::removeFarthestRegion(const Position& positionInWorldFrame) {
+  const double regionSize = terrainModel_->getRegionSize();
+  int farthestSlot = -1;
+  double farthestSquaredDistance = -1.0;
+  for (int slot = 0; slot < regionSlots_.getCapacity(); slot++) {
+    if (!regionSlots_.isUsed(slot)) {
+      continue;
+    }
+    const double dx = (regions_[slot].i_ + 0.5)*regionSize - positionInWorldFrame.x();
+    const double dy = (regions_[slot].j_ + 0.5)*regionSize - positionInWorldFrame.y();
+    if (dx*dx + dy*dy > farthestSquaredDistance) {
+      farthestSquaredDistance = dx*dx + dy*dy;
+      farthestSlot = slot;
+    }
+  }
+  if (farthestSlot >= 0) {
+    terrainModel_->removePlane(regions_[farthestSlot].i_, regions_[farthestSlot].j_);
+    regionSlots_.erase(regionSlots_.getKey(farthestSlot));
+  }
+}
+
+} /* namespace loco */
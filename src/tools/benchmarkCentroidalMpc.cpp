@@ -0,0 +1,145 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * benchmarkCentroidalMpc.cpp
+ */
+
+/*! Measures the solve time of CentroidalMpcSolver against the budget of a control tick.
+ *
+ * Usage: loco_benchmark_centroidal_mpc [number of ticks] [maximal number of iterations]
+ *
+ * The horizon has 15 stages of 30ms and the ADMM iterations are bounded by 20 by default, as for the
+ * centroidal model-predictive controller. The robot trots with alternating diagonal pairs while a lateral
+ * push is braked, the contact schedule is shifted by one tick of 2.5ms per solve and the solver is warm
+ * started as in the controller. The mean and maximal solve times are compared to the budget of 2.5ms,
+ * the exit code is 2 if a solve exceeded it.
+ */
+
+#include "loco/motion_control/CentroidalMpcSolver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+const double timeBudget = 2.5;  // [ms]
+
+} /* namespace */
+
+
+int main(int argc, char** argv) {
+  const int numberOfTicks = (argc > 1) ? std::atoi(argv[1]) : 2000;
+  const int maximalNumberOfIterations = (argc > 2) ? std::atoi(argv[2]) : 20;
+  if (numberOfTicks <= 0 || maximalNumberOfIterations <= 0) {
+    printf("Usage: %s [number of ticks] [maximal number of iterations]\n", argv[0]);
+    return 1;
+  }
+  const double dt = 0.0025;
+  const int numberOfStages = 15;
+  const double stageDuration = 0.03;
+  const double stridePeriod = 0.6;
+  const double mass = 40.0;
+  const double heightOfCoM = 0.45;
+
+  loco::CentroidalMpcSolver solver;
+  if (!solver.initialize(numberOfStages, stageDuration)) {
+    printf("Could not initialize the solver\n");
+    return 1;
+  }
+  solver.setMass(mass);
+  solver.setInertiaInWorldFrame(Eigen::Vector3d(0.8, 2.0, 2.2).asDiagonal());
+  solver.setGravity(Eigen::Vector3d(0.0, 0.0, -9.81));
+  loco::CentroidalMpcSolver::State weights;
+  weights << 50.0, 50.0, 10.0, 100.0, 100.0, 500.0, 1.0, 1.0, 1.0, 10.0, 10.0, 10.0;
+  solver.setStateWeights(weights);
+  solver.setForceWeight(1.0e-6);
+  solver.setFrictionCoefficient(0.6);
+  solver.setNormalForceLimits(5.0, 400.0);
+  solver.setAdmmParameters(1.0e-3, maximalNumberOfIterations, 1.0);
+
+  loco::CentroidalMpcSolver::State reference = loco::CentroidalMpcSolver::State::Zero();
+  reference(5) = heightOfCoM;
+  loco::CentroidalMpcSolver::State state = reference;
+  state(10) = 0.5;
+
+  double meanDuration = 0.0;
+  double maxDuration = 0.0;
+  double meanIterations = 0.0;
+  int numberOfTicksOverBudget = 0;
+  for (int tick=0; tick<numberOfTicks; tick++) {
+    // the diagonal pairs alternate every half stride, the lateral push is repeated every second
+    const double time = tick*dt;
+    if (tick % 400 == 0) {
+      state(10) = 0.5;
+    }
+    const Clock::time_point start = Clock::now();
+    for (int k=0; k<numberOfStages; k++) {
+      const bool isFirstPairInContact = (std::fmod(time + k*stageDuration, stridePeriod) < 0.5*stridePeriod);
+      for (int iLeg=0; iLeg<loco::CentroidalMpcSolver::numberOfLegs; iLeg++) {
+        const bool isFirstPair = (iLeg == 0 || iLeg == 3);
+        const Eigen::Vector3d positionCoMToFoot((iLeg < 2) ? 0.3 : -0.3, (iLeg % 2 == 0) ? 0.2 : -0.2, -heightOfCoM);
+        solver.setContact(k, iLeg, isFirstPair == isFirstPairInContact, positionCoMToFoot);
+      }
+      solver.setReference(k+1, reference);
+    }
+    if (!solver.solve(state)) {
+      printf("Could not solve the problem of tick %d\n", tick);
+      return 1;
+    }
+    const double duration = Milliseconds(Clock::now()-start).count();
+    meanDuration += duration;
+    maxDuration = std::max(maxDuration, duration);
+    meanIterations += solver.getNumberOfIterations();
+    if (duration > timeBudget) {
+      numberOfTicksOverBudget++;
+    }
+
+    // the predicted state of the next tick is the measurement of the next solve
+    const loco::CentroidalMpcSolver::State& nextState = solver.getPredictedState(1);
+    state += dt/stageDuration*(nextState - state);
+  }
+
+  printf("centroidal MPC, %d stages, at most %d ADMM iterations (%d ticks):\n", numberOfStages, maximalNumberOfIterations, numberOfTicks);
+  printf("  solve time:        %8.3f ms (max %.3f ms)\n", meanDuration/numberOfTicks, maxDuration);
+  printf("  iterations:        %8.2f\n", meanIterations/numberOfTicks);
+  printf("  over budget:       %d ticks of %.1f ms\n", numberOfTicksOverBudget, timeBudget);
+  return (numberOfTicksOverBudget == 0) ? 0 : 2;
+}
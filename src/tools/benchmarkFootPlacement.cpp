@@ -0,0 +1,274 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * benchmarkFootPlacement.cpp
+ */
+
+/*! Measures the per-tick cost of FootPlacementStrategyFreePlane::advance against the per-leg queries it replaced.
+ *
+ * Usage: loco_benchmark_foot_placement [number of ticks]
+ *
+ * All legs are in the middle of the swing phase, which is the most expensive case.
+ *
+ *  - "baseline": FootPlacementStrategyBaseline contains copies of the per-leg functions as they were before
+ *    the per-tick context was introduced. Every leg copies the orientations of the torso, queries the hip
+ *    projections, the terrain normal and the desired heading velocity itself. The context is never evaluated.
+ *  - "per-tick context": the current implementation, the shared quantities are evaluated once per tick in
+ *    updateContext().
+ * Everything else, e.g. the swing trajectories, is shared by both strategies.
+ */
+
+#include "loco/foot_placement_strategy/FootPlacementStrategyFreePlane.hpp"
+#include "loco/common/LegStarlETH.hpp"
+#include "loco/common/TorsoStarlETH.hpp"
+#include "loco/common/TerrainModelHorizontalPlane.hpp"
+#include "loco/state_switcher/StateSwitcher.hpp"
+
+#include "RobotModel.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+class FootPlacementStrategyBenchmark: public loco::FootPlacementStrategyFreePlane {
+ public:
+  FootPlacementStrategyBenchmark(loco::LegGroup* legs, loco::TorsoBase* torso, loco::TerrainModelBase* terrain):
+    loco::FootPlacementStrategyFreePlane(legs, torso, terrain)
+  {
+    swingFootHeightTrajectory_.addKnot(0.0, 0.0);
+    swingFootHeightTrajectory_.addKnot(0.65, 0.09);
+    swingFootHeightTrajectory_.addKnot(1.0, 0.0);
+  }
+};
+
+
+//! Foot placement with the per-leg queries of the code before the per-tick context
+class FootPlacementStrategyBaseline: public FootPlacementStrategyBenchmark {
+ public:
+  FootPlacementStrategyBaseline(loco::LegGroup* legs, loco::TorsoBase* torso, loco::TerrainModelBase* terrain):
+    FootPlacementStrategyBenchmark(legs, torso, terrain)
+  {
+
+  }
+
+ protected:
+  virtual void updateContext() {
+    // the baseline has no context, the per-leg functions query the torso and the terrain model
+  }
+
+  loco::Position getBaselinePositionWorldToHipOnTerrainAlongWorldZInWorldFrame(const loco::LegBase& leg) {
+    if (terrainQueryCache_ != nullptr && terrainQueryCache_->isValid()) {
+      return terrainQueryCache_->getPositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg.getId());
+    }
+    loco::Position positionWorldToHipOnTerrainAlongWorldZInWorldFrame = leg.getPositionWorldToHipInWorldFrame();
+    terrain_->getHeight(positionWorldToHipOnTerrainAlongWorldZInWorldFrame);
+    return positionWorldToHipOnTerrainAlongWorldZInWorldFrame;
+  }
+
+  loco::Position getBaselinePositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(const loco::LegBase& leg) {
+    if (terrainQueryCache_ != nullptr && terrainQueryCache_->isValid()) {
+      return terrainQueryCache_->getPositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(leg.getId());
+    }
+    return getPositionProjectedOnPlaneAlongSurfaceNormal(leg.getPositionWorldToHipInWorldFrame());
+  }
+
+  virtual loco::Position getPositionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame(const loco::LegBase& leg) {
+    loco::Position positionWorldToHipOnPlaneAlongWorldNormalInWorldFrame = getBaselinePositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg);
+    loco::Position positionWorldToHipOnPlaneAlongSurfaceNormalInWorldFrame = getBaselinePositionWorldToHipOnTerrainAlongSurfaceNormalInWorldFrame(leg);
+    return (positionWorldToHipOnPlaneAlongSurfaceNormalInWorldFrame - positionWorldToHipOnPlaneAlongWorldNormalInWorldFrame)*telescopicLeverConfiguration_;
+  }
+
+  virtual loco::Position getDesiredWorldToFootPositionInWorldFrame(loco::LegBase* leg) {
+    loco::RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+
+    loco::Position positionWorldToHipOnPlaneAlongNormalInWorldFrame = getBaselinePositionWorldToHipOnTerrainAlongWorldZInWorldFrame(*leg);
+    loco::Position positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame = getPositionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame(*leg);
+
+    loco::Position positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame = getPositionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame(*leg);
+    loco::Position positionDesiredFootOnTerrainToDesiredFootInControlFrame = getPositionDesiredFootOnTerrainToDesiredFootInControlFrame(*leg,
+                                                                                                                         positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame);
+
+    loco::Position positionWorldToDesiredFootInWorldFrame = positionWorldToHipOnPlaneAlongNormalInWorldFrame
+                                                            + positionVerticalHeightOnTerrainToLeverTelescopicConfigurationInWorldFrame
+                                                            + orientationWorldToControl.inverseRotate(positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame)
+                                                            + orientationWorldToControl.inverseRotate(positionDesiredFootOnTerrainToDesiredFootInControlFrame);
+
+    positionWorldToHipOnPlaneAlongNormalInWorldFrame_[leg->getId()] = positionWorldToHipOnPlaneAlongNormalInWorldFrame;
+    positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInWorldFrame_[leg->getId()] = orientationWorldToControl.inverseRotate(positionHipOnTerrainAlongNormalToDesiredFootOnTerrainInControlFrame);
+    positionDesiredFootOnTerrainToDesiredFootInWorldFrame_[leg->getId()] = orientationWorldToControl.inverseRotate(positionDesiredFootOnTerrainToDesiredFootInControlFrame);
+
+    return positionWorldToDesiredFootInWorldFrame;
+  }
+
+  virtual loco::Position getPositionDesiredFootOnTerrainToDesiredFootInControlFrame(const loco::LegBase& leg,
+                                                                                    const loco::Position& positionHipOnTerrainToDesiredFootOnTerrainInControlFrame) {
+    const bool isUsingPolynomial = (isUsingSwingFootTrajectoryPolynomial_ && !leg.isSupportLeg());
+    double desiredFootHeight = 0.0;
+    double time = 0.0;
+    double duration = 0.0;
+    if (isUsingPolynomial) {
+      getSwingTimes(leg, time, duration);
+      desiredFootHeight = swingFootTrajectories_[leg.getId()].getPosition(time).z();
+    }
+    else {
+      const double interpolationParameter = getInterpolationPhase(leg);
+      desiredFootHeight = swingFootHeightTrajectory_.evaluate(interpolationParameter, swingFootHeightTrajectoryCursors_[leg.getId()]);
+    }
+
+    loco::RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+    loco::Position positionHipOnTerrainToDesiredFootOnTerrainInWorldFrame = orientationWorldToControl.inverseRotate(positionHipOnTerrainToDesiredFootOnTerrainInControlFrame);
+
+    loco::Vector normalToPlaneAtCurrentFootPositionInWorldFrame;
+    terrain_->getNormal(positionHipOnTerrainToDesiredFootOnTerrainInWorldFrame,
+                        normalToPlaneAtCurrentFootPositionInWorldFrame);
+
+    loco::Vector normalToPlaneAtCurrentFootPositionInControlFrame = orientationWorldToControl.rotate(normalToPlaneAtCurrentFootPositionInWorldFrame);
+
+    loco::Position positionDesiredFootOnTerrainToDesiredFootInControlFrame = desiredFootHeight*loco::Position(normalToPlaneAtCurrentFootPositionInControlFrame);
+
+    if (isUsingPolynomial) {
+      const loco::SwingFootTrajectoryPolynomial& trajectory = swingFootTrajectories_[leg.getId()];
+      const loco::LinearVelocity linearVelocityInControlFrame = trajectory.getLinearVelocity(time);
+      const loco::LinearAcceleration linearAccelerationInControlFrame = trajectory.getLinearAcceleration(time);
+      linearVelocityHipToDesiredFootInWorldFrame_[leg.getId()] = orientationWorldToControl.inverseRotate(loco::LinearVelocity(linearVelocityInControlFrame.x(), linearVelocityInControlFrame.y(), 0.0))
+                                                                 + loco::LinearVelocity(normalToPlaneAtCurrentFootPositionInWorldFrame.toImplementation()*linearVelocityInControlFrame.z());
+      linearAccelerationHipToDesiredFootInWorldFrame_[leg.getId()] = orientationWorldToControl.inverseRotate(loco::LinearAcceleration(linearAccelerationInControlFrame.x(), linearAccelerationInControlFrame.y(), 0.0))
+                                                                     + loco::LinearAcceleration(normalToPlaneAtCurrentFootPositionInWorldFrame.toImplementation()*linearAccelerationInControlFrame.z());
+    }
+    else {
+      linearVelocityHipToDesiredFootInWorldFrame_[leg.getId()].setZero();
+      linearAccelerationHipToDesiredFootInWorldFrame_[leg.getId()].setZero();
+    }
+
+    return positionDesiredFootOnTerrainToDesiredFootInControlFrame;
+  }
+
+  virtual loco::Position getPositionDesiredFootHoldOnTerrainFeedBackInControlFrame(const loco::LegBase& leg) {
+    loco::RotationQuaternion orientationWorldToControl = torso_->getMeasuredState().getOrientationWorldToControl();
+    loco::RotationQuaternion orientationWorldToBase = torso_->getMeasuredState().getOrientationWorldToBase();
+
+    loco::Vector axisXOfControlFrame = loco::Vector::UnitX();
+    loco::LinearVelocity linearVeloctyDesiredInControlFrame = torso_->getDesiredState().getLinearVelocityBaseInControlFrame();
+    loco::LinearVelocity linearVeloctyDesiredHeadingInControlFrame = loco::LinearVelocity(linearVeloctyDesiredInControlFrame.toImplementation().cwiseProduct(axisXOfControlFrame.toImplementation()));
+    loco::LinearVelocity linearVeloctyDesiredInWorldFrame = orientationWorldToControl.inverseRotate(linearVeloctyDesiredHeadingInControlFrame);
+
+    loco::LinearVelocity linearVeloctyReferenceInWorldFrame = (leg.getLinearVelocityHipInWorldFrame()
+                                                              + orientationWorldToBase.inverseRotate(torso_->getMeasuredState().getLinearVelocityBaseInBaseFrame())
+                                                              )/2.0;
+
+    loco::LinearVelocity linearVelocityErrorInWorldFrame = linearVeloctyReferenceInWorldFrame
+                                                           - linearVeloctyDesiredInWorldFrame;
+
+    const double terrainHeightAtHipInWorldFrame = getBaselinePositionWorldToHipOnTerrainAlongWorldZInWorldFrame(leg).z();
+    const double heightInvertedPendulum = fabs(leg.getPositionWorldToHipInWorldFrame().z() - terrainHeightAtHipInWorldFrame);
+
+    const double gravitationalAccleration = torso_->getProperties().getGravity().norm();
+    loco::Position positionDesiredFootHoldOnTerrainFeedBackInWorldFrame = loco::Position(linearVelocityErrorInWorldFrame
+                                                                          *parameters_.stepFeedbackScale_
+                                                                          *std::sqrt(heightInvertedPendulum/gravitationalAccleration));
+
+    loco::Position positionDesiredFootHoldOnTerrainFeedBackInControlFrame = orientationWorldToControl.rotate(positionDesiredFootHoldOnTerrainFeedBackInWorldFrame);
+    positionDesiredFootHoldOnTerrainFeedBackInControlFrame.z() = 0.0;
+    return positionDesiredFootHoldOnTerrainFeedBackInControlFrame;
+  }
+};
+
+/* returns the mean duration of a tick in microseconds */
+double run(loco::FootPlacementStrategyFreePlane& strategy, int numberOfTicks, double dt) {
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point start = Clock::now();
+  for (int k=0; k<numberOfTicks; k++) {
+    strategy.advance(dt);
+  }
+  const std::chrono::duration<double, std::micro> duration = Clock::now()-start;
+  return duration.count()/numberOfTicks;
+}
+
+} /* namespace */
+
+
+int main(int argc, char** argv) {
+  const int numberOfTicks = (argc > 1) ? std::atoi(argv[1]) : 100000;
+  if (numberOfTicks <= 0) {
+    printf("Usage: %s [number of ticks]\n", argv[0]);
+    return 1;
+  }
+  const double dt = 0.0025;
+
+  robotModel::RobotModel robotModel;
+  loco::LegGroup legs;
+  loco::LegStarlETH leftForeLeg("leftFore", 0, &robotModel);
+  loco::LegStarlETH rightForeLeg("rightFore", 1, &robotModel);
+  loco::LegStarlETH leftHindLeg("leftHind", 2, &robotModel);
+  loco::LegStarlETH rightHindLeg("rightHind", 3, &robotModel);
+  legs.addLeg(&leftForeLeg);
+  legs.addLeg(&rightForeLeg);
+  legs.addLeg(&leftHindLeg);
+  legs.addLeg(&rightHindLeg);
+  loco::TorsoStarlETH torso(&robotModel);
+  loco::TerrainModelHorizontalPlane terrain;
+
+  robotModel.init();
+  robotModel.update();
+
+  for (auto leg : legs) {
+    leg->setIsSupportLeg(false);
+    leg->setIsGrounded(false);
+    leg->setShouldBeGrounded(false);
+    leg->setSwingDuration(0.4);
+    leg->setSwingPhase(0.5);
+    leg->getStateSwitcher()->setState(loco::StateSwitcher::States::SwingNormal);
+  }
+
+  FootPlacementStrategyBaseline baseline(&legs, &torso, &terrain);
+  baseline.initialize(dt);
+  FootPlacementStrategyBenchmark strategy(&legs, &torso, &terrain);
+  strategy.initialize(dt);
+
+  // warm up
+  run(baseline, numberOfTicks/10+1, dt);
+  run(strategy, numberOfTicks/10+1, dt);
+
+  const double durationBaseline = run(baseline, numberOfTicks, dt);
+  const double durationWithContext = run(strategy, numberOfTicks, dt);
+
+  printf("foot placement per tick (%d ticks):\n", numberOfTicks);
+  printf("  baseline (per-leg queries): %8.3f us\n", durationBaseline);
+  printf("  per-tick context:           %8.3f us\n", durationWithContext);
+  return 0;
+}
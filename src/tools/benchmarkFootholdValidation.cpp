@@ -0,0 +1,164 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * benchmarkFootholdValidation.cpp
+ */
+
+/*! Measures the foothold planning and validation of FootPlacementStrategyStaticGait on rough terrain.
+ *
+ * Usage: loco_benchmark_foothold_validation [number of steps]
+ *
+ * Each step plans the foothold of the left fore leg and validates it against a height map with
+ * FootholdValidatorTerrainModel, either on the control thread or on the worker thread of the validator.
+ * For the worker thread, the round-trip latency and the cost of a control tick while the response is
+ * pending are reported.
+ */
+
+#include "loco/foot_placement_strategy/FootPlacementStrategyStaticGait.hpp"
+#include "loco/com_over_support_polygon/CoMOverSupportPolygonControlStaticGait.hpp"
+#include "loco/common/LegStarlETH.hpp"
+#include "loco/common/TorsoStarlETH.hpp"
+#include "loco/common/TerrainModelHeightMap.hpp"
+
+#include "RobotModel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::micro> Microseconds;
+
+class FootPlacementStrategyBenchmark: public loco::FootPlacementStrategyStaticGait {
+ public:
+  FootPlacementStrategyBenchmark(loco::LegGroup* legs, loco::TorsoBase* torso, loco::TerrainModelBase* terrain):
+    loco::FootPlacementStrategyStaticGait(legs, torso, terrain)
+  {
+
+  }
+  using loco::FootPlacementStrategyStaticGait::planFootHold;
+  using loco::FootPlacementStrategyStaticGait::updateFootHoldValidation;
+
+  bool isValidating() const {
+    return mustValidateNextFootHold_;
+  }
+};
+
+} /* namespace */
+
+
+int main(int argc, char** argv) {
+  const int numberOfSteps = (argc > 1) ? std::atoi(argv[1]) : 1000;
+  if (numberOfSteps <= 0) {
+    printf("Usage: %s [number of steps]\n", argv[0]);
+    return 1;
+  }
+  const double dt = 0.0025;
+
+  robotModel::RobotModel robotModel;
+  loco::LegGroup legs;
+  loco::LegStarlETH leftForeLeg("leftFore", 0, &robotModel);
+  loco::LegStarlETH rightForeLeg("rightFore", 1, &robotModel);
+  loco::LegStarlETH leftHindLeg("leftHind", 2, &robotModel);
+  loco::LegStarlETH rightHindLeg("rightHind", 3, &robotModel);
+  legs.addLeg(&leftForeLeg);
+  legs.addLeg(&rightForeLeg);
+  legs.addLeg(&leftHindLeg);
+  legs.addLeg(&rightHindLeg);
+  loco::TorsoStarlETH torso(&robotModel);
+
+  robotModel.init();
+  robotModel.update();
+
+  // rough terrain of +-3cm around the robot
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  terrain.initialize(dt);
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> roughness(-0.03, 0.03);
+  for (double x = -0.6; x < 0.6; x += 0.01) {
+    for (double y = -0.6; y < 0.6; y += 0.01) {
+      terrain.setHeight(loco::Position(x, y, 0.0), roughness(generator));
+    }
+  }
+
+  loco::CoMOverSupportPolygonControlStaticGait comControl(&legs, &torso);
+  FootPlacementStrategyBenchmark strategy(&legs, &torso, &terrain);
+  strategy.setCoMControl(&comControl);
+  strategy.initialize(dt);
+  strategy.setUseFootholdValidation(true);
+  leftHindLeg.setSwingPhase(0.1);
+
+  // validation on the control thread
+  const Clock::time_point start = Clock::now();
+  for (int k=0; k<numberOfSteps; k++) {
+    strategy.planFootHold(&leftForeLeg);
+    strategy.updateFootHoldValidation(leftHindLeg);
+  }
+  const double durationControlThread = Microseconds(Clock::now()-start).count()/numberOfSteps;
+
+  // validation on the worker thread, the control thread only polls
+  if (!strategy.getFootholdValidator()->start()) {
+    printf("Could not start the validator\n");
+    return 1;
+  }
+  double latency = 0.0;
+  double meanTick = 0.0;
+  double maxTick = 0.0;
+  int numberOfTicks = 0;
+  for (int k=0; k<numberOfSteps; k++) {
+    const Clock::time_point sent = Clock::now();
+    strategy.planFootHold(&leftForeLeg);
+    while (strategy.isValidating()) {
+      const Clock::time_point tick = Clock::now();
+      strategy.updateFootHoldValidation(leftHindLeg);
+      const double durationTick = Microseconds(Clock::now()-tick).count();
+      meanTick += durationTick;
+      maxTick = std::max(maxTick, durationTick);
+      numberOfTicks++;
+    }
+    latency += Microseconds(Clock::now()-sent).count();
+  }
+  strategy.getFootholdValidator()->stop();
+
+  printf("foothold planning and validation (%d steps):\n", numberOfSteps);
+  printf("  control thread per step:     %8.3f us\n", durationControlThread);
+  printf("  worker thread round trip:    %8.3f us\n", latency/numberOfSteps);
+  printf("  control tick while pending:  %8.3f us (max %.3f us)\n", meanTick/numberOfTicks, maxTick);
+  return 0;
+}
@@ -0,0 +1,174 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+/*
+ * benchmarkWholeBodyController.cpp
+ */
+
+/*! Measures the compute time of WholeBodyController against its budget within a control tick.
+ *
+ * Usage: loco_benchmark_whole_body_controller [number of ticks]
+ *
+ * The robot trots with alternating diagonal pairs every 0.3s, the swing legs track an offset of their joint
+ * positions. Every second the desired lateral velocity jumps to 1.5m/s for 0.1s, the desired acceleration of
+ * the torso then violates the friction pyramids and the active set method needs additional passes. The whole-body
+ * controller shares the tick of 2.5ms with the estimation, the terrain perception and the other modules, its
+ * budget is 1ms. The mean and maximal compute times are reported, the exit code is 2 if a tick exceeded the budget.
+ */
+
+#include "loco/motion_control/WholeBodyController.hpp"
+#include "loco/common/LegGroup.hpp"
+#include "loco/common/LegStarlETH.hpp"
+#include "loco/common/TorsoStarlETH.hpp"
+
+#include "RobotModel.hpp"
+#include "tinyxml.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+const double timeBudget = 1.0;  // [ms]
+
+const char* wholeBodyControllerParameters =
+  "<LocomotionController>"
+  "  <WholeBodyController>"
+  "    <Torso>"
+  "      <Gains>"
+  "        <Heading kp=\"100.0\" kd=\"20.0\"/>"
+  "        <Lateral kp=\"100.0\" kd=\"20.0\"/>"
+  "        <Vertical kp=\"400.0\" kd=\"40.0\"/>"
+  "        <Roll kp=\"200.0\" kd=\"20.0\"/>"
+  "        <Pitch kp=\"200.0\" kd=\"20.0\"/>"
+  "        <Yaw kp=\"100.0\" kd=\"10.0\"/>"
+  "      </Gains>"
+  "      <Inertia xx=\"0.8\" yy=\"2.0\" zz=\"2.2\"/>"
+  "    </Torso>"
+  "    <SwingLeg>"
+  "      <Gains kp=\"400.0\" kd=\"40.0\"/>"
+  "    </SwingLeg>"
+  "    <Regularization tangentialForce=\"1.0\" normalForce=\"0.1\" jointAcceleration=\"0.01\"/>"
+  "    <Friction coefficient=\"0.6\" minimalNormalForce=\"5.0\"/>"
+  "  </WholeBodyController>"
+  "</LocomotionController>";
+
+} /* namespace */
+
+
+int main(int argc, char** argv) {
+  const int numberOfTicks = (argc > 1) ? std::atoi(argv[1]) : 4000;
+  if (numberOfTicks <= 0) {
+    printf("Usage: %s [number of ticks]\n", argv[0]);
+    return 1;
+  }
+  const double dt = 0.0025;
+  const int ticksPerPhase = 120;
+
+  robotModel::RobotModel robotModel;
+  loco::LegStarlETH leftForeLeg("leftFore", 0, &robotModel);
+  loco::LegStarlETH rightForeLeg("rightFore", 1, &robotModel);
+  loco::LegStarlETH leftHindLeg("leftHind", 2, &robotModel);
+  loco::LegStarlETH rightHindLeg("rightHind", 3, &robotModel);
+  std::shared_ptr<loco::LegGroup> legs(new loco::LegGroup(&leftForeLeg, &rightForeLeg, &leftHindLeg, &rightHindLeg));
+  std::shared_ptr<loco::TorsoStarlETH> torso(new loco::TorsoStarlETH(&robotModel));
+
+  robotModel.init();
+  robotModel.update();
+  torso->initialize(dt);
+  for (auto leg : *legs) {
+    leg->initialize(dt);
+    leg->advance(dt);
+  }
+  torso->advance(dt);
+
+  TiXmlDocument document;
+  document.Parse(wholeBodyControllerParameters);
+  if (document.Error()) {
+    printf("Could not parse the parameters\n");
+    return 1;
+  }
+  loco::WholeBodyController wholeBodyController(legs, torso);
+  if (!wholeBodyController.loadParameters(TiXmlHandle(document.FirstChild("LocomotionController")))) {
+    printf("Could not load the parameters\n");
+    return 1;
+  }
+
+  double meanDuration = 0.0;
+  double maxDuration = 0.0;
+  double meanPasses = 0.0;
+  int numberOfTicksOverBudget = 0;
+  for (int tick=0; tick<numberOfTicks; tick++) {
+    // the diagonal pairs alternate, the swing legs track an offset of their joint positions
+    const bool isFirstPairInContact = ((tick/ticksPerPhase) % 2 == 0);
+    for (auto leg : *legs) {
+      const bool isFirstPair = (leg->getId() == 0 || leg->getId() == 3);
+      const bool isSupportLeg = (isFirstPair == isFirstPairInContact);
+      leg->setIsSupportLeg(isSupportLeg);
+      leg->setIsGrounded(isSupportLeg);
+      loco::LegBase::JointPositions desiredJointPositions = leg->getMeasuredJointPositions();
+      if (!isSupportLeg) {
+        desiredJointPositions(1) += 0.1;
+        desiredJointPositions(2) -= 0.2;
+      }
+      leg->setDesiredJointPositions(desiredJointPositions);
+    }
+    const bool isPushed = (tick % 400 < 40);
+    torso->getDesiredState().setLinearVelocityBaseInControlFrame(loco::LinearVelocity(0.0, isPushed ? 1.5 : 0.0, 0.0));
+
+    const Clock::time_point start = Clock::now();
+    if (!wholeBodyController.compute()) {
+      printf("Could not compute the torques of tick %d\n", tick);
+      return 1;
+    }
+    const double duration = Milliseconds(Clock::now()-start).count();
+    meanDuration += duration;
+    maxDuration = std::max(maxDuration, duration);
+    meanPasses += wholeBodyController.getNumberOfActiveSetPasses();
+    if (duration > timeBudget) {
+      numberOfTicksOverBudget++;
+    }
+  }
+
+  printf("whole-body controller (%d ticks):\n", numberOfTicks);
+  printf("  compute time:      %8.3f ms (max %.3f ms)\n", meanDuration/numberOfTicks, maxDuration);
+  printf("  active set passes: %8.2f\n", meanPasses/numberOfTicks);
+  printf("  over budget:       %d ticks of %.1f ms\n", numberOfTicksOverBudget, timeBudget);
+  return (numberOfTicksOverBudget == 0) ? 0 : 2;
+}
@@ -0,0 +1,73 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * compileParameterCache.cpp
+ */
+
+/*! Compiles all XML parameter files of a directory into a binary parameter cache.
+ *
+ * Usage: loco_compile_parameter_cache <parameter directory> [cache file]
+ *
+ * If no cache file is given, the cache is written to <parameter directory>/parameters.cache,
+ * which is the file the gait switcher looks for at startup.
+ */
+
+#include "loco/common/ParameterCache.hpp"
+
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    printf("Usage: %s <parameter directory> [cache file]\n", argv[0]);
+    return 1;
+  }
+
+  const std::string directory(argv[1]);
+  const std::string cacheFile = (argc == 3) ? std::string(argv[2]) : directory + "/" + loco::ParameterCache::defaultFileName;
+
+  if (!loco::ParameterCache::compileDirectory(directory, cacheFile)) {
+    printf("Could not compile parameter cache %s\n", cacheFile.c_str());
+    return 1;
+  }
+
+  loco::ParameterCache parameterCache;
+  if (!parameterCache.open(directory, cacheFile)) {
+    printf("Could not open compiled parameter cache %s\n", cacheFile.c_str());
+    return 1;
+  }
+  printf("Compiled parameter cache %s\n", cacheFile.c_str());
+  return 0;
+}
@@ -53,4 +53,8 @@ TorsoControlBase::~TorsoControlBase() {
 
 }
 
+bool TorsoControlBase::addParametersToVector(ParameterVector* parameterVector) {
+  return true;
+}
+
 } /* namespace loco */
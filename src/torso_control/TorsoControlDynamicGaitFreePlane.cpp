@@ -54,13 +54,11 @@ TorsoControlDynamicGaitFreePlane::TorsoControlDynamicGaitFreePlane(LegGroup* leg
   desiredRollSlope_(1.0),
   adaptToTerrain_(CompleteAdaption)
 {
-  firstOrderFilter_ = new robotUtils::FirstOrderFilter();
   comControl_ = new CoMOverSupportPolygonControlDynamicGait(legs_);
 }
 
 
 TorsoControlDynamicGaitFreePlane::~TorsoControlDynamicGaitFreePlane() {
-  if (firstOrderFilter_) delete firstOrderFilter_;
   delete comControl_;
 }
 
@@ -70,7 +68,8 @@ bool TorsoControlDynamicGaitFreePlane::initialize(double dt) {
   const Position hindHipPosition = legs_->getLeg(2)->getPositionWorldToHipInBaseFrame();
   headingDistanceFromForeToHindInBaseFrame_ = foreHipPosition.x()-hindHipPosition.x();
 
-  firstOrderFilter_->initialize(0.0, 1.0, 1.0);
+  firstOrderFilter_.setFirstOrder(1.0, 1.0);
+  firstOrderFilter_.initialize(FilterBank<1>::Array::Zero());
 
   return true;
 }
@@ -265,21 +264,8 @@ bool TorsoControlDynamicGaitFreePlane::setToInterpolated(const TorsoControlBase&
   const TorsoControlDynamicGaitFreePlane& controller2 = static_cast<const TorsoControlDynamicGaitFreePlane&>(torsoController2);
 
   this->comControl_->setToInterpolated(controller1.getCoMOverSupportPolygonControl(), controller2.getCoMOverSupportPolygonControl(), t);
-  desiredTorsoForeHeightAboveGroundInWorldFrameOffset_ = linearlyInterpolate(controller1.getDesiredTorsoForeHeightAboveGroundInWorldFrameOffset(),
-                                                                             controller2.getDesiredTorsoForeHeightAboveGroundInWorldFrameOffset(),
-                                                                             0.0,
-                                                                             1.0,
-                                                                             t);
-  desiredTorsoHindHeightAboveGroundInWorldFrameOffset_ = linearlyInterpolate(controller1.getDesiredTorsoHindHeightAboveGroundInWorldFrameOffset(),
-                                                                             controller2.getDesiredTorsoHindHeightAboveGroundInWorldFrameOffset(),
-                                                                             0.0,
-                                                                             1.0,
-                                                                             t);
-  desiredTorsoCoMHeightAboveGroundInControlFrameOffset_ = linearlyInterpolate(controller1.getDesiredTorsoCoMHeightAboveGroundInControlFrameOffset(),
-                                                                              controller2.getDesiredTorsoCoMHeightAboveGroundInControlFrameOffset(),
-                                                                              0.0,
-                                                                              1.0,
-                                                                              t);
+
+  /* the height offsets are interpolated by the parameter vector (see addParametersToVector) */
 
   if(!interpolateHeightTrajectory(desiredTorsoForeHeightAboveGroundInWorldFrame_, controller1.desiredTorsoForeHeightAboveGroundInWorldFrame_, controller2.desiredTorsoForeHeightAboveGroundInWorldFrame_, t)) {
     return false;
@@ -292,6 +278,16 @@ bool TorsoControlDynamicGaitFreePlane::setToInterpolated(const TorsoControlBase&
 }
 
 
+bool TorsoControlDynamicGaitFreePlane::addParametersToVector(ParameterVector* parameterVector) {
+  std::vector<double*> parameters;
+  parameters.push_back(&desiredTorsoForeHeightAboveGroundInWorldFrameOffset_);
+  parameters.push_back(&desiredTorsoHindHeightAboveGroundInWorldFrameOffset_);
+  parameters.push_back(&desiredTorsoCoMHeightAboveGroundInControlFrameOffset_);
+  parameterVector->addSlice("TorsoControlDynamicGaitFreePlane", parameters);
+  return comControl_->addParametersToVector(parameterVector);
+}
+
+
 template <typename T> int TorsoControlDynamicGaitFreePlane::sgn(T val) {
     return (T(0) < val) - (val < T(0));
 }
@@ -75,8 +75,10 @@ TorsoControlGaitContainer::TorsoControlGaitContainer(LegGroup* legs, TorsoBase*
   tValues.push_back(0.50); xValues.push_back(0.0);
   tValues.push_back(0.75); xValues.push_back(0.0);
   tValues.push_back(1.00); xValues.push_back(0.0);
-  desiredTorsoForeHeightAboveGroundInWorldFrame_.setRBFData(tValues, xValues);
-  desiredTorsoHindHeightAboveGroundInWorldFrame_.setRBFData(tValues, xValues);
+  std::shared_ptr<rbf::PeriodicRBF1DC1> defaultTrajectory(new rbf::PeriodicRBF1DC1());
+  defaultTrajectory->setRBFData(tValues, xValues);
+  desiredTorsoForeHeightAboveGroundInWorldFrame_.setTrajectory(defaultTrajectory);
+  desiredTorsoHindHeightAboveGroundInWorldFrame_.setTrajectory(defaultTrajectory);
 }
 
 
@@ -174,28 +176,25 @@ const CoMOverSupportPolygonControlBase& TorsoControlGaitContainer::getCoMOverSup
 }
 
 
-bool TorsoControlGaitContainer::interpolateHeightTrajectory(rbf::PeriodicRBF1DC1& interpolatedTrajectory, const rbf::PeriodicRBF1DC1& trajectory1, const rbf::PeriodicRBF1DC1& trajectory2, double t) {
+const TorsoControlGaitContainer::HeightTrajectory& TorsoControlGaitContainer::getDesiredTorsoForeHeightTrajectory() const {
+  return desiredTorsoForeHeightAboveGroundInWorldFrame_;
+}
 
-  const int nKnots = std::max<int>(trajectory1.getKnotCount(), trajectory2.getKnotCount());
-  const double tMax1 = trajectory1.getKnotPosition(trajectory1.getKnotCount()-1);
-  const double tMax2 = trajectory2.getKnotPosition(trajectory2.getKnotCount()-1);
-  const double tMin1 = trajectory1.getKnotPosition(0);
-  const double tMin2 = trajectory2.getKnotPosition(0);
-  double tMax = std::max<double>(tMax1, tMax2);
-  double tMin = std::min<double>(tMin1, tMin2);
+const TorsoControlGaitContainer::HeightTrajectory& TorsoControlGaitContainer::getDesiredTorsoHindHeightTrajectory() const {
+  return desiredTorsoHindHeightAboveGroundInWorldFrame_;
+}
 
-  double dt = (tMax-tMin)/(nKnots-1);
-  std::vector<double> tValues, xValues;
-  for (int i=0; i<nKnots;i++){
-    const double time = tMin + i*dt;
-    double v = linearlyInterpolate(trajectory1.evaluate(time), trajectory2.evaluate(time), 0.0, 1.0, t);
-    tValues.push_back(time);
-    xValues.push_back(v);
-//    printf("(%f,%f / %f, %f) ", time,v, legProps1->swingFootHeightTrajectory.evaluate(time), legProps2->swingFootHeightTrajectory.evaluate(time));
+bool TorsoControlGaitContainer::setHeightTrajectoriesToInterpolated(const HeightTrajectory& foreTrajectory1, const HeightTrajectory& hindTrajectory1,
+                                                                    const HeightTrajectory& foreTrajectory2, const HeightTrajectory& hindTrajectory2,
+                                                                    double t) {
+  if (!interpolateHeightTrajectory(desiredTorsoForeHeightAboveGroundInWorldFrame_, foreTrajectory1, foreTrajectory2, t)) {
+    return false;
   }
+  return interpolateHeightTrajectory(desiredTorsoHindHeightAboveGroundInWorldFrame_, hindTrajectory1, hindTrajectory2, t);
+}
 
-  interpolatedTrajectory.setRBFData(tValues, xValues);
-  return true;
+bool TorsoControlGaitContainer::interpolateHeightTrajectory(HeightTrajectory& interpolatedTrajectory, const HeightTrajectory& trajectory1, const HeightTrajectory& trajectory2, double t) {
+  return interpolatedTrajectory.setToInterpolated(trajectory1, trajectory2, t);
 }
 
 
@@ -253,7 +252,7 @@ bool TorsoControlGaitContainer::loadParametersTorsoConfiguration(const TiXmlHand
 }
 
 
-bool TorsoControlGaitContainer::loadHeightTrajectory(const TiXmlHandle &hTrajectory,  rbf::PeriodicRBF1DC1& trajectory) {
+bool TorsoControlGaitContainer::loadHeightTrajectory(const TiXmlHandle &hTrajectory,  HeightTrajectory& trajectory) {
   TiXmlElement* pElem;
   int iKnot;
   double t, value;
@@ -273,7 +272,9 @@ bool TorsoControlGaitContainer::loadHeightTrajectory(const TiXmlHandle &hTraject
       xValues.push_back(value);
 //      printf("t=%f, v=%f\n", t, value);
    }
-   trajectory.setRBFData(tValues, xValues);
+   std::shared_ptr<rbf::PeriodicRBF1DC1> loadedTrajectory(new rbf::PeriodicRBF1DC1());
+   loadedTrajectory->setRBFData(tValues, xValues);
+   trajectory.setTrajectory(loadedTrajectory);
 
 
   return true;
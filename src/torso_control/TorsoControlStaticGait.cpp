@@ -65,7 +65,9 @@ bool TorsoControlStaticGait::initialize(double dt) {
   headingDistanceFromForeToHindInBaseFrame_ = foreHipPosition.x()-hindHipPosition.x();
 
   CoMOverSupportPolygonControlStaticGait* comStatic = static_cast<CoMOverSupportPolygonControlStaticGait*>(comControl_);
-  comStatic->initialize();
+  if (!comStatic->initialize()) {
+    return false;
+  }
 
   return true;
 }
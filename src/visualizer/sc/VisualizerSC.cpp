@@ -289,35 +289,27 @@ void VisualizerSC::drawForceAndTorqueInBaseFrame(const Force& forceInBaseFrame,
 void VisualizerSC::drawSupportPolygon(loco::LegGroup* legs, double lineWidth) {
   glLineWidth(lineWidth);
 
-  if (legs->getLeftForeLeg()->isGrounded() && legs->getLeftHindLeg()->isGrounded()) {
-    const loco::Position start = legs->getLeftForeLeg()->getPositionWorldToFootInWorldFrame();
-    const loco::Position end = legs->getLeftHindLeg()->getPositionWorldToFootInWorldFrame();
-    GLUtilsKindr::drawLine(start, end);
-  }
-  if (legs->getLeftForeLeg()->isGrounded() && legs->getRightHindLeg()->isGrounded()) {
-    const loco::Position start = legs->getLeftForeLeg()->getPositionWorldToFootInWorldFrame();
-    const loco::Position end = legs->getRightHindLeg()->getPositionWorldToFootInWorldFrame();
-    GLUtilsKindr::drawLine(start, end);
-  }
-  if (legs->getLeftForeLeg()->isGrounded() && legs->getRightForeLeg()->isGrounded()) {
-    const loco::Position start = legs->getLeftForeLeg()->getPositionWorldToFootInWorldFrame();
-    const loco::Position end = legs->getRightForeLeg()->getPositionWorldToFootInWorldFrame();
-    GLUtilsKindr::drawLine(start, end);
-  }
-  if (legs->getRightForeLeg()->isGrounded() && legs->getRightHindLeg()->isGrounded()) {
-    const loco::Position start = legs->getRightForeLeg()->getPositionWorldToFootInWorldFrame();
-    const loco::Position end = legs->getRightHindLeg()->getPositionWorldToFootInWorldFrame();
-    GLUtilsKindr::drawLine(start, end);
-  }
-  if (legs->getRightForeLeg()->isGrounded() && legs->getLeftHindLeg()->isGrounded()) {
-    const loco::Position start = legs->getRightForeLeg()->getPositionWorldToFootInWorldFrame();
-    const loco::Position end = legs->getLeftHindLeg()->getPositionWorldToFootInWorldFrame();
-    GLUtilsKindr::drawLine(start, end);
+  /* convex hull of the grounded feet, the edges are drawn between the feet */
+  loco::Position positionsWorldToFootInWorldFrame[loco::ConvexPolygon::maxNumberOfVertices];
+  loco::ConvexPolygon::Points feet(2, legs->size());
+  int nGroundedLegs = 0;
+  for (auto leg : *legs) {
+    if (leg->isGrounded() && nGroundedLegs < loco::ConvexPolygon::maxNumberOfVertices) {
+      positionsWorldToFootInWorldFrame[nGroundedLegs] = leg->getPositionWorldToFootInWorldFrame();
+      feet.col(nGroundedLegs) << positionsWorldToFootInWorldFrame[nGroundedLegs].x(), positionsWorldToFootInWorldFrame[nGroundedLegs].y();
+      nGroundedLegs++;
+    }
   }
-  if (legs->getRightHindLeg()->isGrounded() && legs->getLeftHindLeg()->isGrounded()) {
-    const loco::Position start = legs->getRightHindLeg()->getPositionWorldToFootInWorldFrame();
-    const loco::Position end = legs->getLeftHindLeg()->getPositionWorldToFootInWorldFrame();
-    GLUtilsKindr::drawLine(start, end);
+  feet.conservativeResize(2, nGroundedLegs);
+
+  loco::ConvexPolygon supportPolygon;
+  supportPolygon.setToConvexHull(feet);
+  const int nVertices = supportPolygon.getNumberOfVertices();
+  // a line if only two feet are grounded
+  const int nEdges = (nVertices > 2) ? nVertices : nVertices-1;
+  for (int k=0; k<nEdges; k++) {
+    GLUtilsKindr::drawLine(positionsWorldToFootInWorldFrame[supportPolygon.getIndexOfVertex(k)],
+                           positionsWorldToFootInWorldFrame[supportPolygon.getIndexOfVertex((k+1)%nVertices)]);
   }
 }
 
@@ -465,19 +457,25 @@ void VisualizerSC::drawTrajectoryCatMullRomPosition(TrajectoryPosition &trajecto
    GLfloat prevLineWidth;
    glGetFloatv(GL_LINE_WIDTH, &prevLineWidth);
 
+  // sample the trajectory at 0, dt, 2*dt, ..., trajLength in one batch
+  const double trajLength = trajectory.getKnotPosition(knotCount-1);
+  sampleTimes_.clear();
+  sampleTimes_.push_back(0.0);
+  for (double t=dt; t<trajLength-dt/2; t+=dt) {
+    sampleTimes_.push_back(t);
+  }
+  sampleTimes_.push_back(trajLength);
+  samplePositions_.resize(sampleTimes_.size());
+  trajectory.evaluate_catmull_rom(sampleTimes_.data(), samplePositions_.data(), sampleTimes_.size());
+
   glBegin(GL_LINES);
-    double trajLength = trajectory.getKnotPosition(trajectory.getKnotCount()-1);
-    Position pt = trajectory.evaluate_catmull_rom(0.0);
-    for (double t=dt; t<trajLength-dt/2; t+=dt)
+    for (uint i=1; i<samplePositions_.size(); i++)
     {
-      Position nextPt = trajectory.evaluate_catmull_rom(t);
+      const Position& pt = samplePositions_[i-1];
+      const Position& nextPt = samplePositions_[i];
       glVertex3d(pt.x(), pt.y(), pt.z());
       glVertex3d(nextPt.x(), nextPt.y(), nextPt.z());
-      pt = nextPt;
     }
-    Position nextPt = trajectory.evaluate_catmull_rom(trajLength);
-    glVertex3d(pt.x(), pt.y(), pt.z());
-    glVertex3d(nextPt.x(), nextPt.y(), nextPt.z());
   glEnd();
 
   glLineWidth(prevLineWidth);
@@ -498,19 +496,25 @@ void VisualizerSC::drawTrajectoryLinearPosition(TrajectoryPosition &trajectory,
   GLfloat prevLineWidth;
   glGetFloatv(GL_LINE_WIDTH, &prevLineWidth);
 
+  // sample the trajectory at 0, dt, 2*dt, ..., trajLength in one batch
+  const double trajLength = trajectory.getKnotPosition(knotCount-1);
+  sampleTimes_.clear();
+  sampleTimes_.push_back(0.0);
+  for (double t=dt; t<trajLength-dt/2; t+=dt) {
+    sampleTimes_.push_back(t);
+  }
+  sampleTimes_.push_back(trajLength);
+  samplePositions_.resize(sampleTimes_.size());
+  trajectory.evaluate_linear(sampleTimes_.data(), samplePositions_.data(), sampleTimes_.size());
+
   glBegin(GL_LINES);
-    double trajLength = trajectory.getKnotPosition(knotCount-1);
-    Position pt = trajectory.evaluate_linear(0.0);
-    for (double t=dt; t<trajLength-dt/2; t+=dt)
+    for (uint i=1; i<samplePositions_.size(); i++)
     {
-      Position nextPt = trajectory.evaluate_linear(t);
+      const Position& pt = samplePositions_[i-1];
+      const Position& nextPt = samplePositions_[i];
       glVertex3d(pt.x(), pt.y(), pt.z());
       glVertex3d(nextPt.x(), nextPt.y(), nextPt.z());
-      pt = nextPt;
     }
-    Position nextPt = trajectory.evaluate_linear(trajLength);
-    glVertex3d(pt.x(), pt.y(), pt.z());
-    glVertex3d(nextPt.x(), nextPt.y(), nextPt.z());
   glEnd();
 
   glLineWidth(prevLineWidth);
@@ -0,0 +1,165 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     TestLegAndTorso.hpp
+* @version  1.0
+* @ingroup
+* @brief    Legs and torso for unit tests that do not depend on a robot model
+*/
+
+#ifndef LOCO_TEST_TESTLEGANDTORSO_HPP_
+#define LOCO_TEST_TESTLEGANDTORSO_HPP_
+
+#include "loco/common/LegBase.hpp"
+#include "loco/common/LegLinkGroup.hpp"
+#include "loco/common/TorsoBase.hpp"
+#include "loco/state_switcher/StateSwitcher.hpp"
+
+#include <string>
+
+namespace loco_test {
+
+class TestLegProperties : public loco::LegPropertiesBase {
+ public:
+  TestLegProperties() :
+    legLength_(0.5)
+  {
+  }
+  virtual bool initialize(double /*dt*/) { return true; }
+  virtual bool advance(double /*dt*/) { return true; }
+  virtual double getLegLength() { return legLength_; }
+  void setLegLength(double legLength) { legLength_ = legLength; }
+
+ private:
+  double legLength_;
+};
+
+/*! Leg that only holds the state that is set by the test.
+ *  The base frame coincides with the world frame, hence the foot position is the same in both frames.
+ *  The leg is grounded and should be grounded. It has no links unless setLink is called.
+ */
+class TestLeg : public loco::LegBase {
+ public:
+  TestLeg(const std::string& name, int id, const loco::Position& positionWorldToFootInWorldFrame) :
+    loco::LegBase(name, &linkGroup_),
+    id_(id),
+    isLinkAdded_(false),
+    positionWorldToFootInWorldFrame_(positionWorldToFootInWorldFrame),
+    translationJacobian_(TranslationJacobian::Zero())
+  {
+    stateSwitcher_ = new loco::StateSwitcher();
+    setIsGrounded(true);
+    setShouldBeGrounded(true);
+  }
+  virtual ~TestLeg() {
+    delete stateSwitcher_;
+  }
+
+  //! Sets the single link of the leg
+  void setLink(double mass, const loco::Position& positionBaseToCoMInBaseFrame, const TranslationJacobian& translationJacobianBaseToCoMInBaseFrame) {
+    link_.setMass(mass);
+    link_.setBaseToCoMPositionInBaseFrame(positionBaseToCoMInBaseFrame);
+    link_.setTranslationJacobianBaseToCoMInBaseFrame(translationJacobianBaseToCoMInBaseFrame);
+    if (!isLinkAdded_) {
+      linkGroup_.addLegLink(&link_);
+      isLinkAdded_ = true;
+    }
+  }
+  void setPositionWorldToFootInWorldFrame(const loco::Position& position) { positionWorldToFootInWorldFrame_ = position; }
+  void setPositionWorldToHipInWorldFrame(const loco::Position& position) { positionWorldToHipInWorldFrame_ = position; }
+  void setLinearVelocityFootInWorldFrame(const loco::LinearVelocity& linearVelocity) { linearVelocityFootInWorldFrame_ = linearVelocity; }
+  void setLinearVelocityHipInWorldFrame(const loco::LinearVelocity& linearVelocity) { linearVelocityHipInWorldFrame_ = linearVelocity; }
+  void setTranslationJacobianFromBaseToFootInBaseFrame(const TranslationJacobian& translationJacobian) { translationJacobian_ = translationJacobian; }
+
+  virtual const loco::Position& getPositionWorldToFootInWorldFrame() const { return positionWorldToFootInWorldFrame_; }
+  virtual const loco::Position& getPositionWorldToHipInWorldFrame() const { return positionWorldToHipInWorldFrame_; }
+  virtual const loco::Position& getPositionWorldToFootInBaseFrame() const { return positionWorldToFootInWorldFrame_; }
+  virtual const loco::Position& getPositionWorldToHipInBaseFrame() const { return positionWorldToHipInWorldFrame_; }
+  virtual const loco::Position& getPositionBaseToFootInBaseFrame() const { return positionWorldToFootInWorldFrame_; }
+  virtual const loco::Position& getPositionBaseToHipInBaseFrame() const { return positionWorldToHipInWorldFrame_; }
+  virtual const loco::LinearVelocity& getLinearVelocityFootInWorldFrame() const { return linearVelocityFootInWorldFrame_; }
+  virtual const loco::LinearVelocity& getLinearVelocityHipInWorldFrame() const { return linearVelocityHipInWorldFrame_; }
+  virtual JointPositions getJointPositionsFromPositionBaseToFootInBaseFrame(const loco::Position& /*positionBaseToFootInBaseFrame*/) { return JointPositions::Zero(); }
+  virtual const TranslationJacobian& getTranslationJacobianFromBaseToFootInBaseFrame() const { return translationJacobian_; }
+  virtual const loco::Force& getFootContactForceInWorldFrame() const { return force_; }
+  virtual const loco::Vector& getFootContactNormalInWorldFrame() const { return normal_; }
+  virtual bool initialize(double /*dt*/) { return true; }
+  virtual bool advance(double /*dt*/) { return true; }
+  virtual TestLegProperties& getProperties() { return properties_; }
+  virtual const TestLegProperties& getProperties() const { return properties_; }
+  virtual int getId() const { return id_; }
+
+ private:
+  int id_;
+  loco::LegLink link_;
+  loco::LegLinkGroup linkGroup_;
+  bool isLinkAdded_;
+  loco::Position positionWorldToFootInWorldFrame_;
+  loco::Position positionWorldToHipInWorldFrame_;
+  loco::LinearVelocity linearVelocityFootInWorldFrame_;
+  loco::LinearVelocity linearVelocityHipInWorldFrame_;
+  TranslationJacobian translationJacobian_;
+  loco::Force force_;
+  loco::Vector normal_;
+  TestLegProperties properties_;
+};
+
+class TestTorsoProperties : public loco::TorsoPropertiesBase {
+ public:
+  virtual bool initialize(double /*dt*/) { return true; }
+  virtual bool advance(double /*dt*/) { return true; }
+};
+
+//! Torso that only holds the state and the properties that are set by the test
+class TestTorso : public loco::TorsoBase {
+ public:
+  virtual loco::TorsoStateMeasured& getMeasuredState() { return measuredState_; }
+  virtual loco::TorsoStateDesired& getDesiredState() { return desiredState_; }
+  virtual const loco::TorsoStateDesired& getDesiredState() const { return desiredState_; }
+  virtual TestTorsoProperties& getProperties() { return properties_; }
+  virtual double getStridePhase() { return 0.0; }
+  virtual void setStridePhase(double /*stridePhase*/) { }
+  virtual bool initialize(double /*dt*/) { return true; }
+  virtual bool advance(double /*dt*/) { return true; }
+
+ private:
+  loco::TorsoStateMeasured measuredState_;
+  loco::TorsoStateDesired desiredState_;
+  TestTorsoProperties properties_;
+};
+
+} /* namespace loco_test */
+
+#endif /* LOCO_TEST_TESTLEGANDTORSO_HPP_ */
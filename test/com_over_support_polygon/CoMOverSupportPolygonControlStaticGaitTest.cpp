@@ -0,0 +1,174 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     CoMOverSupportPolygonControlStaticGaitTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/com_over_support_polygon/CoMOverSupportPolygonControlStaticGait.hpp"
+
+#include "loco/common/LegStarlETH.hpp"
+#include "loco/common/TorsoStarlETH.hpp"
+
+#include "RobotModel.hpp"
+#include "tinyxml.h"
+
+#include <cmath>
+
+
+static const char* staticGaitParameters =
+  "<StaticGait>"
+  "  <CoMOverSupportPolygonControl>"
+  "    <Delta forward=\"0.05\" backward=\"0.05\"/>"
+  "    <CoMFilter timeConstant=\"0.5\"/>"
+  "    <ZmpPreview samplingTime=\"0.02\" previewTime=\"1.6\" heightOfCoM=\"0.45\" weightZmpError=\"1.0\" weightJerk=\"1.0e-6\"/>"
+  "  </CoMOverSupportPolygonControl>"
+  "</StaticGait>";
+
+static const char* staticGaitParametersWithoutZmpPreview =
+  "<StaticGait>"
+  "  <CoMOverSupportPolygonControl>"
+  "    <Delta forward=\"0.05\" backward=\"0.05\"/>"
+  "    <CoMFilter timeConstant=\"0.5\"/>"
+  "  </CoMOverSupportPolygonControl>"
+  "</StaticGait>";
+
+
+TEST(CoMOverSupportPolygonControlStaticGaitTest, comMovesDuringSwing) {
+  const double dt = 0.0025;
+  robotModel::RobotModel robotModel;
+  loco::LegGroup legs;
+  loco::LegStarlETH leftForeLeg("leftFore", 0, &robotModel);
+  loco::LegStarlETH rightForeLeg("rightFore", 1, &robotModel);
+  loco::LegStarlETH leftHindLeg("leftHind", 2, &robotModel);
+  loco::LegStarlETH rightHindLeg("rightHind", 3, &robotModel);
+  legs.addLeg(&leftForeLeg);
+  legs.addLeg(&rightForeLeg);
+  legs.addLeg(&leftHindLeg);
+  legs.addLeg(&rightHindLeg);
+  loco::TorsoStarlETH torso(&robotModel);
+
+  robotModel.init();
+  robotModel.update();
+
+  TiXmlDocument document;
+  document.Parse(staticGaitParameters);
+  ASSERT_FALSE(document.Error());
+  TiXmlHandle handle(document.FirstChild("StaticGait"));
+
+  loco::CoMOverSupportPolygonControlStaticGait comControl(&legs, &torso);
+  ASSERT_TRUE(comControl.loadParametersStaticGait(handle));
+  ASSERT_NE(nullptr, comControl.getZmpPreviewController());
+  ASSERT_TRUE(comControl.initialize());
+  EXPECT_TRUE(comControl.getZmpPreviewController()->isInitialized());
+
+  // the left fore leg swings, the other legs lift off one after another
+  const double swingDuration = 0.6;
+  const double stanceDuration = 1.8;
+  for (auto leg : legs) {
+    leg->setSwingDuration(swingDuration);
+    leg->setStanceDuration(stanceDuration);
+    leg->setSwingPhase(-1.0);
+  }
+  rightHindLeg.setStancePhase(0.0);
+  rightForeLeg.setStancePhase(1.0/3.0);
+  leftHindLeg.setStancePhase(2.0/3.0);
+
+  // the next foothold of the swing leg is 10cm ahead
+  loco::Position positionWorldToFootHoldInWorldFrame = leftForeLeg.getPositionWorldToFootInWorldFrame();
+  positionWorldToFootHoldInWorldFrame.x() += 0.1;
+  comControl.setFootHold(0, positionWorldToFootHoldInWorldFrame);
+
+  // center of the feet and of the support triangle of the swing phase
+  loco::Position positionWorldToCenterOfFeetInWorldFrame;
+  loco::Position positionWorldToCenterOfSupportFeetInWorldFrame;
+  for (auto leg : legs) {
+    positionWorldToCenterOfFeetInWorldFrame += leg->getPositionWorldToFootInWorldFrame()/4.0;
+    if (leg != &leftForeLeg) {
+      positionWorldToCenterOfSupportFeetInWorldFrame += leg->getPositionWorldToFootInWorldFrame()/3.0;
+    }
+  }
+  const Eigen::Vector2d directionToSupportTriangle(positionWorldToCenterOfSupportFeetInWorldFrame.x()-positionWorldToCenterOfFeetInWorldFrame.x(),
+                                                   positionWorldToCenterOfSupportFeetInWorldFrame.y()-positionWorldToCenterOfFeetInWorldFrame.y());
+  ASSERT_GT(directionToSupportTriangle.norm(), 0.01);
+
+  comControl.setIsInStandConfiguration(false);
+  const int nTicks = static_cast<int>(0.5*swingDuration/dt);
+  for (int k=0; k<nTicks; k++) {
+    leftForeLeg.setSwingPhase(k*dt/swingDuration);
+    rightHindLeg.setStancePhase(rightHindLeg.getStancePhase()+dt/stanceDuration);
+    rightForeLeg.setStancePhase(rightForeLeg.getStancePhase()+dt/stanceDuration);
+    leftHindLeg.setStancePhase(leftHindLeg.getStancePhase()+dt/stanceDuration);
+    comControl.advance(dt);
+    EXPECT_TRUE(comControl.isSafeToResumeWalking());
+  }
+
+  // the CoM has moved away from the center of the feet towards the support triangle
+  const loco::Position& positionWorldToDesiredCoMInWorldFrame = comControl.getPositionWorldToDesiredCoMInWorldFrame();
+  const Eigen::Vector2d displacement(positionWorldToDesiredCoMInWorldFrame.x()-positionWorldToCenterOfFeetInWorldFrame.x(),
+                                     positionWorldToDesiredCoMInWorldFrame.y()-positionWorldToCenterOfFeetInWorldFrame.y());
+  EXPECT_GT(displacement.norm(), 0.005);
+  EXPECT_GT(displacement.dot(directionToSupportTriangle), 0.0);
+}
+
+
+TEST(CoMOverSupportPolygonControlStaticGaitTest, zmpPreviewIsOptional) {
+  robotModel::RobotModel robotModel;
+  loco::LegGroup legs;
+  loco::TorsoStarlETH torso(&robotModel);
+  loco::CoMOverSupportPolygonControlStaticGait comControl(&legs, &torso);
+
+  TiXmlDocument document;
+  document.Parse(staticGaitParameters);
+  TiXmlHandle handle(document.FirstChild("StaticGait"));
+  ASSERT_TRUE(comControl.loadParametersStaticGait(handle));
+  EXPECT_NE(nullptr, comControl.getZmpPreviewController());
+
+  // without the element, the CoM is filtered towards the support triangles
+  TiXmlDocument documentWithoutZmpPreview;
+  documentWithoutZmpPreview.Parse(staticGaitParametersWithoutZmpPreview);
+  TiXmlHandle handleWithoutZmpPreview(documentWithoutZmpPreview.FirstChild("StaticGait"));
+  ASSERT_TRUE(comControl.loadParametersStaticGait(handleWithoutZmpPreview));
+  EXPECT_EQ(nullptr, comControl.getZmpPreviewController());
+
+  // a controller that has been set is kept
+  loco::ZmpPreviewController zmpPreviewController;
+  comControl.setZmpPreviewController(&zmpPreviewController);
+  ASSERT_TRUE(comControl.loadParametersStaticGait(handleWithoutZmpPreview));
+  EXPECT_EQ(&zmpPreviewController, comControl.getZmpPreviewController());
+}
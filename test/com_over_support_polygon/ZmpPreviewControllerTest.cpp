@@ -0,0 +1,100 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ZmpPreviewControllerTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/com_over_support_polygon/ZmpPreviewController.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+
+TEST(ZmpPreviewControllerTest, stepOfReference) {
+  loco::ZmpPreviewController controller;
+  ASSERT_FALSE(controller.initialize(0.01, 10.0, 0.45));
+  ASSERT_TRUE(controller.initialize(0.02, 1.6, 0.45));
+  ASSERT_EQ(80, controller.getNumberOfPreviewSamples());
+
+  // the preview gains decay over the horizon
+  const double gainFirst = std::fabs(controller.getPreviewGains()(0));
+  const double gainLast = std::fabs(controller.getPreviewGains()(controller.getNumberOfPreviewSamples()-1));
+  EXPECT_LT(gainLast, 0.01*gainFirst);
+
+  controller.reset(Eigen::Vector2d::Zero());
+
+  // the ZMP steps from the origin to (0.1, -0.05) at t = 1 s, the controller runs at 400 Hz
+  const double dt = 0.0025;
+  const double timeOfStep = 1.0;
+  const int N = controller.getNumberOfPreviewSamples();
+  loco::ZmpPreviewController::ZmpReference reference(N+1, 2);
+  double timeSinceUpdate = controller.getSamplingTime();
+  double maxZmpError = 0.0;
+  Eigen::Vector2d positionCoMAtStep = Eigen::Vector2d::Zero();
+  for (double time = 0.0; time < 4.0; time += dt) {
+    if (timeSinceUpdate >= controller.getSamplingTime()-1.0e-9) {
+      for (int j=0; j<=N; j++) {
+        if (time + j*controller.getSamplingTime() < timeOfStep) {
+          reference.row(j) << 0.0, 0.0;
+        }
+        else {
+          reference.row(j) << 0.1, -0.05;
+        }
+      }
+      ASSERT_TRUE(controller.update(reference));
+      timeSinceUpdate = 0.0;
+      if (time > timeOfStep + 0.5) {
+        maxZmpError = std::max(maxZmpError, (controller.getZmp()-reference.row(0).transpose()).norm());
+      }
+    }
+    controller.integrate(dt);
+    timeSinceUpdate += dt;
+    if (std::fabs(time-timeOfStep) < dt/2.0) {
+      positionCoMAtStep = controller.getPositionCoM();
+    }
+  }
+
+  // the center of mass moves before the step of the reference
+  EXPECT_GT(positionCoMAtStep.x(), 0.02);
+  EXPECT_LT(positionCoMAtStep.y(), -0.01);
+
+  EXPECT_NEAR(0.1, controller.getPositionCoM().x(), 1e-3);
+  EXPECT_NEAR(-0.05, controller.getPositionCoM().y(), 1e-3);
+  EXPECT_NEAR(0.0, controller.getVelocityCoM().norm(), 1e-3);
+  EXPECT_LT(maxZmpError, 0.01);
+}
@@ -0,0 +1,120 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     BackgroundJobQueueTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/BackgroundJobQueue.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+//! Stands in for parsing a parameter file
+void parse(std::chrono::milliseconds duration) {
+  std::this_thread::sleep_for(duration);
+}
+
+} // namespace
+
+
+TEST(BackgroundJobQueueTest, jobsRunInOrder) {
+  loco::BackgroundJobQueue jobQueue;
+  std::vector<int> order;
+  for (int i=0; i<5; i++) {
+    jobQueue.addJob([&order, i]() { order.push_back(i); });
+  }
+  jobQueue.waitUntilDone();
+  ASSERT_EQ(5u, order.size());
+  for (int i=0; i<5; i++) {
+    EXPECT_EQ(i, order[i]);
+  }
+  EXPECT_FALSE(jobQueue.isBusy());
+}
+
+TEST(BackgroundJobQueueTest, loadWhileTicking) {
+  const std::chrono::microseconds tickDuration(2500);
+  loco::BackgroundJobQueue jobQueue;
+  std::atomic<bool> isPrefetched(false);
+  std::atomic<bool> isLoaded(false);
+
+  // a long prefetch is running when the parameter set is requested, the request is queued instead of rejected
+  jobQueue.addJob([&isPrefetched]() { parse(std::chrono::milliseconds(40)); isPrefetched = true; });
+  int numberOfTicks = 0;
+  bool isRequested = false;
+  std::chrono::steady_clock::duration maxTickDuration = std::chrono::steady_clock::duration::zero();
+  const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!isLoaded && std::chrono::steady_clock::now() < timeout) {
+    const std::chrono::steady_clock::time_point tickStart = std::chrono::steady_clock::now();
+    if (numberOfTicks == 2) {
+      EXPECT_TRUE(jobQueue.isBusy());
+      jobQueue.addJob([&isPrefetched, &isLoaded]() {
+        EXPECT_TRUE(isPrefetched);
+        parse(std::chrono::milliseconds(40));
+        isLoaded = true;
+      });
+      isRequested = true;
+    }
+    maxTickDuration = std::max(maxTickDuration, std::chrono::steady_clock::now() - tickStart);
+    numberOfTicks++;
+    std::this_thread::sleep_until(tickStart + tickDuration);
+  }
+
+  ASSERT_TRUE(isRequested);
+  ASSERT_TRUE(isLoaded);
+  // the control loop kept ticking while the files were parsed and was never blocked by a job
+  EXPECT_GT(numberOfTicks, 20);
+  EXPECT_LT(maxTickDuration, std::chrono::steady_clock::duration(tickDuration));
+}
+
+TEST(BackgroundJobQueueTest, clearDiscardsQueuedJobs) {
+  loco::BackgroundJobQueue jobQueue;
+  std::atomic<int> numberOfJobs(0);
+  std::atomic<bool> isStarted(false);
+  jobQueue.addJob([&numberOfJobs, &isStarted]() { isStarted = true; parse(std::chrono::milliseconds(20)); numberOfJobs++; });
+  jobQueue.addJob([&numberOfJobs]() { numberOfJobs++; });
+  while (!isStarted) {
+    std::this_thread::yield();
+  }
+  jobQueue.clear();
+  jobQueue.waitUntilDone();
+  EXPECT_EQ(1, numberOfJobs);
+}
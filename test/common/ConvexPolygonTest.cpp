@@ -0,0 +1,132 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ConvexPolygonTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/ConvexPolygon.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+
+TEST(ConvexPolygonTest, convexHull) {
+  loco::ConvexPolygon::Points points(2, 6);
+  points << 0.0, 1.0, 1.0, 0.0, 0.5, 0.5,
+            0.0, 0.0, 1.0, 1.0, 0.5, 0.0;
+  loco::ConvexPolygon polygon;
+  ASSERT_TRUE(polygon.setToConvexHull(points));
+  ASSERT_EQ(4, polygon.getNumberOfVertices());
+
+  // counter-clockwise from the lowest x
+  EXPECT_EQ(0, polygon.getIndexOfVertex(0));
+  EXPECT_EQ(1, polygon.getIndexOfVertex(1));
+  EXPECT_EQ(2, polygon.getIndexOfVertex(2));
+  EXPECT_EQ(3, polygon.getIndexOfVertex(3));
+
+  EXPECT_TRUE(polygon.isInside(loco::ConvexPolygon::Point(0.5, 0.5)));
+  EXPECT_FALSE(polygon.isInside(loco::ConvexPolygon::Point(1.1, 0.5)));
+  EXPECT_TRUE(polygon.isInside(loco::ConvexPolygon::Point(1.1, 0.5), 0.2));
+  EXPECT_NEAR(0.25, polygon.getSignedDistance(loco::ConvexPolygon::Point(0.25, 0.5)), 1e-12);
+  EXPECT_NEAR(-0.1, polygon.getSignedDistance(loco::ConvexPolygon::Point(0.5, -0.1)), 1e-12);
+
+  loco::ConvexPolygon::EdgeValues distances;
+  polygon.getSignedDistancesToEdges(loco::ConvexPolygon::Point(0.25, 0.5), distances);
+  ASSERT_EQ(4, distances.cols());
+  EXPECT_NEAR(0.5, distances(0), 1e-12);
+  EXPECT_NEAR(0.75, distances(1), 1e-12);
+  EXPECT_NEAR(0.5, distances(2), 1e-12);
+  EXPECT_NEAR(0.25, distances(3), 1e-12);
+
+  loco::ConvexPolygon::Points collinear(2, 3);
+  collinear << 0.0, 1.0, 2.0,
+               0.0, 1.0, 2.0;
+  EXPECT_FALSE(polygon.setToConvexHull(collinear));
+  EXPECT_EQ(2, polygon.getNumberOfVertices());
+  EXPECT_FALSE(polygon.isInside(loco::ConvexPolygon::Point(1.0, 1.0)));
+}
+
+
+TEST(ConvexPolygonTest, inwardOffset) {
+  // clockwise triangle, the order of the vertices has to be kept
+  loco::ConvexPolygon::Points triangle(2, 3);
+  triangle << 0.0, 0.0, 1.0,
+              0.0, 1.0, 0.0;
+  loco::ConvexPolygon polygon;
+  ASSERT_TRUE(polygon.setVertices(triangle));
+
+  const double margin = 0.05;
+  loco::ConvexPolygon safePolygon;
+  ASSERT_TRUE(polygon.getInwardOffset(margin, safePolygon));
+  ASSERT_EQ(3, safePolygon.getNumberOfVertices());
+
+  // previous implementation of the safe triangle: shift the vertex along the bisector
+  for (int k=0; k<3; k++) {
+    loco::ConvexPolygon::Point v1 = triangle.col((k+1)%3) - triangle.col(k);
+    loco::ConvexPolygon::Point v2 = triangle.col((k+2)%3) - triangle.col(k);
+    v1.normalize();
+    v2.normalize();
+    const loco::ConvexPolygon::Point vertex = triangle.col(k) + margin/std::sin(std::acos(v1.dot(v2)))*(v1+v2);
+    EXPECT_NEAR(vertex.x(), safePolygon.getVertex(k).x(), 1e-12);
+    EXPECT_NEAR(vertex.y(), safePolygon.getVertex(k).y(), 1e-12);
+  }
+
+  loco::ConvexPolygon::EdgeValues distances;
+  safePolygon.getSignedDistancesToEdges(loco::ConvexPolygon::Point(0.0, 0.0), distances);
+  EXPECT_NEAR(-margin, distances.minCoeff(), 1e-12);
+
+  // margin larger than the inradius
+  EXPECT_FALSE(polygon.getInwardOffset(0.5, safePolygon));
+}
+
+
+TEST(ConvexPolygonTest, intersection) {
+  typedef loco::ConvexPolygon::Point Point;
+  Point intersection;
+  ASSERT_TRUE(loco::ConvexPolygon::intersectSegments(Point(0.0, 0.0), Point(1.0, 1.0), Point(0.0, 1.0), Point(1.0, 0.0), intersection));
+  EXPECT_NEAR(0.5, intersection.x(), 1e-12);
+  EXPECT_NEAR(0.5, intersection.y(), 1e-12);
+
+  EXPECT_FALSE(loco::ConvexPolygon::intersectSegments(Point(0.0, 0.0), Point(0.4, 0.4), Point(0.0, 1.0), Point(1.0, 0.0), intersection));
+  EXPECT_FALSE(loco::ConvexPolygon::intersectSegments(Point(0.0, 0.0), Point(1.0, 0.0), Point(0.0, 1.0), Point(1.0, 1.0), intersection));
+
+  double s, t;
+  ASSERT_TRUE(loco::ConvexPolygon::intersectLines(Point(0.0, 0.0), Point(0.4, 0.4), Point(0.0, 1.0), Point(1.0, 0.0), s, t));
+  EXPECT_NEAR(1.25, s, 1e-12);
+  EXPECT_NEAR(0.5, t, 1e-12);
+}
@@ -0,0 +1,161 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ParameterCacheTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/ParameterCache.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+//! Temporary parameter directory with one parameter file
+class ParameterCacheTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    char directory[] = "/tmp/ParameterCacheTestXXXXXX";
+    ASSERT_TRUE(mkdtemp(directory) != nullptr);
+    directory_ = directory;
+    parameterFile_ = directory_ + "/Walk.xml";
+    cacheFile_ = directory_ + "/" + loco::ParameterCache::defaultFileName;
+    writeFile(parameterFile_, "<LocomotionController><Gait stride=\"0.8\"/></LocomotionController>");
+    setModificationTime(parameterFile_, 1000);
+  }
+
+  virtual void TearDown() {
+    unlink(parameterFile_.c_str());
+    unlink(cacheFile_.c_str());
+    rmdir(directory_.c_str());
+  }
+
+  static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream stream(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    stream << content;
+  }
+
+  static void setModificationTime(const std::string& path, long nanoseconds) {
+    struct timespec times[2];
+    times[0].tv_sec = 1400000000;
+    times[0].tv_nsec = nanoseconds;
+    times[1] = times[0];
+    utimensat(AT_FDCWD, path.c_str(), times, 0);
+  }
+
+  static double getStride(const TiXmlDocument& document) {
+    double stride = 0.0;
+    TiXmlElement* element = TiXmlHandle(const_cast<TiXmlDocument*>(&document)).FirstChild("LocomotionController").FirstChild("Gait").Element();
+    if (element == nullptr || element->QueryDoubleAttribute("stride", &stride) != TIXML_SUCCESS) {
+      return -1.0;
+    }
+    return stride;
+  }
+
+  std::string directory_;
+  std::string parameterFile_;
+  std::string cacheFile_;
+};
+
+} // namespace
+
+
+TEST_F(ParameterCacheTest, cacheHit) {
+  loco::ParameterCache cache;
+  ASSERT_TRUE(cache.openOrRebuild(directory_, cacheFile_));
+  EXPECT_TRUE(cache.isUpToDate());
+
+  TiXmlDocument document;
+  ASSERT_TRUE(cache.loadXmlDocument(parameterFile_, &document));
+  EXPECT_DOUBLE_EQ(0.8, getStride(document));
+
+  // a file that is written again with the same content is still restored from the cache
+  writeFile(parameterFile_, "<LocomotionController><Gait stride=\"0.8\"/></LocomotionController>");
+  setModificationTime(parameterFile_, 2000);
+  EXPECT_TRUE(cache.isUpToDate());
+  EXPECT_TRUE(cache.loadXmlDocument(parameterFile_, &document));
+}
+
+TEST_F(ParameterCacheTest, staleDetection) {
+  loco::ParameterCache cache;
+  ASSERT_TRUE(cache.openOrRebuild(directory_, cacheFile_));
+
+  // same size and same whole second, only the nanoseconds of the modification time differ
+  writeFile(parameterFile_, "<LocomotionController><Gait stride=\"0.9\"/></LocomotionController>");
+  setModificationTime(parameterFile_, 2000);
+  EXPECT_FALSE(cache.isUpToDate());
+  TiXmlDocument document;
+  EXPECT_FALSE(cache.loadXmlDocument(parameterFile_, &document));
+
+  // the cache is recompiled from the modified file
+  ASSERT_TRUE(cache.openOrRebuild(directory_, cacheFile_));
+  ASSERT_TRUE(cache.loadXmlDocument(parameterFile_, &document));
+  EXPECT_DOUBLE_EQ(0.9, getStride(document));
+}
+
+TEST_F(ParameterCacheTest, corruptCache) {
+  ASSERT_TRUE(loco::ParameterCache::compileDirectory(directory_, cacheFile_));
+
+  // flip the last byte of the string table
+  {
+    std::fstream stream(cacheFile_.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    stream.seekg(-1, std::ios::end);
+    char byte = 0;
+    stream.get(byte);
+    stream.seekp(-1, std::ios::end);
+    stream.put(static_cast<char>(byte ^ 0x5a));
+  }
+
+  loco::ParameterCache cache;
+  EXPECT_FALSE(cache.open(directory_, cacheFile_));
+  EXPECT_FALSE(cache.isOpen());
+  TiXmlDocument document;
+  EXPECT_FALSE(cache.loadXmlDocument(parameterFile_, &document));
+
+  // a corrupt cache is rebuilt
+  ASSERT_TRUE(cache.openOrRebuild(directory_, cacheFile_));
+  ASSERT_TRUE(cache.loadXmlDocument(parameterFile_, &document));
+  EXPECT_DOUBLE_EQ(0.8, getStride(document));
+}
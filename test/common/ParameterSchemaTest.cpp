@@ -0,0 +1,113 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ParameterSchemaTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/ParameterSchema.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+struct Parameters {
+  Parameters() : gain_(0.0), offset_(0.0) {
+    weights_[0] = 0.0;
+    weights_[1] = 0.0;
+  }
+  double gain_;
+  double offset_;
+  double weights_[2];
+};
+
+loco::ParameterSchema<Parameters> createSchema() {
+  loco::ParameterSchema<Parameters> schema;
+  schema.add("Module/Gains", "gain", &Parameters::gain_);
+  schema.add("Module/Weights", "first", &Parameters::weights_, 0);
+  schema.add("Module/Weights", "second", &Parameters::weights_, 1);
+  schema.addOptional("Module/Offset", "value", &Parameters::offset_, 0.5);
+  return schema;
+}
+
+} // namespace
+
+
+TEST(ParameterSchemaTest, requiredAttributes) {
+  TiXmlDocument document;
+  document.Parse("<Module><Gains gain=\"2.0\"/><Weights first=\"3.0\" second=\"4.0\"/><Offset value=\"1.5\"/></Module>");
+  ASSERT_FALSE(document.Error());
+
+  loco::ParameterSchema<Parameters> schema = createSchema();
+  ASSERT_EQ(4u, schema.getEntries().size());
+  Parameters parameters;
+  ASSERT_TRUE(schema.parse(TiXmlHandle(&document), parameters));
+  EXPECT_DOUBLE_EQ(2.0, parameters.gain_);
+  EXPECT_DOUBLE_EQ(3.0, parameters.weights_[0]);
+  EXPECT_DOUBLE_EQ(4.0, parameters.weights_[1]);
+  EXPECT_DOUBLE_EQ(1.5, parameters.offset_);
+  EXPECT_DOUBLE_EQ(4.0, loco::ParameterSchema<Parameters>::getValue(parameters, schema.getEntries()[2]));
+}
+
+TEST(ParameterSchemaTest, missingRequiredAttribute) {
+  // the second weight is missing and the gain is malformed
+  TiXmlDocument document;
+  document.Parse("<Module><Gains gain=\"high\"/><Weights first=\"3.0\"/><Offset value=\"1.5\"/></Module>");
+  ASSERT_FALSE(document.Error());
+
+  loco::ParameterSchema<Parameters> schema = createSchema();
+  Parameters parameters;
+  parameters.gain_ = 7.0;
+  EXPECT_FALSE(schema.parse(TiXmlHandle(&document), parameters));
+
+  // the struct is left unchanged if the parsing fails
+  EXPECT_DOUBLE_EQ(7.0, parameters.gain_);
+  EXPECT_DOUBLE_EQ(0.0, parameters.weights_[0]);
+  EXPECT_DOUBLE_EQ(0.0, parameters.offset_);
+}
+
+TEST(ParameterSchemaTest, optionalAttribute) {
+  TiXmlDocument document;
+  document.Parse("<Module><Gains gain=\"2.0\"/><Weights first=\"3.0\" second=\"4.0\"/></Module>");
+  ASSERT_FALSE(document.Error());
+
+  loco::ParameterSchema<Parameters> schema = createSchema();
+  Parameters parameters;
+  parameters.offset_ = 7.0;
+  ASSERT_TRUE(schema.parse(TiXmlHandle(&document), parameters));
+  EXPECT_DOUBLE_EQ(2.0, parameters.gain_);
+  EXPECT_DOUBLE_EQ(0.5, parameters.offset_);
+}
@@ -0,0 +1,144 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ParameterVectorTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/ParameterVector.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+struct Module {
+  Module(double gain, double offset) : gain_(gain), offset_(offset), numberOfChanges_(0) { }
+  void addParametersToVector(loco::ParameterVector* parameterVector) {
+    std::vector<double*> parameters;
+    parameters.push_back(&gain_);
+    parameters.push_back(&offset_);
+    parameterVector->addSlice("Module", parameters, [this]() { numberOfChanges_++; });
+  }
+  double gain_;
+  double offset_;
+  int numberOfChanges_;
+};
+
+} // namespace
+
+
+TEST(ParameterVectorTest, interpolation) {
+  Module module1(1.0, 2.0), module2(3.0, 2.0), module(0.0, 0.0);
+  loco::ParameterVector parameterVector1, parameterVector2, parameterVector;
+  module1.addParametersToVector(&parameterVector1);
+  module2.addParametersToVector(&parameterVector2);
+  module.addParametersToVector(&parameterVector);
+  ASSERT_EQ(2, parameterVector.getSize());
+  ASSERT_TRUE(parameterVector.hasSameLayout(parameterVector1));
+
+  ASSERT_TRUE(parameterVector.setToInterpolated(parameterVector1, parameterVector2, 0.25));
+  EXPECT_DOUBLE_EQ(1.5, module.gain_);
+  EXPECT_DOUBLE_EQ(2.0, module.offset_);
+  EXPECT_EQ(1, module.numberOfChanges_);
+
+  // no notification if nothing changed
+  ASSERT_TRUE(parameterVector.setToInterpolated(parameterVector1, parameterVector2, 0.25));
+  EXPECT_EQ(1, module.numberOfChanges_);
+
+  ASSERT_TRUE(parameterVector.setToInterpolated(parameterVector1, parameterVector2, 1.0));
+  EXPECT_DOUBLE_EQ(3.0, module.gain_);
+  EXPECT_EQ(2, module.numberOfChanges_);
+}
+
+TEST(ParameterVectorTest, differentLayouts) {
+  Module module1(1.0, 2.0), module(0.0, 0.0);
+  loco::ParameterVector parameterVector1, parameterVector;
+  module1.addParametersToVector(&parameterVector1);
+  module.addParametersToVector(&parameterVector);
+  double extra = 0.0;
+  parameterVector.addSlice("Extra", std::vector<double*>(1, &extra));
+
+  EXPECT_FALSE(parameterVector.setToInterpolated(parameterVector1, parameterVector1, 0.5));
+  EXPECT_DOUBLE_EQ(0.0, module.gain_);
+}
+
+TEST(ParameterVectorTest, detachedSource) {
+  loco::ParameterVector parameterVector1;
+  {
+    Module module1(1.0, 2.0);
+    module1.addParametersToVector(&parameterVector1);
+    parameterVector1.detachFromModules();
+  }
+  EXPECT_FALSE(parameterVector1.isAttachedToModules());
+  parameterVector1.readFromModules();
+  parameterVector1.writeToModules();
+
+  Module module(0.0, 0.0);
+  loco::ParameterVector parameterVector;
+  module.addParametersToVector(&parameterVector);
+  ASSERT_TRUE(parameterVector.setToInterpolated(parameterVector1, parameterVector1, 0.5));
+  EXPECT_DOUBLE_EQ(1.0, module.gain_);
+  EXPECT_DOUBLE_EQ(2.0, module.offset_);
+}
+
+TEST(ParameterVectorTest, reallocatedSlice) {
+  Module module(1.0, 2.0);
+  loco::ParameterVector parameterVector;
+  std::vector<double> phases(1, 0.5);
+  parameterVector.addSlice("Phases", std::vector<double*>(1, &phases[0]));
+  module.addParametersToVector(&parameterVector);
+
+  // the module appends a parameter, which moves its parameters
+  phases.push_back(0.75);
+  std::vector<double*> parameters;
+  parameters.push_back(&phases[0]);
+  parameters.push_back(&phases[1]);
+  ASSERT_TRUE(parameterVector.setSliceParameters("Phases", parameters));
+  EXPECT_FALSE(parameterVector.setSliceParameters("Unknown", parameters));
+  ASSERT_EQ(4, parameterVector.getSize());
+  EXPECT_EQ(2, parameterVector.getSliceSize(0));
+  EXPECT_EQ(2, parameterVector.getSliceOffset(1));
+  EXPECT_DOUBLE_EQ(0.75, parameterVector.getValues()(1));
+  EXPECT_DOUBLE_EQ(1.0, parameterVector.getValues()(2));
+
+  Eigen::VectorXd values(4);
+  values << 0.25, 0.5, 3.0, 4.0;
+  ASSERT_TRUE(parameterVector.setValues(values));
+  EXPECT_DOUBLE_EQ(0.25, phases[0]);
+  EXPECT_DOUBLE_EQ(0.5, phases[1]);
+  EXPECT_DOUBLE_EQ(3.0, module.gain_);
+  EXPECT_DOUBLE_EQ(4.0, module.offset_);
+}
@@ -0,0 +1,108 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     RegionHashTableTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/RegionHashTable.hpp"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+
+TEST(RegionHashTableTest, insertFindErase) {
+  loco::RegionHashTable table(3);
+  EXPECT_EQ(-1, table.find(7));
+  const int slot = table.insert(7);
+  ASSERT_GE(slot, 0);
+  EXPECT_EQ(slot, table.insert(7));
+  EXPECT_EQ(slot, table.find(7));
+  EXPECT_EQ(7, table.getKey(slot));
+  EXPECT_TRUE(table.isUsed(slot));
+  EXPECT_GE(table.insert(-7), 0);
+  EXPECT_GE(table.insert(int64_t(1) << 40), 0);
+  EXPECT_EQ(-1, table.insert(8));
+  EXPECT_EQ(3, table.size());
+
+  EXPECT_TRUE(table.erase(7));
+  EXPECT_FALSE(table.erase(7));
+  EXPECT_FALSE(table.isUsed(slot));
+  EXPECT_EQ(-1, table.find(7));
+  EXPECT_EQ(slot, table.insert(8));
+
+  table.clear();
+  EXPECT_EQ(0, table.size());
+  EXPECT_EQ(-1, table.find(8));
+}
+
+
+TEST(RegionHashTableTest, randomOperations) {
+  // Keys of neighboring regions collide frequently in a small table
+  const int capacity = 16;
+  loco::RegionHashTable table(capacity);
+  std::map<int64_t, int> reference;
+  std::minstd_rand randomNumberGenerator;
+  std::uniform_int_distribution<int> indexDistribution(-4, 4);
+  for (int iteration = 0; iteration < 10000; iteration++) {
+    const int64_t key = (static_cast<int64_t>(indexDistribution(randomNumberGenerator)) << 32)
+                        ^ (static_cast<int64_t>(indexDistribution(randomNumberGenerator)) & 0xffffffff);
+    if (iteration % 3 == 0) {
+      EXPECT_EQ(reference.erase(key) == 1, table.erase(key));
+    }
+    else {
+      const int slot = table.insert(key);
+      if (reference.count(key) == 1) {
+        EXPECT_EQ(reference[key], slot);
+      }
+      else if (static_cast<int>(reference.size()) < capacity) {
+        ASSERT_GE(slot, 0);
+        ASSERT_LT(slot, capacity);
+        reference[key] = slot;
+      }
+      else {
+        EXPECT_EQ(-1, slot);
+      }
+    }
+
+    ASSERT_EQ(static_cast<int>(reference.size()), table.size());
+    for (const auto& entry : reference) {
+      ASSERT_EQ(entry.second, table.find(entry.first));
+    }
+  }
+}
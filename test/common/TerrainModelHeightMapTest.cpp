@@ -0,0 +1,178 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     TerrainModelHeightMapTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/TerrainModelHeightMap.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+
+TEST(TerrainModelHeightMapTest, slope) {
+  loco::TerrainModelHeightMap terrain(0.05, 4, 4);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  for (double x = -1.6; x < 1.6; x += 0.05) {
+    for (double y = -1.6; y < 1.6; y += 0.05) {
+      terrain.setHeight(loco::Position(x, y, 0.0), 0.5*x);
+    }
+  }
+
+  double height;
+  loco::Vector normal;
+  for (int method = 0; method < 2; method++) {
+    terrain.setInterpolationMethod(static_cast<loco::TerrainModelHeightMap::InterpolationMethod>(method));
+    ASSERT_TRUE(terrain.getHeight(loco::Position(0.33, -0.21, 1.0), height));
+    EXPECT_NEAR(0.165, height, 1.0e-6);
+  }
+  ASSERT_TRUE(terrain.getNormal(loco::Position(0.33, -0.21, 1.0), normal));
+  EXPECT_NEAR(-0.5/sqrt(1.25), normal.x(), 1.0e-6);
+  EXPECT_NEAR(0.0, normal.y(), 1.0e-6);
+  EXPECT_NEAR(1.0/sqrt(1.25), normal.z(), 1.0e-6);
+  EXPECT_NEAR(1.0/sqrt(1.25), terrain.getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(loco::Position(0.0, 0.0, 1.0)), 1.0e-6);
+  EXPECT_FALSE(terrain.getHeight(loco::Position(2.0, 0.0, 0.0), height));
+}
+
+
+TEST(TerrainModelHeightMapTest, moveAndFootholds) {
+  loco::TerrainModelHeightMap terrain(0.05, 4, 4);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  terrain.setFootholdUpdateParameters(0.03, 1.0);
+  ASSERT_TRUE(terrain.addFootholdMeasurement(loco::Position(0.5, 0.5, 0.2)));
+
+  double height;
+  ASSERT_TRUE(terrain.getHeight(loco::Position(0.5, 0.5, 0.0), height));
+  EXPECT_NEAR(0.2, height, 1.0e-6);
+
+  // The foothold stays in the map when moving by less than a tile
+  terrain.moveTo(loco::Position(0.5, 0.0, 0.0));
+  ASSERT_TRUE(terrain.getHeight(loco::Position(0.5, 0.5, 0.0), height));
+  EXPECT_NEAR(0.2, height, 1.0e-6);
+
+  // The foothold leaves the map and comes back as flat ground
+  terrain.moveTo(loco::Position(10.0, 0.0, 0.0));
+  EXPECT_FALSE(terrain.isInside(loco::Position(0.5, 0.5, 0.0)));
+  terrain.moveTo(loco::Position(0.0, 0.0, 0.0));
+  ASSERT_TRUE(terrain.getHeight(loco::Position(0.5, 0.5, 0.0), height));
+  EXPECT_NEAR(0.0, height, 1.0e-6);
+}
+
+TEST(TerrainModelHeightMapTest, moveUpdatesNormalsAtBoundary) {
+  // The map spans 4x4 tiles of 16 cells, moving the center to x = 0.9 shifts it by one tile
+  loco::TerrainModelHeightMap terrain(0.05, 4, 4);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  for (int i = -32; i < 32; i++) {
+    for (int j = -32; j < 32; j++) {
+      terrain.setHeight(loco::Position(i*0.05, j*0.05, 0.0), 0.5*i*0.05);
+    }
+  }
+  terrain.moveTo(loco::Position(0.9, 0.0, 0.0));
+
+  // Reference with the heights of the kept tiles and all normals computed from scratch
+  loco::TerrainModelHeightMap reference(0.05, 4, 4);
+  ASSERT_TRUE(reference.initialize(0.0025));
+  reference.moveTo(loco::Position(0.9, 0.0, 0.0));
+  for (int i = -16; i < 32; i++) {
+    for (int j = -32; j < 32; j++) {
+      reference.setHeight(loco::Position(i*0.05, j*0.05, 0.0), 0.5*i*0.05);
+    }
+  }
+
+  loco::Vector normal, referenceNormal;
+  for (int i = -16; i < 48; i++) {
+    for (int j = -32; j < 32; j++) {
+      const loco::Position position(i*0.05, j*0.05, 0.0);
+      ASSERT_TRUE(terrain.getNormal(position, normal));
+      ASSERT_TRUE(reference.getNormal(position, referenceNormal));
+      EXPECT_NEAR(referenceNormal.x(), normal.x(), 1.0e-9);
+      EXPECT_NEAR(referenceNormal.y(), normal.y(), 1.0e-9);
+      EXPECT_NEAR(referenceNormal.z(), normal.z(), 1.0e-9);
+    }
+  }
+}
+
+
+TEST(TerrainModelHeightMapTest, file) {
+  loco::TerrainModelHeightMap terrain(0.05, 2, 2);
+  terrain.setHeight(loco::Position(0.1, 0.2, 0.0), 0.3);
+  terrain.setFrictionCoefficient(loco::Position(0.1, 0.2, 0.0), 0.9);
+  const std::string filename = "TerrainModelHeightMapTest.map";
+  ASSERT_TRUE(terrain.saveToFile(filename));
+
+  loco::TerrainModelHeightMap loadedTerrain(0.02, 8, 8);
+  ASSERT_TRUE(loadedTerrain.loadFromFile(filename));
+  std::remove(filename.c_str());
+  EXPECT_EQ(0.05, loadedTerrain.getResolution());
+  EXPECT_EQ(terrain.getNumberOfCellsX(), loadedTerrain.getNumberOfCellsX());
+
+  double height, frictionCoefficient;
+  ASSERT_TRUE(loadedTerrain.getHeight(loco::Position(0.1, 0.2, 0.0), height));
+  EXPECT_NEAR(0.3, height, 1.0e-6);
+  ASSERT_TRUE(loadedTerrain.getFrictionCoefficientForFoot(loco::Position(0.1, 0.2, 0.0), frictionCoefficient));
+  EXPECT_NEAR(0.9, frictionCoefficient, 1.0e-6);
+}
+
+
+TEST(TerrainModelHeightMapTest, batchQueries) {
+  loco::TerrainModelHeightMap terrain(0.05, 4, 4);
+  terrain.setInterpolationMethod(loco::TerrainModelHeightMap::InterpolationBicubic);
+  terrain.setFootholdUpdateParameters(0.1, 1.0);
+  terrain.addFootholdMeasurement(loco::Position(0.2, 0.1, 0.1));
+
+  std::vector<loco::Position> positions;
+  positions.push_back(loco::Position(0.25, 0.12, 0.5));
+  positions.push_back(loco::Position(-0.3, 0.4, 0.5));
+  std::vector<double> heights;
+  std::vector<loco::Vector> normals;
+  std::vector<loco::Position> projectedPositions;
+  ASSERT_TRUE(terrain.getHeights(positions, heights));
+  ASSERT_TRUE(terrain.getNormals(positions, normals));
+  ASSERT_TRUE(terrain.getPositionsProjectedOnPlaneAlongSurfaceNormalInWorldFrame(positions, projectedPositions));
+  ASSERT_EQ(positions.size(), heights.size());
+
+  for (size_t i = 0; i < positions.size(); i++) {
+    double height;
+    loco::Vector normal;
+    terrain.getHeight(positions[i], height);
+    terrain.getNormal(positions[i], normal);
+    EXPECT_EQ(height, heights[i]);
+    EXPECT_TRUE(normal.toImplementation().isApprox(normals[i].toImplementation()));
+    EXPECT_TRUE(terrain.getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(positions[i]).toImplementation().isApprox(projectedPositions[i].toImplementation()));
+  }
+}
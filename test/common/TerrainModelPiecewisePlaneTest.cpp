@@ -0,0 +1,124 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     TerrainModelPiecewisePlaneTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/common/TerrainModelPiecewisePlane.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+
+TEST(TerrainModelPiecewisePlaneTest, localPlanes) {
+  loco::TerrainModelPiecewisePlane terrain(0.3);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  ASSERT_TRUE(terrain.setPlane(0, 0, Eigen::Vector3d(0.1, 0.0, 0.2)));
+  ASSERT_TRUE(terrain.setPlane(2, 0, Eigen::Vector3d(0.0, 0.0, 0.5)));
+  EXPECT_EQ(2, terrain.getNumberOfPlanes());
+
+  double height;
+  loco::Vector normal;
+  EXPECT_TRUE(terrain.getHeight(loco::Position(0.1, 0.1, 1.0), height));
+  EXPECT_NEAR(0.19, height, 1.0e-9);
+  EXPECT_TRUE(terrain.getNormal(loco::Position(0.1, 0.1, 1.0), normal));
+  EXPECT_NEAR(0.1/std::sqrt(1.01), normal.x(), 1.0e-9);
+  EXPECT_NEAR(0.0, normal.y(), 1.0e-9);
+  EXPECT_NEAR(1.0/std::sqrt(1.01), normal.z(), 1.0e-9);
+
+  // A region without plane uses the plane of the closest neighboring region
+  EXPECT_TRUE(terrain.getHeight(loco::Position(0.35, 0.1, 1.0), height));
+  EXPECT_NEAR(0.2 - 0.1*0.35, height, 1.0e-9);
+  EXPECT_TRUE(terrain.getHeight(loco::Position(0.55, 0.1, 1.0), height));
+  EXPECT_NEAR(0.5, height, 1.0e-9);
+
+  // Far from all local planes the default plane is used
+  EXPECT_FALSE(terrain.getHeight(loco::Position(5.0, 5.0, 1.0), height));
+  EXPECT_NEAR(0.0, height, 1.0e-9);
+  terrain.setDefaultPlane(Eigen::Vector3d(0.0, 0.0, 0.3));
+  EXPECT_FALSE(terrain.getHeight(loco::Position(5.0, 5.0, 1.0), height));
+  EXPECT_NEAR(0.3, height, 1.0e-9);
+
+  // Regions with negative indices
+  ASSERT_TRUE(terrain.setPlane(-1, -1, Eigen::Vector3d(0.0, 0.0, -0.1)));
+  EXPECT_TRUE(terrain.getHeight(loco::Position(-0.1, -0.1, 1.0), height));
+  EXPECT_NEAR(-0.1, height, 1.0e-9);
+
+  terrain.removePlane(2, 0);
+  EXPECT_EQ(2, terrain.getNumberOfPlanes());
+  EXPECT_TRUE(terrain.getHeight(loco::Position(0.55, 0.1, 1.0), height));
+  EXPECT_NEAR(0.2 - 0.1*0.55, height, 1.0e-9);
+
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  EXPECT_EQ(0, terrain.getNumberOfPlanes());
+}
+
+
+TEST(TerrainModelPiecewisePlaneTest, projection) {
+  loco::TerrainModelPiecewisePlane terrain(0.3);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  ASSERT_TRUE(terrain.setPlane(0, 0, Eigen::Vector3d(0.5, 0.0, 0.0)));
+
+  const loco::Position position(0.1, 0.1, 1.0);
+  const loco::Position projection = terrain.getPositionProjectedOnPlaneAlongSurfaceNormalInWorldFrame(position);
+  EXPECT_NEAR(-0.5*projection.x(), projection.z(), 1.0e-9);
+  EXPECT_NEAR((1.0 + 0.5*0.1)/std::sqrt(1.25), terrain.getDistanceFromSurfaceAlongSurfaceNormalToPositionInWorldFrame(position), 1.0e-9);
+}
+
+
+TEST(TerrainModelPiecewisePlaneTest, maximumNumberOfPlanes) {
+  loco::TerrainModelPiecewisePlane terrain(0.3, 2);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  EXPECT_EQ(2, terrain.getMaximumNumberOfPlanes());
+  EXPECT_TRUE(terrain.setPlane(0, 0, Eigen::Vector3d(0.0, 0.0, 0.1)));
+  EXPECT_TRUE(terrain.setPlane(5, 0, Eigen::Vector3d(0.0, 0.0, 0.2)));
+  EXPECT_FALSE(terrain.setPlane(10, 0, Eigen::Vector3d(0.0, 0.0, 0.3)));
+
+  // Updating an existing plane and reusing the slot of a removed plane
+  EXPECT_TRUE(terrain.setPlane(0, 0, Eigen::Vector3d(0.0, 0.0, 0.4)));
+  terrain.removePlane(5, 0);
+  EXPECT_TRUE(terrain.setPlane(10, 0, Eigen::Vector3d(0.0, 0.0, 0.3)));
+  EXPECT_EQ(2, terrain.getNumberOfPlanes());
+
+  double height;
+  EXPECT_TRUE(terrain.getHeight(loco::Position(0.1, 0.1, 0.0), height));
+  EXPECT_NEAR(0.4, height, 1.0e-9);
+  EXPECT_TRUE(terrain.getHeight(loco::Position(3.1, 0.1, 0.0), height));
+  EXPECT_NEAR(0.3, height, 1.0e-9);
+  EXPECT_FALSE(terrain.getHeight(loco::Position(1.6, 0.1, 0.0), height));
+}
@@ -0,0 +1,182 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootPlacementStrategyStaticGaitTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/foot_placement_strategy/FootPlacementStrategyStaticGait.hpp"
+#include "loco/com_over_support_polygon/CoMOverSupportPolygonControlStaticGait.hpp"
+
+#include "loco/common/LegStarlETH.hpp"
+#include "loco/common/TorsoStarlETH.hpp"
+#include "loco/common/TerrainModelHeightMap.hpp"
+
+#include "RobotModel.hpp"
+
+#include <cmath>
+
+
+/* exposes the planning and validation steps of advance() */
+class FootPlacementStrategyStaticGaitTestable: public loco::FootPlacementStrategyStaticGait {
+ public:
+  FootPlacementStrategyStaticGaitTestable(loco::LegGroup* legs, loco::TorsoBase* torso, loco::TerrainModelBase* terrain):
+    loco::FootPlacementStrategyStaticGait(legs, torso, terrain) {
+
+  }
+  using loco::FootPlacementStrategyStaticGait::generateFootHold;
+  using loco::FootPlacementStrategyStaticGait::planFootHold;
+  using loco::FootPlacementStrategyStaticGait::updateFootHoldValidation;
+};
+
+/* validator that never responds, e.g. a service that is down */
+class SilentFootholdValidator: public loco::FootholdValidatorBase {
+ protected:
+  virtual bool validateFoothold(const loco::FootholdValidationRequest& /*request*/, loco::FootholdValidationResponse& /*response*/) {
+    return false;
+  }
+};
+
+static void expectNear(const loco::Position& expected, const loco::Position& actual, double tolerance) {
+  EXPECT_NEAR(expected.x(), actual.x(), tolerance);
+  EXPECT_NEAR(expected.y(), actual.y(), tolerance);
+  EXPECT_NEAR(expected.z(), actual.z(), tolerance);
+}
+
+
+class FootPlacementStrategyStaticGaitTest: public ::testing::Test {
+ protected:
+  FootPlacementStrategyStaticGaitTest():
+    leftForeLeg_("leftFore", 0, &robotModel_),
+    rightForeLeg_("rightFore", 1, &robotModel_),
+    leftHindLeg_("leftHind", 2, &robotModel_),
+    rightHindLeg_("rightHind", 3, &robotModel_),
+    torso_(&robotModel_),
+    terrain_(0.01, 8, 8),
+    comControl_(&legs_, &torso_),
+    footPlacementStrategy_(&legs_, &torso_, &terrain_)
+  {
+    legs_.addLeg(&leftForeLeg_);
+    legs_.addLeg(&rightForeLeg_);
+    legs_.addLeg(&leftHindLeg_);
+    legs_.addLeg(&rightHindLeg_);
+  }
+
+  virtual void SetUp() {
+    const double dt = 0.0025;
+    robotModel_.init();
+    robotModel_.update();
+    ASSERT_TRUE(terrain_.initialize(dt));
+    footPlacementStrategy_.setCoMControl(&comControl_);
+    ASSERT_TRUE(footPlacementStrategy_.initialize(dt));
+  }
+
+  robotModel::RobotModel robotModel_;
+  loco::LegGroup legs_;
+  loco::LegStarlETH leftForeLeg_;
+  loco::LegStarlETH rightForeLeg_;
+  loco::LegStarlETH leftHindLeg_;
+  loco::LegStarlETH rightHindLeg_;
+  loco::TorsoStarlETH torso_;
+  loco::TerrainModelHeightMap terrain_;
+  loco::CoMOverSupportPolygonControlStaticGait comControl_;
+  FootPlacementStrategyStaticGaitTestable footPlacementStrategy_;
+};
+
+
+TEST_F(FootPlacementStrategyStaticGaitTest, validatedFootholdIsPassedToCoMControl) {
+  // put a step edge 5mm in front of the nominal foothold of the left fore leg
+  const loco::Position nominal = footPlacementStrategy_.generateFootHold(&leftForeLeg_);
+  ASSERT_TRUE(terrain_.isInside(nominal));
+  const double edgeX = nominal.x() + 0.005;
+  for (double x = nominal.x()-0.2; x < nominal.x()+0.2; x += 0.01) {
+    for (double y = nominal.y()-0.2; y < nominal.y()+0.2; y += 0.01) {
+      terrain_.setHeight(loco::Position(x, y, 0.0), (x >= edgeX) ? 0.1 : 0.0);
+    }
+  }
+
+  const loco::Position previousFoothold(1.0, 2.0, 3.0);
+  comControl_.setFootHold(0, previousFoothold);
+  footPlacementStrategy_.setUseFootholdValidation(true);
+  footPlacementStrategy_.planFootHold(&leftForeLeg_);
+
+  // the CoM control does not plan with the unvalidated foothold
+  expectNear(previousFoothold, comControl_.getFootHold(0), 0.0);
+
+  // no worker thread: the request is validated on the control thread
+  leftHindLeg_.setSwingPhase(0.1);
+  footPlacementStrategy_.updateFootHoldValidation(leftHindLeg_);
+
+  const loco::Position validated = comControl_.getFootHold(0);
+  expectNear(footPlacementStrategy_.getPositionWorldToValidatedDesiredFootHoldInWorldFrame(0), validated, 1.0e-12);
+  EXPECT_GT(std::fabs(validated.x()-edgeX), 0.03);
+  EXPECT_NEAR((validated.x() >= edgeX) ? 0.1 : 0.0, validated.z(), 1.0e-6);
+  const double distance = std::sqrt(std::pow(validated.x()-nominal.x(), 2) + std::pow(validated.y()-nominal.y(), 2));
+  EXPECT_LE(distance, 0.1+1.0e-9);
+}
+
+
+TEST_F(FootPlacementStrategyStaticGaitTest, generatedFootholdIsUsedWithoutResponse) {
+  const loco::Position previousFoothold(1.0, 2.0, 3.0);
+
+  // without validation, the generated foothold is passed on immediately
+  comControl_.setFootHold(0, previousFoothold);
+  footPlacementStrategy_.setUseFootholdValidation(false);
+  footPlacementStrategy_.planFootHold(&leftForeLeg_);
+  const loco::Position generated = footPlacementStrategy_.getPositionWorldToValidatedDesiredFootHoldInWorldFrame(0);
+  expectNear(generated, comControl_.getFootHold(0), 0.0);
+
+  SilentFootholdValidator validator;
+  footPlacementStrategy_.setFootholdValidator(&validator);
+  footPlacementStrategy_.setUseFootholdValidation(true);
+  comControl_.setFootHold(0, previousFoothold);
+  footPlacementStrategy_.planFootHold(&leftForeLeg_);
+
+  leftHindLeg_.setSwingPhase(0.5);
+  footPlacementStrategy_.updateFootHoldValidation(leftHindLeg_);
+  expectNear(previousFoothold, comControl_.getFootHold(0), 0.0);
+
+  // the response is too late, the generated foothold is used
+  leftHindLeg_.setSwingPhase(0.85);
+  footPlacementStrategy_.updateFootHoldValidation(leftHindLeg_);
+  expectNear(generated, comControl_.getFootHold(0), 1.0e-12);
+
+  // restores the validator against the terrain model
+  footPlacementStrategy_.setFootholdValidator(nullptr);
+  EXPECT_NE(static_cast<loco::FootholdValidatorBase*>(&validator), footPlacementStrategy_.getFootholdValidator());
+}
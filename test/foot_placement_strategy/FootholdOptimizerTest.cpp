@@ -0,0 +1,147 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdOptimizerTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/foot_placement_strategy/FootholdOptimizer.hpp"
+#include "loco/common/TerrainModelHeightMap.hpp"
+
+#include <cmath>
+#include <vector>
+
+
+/* flat terrain with a step of 0.1m at x=0 */
+static void setStep(loco::TerrainModelHeightMap& terrain) {
+  for (double x = -0.6; x < 0.6; x += 0.01) {
+    for (double y = -0.6; y < 0.6; y += 0.01) {
+      terrain.setHeight(loco::Position(x, y, 0.0), (x >= 0.0) ? 0.1 : 0.0);
+    }
+  }
+}
+
+
+static loco::FootholdOptimizationProblem getProblem(double x, double y) {
+  loco::FootholdOptimizationProblem problem;
+  problem.positionWorldToNominalFootholdInWorldFrame_ = loco::Position(x, y, 0.0);
+  problem.positionWorldToHipInWorldFrame_ = loco::Position(x, y, 0.45);
+  return problem;
+}
+
+
+TEST(FootholdOptimizerTest, stepEdge) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setStep(terrain);
+  loco::FootholdOptimizer optimizer(&terrain);
+  optimizer.setTimeBudget(1.0);
+  EXPECT_EQ(121, optimizer.getNumberOfCandidates());
+
+  // the foothold is moved away from the edge
+  loco::FootholdOptimizationResult result;
+  ASSERT_TRUE(optimizer.optimize(getProblem(0.005, 0.1), result));
+  EXPECT_EQ(121, result.numberOfEvaluatedCandidates_);
+  const loco::Position& foothold = result.positionWorldToFootholdInWorldFrame_;
+  EXPECT_GE(std::fabs(foothold.x()), 0.03);
+  EXPECT_LE(std::fabs(foothold.x()-0.005), 0.1+1.0e-9);
+  EXPECT_NEAR((foothold.x() >= 0.0) ? 0.1 : 0.0, foothold.z(), 1.0e-6);
+
+  // a foothold on flat ground is not changed
+  ASSERT_TRUE(optimizer.optimize(getProblem(0.3, -0.2), result));
+  EXPECT_NEAR(0.3, result.positionWorldToFootholdInWorldFrame_.x(), 1.0e-12);
+  EXPECT_NEAR(-0.2, result.positionWorldToFootholdInWorldFrame_.y(), 1.0e-12);
+  EXPECT_NEAR(0.1, result.positionWorldToFootholdInWorldFrame_.z(), 1.0e-6);
+
+  // no candidate is inside the map, the nominal foothold is returned
+  EXPECT_FALSE(optimizer.optimize(getProblem(5.0, 0.0), result));
+  EXPECT_FALSE(result.isFeasible_);
+  EXPECT_NEAR(5.0, result.positionWorldToFootholdInWorldFrame_.x(), 1.0e-12);
+}
+
+
+TEST(FootholdOptimizerTest, supportMargin) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  loco::FootholdOptimizer optimizer(&terrain);
+  optimizer.setTimeBudget(1.0);
+  optimizer.setWeights(1.0, 0.0, 0.0, 0.0, 0.08, 0.0, 10.0, 0.05, 0.0);
+
+  // the center of mass is close to the border of the support polygon, the foothold is moved outwards
+  loco::FootholdOptimizationProblem problem = getProblem(0.0, 0.1);
+  problem.positionWorldToSupportFeetInWorldFrame_[0] = loco::Position(0.2, -0.2, 0.0);
+  problem.positionWorldToSupportFeetInWorldFrame_[1] = loco::Position(-0.2, -0.2, 0.0);
+  problem.positionWorldToSupportFeetInWorldFrame_[2] = loco::Position(-0.2, 0.2, 0.0);
+  problem.numberOfSupportFeet_ = 3;
+  problem.positionWorldToCenterOfMassInWorldFrame_ = loco::Position(0.02, 0.02, 0.5);
+  loco::FootholdOptimizationResult result;
+  ASSERT_TRUE(optimizer.optimize(problem, result));
+  EXPECT_GT(result.positionWorldToFootholdInWorldFrame_.x()+result.positionWorldToFootholdInWorldFrame_.y(), 0.12);
+}
+
+
+TEST(FootholdOptimizerTest, parallelLegs) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setStep(terrain);
+  loco::FootholdOptimizer serialOptimizer(&terrain);
+  serialOptimizer.setTimeBudget(1.0);
+  loco::FootholdOptimizer parallelOptimizer(&terrain);
+  parallelOptimizer.setTimeBudget(1.0);
+  parallelOptimizer.setNumberOfThreads(3);
+  EXPECT_EQ(3, parallelOptimizer.getNumberOfThreads());
+
+  std::vector<loco::FootholdOptimizationProblem> problems;
+  problems.push_back(getProblem(0.005, 0.1));
+  problems.push_back(getProblem(-0.01, -0.1));
+  problems.push_back(getProblem(0.3, 0.3));
+  problems.push_back(getProblem(-0.3, -0.3));
+
+  std::vector<loco::FootholdOptimizationResult> serialResults;
+  std::vector<loco::FootholdOptimizationResult> parallelResults;
+  for (int k=0; k<50; k++) {
+    ASSERT_TRUE(serialOptimizer.optimize(problems, serialResults));
+    ASSERT_TRUE(parallelOptimizer.optimize(problems, parallelResults));
+    ASSERT_EQ(problems.size(), parallelResults.size());
+    for (int i=0; i<(int)problems.size(); i++) {
+      EXPECT_EQ(serialResults[i].positionWorldToFootholdInWorldFrame_.x(), parallelResults[i].positionWorldToFootholdInWorldFrame_.x());
+      EXPECT_EQ(serialResults[i].positionWorldToFootholdInWorldFrame_.y(), parallelResults[i].positionWorldToFootholdInWorldFrame_.y());
+      EXPECT_EQ(serialResults[i].cost_, parallelResults[i].cost_);
+    }
+  }
+}
@@ -0,0 +1,163 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootholdValidatorTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/foot_placement_strategy/FootholdValidatorTerrainModel.hpp"
+#include "loco/common/TerrainModelHeightMap.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+
+/* flat terrain with a step of 0.1m at x=0 */
+static void setStep(loco::TerrainModelHeightMap& terrain) {
+  for (double x = -0.6; x < 0.6; x += 0.01) {
+    for (double y = -0.6; y < 0.6; y += 0.01) {
+      terrain.setHeight(loco::Position(x, y, 0.0), (x >= 0.0) ? 0.1 : 0.0);
+    }
+  }
+}
+
+
+TEST(FootholdValidatorTest, stepEdge) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setStep(terrain);
+  loco::FootholdValidatorTerrainModel validator(&terrain);
+
+  loco::FootholdValidationRequest request;
+  request.legId_ = 2;
+  request.stepNumber_ = 7;
+  request.positionWorldToDesiredFootHoldInWorldFrame_ = loco::Position(0.005, 0.1, 0.0);
+  ASSERT_TRUE(validator.sendRequest(request));
+
+  loco::FootholdValidationResponse response;
+  EXPECT_FALSE(validator.receiveResponse(response));
+  EXPECT_EQ(1, validator.processRequests());
+  ASSERT_TRUE(validator.receiveResponse(response));
+  EXPECT_EQ(2, response.legId_);
+  EXPECT_EQ(7, response.stepNumber_);
+  EXPECT_EQ(loco::FootholdVerified, response.flag_);
+
+  // the foothold is moved away from the edge onto flat ground
+  const loco::Position& validated = response.positionWorldToValidatedFootHoldInWorldFrame_;
+  EXPECT_GT(std::fabs(validated.x()), 0.03);
+  const double distance = std::sqrt(std::pow(validated.x()-0.005, 2) + std::pow(validated.y()-0.1, 2));
+  EXPECT_LE(distance, 0.1+1.0e-9);
+  EXPECT_NEAR((validated.x() >= 0.0) ? 0.1 : 0.0, validated.z(), 1.0e-6);
+
+  // a foothold on flat ground is not changed
+  request.positionWorldToDesiredFootHoldInWorldFrame_ = loco::Position(0.3, -0.2, 0.0);
+  ASSERT_TRUE(validator.sendRequest(request));
+  validator.processRequests();
+  ASSERT_TRUE(validator.receiveResponse(response));
+  EXPECT_EQ(loco::FootholdVerified, response.flag_);
+  EXPECT_NEAR(0.3, response.positionWorldToValidatedFootHoldInWorldFrame_.x(), 1.0e-12);
+  EXPECT_NEAR(-0.2, response.positionWorldToValidatedFootHoldInWorldFrame_.y(), 1.0e-12);
+  EXPECT_NEAR(0.1, response.positionWorldToValidatedFootHoldInWorldFrame_.z(), 1.0e-6);
+
+  // no candidate is inside the map
+  request.positionWorldToDesiredFootHoldInWorldFrame_ = loco::Position(5.0, 0.0, 0.0);
+  ASSERT_TRUE(validator.sendRequest(request));
+  validator.processRequests();
+  ASSERT_TRUE(validator.receiveResponse(response));
+  EXPECT_EQ(loco::FootholdBad, response.flag_);
+}
+
+
+TEST(FootholdValidatorTest, workerThread) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setStep(terrain);
+  loco::FootholdValidatorTerrainModel validator(&terrain);
+  ASSERT_TRUE(validator.start());
+  EXPECT_EQ(-1, validator.processRequests());
+
+  const int nSteps = 20;
+  int nReceived = 0;
+  loco::FootholdValidationResponse response;
+  for (int k=0; k<nSteps; k++) {
+    loco::FootholdValidationRequest request;
+    request.legId_ = k%4;
+    request.stepNumber_ = k;
+    request.positionWorldToDesiredFootHoldInWorldFrame_ = loco::Position(-0.2+0.02*k, 0.0, 0.0);
+    ASSERT_TRUE(validator.sendRequest(request));
+
+    // poll like the control loop until the response arrives
+    for (int i=0; i<4000 && !validator.receiveResponse(response); i++) {
+      std::this_thread::sleep_for(std::chrono::microseconds(250));
+    }
+    ASSERT_EQ(k, response.stepNumber_);
+    EXPECT_EQ(k%4, response.legId_);
+    EXPECT_EQ(loco::FootholdVerified, response.flag_);
+    nReceived++;
+  }
+  validator.stop();
+  EXPECT_EQ(nSteps, nReceived);
+  EXPECT_FALSE(validator.isRunning());
+}
+
+
+TEST(FootholdValidatorTest, terrainSnapshot) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setStep(terrain);
+  loco::FootholdValidatorTerrainModel validator(&terrain);
+
+  loco::FootholdValidationRequest request;
+  request.legId_ = 0;
+  request.stepNumber_ = 1;
+  request.positionWorldToDesiredFootHoldInWorldFrame_ = loco::Position(0.3, -0.2, 0.0);
+  ASSERT_TRUE(validator.sendRequest(request));
+
+  // the terrain is modified after the request has been sent, e.g. by the terrain perception
+  for (double x = 0.2; x < 0.4; x += 0.01) {
+    for (double y = -0.3; y < -0.1; y += 0.01) {
+      terrain.setHeight(loco::Position(x, y, 0.0), 0.3);
+    }
+  }
+  validator.processRequests();
+  loco::FootholdValidationResponse response;
+  ASSERT_TRUE(validator.receiveResponse(response));
+  EXPECT_EQ(loco::FootholdVerified, response.flag_);
+  EXPECT_NEAR(0.1, response.positionWorldToValidatedFootHoldInWorldFrame_.z(), 1.0e-6);
+}
@@ -0,0 +1,128 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FootstepPreviewPlannerTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/foot_placement_strategy/FootstepPreviewPlanner.hpp"
+
+#include <cmath>
+
+
+static loco::FootstepPreviewInput getInput(double timeToTouchDown) {
+  loco::FootstepPreviewInput input;
+  input.positionWorldToCenterOfMassInWorldFrame_ = loco::Position(0.0, 0.0, 0.45);
+  input.linearVelocityCenterOfMassInWorldFrame_ = loco::LinearVelocity(0.3, 0.0, 0.0);
+  input.linearVelocityDesiredInWorldFrame_ = loco::LinearVelocity(0.3, 0.0, 0.0);
+  input.heightCenterOfMass_ = 0.45;
+  input.timeToTouchDown_ = timeToTouchDown;
+  input.strideDuration_ = 0.6;
+  input.positionCenterOfMassToNominalFootHoldInWorldFrame_ = loco::Position(0.25, 0.18, 0.0);
+  return input;
+}
+
+
+TEST(FootstepPreviewPlannerTest, steadyState) {
+  loco::FootstepPreviewPlanner planner;
+  ASSERT_TRUE(planner.setNumberOfSteps(4));
+  ASSERT_TRUE(planner.plan(0, getInput(0.2)));
+  ASSERT_TRUE(planner.hasPlan(0));
+  EXPECT_FALSE(planner.hasPlan(1));
+
+  // the steps move forward and the velocity is kept
+  const double omega = std::sqrt(9.81/0.45);
+  for (int k=0; k<4; k++) {
+    EXPECT_NEAR(0.3, planner.getLinearVelocityCenterOfMassInWorldFrame(0, k).x(), 1.0e-6);
+    EXPECT_NEAR(0.0, planner.getLinearVelocityCenterOfMassInWorldFrame(0, k).y(), 1.0e-6);
+    EXPECT_NEAR(0.18, planner.getPositionWorldToFootHoldInWorldFrame(0, k).y(), 1.0e-6);
+    EXPECT_NEAR(0.0, planner.getPositionWorldToFootHoldInWorldFrame(0, k).z(), 1.0e-12);
+    if (k > 0) {
+      const double stepLength = planner.getPositionWorldToFootHoldInWorldFrame(0, k).x() - planner.getPositionWorldToFootHoldInWorldFrame(0, k-1).x();
+      EXPECT_NEAR(2.0*0.3*std::tanh(0.5*omega*0.6)/omega, stepLength, 1.0e-6);
+    }
+  }
+}
+
+
+TEST(FootstepPreviewPlannerTest, pushRecovery) {
+  loco::FootstepPreviewPlanner planner;
+  loco::FootstepPreviewInput input = getInput(0.2);
+  input.linearVelocityCenterOfMassInWorldFrame_ = loco::LinearVelocity(0.3, 0.4, 0.0);
+  ASSERT_TRUE(planner.plan(0, input));
+
+  // the next step is placed sideways to catch the push
+  EXPECT_GT(planner.getPositionWorldToFootHoldInWorldFrame(0, 0).y(), 0.18 + 0.4*0.2);
+  EXPECT_LT(std::fabs(planner.getLinearVelocityCenterOfMassInWorldFrame(0, 0).y()), 0.4);
+}
+
+
+TEST(FootstepPreviewPlannerTest, warmStart) {
+  const double dt = 0.0025;
+  loco::FootstepPreviewPlanner planner;
+  loco::FootstepPreviewPlanner reference;
+  ASSERT_TRUE(planner.setNumberOfSteps(3));
+  ASSERT_TRUE(reference.setNumberOfSteps(3));
+  planner.setNumberOfIterations(2);
+
+  loco::FootstepPreviewInput input = getInput(0.1);
+  input.linearVelocityCenterOfMassInWorldFrame_ = loco::LinearVelocity(0.2, 0.1, 0.0);
+  input.angularVelocityDesiredZ_ = 0.2;
+  ASSERT_TRUE(planner.plan(1, input));
+
+  // the center of mass follows the prediction, the plan is shifted at touch-down
+  for (int i=0; i<200; i++) {
+    input.positionWorldToCenterOfMassInWorldFrame_ += loco::Position(input.linearVelocityCenterOfMassInWorldFrame_*dt);
+    input.timeToTouchDown_ -= dt;
+    input.didTouchDown_ = false;
+    if (input.timeToTouchDown_ < 0.0) {
+      input.timeToTouchDown_ += input.strideDuration_;
+      input.didTouchDown_ = true;
+    }
+    ASSERT_TRUE(planner.plan(1, input));
+  }
+
+  // a few iterations per tick track the exact solution
+  input.didTouchDown_ = false;
+  ASSERT_TRUE(planner.plan(1, input));
+  ASSERT_TRUE(reference.plan(1, input));
+  for (int k=0; k<3; k++) {
+    EXPECT_NEAR(reference.getPositionWorldToFootHoldInWorldFrame(1, k).x(), planner.getPositionWorldToFootHoldInWorldFrame(1, k).x(), 1.0e-3);
+    EXPECT_NEAR(reference.getPositionWorldToFootHoldInWorldFrame(1, k).y(), planner.getPositionWorldToFootHoldInWorldFrame(1, k).y(), 1.0e-3);
+  }
+}
@@ -0,0 +1,98 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     SwingFootClearancePlannerTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/foot_placement_strategy/SwingFootClearancePlanner.hpp"
+#include "loco/common/TerrainModelHeightMap.hpp"
+
+
+/* flat terrain with a box of the given height in 0.1 < x < 0.15 */
+static void setBox(loco::TerrainModelHeightMap& terrain, double height) {
+  for (double x = -0.6; x < 0.6; x += 0.01) {
+    for (double y = -0.6; y < 0.6; y += 0.01) {
+      terrain.setHeight(loco::Position(x, y, 0.0), (x > 0.1 && x < 0.15) ? height : 0.0);
+    }
+  }
+}
+
+
+TEST(SwingFootClearancePlannerTest, flat) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setBox(terrain, 0.0);
+  loco::SwingFootClearancePlanner planner(&terrain);
+  ASSERT_TRUE(planner.setLimits(0.03, 0.25));
+
+  loco::SwingFootClearanceResult result;
+  ASSERT_TRUE(planner.plan(loco::Position(0.0, 0.0, 0.0), loco::Position(0.25, 0.0, 0.0), 0.0, 0.08, 0.0, 0.5, result));
+  EXPECT_FALSE(result.isApexRaised_);
+  EXPECT_EQ(0.08, result.heightApex_);
+  EXPECT_EQ(0, result.numberOfPredictedCollisions_);
+  EXPECT_FALSE(result.isColliding_);
+}
+
+
+TEST(SwingFootClearancePlannerTest, box) {
+  loco::TerrainModelHeightMap terrain(0.01, 8, 8);
+  ASSERT_TRUE(terrain.initialize(0.0025));
+  setBox(terrain, 0.12);
+  loco::SwingFootClearancePlanner planner(&terrain);
+  ASSERT_TRUE(planner.setNumberOfSamples(41));
+  ASSERT_TRUE(planner.setLimits(0.03, 0.25));
+
+  // the nominal apex hits the box, the raised one clears it
+  loco::SwingFootClearanceResult result;
+  ASSERT_TRUE(planner.plan(loco::Position(0.0, 0.0, 0.0), loco::Position(0.25, 0.0, 0.0), 0.0, 0.08, 0.0, 0.5, result));
+  EXPECT_TRUE(result.isApexRaised_);
+  EXPECT_GT(result.heightApex_, 0.12);
+  EXPECT_LE(result.heightApex_, 0.25);
+  EXPECT_GT(result.numberOfPredictedCollisions_, 0);
+  EXPECT_GT(result.phaseOfFirstPredictedCollision_, 0.0);
+  EXPECT_LT(result.phaseOfFirstPredictedCollision_, 1.0);
+  EXPECT_GT(result.minClearance_, 0.0);
+  EXPECT_FALSE(result.isColliding_);
+
+  // the box is too high
+  setBox(terrain, 0.4);
+  EXPECT_FALSE(planner.plan(loco::Position(0.0, 0.0, 0.0), loco::Position(0.25, 0.0, 0.0), 0.0, 0.08, 0.0, 0.5, result));
+  EXPECT_EQ(0.25, result.heightApex_);
+  EXPECT_TRUE(result.isColliding_);
+}
@@ -0,0 +1,117 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     SwingFootTrajectoryPolynomialTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/foot_placement_strategy/SwingFootTrajectoryPolynomial.hpp"
+
+TEST(SwingFootTrajectoryPolynomialTest, boundaryConditions) {
+  loco::SwingFootTrajectoryPolynomial trajectory;
+  const loco::Position start(0.1, 0.2, 0.0);
+  const loco::Position target(0.3, -0.1, 0.0);
+  const double duration = 0.4;
+  trajectory.plan(0.0, duration, start, target, 0.0, 0.1, -0.02, 0.5);
+
+  // lift-off
+  EXPECT_NEAR(0.1, trajectory.getPosition(0.0).x(), 1.0e-12);
+  EXPECT_NEAR(0.2, trajectory.getPosition(0.0).y(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getPosition(0.0).z(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getLinearVelocity(0.0).norm(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getLinearAcceleration(0.0).norm(), 1.0e-12);
+
+  // apex
+  EXPECT_NEAR(0.1, trajectory.getPosition(0.2).z(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getLinearVelocity(0.2).z(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getLinearAcceleration(0.2).z(), 1.0e-12);
+
+  // touch-down
+  EXPECT_NEAR(0.3, trajectory.getPosition(duration).x(), 1.0e-12);
+  EXPECT_NEAR(-0.1, trajectory.getPosition(duration).y(), 1.0e-12);
+  EXPECT_NEAR(-0.02, trajectory.getPosition(duration).z(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getLinearVelocity(duration).norm(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getLinearAcceleration(duration).norm(), 1.0e-12);
+
+  // the velocity is the derivative of the position
+  const double h = 1.0e-6;
+  for (double time=0.05; time<duration; time+=0.1) {
+    const loco::Position difference = loco::Position((trajectory.getPosition(time+h).toImplementation() - trajectory.getPosition(time-h).toImplementation())/(2.0*h));
+    EXPECT_NEAR(0.0, (difference.toImplementation() - trajectory.getLinearVelocity(time).toImplementation()).norm(), 1.0e-6) << "time: " << time;
+  }
+}
+
+TEST(SwingFootTrajectoryPolynomialTest, planAfterLiftOff) {
+  loco::SwingFootTrajectoryPolynomial trajectory;
+  const loco::Position current(0.15, 0.1, 0.0);
+  const loco::Position target(0.3, 0.1, 0.0);
+
+  // before the apex, the trajectory starts at the current position and height
+  trajectory.plan(0.1, 0.4, current, target, 0.05, 0.1, 0.0, 0.5);
+  EXPECT_NEAR(0.15, trajectory.getPosition(0.1).x(), 1.0e-12);
+  EXPECT_NEAR(0.05, trajectory.getPosition(0.1).z(), 1.0e-12);
+  EXPECT_NEAR(0.1, trajectory.getPosition(0.2).z(), 1.0e-12);
+  EXPECT_NEAR(0.3, trajectory.getPosition(0.4).x(), 1.0e-12);
+  EXPECT_NEAR(0.0, trajectory.getPosition(0.4).z(), 1.0e-12);
+
+  // after the apex, the height goes straight to the target
+  trajectory.plan(0.3, 0.4, current, target, 0.07, 0.1, 0.0, 0.5);
+  EXPECT_NEAR(0.15, trajectory.getPosition(0.3).x(), 1.0e-12);
+  EXPECT_NEAR(0.07, trajectory.getPosition(0.3).z(), 1.0e-12);
+  EXPECT_GT(0.07, trajectory.getPosition(0.35).z());
+  EXPECT_NEAR(0.0, trajectory.getPosition(0.4).z(), 1.0e-12);
+}
+
+TEST(SwingFootTrajectoryPolynomialTest, refitIsContinuous) {
+  loco::SwingFootTrajectoryPolynomial trajectory;
+  trajectory.plan(0.0, 0.4, loco::Position(0.0, 0.0, 0.0), loco::Position(0.2, 0.0, 0.0), 0.0, 0.1, 0.0, 0.5);
+
+  // small changes of the target are ignored
+  EXPECT_FALSE(trajectory.updateTarget(0.1, loco::Position(0.205, 0.0, 0.0), 0.01));
+
+  const double time = 0.15;
+  const loco::Position position = trajectory.getPosition(time);
+  const loco::LinearVelocity velocity = trajectory.getLinearVelocity(time);
+  const loco::LinearAcceleration acceleration = trajectory.getLinearAcceleration(time);
+  EXPECT_TRUE(trajectory.updateTarget(time, loco::Position(0.25, 0.05, 0.0), 0.01));
+  EXPECT_NEAR(0.0, (position.toImplementation() - trajectory.getPosition(time).toImplementation()).norm(), 1.0e-12);
+  EXPECT_NEAR(0.0, (velocity.toImplementation() - trajectory.getLinearVelocity(time).toImplementation()).norm(), 1.0e-12);
+  EXPECT_NEAR(0.0, (acceleration.toImplementation() - trajectory.getLinearAcceleration(time).toImplementation()).norm(), 1.0e-9);
+  EXPECT_NEAR(0.25, trajectory.getPosition(0.4).x(), 1.0e-12);
+  EXPECT_NEAR(0.05, trajectory.getPosition(0.4).y(), 1.0e-12);
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     GaitPatternFlightPhasesTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/gait_pattern/GaitPatternFlightPhases.hpp"
+#include "loco/common/ParameterVector.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+void addGait(loco::GaitPatternFlightPhases* gaitPattern, double strideDuration, double liftOffPhase, double strikePhase) {
+  gaitPattern->setStrideDuration(strideDuration);
+  for (int iLeg=0; iLeg<4; iLeg++) {
+    gaitPattern->addFootFallPattern(iLeg, liftOffPhase, strikePhase);
+  }
+}
+
+} // namespace
+
+TEST(GaitPatternFlightPhasesTest, interpolationByParameterVector) {
+  loco::ParameterVector parameterVector1, parameterVector2, parameterVector;
+  {
+    // the parameters of the gaits outlive the gait patterns they have been read from
+    loco::GaitPatternFlightPhases walk(nullptr, nullptr), trot(nullptr, nullptr);
+    addGait(&walk, 1.0, 0.2, 0.4);
+    addGait(&trot, 0.8, 0.0, 0.5);
+    ASSERT_TRUE(walk.addParametersToVector(&parameterVector1));
+    ASSERT_TRUE(trot.addParametersToVector(&parameterVector2));
+    parameterVector1.detachFromModules();
+    parameterVector2.detachFromModules();
+  }
+  EXPECT_EQ(9, parameterVector1.getSize());
+
+  loco::GaitPatternFlightPhases gaitPattern(nullptr, nullptr);
+  addGait(&gaitPattern, 1.0, 0.2, 0.4);
+  ASSERT_TRUE(gaitPattern.addParametersToVector(&parameterVector));
+  ASSERT_TRUE(parameterVector.setToInterpolated(parameterVector1, parameterVector2, 0.5));
+  EXPECT_DOUBLE_EQ(0.9, gaitPattern.getStrideDuration());
+  for (int iLeg=0; iLeg<4; iLeg++) {
+    EXPECT_DOUBLE_EQ(0.1, gaitPattern.getFootLiftOffPhase(iLeg));
+    EXPECT_DOUBLE_EQ(0.45, gaitPattern.getFootTouchDownPhase(iLeg));
+  }
+}
+
+TEST(GaitPatternFlightPhasesTest, differentNumberOfLegs) {
+  loco::GaitPatternFlightPhases biped(nullptr, nullptr), gaitPattern(nullptr, nullptr);
+  loco::ParameterVector parameterVector1, parameterVector;
+  biped.setStrideDuration(1.0);
+  biped.addFootFallPattern(0, 0.0, 0.5);
+  biped.addFootFallPattern(1, 0.5, 1.0);
+  addGait(&gaitPattern, 1.0, 0.2, 0.4);
+  ASSERT_TRUE(biped.addParametersToVector(&parameterVector1));
+  ASSERT_TRUE(gaitPattern.addParametersToVector(&parameterVector));
+  EXPECT_FALSE(parameterVector.setToInterpolated(parameterVector1, parameterVector1, 0.5));
+  EXPECT_DOUBLE_EQ(0.2, gaitPattern.getFootLiftOffPhase(0));
+}
+
+TEST(GaitPatternFlightPhasesTest, patternsAddedAfterRegistration) {
+  loco::GaitPatternFlightPhases gaitPattern(nullptr, nullptr);
+  loco::ParameterVector parameterVector;
+  gaitPattern.setStrideDuration(1.0);
+  gaitPattern.addFootFallPattern(0, 0.0, 0.5);
+  ASSERT_TRUE(gaitPattern.addParametersToVector(&parameterVector));
+  EXPECT_EQ(3, parameterVector.getSize());
+
+  // the patterns are reallocated, the vector follows them
+  for (int iLeg=1; iLeg<4; iLeg++) {
+    gaitPattern.addFootFallPattern(iLeg, 0.0, 0.5);
+  }
+  ASSERT_EQ(9, parameterVector.getSize());
+  Eigen::VectorXd values(9);
+  values << 0.8, 0.1, 0.4, 0.2, 0.5, 0.3, 0.6, 0.4, 0.7;
+  ASSERT_TRUE(parameterVector.setValues(values));
+  EXPECT_DOUBLE_EQ(0.8, gaitPattern.getStrideDuration());
+  for (int iLeg=0; iLeg<4; iLeg++) {
+    EXPECT_DOUBLE_EQ(0.1*(iLeg+1), gaitPattern.getFootLiftOffPhase(iLeg));
+    EXPECT_DOUBLE_EQ(0.1*(iLeg+4), gaitPattern.getFootTouchDownPhase(iLeg));
+  }
+
+  gaitPattern.clear();
+  EXPECT_EQ(1, parameterVector.getSize());
+}
@@ -0,0 +1,358 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     StabilityMarginsTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/common/StabilityMargins.hpp"
+#include "loco/contact_force_distribution/ContactForceDistributionBase.hpp"
+#include "loco/limb_coordinator/LimbCoordinatorDynamicGait.hpp"
+#include "loco/gait_pattern/GaitPatternFlightPhases.hpp"
+#include "loco/motion_control/WholeBodyController.hpp"
+#include "tinyxml.h"
+#include "../TestLegAndTorso.hpp"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace {
+
+//! Returns given ground reaction forces instead of distributing a virtual force
+class StabilityMarginsTestContactForceDistribution : public loco::ContactForceDistributionBase {
+ public:
+  StabilityMarginsTestContactForceDistribution() :
+    loco::ContactForceDistributionBase(nullptr, nullptr, nullptr)
+  {
+  }
+  void setNormalForce(int legId, double normalForce) {
+    normalForces_[legId] = normalForce;
+  }
+  virtual bool getGroundReactionForceInWorldFrame(loco::LegBase* leg, loco::Force& forceInWorldFrame) const {
+    forceInWorldFrame = loco::Force(0.0, 0.0, normalForces_[leg->getId()]);
+    return true;
+  }
+  virtual bool loadParameters(const TiXmlHandle& /*handle*/) { return true; }
+  virtual bool addToLogger() { return true; }
+  virtual bool computeForceDistribution(const loco::Force& /*virtualForceInBaseFrame*/, const loco::Torque& /*virtualTorqueInBaseFrame*/) { return true; }
+  virtual bool getNetForceAndTorqueOnBase(loco::Force& /*netForce*/, loco::Torque& /*netTorque*/) { return true; }
+
+ protected:
+  virtual bool updateLoggerData() { return true; }
+
+ private:
+  double normalForces_[4] = {0.0, 0.0, 0.0, 0.0};
+};
+
+/* The feet span a rectangle of 0.6m x 0.4m around the origin. The center of mass is 5cm in front
+ * of the origin at a height of 0.5m and moves forward with 0.5m/s.
+ */
+class StabilityMarginsTest : public ::testing::Test {
+ protected:
+  StabilityMarginsTest() :
+    leftForeLeg_("leftFore", 0, loco::Position(0.3, 0.2, 0.0)),
+    rightForeLeg_("rightFore", 1, loco::Position(0.3, -0.2, 0.0)),
+    leftHindLeg_("leftHind", 2, loco::Position(-0.3, 0.2, 0.0)),
+    rightHindLeg_("rightHind", 3, loco::Position(-0.3, -0.2, 0.0)),
+    stabilityMargins_(&legs_, &torso_)
+  {
+    legs_.addLeg(&leftForeLeg_);
+    legs_.addLeg(&rightForeLeg_);
+    legs_.addLeg(&leftHindLeg_);
+    legs_.addLeg(&rightHindLeg_);
+    torso_.getProperties().setGravity(loco::LinearAcceleration(0.0, 0.0, -gravity_));
+    torso_.getProperties().setBaseToCenterOfMassPositionInBaseFrame(loco::Position(0.0, 0.0, 0.0));
+    torso_.getMeasuredState().setPositionWorldToBaseInWorldFrame(loco::Position(0.05, 0.0, height_));
+    torso_.getMeasuredState().setOrientationWorldToBase(loco::RotationQuaternion());
+    torso_.getMeasuredState().setLinearVelocityBaseInBaseFrame(loco::LinearVelocity(velocity_, 0.0, 0.0));
+    contactForceDistribution_.setNormalForce(0, 150.0);
+    contactForceDistribution_.setNormalForce(1, 150.0);
+    contactForceDistribution_.setNormalForce(2, 100.0);
+    contactForceDistribution_.setNormalForce(3, 50.0);
+    stabilityMargins_.setContactForceDistribution(&contactForceDistribution_);
+  }
+
+  //! x-coordinate of the instantaneous capture point
+  double getCapturePoint() const {
+    return 0.05 + velocity_*std::sqrt(height_/gravity_);
+  }
+
+  const double gravity_ = 9.81;
+  const double height_ = 0.5;
+  const double velocity_ = 0.5;
+
+  loco_test::TestLeg leftForeLeg_;
+  loco_test::TestLeg rightForeLeg_;
+  loco_test::TestLeg leftHindLeg_;
+  loco_test::TestLeg rightHindLeg_;
+  loco::LegGroup legs_;
+  loco_test::TestTorso torso_;
+  StabilityMarginsTestContactForceDistribution contactForceDistribution_;
+  loco::StabilityMargins stabilityMargins_;
+};
+
+} // namespace
+
+
+TEST_F(StabilityMarginsTest, fourGroundedFeet) {
+  ASSERT_TRUE(stabilityMargins_.update());
+  EXPECT_TRUE(stabilityMargins_.isValid());
+  EXPECT_EQ(4, stabilityMargins_.getSupportPolygon().getNumberOfVertices());
+
+  // the lateral edges are closest to the center of mass
+  EXPECT_NEAR(0.2, stabilityMargins_.getSupportPolygonMargin(), 1.0e-9);
+
+  // the center of pressure is at (0.1, 1/45) and closest to the left edge
+  ASSERT_TRUE(stabilityMargins_.isCenterOfPressureValid());
+  EXPECT_NEAR(0.1, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().x(), 1.0e-9);
+  EXPECT_NEAR(1.0/45.0, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().y(), 1.0e-9);
+  EXPECT_NEAR(0.2-1.0/45.0, stabilityMargins_.getCenterOfPressureMargin(), 1.0e-9);
+
+  EXPECT_NEAR(getCapturePoint(), stabilityMargins_.getPositionWorldToCapturePointInWorldFrame().x(), 1.0e-9);
+  EXPECT_NEAR(0.3-getCapturePoint(), stabilityMargins_.getCapturePointMargin(), 1.0e-9);
+}
+
+
+TEST_F(StabilityMarginsTest, threeGroundedFeet) {
+  rightHindLeg_.setIsGrounded(false);
+  ASSERT_TRUE(stabilityMargins_.update());
+  EXPECT_EQ(3, stabilityMargins_.getSupportPolygon().getNumberOfVertices());
+
+  // the diagonal 0.2*x + 0.3*y = 0 from the right fore to the left hind foot is closest
+  const double normOfDiagonal = std::sqrt(0.13);
+  EXPECT_NEAR(0.2*0.05/normOfDiagonal, stabilityMargins_.getSupportPolygonMargin(), 1.0e-9);
+
+  // the force of the lifted leg does not contribute, the center of pressure is at (0.15, 0.05)
+  ASSERT_TRUE(stabilityMargins_.isCenterOfPressureValid());
+  EXPECT_NEAR(0.15, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().x(), 1.0e-9);
+  EXPECT_NEAR(0.05, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().y(), 1.0e-9);
+  EXPECT_NEAR((0.2*0.15+0.3*0.05)/normOfDiagonal, stabilityMargins_.getCenterOfPressureMargin(), 1.0e-9);
+
+  EXPECT_NEAR(0.2*getCapturePoint()/normOfDiagonal, stabilityMargins_.getCapturePointMargin(), 1.0e-9);
+}
+
+
+TEST_F(StabilityMarginsTest, twoGroundedFeet) {
+  rightForeLeg_.setIsGrounded(false);
+  leftHindLeg_.setIsGrounded(false);
+  ASSERT_TRUE(stabilityMargins_.update());
+  EXPECT_EQ(2, stabilityMargins_.getSupportPolygon().getNumberOfVertices());
+
+  // the margin is the negative distance to the diagonal 0.2*x - 0.3*y = 0 of the trot
+  const double normOfDiagonal = std::sqrt(0.13);
+  EXPECT_NEAR(-0.2*0.05/normOfDiagonal, stabilityMargins_.getSupportPolygonMargin(), 1.0e-9);
+
+  // the center of pressure (0.15, 0.1) lies on the diagonal
+  ASSERT_TRUE(stabilityMargins_.isCenterOfPressureValid());
+  EXPECT_NEAR(0.15, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().x(), 1.0e-9);
+  EXPECT_NEAR(0.1, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().y(), 1.0e-9);
+  EXPECT_NEAR(0.0, stabilityMargins_.getCenterOfPressureMargin(), 1.0e-9);
+
+  EXPECT_NEAR(-0.2*getCapturePoint()/normOfDiagonal, stabilityMargins_.getCapturePointMargin(), 1.0e-9);
+}
+
+
+TEST_F(StabilityMarginsTest, capturePointMarginWithoutLeg) {
+  ASSERT_TRUE(stabilityMargins_.update());
+
+  // without the right hind foot the diagonal 0.2*x + 0.3*y = 0 is closest to the capture point
+  const double normOfDiagonal = std::sqrt(0.13);
+  EXPECT_NEAR(0.2*getCapturePoint()/normOfDiagonal, stabilityMargins_.getCapturePointMarginWithoutLeg(rightHindLeg_), 1.0e-9);
+
+  // without the left fore foot the capture point lies outside of the same diagonal
+  EXPECT_NEAR(-0.2*getCapturePoint()/normOfDiagonal, stabilityMargins_.getCapturePointMarginWithoutLeg(leftForeLeg_), 1.0e-9);
+
+  // a leg that is not grounded does not change the margin
+  rightHindLeg_.setIsGrounded(false);
+  ASSERT_TRUE(stabilityMargins_.update());
+  EXPECT_NEAR(stabilityMargins_.getCapturePointMargin(), stabilityMargins_.getCapturePointMarginWithoutLeg(rightHindLeg_), 1.0e-12);
+}
+
+
+TEST_F(StabilityMarginsTest, noGroundedFoot) {
+  for (auto leg : legs_) {
+    leg->setIsGrounded(false);
+  }
+  EXPECT_FALSE(stabilityMargins_.update());
+  EXPECT_FALSE(stabilityMargins_.isValid());
+  EXPECT_FALSE(stabilityMargins_.isCenterOfPressureValid());
+}
+
+
+TEST_F(StabilityMarginsTest, centerOfPressureOfWholeBodyController) {
+  const char* wholeBodyControllerParameters =
+    "<WholeBodyController>"
+    "  <Torso>"
+    "    <Gains>"
+    "      <Heading kp=\"100.0\" kd=\"20.0\"/>"
+    "      <Lateral kp=\"100.0\" kd=\"20.0\"/>"
+    "      <Vertical kp=\"400.0\" kd=\"40.0\"/>"
+    "      <Roll kp=\"200.0\" kd=\"20.0\"/>"
+    "      <Pitch kp=\"200.0\" kd=\"20.0\"/>"
+    "      <Yaw kp=\"100.0\" kd=\"10.0\"/>"
+    "    </Gains>"
+    "    <Inertia xx=\"0.8\" yy=\"2.0\" zz=\"2.2\"/>"
+    "  </Torso>"
+    "  <SwingLeg>"
+    "    <Gains kp=\"400.0\" kd=\"40.0\"/>"
+    "  </SwingLeg>"
+    "  <Regularization tangentialForce=\"1.0\" normalForce=\"0.1\" jointAcceleration=\"0.01\"/>"
+    "  <Friction coefficient=\"0.6\" minimalNormalForce=\"5.0\"/>"
+    "</WholeBodyController>";
+  TiXmlDocument document;
+  document.Parse(wholeBodyControllerParameters);
+  ASSERT_FALSE(document.Error());
+
+  // the controller does not own the legs and the torso of the fixture
+  loco::WholeBodyController wholeBodyController(std::shared_ptr<loco::LegGroup>(&legs_, [](loco::LegGroup*) {}),
+                                                std::shared_ptr<loco::TorsoBase>(&torso_, [](loco::TorsoBase*) {}));
+  ASSERT_TRUE(wholeBodyController.loadParameters(TiXmlHandle(&document)));
+  stabilityMargins_.setWholeBodyController(&wholeBodyController);
+
+  // the whole-body controller replaces the contact force distribution, it has no forces before it is computed
+  ASSERT_TRUE(stabilityMargins_.update());
+  EXPECT_FALSE(stabilityMargins_.isCenterOfPressureValid());
+
+  // the center of pressure is the mean of the feet weighted with the normal forces of the whole-body controller,
+  // the torso keeps its velocity and is supported above the center of the feet
+  torso_.getProperties().setMass(30.0);
+  torso_.getDesiredState().setLinearVelocityBaseInControlFrame(loco::LinearVelocity(velocity_, 0.0, 0.0));
+  for (auto leg : legs_) {
+    leg->setIsSupportLeg(true);
+  }
+  ASSERT_TRUE(wholeBodyController.compute());
+  ASSERT_TRUE(stabilityMargins_.update());
+  ASSERT_TRUE(stabilityMargins_.isCenterOfPressureValid());
+  loco::Position positionWorldToCenterOfPressureInWorldFrame;
+  double normalForce = 0.0;
+  for (auto leg : legs_) {
+    const double normalForceOfLeg = wholeBodyController.getGroundReactionForceInWorldFrame(leg->getId()).z();
+    positionWorldToCenterOfPressureInWorldFrame += leg->getPositionWorldToFootInWorldFrame()*normalForceOfLeg;
+    normalForce += normalForceOfLeg;
+  }
+  positionWorldToCenterOfPressureInWorldFrame /= normalForce;
+  EXPECT_NEAR(positionWorldToCenterOfPressureInWorldFrame.x(), stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().x(), 1.0e-9);
+  EXPECT_NEAR(positionWorldToCenterOfPressureInWorldFrame.y(), stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().y(), 1.0e-9);
+  EXPECT_NEAR(0.0, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().x(), 1.0e-3);
+  EXPECT_NEAR(0.0, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().y(), 1.0e-3);
+
+  // the contact force distribution is used again without the whole-body controller
+  stabilityMargins_.setWholeBodyController(nullptr);
+  ASSERT_TRUE(stabilityMargins_.update());
+  EXPECT_NEAR(0.1, stabilityMargins_.getPositionWorldToCenterOfPressureInWorldFrame().x(), 1.0e-9);
+}
+
+
+TEST_F(StabilityMarginsTest, lateLiftOffIsDelayedByCapturePointMargin) {
+  loco::LimbCoordinatorDynamicGait limbCoordinator(&legs_, &torso_, nullptr);
+
+  // the right hind leg should swing, but is still grounded
+  rightHindLeg_.setShouldBeGrounded(false);
+  rightHindLeg_.setSwingPhase(0.1);
+  ASSERT_TRUE(stabilityMargins_.update());
+
+  // without margins or with the default threshold the leg lifts off
+  ASSERT_TRUE(limbCoordinator.advance(0.0025));
+  EXPECT_FALSE(rightHindLeg_.isSupportLeg());
+  limbCoordinator.setStabilityMargins(&stabilityMargins_);
+  ASSERT_TRUE(limbCoordinator.advance(0.0025));
+  EXPECT_FALSE(rightHindLeg_.isSupportLeg());
+
+  // the capture point is closer to the fore feet than the threshold
+  limbCoordinator.setMinCapturePointMarginForLiftOff(0.3-getCapturePoint()+0.01);
+  ASSERT_TRUE(limbCoordinator.advance(0.0025));
+  EXPECT_TRUE(rightHindLeg_.isSupportLeg());
+  EXPECT_TRUE(leftForeLeg_.isSupportLeg());
+
+  // the margin of all four feet is above the threshold, but the support triangle without the lifting leg is too small
+  const double marginWithoutRightHindLeg = 0.2*getCapturePoint()/std::sqrt(0.13);
+  ASSERT_LT(marginWithoutRightHindLeg+0.01, stabilityMargins_.getCapturePointMargin());
+  limbCoordinator.setMinCapturePointMarginForLiftOff(marginWithoutRightHindLeg+0.01);
+  ASSERT_TRUE(limbCoordinator.advance(0.0025));
+  EXPECT_TRUE(rightHindLeg_.isSupportLeg());
+  limbCoordinator.setMinCapturePointMarginForLiftOff(marginWithoutRightHindLeg-0.01);
+  ASSERT_TRUE(limbCoordinator.advance(0.0025));
+  EXPECT_FALSE(rightHindLeg_.isSupportLeg());
+
+  // outdated margins are ignored
+  stabilityMargins_.invalidate();
+  ASSERT_TRUE(limbCoordinator.advance(0.0025));
+  EXPECT_FALSE(rightHindLeg_.isSupportLeg());
+}
+
+
+TEST_F(StabilityMarginsTest, capturePointMarginForLiftOffIsLoaded) {
+  loco::LimbCoordinatorDynamicGait limbCoordinator(&legs_, &torso_, nullptr);
+
+  TiXmlDocument document;
+  document.Parse("<LimbCoordination><StabilityMargins minCapturePointMarginForLiftOff=\"0.02\"/></LimbCoordination>");
+  ASSERT_FALSE(document.Error());
+  ASSERT_TRUE(limbCoordinator.loadParameters(TiXmlHandle(&document)));
+  EXPECT_DOUBLE_EQ(0.02, limbCoordinator.getParameters().minCapturePointMarginForLiftOff_);
+
+  // the delay is disabled if the element is missing
+  TiXmlDocument documentWithoutMargins;
+  documentWithoutMargins.Parse("<LimbCoordination/>");
+  ASSERT_FALSE(documentWithoutMargins.Error());
+  ASSERT_TRUE(limbCoordinator.loadParameters(TiXmlHandle(&documentWithoutMargins)));
+  EXPECT_TRUE(std::isinf(limbCoordinator.getMinCapturePointMarginForLiftOff()));
+  EXPECT_LT(limbCoordinator.getMinCapturePointMarginForLiftOff(), 0.0);
+}
+
+
+TEST_F(StabilityMarginsTest, capturePointMarginForLiftOffIsInterpolated) {
+  loco::GaitPatternFlightPhases gaitPattern(&legs_, &torso_);
+  loco::GaitPatternFlightPhases gaitPattern1(&legs_, &torso_);
+  loco::GaitPatternFlightPhases gaitPattern2(&legs_, &torso_);
+  loco::LimbCoordinatorDynamicGait limbCoordinator(&legs_, &torso_, &gaitPattern);
+  loco::LimbCoordinatorDynamicGait limbCoordinator1(&legs_, &torso_, &gaitPattern1);
+  loco::LimbCoordinatorDynamicGait limbCoordinator2(&legs_, &torso_, &gaitPattern2);
+
+  limbCoordinator1.setMinCapturePointMarginForLiftOff(0.02);
+  limbCoordinator2.setMinCapturePointMarginForLiftOff(0.04);
+  ASSERT_TRUE(limbCoordinator.setToInterpolated(limbCoordinator1, limbCoordinator2, 0.25));
+  EXPECT_NEAR(0.025, limbCoordinator.getMinCapturePointMarginForLiftOff(), 1.0e-12);
+
+  // a disabled delay is taken from the closer controller
+  limbCoordinator2.setMinCapturePointMarginForLiftOff(-std::numeric_limits<double>::infinity());
+  ASSERT_TRUE(limbCoordinator.setToInterpolated(limbCoordinator1, limbCoordinator2, 0.25));
+  EXPECT_DOUBLE_EQ(0.02, limbCoordinator.getMinCapturePointMarginForLiftOff());
+  ASSERT_TRUE(limbCoordinator.setToInterpolated(limbCoordinator1, limbCoordinator2, 0.75));
+  EXPECT_TRUE(std::isinf(limbCoordinator.getMinCapturePointMarginForLiftOff()));
+}
@@ -0,0 +1,202 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     ParameterHotReloadTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "loco/gait_switcher/GaitSwitcherDynamicGaitDefault.hpp"
+#include "loco/locomotion_controller/LocomotionControllerDynamicGaitDefault.hpp"
+#include "loco/foot_placement_strategy/FootPlacementStrategyInvertedPendulum.hpp"
+#include "loco/motion_control/VirtualModelController.hpp"
+
+#include "RobotModel.hpp"
+#include "robotUtils/terrains/TerrainPlane.hpp"
+
+namespace {
+
+const char* configFile =
+    "<GaitSwitcherDynamicGaitDefault>"
+    "  <ParameterSets initialIdx=\"1\">"
+    "    <ParameterSet idx=\"1\" name=\"Walk\"/>"
+    "  </ParameterSets>"
+    "</GaitSwitcherDynamicGaitDefault>";
+
+//! Writes a complete parameter file of the default dynamic gait controller
+void writeParameterFile(const std::string& path, double proportionalGainHeading, double cycleDuration, double swingHeight) {
+  std::ostringstream xml;
+  xml << "<LocomotionController>"
+      << "<Mission>"
+      << "  <Speed><Maximum headingSpeed=\"0.5\" lateralSpeed=\"0.3\" turningSpeed=\"0.5\"/></Speed>"
+      << "  <Configuration>"
+      << "    <Position><Initial x=\"0\" y=\"0\" z=\"0.42\"/><Minimal x=\"0\" y=\"0\" z=\"0.24\"/><Maximal x=\"0\" y=\"0\" z=\"0.44\"/></Position>"
+      << "    <Orientation><Initial x=\"0\" y=\"0\" z=\"0\"/><Minimal x=\"0\" y=\"0\" z=\"0\"/><Maximal x=\"0\" y=\"0\" z=\"0\"/></Orientation>"
+      << "  </Configuration>"
+      << "</Mission>"
+      << "<FootPlacementStrategy><InvertedPendulum>"
+      << "  <Gains feedbackScale=\"1.0\"/>"
+      << "  <Offset><Fore heading=\"0.0\" lateral=\"0.0\"/><Hind heading=\"0.0\" lateral=\"0.0\"/></Offset>"
+      << "  <HeightTrajectory><Knot t=\"0.0\" v=\"0.0\"/><Knot t=\"0.5\" v=\"" << swingHeight << "\"/><Knot t=\"1.0\" v=\"0.0\"/></HeightTrajectory>"
+      << "</InvertedPendulum></FootPlacementStrategy>"
+      << "<TorsoControl>"
+      << "  <TorsoConfiguration><TorsoHeight torsoHeight=\"0.42\"/></TorsoConfiguration>"
+      << "  <DynamicGait>"
+      << "    <CoMOverSupportPolygonControl><Weight minSwingLegWeight=\"0.3\"/>"
+      << "      <Timing startShiftAwayFromLegAtStancePhase=\"0.8\" startShiftTowardsLegAtSwingPhase=\"0.7\"/></CoMOverSupportPolygonControl>"
+      << "    <HipConfiguration>"
+      << "      <HeightTrajectory fore=\"true\" offset=\"0.0\"><Knot t=\"0.0\" v=\"0.42\"/><Knot t=\"0.5\" v=\"0.42\"/></HeightTrajectory>"
+      << "      <HeightTrajectory hind=\"true\" offset=\"0.0\"><Knot t=\"0.0\" v=\"0.42\"/><Knot t=\"0.5\" v=\"0.42\"/></HeightTrajectory>"
+      << "    </HipConfiguration>"
+      << "  </DynamicGait>"
+      << "</TorsoControl>"
+      << "<ContactForceDistribution>"
+      << "  <Weights><Force heading=\"1\" lateral=\"1\" vertical=\"1\"/><Torque roll=\"10\" pitch=\"10\" yaw=\"5\"/><Regularizer value=\"0.00001\"/></Weights>"
+      << "  <Constraints frictionCoefficient=\"0.6\" minimalNormalForce=\"2.0\"/>"
+      << "  <LoadFactor loadFactor=\"1.0\"/>"
+      << "</ContactForceDistribution>"
+      << "<VirtualModelController><Gains>"
+      << "  <Heading kp=\"" << proportionalGainHeading << "\" kd=\"150\" kff=\"0\"/>"
+      << "  <Lateral kp=\"1000\" kd=\"150\" kff=\"0\"/>"
+      << "  <Vertical kp=\"1000\" kd=\"150\" kff=\"1\"/>"
+      << "  <Roll kp=\"500\" kd=\"20\" kff=\"0\"/>"
+      << "  <Pitch kp=\"500\" kd=\"20\" kff=\"0\"/>"
+      << "  <Yaw kp=\"500\" kd=\"20\" kff=\"0\"/>"
+      << "</Gains></VirtualModelController>"
+      << "<LimbCoordination><GaitPattern>"
+      << "  <FlightPhases cycleDuration=\"" << cycleDuration << "\" initCyclePhase=\"0.0\">"
+      << "    <LF liftOff=\"0.5\" touchDown=\"0.95\"/><RF liftOff=\"0.0\" touchDown=\"0.45\"/>"
+      << "    <LH liftOff=\"0.0\" touchDown=\"0.45\"/><RH liftOff=\"0.5\" touchDown=\"0.95\"/>"
+      << "  </FlightPhases>"
+      << "</GaitPattern></LimbCoordination>"
+      << "</LocomotionController>";
+  std::ofstream stream(path.c_str(), std::ios::out | std::ios::trunc);
+  stream << xml.str();
+}
+
+} // namespace
+
+
+TEST(ParameterHotReloadTest, modifiedFileReachesLiveController) {
+  const double dt = 0.0025;
+
+  char directory[] = "/tmp/ParameterHotReloadTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(directory) != nullptr);
+  const std::string configFilePath = std::string(directory) + "/GaitSwitcher.xml";
+  const std::string parameterFilePath = std::string(directory) + "/WalkSim.xml";
+  {
+    std::ofstream stream(configFilePath.c_str());
+    stream << configFile;
+  }
+  writeParameterFile(parameterFilePath, 1000.0, 0.8, 0.08);
+
+  robotTerrain::TerrainPlane terrain;
+  robotModel::RobotModel robotModel;
+  robotModel.init();
+  robotModel.update();
+
+  {
+    loco::GaitSwitcherDynamicGaitDefault gaitSwitcher(&robotModel, &terrain, dt);
+    gaitSwitcher.setPathToConfigFile(configFilePath);
+    gaitSwitcher.setPathToParameterFiles(directory);
+    ASSERT_TRUE(gaitSwitcher.initialize(dt));
+    ASSERT_TRUE(gaitSwitcher.startParameterHotReload());
+    ASSERT_TRUE(gaitSwitcher.advance(dt));
+
+    loco::LocomotionControllerDynamicGait* locomotionController = gaitSwitcher.getLocomotionController()->getLocomotionControllerDynamicGait();
+    EXPECT_DOUBLE_EQ(1000.0, locomotionController->getVirtualModelController()->getParameters().proportionalGainTranslation_(0));
+    EXPECT_DOUBLE_EQ(0.8, gaitSwitcher.getLocomotionController()->getGaitPattern()->getStrideDuration());
+
+    // the gain and the stride duration are carried by the parameter vector
+    writeParameterFile(parameterFilePath, 1200.0, 0.6, 0.08);
+
+    bool isReloaded = false;
+    for (int i=0; i<800 && !isReloaded; i++) {
+      std::this_thread::sleep_for(std::chrono::microseconds(2500));
+      ASSERT_TRUE(gaitSwitcher.advance(dt));
+      isReloaded = (locomotionController->getVirtualModelController()->getParameters().proportionalGainTranslation_(0) == 1200.0);
+    }
+    ASSERT_TRUE(isReloaded);
+
+    // the values have been written into the running controller
+    EXPECT_EQ(locomotionController, gaitSwitcher.getLocomotionController()->getLocomotionControllerDynamicGait());
+    EXPECT_TRUE(gaitSwitcher.getLocomotionController()->isInitialized());
+    EXPECT_DOUBLE_EQ(0.6, gaitSwitcher.getLocomotionController()->getGaitPattern()->getStrideDuration());
+
+    // the swing height trajectory is not carried by the gait parameters, hence the file is rejected
+    writeParameterFile(parameterFilePath, 1300.0, 0.6, 0.12);
+    for (int i=0; i<100; i++) {
+      std::this_thread::sleep_for(std::chrono::microseconds(2500));
+      ASSERT_TRUE(gaitSwitcher.advance(dt));
+    }
+    EXPECT_DOUBLE_EQ(1200.0, locomotionController->getVirtualModelController()->getParameters().proportionalGainTranslation_(0));
+    loco::FootPlacementStrategyInvertedPendulum* footPlacementStrategy =
+        dynamic_cast<loco::FootPlacementStrategyInvertedPendulum*>(locomotionController->getFootPlacementStrategy());
+    ASSERT_TRUE(footPlacementStrategy != nullptr);
+    EXPECT_NEAR(0.08, footPlacementStrategy->swingFootHeightTrajectory_.evaluate_linear(0.5), 1e-9);
+
+    // an invalid file is rejected and the current parameters are kept
+    {
+      std::ofstream stream(parameterFilePath.c_str(), std::ios::out | std::ios::trunc);
+      stream << "<LocomotionController></LocomotionController>";
+    }
+    for (int i=0; i<100; i++) {
+      std::this_thread::sleep_for(std::chrono::microseconds(2500));
+      ASSERT_TRUE(gaitSwitcher.advance(dt));
+    }
+    locomotionController = gaitSwitcher.getLocomotionController()->getLocomotionControllerDynamicGait();
+    EXPECT_DOUBLE_EQ(1200.0, locomotionController->getVirtualModelController()->getParameters().proportionalGainTranslation_(0));
+
+    gaitSwitcher.stopParameterHotReload();
+  }
+
+  unlink(configFilePath.c_str());
+  unlink(parameterFilePath.c_str());
+  unlink((std::string(directory) + "/" + loco::ParameterCache::defaultFileName).c_str());
+  rmdir(directory);
+}
@@ -0,0 +1,167 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     CentroidalMpcSolverTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/motion_control/CentroidalMpcSolver.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+const double mass = 40.0;
+const double gravity = 9.81;
+
+void setUpSolver(loco::CentroidalMpcSolver& solver, double frictionCoefficient) {
+  ASSERT_FALSE(solver.initialize(loco::CentroidalMpcSolver::maxNumberOfStages+1, 0.03));
+  ASSERT_TRUE(solver.initialize(15, 0.03));
+  solver.setMass(mass);
+  solver.setInertiaInWorldFrame(Eigen::Vector3d(0.8, 2.0, 2.2).asDiagonal());
+  solver.setGravity(Eigen::Vector3d(0.0, 0.0, -gravity));
+  loco::CentroidalMpcSolver::State weights;
+  weights << 50.0, 50.0, 10.0, 100.0, 100.0, 500.0, 1.0, 1.0, 1.0, 10.0, 10.0, 10.0;
+  solver.setStateWeights(weights);
+  solver.setForceWeight(1.0e-6);
+  solver.setFrictionCoefficient(frictionCoefficient);
+  solver.setNormalForceLimits(5.0, 400.0);
+  solver.setAdmmParameters(1.0e-3, 200, 1.0);
+}
+
+//! Feet at the corners of the rectangle below the CoM, legs 0 and 3 and legs 1 and 2 are diagonal pairs.
+Eigen::Vector3d getPositionCoMToFoot(int iLeg, double heightOfCoM) {
+  const double x = (iLeg < 2) ? 0.3 : -0.3;
+  const double y = (iLeg % 2 == 0) ? 0.2 : -0.2;
+  return Eigen::Vector3d(x, y, -heightOfCoM);
+}
+
+void checkConstraints(const loco::CentroidalMpcSolver::Input& forces, double frictionCoefficient) {
+  for (int iLeg=0; iLeg<loco::CentroidalMpcSolver::numberOfLegs; iLeg++) {
+    const Eigen::Vector3d force = forces.segment<3>(3*iLeg);
+    EXPECT_LE(std::fabs(force.x()), frictionCoefficient*force.z() + 1.0e-9) << "leg " << iLeg;
+    EXPECT_LE(std::fabs(force.y()), frictionCoefficient*force.z() + 1.0e-9) << "leg " << iLeg;
+    EXPECT_LE(force.z(), 400.0 + 1.0e-9) << "leg " << iLeg;
+  }
+}
+
+} // namespace
+
+TEST(CentroidalMpcSolverTest, projectOnFrictionPyramid) {
+  // a force inside the pyramid is not changed
+  const Eigen::Vector3d inside(10.0, -20.0, 100.0);
+  EXPECT_TRUE(inside.isApprox(loco::CentroidalMpcSolver::projectOnFrictionPyramid(inside, 0.5, 5.0, 400.0)));
+
+  // the projection is on the boundary and no sampled force of the pyramid is closer
+  const Eigen::Vector3d outside(80.0, 10.0, 50.0);
+  const Eigen::Vector3d projected = loco::CentroidalMpcSolver::projectOnFrictionPyramid(outside, 0.5, 5.0, 400.0);
+  EXPECT_NEAR(0.5*projected.z(), projected.x(), 1.0e-9);
+  EXPECT_NEAR(10.0, projected.y(), 1.0e-9);
+  for (double fz=5.0; fz<=400.0; fz+=0.5) {
+    const Eigen::Vector3d sample(std::min(80.0, 0.5*fz), std::min(10.0, 0.5*fz), fz);
+    EXPECT_LE((outside - projected).norm(), (outside - sample).norm() + 1.0e-9);
+  }
+
+  // the bounds of the normal force are respected
+  EXPECT_NEAR(5.0, loco::CentroidalMpcSolver::projectOnFrictionPyramid(Eigen::Vector3d(0.0, 0.0, -10.0), 0.5, 5.0, 400.0).z(), 1.0e-9);
+  EXPECT_NEAR(400.0, loco::CentroidalMpcSolver::projectOnFrictionPyramid(Eigen::Vector3d(0.0, 0.0, 500.0), 0.5, 5.0, 400.0).z(), 1.0e-9);
+}
+
+TEST(CentroidalMpcSolverTest, standing) {
+  loco::CentroidalMpcSolver solver;
+  setUpSolver(solver, 0.6);
+
+  loco::CentroidalMpcSolver::State state = loco::CentroidalMpcSolver::State::Zero();
+  state(5) = 0.45;
+  for (int k=0; k<solver.getNumberOfStages(); k++) {
+    for (int iLeg=0; iLeg<4; iLeg++) {
+      solver.setContact(k, iLeg, true, getPositionCoMToFoot(iLeg, 0.45));
+    }
+    solver.setReference(k+1, state);
+  }
+  ASSERT_TRUE(solver.solve(state));
+
+  // the legs share the weight
+  const loco::CentroidalMpcSolver::Input& forces = solver.getInputOfFirstStage();
+  Eigen::Vector3d netForce = Eigen::Vector3d::Zero();
+  for (int iLeg=0; iLeg<4; iLeg++) {
+    netForce += forces.segment<3>(3*iLeg);
+    EXPECT_NEAR(mass*gravity/4.0, forces(3*iLeg+2), 5.0);
+  }
+  EXPECT_NEAR(0.0, netForce.x(), 1.0);
+  EXPECT_NEAR(0.0, netForce.y(), 1.0);
+  EXPECT_NEAR(mass*gravity, netForce.z(), 5.0);
+  EXPECT_NEAR(0.45, solver.getPredictedState(solver.getNumberOfStages())(5), 0.01);
+  checkConstraints(forces, 0.6);
+}
+
+TEST(CentroidalMpcSolverTest, trotWithFrictionLimit) {
+  const double frictionCoefficient = 0.3;
+  loco::CentroidalMpcSolver solver;
+  setUpSolver(solver, frictionCoefficient);
+
+  // the robot is pushed sideways and the diagonal pairs alternate every 5 stages
+  loco::CentroidalMpcSolver::State state = loco::CentroidalMpcSolver::State::Zero();
+  state(5) = 0.45;
+  loco::CentroidalMpcSolver::State reference = state;
+  state(10) = 1.0;
+  for (int k=0; k<solver.getNumberOfStages(); k++) {
+    const bool isFirstPairInContact = ((k/5) % 2 == 0);
+    for (int iLeg=0; iLeg<4; iLeg++) {
+      const bool isFirstPair = (iLeg == 0 || iLeg == 3);
+      solver.setContact(k, iLeg, isFirstPair == isFirstPairInContact, getPositionCoMToFoot(iLeg, 0.45));
+    }
+    solver.setReference(k+1, reference);
+  }
+
+  ASSERT_TRUE(solver.solve(state));
+  const int numberOfIterations = solver.getNumberOfIterations();
+  EXPECT_LT(solver.getResidual(), 1.0);
+
+  // the warm started solution of the same problem converges faster
+  ASSERT_TRUE(solver.solve(state));
+  EXPECT_LT(solver.getNumberOfIterations(), numberOfIterations);
+
+  const loco::CentroidalMpcSolver::Input& forces = solver.getInputOfFirstStage();
+  // the legs of the swinging pair do not push
+  EXPECT_EQ(0.0, forces.segment<3>(3).norm());
+  EXPECT_EQ(0.0, forces.segment<3>(6).norm());
+  // the stance legs brake the lateral velocity within the friction pyramid
+  EXPECT_LT(forces(1) + forces(10), -10.0);
+  checkConstraints(forces, frictionCoefficient);
+}
@@ -0,0 +1,155 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     HierarchicalLeastSquaresSolverTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/motion_control/HierarchicalLeastSquaresSolver.hpp"
+#include <gtest/gtest.h>
+
+typedef loco::HierarchicalLeastSquaresSolver Solver;
+
+TEST(HierarchicalLeastSquaresSolverTest, priorities) {
+  Solver solver;
+  ASSERT_FALSE(solver.reset(Solver::maxNumberOfVariables+1));
+  ASSERT_TRUE(solver.reset(3));
+
+  // x0 + x1 = 1
+  Solver::TaskMatrix A(1, 3);
+  Solver::TaskVector b(1);
+  A << 1.0, 1.0, 0.0;
+  b << 1.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+  EXPECT_EQ(2, solver.getNumberOfFreeVariables());
+  EXPECT_NEAR(0.0, solver.getResidualOfLastTask(), 1.0e-9);
+
+  // x0 = 3 and x2 = 2 do not conflict with the first task
+  A.resize(2, 3);
+  b.resize(2);
+  A << 1.0, 0.0, 0.0,
+       0.0, 0.0, 1.0;
+  b << 3.0, 2.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+  EXPECT_EQ(0, solver.getNumberOfFreeVariables());
+
+  // x1 = 5 conflicts and has no effect
+  A.resize(1, 3);
+  b.resize(1);
+  A << 0.0, 1.0, 0.0;
+  b << 5.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+  EXPECT_NEAR(7.0, solver.getResidualOfLastTask(), 1.0e-9);
+
+  EXPECT_NEAR(3.0, solver.getSolution()(0), 1.0e-9);
+  EXPECT_NEAR(-2.0, solver.getSolution()(1), 1.0e-9);
+  EXPECT_NEAR(2.0, solver.getSolution()(2), 1.0e-9);
+}
+
+TEST(HierarchicalLeastSquaresSolverTest, leastSquaresWithinNullspace) {
+  Solver solver;
+  ASSERT_TRUE(solver.reset(3));
+
+  // x2 = 1 has the highest priority
+  Solver::TaskMatrix A(1, 3);
+  Solver::TaskVector b(1);
+  A << 0.0, 0.0, 1.0;
+  b << 1.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+
+  // the conflicting tasks x0 = 1, x0 = 3 and x1 + x2 = 0 are solved in the least squares sense
+  A.resize(3, 3);
+  b.resize(3);
+  A << 1.0, 0.0, 0.0,
+       1.0, 0.0, 0.0,
+       0.0, 1.0, 1.0;
+  b << 1.0, 3.0, 0.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+  EXPECT_NEAR(2.0, solver.getSolution()(0), 1.0e-9);
+  EXPECT_NEAR(-1.0, solver.getSolution()(1), 1.0e-9);
+  EXPECT_NEAR(1.0, solver.getSolution()(2), 1.0e-9);
+  EXPECT_EQ(0, solver.getNumberOfFreeVariables());
+
+  // a task with wrong dimensions is rejected
+  A.resize(1, 2);
+  b.resize(1);
+  EXPECT_FALSE(solver.addTask(A, b));
+}
+
+TEST(HierarchicalLeastSquaresSolverTest, checkpoint) {
+  Solver solver;
+  ASSERT_TRUE(solver.reset(3));
+
+  // x0 + x1 = 1
+  Solver::TaskMatrix A(1, 3);
+  Solver::TaskVector b(1);
+  A << 1.0, 1.0, 0.0;
+  b << 1.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+  solver.setCheckpoint();
+
+  // x0 = 3 and x2 = 2
+  A.resize(2, 3);
+  b.resize(2);
+  A << 1.0, 0.0, 0.0,
+       0.0, 0.0, 1.0;
+  b << 3.0, 2.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+  EXPECT_EQ(0, solver.getNumberOfFreeVariables());
+
+  // continuing from the first task gives the same solution as a new hierarchy
+  solver.restoreCheckpoint();
+  EXPECT_EQ(2, solver.getNumberOfFreeVariables());
+  A.resize(1, 3);
+  b.resize(1);
+  A << 0.0, 1.0, 0.0;
+  b << 5.0;
+  ASSERT_TRUE(solver.addTask(A, b));
+
+  Solver reference;
+  ASSERT_TRUE(reference.reset(3));
+  Solver::TaskMatrix A1(1, 3);
+  Solver::TaskVector b1(1);
+  A1 << 1.0, 1.0, 0.0;
+  b1 << 1.0;
+  ASSERT_TRUE(reference.addTask(A1, b1));
+  ASSERT_TRUE(reference.addTask(A, b));
+  EXPECT_NEAR(0.0, (solver.getSolution() - reference.getSolution()).norm(), 1.0e-12);
+  EXPECT_NEAR(-4.0, solver.getSolution()(0), 1.0e-9);
+  EXPECT_NEAR(5.0, solver.getSolution()(1), 1.0e-9);
+  EXPECT_EQ(1, solver.getNumberOfFreeVariables());
+}
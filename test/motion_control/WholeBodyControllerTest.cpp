@@ -0,0 +1,219 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     WholeBodyControllerTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include <gtest/gtest.h>
+#include "loco/motion_control/WholeBodyController.hpp"
+#include "tinyxml.h"
+#include "../TestLegAndTorso.hpp"
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+const double torsoMass = 30.0;
+const double linkMass = 2.0;
+const double gravity = 9.81;
+
+const char* wholeBodyControllerParameters =
+  "<LocomotionController>"
+  "  <WholeBodyController>"
+  "    <Torso>"
+  "      <Gains>"
+  "        <Heading kp=\"100.0\" kd=\"20.0\"/>"
+  "        <Lateral kp=\"100.0\" kd=\"20.0\"/>"
+  "        <Vertical kp=\"400.0\" kd=\"40.0\"/>"
+  "        <Roll kp=\"200.0\" kd=\"20.0\"/>"
+  "        <Pitch kp=\"200.0\" kd=\"20.0\"/>"
+  "        <Yaw kp=\"100.0\" kd=\"10.0\"/>"
+  "      </Gains>"
+  "      <Inertia xx=\"0.8\" yy=\"2.0\" zz=\"2.2\"/>"
+  "    </Torso>"
+  "    <SwingLeg>"
+  "      <Gains kp=\"400.0\" kd=\"40.0\"/>"
+  "    </SwingLeg>"
+  "    <Regularization tangentialForce=\"1.0\" normalForce=\"0.1\" jointAcceleration=\"0.01\"/>"
+  "    <Friction coefficient=\"0.6\" minimalNormalForce=\"5.0\"/>"
+  "  </WholeBodyController>"
+  "</LocomotionController>";
+
+//! Leg with a single link, the foot is below the hip at the corner of a rectangle
+class WholeBodyControllerTestLeg : public loco_test::TestLeg {
+ public:
+  WholeBodyControllerTestLeg(const std::string& name, int id, double x, double y) :
+    loco_test::TestLeg(name, id, loco::Position(x, y, -0.45))
+  {
+    setLink(linkMass, loco::Position(x, y, -0.2), 0.5*TranslationJacobian::Identity());
+    TranslationJacobian translationJacobian;
+    translationJacobian << 0.0, 0.4, 0.2,
+                          -0.4, 0.0, 0.0,
+                           0.0, -0.3, -0.3;
+    setTranslationJacobianFromBaseToFootInBaseFrame(translationJacobian);
+    getProperties().setLegLength(0.45);
+    setIsSupportLeg(true);
+  }
+};
+
+//! Robot at rest at its desired pose, the base frame coincides with the world frame
+class WholeBodyControllerTest : public ::testing::Test {
+ protected:
+  WholeBodyControllerTest() :
+    leftForeLeg_("leftFore", 0, 0.3, 0.2),
+    rightForeLeg_("rightFore", 1, 0.3, -0.2),
+    leftHindLeg_("leftHind", 2, -0.3, 0.2),
+    rightHindLeg_("rightHind", 3, -0.3, -0.2),
+    legs_(new loco::LegGroup(&leftForeLeg_, &rightForeLeg_, &leftHindLeg_, &rightHindLeg_)),
+    torso_(new loco_test::TestTorso),
+    wholeBodyController_(legs_, torso_)
+  {
+    torso_->getProperties().setMass(torsoMass);
+    torso_->getProperties().setGravity(loco::LinearAcceleration(0.0, 0.0, -gravity));
+    torso_->getProperties().setBaseToCenterOfMassPositionInBaseFrame(loco::Position(0.0, 0.0, 0.0));
+  }
+
+  virtual void SetUp() {
+    document_.Parse(wholeBodyControllerParameters);
+    ASSERT_FALSE(document_.Error());
+    ASSERT_TRUE(wholeBodyController_.loadParameters(TiXmlHandle(document_.FirstChild("LocomotionController"))));
+  }
+
+  //! Generalized accelerations of the last solution
+  loco::WholeBodyController::GeneralizedForces getGeneralizedAccelerations() const {
+    return wholeBodyController_.getSolver().getSolution().head<loco::WholeBodyController::numberOfGeneralizedCoordinates>();
+  }
+
+  WholeBodyControllerTestLeg leftForeLeg_;
+  WholeBodyControllerTestLeg rightForeLeg_;
+  WholeBodyControllerTestLeg leftHindLeg_;
+  WholeBodyControllerTestLeg rightHindLeg_;
+  std::shared_ptr<loco::LegGroup> legs_;
+  std::shared_ptr<loco_test::TestTorso> torso_;
+  TiXmlDocument document_;
+  loco::WholeBodyController wholeBodyController_;
+};
+
+} // namespace
+
+
+TEST_F(WholeBodyControllerTest, standingOnFourLegs) {
+  ASSERT_TRUE(wholeBodyController_.compute());
+  EXPECT_NEAR(0.0, wholeBodyController_.getDesiredAccelerationOfBase().norm(), 1.0e-9);
+  EXPECT_EQ(1, wholeBodyController_.getNumberOfActiveSetPasses());
+
+  // the base rows of the equations of motion M*ddq + h = J'*f are satisfied
+  const loco::WholeBodyController::GeneralizedForces generalizedAccelerations = getGeneralizedAccelerations();
+  Eigen::Matrix<double, 6, 1> wrenchOfForces = Eigen::Matrix<double, 6, 1>::Zero();
+  for (auto leg : *legs_) {
+    const Eigen::Vector3d force = wholeBodyController_.getGroundReactionForceInWorldFrame(leg->getId()).toImplementation();
+    wrenchOfForces.head<3>() += force;
+    wrenchOfForces.tail<3>() += leg->getPositionBaseToFootInBaseFrame().toImplementation().cross(force);
+  }
+  const Eigen::Matrix<double, 6, 1> residualOfBase = wholeBodyController_.getMassMatrix().topRows<6>()*generalizedAccelerations
+      + wholeBodyController_.getGravityTerms().head<6>() - wrenchOfForces;
+  EXPECT_NEAR(0.0, residualOfBase.norm(), 1.0e-6);
+  EXPECT_NEAR(0.0, generalizedAccelerations.norm(), 1.0e-6);
+
+  // each leg carries a quarter of the weight of the torso and the links
+  const double weight = (torsoMass + 4.0*linkMass)*gravity;
+  for (auto leg : *legs_) {
+    const loco::Force& force = wholeBodyController_.getGroundReactionForceInWorldFrame(leg->getId());
+    EXPECT_NEAR(0.0, force.x(), 1.0e-6) << leg->getName();
+    EXPECT_NEAR(0.0, force.y(), 1.0e-6) << leg->getName();
+    EXPECT_NEAR(weight/4.0, force.z(), 1.0e-6) << leg->getName();
+  }
+}
+
+
+TEST_F(WholeBodyControllerTest, swingLegTracksDesiredJointPositions) {
+  // the right fore leg swings towards an offset of its joint positions
+  rightForeLeg_.setIsSupportLeg(false);
+  rightForeLeg_.setIsGrounded(false);
+  loco::LegBase::JointPositions jointPositionErrors;
+  jointPositionErrors << 0.0, 0.1, -0.2;
+  rightForeLeg_.setDesiredJointPositions(rightForeLeg_.getMeasuredJointPositions() + jointPositionErrors);
+  ASSERT_TRUE(wholeBodyController_.compute());
+
+  // J*ddq = kp*J*(q_des - q), hence ddq = kp*(q_des - q) since the Jacobian is regular
+  const double proportionalGain = wholeBodyController_.getParameters().proportionalGainSwingLeg_;
+  const int indexOfJoints = 6 + loco::WholeBodyController::numberOfJointsPerLeg*rightForeLeg_.getId();
+  const loco::WholeBodyController::GeneralizedForces generalizedAccelerations = getGeneralizedAccelerations();
+  const Eigen::Vector3d jointAccelerations = generalizedAccelerations.segment<3>(indexOfJoints);
+  EXPECT_NEAR(0.0, (jointAccelerations - proportionalGain*jointPositionErrors.matrix()).norm(), 1.0e-6);
+  EXPECT_NEAR(0.0, wholeBodyController_.getGroundReactionForceInWorldFrame(rightForeLeg_.getId()).norm(), 1.0e-9);
+
+  // the torques of the swing leg produce these accelerations, M*ddq + h = tau without a contact force
+  const Eigen::Vector3d expectedJointTorques = wholeBodyController_.getMassMatrix().block<3, loco::WholeBodyController::numberOfGeneralizedCoordinates>(indexOfJoints, 0)*generalizedAccelerations
+      + wholeBodyController_.getGravityTerms().segment<3>(indexOfJoints);
+  EXPECT_NEAR(0.0, (rightForeLeg_.getDesiredJointTorques().matrix() - expectedJointTorques).norm(), 1.0e-6);
+
+  // the torso stays at rest on the remaining legs
+  EXPECT_NEAR(0.0, generalizedAccelerations.head<6>().norm(), 1.0e-6);
+}
+
+
+TEST_F(WholeBodyControllerTest, frictionConstraintsAreActivated) {
+  // the desired lateral acceleration of the torso needs more tangential force than the friction allows
+  torso_->getDesiredState().setLinearVelocityBaseInControlFrame(loco::LinearVelocity(0.0, 2.0, 0.0));
+  ASSERT_TRUE(wholeBodyController_.compute());
+  EXPECT_NEAR(40.0, wholeBodyController_.getDesiredAccelerationOfBase()(1), 1.0e-9);
+  EXPECT_GT(wholeBodyController_.getNumberOfActiveSetPasses(), 1);
+
+  // the forces stay in the friction pyramid and the torso accelerates less than desired
+  const double frictionCoefficient = wholeBodyController_.getParameters().frictionCoefficient_;
+  int numberOfLegsAtBound = 0;
+  for (auto leg : *legs_) {
+    const loco::Force& force = wholeBodyController_.getGroundReactionForceInWorldFrame(leg->getId());
+    EXPECT_LE(std::fabs(force.x()), frictionCoefficient*force.z() + 1.0e-6) << leg->getName();
+    EXPECT_LE(std::fabs(force.y()), frictionCoefficient*force.z() + 1.0e-6) << leg->getName();
+    if (std::fabs(force.y() - frictionCoefficient*force.z()) < 1.0e-6) {
+      numberOfLegsAtBound++;
+    }
+  }
+  EXPECT_GT(numberOfLegsAtBound, 0);
+  const double lateralAcceleration = getGeneralizedAccelerations()(1);
+  EXPECT_GT(lateralAcceleration, 0.0);
+  EXPECT_LT(lateralAcceleration, 40.0);
+
+  // the active set starts empty in the next tick
+  torso_->getDesiredState().setLinearVelocityBaseInControlFrame(loco::LinearVelocity(0.0, 0.0, 0.0));
+  ASSERT_TRUE(wholeBodyController_.compute());
+  EXPECT_EQ(1, wholeBodyController_.getNumberOfActiveSetPasses());
+}
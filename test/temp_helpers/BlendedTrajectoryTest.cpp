@@ -0,0 +1,77 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     BlendedTrajectoryTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/temp_helpers/BlendedTrajectory.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+struct LinearFunction {
+  LinearFunction(double slope, double offset) : slope_(slope), offset_(offset) { }
+  double evaluate(double t) const { return slope_*t + offset_; }
+  double slope_;
+  double offset_;
+};
+
+} // namespace
+
+
+TEST(BlendedTrajectoryTest, transition) {
+  typedef loco::BlendedTrajectory<LinearFunction> Blend;
+  Blend walk, trot, current;
+  walk.setTrajectory(Blend::TrajectoryPtr(new LinearFunction(1.0, 0.0)));
+  trot.setTrajectory(Blend::TrajectoryPtr(new LinearFunction(-1.0, 2.0)));
+  current = walk;
+
+  // interpolating between the endpoints every tick does not accumulate terms
+  for (int i=0; i<=10; i++) {
+    const double t = i/10.0;
+    ASSERT_TRUE(current.setToInterpolated(walk, trot, t));
+    EXPECT_NEAR((1.0-t)*walk.evaluate(0.3) + t*trot.evaluate(0.3), current.evaluate(0.3), 1.0e-12);
+    EXPECT_LE(current.getNumberOfTrajectories(), 2);
+  }
+  EXPECT_EQ(1, current.getNumberOfTrajectories());
+
+  // the blend itself can be used as an endpoint
+  ASSERT_TRUE(current.setToInterpolated(current, walk, 0.5));
+  EXPECT_EQ(2, current.getNumberOfTrajectories());
+  EXPECT_NEAR(0.5*trot.evaluate(0.8) + 0.5*walk.evaluate(0.8), current.evaluate(0.8), 1.0e-12);
+}
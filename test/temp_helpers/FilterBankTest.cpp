@@ -0,0 +1,98 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     FilterBankTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/temp_helpers/FilterBank.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+
+
+TEST(FilterBankTest, firstOrderStepResponse) {
+  loco::FilterBank<2> filterBank;
+  filterBank.setFirstOrder(0.1, 2.0);
+
+  // the response at t=0.3s does not depend on the time step
+  const double dts[2] = {0.0025, 0.01};
+  for (int k=0; k<2; k++) {
+    filterBank.initialize(loco::FilterBank<2>::Array::Zero());
+    const int nSteps = static_cast<int>(std::round(0.3/dts[k]));
+    for (int i=0; i<nSteps; i++) {
+      filterBank.advance(dts[k], loco::FilterBank<2>::Array::Ones());
+    }
+    EXPECT_NEAR(2.0*(1.0-std::exp(-3.0)), filterBank.getOutput(0), 1.0e-12);
+    EXPECT_NEAR(filterBank.getOutput(0), filterBank.getOutput(1), 1.0e-15);
+  }
+}
+
+TEST(FilterBankTest, secondOrderStepResponse) {
+  const double omega = 20.0;
+  const double zeta = 0.5;
+  loco::FilterBank<3> filterBank;
+  filterBank.setSecondOrder(omega, zeta);
+  filterBank.setSecondOrder(1, omega, 1.0);
+  filterBank.setFirstOrder(2, 0.0);
+  filterBank.initialize(loco::FilterBank<3>::Array::Zero());
+  const double dt = 0.0025;
+  for (int i=0; i<40; i++) {
+    filterBank.advance(dt, loco::FilterBank<3>::Array::Ones());
+  }
+
+  // analytic step response of the under-damped and the critically damped channel at t=0.1s
+  const double t = 0.1;
+  const double omegaD = omega*std::sqrt(1.0-zeta*zeta);
+  const double underDamped = 1.0 - std::exp(-zeta*omega*t)*(std::cos(omegaD*t) + zeta/std::sqrt(1.0-zeta*zeta)*std::sin(omegaD*t));
+  const double criticallyDamped = 1.0 - std::exp(-omega*t)*(1.0 + omega*t);
+  EXPECT_NEAR(underDamped, filterBank.getOutput(0), 1.0e-10);
+  EXPECT_NEAR(criticallyDamped, filterBank.getOutput(1), 1.0e-10);
+  EXPECT_NEAR(omega*omega*t*std::exp(-omega*t), filterBank.getRate()(1), 1.0e-8);
+
+  // a zero time constant passes the input through
+  EXPECT_DOUBLE_EQ(1.0, filterBank.getOutput(2));
+}
+
+TEST(FilterBankTest, initializeOnFirstAdvance) {
+  loco::FilterBank<1> filterBank;
+  filterBank.setFirstOrder(0.5);
+  filterBank.advance(0.0025, loco::FilterBank<1>::Array::Constant(0.7));
+  EXPECT_DOUBLE_EQ(0.7, filterBank.getOutput(0));
+  filterBank.reset();
+  filterBank.advance(0.0025, loco::FilterBank<1>::Array::Constant(-0.2));
+  EXPECT_DOUBLE_EQ(-0.2, filterBank.getOutput(0));
+}
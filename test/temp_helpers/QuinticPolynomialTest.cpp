@@ -0,0 +1,71 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     QuinticPolynomialTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/temp_helpers/QuinticPolynomial.hpp"
+#include <gtest/gtest.h>
+
+
+TEST(QuinticPolynomialTest, boundaryConditions) {
+  loco::QuinticPolynomial polynomial;
+  polynomial.fit(0.4, 0.1, -0.3, 2.0, 0.25, 0.5, -1.0);
+
+  EXPECT_NEAR(0.1, polynomial.getPosition(0.0), 1.0e-12);
+  EXPECT_NEAR(-0.3, polynomial.getVelocity(0.0), 1.0e-12);
+  EXPECT_NEAR(2.0, polynomial.getAcceleration(0.0), 1.0e-12);
+  EXPECT_NEAR(0.25, polynomial.getPosition(0.4), 1.0e-12);
+  EXPECT_NEAR(0.5, polynomial.getVelocity(0.4), 1.0e-10);
+  EXPECT_NEAR(-1.0, polynomial.getAcceleration(0.4), 1.0e-9);
+
+  // clamped outside of the duration
+  EXPECT_NEAR(0.25, polynomial.getPosition(1.0), 1.0e-12);
+}
+
+TEST(QuinticPolynomialTest, minimumJerk) {
+  loco::QuinticPolynomial polynomial;
+  polynomial.fitMinimumJerk(2.0, 1.0, 3.0);
+  EXPECT_NEAR(2.0, polynomial.getPosition(1.0), 1.0e-12);
+  EXPECT_NEAR(0.0, polynomial.getVelocity(2.0), 1.0e-12);
+  EXPECT_NEAR(0.0, polynomial.getAcceleration(0.0), 1.0e-12);
+
+  // analytic velocity matches the finite difference
+  const double h = 1.0e-6;
+  EXPECT_NEAR((polynomial.getPosition(0.7+h)-polynomial.getPosition(0.7-h))/(2.0*h), polynomial.getVelocity(0.7), 1.0e-6);
+}
@@ -0,0 +1,136 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     TrajectoryTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/temp_helpers/Trajectory.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+
+TEST(TrajectoryTest, batchEvaluation1D) {
+  loco::Trajectory1D trajectory;
+  trajectory.addKnot(0.0, 0.0);
+  trajectory.addKnot(0.3, 0.08);
+  trajectory.addKnot(0.65, 0.1);
+  trajectory.addKnot(0.8, 0.02);
+  trajectory.addKnot(1.0, 0.0);
+
+  // samples outside the range of the knots and in unsorted order are also supported
+  std::vector<double> tValues;
+  for (int i=0; i<203; i++) {
+    tValues.push_back(-0.1 + 1.2*i/202.0);
+  }
+  tValues.push_back(0.5);
+  tValues.push_back(0.3);
+
+  std::vector<double> catmullRom(tValues.size());
+  std::vector<double> linear(tValues.size());
+  trajectory.evaluate_catmull_rom(tValues.data(), catmullRom.data(), tValues.size());
+  trajectory.evaluate_linear(tValues.data(), linear.data(), tValues.size());
+  for (unsigned int i=0; i<tValues.size(); i++) {
+    EXPECT_NEAR(trajectory.evaluate_catmull_rom(tValues[i]), catmullRom[i], 1.0e-12) << "t: " << tValues[i];
+    EXPECT_NEAR(trajectory.evaluate_linear(tValues[i]), linear[i], 1.0e-12) << "t: " << tValues[i];
+  }
+}
+
+TEST(TrajectoryTest, batchEvaluationEigen3D) {
+  loco::TrajectoryEigen3D trajectory;
+  trajectory.addKnot(0.0, Eigen::Vector3d(0.0, 1.0, -1.0));
+  trajectory.addKnot(0.5, Eigen::Vector3d(0.2, 0.5, 0.0));
+  trajectory.addKnot(1.0, Eigen::Vector3d(0.3, -0.5, 1.0));
+  trajectory.addKnot(2.0, Eigen::Vector3d(0.0, 0.0, 0.0));
+
+  std::vector<double> tValues;
+  for (int i=0; i<101; i++) {
+    tValues.push_back(-0.5 + 3.0*i/100.0);
+  }
+
+  std::vector<Eigen::Vector3d> catmullRom(tValues.size());
+  std::vector<Eigen::Vector3d> linear(tValues.size());
+  trajectory.evaluate_catmull_rom(tValues.data(), catmullRom.data(), tValues.size());
+  trajectory.evaluate_linear(tValues.data(), linear.data(), tValues.size());
+  for (unsigned int i=0; i<tValues.size(); i++) {
+    EXPECT_TRUE(trajectory.evaluate_catmull_rom(tValues[i]).isApprox(catmullRom[i], 1.0e-12)) << "t: " << tValues[i];
+    EXPECT_TRUE(trajectory.evaluate_linear(tValues[i]).isApprox(linear[i], 1.0e-12)) << "t: " << tValues[i];
+  }
+}
+
+TEST(TrajectoryTest, sampleCatmullRomTrajectory) {
+  loco::Trajectory1D trajectory;
+  trajectory.addKnot(0.0, 1.0);
+  trajectory.addKnot(1.0, 2.0);
+
+  std::vector<double> tArray, valArray;
+  trajectory.evaluate_catmull_rom_traj(11, tArray, valArray);
+  ASSERT_EQ(11, tArray.size());
+  ASSERT_EQ(11, valArray.size());
+  EXPECT_DOUBLE_EQ(1.0, valArray.front());
+  EXPECT_DOUBLE_EQ(2.0, valArray.back());
+
+  // no samples are appended to empty arrays
+  std::vector<double> emptyTArray, emptyValArray;
+  trajectory.evaluate_catmull_rom_traj(0, emptyTArray, emptyValArray);
+  EXPECT_TRUE(emptyTArray.empty());
+  EXPECT_TRUE(emptyValArray.empty());
+}
+
+TEST(TrajectoryTest, sharedKnots) {
+  loco::Trajectory1D trajectory;
+  trajectory.addKnot(0.0, 0.0);
+  trajectory.addKnot(1.0, 1.0);
+
+  // copies share the knots until one of them is modified
+  loco::Trajectory1D copy(trajectory);
+  EXPECT_TRUE(copy.isSharingKnots(trajectory));
+  EXPECT_DOUBLE_EQ(1.0, copy.getKnotValue(1));
+  EXPECT_TRUE(copy.isSharingKnots(trajectory));
+  copy.setKnotValue(1, 2.0);
+  EXPECT_FALSE(copy.isSharingKnots(trajectory));
+  EXPECT_DOUBLE_EQ(1.0, trajectory.getKnotValue(1));
+  EXPECT_DOUBLE_EQ(2.0, copy.getKnotValue(1));
+
+  // evaluation with external cursors does not modify the trajectory
+  const loco::Trajectory1D& constTrajectory = trajectory;
+  loco::TrajectoryCursor cursor1, cursor2;
+  EXPECT_DOUBLE_EQ(0.75, constTrajectory.evaluate_linear(0.75, cursor1));
+  EXPECT_DOUBLE_EQ(0.25, constTrajectory.evaluate_linear(0.25, cursor2));
+  EXPECT_DOUBLE_EQ(trajectory.evaluate_catmull_rom(0.4), constTrajectory.evaluate_catmull_rom(0.4, cursor1));
+}
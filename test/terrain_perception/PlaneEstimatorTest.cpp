@@ -0,0 +1,150 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     PlaneEstimatorTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/terrain_perception/PlaneEstimator.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+//! Height of the plane z = d - a*x - b*y
+double getHeight(const Eigen::Vector3d& plane, double x, double y) {
+  return plane(2) - plane(0)*x - plane(1)*y;
+}
+
+} // namespace
+
+
+TEST(PlaneEstimatorTest, tiltedPlane) {
+  const Eigen::Vector3d plane(0.2, -0.1, 0.3);
+  loco::PlaneEstimator estimator(8, 0.9);
+  const double xs[8] = {0.0, 0.4, 0.4, 0.0, 0.8, 0.8, 1.2, 1.2};
+  const double ys[8] = {0.0, 0.0, 0.3, 0.3, -0.2, 0.1, 0.0, 0.3};
+  for (int k = 0; k < 8; k++) {
+    estimator.addPoint(loco::Position(xs[k], ys[k], getHeight(plane, xs[k], ys[k])));
+  }
+  ASSERT_TRUE(estimator.estimate());
+  EXPECT_EQ(8, estimator.getNumberOfPoints());
+  EXPECT_NEAR(plane(0), estimator.getParameters()(0), 1.0e-9);
+  EXPECT_NEAR(plane(1), estimator.getParameters()(1), 1.0e-9);
+  EXPECT_NEAR(plane(2), estimator.getParameters()(2), 1.0e-9);
+  EXPECT_NEAR(0.0, estimator.getResidualVariance(), 1.0e-12);
+
+  const loco::Vector normal = estimator.getNormalInWorldFrame();
+  const Eigen::Vector3d expectedNormal = Eigen::Vector3d(plane(0), plane(1), 1.0).normalized();
+  EXPECT_NEAR(expectedNormal.x(), normal.x(), 1.0e-9);
+  EXPECT_NEAR(expectedNormal.y(), normal.y(), 1.0e-9);
+  EXPECT_NEAR(expectedNormal.z(), normal.z(), 1.0e-9);
+  EXPECT_NEAR(plane(2), estimator.getPositionInWorldFrame().z(), 1.0e-9);
+}
+
+
+TEST(PlaneEstimatorTest, windowEviction) {
+  const Eigen::Vector3d firstPlane(0.0, 0.0, 0.0);
+  const Eigen::Vector3d secondPlane(0.3, 0.2, 0.5);
+  const double xs[4] = {0.0, 0.5, 0.5, 0.0};
+  const double ys[4] = {0.0, 0.0, 0.4, 0.4};
+  loco::PlaneEstimator estimator(4, 1.0);
+  for (int k = 0; k < 4; k++) {
+    estimator.addPoint(loco::Position(xs[k], ys[k], getHeight(firstPlane, xs[k], ys[k])));
+  }
+  ASSERT_TRUE(estimator.estimate());
+  EXPECT_NEAR(0.0, estimator.getParameters()(2), 1.0e-9);
+
+  // As long as points of the first plane are in the window, the fit is a mixture of both planes
+  for (int k = 0; k < 2; k++) {
+    estimator.addPoint(loco::Position(xs[k], ys[k], getHeight(secondPlane, xs[k], ys[k])));
+  }
+  ASSERT_TRUE(estimator.estimate());
+  EXPECT_EQ(4, estimator.getNumberOfPoints());
+  EXPECT_GT(estimator.getResidualVariance(), 1.0e-3);
+
+  // The window only contains points of the second plane
+  for (int k = 2; k < 4; k++) {
+    estimator.addPoint(loco::Position(xs[k], ys[k], getHeight(secondPlane, xs[k], ys[k])));
+  }
+  ASSERT_TRUE(estimator.estimate());
+  EXPECT_EQ(4, estimator.getNumberOfPoints());
+  for (int k = 0; k < 4; k++) {
+    EXPECT_NEAR(getHeight(secondPlane, xs[k], ys[k]), estimator.getPoint(k).z(), 1.0e-12);
+  }
+  EXPECT_NEAR(secondPlane(0), estimator.getParameters()(0), 1.0e-9);
+  EXPECT_NEAR(secondPlane(1), estimator.getParameters()(1), 1.0e-9);
+  EXPECT_NEAR(secondPlane(2), estimator.getParameters()(2), 1.0e-9);
+  EXPECT_NEAR(0.0, estimator.getResidualVariance(), 1.0e-12);
+}
+
+
+TEST(PlaneEstimatorTest, collinearFootholds) {
+  const Eigen::Vector3d plane(0.2, 0.1, 0.3);
+  loco::PlaneEstimator estimator(3, 1.0);
+  estimator.addPoint(loco::Position(0.0, 0.0, getHeight(plane, 0.0, 0.0)));
+  estimator.addPoint(loco::Position(0.5, 0.0, getHeight(plane, 0.5, 0.0)));
+  estimator.addPoint(loco::Position(0.0, 0.4, getHeight(plane, 0.0, 0.4)));
+  ASSERT_TRUE(estimator.estimate());
+
+  // Footholds on a line do not define a plane, the previous estimate is kept
+  for (int k = 0; k < 3; k++) {
+    estimator.addPoint(loco::Position(0.1*k, 0.2*k, 0.05*k));
+  }
+  EXPECT_FALSE(estimator.estimate());
+  EXPECT_NEAR(plane(0), estimator.getParameters()(0), 1.0e-9);
+  EXPECT_NEAR(plane(1), estimator.getParameters()(1), 1.0e-9);
+  EXPECT_NEAR(plane(2), estimator.getParameters()(2), 1.0e-9);
+
+  // Less than three footholds are rejected as well
+  estimator.reset();
+  estimator.addPoint(loco::Position(0.0, 0.0, 0.1));
+  estimator.addPoint(loco::Position(0.5, 0.5, 0.2));
+  EXPECT_FALSE(estimator.estimate());
+
+  // With a slope prior the collinear footholds give the plane with the least slope through the line
+  estimator.reset();
+  estimator.setSlopePriorWeight(1.0e-6);
+  for (int k = 0; k < 5; k++) {
+    estimator.addPoint(loco::Position(0.1*k, 0.0, 0.3 - 0.2*0.1*k));
+  }
+  ASSERT_TRUE(estimator.estimate());
+  EXPECT_NEAR(0.2, estimator.getParameters()(0), 1.0e-4);
+  EXPECT_NEAR(0.0, estimator.getParameters()(1), 1.0e-4);
+  EXPECT_NEAR(0.3, estimator.getParameters()(2), 1.0e-4);
+}
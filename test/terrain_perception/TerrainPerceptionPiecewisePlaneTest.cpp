@@ -0,0 +1,181 @@
+/*****************************************************************************************
+* Software License Agreement (BSD License)
+*
+* Copyright (c) 2014, Christian Gehring, Péter Fankhauser, C. Dario Bellicoso, Stelian Coros
+* All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of Autonomous Systems Lab nor ETH Zurich
+*     nor the names of its contributors may be used to endorse or
+*     promote products derived from this software without specific
+*     prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+* @file     TerrainPerceptionPiecewisePlaneTest.cpp
+* @version  1.0
+* @ingroup
+* @brief
+*/
+
+#include "loco/terrain_perception/TerrainPerceptionPiecewisePlane.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+//! Number of allocations with the global operator new
+std::atomic<long> numberOfAllocations(0);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  numberOfAllocations++;
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+
+TEST(TerrainPerceptionPiecewisePlaneTest, stairs) {
+  loco::TerrainModelPiecewisePlane terrainModel(0.3);
+  loco::LegGroup legs;
+  loco::TerrainPerceptionPiecewisePlane perception(&terrainModel, &legs, nullptr);
+  ASSERT_TRUE(terrainModel.initialize(0.0025));
+
+  // Two treads of a stair in neighboring regions
+  for (int k = 0; k < 6; k++) {
+    perception.addFoothold(loco::Position(0.02 + 0.05*k, 0.05 + 0.03*(k % 3), 0.0));
+    perception.addFoothold(loco::Position(0.32 + 0.05*k, 0.05 + 0.03*((k + 1) % 3), 0.15));
+  }
+  EXPECT_EQ(2, perception.getNumberOfRegions());
+  EXPECT_EQ(2, terrainModel.getNumberOfPlanes());
+
+  double height;
+  EXPECT_TRUE(terrainModel.getHeight(loco::Position(0.15, 0.1, 1.0), height));
+  EXPECT_NEAR(0.0, height, 1.0e-6);
+  EXPECT_TRUE(terrainModel.getHeight(loco::Position(0.45, 0.1, 1.0), height));
+  EXPECT_NEAR(0.15, height, 1.0e-6);
+
+  // Unknown terrain continues at the height of the latest foothold
+  EXPECT_FALSE(terrainModel.getHeight(loco::Position(5.0, 5.0, 1.0), height));
+  EXPECT_NEAR(0.15, height, 1.0e-6);
+}
+
+
+TEST(TerrainPerceptionPiecewisePlaneTest, ramp) {
+  loco::TerrainModelPiecewisePlane terrainModel(0.3);
+  loco::LegGroup legs;
+  loco::TerrainPerceptionPiecewisePlane perception(&terrainModel, &legs, nullptr);
+  ASSERT_TRUE(terrainModel.initialize(0.0025));
+
+  // Footholds on a ramp z = 0.2*x, the weak slope prior keeps the fit close to the ramp
+  const double xs[6] = {0.02, 0.27, 0.15, 0.05, 0.22, 0.12};
+  const double ys[6] = {0.03, 0.05, 0.25, 0.18, 0.14, 0.09};
+  for (int k = 0; k < 6; k++) {
+    perception.addFoothold(loco::Position(xs[k], ys[k], 0.2*xs[k]));
+  }
+  EXPECT_EQ(1, perception.getNumberOfRegions());
+
+  loco::Vector normal;
+  EXPECT_TRUE(terrainModel.getNormal(loco::Position(0.15, 0.15, 1.0), normal));
+  EXPECT_NEAR(-0.2/std::sqrt(1.04), normal.x(), 1.0e-2);
+  EXPECT_NEAR(0.0, normal.y(), 1.0e-2);
+  double height;
+  EXPECT_TRUE(terrainModel.getHeight(loco::Position(0.15, 0.15, 1.0), height));
+  EXPECT_NEAR(0.03, height, 1.0e-3);
+}
+
+
+TEST(TerrainPerceptionPiecewisePlaneTest, stepInsideRegion) {
+  loco::TerrainModelPiecewisePlane terrainModel(0.3);
+  loco::LegGroup legs;
+  loco::TerrainPerceptionPiecewisePlane perception(&terrainModel, &legs, nullptr);
+  ASSERT_TRUE(terrainModel.initialize(0.0025));
+
+  for (int k = 0; k < 4; k++) {
+    perception.addFoothold(loco::Position(0.05 + 0.05*k, 0.05 + 0.05*(k % 2), 0.0));
+  }
+  double height;
+  EXPECT_TRUE(terrainModel.getHeight(loco::Position(0.15, 0.15, 1.0), height));
+  EXPECT_NEAR(0.0, height, 1.0e-6);
+
+  // The region is segmented again and follows the footholds on the new level
+  for (int k = 0; k < 12; k++) {
+    perception.addFoothold(loco::Position(0.03 + 0.02*k, 0.05 + 0.1*(k % 3), 0.1));
+  }
+  EXPECT_EQ(1, perception.getNumberOfRegions());
+  EXPECT_TRUE(terrainModel.getHeight(loco::Position(0.15, 0.15, 1.0), height));
+  EXPECT_NEAR(0.1, height, 1.0e-6);
+}
+
+
+TEST(TerrainPerceptionPiecewisePlaneTest, maximumNumberOfRegions) {
+  loco::TerrainModelPiecewisePlane terrainModel(0.3);
+  loco::LegGroup legs;
+  loco::TerrainPerceptionPiecewisePlane perception(&terrainModel, &legs, nullptr);
+  perception.setParameters(12, 0.03, 16, 3);
+  ASSERT_TRUE(terrainModel.initialize(0.0025));
+
+  // Walk along x, the regions behind the robot are dropped
+  for (int i = 0; i < 6; i++) {
+    for (int k = 0; k < 3; k++) {
+      perception.addFoothold(loco::Position(0.3*i + 0.05 + 0.1*k, 0.05 + 0.1*k*k, 0.01*i));
+    }
+  }
+  EXPECT_EQ(3, perception.getNumberOfRegions());
+  EXPECT_EQ(3, terrainModel.getNumberOfPlanes());
+  double height;
+  EXPECT_FALSE(terrainModel.getHeight(loco::Position(0.15, 0.15, 1.0), height));
+  EXPECT_TRUE(terrainModel.getHeight(loco::Position(1.65, 0.15, 1.0), height));
+  EXPECT_NEAR(0.05, height, 1.0e-6);
+}
+
+
+TEST(TerrainPerceptionPiecewisePlaneTest, noAllocationPerFoothold) {
+  loco::TerrainModelPiecewisePlane terrainModel(0.3);
+  loco::LegGroup legs;
+  loco::TerrainPerceptionPiecewisePlane perception(&terrainModel, &legs, nullptr);
+  perception.setParameters(12, 0.03, 16, 8);
+  ASSERT_TRUE(terrainModel.initialize(0.0025));
+
+  // New regions, evicted regions, inliers and segmentations
+  const long numberOfAllocationsBefore = numberOfAllocations;
+  for (int k = 0; k < 400; k++) {
+    const double x = 0.07*k;
+    const double y = 0.1*(k % 5);
+    perception.addFoothold(loco::Position(x, y, 0.05*((k/7) % 3) + 0.01*x));
+  }
+  EXPECT_EQ(numberOfAllocationsBefore, numberOfAllocations);
+  EXPECT_EQ(8, perception.getNumberOfRegions());
+}